@@ -6059,3 +6059,9 @@ void StubGenerator_generate(CodeBuffer* code, bool all) {
   }
   StubGenerator g(code, all);
 }
+
+void StubGenerator_generate_compiler_stubs(CodeBuffer* code) {
+  // The compiler intrinsic stubs are generated together with the
+  // other stubs on this platform, see compiler_stubs_code_size.
+  ShouldNotReachHere();
+}
@@ -617,6 +617,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ movw(bc, Bytecodes::_fast_icaload);
     __ br(Assembler::EQ, rewrite);
 
+    // if _iaload rewrite to _fast_iiaload
+    __ cmpw(r1, Bytecodes::_iaload);
+    __ movw(bc, Bytecodes::_fast_iiaload);
+    __ br(Assembler::EQ, rewrite);
+
     // else rewrite to _fast_iload
     __ movw(bc, Bytecodes::_fast_iload);
 
@@ -858,6 +863,23 @@ void TemplateTable::fast_icaload()
   __ access_load_at(T_CHAR, IN_HEAP | IS_ARRAY, r0, Address(r0, r1, Address::uxtw(1)), noreg, noreg);
 }
 
+// iload followed by iaload frequent pair
+void TemplateTable::fast_iiaload()
+{
+  transition(vtos, itos);
+  // load index out of locals
+  locals_index(r2);
+  __ ldr(r1, iaddress(r2));
+
+  __ pop_ptr(r0);
+
+  // r0: array
+  // r1: index
+  index_check(r0, r1); // leaves index in r1, kills rscratch1
+  __ add(r1, r1, arrayOopDesc::base_offset_in_bytes(T_INT) >> 2);
+  __ access_load_at(T_INT, IN_HEAP | IS_ARRAY, r0, Address(r0, r1, Address::uxtw(2)), noreg, noreg);
+}
+
 void TemplateTable::saload()
 {
   transition(itos, itos);
@@ -31,7 +31,8 @@
 
 enum platform_dependent_constants {
   code_size1 =  9000,           // simply increase if too small (assembler will crash if too small)
-  code_size2 = 22000            // simply increase if too small (assembler will crash if too small)
+  code_size2 = 22000,           // simply increase if too small (assembler will crash if too small)
+  compiler_stubs_code_size = 0  // compiler intrinsic stubs are generated in code_size2
 };
 
 class Arm {
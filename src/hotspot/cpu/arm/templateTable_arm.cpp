@@ -652,6 +652,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ mov(target_bytecode, Bytecodes::_fast_icaload);
     __ b(rewrite, eq);
 
+    // if _iaload, rewrite to fast_iiaload
+    __ cmp(next_bytecode, Bytecodes::_iaload);
+    __ mov(target_bytecode, Bytecodes::_fast_iiaload);
+    __ b(rewrite, eq);
+
     // rewrite so iload doesn't check again.
     __ mov(target_bytecode, Bytecodes::_fast_iload);
 
@@ -928,6 +933,27 @@ void TemplateTable::fast_icaload() {
 }
 
 
+// iload followed by iaload frequent pair
+void TemplateTable::fast_iiaload() {
+  transition(vtos, itos);
+  const Register Rlocal_index = R1_tmp;
+  const Register Rarray = R1_tmp;
+  const Register Rindex = R4_tmp; // index_check prefers index on R4
+  assert_different_registers(Rlocal_index, Rindex);
+  assert_different_registers(Rarray, Rindex);
+
+  // load index out of locals
+  locals_index(Rlocal_index);
+  Address local = load_iaddress(Rlocal_index, Rtemp);
+  __ ldr_s32(Rindex, local);
+
+  // get array element
+  index_check(Rarray, Rindex);
+  Address addr = get_array_elem_addr_same_base(T_INT, Rarray, Rindex, Rtemp);
+  __ access_load_at(T_INT, IN_HEAP | IS_ARRAY, addr, R0_tos, noreg, noreg, noreg);
+}
+
+
 void TemplateTable::saload() {
   transition(itos, itos);
   const Register Rarray = R1_tmp;
@@ -34,7 +34,8 @@ static bool returns_to_call_stub(address return_pc) { return return_pc == _call_
 
 enum platform_dependent_constants {
   code_size1 = 20000,          // simply increase if too small (assembler will crash if too small)
-  code_size2 = 24000           // simply increase if too small (assembler will crash if too small)
+  code_size2 = 24000,          // simply increase if too small (assembler will crash if too small)
+  compiler_stubs_code_size = 0 // compiler intrinsic stubs are generated in code_size2
 };
 
 // CRC32 Intrinsics.
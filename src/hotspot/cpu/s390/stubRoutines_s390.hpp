@@ -34,7 +34,8 @@ static bool returns_to_call_stub(address return_pc) { return return_pc == _call_
 enum { // Platform dependent constants.
   // TODO: May be able to shrink this a lot
   code_size1 = 20000,      // Simply increase if too small (assembler will crash if too small).
-  code_size2 = 20000       // Simply increase if too small (assembler will crash if too small).
+  code_size2 = 20000,      // Simply increase if too small (assembler will crash if too small).
+  compiler_stubs_code_size = 0 // Compiler intrinsic stubs are generated in code_size2.
 };
 
 // MethodHandles adapters
@@ -1500,6 +1500,7 @@ private:
 
   // Move Unaligned 256bit Vector
   void vmovdqu(Address dst, XMMRegister src);
+  void vmovntdq(Address dst, XMMRegister src);
   void vmovdqu(XMMRegister dst, Address src);
   void vmovdqu(XMMRegister dst, XMMRegister src);
 
@@ -1727,16 +1728,21 @@ private:
   void evpmovwb(Address dst, KRegister mask, XMMRegister src, int vector_len);
 
   void vpmovzxwd(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovzxwd(XMMRegister dst, Address src, int vector_len);
+  void vpmovzxbd(XMMRegister dst, Address src, int vector_len);
 
   void evpmovdb(Address dst, XMMRegister src, int vector_len);
 
   // Sign extend moves
   void pmovsxbw(XMMRegister dst, XMMRegister src);
   void vpmovsxbw(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovsxbd(XMMRegister dst, Address src, int vector_len);
+  void vpmovsxwd(XMMRegister dst, Address src, int vector_len);
 
   // Multiply add
   void pmaddwd(XMMRegister dst, XMMRegister src);
   void vpmaddwd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void vpmaddubsw(XMMRegister dst, XMMRegister src1, XMMRegister src2, int vector_len);
   // Multiply add accumulate
   void evpdpwssd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
 
@@ -2139,6 +2145,12 @@ private:
   void vpmulld(XMMRegister dst, XMMRegister nds, Address src, int vector_len);
   void vpmullq(XMMRegister dst, XMMRegister nds, Address src, int vector_len);
 
+  // Minimum and maximum of packed signed ints
+  void pminsd(XMMRegister dst, XMMRegister src);
+  void pmaxsd(XMMRegister dst, XMMRegister src);
+  void vpminsd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void vpmaxsd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+
   // Shift left packed integers
   void psllw(XMMRegister dst, int shift);
   void pslld(XMMRegister dst, int shift);
@@ -61,6 +61,17 @@ int C1_MacroAssembler::lock_object(Register hdr, Register obj, Register disp_hdr
     jcc(Assembler::notZero, slow_case);
   }
 
+  if (UseLightweightLocking) {
+#ifdef _LP64
+    assert(scratch != noreg, "should have scratch register at this point");
+    movptr(hdr, Address(obj, hdr_offset));
+    fast_lock_impl(obj, hdr, r15_thread, scratch, slow_case);
+    return null_check_offset;
+#else
+    ShouldNotReachHere();
+#endif // _LP64
+  }
+
   if (UseBiasedLocking) {
     assert(scratch != noreg, "should have scratch register at this point");
     biased_locking_enter(disp_hdr, obj, hdr, scratch, rklass_decode_tmp, false, done, &slow_case);
@@ -116,6 +127,27 @@ void C1_MacroAssembler::unlock_object(Register hdr, Register obj, Register disp_
   assert(hdr != obj && hdr != disp_hdr && obj != disp_hdr, "registers must be different");
   Label done;
 
+  if (UseLightweightLocking) {
+#ifdef _LP64
+    Label slow;
+    movptr(obj, Address(disp_hdr, BasicObjectLock::obj_offset_in_bytes()));
+    verify_oop(obj);
+    // The slow case needs the lock address, but rax is used by the cmpxchg.
+    push(disp_hdr);
+    movptr(disp_hdr, Address(obj, hdr_offset));
+    fast_unlock_impl(obj, disp_hdr, r15_thread, hdr, slow);
+    pop(disp_hdr);
+    jmp(done);
+    bind(slow);
+    pop(disp_hdr);
+    jmp(slow_case);
+    bind(done);
+    return;
+#else
+    ShouldNotReachHere();
+#endif // _LP64
+  }
+
   if (UseBiasedLocking) {
     // load object
     movptr(obj, Address(disp_hdr, BasicObjectLock::obj_offset_in_bytes()));
@@ -497,31 +497,42 @@ void C2_MacroAssembler::fast_lock(Register objReg, Register boxReg, Register tmp
 
   movptr(tmpReg, Address(objReg, oopDesc::mark_offset_in_bytes()));          // [FETCH]
   testptr(tmpReg, markWord::monitor_value); // inflated vs stack-locked|neutral|biased
-  jccb(Assembler::notZero, IsInflated);
-
-  // Attempt stack-locking ...
-  orptr (tmpReg, markWord::unlocked_value);
-  movptr(Address(boxReg, 0), tmpReg);          // Anticipate successful CAS
-  lock();
-  cmpxchgptr(boxReg, Address(objReg, oopDesc::mark_offset_in_bytes()));      // Updates tmpReg
-  if (counters != NULL) {
-    cond_inc32(Assembler::equal,
-               ExternalAddress((address)counters->fast_path_entry_count_addr()));
-  }
-  jcc(Assembler::equal, DONE_LABEL);           // Success
-
-  // Recursive locking.
-  // The object is stack-locked: markword contains stack pointer to BasicLock.
-  // Locked by current thread if difference with current SP is less than one page.
-  subptr(tmpReg, rsp);
-  // Next instruction set ZFlag == 1 (Success) if difference is less then one page.
-  andptr(tmpReg, (int32_t) (NOT_LP64(0xFFFFF003) LP64_ONLY(7 - os::vm_page_size())) );
-  movptr(Address(boxReg, 0), tmpReg);
-  if (counters != NULL) {
-    cond_inc32(Assembler::equal,
-               ExternalAddress((address)counters->fast_path_entry_count_addr()));
+  if (UseLightweightLocking) {
+#ifdef _LP64
+    jcc(Assembler::notZero, IsInflated);
+    // Both failure branches of fast_lock_impl leave ZF == 0.
+    fast_lock_impl(objReg, tmpReg, r15_thread, scrReg, DONE_LABEL);
+    xorl(tmpReg, tmpReg);                      // set ICC.ZF=1 to indicate success
+    jmp(DONE_LABEL);
+#else
+    ShouldNotReachHere();
+#endif // _LP64
+  } else {
+    jccb(Assembler::notZero, IsInflated);
+    // Attempt stack-locking ...
+    orptr (tmpReg, markWord::unlocked_value);
+    movptr(Address(boxReg, 0), tmpReg);          // Anticipate successful CAS
+    lock();
+    cmpxchgptr(boxReg, Address(objReg, oopDesc::mark_offset_in_bytes()));      // Updates tmpReg
+    if (counters != NULL) {
+      cond_inc32(Assembler::equal,
+                 ExternalAddress((address)counters->fast_path_entry_count_addr()));
+    }
+    jcc(Assembler::equal, DONE_LABEL);           // Success
+
+    // Recursive locking.
+    // The object is stack-locked: markword contains stack pointer to BasicLock.
+    // Locked by current thread if difference with current SP is less than one page.
+    subptr(tmpReg, rsp);
+    // Next instruction set ZFlag == 1 (Success) if difference is less then one page.
+    andptr(tmpReg, (int32_t) (NOT_LP64(0xFFFFF003) LP64_ONLY(7 - os::vm_page_size())) );
+    movptr(Address(boxReg, 0), tmpReg);
+    if (counters != NULL) {
+      cond_inc32(Assembler::equal,
+                 ExternalAddress((address)counters->fast_path_entry_count_addr()));
+    }
+    jmp(DONE_LABEL);
   }
-  jmp(DONE_LABEL);
 
   bind(IsInflated);
   // The object is inflated. tmpReg contains pointer to ObjectMonitor* + markWord::monitor_value
@@ -663,11 +674,36 @@ void C2_MacroAssembler::fast_unlock(Register objReg, Register boxReg, Register t
   }
 #endif
 
-  cmpptr(Address(boxReg, 0), (int32_t)NULL_WORD);                   // Examine the displaced header
-  jcc   (Assembler::zero, DONE_LABEL);                              // 0 indicates recursive stack-lock
+  if (!UseLightweightLocking) {
+    cmpptr(Address(boxReg, 0), (int32_t)NULL_WORD);                 // Examine the displaced header
+    jcc   (Assembler::zero, DONE_LABEL);                            // 0 indicates recursive stack-lock
+  }
   movptr(tmpReg, Address(objReg, oopDesc::mark_offset_in_bytes())); // Examine the object's markword
   testptr(tmpReg, markWord::monitor_value);                         // Inflated?
-  jccb  (Assembler::zero, Stacked);
+  if (UseLightweightLocking) {
+#ifdef _LP64
+    Label Inflated, NotAnonymous;
+    jcc(Assembler::notZero, Inflated);
+    // It's fast-locked. Both failure branches of fast_unlock_impl leave ZF == 0.
+    movptr(boxReg, tmpReg);
+    fast_unlock_impl(objReg, boxReg, r15_thread, tmpReg, DONE_LABEL);
+    xorl(tmpReg, tmpReg);                                           // set ICC.ZF=1 to indicate success
+    jmp(DONE_LABEL);
+
+    bind(Inflated);
+    // A monitor inflated by another thread while we had it fast-locked is
+    // owned anonymously. The runtime claims it and fixes up the lock stack.
+    cmpptr(Address(tmpReg, OM_OFFSET_NO_MONITOR_VALUE_TAG(owner)), (int32_t)(intptr_t)ANONYMOUS_OWNER);
+    jccb(Assembler::notEqual, NotAnonymous);
+    testptr(objReg, objReg);                                        // set ICC.ZF=0 to indicate failure
+    jmp(DONE_LABEL);
+    bind(NotAnonymous);
+#else
+    ShouldNotReachHere();
+#endif // _LP64
+  } else {
+    jccb  (Assembler::zero, Stacked);
+  }
 
   // It's inflated.
 #if INCLUDE_RTM_OPT
@@ -1047,6 +1083,9 @@ void C2_MacroAssembler::reduce_operation_128(int opcode, XMMRegister dst, XMMReg
     case Op_MulReductionVI: pmulld(dst, src); break;
     case Op_MulReductionVL: vpmullq(dst, dst, src, vector_len); break;
 
+    case Op_MinReductionV:  pminsd(dst, src); break;
+    case Op_MaxReductionV:  pmaxsd(dst, src); break;
+
     default: assert(false, "wrong opcode");
   }
 }
@@ -1065,6 +1104,9 @@ void C2_MacroAssembler::reduce_operation_256(int opcode, XMMRegister dst,  XMMRe
     case Op_MulReductionVI: vpmulld(dst, src1, src2, vector_len); break;
     case Op_MulReductionVL: vpmullq(dst, src1, src2, vector_len); break;
 
+    case Op_MinReductionV:  vpminsd(dst, src1, src2, vector_len); break;
+    case Op_MaxReductionV:  vpmaxsd(dst, src1, src2, vector_len); break;
+
     default: assert(false, "wrong opcode");
   }
 }
@@ -214,6 +214,14 @@ define_pd_global(intx, InitArrayShortSize, 8*BytesPerLong);
              "compare operations can also use AVX512 intrinsics.")          \
              range(0, max_jint)                                             \
                                                                             \
+  /* Copies at least this large are done with non-temporal stores so */     \
+  /* they do not evict the working set of other threads from the */         \
+  /* shared cache. */                                                       \
+  product(intx, ArrayCopyNonTemporalThreshold, 4*M, DIAGNOSTIC,             \
+             "Minimum array copy size in bytes to use non-temporal "        \
+             "stores in the AVX2 copy stubs. Zero disables them.")          \
+             range(0, max_jint)                                             \
+                                                                            \
   product(bool, IntelJccErratumMitigation, true, DIAGNOSTIC,                \
              "Turn off JVM mitigations related to Intel micro code "        \
              "mitigations for the Intel JCC erratum")
@@ -1275,6 +1275,56 @@ void MacroAssembler::biased_locking_exit(Register obj_reg, Register temp_reg, La
   jcc(Assembler::equal, done);
 }
 
+#ifdef _LP64
+void MacroAssembler::fast_lock_impl(Register obj, Register hdr, Register thread, Register tmp, Label& slow) {
+  assert(UseLightweightLocking, "why call this otherwise?");
+  assert(hdr == rax, "header must be in rax for cmpxchg");
+  assert_different_registers(obj, hdr, thread, tmp);
+
+  // Check that the lock stack has room for the object.
+  movl(tmp, Address(thread, JavaThread::lock_stack_top_offset()));
+  cmpl(tmp, LockStack::end_offset() - 1);
+  jcc(Assembler::greater, slow);
+
+  // Expect an unlocked header and swing its lock bits to locked, leaving
+  // the rest of the header in place.
+  andptr(hdr, ~(int32_t)markWord::lock_mask_in_place);
+  movptr(tmp, hdr);
+  orptr(hdr, markWord::unlocked_value);
+  lock();
+  cmpxchgptr(tmp, Address(obj, oopDesc::mark_offset_in_bytes()));
+  jcc(Assembler::notEqual, slow);
+
+  // Push the object on the lock stack.
+  movl(tmp, Address(thread, JavaThread::lock_stack_top_offset()));
+  movptr(Address(thread, tmp), obj);
+  addl(tmp, oopSize);
+  movl(Address(thread, JavaThread::lock_stack_top_offset()), tmp);
+}
+
+void MacroAssembler::fast_unlock_impl(Register obj, Register hdr, Register thread, Register tmp, Label& slow) {
+  assert(UseLightweightLocking, "why call this otherwise?");
+  assert(hdr == rax, "header must be in rax for cmpxchg");
+  assert_different_registers(obj, hdr, thread, tmp);
+
+  // Unlocking out of order is allowed but left to the runtime.
+  movl(tmp, Address(thread, JavaThread::lock_stack_top_offset()));
+  cmpptr(obj, Address(thread, tmp, Address::times_1, -oopSize));
+  jcc(Assembler::notEqual, slow);
+
+  // Expect a fast-locked header and swing its lock bits back to unlocked.
+  andptr(hdr, ~(int32_t)markWord::lock_mask_in_place);
+  movptr(tmp, hdr);
+  orptr(tmp, markWord::unlocked_value);
+  lock();
+  cmpxchgptr(tmp, Address(obj, oopDesc::mark_offset_in_bytes()));
+  jcc(Assembler::notEqual, slow);
+
+  // Pop the object from the lock stack.
+  subl(Address(thread, JavaThread::lock_stack_top_offset()), oopSize);
+}
+#endif // _LP64
+
 void MacroAssembler::c2bool(Register x) {
   // implements x == 0 ? 0 : 1
   // note: must only look at least-significant byte of x
@@ -3631,6 +3681,39 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   LP64_ONLY( incrementl(Address(rcx, 0)) );
 #endif //PRODUCT
 
+#ifdef _LP64
+  // Probe the hashed secondary supers table first, see
+  // Klass::lookup_secondary_supers_table(). A clear slot bit is a definite
+  // miss, and without collisions a single compare finds the super.
+  Label L_linear_scan, L_table_done;
+  const bool use_table = UseSecondarySupersTable && UsePopCountInstruction && sub_klass != rdi;
+  if (use_table) {
+    Label L_probe;
+    movptr(rdi, Address(sub_klass, in_bytes(Klass::secondary_supers_bitmap_offset())));
+    cmpptr(rdi, (int32_t)Klass::SECONDARY_SUPERS_BITMAP_FULL);
+    jcc(Assembler::equal, L_linear_scan);
+    // Shift the slot bit of super_klass into the sign bit; the bits of
+    // the lower slots stay below it.
+    movzbl(rcx, Address(rax, in_bytes(Klass::hash_slot_offset())));
+    xorl(rcx, Klass::SECONDARY_SUPERS_TABLE_MASK);
+    shlq(rdi);
+    testptr(rdi, rdi);
+    jccb(Assembler::negative, L_probe);
+    movptr(rdi, secondary_supers_addr); // rdi must be left non-NULL
+    testptr(rax, rax); // Set Z = 0
+    jmp(L_table_done);
+
+    bind(L_probe);
+    // One more than the number of entries in lower slots
+    popcntq(rcx, rdi);
+    movptr(rdi, secondary_supers_addr);
+    cmpptr(rax, Address(rdi, rcx, Address::times_ptr, Array<Klass*>::base_offset_in_bytes() - wordSize));
+    jcc(Assembler::equal, L_table_done);
+    // Slot collision, fall back to the linear scan.
+  }
+  bind(L_linear_scan);
+#endif // _LP64
+
   // We will consult the secondary-super array.
   movptr(rdi, secondary_supers_addr);
   // Load the array length.  (Positive movl does right thing on LP64.)
@@ -3669,6 +3752,24 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
     jmp(*L_success);
   }
 
+#ifdef _LP64
+  if (use_table) {
+    if (L_success == &L_fallthrough) {
+      jmp(L_fallthrough);
+    }
+    // The table answered. Cache a super it found, like the scan does.
+    bind(L_table_done);
+    if (pushed_rdi)  pop(rdi);
+    if (pushed_rcx)  pop(rcx);
+    if (pushed_rax)  pop(rax);
+    jcc(Assembler::notEqual, *L_failure);
+    movptr(super_cache_addr, super_klass);
+    if (L_success != &L_fallthrough) {
+      jmp(*L_success);
+    }
+  }
+#endif // _LP64
+
 #undef IS_A_TEMP
 
   bind(L_fallthrough);
@@ -668,6 +668,16 @@ class MacroAssembler: public Assembler {
                             BiasedLockingCounters* counters = NULL);
   void biased_locking_exit (Register obj_reg, Register temp_reg, Label& done);
 
+#ifdef _LP64
+  // Lightweight locking support (UseLightweightLocking)
+  // hdr must be rax and hold the object's mark word on entry; hdr and tmp
+  // are killed. fast_lock_impl branches to slow if the mark is not neutral
+  // or the lock stack is full. fast_unlock_impl branches to slow if obj is
+  // not the most recent lock stack entry or its mark is not fast-locked.
+  void fast_lock_impl(Register obj, Register hdr, Register thread, Register tmp, Label& slow);
+  void fast_unlock_impl(Register obj, Register hdr, Register thread, Register tmp, Label& slow);
+#endif
+
   Condition negate_condition(Condition cond);
 
   // Instructions that use AddressLiteral operands. These instruction can handle 32bit/64bit
@@ -1988,13 +1988,18 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
 
             // rax has pinned array
             VMRegPair result_reg(rax->as_VMReg());
+            // Record the pinned array in the oop map so that it is kept
+            // alive while the native runs.
             if (!in_arg.first()->is_stack()) {
               assert(pinned_slot <= stack_slots, "overflow");
               simple_move32(masm, result_reg, VMRegImpl::stack2reg(pinned_slot));
+              map->set_oop(VMRegImpl::stack2reg(pinned_slot));
               pinned_slot += VMRegImpl::slots_per_word;
             } else {
               // Write back pinned value, it will be used to unpin this argument
               __ movptr(Address(rbp, reg2offset_in(in_arg.first())), result_reg.first()->as_Register());
+              int offset_in_older_frame = in_arg.first()->reg2stack() + SharedRuntime::out_preserve_stack_slots();
+              map->set_oop(VMRegImpl::stack2reg(offset_in_older_frame + stack_slots));
             }
             // We have the array in register, use it
             in_arg = result_reg;
@@ -32,6 +32,7 @@
 #include "interpreter/interpreter.hpp"
 #include "memory/universe.hpp"
 #include "nativeInst_x86.hpp"
+#include "oops/compiledICHolder.hpp"
 #include "oops/instanceOop.hpp"
 #include "oops/method.hpp"
 #include "oops/objArrayKlass.hpp"
@@ -1106,6 +1107,103 @@ class StubGenerator: public StubCodeGenerator {
 #endif
   }
 
+  // Branch to L_nontemporal if a copy of qword_count qwords is large enough
+  // to be done with non-temporal stores and the destination is qword aligned.
+  // Copies that large would otherwise flush the caches of other threads.
+  void nontemporal_copy_check(Register dest, Register qword_count, bool forward,
+                              Label& L_nontemporal) {
+    Label L_temporal;
+    int threshold = MAX2((int)ArrayCopyNonTemporalThreshold, 256) / 8;
+    if (forward) {
+      __ cmpptr(qword_count, -threshold);
+      __ jccb(Assembler::greater, L_temporal);
+    } else {
+      __ cmpptr(qword_count, threshold);
+      __ jccb(Assembler::less, L_temporal);
+    }
+    __ testptr(dest, 7);
+    __ jcc(Assembler::zero, L_nontemporal);
+    __ BIND(L_temporal);
+  }
+
+  // Copy big chunks forward with non-temporal stores
+  //
+  // Inputs:
+  //   end_from     - source arrays end address
+  //   end_to       - destination array end address, qword aligned
+  //   qword_count  - 64-bits element count, negative
+  //   to           - scratch
+  //   L_nontemporal - entry label
+  //   L_tail       - exit label, reached in the state the 64-byte loop leaves
+  //
+  void copy_bytes_forward_nontemporal(Register end_from, Register end_to,
+                                      Register qword_count, Register to,
+                                      Label& L_nontemporal, Label& L_tail) {
+    Label L_loop, L_align, L_aligned;
+    __ BIND(L_nontemporal);
+    // Copy single qwords until the destination is 32-byte aligned
+    __ BIND(L_align);
+    __ lea(to, Address(end_to, qword_count, Address::times_8, 8));
+    __ testptr(to, 31);
+    __ jcc(Assembler::zero, L_aligned);
+    __ movq(to, Address(end_from, qword_count, Address::times_8, 8));
+    __ movq(Address(end_to, qword_count, Address::times_8, 8), to);
+    __ incrementq(qword_count);
+    __ jmpb(L_align);
+
+    __ align(OptoLoopAlignment);
+    __ BIND(L_loop);
+    __ vmovdqu(xmm0, Address(end_from, qword_count, Address::times_8, -56));
+    __ vmovntdq(Address(end_to, qword_count, Address::times_8, -56), xmm0);
+    __ vmovdqu(xmm1, Address(end_from, qword_count, Address::times_8, -24));
+    __ vmovntdq(Address(end_to, qword_count, Address::times_8, -24), xmm1);
+    __ BIND(L_aligned);
+    __ addptr(qword_count, 8);
+    __ jcc(Assembler::lessEqual, L_loop);
+    // Non-temporal stores are weakly ordered
+    __ sfence();
+    __ jmp(L_tail);
+  }
+
+  // Copy big chunks backward with non-temporal stores
+  //
+  // Inputs:
+  //   from         - source arrays address
+  //   dest         - destination array address, qword aligned
+  //   qword_count  - 64-bits element count
+  //   to           - scratch
+  //   L_nontemporal - entry label
+  //   L_tail       - exit label, reached in the state the 64-byte loop leaves
+  //
+  void copy_bytes_backward_nontemporal(Register from, Register dest,
+                                       Register qword_count, Register to,
+                                       Label& L_nontemporal, Label& L_tail) {
+    Label L_loop, L_align, L_aligned;
+    __ BIND(L_nontemporal);
+    // Copy single qwords until the destination end is 32-byte aligned
+    __ BIND(L_align);
+    __ lea(to, Address(dest, qword_count, Address::times_8, 0));
+    __ testptr(to, 31);
+    __ jcc(Assembler::zero, L_aligned);
+    __ decrementq(qword_count);
+    __ movq(to, Address(from, qword_count, Address::times_8, 0));
+    __ movq(Address(dest, qword_count, Address::times_8, 0), to);
+    __ jmpb(L_align);
+
+    __ align(OptoLoopAlignment);
+    __ BIND(L_loop);
+    __ vmovdqu(xmm0, Address(from, qword_count, Address::times_8, 32));
+    __ vmovntdq(Address(dest, qword_count, Address::times_8, 32), xmm0);
+    __ vmovdqu(xmm1, Address(from, qword_count, Address::times_8, 0));
+    __ vmovntdq(Address(dest, qword_count, Address::times_8, 0), xmm1);
+    __ BIND(L_aligned);
+    __ subptr(qword_count, 8);
+    __ jcc(Assembler::greaterEqual, L_loop);
+    // Non-temporal stores are weakly ordered
+    __ sfence();
+    __ jmp(L_tail);
+  }
+
   // Copy big chunks forward
   //
   // Inputs:
@@ -1120,15 +1218,22 @@ class StubGenerator: public StubCodeGenerator {
                              Register qword_count, Register to,
                              Label& L_copy_bytes, Label& L_copy_8_bytes) {
     DEBUG_ONLY(__ stop("enter at entry label, not here"));
-    Label L_loop;
+    Label L_loop, L_nontemporal, L_32_byte_head;
+    const bool use_nontemporal = UseUnalignedLoadStores && UseAVX >= 2 && ArrayCopyNonTemporalThreshold > 0;
+    if (use_nontemporal) {
+      copy_bytes_forward_nontemporal(end_from, end_to, qword_count, to, L_nontemporal, L_32_byte_head);
+    }
     __ align(OptoLoopAlignment);
     if (UseUnalignedLoadStores) {
       Label L_end;
       // Copy 64-bytes per iteration
       if (UseAVX > 2) {
-        Label L_loop_avx512, L_loop_avx2, L_32_byte_head, L_above_threshold, L_below_threshold;
+        Label L_loop_avx512, L_loop_avx2, L_above_threshold, L_below_threshold;
 
         __ BIND(L_copy_bytes);
+        if (use_nontemporal) {
+          nontemporal_copy_check(end_to, qword_count, true, L_nontemporal);
+        }
         __ cmpptr(qword_count, (-1 * AVX3Threshold / 8));
         __ jccb(Assembler::less, L_above_threshold);
         __ jmpb(L_below_threshold);
@@ -1172,8 +1277,12 @@ class StubGenerator: public StubCodeGenerator {
         }
 
         __ BIND(L_copy_bytes);
+        if (use_nontemporal) {
+          nontemporal_copy_check(end_to, qword_count, true, L_nontemporal);
+        }
         __ addptr(qword_count, 8);
         __ jcc(Assembler::lessEqual, L_loop);
+        __ BIND(L_32_byte_head);
         __ subptr(qword_count, 4);  // sub(8) and add(4)
         __ jccb(Assembler::greater, L_end);
       }
@@ -1228,15 +1337,22 @@ class StubGenerator: public StubCodeGenerator {
                               Register qword_count, Register to,
                               Label& L_copy_bytes, Label& L_copy_8_bytes) {
     DEBUG_ONLY(__ stop("enter at entry label, not here"));
-    Label L_loop;
+    Label L_loop, L_nontemporal, L_32_byte_head;
+    const bool use_nontemporal = UseUnalignedLoadStores && UseAVX >= 2 && ArrayCopyNonTemporalThreshold > 0;
+    if (use_nontemporal) {
+      copy_bytes_backward_nontemporal(from, dest, qword_count, to, L_nontemporal, L_32_byte_head);
+    }
     __ align(OptoLoopAlignment);
     if (UseUnalignedLoadStores) {
       Label L_end;
       // Copy 64-bytes per iteration
       if (UseAVX > 2) {
-        Label L_loop_avx512, L_loop_avx2, L_32_byte_head, L_above_threshold, L_below_threshold;
+        Label L_loop_avx512, L_loop_avx2, L_above_threshold, L_below_threshold;
 
         __ BIND(L_copy_bytes);
+        if (use_nontemporal) {
+          nontemporal_copy_check(dest, qword_count, false, L_nontemporal);
+        }
         __ cmpptr(qword_count, (AVX3Threshold / 8));
         __ jccb(Assembler::greater, L_above_threshold);
         __ jmpb(L_below_threshold);
@@ -1280,9 +1396,13 @@ class StubGenerator: public StubCodeGenerator {
         }
 
         __ BIND(L_copy_bytes);
+        if (use_nontemporal) {
+          nontemporal_copy_check(dest, qword_count, false, L_nontemporal);
+        }
         __ subptr(qword_count, 8);
         __ jcc(Assembler::greaterEqual, L_loop);
 
+        __ BIND(L_32_byte_head);
         __ addptr(qword_count, 4);  // add(8) and sub(4)
         __ jccb(Assembler::less, L_end);
       }
@@ -5173,6 +5293,369 @@ address generate_avx_ghash_processBlocks() {
     return start;
   }
 
+  // Lookup tables for base64 decoding. Each 16-byte table is repeated so
+  // that vpshufb sees it in both 128-bit lanes.
+  //   0: base64 alphabet   (lut_lo, lut_hi, lut_roll, '/')
+  // 128: base64url alphabet (lut_lo, lut_hi, lut_roll, '_')
+  // 256: nibble mask, pmaddubsw and pmaddwd multipliers, output shuffle
+  address base64_decoding_table_addr() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "base64_decoding_table");
+    address start = __ pc();
+    const jlong table[] = {
+      // base64: lut_lo, lut_hi, lut_roll, '/'
+      0x1111111111111115, 0x1a1b1b1b1a131111,
+      0x0804080402011010, 0x1010101010101010,
+      (jlong)0xb9b9bfbf04130000, 0x0000100000000000,
+      0x2f2f2f2f2f2f2f2f, 0x2f2f2f2f2f2f2f2f,
+      // base64url: lut_lo, lut_hi, lut_roll, '_'
+      0x1111111111111115, 0x333b3a3b3b131111,
+      0x2004080402011010, 0x1010101010101010,
+      (jlong)0xb9b9bfbf04110000, 0x0000000000e00000,
+      0x5f5f5f5f5f5f5f5f, 0x5f5f5f5f5f5f5f5f,
+      // nibble mask, pmaddubsw and pmaddwd multipliers, output shuffle
+      0x0f0f0f0f0f0f0f0f, 0x0f0f0f0f0f0f0f0f,
+      0x0140014001400140, 0x0140014001400140,
+      0x0001100000011000, 0x0001100000011000,
+      0x090a040506000102, (jlong)0x808080800c0d0e08
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(table); i += 2) {
+      // both 128-bit lanes
+      __ emit_data64(table[i], relocInfo::none);
+      __ emit_data64(table[i + 1], relocInfo::none);
+      __ emit_data64(table[i], relocInfo::none);
+      __ emit_data64(table[i + 1], relocInfo::none);
+    }
+    return start;
+  }
+
+  // Decodes base64 in blocks of 32 characters into 24 bytes with AVX2
+  // (Mula and Lemire, "Faster Base64 Encoding and Decoding using AVX2
+  // Instructions"). Stops before the first block containing a character
+  // outside the alphabet, which includes padding and MIME line
+  // separators, and leaves the rest of the input to the Java code.
+  //
+  // Arguments:
+  //
+  // Inputs:
+  //   c_rarg0   - byte[] source array address
+  //   c_rarg1   - int source start offset
+  //   c_rarg2   - int source end offset
+  //   c_rarg3   - byte[] destination array address
+  //   c_rarg4   - int destination start offset
+  //   c_rarg5   - boolean isURL
+  //   isMIME (not read: line separators end a block like any other
+  //   character outside the alphabet)
+  //
+  // Output:
+  //   rax       - number of bytes written to the destination
+  address generate_base64_decodeBlock() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "implDecode");
+    address start = __ pc();
+    __ enter();
+
+    // Save callee-saved registers before using them
+    __ push(r12);
+    __ push(r13);
+
+    // arguments
+    const Register source = c_rarg0; // Source Array
+    const Register start_offset = c_rarg1; // start offset
+    const Register end_offset = c_rarg2; // end offset
+    const Register dest = c_rarg3; // destination array
+
+#ifndef _WIN64
+    const Register dp = c_rarg4;  // Position for writing to dest array
+    const Register isURL = c_rarg5;// Base64 or URL character set
+#else
+    const Address  dp_mem(rbp, 6 * wordSize);  // dp is on stack on Win64
+    const Address isURL_mem(rbp, 7 * wordSize);
+    const Register isURL = r10;      // pick the volatile windows registers
+    const Register dp = r11;
+    __ movl(dp, dp_mem);
+    __ movl(isURL, isURL_mem);
+    // xmm6-xmm11 are callee-saved on Win64
+    __ subptr(rsp, 6 * wordSize * 2);
+    for (int i = 6; i <= 11; i++) {
+      __ movdqu(Address(rsp, (i - 6) * wordSize * 2), as_XMMRegister(i));
+    }
+#endif
+
+    const Register table = r12;
+    const Register dp_start = r13;
+
+    const XMMRegister input    = xmm0;
+    const XMMRegister hi       = xmm1;
+    const XMMRegister tmp      = xmm2;
+    const XMMRegister tmp2     = xmm3;
+    const XMMRegister lut_lo   = xmm4;
+    const XMMRegister lut_hi   = xmm5;
+    const XMMRegister lut_roll = xmm6;
+    const XMMRegister special  = xmm7;
+    const XMMRegister mask     = xmm8;
+    const XMMRegister merge_ab = xmm9;
+    const XMMRegister merge_bc = xmm10;
+    const XMMRegister pack     = xmm11;
+
+    Label L_loop, L_exit, L_load_tables;
+
+    // the offsets are non-negative ints; clear the upper halves
+    __ movl(start_offset, start_offset);
+    __ movl(dp, dp);
+    __ movl(dp_start, dp);
+
+    __ lea(table, ExternalAddress(StubRoutines::x86::base64_decoding_table_addr()));
+    __ vmovdqu(mask, Address(table, 256));
+    __ vmovdqu(merge_ab, Address(table, 288));
+    __ vmovdqu(merge_bc, Address(table, 320));
+    __ vmovdqu(pack, Address(table, 352));
+    __ cmpl(isURL, 0);
+    __ jcc(Assembler::equal, L_load_tables);
+    __ addptr(table, 128);
+    __ BIND(L_load_tables);
+    __ vmovdqu(lut_lo, Address(table, 0));
+    __ vmovdqu(lut_hi, Address(table, 32));
+    __ vmovdqu(lut_roll, Address(table, 64));
+    __ vmovdqu(special, Address(table, 96));
+
+    __ BIND(L_loop);
+    __ movl(rax, end_offset);
+    __ subl(rax, start_offset);
+    __ cmpl(rax, 32);
+    __ jcc(Assembler::less, L_exit);
+
+    __ vmovdqu(input, Address(source, start_offset, Address::times_1));
+
+    // Validate: a character is in the alphabet iff the class bits looked
+    // up by its low nibble and by its high nibble do not intersect.
+    __ vpsrld(hi, input, 4, Assembler::AVX_256bit);
+    __ vpand(hi, hi, mask, Assembler::AVX_256bit);
+    __ vpand(tmp, input, mask, Assembler::AVX_256bit);
+    __ vpshufb(tmp, lut_lo, tmp, Assembler::AVX_256bit);
+    __ vpshufb(tmp2, lut_hi, hi, Assembler::AVX_256bit);
+    __ vptest(tmp, tmp2);
+    __ jcc(Assembler::notZero, L_exit);
+
+    // Translate to 6-bit values: the offset to add depends on the high
+    // nibble, except for the one character ('/' or '_') that shares its
+    // high nibble with others and gets a table slot of its own.
+    __ vpcmpeqb(tmp, input, special, Assembler::AVX_256bit);
+    __ vpand(tmp, tmp, mask, Assembler::AVX_256bit);
+    __ vpxor(hi, hi, tmp, Assembler::AVX_256bit);
+    __ vpshufb(hi, lut_roll, hi, Assembler::AVX_256bit);
+    __ vpaddb(input, input, hi, Assembler::AVX_256bit);
+
+    // Pack each group of four 6-bit values into three bytes.
+    __ vpmaddubsw(input, input, merge_ab, Assembler::AVX_256bit);
+    __ vpmaddwd(input, input, merge_bc, Assembler::AVX_256bit);
+    __ vpshufb(input, input, pack, Assembler::AVX_256bit);
+
+    // Each lane now holds 12 decoded bytes. Store exactly 24 bytes; the
+    // high lane overwrites the 4 zero bytes the low lane store leaves.
+    __ movdqu(Address(dest, dp, Address::times_1), input);
+    __ vextracti128_high(tmp, input);
+    __ movq(Address(dest, dp, Address::times_1, 12), tmp);
+    __ psrldq(tmp, 8);
+    __ movdl(rax, tmp);
+    __ movl(Address(dest, dp, Address::times_1, 20), rax);
+
+    __ addl(start_offset, 32);
+    __ addl(dp, 24);
+    __ jmp(L_loop);
+
+    __ BIND(L_exit);
+    __ vzeroupper();
+    __ movl(rax, dp);
+    __ subl(rax, dp_start);
+#ifdef _WIN64
+    for (int i = 6; i <= 11; i++) {
+      __ movdqu(as_XMMRegister(i), Address(rsp, (i - 6) * wordSize * 2));
+    }
+    __ addptr(rsp, 6 * wordSize * 2);
+#endif
+    __ pop(r13);
+    __ pop(r12);
+    __ leave();
+    __ ret(0);
+    return start;
+  }
+
+  // Constants for the ChaCha20 block stub: vpshufb masks rotating each
+  // dword left by 16 and by 8, then the block counter increments for the
+  // two pairs of blocks (0 | 1 and 2 | 3, low | high lane).
+  address chacha20_constants_addr() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "chacha20_constants");
+    address start = __ pc();
+    for (int i = 0; i < 4; i++) {
+      __ emit_data64(0x0504070601000302, relocInfo::none); // rotl 16
+    }
+    for (int i = 0; i < 4; i++) {
+      __ emit_data64(0x0605040702010003, relocInfo::none); // rotl 8
+    }
+    __ emit_data64(0x0000000000000000, relocInfo::none);   // +0 | +1
+    __ emit_data64(0x0000000000000000, relocInfo::none);
+    __ emit_data64(0x0000000000000001, relocInfo::none);
+    __ emit_data64(0x0000000000000000, relocInfo::none);
+    __ emit_data64(0x0000000000000002, relocInfo::none);   // +2 | +3
+    __ emit_data64(0x0000000000000000, relocInfo::none);
+    __ emit_data64(0x0000000000000003, relocInfo::none);
+    __ emit_data64(0x0000000000000000, relocInfo::none);
+    return start;
+  }
+
+  // Rotates each dword of x left by bits, using tmp for shift counts that
+  // are not a multiple of 8.
+  void chacha20_rotl(XMMRegister x, int bits, XMMRegister tmp, XMMRegister shuffle) {
+    if (shuffle != xnoreg) {
+      __ vpshufb(x, x, shuffle, Assembler::AVX_256bit);
+    } else {
+      __ vpslld(tmp, x, bits, Assembler::AVX_256bit);
+      __ vpsrld(x, x, 32 - bits, Assembler::AVX_256bit);
+      __ vpor(x, x, tmp, Assembler::AVX_256bit);
+    }
+  }
+
+  // One quarter round on all four columns of two register sets; each
+  // register holds one row of the state of two blocks.
+  void chacha20_quarter_round(const XMMRegister* s1, const XMMRegister* s2, XMMRegister tmp,
+                              XMMRegister rot16, XMMRegister rot8) {
+    const XMMRegister* sets[2] = { s1, s2 };
+    for (int i = 0; i < 2; i++) { // a += b; d ^= a; d <<<= 16
+      __ vpaddd(sets[i][0], sets[i][0], sets[i][1], Assembler::AVX_256bit);
+      __ vpxor(sets[i][3], sets[i][3], sets[i][0], Assembler::AVX_256bit);
+      chacha20_rotl(sets[i][3], 16, tmp, rot16);
+    }
+    for (int i = 0; i < 2; i++) { // c += d; b ^= c; b <<<= 12
+      __ vpaddd(sets[i][2], sets[i][2], sets[i][3], Assembler::AVX_256bit);
+      __ vpxor(sets[i][1], sets[i][1], sets[i][2], Assembler::AVX_256bit);
+      chacha20_rotl(sets[i][1], 12, tmp, xnoreg);
+    }
+    for (int i = 0; i < 2; i++) { // a += b; d ^= a; d <<<= 8
+      __ vpaddd(sets[i][0], sets[i][0], sets[i][1], Assembler::AVX_256bit);
+      __ vpxor(sets[i][3], sets[i][3], sets[i][0], Assembler::AVX_256bit);
+      chacha20_rotl(sets[i][3], 8, tmp, rot8);
+    }
+    for (int i = 0; i < 2; i++) { // c += d; b ^= c; b <<<= 7
+      __ vpaddd(sets[i][2], sets[i][2], sets[i][3], Assembler::AVX_256bit);
+      __ vpxor(sets[i][1], sets[i][1], sets[i][2], Assembler::AVX_256bit);
+      chacha20_rotl(sets[i][1], 7, tmp, xnoreg);
+    }
+  }
+
+  // Rotates rows b, c and d of both sets by one, two and three dwords,
+  // moving between column and diagonal order (shuffles 0x39, 0x4E, 0x93)
+  // or back again (0x93, 0x4E, 0x39).
+  void chacha20_shuffle_rows(const XMMRegister* s1, const XMMRegister* s2, int b_mode, int d_mode) {
+    const XMMRegister* sets[2] = { s1, s2 };
+    for (int i = 0; i < 2; i++) {
+      __ vpshufd(sets[i][1], sets[i][1], b_mode, Assembler::AVX_256bit);
+      __ vpshufd(sets[i][2], sets[i][2], 0x4E, Assembler::AVX_256bit);
+      __ vpshufd(sets[i][3], sets[i][3], d_mode, Assembler::AVX_256bit);
+    }
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Inputs:
+   *   c_rarg0   - int[]  initial ChaCha20 state, 16 words
+   *   c_rarg1   - byte[] key stream output, at least 256 bytes
+   *
+   *  Output:
+   *       rax   - number of key stream bytes written (256)
+   *
+   *  Computes four consecutive 64-byte ChaCha20 key stream blocks with
+   *  block counters state[12] + 0 .. 3. Each ymm register holds one row
+   *  of the state for two blocks, one per 128-bit lane, and the two
+   *  register sets are interleaved to hide latencies.
+   */
+  address generate_chacha20Block_avx2() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "chacha20Block");
+    address start = __ pc();
+    __ enter();
+
+    const Register state  = c_rarg0;
+    const Register result = c_rarg1;
+    const Register consts = r10;
+    const Register rounds = r11;
+
+#ifdef _WIN64
+    // xmm6-xmm10 are callee-saved on Win64
+    __ subptr(rsp, 5 * wordSize * 2);
+    for (int i = 6; i <= 10; i++) {
+      __ movdqu(Address(rsp, (i - 6) * wordSize * 2), as_XMMRegister(i));
+    }
+#endif
+
+    const XMMRegister set1[4] = { xmm0, xmm1, xmm2, xmm3 };
+    const XMMRegister set2[4] = { xmm4, xmm5, xmm6, xmm7 };
+    const XMMRegister tmp   = xmm8;
+    const XMMRegister rot16 = xmm9;
+    const XMMRegister rot8  = xmm10;
+
+    Label L_double_round;
+
+    __ lea(consts, ExternalAddress(StubRoutines::x86::chacha20_constants_addr()));
+    __ vmovdqu(rot16, Address(consts, 0));
+    __ vmovdqu(rot8, Address(consts, 32));
+
+    // Load each row of the state into both lanes, and give every block
+    // its own counter.
+    for (int row = 0; row < 4; row++) {
+      __ movdqu(set1[row], Address(state, row * 16));
+      __ vinserti128_high(set1[row], Address(state, row * 16));
+    }
+    __ vpaddd(set2[3], set1[3], Address(consts, 96), Assembler::AVX_256bit);
+    __ vpaddd(set1[3], set1[3], Address(consts, 64), Assembler::AVX_256bit);
+    for (int row = 0; row < 3; row++) {
+      __ vmovdqu(set2[row], set1[row]);
+    }
+
+    __ movl(rounds, 10);
+    __ BIND(L_double_round);
+    chacha20_quarter_round(set1, set2, tmp, rot16, rot8);
+    chacha20_shuffle_rows(set1, set2, 0x39, 0x93);
+    chacha20_quarter_round(set1, set2, tmp, rot16, rot8);
+    chacha20_shuffle_rows(set1, set2, 0x93, 0x39);
+    __ decrementl(rounds);
+    __ jcc(Assembler::notZero, L_double_round);
+
+    // Add the initial state back in.
+    for (int row = 0; row < 4; row++) {
+      __ movdqu(tmp, Address(state, row * 16));
+      __ vinserti128_high(tmp, Address(state, row * 16));
+      if (row == 3) {
+        __ vpaddd(set2[3], set2[3], Address(consts, 96), Assembler::AVX_256bit);
+        __ vpaddd(set1[3], set1[3], Address(consts, 64), Assembler::AVX_256bit);
+      }
+      __ vpaddd(set1[row], set1[row], tmp, Assembler::AVX_256bit);
+      __ vpaddd(set2[row], set2[row], tmp, Assembler::AVX_256bit);
+    }
+
+    // Blocks 0 and 2 are in the low lanes, blocks 1 and 3 in the high.
+    for (int row = 0; row < 4; row++) {
+      __ movdqu(Address(result, 0 * 64 + row * 16), set1[row]);
+      __ vextracti128_high(Address(result, 1 * 64 + row * 16), set1[row]);
+      __ movdqu(Address(result, 2 * 64 + row * 16), set2[row]);
+      __ vextracti128_high(Address(result, 3 * 64 + row * 16), set2[row]);
+    }
+
+    __ vzeroupper();
+#ifdef _WIN64
+    for (int i = 6; i <= 10; i++) {
+      __ movdqu(as_XMMRegister(i), Address(rsp, (i - 6) * wordSize * 2));
+    }
+    __ addptr(rsp, 5 * wordSize * 2);
+#endif
+    __ movl(rax, 4 * 64);
+    __ leave();
+    __ ret(0);
+    return start;
+  }
+
   /**
    *  Arguments:
    *
@@ -5396,6 +5879,339 @@ address generate_avx_ghash_processBlocks() {
     return start;
   }
 
+  // Weights 8 .. 1 of the eight byte lanes used by the Adler32 stub.
+  address adler32_weights_addr() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "adler32_weights");
+    address start = __ pc();
+    __ emit_data64(0x0000000700000008, relocInfo::none);
+    __ emit_data64(0x0000000500000006, relocInfo::none);
+    __ emit_data64(0x0000000300000004, relocInfo::none);
+    __ emit_data64(0x0000000100000002, relocInfo::none);
+    return start;
+  }
+
+  // Sums the eight int lanes of src into dst. Clobbers tmp and src.
+  void adler32_sum_lanes(Register dst, XMMRegister src, XMMRegister tmp) {
+    __ vextracti128_high(tmp, src);
+    __ vpaddd(src, src, tmp, Assembler::AVX_128bit);
+    __ vphaddd(src, src, src, Assembler::AVX_128bit);
+    __ vphaddd(src, src, src, Assembler::AVX_128bit);
+    __ movdl(dst, src);
+  }
+
+  // s = s % BASE, for an unsigned 32-bit s. Clobbers rax, rdx and tmp.
+  void adler32_mod(Register s, Register tmp) {
+    __ movl(rax, s);
+    __ xorl(rdx, rdx);
+    __ movl(tmp, 65521);
+    __ divl(tmp);
+    __ movl(s, rdx);
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - int adler
+   *   c_rarg1   - byte* buf
+   *   c_rarg2   - int length
+   *
+   * Ouput:
+   *       rax   - int adler result
+   *
+   * The input is processed in blocks of up to 4096 bytes, eight bytes at
+   * a time. Lane j of the ymm accumulator a sums the bytes at offsets j,
+   * j + 8, j + 16, ... of the block, and b accumulates a before each
+   * addition. For a block of n bytes
+   *
+   *   s1' = s1 + sum(a)
+   *   s2' = s2 + n * s1 + 8 * sum(b) + sum(a[j] * (8 - j))
+   *
+   * With 4096 byte blocks neither the lanes nor s2' overflow 32 bits, so
+   * both sums are reduced modulo BASE once per block. The remaining bytes
+   * are added one at a time.
+   */
+  address generate_updateBytesAdler32() {
+    assert(UseAdler32Intrinsics, "need AVX2");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "updateBytesAdler32");
+    address start = __ pc();
+
+    // Win64: rcx, rdx, r8, r9 (c_rarg0, c_rarg1, ...)
+    // Unix:  rdi, rsi, rdx, rcx, r8, r9 (c_rarg0, c_rarg1, ...)
+    // The arguments are moved out of rcx and rdx first, since divl
+    // needs rdx and s2 lives in rcx.
+    const Register s1  = r11;
+    const Register s2  = rcx;
+    const Register buf = r9;
+    const Register len = r10;
+    const Register end = r8;
+    const XMMRegister xa      = xmm0;
+    const XMMRegister xb      = xmm1;
+    const XMMRegister xbytes  = xmm2;
+    const XMMRegister xweight = xmm3;
+    const XMMRegister xtmp    = xmm4;
+    const int block_size = 4096;
+
+    Label L_block, L_loop, L_tail, L_tail_loop, L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ vmovdqu(xweight, ExternalAddress(StubRoutines::x86::adler32_weights_addr()), rax);
+    __ movl(s1, c_rarg0);
+    __ movptr(buf, c_rarg1);
+    __ movl(len, c_rarg2);
+    __ movl(s2, s1);
+    __ shrl(s2, 16);
+    __ andl(s1, 0xffff);
+
+    __ bind(L_block);
+    __ cmpl(len, 8);
+    __ jcc(Assembler::less, L_tail);
+    __ movl(end, len);
+    __ andl(end, ~7);
+    __ movl(rax, block_size);
+    __ cmpl(end, rax);
+    __ cmovl(Assembler::above, end, rax);
+    __ subl(len, end);
+
+    // s2 += n * s1
+    __ movl(rax, end);
+    __ imull(rax, s1);
+    __ addl(s2, rax);
+
+    __ addptr(end, buf);
+    __ vpxor(xa, xa, xa, Assembler::AVX_256bit);
+    __ vpxor(xb, xb, xb, Assembler::AVX_256bit);
+
+    __ align(OptoLoopAlignment);
+    __ bind(L_loop);
+    __ vpmovzxbd(xbytes, Address(buf, 0), Assembler::AVX_256bit);
+    __ vpaddd(xb, xb, xa, Assembler::AVX_256bit);
+    __ vpaddd(xa, xa, xbytes, Assembler::AVX_256bit);
+    __ addptr(buf, 8);
+    __ cmpptr(buf, end);
+    __ jcc(Assembler::below, L_loop);
+
+    // s2 += 8 * sum(b) + sum(a[j] * (8 - j))
+    __ vpmulld(xbytes, xa, xweight, Assembler::AVX_256bit);
+    adler32_sum_lanes(rax, xb, xtmp);
+    __ shll(rax, 3);
+    __ addl(s2, rax);
+    adler32_sum_lanes(rax, xbytes, xtmp);
+    __ addl(s2, rax);
+
+    // s1 += sum(a)
+    adler32_sum_lanes(rax, xa, xtmp);
+    __ addl(s1, rax);
+
+    adler32_mod(s1, end);
+    adler32_mod(s2, end);
+    __ jmp(L_block);
+
+    __ bind(L_tail);
+    __ testl(len, len);
+    __ jcc(Assembler::zero, L_done);
+    __ bind(L_tail_loop);
+    __ movzbl(rax, Address(buf, 0));
+    __ addl(s1, rax);
+    __ addl(s2, s1);
+    __ addptr(buf, 1);
+    __ decrementl(len);
+    __ jcc(Assembler::notZero, L_tail_loop);
+    adler32_mod(s1, end);
+    adler32_mod(s2, end);
+
+    __ bind(L_done);
+    __ shll(s2, 16);
+    __ orl(s2, s1);
+    __ movl(rax, s2);
+    __ vzeroupper();
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  // Powers of 31 used by the vectorizedHashCode stubs: the weights
+  // 31^31 .. 31^0 of the 32 lanes of four accumulators, then 31^32 and
+  // 31^8 broadcast, the factors the accumulators are scaled by per
+  // iteration of the 32 and 8 element loops.
+  address vectorized_hashcode_powers_addr() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedHashCode_powers");
+    address start = __ pc();
+    __ emit_data64(0x14e8c84188303fdf, relocInfo::none);
+    __ emit_data64(0x294fe48100acab9f, relocInfo::none);
+    __ emit_data64(0x395110c1f0d1075f, relocInfo::none);
+    __ emit_data64(0x84304d0101d9531f, relocInfo::none);
+    __ emit_data64(0x4a319941fc018edf, relocInfo::none);
+    __ emit_data64(0x0c98f5818685ba9f, relocInfo::none);
+    __ emit_data64(0xcdaa61c1e7a1d65f, relocInfo::none);
+    __ emit_data64(0x50a9de01c491e21f, relocInfo::none);
+    __ emit_data64(0x59db6a41e191dddf, relocInfo::none);
+    __ emit_data64(0xee830681e1ddc99f, relocInfo::none);
+    __ emit_data64(0x94e4b2c107b1a55f, relocInfo::none);
+    __ emit_data64(0x94446f01f449711f, relocInfo::none);
+    __ emit_data64(0x34e63b4167e12cdf, relocInfo::none);
+    __ emit_data64(0x000e178101b4d89f, relocInfo::none);
+    __ emit_data64(0x000003c10000745f, relocInfo::none);
+    __ emit_data64(0x000000010000001f, relocInfo::none);
+    for (int i = 0; i < 4; i++) {
+      __ emit_data64(0x7dd7bc017dd7bc01, relocInfo::none); // 31^32
+    }
+    for (int i = 0; i < 4; i++) {
+      __ emit_data64(0x94446f0194446f01, relocInfo::none); // 31^8
+    }
+    return start;
+  }
+
+  // Loads eight elements of the given type, widened to ints.
+  void vectorized_hashcode_load8(BasicType type, XMMRegister dst, Address src) {
+    switch (type) {
+      case T_BOOLEAN: __ vpmovzxbd(dst, src, Assembler::AVX_256bit); break;
+      case T_BYTE:    __ vpmovsxbd(dst, src, Assembler::AVX_256bit); break;
+      case T_CHAR:    __ vpmovzxwd(dst, src, Assembler::AVX_256bit); break;
+      case T_SHORT:   __ vpmovsxwd(dst, src, Assembler::AVX_256bit); break;
+      case T_INT:     __ vmovdqu(dst, src); break;
+      default: ShouldNotReachHere();
+    }
+  }
+
+  // Loads one element of the given type, widened to an int.
+  void vectorized_hashcode_load1(BasicType type, Register dst, Address src) {
+    switch (type) {
+      case T_BOOLEAN: __ movzbl(dst, src); break;
+      case T_BYTE:    __ movsbl(dst, src); break;
+      case T_CHAR:    __ movzwl(dst, src); break;
+      case T_SHORT:   __ movswl(dst, src); break;
+      case T_INT:     __ movl(dst, src); break;
+      default: ShouldNotReachHere();
+    }
+  }
+
+  // Adds up the eight int lanes of acc into dst; clobbers tmp.
+  void vectorized_hashcode_reduce(Register dst, XMMRegister acc, XMMRegister tmp) {
+    __ vextracti128_high(tmp, acc);
+    __ vpaddd(acc, acc, tmp, Assembler::AVX_128bit);
+    __ pshufd(tmp, acc, 0x4E);
+    __ vpaddd(acc, acc, tmp, Assembler::AVX_128bit);
+    __ pshufd(tmp, acc, 0xB1);
+    __ vpaddd(acc, acc, tmp, Assembler::AVX_128bit);
+    __ movdl(dst, acc);
+  }
+
+  /**
+  *  Arguments:
+  *
+  *  Input:
+  *    c_rarg0   - address of the first element
+  *    c_rarg1   - number of elements
+  *    c_rarg2   - initial hash value
+  *
+  *  Output:
+  *        rax   - the initial value folded with 31 * h + e over the elements,
+  *                as computed by String.hashCode and Arrays.hashCode
+  *
+  *  The polynomial is evaluated with the powers-of-31 technique: four
+  *  accumulators of eight lanes are scaled by 31^32 and take the next 32
+  *  elements per iteration, and the lanes are weighted by 31^31 .. 31^0
+  *  at the end. A single accumulator then handles 8 elements at a time,
+  *  and the last few elements are done with scalar code.
+  */
+  address generate_vectorizedHashCode(BasicType type, const char* name) {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", name);
+    address start = __ pc();
+
+    BLOCK_COMMENT("Entry:");
+    __ enter();
+
+    const Register ary    = c_rarg0;
+    const Register length = c_rarg1;
+    const Register result = rax;
+    const Register tmp    = r11;
+    const Register powers = r10;
+
+    const XMMRegister vacc[4] = { xmm0, xmm1, xmm2, xmm3 };
+    const XMMRegister vscale = xmm4;
+    const XMMRegister vtmp   = xmm5;
+
+    const int elem_size = type2aelembytes(type);
+    Label L_loop32, L_check8, L_loop8, L_check1, L_loop1, L_exit;
+
+    __ movl(result, c_rarg2);
+    __ lea(powers, ExternalAddress(StubRoutines::x86::vectorized_hashcode_powers_addr()));
+
+    __ cmpl(length, 32);
+    __ jcc(Assembler::less, L_check8);
+    for (int i = 0; i < 4; i++) {
+      __ vpxor(vacc[i], vacc[i], vacc[i], Assembler::AVX_256bit);
+    }
+    __ vmovdqu(vscale, Address(powers, 128));
+    __ align(OptoLoopAlignment);
+    __ BIND(L_loop32);
+    for (int i = 0; i < 4; i++) {
+      __ vpmulld(vacc[i], vacc[i], vscale, Assembler::AVX_256bit);
+      vectorized_hashcode_load8(type, vtmp, Address(ary, i * 8 * elem_size));
+      __ vpaddd(vacc[i], vacc[i], vtmp, Assembler::AVX_256bit);
+    }
+    __ imull(result, result, 0x7dd7bc01); // 31^32
+    __ addptr(ary, 32 * elem_size);
+    __ subl(length, 32);
+    __ cmpl(length, 32);
+    __ jcc(Assembler::greaterEqual, L_loop32);
+
+    for (int i = 0; i < 4; i++) {
+      __ vpmulld(vacc[i], vacc[i], Address(powers, i * 32), Assembler::AVX_256bit);
+    }
+    __ vpaddd(vacc[0], vacc[0], vacc[1], Assembler::AVX_256bit);
+    __ vpaddd(vacc[2], vacc[2], vacc[3], Assembler::AVX_256bit);
+    __ vpaddd(vacc[0], vacc[0], vacc[2], Assembler::AVX_256bit);
+    vectorized_hashcode_reduce(tmp, vacc[0], vtmp);
+    __ addl(result, tmp);
+
+    __ BIND(L_check8);
+    __ cmpl(length, 8);
+    __ jcc(Assembler::less, L_check1);
+    __ vpxor(vacc[0], vacc[0], vacc[0], Assembler::AVX_256bit);
+    __ vmovdqu(vscale, Address(powers, 160));
+    __ BIND(L_loop8);
+    __ vpmulld(vacc[0], vacc[0], vscale, Assembler::AVX_256bit);
+    vectorized_hashcode_load8(type, vtmp, Address(ary, 0));
+    __ vpaddd(vacc[0], vacc[0], vtmp, Assembler::AVX_256bit);
+    __ imull(result, result, (int)0x94446f01); // 31^8
+    __ addptr(ary, 8 * elem_size);
+    __ subl(length, 8);
+    __ cmpl(length, 8);
+    __ jcc(Assembler::greaterEqual, L_loop8);
+
+    __ vpmulld(vacc[0], vacc[0], Address(powers, 96), Assembler::AVX_256bit);
+    vectorized_hashcode_reduce(tmp, vacc[0], vtmp);
+    __ addl(result, tmp);
+
+    __ BIND(L_check1);
+    __ testl(length, length);
+    __ jcc(Assembler::lessEqual, L_exit);
+    __ BIND(L_loop1);
+    vectorized_hashcode_load1(type, tmp, Address(ary, 0));
+    __ imull(result, result, 31);
+    __ addl(result, tmp);
+    __ addptr(ary, elem_size);
+    __ decrementl(length);
+    __ jcc(Assembler::notZero, L_loop1);
+
+    __ BIND(L_exit);
+    __ vzeroupper();
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
 /**
    *  Arguments:
    *
@@ -5442,6 +6258,56 @@ address generate_avx_ghash_processBlocks() {
     return start;
   }
 
+  // Dispatch stub for polymorphic inline caches.
+  //
+  // Inputs:
+  //   rax:     CompiledICHolder with the cached (receiver klass, method) entries
+  //   j_rarg0: receiver
+  //
+  // Jumps to the compiled entry of the method cached for the receiver klass,
+  // or to the IC miss stub if the receiver klass is not cached. A null
+  // receiver also takes the miss path, which throws the NullPointerException.
+  //
+  address generate_polymorphic_ic_stub() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "polymorphic_ic_stub");
+
+    // Same registers as the itable stubs; the argument registers are live.
+    const Register icholder   = rax;
+    const Register method     = rbx;
+    const Register count      = rbx;
+    const Register recv_klass = r10;
+    const Register entry      = r11;
+
+    Label L_loop, L_hit, L_miss;
+
+    address start = __ pc();
+
+    __ testptr(j_rarg0, j_rarg0);
+    __ jcc(Assembler::zero, L_miss);
+    __ load_klass(recv_klass, j_rarg0, entry);
+    __ movl(count, Address(icholder, CompiledICHolder::pic_length_offset()));
+    __ movptr(entry, Address(icholder, CompiledICHolder::pic_entries_offset()));
+
+    __ BIND(L_loop);
+    __ cmpptr(recv_klass, Address(entry, CompiledICHolder::PICEntry::klass_offset()));
+    __ jccb(Assembler::equal, L_hit);
+    __ addptr(entry, (int32_t)sizeof(CompiledICHolder::PICEntry));
+    __ decrementl(count);
+    __ jccb(Assembler::notZero, L_loop);
+
+    __ BIND(L_miss);
+    __ jump(RuntimeAddress(SharedRuntime::get_ic_miss_stub()));
+
+    __ BIND(L_hit);
+    // method (rbx): Method*
+    // j_rarg0: receiver
+    __ movptr(method, Address(entry, CompiledICHolder::PICEntry::method_offset()));
+    __ jmp(Address(method, Method::from_compiled_offset()));
+
+    return start;
+  }
+
   address generate_method_entry_barrier() {
     __ align(CodeEntryAlignment);
     StubCodeMark mark(this, "StubRoutines", "nmethod_entry_barrier");
@@ -6340,6 +7206,23 @@ address generate_avx_ghash_processBlocks() {
     // arraycopy stubs used by compilers
     generate_arraycopy_stubs();
 
+    if (UseInlineCaches && PolymorphicInlineCacheSize >= 2) {
+      StubRoutines::_polymorphic_ic_stub = generate_polymorphic_ic_stub();
+    }
+
+    BarrierSetNMethod* bs_nm = BarrierSet::barrier_set()->barrier_set_nmethod();
+    if (bs_nm != NULL) {
+      StubRoutines::x86::_method_entry_barrier = generate_method_entry_barrier();
+    }
+
+    if (UseVectorizedMismatchIntrinsic) {
+      StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
+    }
+  }
+
+  void generate_compiler_stubs() {
+    // Generates the intrinsic stubs that are only called from compiled code
+
     // don't bother generating these AES intrinsic stubs unless global flag is set
     if (UseAESIntrinsics) {
       StubRoutines::x86::_key_shuffle_mask_addr = generate_key_shuffle_mask();  // needed by the others
@@ -6407,6 +7290,11 @@ address generate_avx_ghash_processBlocks() {
       }
     }
 
+    if (UseChaCha20Intrinsics) {
+      StubRoutines::x86::_chacha20_constants = chacha20_constants_addr();
+      StubRoutines::_chacha20Block = generate_chacha20Block_avx2();
+    }
+
     if (UseBASE64Intrinsics) {
       StubRoutines::x86::_and_mask = base64_and_mask_addr();
       StubRoutines::x86::_bswap_mask = base64_bswap_mask_addr();
@@ -6416,12 +7304,12 @@ address generate_avx_ghash_processBlocks() {
       StubRoutines::x86::_left_shift_mask = base64_left_shift_mask_addr();
       StubRoutines::x86::_right_shift_mask = base64_right_shift_mask_addr();
       StubRoutines::_base64_encodeBlock = generate_base64_encodeBlock();
+      if (UseAVX >= 2) {
+        StubRoutines::x86::_base64_decoding_table = base64_decoding_table_addr();
+        StubRoutines::_base64_decodeBlock = generate_base64_decodeBlock();
+      }
     }
 
-    BarrierSetNMethod* bs_nm = BarrierSet::barrier_set()->barrier_set_nmethod();
-    if (bs_nm != NULL) {
-      StubRoutines::x86::_method_entry_barrier = generate_method_entry_barrier();
-    }
 #ifdef COMPILER2
     if (UseMultiplyToLenIntrinsic) {
       StubRoutines::_multiplyToLen = generate_multiplyToLen();
@@ -6446,17 +7334,34 @@ address generate_avx_ghash_processBlocks() {
     }
 #endif // COMPILER2
 
-    if (UseVectorizedMismatchIntrinsic) {
-      StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
+    if (UseAdler32Intrinsics) {
+      StubRoutines::x86::_adler32_weights = adler32_weights_addr();
+      StubRoutines::_updateBytesAdler32 = generate_updateBytesAdler32();
+    }
+
+    if (UseVectorizedHashCodeIntrinsic) {
+      StubRoutines::x86::_vectorized_hashcode_powers = vectorized_hashcode_powers_addr();
+      StubRoutines::_vectorizedHashCode_boolean = generate_vectorizedHashCode(T_BOOLEAN, "vectorizedHashCode_boolean");
+      StubRoutines::_vectorizedHashCode_byte    = generate_vectorizedHashCode(T_BYTE,    "vectorizedHashCode_byte");
+      StubRoutines::_vectorizedHashCode_char    = generate_vectorizedHashCode(T_CHAR,    "vectorizedHashCode_char");
+      StubRoutines::_vectorizedHashCode_short   = generate_vectorizedHashCode(T_SHORT,   "vectorizedHashCode_short");
+      StubRoutines::_vectorizedHashCode_int     = generate_vectorizedHashCode(T_INT,     "vectorizedHashCode_int");
     }
   }
 
  public:
-  StubGenerator(CodeBuffer* code, bool all) : StubCodeGenerator(code) {
-    if (all) {
-      generate_all();
-    } else {
-      generate_initial();
+  enum StubsKind {
+    initial_stubs,
+    final_stubs,
+    compiler_stubs
+  };
+
+  StubGenerator(CodeBuffer* code, StubsKind kind) : StubCodeGenerator(code) {
+    switch (kind) {
+      case initial_stubs:  generate_initial();        break;
+      case final_stubs:    generate_all();            break;
+      case compiler_stubs: generate_compiler_stubs(); break;
+      default:             ShouldNotReachHere();
     }
   }
 }; // end class declaration
@@ -6466,5 +7371,9 @@ void StubGenerator_generate(CodeBuffer* code, bool all) {
   if (UnsafeCopyMemory::_table == NULL) {
     UnsafeCopyMemory::create_table(UCM_TABLE_MAX_ENTRIES);
   }
-  StubGenerator g(code, all);
+  StubGenerator g(code, all ? StubGenerator::final_stubs : StubGenerator::initial_stubs);
+}
+
+void StubGenerator_generate_compiler_stubs(CodeBuffer* code) {
+  StubGenerator g(code, StubGenerator::compiler_stubs);
 }
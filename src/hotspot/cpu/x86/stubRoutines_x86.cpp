@@ -62,6 +62,10 @@ address StubRoutines::x86::_right_shift_mask = NULL;
 address StubRoutines::x86::_left_shift_mask = NULL;
 address StubRoutines::x86::_and_mask = NULL;
 address StubRoutines::x86::_url_charset = NULL;
+address StubRoutines::x86::_base64_decoding_table = NULL;
+address StubRoutines::x86::_vectorized_hashcode_powers = NULL;
+address StubRoutines::x86::_adler32_weights = NULL;
+address StubRoutines::x86::_chacha20_constants = NULL;
 address StubRoutines::x86::_counter_mask_addr = NULL;
 #endif
 address StubRoutines::x86::_pshuffle_byte_flip_mask_addr = NULL;
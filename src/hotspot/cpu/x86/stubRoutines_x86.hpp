@@ -33,7 +33,9 @@ static bool returns_to_call_stub(address return_pc) { return return_pc == _call_
 
 enum platform_dependent_constants {
   code_size1 = 20000 LP64_ONLY(+10000),         // simply increase if too small (assembler will crash if too small)
-  code_size2 = 35300 LP64_ONLY(+11400)          // simply increase if too small (assembler will crash if too small)
+  code_size2 = 35300 LP64_ONLY(+11400),         // simply increase if too small (assembler will crash if too small)
+  // The 32-bit generator keeps the compiler intrinsic stubs in code_size2.
+  compiler_stubs_code_size = 0 LP64_ONLY(+30000) // simply increase if too small (assembler will crash if too small)
 };
 
 class x86 {
@@ -164,6 +166,10 @@ class x86 {
   static address _left_shift_mask;
   static address _and_mask;
   static address _url_charset;
+  static address _base64_decoding_table;
+  static address _vectorized_hashcode_powers;
+  static address _adler32_weights;
+  static address _chacha20_constants;
 #endif
   // byte flip mask for sha256
   static address _pshuffle_byte_flip_mask_addr;
@@ -266,6 +272,10 @@ class x86 {
   static address base64_right_shift_mask_addr() { return _right_shift_mask; }
   static address base64_left_shift_mask_addr() { return _left_shift_mask; }
   static address base64_and_mask_addr() { return _and_mask; }
+  static address base64_decoding_table_addr() { return _base64_decoding_table; }
+  static address vectorized_hashcode_powers_addr() { return _vectorized_hashcode_powers; }
+  static address adler32_weights_addr() { return _adler32_weights; }
+  static address chacha20_constants_addr() { return _chacha20_constants; }
   static address counter_mask_addr() { return _counter_mask_addr; }
 #endif
   static address pshuffle_byte_flip_mask_addr() { return _pshuffle_byte_flip_mask_addr; }
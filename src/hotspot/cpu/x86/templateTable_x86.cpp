@@ -648,6 +648,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ movl(bc, Bytecodes::_fast_icaload);
     __ jccb(Assembler::equal, rewrite);
 
+    // if _iaload, rewrite to fast_iiaload
+    __ cmpl(rbx, Bytecodes::_iaload);
+    __ movl(bc, Bytecodes::_fast_iiaload);
+    __ jccb(Assembler::equal, rewrite);
+
     // rewrite so iload doesn't check again.
     __ movl(bc, Bytecodes::_fast_iload);
 
@@ -866,6 +871,21 @@ void TemplateTable::fast_icaload() {
                     noreg, noreg);
 }
 
+// iload followed by iaload frequent pair
+void TemplateTable::fast_iiaload() {
+  transition(vtos, itos);
+  // load index out of locals
+  locals_index(rbx);
+  __ movl(rax, iaddress(rbx));
+
+  // rax: index
+  // rdx: array
+  index_check(rdx, rax); // kills rbx
+  __ access_load_at(T_INT, IN_HEAP | IS_ARRAY, rax,
+                    Address(rdx, rax, Address::times_4, arrayOopDesc::base_offset_in_bytes(T_INT)),
+                    noreg, noreg);
+}
+
 
 void TemplateTable::saload() {
   transition(itos, itos);
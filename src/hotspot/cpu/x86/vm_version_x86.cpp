@@ -964,6 +964,17 @@ void VM_Version::get_processor_features() {
     FLAG_SET_DEFAULT(UseGHASHIntrinsics, false);
   }
 
+  // ChaCha20 Intrinsics
+  if (LP64_ONLY(UseAVX >= 2) NOT_LP64(false)) {
+    if (FLAG_IS_DEFAULT(UseChaCha20Intrinsics)) {
+      UseChaCha20Intrinsics = true;
+    }
+  } else if (UseChaCha20Intrinsics) {
+    if (!FLAG_IS_DEFAULT(UseChaCha20Intrinsics))
+      warning("ChaCha20 intrinsic requires AVX2 instructions on this CPU");
+    FLAG_SET_DEFAULT(UseChaCha20Intrinsics, false);
+  }
+
   // Base64 Intrinsics (Check the condition for which the intrinsic will be active)
   if ((UseAVX > 2) && supports_avx512vl() && supports_avx512bw()) {
     if (FLAG_IS_DEFAULT(UseBASE64Intrinsics)) {
@@ -1032,6 +1043,13 @@ void VM_Version::get_processor_features() {
     FLAG_SET_DEFAULT(UseSHA, false);
   }
 
+#ifdef _LP64
+  if (UseAVX >= 2) {
+    if (FLAG_IS_DEFAULT(UseAdler32Intrinsics)) {
+      FLAG_SET_DEFAULT(UseAdler32Intrinsics, true);
+    }
+  } else
+#endif
   if (UseAdler32Intrinsics) {
     warning("Adler32Intrinsics not available on this CPU.");
     FLAG_SET_DEFAULT(UseAdler32Intrinsics, false);
@@ -1071,6 +1089,11 @@ void VM_Version::get_processor_features() {
       // high lock contention. For now we do not use it by default.
       vm_exit_during_initialization("UseRTMLocking flag should be only set on command line");
     }
+    if (UseLightweightLocking && UseRTMForStackLocks) {
+      // RTM stack locking relies on the displaced header in the BasicLock.
+      warning("UseRTMForStackLocks is not supported with lightweight locking");
+      FLAG_SET_DEFAULT(UseRTMForStackLocks, false);
+    }
   } else { // !UseRTMLocking
     if (UseRTMForStackLocks) {
       if (!FLAG_IS_DEFAULT(UseRTMForStackLocks)) {
@@ -1469,6 +1492,25 @@ void VM_Version::get_processor_features() {
   }
 #endif // _LP64
 
+#ifdef _LP64
+  if (UseAVX >= 2) {
+    if (FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic)) {
+      UseVectorizedHashCodeIntrinsic = true;
+    }
+  } else if (UseVectorizedHashCodeIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic))
+      warning("vectorizedHashCode intrinsic requires AVX2 instructions on this CPU");
+    FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, false);
+  }
+#else
+  if (UseVectorizedHashCodeIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic)) {
+      warning("vectorizedHashCode intrinsic is not available in 32-bit VM");
+    }
+    FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, false);
+  }
+#endif // _LP64
+
   // Use count leading zeros count instruction if available.
   if (supports_lzcnt()) {
     if (FLAG_IS_DEFAULT(UseCountLeadingZerosInstruction)) {
@@ -182,13 +182,18 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   __ movptr(resolved_klass_reg, Address(icholder_reg, CompiledICHolder::holder_klass_offset()));
   __ movptr(holder_klass_reg,   Address(icholder_reg, CompiledICHolder::holder_metadata_offset()));
 
-  Label L_no_such_interface;
+  Label L_no_such_interface, L_refc_checked;
 
   // get receiver klass (also an implicit null-check)
   assert(VtableStub::receiver_location() == j_rarg0->as_VMReg(), "receiver expected in j_rarg0");
   address npe_addr = __ pc();
   __ load_klass(recv_klass_reg, j_rarg0, temp_reg);
 
+  // If REFC and DECC are the same interface, the method lookup below
+  // doubles as the receiver subtype check; skip the separate itable scan.
+  __ cmpptr(resolved_klass_reg, holder_klass_reg);
+  __ jcc(Assembler::equal, L_refc_checked);
+
   start_pc = __ pc();
 
   // Receiver subtype check against REFC.
@@ -201,11 +206,14 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
                              /*return_method=*/false);
 
   const ptrdiff_t  typecheckSize = __ pc() - start_pc;
+
+  __ load_klass(recv_klass_reg, j_rarg0, temp_reg);   // restore recv_klass_reg
+  __ bind(L_refc_checked);
+
   start_pc = __ pc();
 
   // Get selected method from declaring class and itable index
   const Register method = rbx;
-  __ load_klass(recv_klass_reg, j_rarg0, temp_reg);   // restore recv_klass_reg
   __ lookup_interface_method(// inputs: rec. class, interface, itable index
                              recv_klass_reg, holder_klass_reg, itable_index,
                              // outputs: method, scan temp. reg
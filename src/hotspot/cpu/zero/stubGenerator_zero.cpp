@@ -311,6 +311,12 @@ void StubGenerator_generate(CodeBuffer* code, bool all) {
   StubGenerator g(code, all);
 }
 
+void StubGenerator_generate_compiler_stubs(CodeBuffer* code) {
+  // The compiler intrinsic stubs are generated together with the
+  // other stubs on this platform, see compiler_stubs_code_size.
+  ShouldNotReachHere();
+}
+
 EntryFrame *EntryFrame::build(const intptr_t*  parameters,
                               int              parameter_words,
                               JavaCallWrapper* call_wrapper,
@@ -41,8 +41,9 @@
 
   enum platform_dependent_constants {
     code_size1 = 0,      // The assembler will fail with a guarantee
-    code_size2 = 0       // if these are too small.  Simply increase
-  };                     // them if that happens.
+    code_size2 = 0,      // if these are too small.  Simply increase
+    compiler_stubs_code_size = 0 // them if that happens.
+  };
 
   enum method_handles_platform_dependent_constants {
     method_handles_adapters_code_size = 0
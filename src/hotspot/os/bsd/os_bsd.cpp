@@ -2320,6 +2320,10 @@ OSReturn os::get_native_priority(const Thread* const thread, int *priority_ptr)
   return (*priority_ptr != -1 || errno == 0 ? OS_OK : OS_ERR);
 }
 
+OSReturn os::set_native_affinity(Thread* thread, const char* cpu_list) {
+  return OS_ERR; // Not supported
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // suspend/resume support
 
@@ -30,6 +30,7 @@
 #include "services/attachListener.hpp"
 #include "services/dtraceAttacher.hpp"
 
+#include <poll.h>
 #include <unistd.h>
 #include <signal.h>
 #include <sys/types.h>
@@ -49,6 +50,18 @@
 // executes it, and returns the response to the client via the socket
 // connection.
 //
+// Clients that run many commands, e.g. monitoring agents, can use protocol
+// version 2 instead. The connection then stays open after the response and
+// the client can send further requests on it, one at a time: the next request
+// is sent only after the complete response to the previous one was read.
+// A version 2 response carries the length of the result data, so that the
+// client knows where it ends:
+//   <result>\n<length>\n<data>
+// The listener waits for new connections and for requests on up to
+// max_persistent_connections open connections at the same time; further
+// connections are closed after their response. The client closes the
+// connection when it is done.
+//
 // As the socket is a UNIX domain socket it means that only clients on the
 // local machine can connect. In addition there are two other aspects to
 // the security:
@@ -71,12 +84,22 @@ class LinuxAttachListener: AllStatic {
 
   static bool _atexit_registered;
 
+  // open connections using protocol version 2, -1 for unused slots
+  enum {
+    max_persistent_connections = 8
+  };
+  static int _connections[max_persistent_connections];
+
   // reads a request from the given connected socket
   static LinuxAttachOperation* read_request(int s);
 
+  // checks the credentials of a new connection and reads its first request
+  static LinuxAttachOperation* accept_request();
+
  public:
   enum {
-    ATTACH_PROTOCOL_VER = 1                     // protocol version
+    ATTACH_PROTOCOL_VER = 1,                    // protocol version
+    ATTACH_PROTOCOL_VER_PERSISTENT = 2          // protocol version for persistent connections
   };
   enum {
     ATTACH_ERROR_BADVERSION     = 101           // error codes
@@ -106,21 +129,29 @@ class LinuxAttachListener: AllStatic {
   static int write_fully(int s, char* buf, int len);
 
   static LinuxAttachOperation* dequeue();
+
+  // keep a connection open for further requests, returns false if there are too many
+  static bool add_connection(int s);
 };
 
 class LinuxAttachOperation: public AttachOperation {
  private:
   // the connection to the client
   int _socket;
+  // the connection stays open after the response (protocol version 2)
+  bool _persistent;
 
  public:
   void complete(jint res, bufferedStream* st);
 
   void set_socket(int s)                                { _socket = s; }
   int socket() const                                    { return _socket; }
+  void set_persistent(bool persistent)                  { _persistent = persistent; }
+  bool persistent() const                               { return _persistent; }
 
   LinuxAttachOperation(char* name) : AttachOperation(name) {
     set_socket(-1);
+    set_persistent(false);
   }
 };
 
@@ -129,6 +160,8 @@ char LinuxAttachListener::_path[UNIX_PATH_MAX];
 bool LinuxAttachListener::_has_path;
 volatile int LinuxAttachListener::_listener = -1;
 bool LinuxAttachListener::_atexit_registered = false;
+int LinuxAttachListener::_connections[LinuxAttachListener::max_persistent_connections] =
+  { -1, -1, -1, -1, -1, -1, -1, -1 };
 
 // Supporting class to help split a buffer into individual components
 class ArgumentIterator : public StackObj {
@@ -249,12 +282,13 @@ int LinuxAttachListener::init() {
 LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
   char ver_str[8];
   sprintf(ver_str, "%d", ATTACH_PROTOCOL_VER);
+  int ver = ATTACH_PROTOCOL_VER;
 
   // The request is a sequence of strings so we first figure out the
   // expected count and the maximum possible length of the request.
   // The request is:
   //   <ver>0<cmd>0<arg>0<arg>0<arg>0
-  // where <ver> is the protocol version (1), <cmd> is the command
+  // where <ver> is the protocol version (1 or 2), <cmd> is the command
   // name ("load", "datadump", ...), and <arg> is an argument
   int expected_str_count = 2 + AttachOperation::arg_count_max;
   const int max_len = (sizeof(ver_str) + 1) + (AttachOperation::name_length_max + 1) +
@@ -288,8 +322,9 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
         // The first string is <ver> so check it now to
         // check for protocol mis-match
         if (str_count == 1) {
+          ver = atoi(buf);
           if ((strlen(buf) != strlen(ver_str)) ||
-              (atoi(buf) != ATTACH_PROTOCOL_VER)) {
+              (ver != ATTACH_PROTOCOL_VER && ver != ATTACH_PROTOCOL_VER_PERSISTENT)) {
             char msg[32];
             sprintf(msg, "%d\n", ATTACH_ERROR_BADVERSION);
             write_fully(s, msg, strlen(msg));
@@ -334,50 +369,116 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
   }
 
   op->set_socket(s);
+  op->set_persistent(ver == ATTACH_PROTOCOL_VER_PERSISTENT);
   return op;
 }
 
 
+// Accept a new connection, check the credentials of the peer and read
+// the first request.
+//
+LinuxAttachOperation* LinuxAttachListener::accept_request() {
+  int s;
+
+  // the client has connected
+  struct sockaddr addr;
+  socklen_t len = sizeof(addr);
+  RESTARTABLE(::accept(listener(), &addr, &len), s);
+  if (s == -1) {
+    return NULL;      // log a warning?
+  }
+
+  // get the credentials of the peer and check the effective uid/guid
+  struct ucred cred_info;
+  socklen_t optlen = sizeof(cred_info);
+  if (::getsockopt(s, SOL_SOCKET, SO_PEERCRED, (void*)&cred_info, &optlen) == -1) {
+    log_debug(attach)("Failed to get socket option SO_PEERCRED");
+    ::close(s);
+    return NULL;
+  }
+
+  if (!os::Posix::matches_effective_uid_and_gid_or_root(cred_info.uid, cred_info.gid)) {
+    log_debug(attach)("euid/egid check failed (%d/%d vs %d/%d)",
+            cred_info.uid, cred_info.gid, geteuid(), getegid());
+    ::close(s);
+    return NULL;
+  }
+
+  // peer credential look okay so we read the request
+  LinuxAttachOperation* op = read_request(s);
+  if (op == NULL) {
+    ::close(s);
+  }
+  return op;
+}
+
+bool LinuxAttachListener::add_connection(int s) {
+  for (int i = 0; i < max_persistent_connections; i++) {
+    if (_connections[i] == -1) {
+      _connections[i] = s;
+      return true;
+    }
+  }
+  return false;
+}
+
 // Dequeue an operation
 //
 // In the Linux implementation there is only a single operation and clients
-// cannot queue commands (except at the socket level).
+// cannot queue commands (except at the socket level). Operations are read
+// from new connections and from the persistent connections that wait for
+// their next request.
 //
 LinuxAttachOperation* LinuxAttachListener::dequeue() {
   for (;;) {
-    int s;
-
-    // wait for client to connect
-    struct sockaddr addr;
-    socklen_t len = sizeof(addr);
-    RESTARTABLE(::accept(listener(), &addr, &len), s);
-    if (s == -1) {
-      return NULL;      // log a warning?
+    // wait for a client to connect or to send a request on an open connection
+    struct pollfd fds[1 + max_persistent_connections];
+    int nfds = 0;
+    fds[nfds].fd = listener();
+    fds[nfds].events = POLLIN;
+    fds[nfds].revents = 0;
+    nfds++;
+    for (int i = 0; i < max_persistent_connections; i++) {
+      if (_connections[i] != -1) {
+        fds[nfds].fd = _connections[i];
+        fds[nfds].events = POLLIN;
+        fds[nfds].revents = 0;
+        nfds++;
+      }
     }
-
-    // get the credentials of the peer and check the effective uid/guid
-    struct ucred cred_info;
-    socklen_t optlen = sizeof(cred_info);
-    if (::getsockopt(s, SOL_SOCKET, SO_PEERCRED, (void*)&cred_info, &optlen) == -1) {
-      log_debug(attach)("Failed to get socket option SO_PEERCRED");
-      ::close(s);
-      continue;
+    int n;
+    RESTARTABLE(::poll(fds, nfds, -1), n);
+    if (n == -1) {
+      return NULL;
     }
 
-    if (!os::Posix::matches_effective_uid_and_gid_or_root(cred_info.uid, cred_info.gid)) {
-      log_debug(attach)("euid/egid check failed (%d/%d vs %d/%d)",
-              cred_info.uid, cred_info.gid, geteuid(), getegid());
-      ::close(s);
-      continue;
+    // The connection is taken out of the set while its request is served.
+    // It is added back when the response was written, see complete().
+    for (int i = 1; i < nfds; i++) {
+      if (fds[i].revents != 0) {
+        int s = fds[i].fd;
+        for (int j = 0; j < max_persistent_connections; j++) {
+          if (_connections[j] == s) {
+            _connections[j] = -1;
+          }
+        }
+        LinuxAttachOperation* op = read_request(s);
+        if (op != NULL) {
+          return op;
+        }
+        // the client closed the connection or sent a bad request
+        ::close(s);
+      }
     }
 
-    // peer credential look okay so we read the request
-    LinuxAttachOperation* op = read_request(s);
-    if (op == NULL) {
-      ::close(s);
-      continue;
-    } else {
-      return op;
+    if (fds[0].revents != 0) {
+      if (listener() == -1) {
+        return NULL;    // shutdown
+      }
+      LinuxAttachOperation* op = accept_request();
+      if (op != NULL) {
+        return op;
+      }
     }
   }
 }
@@ -413,19 +514,34 @@ void LinuxAttachOperation::complete(jint result, bufferedStream* st) {
   // cleared by handle_special_suspend_equivalent_condition() or
   // java_suspend_self() via check_and_wait_while_suspended()
 
-  // write operation result
-  char msg[32];
-  sprintf(msg, "%d\n", result);
-  int rc = LinuxAttachListener::write_fully(this->socket(), msg, strlen(msg));
+  if (persistent()) {
+    // write operation result and the length of the result data
+    char msg[64];
+    sprintf(msg, "%d\n" SIZE_FORMAT "\n", result, st->size());
+    int rc = LinuxAttachListener::write_fully(this->socket(), msg, strlen(msg));
 
-  // write any result data
-  if (rc == 0) {
-    LinuxAttachListener::write_fully(this->socket(), (char*) st->base(), st->size());
-    ::shutdown(this->socket(), 2);
-  }
+    // write any result data and wait for the next request
+    if (rc == 0) {
+      rc = LinuxAttachListener::write_fully(this->socket(), (char*) st->base(), st->size());
+    }
+    if (rc != 0 || !LinuxAttachListener::add_connection(this->socket())) {
+      ::close(this->socket());
+    }
+  } else {
+    // write operation result
+    char msg[32];
+    sprintf(msg, "%d\n", result);
+    int rc = LinuxAttachListener::write_fully(this->socket(), msg, strlen(msg));
+
+    // write any result data
+    if (rc == 0) {
+      LinuxAttachListener::write_fully(this->socket(), (char*) st->base(), st->size());
+      ::shutdown(this->socket(), 2);
+    }
 
-  // done
-  ::close(this->socket());
+    // done
+    ::close(this->socket());
+  }
 
   // were we externally suspended while we were waiting?
   thread->check_and_wait_while_suspended();
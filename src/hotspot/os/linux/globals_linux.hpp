@@ -39,11 +39,23 @@
   product(bool, UseOprofile, false,                                     \
         "enable support for Oprofile profiler")                         \
                                                                         \
+  product(bool, WritePerfMap, false,                                    \
+          "Append generated code to /tmp/perf-<pid>.map as it is "      \
+          "created, for profilers such as perf")                        \
+                                                                        \
+  product(bool, WriteJitDump, false,                                    \
+          "Write generated code to /tmp/jit-<pid>.dump in the jitdump " \
+          "format read by perf inject --jit")                           \
+                                                                        \
   /*  NB: The default value of UseLinuxPosixThreadCPUClocks may be   */ \
   /* overridden in Arguments::parse_each_vm_init_arg.                */ \
   product(bool, UseLinuxPosixThreadCPUClocks, true,                     \
           "enable fast Linux Posix clocks where available")             \
                                                                         \
+  product(bool, UseTSCForJavaTimeNanos, false, EXPERIMENTAL,            \
+          "Read System.nanoTime() from the time stamp counter when the "\
+          "kernel uses it as its clock source. x86_64 only")            \
+                                                                        \
   product(bool, UseHugeTLBFS, false,                                    \
           "Use MAP_HUGETLB for large pages")                            \
                                                                         \
@@ -68,6 +80,12 @@
           "Increase the thread stack size to include space for glibc "  \
           "static thread-local storage (TLS) if true")                  \
                                                                         \
+  product(uintx, ThreadStackPoolSize, 0, EXPERIMENTAL,                  \
+          "Number of Java thread stacks, with their guard zones still " \
+          "protected, that are kept for reuse by new Java threads. "    \
+          "0 disables the pool")                                        \
+          range(0, 4096)                                                \
+                                                                        \
   product(bool, DumpPrivateMappingsInCore, true, DIAGNOSTIC,            \
           "If true, sets bit 2 of /proc/PID/coredump_filter, thus "     \
           "resulting in file-backed private mappings of the process to "\
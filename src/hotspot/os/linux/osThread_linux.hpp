@@ -45,8 +45,14 @@
 
   sigset_t _caller_sigmask; // Caller's signal mask
 
+  // The stack this thread runs on if it was taken from the ThreadStackPool.
+  PooledThreadStack* _pooled_stack;
+
  public:
 
+  PooledThreadStack* pooled_stack() const     { return _pooled_stack; }
+  void set_pooled_stack(PooledThreadStack* s) { _pooled_stack = s; }
+
   // Methods to save/restore caller's signal mask
   sigset_t  caller_sigmask() const       { return _caller_sigmask; }
   void    set_caller_sigmask(sigset_t sigmask)  { _caller_sigmask = sigmask; }
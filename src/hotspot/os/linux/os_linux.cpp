@@ -66,6 +66,7 @@
 #include "services/attachListener.hpp"
 #include "services/memTracker.hpp"
 #include "services/runtimeService.hpp"
+#include "threadStackPool_linux.hpp"
 #include "utilities/align.hpp"
 #include "utilities/decoder.hpp"
 #include "utilities/defaultStream.hpp"
@@ -789,6 +790,9 @@ static void *thread_native_entry(Thread *thread) {
 
   assert(osthread->pthread_id() != 0, "pthread_id was not set as expected");
 
+  // The OSThread is gone once call_run() returns.
+  PooledThreadStack* pooled_stack = osthread->pooled_stack();
+
   // call one more level start routine
   thread->call_run();
 
@@ -799,6 +803,11 @@ static void *thread_native_entry(Thread *thread) {
   log_info(os, thread)("Thread finished (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
     os::current_thread_id(), (uintx) pthread_self());
 
+  if (pooled_stack != NULL) {
+    // The stack is not reused before this thread has been joined.
+    ThreadStackPool::release(pooled_stack);
+  }
+
   return 0;
 }
 
@@ -920,7 +929,24 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
   }
   assert(is_aligned(stack_size, os::vm_page_size()), "stack_size not aligned");
 
-  int status = pthread_attr_setstacksize(&attr, stack_size);
+  // Java threads may run on a stack from the pool, which is set up already.
+  PooledThreadStack* pooled_stack = NULL;
+  if (thr_type == java_thread && ThreadStackPool::is_enabled()) {
+    pooled_stack = ThreadStackPool::take(stack_size);
+  }
+
+  if (pooled_stack != NULL) {
+    if (pthread_attr_setstack(&attr, pooled_stack->bottom(), stack_size) == 0) {
+      // Joinable, so that the pool can tell when the stack is free again.
+      pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+      osthread->set_pooled_stack(pooled_stack);
+    } else {
+      ThreadStackPool::release(pooled_stack);
+      pooled_stack = NULL;
+    }
+  }
+
+  int status = (pooled_stack != NULL) ? 0 : pthread_attr_setstacksize(&attr, stack_size);
   if (status != 0) {
     // pthread_attr_setstacksize() function can fail
     // if the stack size exceeds a system-imposed limit.
@@ -959,11 +985,20 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
 
     if (ret != 0) {
       // Need to clean up stuff we've allocated so far
+      if (pooled_stack != NULL) {
+        ThreadStackPool::release(pooled_stack);
+      }
       thread->set_osthread(NULL);
       delete osthread;
       return false;
     }
 
+    // The child cannot finish before os::start_thread(), so this is
+    // in place before it releases the stack.
+    if (pooled_stack != NULL) {
+      pooled_stack->set_owner(tid);
+    }
+
     // Store pthread info into the OSThread
     osthread->set_pthread_id(tid);
 
@@ -1444,7 +1479,17 @@ void os::Linux::fast_thread_clock_init() {
   }
 }
 
+#if defined(AMD64)
+// Set once at startup, see UseTSCForJavaTimeNanos
+static bool use_tsc_java_time_nanos = false;
+#endif
+
 jlong os::javaTimeNanos() {
+#if defined(AMD64)
+  if (use_tsc_java_time_nanos) {
+    return os::tsc_java_time_nanos();
+  }
+#endif
   if (os::supports_monotonic_clock()) {
     struct timespec tp;
     int status = os::Posix::clock_gettime(CLOCK_MONOTONIC, &tp);
@@ -3578,6 +3623,73 @@ bool os::committed_in_range(address start, size_t size, address& committed_start
   }
 }
 
+size_t os::resident_in_range(address start, size_t size) {
+  const size_t stripe = 1024;  // query this many pages each time
+  unsigned char vec[stripe];
+
+  const size_t page_sz = os::vm_page_size();
+  address loop_base = align_down(start, page_sz);
+  size_t pages = (align_up(start + size, page_sz) - loop_base) / page_sz;
+  size_t resident_pages = 0;
+
+  while (pages > 0) {
+    size_t pages_to_query = MIN2(pages, stripe);
+    int mincore_return_value;
+    while ((mincore_return_value = mincore(loop_base, pages_to_query * page_sz, vec)) == -1 && errno == EAGAIN);
+
+    // Some memory can go away without notifying NMT, see committed_in_range().
+    // Count such a stripe as not resident.
+    if (mincore_return_value == 0) {
+      for (size_t vecIdx = 0; vecIdx < pages_to_query; vecIdx ++) {
+        if ((vec[vecIdx] & 0x01) != 0) {
+          resident_pages ++;
+        }
+      }
+    }
+
+    pages -= pages_to_query;
+    loop_base += pages_to_query * page_sz;
+  }
+
+  return MIN2(resident_pages * page_sz, size);
+}
+
+// The kernel reports AnonHugePages per mapping in /proc/self/smaps only, so
+// mappings that extend past the range are counted in proportion to their
+// overlap with it.
+size_t os::huge_pages_in_range(address start, size_t size) {
+  FILE* fp = fopen("/proc/self/smaps", "r");
+  if (fp == NULL) {
+    return 0;
+  }
+
+  const address end = start + size;
+  address map_start = NULL;
+  address map_end = NULL;
+  size_t huge_pages = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    void* lo;
+    void* hi;
+    size_t kb;
+    if (sscanf(line, "%p-%p ", &lo, &hi) == 2) {
+      map_start = (address)lo;
+      map_end = (address)hi;
+      // Mappings are listed in address order
+      if (map_start >= end) {
+        break;
+      }
+    } else if (sscanf(line, "AnonHugePages: " SIZE_FORMAT " kB", &kb) == 1 && kb > 0 &&
+               map_start < end && map_end > start) {
+      size_t overlap = MIN2(map_end, end) - MAX2(map_start, start);
+      huge_pages += (size_t)((double)kb * K * overlap / (map_end - map_start));
+    }
+  }
+  fclose(fp);
+
+  return MIN2(align_down(huge_pages, os::vm_page_size()), size);
+}
+
 
 // Linux uses a growable mapping for the stack, and if the mapping for
 // the stack guard pages is not removed when we detach a thread the
@@ -4536,6 +4648,43 @@ OSReturn os::get_native_priority(const Thread* const thread,
   return (*priority_ptr != -1 || errno == 0 ? OS_OK : OS_ERR);
 }
 
+OSReturn os::set_native_affinity(Thread* thread, const char* cpu_list) {
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  const char* p = cpu_list;
+  while (*p != '\0') {
+    char* end;
+    long first = strtol(p, &end, 10);
+    if (end == p || first < 0 || first >= CPU_SETSIZE) {
+      return OS_ERR;
+    }
+    long last = first;
+    p = end;
+    if (*p == '-') {
+      p++;
+      last = strtol(p, &end, 10);
+      if (end == p || last < first || last >= CPU_SETSIZE) {
+        return OS_ERR;
+      }
+      p = end;
+    }
+    for (long cpu = first; cpu <= last; cpu++) {
+      CPU_SET(cpu, &cpus);
+    }
+    if (*p == ',') {
+      p++;
+    } else if (*p != '\0') {
+      return OS_ERR;
+    }
+  }
+  if (CPU_COUNT(&cpus) == 0) {
+    return OS_ERR;
+  }
+  // The cpuset of the container still applies on top of this mask.
+  int ret = sched_setaffinity(thread->osthread()->thread_id(), sizeof(cpus), &cpus);
+  return (ret == 0) ? OS_OK : OS_ERR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // suspend/resume support
 
@@ -5369,6 +5518,14 @@ jint os::init_2(void) {
 
   Linux::fast_thread_clock_init();
 
+  if (UseTSCForJavaTimeNanos) {
+#if defined(AMD64)
+    use_tsc_java_time_nanos = os::tsc_java_time_nanos_init();
+#else
+    warning("UseTSCForJavaTimeNanos is only supported on x86_64");
+#endif
+  }
+
   // initialize suspend/resume support - must do this before signal_sets_init()
   if (SR_initialize() != 0) {
     perror("SR_initialize failed");
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "logging/log.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#include "threadStackPool_linux.hpp"
+#include "utilities/debug.hpp"
+
+#include <sys/mman.h>
+
+pthread_mutex_t    ThreadStackPool::_lock = PTHREAD_MUTEX_INITIALIZER;
+PooledThreadStack* ThreadStackPool::_free_list = NULL;
+uint               ThreadStackPool::_free_count = 0;
+
+void ThreadStackPool::join_owner(PooledThreadStack* stack) {
+  if (stack->_has_owner) {
+    int status = pthread_join(stack->_owner, NULL);
+    assert_status(status == 0, status, "pthread_join");
+    stack->_has_owner = false;
+  }
+}
+
+void ThreadStackPool::unmap(PooledThreadStack* stack) {
+  join_owner(stack);
+  if (::munmap(stack->_bottom, stack->_size) != 0) {
+    log_warning(os, thread)("Failed to unmap pooled thread stack " PTR_FORMAT " (%s).",
+                            p2i(stack->_bottom), os::strerror(errno));
+  }
+  delete stack;
+}
+
+PooledThreadStack* ThreadStackPool::take(size_t size) {
+  PooledThreadStack* stack = NULL;
+  pthread_mutex_lock(&_lock);
+  for (PooledThreadStack** p = &_free_list; *p != NULL; p = &(*p)->_next) {
+    if ((*p)->_size == size) {
+      stack = *p;
+      *p = stack->_next;
+      _free_count--;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&_lock);
+
+  if (stack != NULL) {
+    join_owner(stack);
+    stack->_next = NULL;
+  } else {
+    void* addr = ::mmap(NULL, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (addr == MAP_FAILED) {
+      log_info(os, thread)("Failed to map a pooled thread stack of " SIZE_FORMAT "k (%s).",
+                           size / K, os::strerror(errno));
+      return NULL;
+    }
+    stack = new PooledThreadStack((address)addr, size);
+  }
+
+  if (!stack->_guarded) {
+    size_t len = JavaThread::stack_guard_zone_size();
+    if (!os::guard_memory((char*)stack->_bottom, len)) {
+      log_info(os, thread)("Failed to protect the guard zone of a pooled thread stack ("
+                           PTR_FORMAT "-" PTR_FORMAT ").",
+                           p2i(stack->_bottom), p2i(stack->_bottom + len));
+      unmap(stack);
+      return NULL;
+    }
+    stack->_guarded = true;
+  }
+
+  log_debug(os, thread)("Took pooled thread stack " PTR_FORMAT " of " SIZE_FORMAT "k.",
+                        p2i(stack->_bottom), size / K);
+  return stack;
+}
+
+void ThreadStackPool::release(PooledThreadStack* stack) {
+  PooledThreadStack* excess = NULL;
+
+  pthread_mutex_lock(&_lock);
+  stack->_next = _free_list;
+  _free_list = stack;
+  _free_count++;
+  if (_free_count > ThreadStackPoolSize) {
+    // Keep the most recently released stacks. The one just released is
+    // at the head, so a thread never unmaps the stack it is running on.
+    PooledThreadStack* last = _free_list;
+    for (uint i = 1; i < ThreadStackPoolSize; i++) {
+      last = last->_next;
+    }
+    excess = last->_next;
+    last->_next = NULL;
+    _free_count = (uint)ThreadStackPoolSize;
+  }
+  pthread_mutex_unlock(&_lock);
+
+  while (excess != NULL) {
+    PooledThreadStack* next = excess->_next;
+    unmap(excess);
+    excess = next;
+  }
+}
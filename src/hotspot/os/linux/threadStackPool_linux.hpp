@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef OS_LINUX_THREADSTACKPOOL_LINUX_HPP
+#define OS_LINUX_THREADSTACKPOOL_LINUX_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+#include <pthread.h>
+
+// A pool of Java thread stacks, enabled with -XX:ThreadStackPoolSize=<n>.
+//
+// A Java thread normally gets a fresh stack from glibc and then commits
+// and protects the HotSpot guard zone at its low end; on exit the guard
+// zone is removed again. A thread that runs on a pooled stack reuses the
+// memory of a thread that has exited, normally with the guard zone still
+// protected, so neither step is needed.
+//
+// Threads running on a pooled stack are created joinable. A released
+// stack is still in use by its thread until that thread has returned
+// from its start routine, so the thread is joined before the stack is
+// handed out again or unmapped.
+class PooledThreadStack : public CHeapObj<mtThread> {
+  friend class ThreadStackPool;
+
+  PooledThreadStack* _next;
+  address const _bottom;
+  size_t const _size;
+  pthread_t _owner;
+  bool _has_owner;
+  bool _guarded;
+
+  PooledThreadStack(address bottom, size_t size) :
+    _next(NULL), _bottom(bottom), _size(size), _owner(0), _has_owner(false), _guarded(false) {}
+
+ public:
+  address bottom() const { return _bottom; }
+  size_t size() const    { return _size; }
+
+  // True if the HotSpot guard zone at the bottom of the stack is protected.
+  bool is_guarded() const        { return _guarded; }
+  void set_guarded(bool guarded) { _guarded = guarded; }
+
+  // The thread running on this stack, joined before the stack is reused.
+  void set_owner(pthread_t owner) {
+    _owner = owner;
+    _has_owner = true;
+  }
+};
+
+class ThreadStackPool : AllStatic {
+  // A pthread mutex rather than a Mutex: release() runs after the thread
+  // has been detached from the VM.
+  static pthread_mutex_t    _lock;
+  static PooledThreadStack* _free_list;
+  static uint               _free_count;
+
+  static void join_owner(PooledThreadStack* stack);
+  static void unmap(PooledThreadStack* stack);
+
+ public:
+  static bool is_enabled() { return ThreadStackPoolSize > 0; }
+
+  // Returns a stack of the given size with its guard zone protected, or
+  // NULL if none could be set up.
+  static PooledThreadStack* take(size_t size);
+
+  // Returns a stack to the pool, unmapping the oldest stacks beyond
+  // ThreadStackPoolSize. Called by the thread running on the stack just
+  // before it returns from its start routine, or by its creator if the
+  // thread could not be started.
+  static void release(PooledThreadStack* stack);
+};
+
+#endif // OS_LINUX_THREADSTACKPOOL_LINUX_HPP
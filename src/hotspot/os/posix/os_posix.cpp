@@ -42,11 +42,17 @@
 #include <dirent.h>
 #include <dlfcn.h>
 #include <grp.h>
+#ifdef LINUX
+#include <linux/futex.h>
+#endif
 #include <pwd.h>
 #include <pthread.h>
 #include <signal.h>
 #include <sys/mman.h>
 #include <sys/resource.h>
+#ifdef LINUX
+#include <sys/syscall.h>
+#endif
 #include <sys/utsname.h>
 #include <time.h>
 #include <unistd.h>
@@ -1487,6 +1493,7 @@ size_t os::Posix::get_initial_stack_size(ThreadType thr_type, size_t req_stack_s
   case os::pgc_thread:
   case os::cgc_thread:
   case os::watcher_thread:
+  case os::asynclog_thread:
   default:  // presume the unknown thr_type is a VM internal
     if (req_stack_size == 0 && VMThreadStackSize > 0) {
       // no requested size and we have a more specific default value
@@ -2048,6 +2055,115 @@ void os::PlatformEvent::unpark() {
 
 // JSR166 support
 
+#ifdef LINUX
+
+static int futex_wait(volatile int* addr, int expected, const struct timespec* abstime, bool realtime) {
+  int op = FUTEX_WAIT_BITSET_PRIVATE | (realtime ? FUTEX_CLOCK_REALTIME : 0);
+  return syscall(SYS_futex, addr, op, expected, abstime, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+static int futex_wake(volatile int* addr) {
+  return syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+os::PlatformParker::PlatformParker() {
+  _spin_limit = (os::processor_count() > 1) ? MinSpin : 0;
+}
+
+// Parker::park consumes the permit if there is one, else spins for a
+// while and then blocks on _counter until unpark() sets it. Transitions
+// for _counter:
+//    1 =>  0 : permit consumed, return immediately
+//    0 => -1 : block in FUTEX_WAIT; then set _counter to 0 before returning
+// Spurious returns are fine, so a single FUTEX_WAIT is enough.
+
+void Parker::park(bool isAbsolute, jlong time) {
+
+  // Optional fast-path check:
+  // Return immediately if a permit is available.
+  // We depend on Atomic::xchg() having full barrier semantics
+  // since we are doing a lock-free update to _counter.
+  if (Atomic::xchg(&_counter, 0) > 0) return;
+
+  JavaThread *jt = JavaThread::current();
+
+  // Optional optimization -- avoid state transitions if there's
+  // an interrupt pending.
+  if (jt->is_interrupted(false)) {
+    return;
+  }
+
+  // Next, demultiplex/decode time arguments
+  struct timespec absTime;
+  if (time < 0 || (isAbsolute && time == 0)) { // don't wait at all
+    return;
+  }
+  if (time > 0) {
+    to_abstime(&absTime, time, isAbsolute, false);
+  }
+
+  ThreadBlockInVM tbivm(jt);
+
+  // Spin for the permit before blocking. This is done in the blocked
+  // state, so the spin does not hold up safepoints or handshakes. The
+  // spin grows while it keeps succeeding and shrinks when it does not.
+  // Only _counter is checked: JavaThread::interrupt() sets it through
+  // unpark(), so an interrupt ends the spin as well.
+  const int spin_limit = _spin_limit;
+  for (int i = 0; i < spin_limit; i++) {
+    if (_counter > 0 && Atomic::xchg(&_counter, 0) > 0) {
+      _spin_limit = MIN2(spin_limit * 2, (int)MaxSpin);
+      return;
+    }
+    SpinPause();
+  }
+  if (spin_limit > 0) {
+    _spin_limit = MAX2(spin_limit / 2, (int)MinSpin);
+  }
+
+  // Can't access interrupt state now that we are _thread_blocked. If we've
+  // been interrupted since we checked above then _counter will be > 0.
+  if (Atomic::cmpxchg(&_counter, 0, -1) != 0) {
+    // A permit arrived; consume it.
+    Atomic::xchg(&_counter, 0);
+    return;
+  }
+
+  OSThreadWaitState osts(jt->osthread(), false /* not Object.wait() */);
+  jt->set_suspend_equivalent();
+  // cleared by handle_special_suspend_equivalent_condition() or java_suspend_self()
+
+  // Relative times are measured with the clock that to_abstime() picked.
+#ifdef SUPPORTS_CLOCK_MONOTONIC
+  const bool realtime = isAbsolute || !os::Posix::supports_monotonic_clock() ||
+                        !_use_clock_monotonic_condattr;
+#else
+  const bool realtime = true;
+#endif
+  int status = futex_wait(&_counter, -1, (time == 0) ? NULL : &absTime, realtime);
+  assert(status == 0 || errno == EAGAIN || errno == EINTR || errno == ETIMEDOUT,
+         "futex FUTEX_WAIT failed: %s", os::strerror(errno));
+
+  // Consume a permit that arrived while blocked, or undo the -1.
+  Atomic::xchg(&_counter, 0);
+
+  // If externally suspended while waiting, re-suspend
+  if (jt->handle_special_suspend_equivalent_condition()) {
+    jt->java_suspend_self();
+  }
+}
+
+void Parker::unpark() {
+  // Only wake the thread if it is blocked in, or about to block in,
+  // FUTEX_WAIT; a thread that is still spinning sees the permit.
+  if (Atomic::xchg(&_counter, 1) < 0) {
+    int status = futex_wake(&_counter);
+    assert(status >= 0, "futex FUTEX_WAKE failed: %s", os::strerror(errno));
+  }
+}
+
+#else
+
  os::PlatformParker::PlatformParker() {
   int status;
   status = pthread_cond_init(&_cond[REL_INDEX], _condAttr);
@@ -2175,6 +2291,8 @@ void Parker::unpark() {
   }
 }
 
+#endif // LINUX
+
 // Platform Mutex/Monitor implementation
 
 #if PLATFORM_MONITOR_IMPL_INDIRECT
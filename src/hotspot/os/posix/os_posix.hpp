@@ -214,6 +214,25 @@ class PlatformEvent : public CHeapObj<mtSynchronizer> {
 // API updates of course). But Parker methods use fastpaths that break that
 // level of encapsulation - so combining the two remains a future project.
 
+#ifdef LINUX
+
+// On Linux the Parker blocks on a futex instead: Parker::_counter itself
+// is the futex word, with -1 meaning that the thread is blocked in park().
+// An uncontended handoff then costs at most one FUTEX_WAKE, and park()
+// spins briefly before blocking, for as long as spinning recently paid off.
+class PlatformParker : public CHeapObj<mtSynchronizer> {
+ protected:
+  static const int MinSpin = 16;
+  static const int MaxSpin = 1024;
+  int _spin_limit;  // Only used by the parking thread.
+
+ public:
+  ~PlatformParker() { guarantee(false, "invariant"); }
+  PlatformParker();
+};
+
+#else
+
 class PlatformParker : public CHeapObj<mtSynchronizer> {
  protected:
   enum {
@@ -224,13 +243,13 @@ class PlatformParker : public CHeapObj<mtSynchronizer> {
   pthread_mutex_t _mutex[1];
   pthread_cond_t  _cond[2]; // one for relative times and one for absolute
 
- public:       // TODO-FIXME: make dtor private
-  ~PlatformParker() { guarantee(false, "invariant"); }
-
  public:
+  ~PlatformParker() { guarantee(false, "invariant"); }
   PlatformParker();
 };
 
+#endif // LINUX
+
 // Workaround for a bug in macOSX kernel's pthread support (fixed in Mojave?).
 // Avoid ever allocating a pthread_mutex_t at the same address as one of our
 // former pthread_cond_t, by using freelists of mutexes and condvars.
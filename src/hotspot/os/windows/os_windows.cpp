@@ -628,6 +628,7 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
     case os::pgc_thread:
     case os::cgc_thread:
     case os::watcher_thread:
+    case os::asynclog_thread:
       if (VMThreadStackSize > 0) stack_size = (size_t)(VMThreadStackSize * K);
       break;
     }
@@ -3579,6 +3580,10 @@ OSReturn os::get_native_priority(const Thread* const thread,
   return OS_OK;
 }
 
+OSReturn os::set_native_affinity(Thread* thread, const char* cpu_list) {
+  return OS_ERR; // Not supported
+}
+
 // GetCurrentThreadId() returns DWORD
 intx os::current_thread_id()  { return GetCurrentThreadId(); }
 
@@ -38,15 +38,18 @@
 #include "prims/jniFastGetField.hpp"
 #include "prims/jvm_misc.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.inline.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
+#include "runtime/task.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/timer.hpp"
 #include "services/memTracker.hpp"
@@ -640,6 +643,225 @@ juint os::cpu_microcode_revision() {
   return result;
 }
 
+#ifdef AMD64
+
+// javaTimeNanos() from the TSC. Ticks are converted to nanoseconds with a
+// fixed-point multiplier calibrated against CLOCK_MONOTONIC, anchored at
+// the CLOCK_MONOTONIC value read at the end of the calibration so that the
+// switch from the clock_gettime() based clock is seamless.
+//
+// A periodic task checks the kernel clock source and recalibrates. When the
+// kernel stops using the TSC, javaTimeNanos() goes back to CLOCK_MONOTONIC
+// for good, offset so that it does not go backwards. Otherwise the
+// multiplier is recomputed over the whole time since the first calibration,
+// and the difference that has built up to CLOCK_MONOTONIC is slewed away
+// over the next interval rather than stepped.
+static const int    TscNanosShift = 32;
+static const jlong  TscCalibrationNanos = 10 * NANOSECS_PER_MILLISEC;
+static const int    TscRecalibrationMillis = 1000;
+
+// The conversion parameters are updated by the recalibration while other
+// threads read the clock, and are guarded by a sequence lock. The sequence
+// number is odd while an update is in progress.
+static volatile uint32_t tsc_seq = 0;
+static jlong  tsc_base_ticks = 0;
+static jlong  tsc_base_nanos = 0;
+static julong tsc_nanos_mult = 0; // nanoseconds per tick << TscNanosShift
+static bool   tsc_fallback = false;
+static jlong  tsc_fallback_offset = 0;
+
+// The first calibration sample, only used by the recalibration.
+static jlong  tsc_anchor_ticks = 0;
+static jlong  tsc_anchor_nanos = 0;
+
+// Like rdtsc(), but not executed ahead of earlier loads, as in the vDSO
+// clock_gettime(), so that the time read cannot precede a load of a time
+// published by another thread.
+static inline jlong rdtsc_ordered() {
+  uint32_t ts1, ts2;
+  __asm__ __volatile__ ("lfence; rdtsc" : "=a" (ts1), "=d" (ts2) : : "memory");
+  return (jlong)((uint64_t)ts1 | (uint64_t)ts2 << 32);
+}
+
+static inline jlong monotonic_nanos() {
+  struct timespec tp;
+  os::Posix::clock_gettime(CLOCK_MONOTONIC, &tp);
+  return jlong(tp.tv_sec) * NANOSECS_PER_SEC + jlong(tp.tv_nsec);
+}
+
+static inline jlong tsc_to_nanos(jlong ticks, jlong base_ticks, jlong base_nanos, julong mult) {
+  ticks -= base_ticks;
+  // The TSC of another CPU may lag the calibrating one by a few ticks
+  if (ticks < 0) {
+    ticks = 0;
+  }
+  return base_nanos + (jlong)(((unsigned __int128)ticks * mult) >> TscNanosShift);
+}
+
+// Reads CLOCK_MONOTONIC together with the TSC, keeping the pair from the
+// attempt with the smallest number of ticks around the clock read.
+static void sample_tsc_and_monotonic(jlong& ticks, jlong& nanos) {
+  jlong best_window = max_jlong;
+  for (int i = 0; i < 16; i++) {
+    jlong before = rdtsc_ordered();
+    jlong now = monotonic_nanos();
+    jlong after = rdtsc_ordered();
+    if (after - before < best_window) {
+      best_window = after - before;
+      ticks = before + (after - before) / 2;
+      nanos = now;
+    }
+  }
+}
+
+// The kernel only keeps the TSC as its clock source while the TSC is
+// invariant and synchronized across all CPUs, and switches away from it
+// when its watchdog finds otherwise.
+static bool kernel_clocksource_is_tsc() {
+  char buf[32] = {0};
+  FILE* fp = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+  if (fp == NULL) {
+    return false;
+  }
+  bool result = fgets(buf, sizeof(buf), fp) != NULL && strcmp(buf, "tsc\n") == 0;
+  fclose(fp);
+  return result;
+}
+
+// There is a single writer, the initialization and later the WatcherThread.
+// The TSC is read for the new base after the sequence number has become odd,
+// so readers that complete with the old parameters read a smaller TSC value.
+static void tsc_write_begin() {
+  Atomic::release_store(&tsc_seq, tsc_seq + 1);
+  OrderAccess::fence();
+}
+
+static void tsc_write_end() {
+  Atomic::release_store(&tsc_seq, tsc_seq + 1);
+}
+
+static void tsc_fall_back(const char* reason) {
+  tsc_write_begin();
+  jlong last = tsc_to_nanos(rdtsc_ordered(), tsc_base_ticks, tsc_base_nanos, tsc_nanos_mult);
+  tsc_fallback_offset = MAX2(last - monotonic_nanos(), (jlong)0);
+  tsc_fallback = true;
+  tsc_write_end();
+  log_info(os)("No longer using the TSC for javaTimeNanos, %s", reason);
+}
+
+// Returns false if javaTimeNanos() has gone back to CLOCK_MONOTONIC.
+static bool tsc_recalibrate() {
+  if (!kernel_clocksource_is_tsc()) {
+    tsc_fall_back("the kernel clock source is no longer tsc");
+    return false;
+  }
+
+  jlong ticks = 0, nanos = 0;
+  sample_tsc_and_monotonic(ticks, nanos);
+  if (ticks <= tsc_anchor_ticks) {
+    tsc_fall_back("the TSC went backwards");
+    return false;
+  }
+  julong mult = (julong)(((unsigned __int128)(nanos - tsc_anchor_nanos) << TscNanosShift) /
+                         (julong)(ticks - tsc_anchor_ticks));
+
+  // Only this thread writes the parameters, so it can read them unlocked.
+  const jlong interval = TscRecalibrationMillis * NANOSECS_PER_MILLISEC;
+  jlong error = tsc_to_nanos(ticks, tsc_base_ticks, tsc_base_nanos, tsc_nanos_mult) - nanos;
+  if (error > interval / 2 || error < -interval / 2) {
+    tsc_fall_back("the TSC disagrees with CLOCK_MONOTONIC");
+    return false;
+  }
+  mult = (julong)(((unsigned __int128)mult * (julong)(interval - error)) / (julong)interval);
+
+  tsc_write_begin();
+  jlong base_ticks = rdtsc_ordered();
+  tsc_base_nanos = tsc_to_nanos(base_ticks, tsc_base_ticks, tsc_base_nanos, tsc_nanos_mult);
+  tsc_base_ticks = base_ticks;
+  tsc_nanos_mult = mult;
+  tsc_write_end();
+
+  log_debug(os)("Recalibrated the TSC for javaTimeNanos, " JLONG_FORMAT " ns off CLOCK_MONOTONIC", error);
+  return true;
+}
+
+class TscRecalibrationTask : public PeriodicTask {
+ public:
+  TscRecalibrationTask() : PeriodicTask(TscRecalibrationMillis) {}
+
+  virtual void task() {
+    if (!tsc_recalibrate()) {
+      // Nothing left to do, reclaim our storage and disenroll ourself
+      delete this;
+    }
+  }
+};
+
+bool os::tsc_java_time_nanos_init() {
+  if (!os::supports_monotonic_clock() || !kernel_clocksource_is_tsc()) {
+    log_info(os)("Not using the TSC for javaTimeNanos, the kernel clock source is not tsc");
+    return false;
+  }
+
+  // Spin rather than sleep, the calibration only runs when requested
+  jlong start_ticks = 0, start_nanos = 0;
+  jlong end_ticks = 0, end_nanos = 0;
+  sample_tsc_and_monotonic(start_ticks, start_nanos);
+  do {
+    sample_tsc_and_monotonic(end_ticks, end_nanos);
+  } while (end_nanos - start_nanos < TscCalibrationNanos);
+
+  jlong ticks = end_ticks - start_ticks;
+  jlong nanos = end_nanos - start_nanos;
+  // Reject a TSC slower than 100 MHz, which is no invariant TSC
+  if (ticks < nanos / 10) {
+    log_info(os)("Not using the TSC for javaTimeNanos, calibration failed");
+    return false;
+  }
+
+  tsc_nanos_mult = (julong)(((unsigned __int128)nanos << TscNanosShift) / (julong)ticks);
+  tsc_base_ticks = end_ticks;
+  tsc_base_nanos = end_nanos;
+  tsc_anchor_ticks = start_ticks;
+  tsc_anchor_nanos = start_nanos;
+  log_info(os)("Using the TSC for javaTimeNanos, " JLONG_FORMAT " ticks per second",
+               (jlong)(((unsigned __int128)ticks * NANOSECS_PER_SEC) / (julong)nanos));
+  return true;
+}
+
+void os::tsc_java_time_nanos_engage() {
+  // Mutexes and the WatcherThread are not available yet at init time.
+  if (tsc_nanos_mult != 0) {
+    TscRecalibrationTask* task = new TscRecalibrationTask();
+    task->enroll();
+  }
+}
+
+jlong os::tsc_java_time_nanos() {
+  for (;;) {
+    uint32_t seq = Atomic::load_acquire(&tsc_seq);
+    if ((seq & 1) == 0) {
+      jlong base_ticks = tsc_base_ticks;
+      jlong base_nanos = tsc_base_nanos;
+      julong mult = tsc_nanos_mult;
+      bool fallback = tsc_fallback;
+      jlong offset = tsc_fallback_offset;
+      jlong ticks = fallback ? 0 : rdtsc_ordered();
+      // Keep the check of the sequence number after the TSC read
+      __asm__ __volatile__ ("lfence" : : : "memory");
+      if (Atomic::load(&tsc_seq) == seq) {
+        if (fallback) {
+          return monotonic_nanos() + offset;
+        }
+        return tsc_to_nanos(ticks, base_ticks, base_nanos, mult);
+      }
+    }
+    SpinPause();
+  }
+}
+
+#endif // AMD64
+
 bool os::is_allocatable(size_t bytes) {
 #ifdef AMD64
   // unused on amd64?
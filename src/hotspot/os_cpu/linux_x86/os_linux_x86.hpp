@@ -31,6 +31,13 @@
 
   static jlong rdtsc();
 
+#ifdef AMD64
+  // System.nanoTime() from the time stamp counter, see UseTSCForJavaTimeNanos
+  static bool  tsc_java_time_nanos_init();
+  static void  tsc_java_time_nanos_engage();
+  static jlong tsc_java_time_nanos();
+#endif
+
   static bool is_allocatable(size_t bytes);
 
   // Used to register dynamic code cache area with the OS
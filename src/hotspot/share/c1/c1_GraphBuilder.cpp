@@ -4034,6 +4034,42 @@ bool GraphBuilder::try_inline_full(ciMethod* callee, bool holder_known, bool ign
 }
 
 
+// Bind the virtual or interface target of a linkTo* call to a single
+// method, either from the exact type of the receiver or, for a virtual
+// call, with class hierarchy analysis. Returns NULL if that fails.
+ciMethod* GraphBuilder::bind_linked_target(vmIntrinsics::ID iid, ciMethod* target, Value receiver) {
+  ciInstanceKlass* calling_klass = method()->holder();
+  ciType* type = receiver->exact_type();
+  if (type != NULL && type->is_loaded() &&
+      type->is_instance_klass() && !type->as_instance_klass()->is_interface()) {
+    return target->resolve_invoke(calling_klass, type->as_instance_klass());
+  }
+
+  ciInstanceKlass* holder = target->holder();
+  if (iid != vmIntrinsics::_linkToVirtual || !UseCHA || !DeoptC1 || !holder->is_initialized()) {
+    return NULL;
+  }
+  ciInstanceKlass* actual_recv = holder;
+  type = receiver->declared_type();
+  if (type != NULL && type->is_loaded() &&
+      type->is_instance_klass() && !type->as_instance_klass()->is_interface()) {
+    ciInstanceKlass* receiver_klass = type->as_instance_klass();
+    if (receiver_klass->is_subtype_of(holder) && receiver_klass->is_initialized()) {
+      actual_recv = receiver_klass;
+    }
+  }
+  ciMethod* cha_monomorphic_target = target->find_monomorphic_target(calling_klass, holder, actual_recv);
+  if (cha_monomorphic_target == NULL || cha_monomorphic_target->is_abstract()) {
+    return NULL;
+  }
+  if (!cha_monomorphic_target->can_be_statically_bound(actual_recv)) {
+    // Same as for a regular invoke bound by CHA: depend on the target
+    // not getting overridden by dynamic class loading.
+    dependency_recorder()->assert_unique_concrete_method(actual_recv, cha_monomorphic_target);
+  }
+  return cha_monomorphic_target;
+}
+
 bool GraphBuilder::try_method_handle_inline(ciMethod* callee, bool ignore_return) {
   ValueStack* state_before = copy_state_before();
   vmIntrinsics::ID iid = callee->intrinsic_id();
@@ -4113,12 +4149,20 @@ bool GraphBuilder::try_method_handle_inline(ciMethod* callee, bool ignore_return
             }
             j += t->size();  // long and double take two slots
           }
-          // We don't do CHA here so only inline static and statically bindable methods.
           if (target->is_static() || target->can_be_statically_bound()) {
             Bytecodes::Code bc = target->is_static() ? Bytecodes::_invokestatic : Bytecodes::_invokevirtual;
             if (try_inline(target, /*holder_known*/ !callee->is_static(), ignore_return, bc)) {
               return true;
             }
+          } else if (iid == vmIntrinsics::_linkToVirtual || iid == vmIntrinsics::_linkToInterface) {
+            ciMethod* bound_target = bind_linked_target(iid, target, state()->stack_at(args_base));
+            if (bound_target != NULL) {
+              if (try_inline(bound_target, /*holder_known*/ true, ignore_return, Bytecodes::_invokespecial)) {
+                return true;
+              }
+            } else {
+              print_inlining(target, "no static binding", /*success*/ false);
+            }
           } else {
             print_inlining(target, "not static or statically bindable", /*success*/ false);
           }
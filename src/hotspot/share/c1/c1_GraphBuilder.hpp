@@ -359,6 +359,7 @@ class GraphBuilder {
 
   // JSR 292 support
   bool try_method_handle_inline(ciMethod* callee, bool ignore_return);
+  ciMethod* bind_linked_target(vmIntrinsics::ID iid, ciMethod* target, Value receiver);
 
   // helpers
   void inline_bailout(const char* msg);
@@ -3378,6 +3378,35 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
   } else {
     ShouldNotReachHere();
   }
+  LabelObj* skip = NULL;
+  int sample_shift = (int)C1ProfileCounterSampling;
+  if (sample_shift > 0) {
+    // Advance the thread's xorshift state and only update the shared
+    // counter for 1 in 2^sample_shift events, by 2^sample_shift steps.
+    skip = new LabelObj();
+    LIR_Address* state_addr = new LIR_Address(getThreadPointer(), in_bytes(JavaThread::profile_sample_state_offset()), T_INT);
+    LIR_Opr state = new_register(T_INT);
+    LIR_Opr tmp = new_register(T_INT);
+    __ load(state_addr, state);
+    __ shift_left(state, 13, tmp);
+    __ logical_xor(state, tmp, state);
+    __ unsigned_shift_right(state, 17, tmp);
+    __ logical_xor(state, tmp, state);
+    __ shift_left(state, 5, tmp);
+    __ logical_xor(state, tmp, state);
+    __ store(state, state_addr);
+    __ move(state, tmp);
+    __ logical_and(tmp, load_immediate(right_n_bits(sample_shift), T_INT), tmp);
+    __ cmp(lir_cond_notEqual, tmp, LIR_OprFact::intConst(0));
+    __ branch(lir_cond_notEqual, skip->label());
+    if (step->is_constant()) {
+      step = LIR_OprFact::intConst(step->as_jint() << sample_shift);
+    } else {
+      LIR_Opr scaled_step = new_register(T_INT);
+      __ shift_left(step, sample_shift, scaled_step);
+      step = scaled_step;
+    }
+  }
   LIR_Address* counter = new LIR_Address(counter_holder, offset, T_INT);
   LIR_Opr result = new_register(T_INT);
   __ load(counter, result);
@@ -3397,17 +3426,35 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
       }
     } else {
       LIR_Opr mask = load_immediate(freq, T_INT);
-      if (!step->is_constant()) {
-        // If step is 0, make sure the overflow check below always fails
-        __ cmp(lir_cond_notEqual, step, LIR_OprFact::intConst(0));
-        __ cmove(lir_cond_notEqual, result, LIR_OprFact::intConst(InvocationCounter::count_increment), result, T_INT);
+      if (sample_shift > 0) {
+        // Scaled increments need not be aligned with the notification
+        // frequency (counters get decayed), so check whether the update
+        // wrapped around the masked bits instead of testing for zero.
+        int increment = InvocationCounter::count_increment << sample_shift;
+        if (!step->is_constant()) {
+          // If step is 0, make sure the overflow check below always fails
+          __ cmp(lir_cond_notEqual, step, LIR_OprFact::intConst(0));
+          __ cmove(lir_cond_notEqual, result, LIR_OprFact::intConst(freq), result, T_INT);
+        }
+        __ logical_and(result, mask, result);
+        __ cmp(lir_cond_belowEqual, result, LIR_OprFact::intConst(increment - 1));
+        __ branch(lir_cond_belowEqual, overflow);
+      } else {
+        if (!step->is_constant()) {
+          // If step is 0, make sure the overflow check below always fails
+          __ cmp(lir_cond_notEqual, step, LIR_OprFact::intConst(0));
+          __ cmove(lir_cond_notEqual, result, LIR_OprFact::intConst(InvocationCounter::count_increment), result, T_INT);
+        }
+        __ logical_and(result, mask, result);
+        __ cmp(lir_cond_equal, result, LIR_OprFact::intConst(0));
+        __ branch(lir_cond_equal, overflow);
       }
-      __ logical_and(result, mask, result);
-      __ cmp(lir_cond_equal, result, LIR_OprFact::intConst(0));
-      __ branch(lir_cond_equal, overflow);
     }
     __ branch_destination(overflow->continuation());
   }
+  if (skip != NULL) {
+    __ branch_destination(skip->label());
+  }
 }
 
 void LIRGenerator::do_RuntimeCall(RuntimeCall* x) {
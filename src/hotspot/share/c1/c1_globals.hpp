@@ -334,6 +334,12 @@
   product(bool, C1UpdateMethodData, trueInTiered,                           \
           "Update MethodData*s in Tier1-generated code")                    \
                                                                             \
+  product(intx, C1ProfileCounterSampling, 0, EXPERIMENTAL,                  \
+          "Update invocation and backedge counters in profiled code only "  \
+          "on a random 1 in 2^n of the events, by 2^n at a time, to "       \
+          "reduce contention on shared counters (0 updates every time)")    \
+          range(0, 8)                                                       \
+                                                                            \
   develop(bool, PrintCFGToFile, false,                                      \
           "print control flow graph to a separate file during compilation")
 
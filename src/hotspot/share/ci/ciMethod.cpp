@@ -536,9 +536,11 @@ ciCallProfile ciMethod::call_profile_at_bci(int bci) {
         // or < 0 in the case of a type check failure for checkcast, aastore, instanceof.
         // The call site count is > 0 in the case of a polymorphic virtual call.
         if (morphism > 0 && morphism == result._limit) {
-           // The morphism <= MorphismLimit.
-           if ((morphism <  ciCallProfile::MorphismLimit) ||
-               (morphism == ciCallProfile::MorphismLimit && count == 0)) {
+           // The morphism <= MorphismLimit. All receivers were recorded if
+           // the profile has free rows or the polymorphic counter is zero.
+           int limit = MIN2((int)call->row_limit(), (int)ciCallProfile::MorphismLimit);
+           if ((morphism <  limit) ||
+               (morphism == limit && count == 0)) {
 #ifdef ASSERT
              if (count > 0) {
                this->print_short_name(tty);
@@ -33,6 +33,7 @@
 #include "classfile/systemDictionaryShared.hpp"
 #include "logging/log.hpp"
 #include "logging/logTag.hpp"
+#include "memory/lambdaFormInvokers.hpp"
 #include "memory/metaspaceShared.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/handles.inline.hpp"
@@ -86,6 +87,10 @@ bool ClassListParser::parse_one_line() {
     if (*_line == '#') { // comment
       continue;
     }
+    if (*_line == '@') {
+      parse_at_tags();
+      continue;
+    }
     break;
   }
 
@@ -165,6 +170,25 @@ bool ClassListParser::parse_one_line() {
   return true;
 }
 
+// Lines that start with '@' carry information other than a class to load.
+void ClassListParser::parse_at_tags() {
+  assert(_line[0] == '@', "must be");
+  int len = _line_len;
+  while (len > 0 && (_line[len - 1] == '\n' || _line[len - 1] == '\r' ||
+                     _line[len - 1] == ' '  || _line[len - 1] == '\t')) {
+    _line[--len] = '\0';
+  }
+
+  const char* tag = LambdaFormInvokers::lambda_form_invoker_tag();
+  size_t tag_len = strlen(tag);
+  if (strncmp(_line, tag, tag_len) == 0 && _line[tag_len] == ' ') {
+    LambdaFormInvokers::append(os::strdup(_line + tag_len + 1, mtClass));
+  } else {
+    _token = _line;
+    error("Unknown tag");
+  }
+}
+
 void ClassListParser::skip_whitespaces() {
   while (*_token == ' ' || *_token == '\t') {
     _token ++;
@@ -75,6 +75,7 @@ class ClassListParser : public StackObj {
   InstanceKlass* lookup_class_by_id(int id);
   void print_specified_interfaces();
   void print_actual_interfaces(InstanceKlass *ik);
+  void parse_at_tags();
 public:
   ClassListParser(const char* file);
   ~ClassListParser();
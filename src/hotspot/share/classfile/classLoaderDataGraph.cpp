@@ -37,8 +37,11 @@
 #include "memory/resourceArea.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/safepoint.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/vmOperations.hpp"
 #include "runtime/vmThread.hpp"
@@ -194,6 +197,7 @@ void ClassLoaderDataGraph::walk_metadata_and_clean_metaspaces() {
 // GC root of class loader data created.
 ClassLoaderData* volatile ClassLoaderDataGraph::_head = NULL;
 ClassLoaderData* ClassLoaderDataGraph::_unloading = NULL;
+ClassLoaderData* volatile ClassLoaderDataGraph::_deferred_purge = NULL;
 
 bool ClassLoaderDataGraph::_should_clean_deallocate_lists = false;
 bool ClassLoaderDataGraph::_safepoint_cleanup_needed = false;
@@ -591,6 +595,55 @@ void ClassLoaderDataGraph::purge(bool at_safepoint) {
   }
 }
 
+// Move the CLDs unloaded by this GC onto the deferred purge list so that
+// deleting them and returning their metaspace does not lengthen the pause.
+// The CLDs are no longer reachable from the graph and no thread can refer
+// to their metadata after the unloading pause, so they can be deleted
+// concurrently, as is done after concurrent class unloading.
+void ClassLoaderDataGraph::defer_purge() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (_unloading == NULL) {
+    return;
+  }
+  ClassLoaderData* tail = _unloading;
+  while (tail->next() != NULL) {
+    tail = tail->next();
+  }
+  tail->set_next(_deferred_purge);
+  Atomic::release_store(&_deferred_purge, _unloading);
+  _unloading = NULL;
+
+  MutexLocker ml(Service_lock, Mutex::_no_safepoint_check_flag);
+  Service_lock->notify_all();
+}
+
+bool ClassLoaderDataGraph::has_deferred_purge() {
+  return Atomic::load(&_deferred_purge) != NULL;
+}
+
+void ClassLoaderDataGraph::purge_deferred(JavaThread* jt) {
+  assert(jt == JavaThread::current(), "invariant");
+  // A later GC pause may add to the list; take the whole list now and
+  // process it without holding any lock.
+  ClassLoaderData* next = Atomic::xchg(&_deferred_purge, (ClassLoaderData*)NULL);
+  uint purged = 0;
+  while (next != NULL) {
+    ClassLoaderData* purge_me = next;
+    next = purge_me->next();
+    delete purge_me;
+    purged++;
+    // Do not hold up a safepoint for the whole list.
+    if (SafepointMechanism::should_process(jt)) {
+      ThreadBlockInVM tbivm(jt);
+    }
+  }
+  if (purged > 0) {
+    Metaspace::purge();
+    set_metaspace_oom(false);
+    log_debug(class, loader, data)("purge_deferred: loaders purged %u", purged);
+  }
+}
+
 int ClassLoaderDataGraph::resize_dictionaries() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
   int resized = 0;
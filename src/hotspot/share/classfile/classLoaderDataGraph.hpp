@@ -43,6 +43,9 @@ class ClassLoaderDataGraph : public AllStatic {
   // All CLDs (except the null CLD) can be reached by walking _head->_next->...
   static ClassLoaderData* volatile _head;
   static ClassLoaderData* _unloading;
+  // Unloaded CLDs whose metadata is freed by the ServiceThread after
+  // the pause instead of at the safepoint. See defer_purge().
+  static ClassLoaderData* volatile _deferred_purge;
 
   // Set if there's anything to purge in the deallocate lists or previous versions
   // during a safepoint after class unloading in a full GC.
@@ -63,6 +66,12 @@ class ClassLoaderDataGraph : public AllStatic {
   static ClassLoaderData* add(Handle class_loader, bool has_class_mirror_holder);
   static void clean_module_and_package_info();
   static void purge(bool at_safepoint);
+  // Hand the unloaded CLDs over to the ServiceThread, which frees them
+  // concurrently with the application.
+  static void defer_purge();
+  static bool has_deferred_purge();
+  // Called from ServiceThread
+  static void purge_deferred(JavaThread* jt);
   static void clear_claimed_marks();
   static void clear_claimed_marks(int claim);
   // Iteration through CLDG inside a safepoint; GC support
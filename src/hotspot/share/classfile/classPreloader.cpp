@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "classfile/classPreloader.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+
+GrowableArray<Symbol*>* ClassPreloader::_class_names = NULL;
+volatile int ClassPreloader::_next = 0;
+
+// Only the class name, i.e. the first token, of each line is used. Lines for
+// classes of unregistered loaders (with a "source:" attribute), lambda proxy
+// and other '@' directives, and comments are skipped.
+void ClassPreloader::read_class_list(const char* path) {
+  // Use os::open() because neither fopen() nor os::fopen()
+  // can handle long path name on Windows.
+  FILE* file = NULL;
+  int fd = os::open(path, O_RDONLY, S_IREAD);
+  if (fd != -1) {
+    file = os::open(fd, "r");
+  }
+  if (file == NULL) {
+    char errmsg[JVM_MAXPATHLEN];
+    os::lasterror(errmsg, JVM_MAXPATHLEN);
+    log_warning(class, load)("Cannot read PreloadClassListFile %s: %s", path, errmsg);
+    return;
+  }
+
+  _class_names = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Symbol*>(1024, mtClass);
+  char line[4096];
+  while (fgets(line, sizeof(line), file) != NULL) {
+    size_t len = strlen(line);
+    if (len > 0 && line[len - 1] != '\n' && !feof(file)) {
+      // Too long for a class list entry; skip the rest of the line.
+      int c;
+      while ((c = fgetc(file)) != EOF && c != '\n') {}
+      continue;
+    }
+    if (line[0] == '#' || line[0] == '@' || line[0] == '[' || strstr(line, " source:") != NULL) {
+      continue;
+    }
+    size_t name_len = strcspn(line, " \t\r\n");
+    if (name_len == 0 || name_len > (size_t)Symbol::max_length()) {
+      continue;
+    }
+    _class_names->append(SymbolTable::new_symbol(line, (int)name_len));
+  }
+  fclose(file);
+  log_info(class, load)("Preloading %d classes from %s", _class_names->length(), path);
+}
+
+void ClassPreloader::preload(Symbol* class_name, TRAPS) {
+  Handle loader(THREAD, SystemDictionary::java_system_loader());
+  Klass* k = SystemDictionary::resolve_or_null(class_name, loader, Handle(), THREAD);
+  if (!HAS_PENDING_EXCEPTION && k != NULL && k->is_instance_klass()) {
+    // Verification happens here, not at load time.
+    InstanceKlass::cast(k)->link_class(THREAD);
+  }
+  if (HAS_PENDING_EXCEPTION) {
+    if (log_is_enabled(Debug, class, load)) {
+      ResourceMark rm(THREAD);
+      log_debug(class, load)("Preloading %s failed: %s", class_name->as_C_string(),
+                             PENDING_EXCEPTION->klass()->external_name());
+    }
+    // Linking errors are not recorded, the application's first use of
+    // the class runs into the same error again.
+    CLEAR_PENDING_EXCEPTION;
+  }
+}
+
+void ClassPreloader::preloader_thread_entry(JavaThread* thread, TRAPS) {
+  const int length = _class_names->length();
+  for (int i = Atomic::fetch_and_add(&_next, 1); i < length; i = Atomic::fetch_and_add(&_next, 1)) {
+    HandleMark hm(THREAD);
+    Symbol* class_name = _class_names->at(i);
+    preload(class_name, THREAD);
+    class_name->decrement_refcount();
+  }
+}
+
+void ClassPreloader::initialize(TRAPS) {
+  if (PreloadClassListFile == NULL || Arguments::is_dumping_archive()) {
+    return;
+  }
+  read_class_list(PreloadClassListFile);
+  if (_class_names == NULL || _class_names->is_empty()) {
+    return;
+  }
+
+  const uint num_threads = MIN2(PreloadClassThreads, (uint)_class_names->length());
+  for (uint i = 0; i < num_threads; i++) {
+    char name[64];
+    jio_snprintf(name, sizeof(name), "Class Preloader Thread #%u", i);
+    Handle string = java_lang_String::create_from_str(name, CHECK);
+
+    // Initialize thread_oop to put it into the system threadGroup
+    Handle thread_group(THREAD, Universe::system_thread_group());
+    Handle thread_oop = JavaCalls::construct_new_instance(
+                            SystemDictionary::Thread_klass(),
+                            vmSymbols::threadgroup_string_void_signature(),
+                            thread_group,
+                            string,
+                            CHECK);
+
+    MutexLocker mu(THREAD, Threads_lock);
+    JavaThread* thread = new JavaThread(&preloader_thread_entry);
+    if (thread == NULL || thread->osthread() == NULL) {
+      // Preloading is only an optimization; the classes are loaded on demand.
+      log_warning(class, load)("Failed to start class preloader thread");
+      return;
+    }
+    java_lang_Thread::set_thread(thread_oop(), thread);
+    java_lang_Thread::set_priority(thread_oop(), NormPriority);
+    java_lang_Thread::set_daemon(thread_oop());
+    thread->set_threadObj(thread_oop());
+
+    Threads::add(thread);
+    Thread::start(thread);
+  }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_CLASSFILE_CLASSPRELOADER_HPP
+#define SHARE_CLASSFILE_CLASSPRELOADER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/exceptions.hpp"
+#include "utilities/growableArray.hpp"
+
+class JavaThread;
+class Symbol;
+
+// Speculative class loading for -XX:PreloadClassListFile.
+//
+// The classes named in the list are loaded and linked (parsed and verified)
+// by PreloadClassThreads background threads while the application starts,
+// so that most of that work is already done when the application first
+// asks for them. Each class is requested from the system class loader, as
+// Class.forName(name, false, ClassLoader.getSystemClassLoader()) would do:
+// delegation, placeholders and loader constraints are handled by
+// SystemDictionary like for any other parallel class loading, and static
+// initializers are not run. Failures are ignored; the application sees
+// them again when it uses the class.
+class ClassPreloader : AllStatic {
+  static GrowableArray<Symbol*>* _class_names;
+  static volatile int _next;
+
+  static void read_class_list(const char* path);
+  static void preload(Symbol* class_name, TRAPS);
+  static void preloader_thread_entry(JavaThread* thread, TRAPS);
+
+ public:
+  // Called once the system class loader is available.
+  static void initialize(TRAPS);
+};
+
+#endif // SHARE_CLASSFILE_CLASSPRELOADER_HPP
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/concurrentTableWorkBudget.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+
+ConcurrentTableWorkBudget::ConcurrentTableWorkBudget(JavaThread* jt, const char* table, const char* operation) :
+  _jt(jt),
+  _table(table),
+  _operation(operation),
+  _start(Ticks::now()),
+  _slice_start_ns(os::javaTimeNanos()),
+  _yields(0) {
+}
+
+void ConcurrentTableWorkBudget::yield() {
+  ThreadBlockInVM tbivm(_jt);
+  if (ConcurrentTableWorkTimeSliceMillis == 0) {
+    return;
+  }
+  jlong now = os::javaTimeNanos();
+  if (now - _slice_start_ns < (jlong)ConcurrentTableWorkTimeSliceMillis * NANOSECS_PER_MILLISEC) {
+    return;
+  }
+  // Back off while blocked, so that safepoints do not wait for us.
+  os::naked_short_sleep(ConcurrentTableWorkTimeSliceMillis);
+  _yields++;
+  _slice_start_ns = os::javaTimeNanos();
+}
+
+void ConcurrentTableWorkBudget::commit(size_t bucket_count, double load_factor, size_t dead_count) {
+  EventConcurrentTableWork event(UNTIMED);
+  if (event.should_commit()) {
+    event.set_starttime(_start);
+    event.set_endtime(Ticks::now());
+    event.set_table(_table);
+    event.set_operation(_operation);
+    event.set_bucketCount(bucket_count);
+    event.set_loadFactor((float)load_factor);
+    event.set_deadCount(dead_count);
+    event.set_yields(_yields);
+    event.commit();
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_CLASSFILE_CONCURRENTTABLEWORKBUDGET_HPP
+#define SHARE_CLASSFILE_CONCURRENTTABLEWORKBUDGET_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/ticks.hpp"
+
+class JavaThread;
+
+// Paces the concurrent growing and cleaning of the StringTable and SymbolTable
+// by the service thread. The table operations process ConcurrentTableWorkChunkLog2
+// buckets at a time and call yield() in between, with the operation paused.
+// Once the operation used up its ConcurrentTableWorkTimeSliceMillis time slice,
+// yield() backs off for the same time, so that a large table operation does not
+// compete with application threads for its whole duration.
+class ConcurrentTableWorkBudget : public StackObj {
+  JavaThread* const _jt;
+  const char* const _table;
+  const char* const _operation;
+  const Ticks _start;
+  jlong _slice_start_ns;
+  uint _yields;
+
+public:
+  ConcurrentTableWorkBudget(JavaThread* jt, const char* table, const char* operation);
+
+  // Checks for safepoints, and backs off if the time slice is used up.
+  void yield();
+
+  uint yields() const { return _yields; }
+
+  // Reports the completed operation.
+  void commit(size_t bucket_count, double load_factor, size_t dead_count);
+};
+
+#endif // SHARE_CLASSFILE_CONCURRENTTABLEWORKBUDGET_HPP
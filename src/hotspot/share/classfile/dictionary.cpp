@@ -74,7 +74,7 @@ Dictionary::~Dictionary() {
 
 DictionaryEntry* Dictionary::new_entry(unsigned int hash, InstanceKlass* klass) {
   DictionaryEntry* entry = (DictionaryEntry*)Hashtable<InstanceKlass*, mtClass>::allocate_new_entry(hash, klass);
-  entry->set_pd_set(NULL);
+  entry->release_set_pd_set(NULL);
   assert(klass->is_instance_klass(), "Must be");
   return entry;
 }
@@ -85,9 +85,9 @@ void Dictionary::free_entry(DictionaryEntry* entry) {
   // pd_set is accessed during a safepoint.
   // This doesn't require a lock because nothing is reading this
   // entry anymore.  The ClassLoader is dead.
-  while (entry->pd_set() != NULL) {
-    ProtectionDomainEntry* to_delete = entry->pd_set();
-    entry->set_pd_set(to_delete->next());
+  while (entry->pd_set_acquire() != NULL) {
+    ProtectionDomainEntry* to_delete = entry->pd_set_acquire();
+    entry->release_set_pd_set(to_delete->next_acquire());
     delete to_delete;
   }
   // Unlink from the Hashtable prior to freeing
@@ -151,16 +151,16 @@ bool Dictionary::resize_if_needed() {
 }
 
 bool DictionaryEntry::contains_protection_domain(oop protection_domain) const {
-  // Lock the pd_set list.  This lock cannot safepoint since the caller holds
-  // a Dictionary entry, which can be moved if the Dictionary is resized.
-  MutexLocker ml(ProtectionDomainSet_lock, Mutex::_no_safepoint_check_flag);
+  // The pd_set list is walked without a lock; the caller must not reach a
+  // safepoint or handshake until it's done with the entries, since unlinked
+  // entries are freed after a handshake.
 #ifdef ASSERT
   if (protection_domain == instance_klass()->protection_domain()) {
     // Ensure this doesn't show up in the pd_set (invariant)
     bool in_pd_set = false;
-    for (ProtectionDomainEntry* current = pd_set();
+    for (ProtectionDomainEntry* current = pd_set_acquire();
                                 current != NULL;
-                                current = current->next()) {
+                                current = current->next_acquire()) {
       if (current->object_no_keepalive() == protection_domain) {
         in_pd_set = true;
         break;
@@ -178,9 +178,9 @@ bool DictionaryEntry::contains_protection_domain(oop protection_domain) const {
     return true;
   }
 
-  for (ProtectionDomainEntry* current = pd_set();
+  for (ProtectionDomainEntry* current = pd_set_acquire();
                               current != NULL;
-                              current = current->next()) {
+                              current = current->next_acquire()) {
     if (current->object_no_keepalive() == protection_domain) return true;
   }
   return false;
@@ -195,8 +195,9 @@ void DictionaryEntry::add_protection_domain(Dictionary* dict, Handle protection_
     // With concurrent PD table cleanup, these links could be broken.
     MutexLocker ml(ProtectionDomainSet_lock, Mutex::_no_safepoint_check_flag);
     ProtectionDomainEntry* new_head =
-                new ProtectionDomainEntry(entry, pd_set());
-    set_pd_set(new_head);
+                new ProtectionDomainEntry(entry, pd_set_acquire());
+    // Publish the fully constructed entry to lock-free readers.
+    release_set_pd_set(new_head);
   }
   LogTarget(Trace, protectiondomain) lt;
   if (lt.is_enabled()) {
@@ -356,7 +357,9 @@ bool Dictionary::is_valid_protection_domain(unsigned int hash,
 
 // During class loading we may have cached a protection domain that has
 // since been unreferenced, so this entry should be cleared.
-void Dictionary::clean_cached_protection_domains() {
+// Dead entries are unlinked here but only freed by the caller, once no
+// lock-free reader can still be traversing them.
+void Dictionary::clean_cached_protection_domains(GrowableArray<ProtectionDomainEntry*>* delete_list) {
   assert_locked_or_safepoint(SystemDictionary_lock);
   assert(!loader_data()->has_class_mirror_holder(), "cld should have a ClassLoader holder not a Class holder");
 
@@ -372,7 +375,7 @@ void Dictionary::clean_cached_protection_domains() {
       Klass* e = probe->instance_klass();
 
       MutexLocker ml(ProtectionDomainSet_lock, Mutex::_no_safepoint_check_flag);
-      ProtectionDomainEntry* current = probe->pd_set();
+      ProtectionDomainEntry* current = probe->pd_set_acquire();
       ProtectionDomainEntry* prev = NULL;
       while (current != NULL) {
         if (current->object_no_keepalive() == NULL) {
@@ -386,18 +389,18 @@ void Dictionary::clean_cached_protection_domains() {
             ls.print(" loading: "); probe->instance_klass()->print_value_on(&ls);
             ls.cr();
           }
-          if (probe->pd_set() == current) {
-            probe->set_pd_set(current->next());
+          if (probe->pd_set_acquire() == current) {
+            probe->release_set_pd_set(current->next_acquire());
           } else {
             assert(prev != NULL, "should be set by alive entry");
-            prev->set_next(current->next());
+            prev->release_set_next(current->next_acquire());
           }
-          ProtectionDomainEntry* to_delete = current;
-          current = current->next();
-          delete to_delete;
+          // Readers may still be looking at current, which keeps its _next.
+          delete_list->push(current);
+          current = current->next_acquire();
         } else {
           prev = current;
-          current = current->next();
+          current = current->next_acquire();
         }
       }
     }
@@ -489,9 +492,9 @@ void SymbolPropertyTable::free_entry(SymbolPropertyEntry* entry) {
 
 void DictionaryEntry::verify_protection_domain_set() {
   MutexLocker ml(ProtectionDomainSet_lock, Mutex::_no_safepoint_check_flag);
-  for (ProtectionDomainEntry* current = pd_set(); // accessed at a safepoint
+  for (ProtectionDomainEntry* current = pd_set_acquire(); // accessed at a safepoint
                               current != NULL;
-                              current = current->_next) {
+                              current = current->next_acquire()) {
     guarantee(oopDesc::is_oop_or_null(current->_pd_cache->object_no_keepalive()), "Invalid oop");
   }
 }
@@ -499,9 +502,9 @@ void DictionaryEntry::verify_protection_domain_set() {
 void DictionaryEntry::print_count(outputStream *st) {
   MutexLocker ml(ProtectionDomainSet_lock, Mutex::_no_safepoint_check_flag);
   int count = 0;
-  for (ProtectionDomainEntry* current = pd_set();  // accessed inside SD lock
+  for (ProtectionDomainEntry* current = pd_set_acquire();  // accessed inside SD lock
                               current != NULL;
-                              current = current->_next) {
+                              current = current->next_acquire()) {
     count++;
   }
   st->print_cr("pd set count = #%d", count);
@@ -26,6 +26,7 @@
 #include "jvm.h"
 #include "classfile/classFileParser.hpp"
 #include "classfile/fieldLayoutBuilder.hpp"
+#include "classfile/hotFieldTable.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/array.hpp"
 #include "oops/fieldStreams.inline.hpp"
@@ -505,6 +506,7 @@ FieldLayoutBuilder::FieldLayoutBuilder(const Symbol* classname, const InstanceKl
   _fields(fields),
   _info(info),
   _root_group(NULL),
+  _hot_group(NULL),
   _contended_groups(GrowableArray<FieldGroup*>(8)),
   _static_fields(NULL),
   _layout(NULL),
@@ -538,6 +540,9 @@ void FieldLayoutBuilder::prologue() {
   _static_layout->initialize_static_layout();
   _static_fields = new FieldGroup();
   _root_group = new FieldGroup();
+  if (HotFieldTable::has_hot_fields(const_cast<Symbol*>(_classname))) {
+    _hot_group = new FieldGroup();
+  }
 }
 
 // Field sorting for regular classes:
@@ -545,6 +550,7 @@ void FieldLayoutBuilder::prologue() {
 //   - non-static fields are also sorted according to their contention group
 //     (support of the @Contended annotation)
 //   - @Contended annotation is ignored for static fields
+//   - other non-static fields listed in HotFieldsFile go to the hot group
 void FieldLayoutBuilder::regular_field_sorting() {
   for (AllFieldStream fs(_fields, _constant_pool); !fs.done(); fs.next()) {
     FieldGroup* group = NULL;
@@ -560,6 +566,9 @@ void FieldLayoutBuilder::regular_field_sorting() {
         } else {
           group = get_or_create_contended_group(g);
         }
+      } else if (_hot_group != NULL &&
+                 HotFieldTable::is_hot(const_cast<Symbol*>(_classname), fs.name())) {
+        group = _hot_group;
       } else {
         group = _root_group;
       }
@@ -587,6 +596,9 @@ void FieldLayoutBuilder::regular_field_sorting() {
     }
   }
   _root_group->sort_by_size();
+  if (_hot_group != NULL) {
+    _hot_group->sort_by_size();
+  }
   _static_fields->sort_by_size();
   if (!_contended_groups.is_empty()) {
     for (int i = 0; i < _contended_groups.length(); i++) {
@@ -607,6 +619,8 @@ void FieldLayoutBuilder::insert_contended_padding(LayoutRawBlock* slot) {
 //   - primitive fields are allocated first (from the biggest to the smallest)
 //   - then oop fields are allocated, either in existing gaps or at the end of
 //     the layout
+// Fields of the hot group, if any, are allocated the same way before all other
+// fields, so that they end up as close to the object header as possible.
 void FieldLayoutBuilder::compute_regular_layout() {
   bool need_tail_padding = false;
   prologue();
@@ -619,6 +633,10 @@ void FieldLayoutBuilder::compute_regular_layout() {
     insert_contended_padding(_layout->start());
     need_tail_padding = true;
   }
+  if (_hot_group != NULL) {
+    _layout->add(_hot_group->primitive_fields());
+    _layout->add(_hot_group->oop_fields());
+  }
   _layout->add(_root_group->primitive_fields());
   _layout->add(_root_group->oop_fields());
 
@@ -655,6 +673,13 @@ void FieldLayoutBuilder::epilogue() {
     _super_klass->nonstatic_oop_map_count());
   }
 
+  if (_hot_group != NULL && _hot_group->oop_fields() != NULL) {
+    for (int i = 0; i < _hot_group->oop_fields()->length(); i++) {
+      LayoutRawBlock* b = _hot_group->oop_fields()->at(i);
+      nonstatic_oop_maps->add(b->offset(), 1);
+    }
+  }
+
   if (_root_group->oop_fields() != NULL) {
     for (int i = 0; i < _root_group->oop_fields()->length(); i++) {
       LayoutRawBlock* b = _root_group->oop_fields()->at(i);
@@ -233,6 +233,7 @@ class FieldLayoutBuilder : public ResourceObj {
   Array<u2>* _fields;
   FieldLayoutInfo* _info;
   FieldGroup* _root_group;
+  FieldGroup* _hot_group;   // fields listed in HotFieldsFile, NULL if none
   GrowableArray<FieldGroup*> _contended_groups;
   FieldGroup* _static_fields;
   FieldLayout* _layout;
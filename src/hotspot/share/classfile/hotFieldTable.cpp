@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "classfile/hotFieldTable.hpp"
+#include "classfile/symbolTable.hpp"
+#include "logging/log.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/resourceHash.hpp"
+
+// Maps a class name to the names of its hot fields.
+typedef ResourceHashtable<Symbol*, GrowableArray<Symbol*>*,
+                          primitive_hash<Symbol*>, primitive_equals<Symbol*>,
+                          1031, ResourceObj::C_HEAP, mtClass> HotFieldMap;
+
+static HotFieldMap* _hot_fields = NULL;
+
+void HotFieldTable::initialize() {
+  if (HotFieldsFile == NULL) {
+    return;
+  }
+  // Use os::open() because neither fopen() nor os::fopen()
+  // can handle long path name on Windows.
+  FILE* file = NULL;
+  int fd = os::open(HotFieldsFile, O_RDONLY, S_IREAD);
+  if (fd != -1) {
+    file = os::open(fd, "r");
+  }
+  if (file == NULL) {
+    char errmsg[JVM_MAXPATHLEN];
+    os::lasterror(errmsg, JVM_MAXPATHLEN);
+    log_warning(class)("Cannot read HotFieldsFile %s: %s", HotFieldsFile, errmsg);
+    return;
+  }
+
+  HotFieldMap* table = new (ResourceObj::C_HEAP, mtClass) HotFieldMap();
+  int num_fields = 0;
+  char line[4096];
+  while (fgets(line, sizeof(line), file) != NULL) {
+    size_t len = strlen(line);
+    if (len > 0 && line[len - 1] != '\n' && !feof(file)) {
+      // Too long for a field entry; skip the rest of the line.
+      int c;
+      while ((c = fgetc(file)) != EOF && c != '\n') {}
+      continue;
+    }
+    if (line[0] == '#') {
+      continue;
+    }
+    const char* delims = " \t\r\n";
+    size_t class_len = strcspn(line, delims);
+    char* field = line + class_len;
+    field += strspn(field, delims);
+    size_t field_len = strcspn(field, delims);
+    if (class_len == 0 || field_len == 0 ||
+        class_len > (size_t)Symbol::max_length() || field_len > (size_t)Symbol::max_length()) {
+      continue;
+    }
+    for (size_t i = 0; i < class_len; i++) {
+      if (line[i] == '.') {
+        line[i] = '/';
+      }
+    }
+    line[class_len] = '\0';
+    field[field_len] = '\0';
+
+    // The symbols are kept alive by the table for the lifetime of the VM.
+    Symbol* class_name = SymbolTable::new_permanent_symbol(line);
+    Symbol* field_name = SymbolTable::new_permanent_symbol(field);
+    GrowableArray<Symbol*>** fields = table->get(class_name);
+    if (fields == NULL) {
+      GrowableArray<Symbol*>* list = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Symbol*>(4, mtClass);
+      table->put(class_name, list);
+      fields = table->get(class_name);
+    }
+    if (!(*fields)->contains(field_name)) {
+      (*fields)->append(field_name);
+      num_fields++;
+    }
+  }
+  fclose(file);
+
+  _hot_fields = table;
+  log_info(class)("Read %d hot fields from %s", num_fields, HotFieldsFile);
+}
+
+bool HotFieldTable::has_hot_fields(Symbol* class_name) {
+  return _hot_fields != NULL && _hot_fields->get(class_name) != NULL;
+}
+
+bool HotFieldTable::is_hot(Symbol* class_name, Symbol* field_name) {
+  if (_hot_fields == NULL) {
+    return false;
+  }
+  GrowableArray<Symbol*>** fields = _hot_fields->get(class_name);
+  return fields != NULL && (*fields)->contains(field_name);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_CLASSFILE_HOTFIELDTABLE_HPP
+#define SHARE_CLASSFILE_HOTFIELDTABLE_HPP
+
+#include "memory/allocation.hpp"
+
+class Symbol;
+
+// The instance fields named in -XX:HotFieldsFile, typically the fields
+// that a profiling run found to be accessed most often.
+//
+// FieldLayoutBuilder lays these fields out before all other fields of
+// their class, so that they share the cache line that holds the object
+// header, and the remaining (cold) fields of the class follow them. Each
+// line of the file names one field as "<class> <field>", with the class
+// name in either internal (java/lang/String) or external (java.lang.String)
+// form. Anything after the field name, such as an access count, is ignored,
+// as are empty lines and lines starting with '#'.
+//
+// The table is read once during VM startup and is immutable afterwards, so
+// lookups need no locking. Classes loaded from the CDS archive keep the
+// layout they were dumped with.
+class HotFieldTable : AllStatic {
+ public:
+  static void initialize();
+
+  static bool has_hot_fields(Symbol* class_name);
+  static bool is_hot(Symbol* class_name, Symbol* field_name);
+};
+
+#endif // SHARE_CLASSFILE_HOTFIELDTABLE_HPP
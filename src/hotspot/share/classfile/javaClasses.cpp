@@ -1321,7 +1321,7 @@ bool java_lang_Class::restore_archived_mirror(Klass *k,
 
   // mirror is archived, restore
   log_debug(cds, mirror)("Archived mirror is: " PTR_FORMAT, p2i(m));
-  assert(HeapShared::is_archived_object(m), "must be archived mirror object");
+  assert(HeapShared::is_archived_object(m) || HeapShared::is_loaded(), "must be archived mirror object");
   assert(as_Klass(m) == k, "must be");
   Handle mirror(THREAD, m);
 
@@ -2096,7 +2096,15 @@ class BacktraceBuilder: public StackObj {
 
   // constructor for new backtrace
   BacktraceBuilder(TRAPS): _head(NULL), _methods(NULL), _bcis(NULL), _mirrors(NULL), _names(NULL), _has_hidden_top_frame(false) {
-    expand(CHECK);
+    expand(trace_chunk_size, CHECK);
+    _backtrace = Handle(THREAD, _head);
+    _index = 0;
+  }
+
+  // constructor for a new backtrace of known depth, which is held in a
+  // single chunk of exactly that size
+  BacktraceBuilder(int depth, TRAPS): _head(NULL), _methods(NULL), _bcis(NULL), _mirrors(NULL), _names(NULL), _has_hidden_top_frame(false) {
+    expand(depth, CHECK);
     _backtrace = Handle(THREAD, _head);
     _index = 0;
   }
@@ -2118,23 +2126,23 @@ class BacktraceBuilder: public StackObj {
     _index = 0;
   }
 
-  void expand(TRAPS) {
+  void expand(int size, TRAPS) {
     objArrayHandle old_head(THREAD, _head);
     PauseNoSafepointVerifier pnsv(&_nsv);
 
     objArrayOop head = oopFactory::new_objectArray(trace_size, CHECK);
     objArrayHandle new_head(THREAD, head);
 
-    typeArrayOop methods = oopFactory::new_shortArray(trace_chunk_size, CHECK);
+    typeArrayOop methods = oopFactory::new_shortArray(size, CHECK);
     typeArrayHandle new_methods(THREAD, methods);
 
-    typeArrayOop bcis = oopFactory::new_intArray(trace_chunk_size, CHECK);
+    typeArrayOop bcis = oopFactory::new_intArray(size, CHECK);
     typeArrayHandle new_bcis(THREAD, bcis);
 
-    objArrayOop mirrors = oopFactory::new_objectArray(trace_chunk_size, CHECK);
+    objArrayOop mirrors = oopFactory::new_objectArray(size, CHECK);
     objArrayHandle new_mirrors(THREAD, mirrors);
 
-    typeArrayOop names = oopFactory::new_symbolArray(trace_chunk_size, CHECK);
+    typeArrayOop names = oopFactory::new_symbolArray(size, CHECK);
     typeArrayHandle new_names(THREAD, names);
 
     if (!old_head.is_null()) {
@@ -2164,9 +2172,9 @@ class BacktraceBuilder: public StackObj {
     // to a 0 even if it could be recorded.
     if (bci == SynchronizationEntryBCI) bci = 0;
 
-    if (_index >= trace_chunk_size) {
+    if (_index >= _methods->length()) {
       methodHandle mhandle(THREAD, method);
-      expand(CHECK);
+      expand(trace_chunk_size, CHECK);
       method = mhandle();
     }
 
@@ -2231,7 +2239,6 @@ class BacktraceIterator : public StackObj {
  public:
   BacktraceIterator(objArrayHandle result, Thread* thread) {
     init(result, thread);
-    assert(_methods.is_null() || _methods->length() == java_lang_Throwable::trace_chunk_size, "lengths don't match");
   }
 
   BacktraceElement next(Thread* thread) {
@@ -2242,7 +2249,9 @@ class BacktraceIterator : public StackObj {
                         _names->symbol_at(_index));
     _index++;
 
-    if (_index >= java_lang_Throwable::trace_chunk_size) {
+    // Chunks are usually trace_chunk_size long, but a backtrace filled in
+    // at once is a single chunk of its depth.
+    if (_index >= _methods->length()) {
       int next_offset = java_lang_Throwable::trace_next_offset;
       // Get next chunk
       objArrayHandle result (thread, objArrayOop(_result->obj_at(next_offset)));
@@ -2252,7 +2261,7 @@ class BacktraceIterator : public StackObj {
   }
 
   bool repeat() {
-    return _result.not_null() && _mirrors->obj_at(_index) != NULL;
+    return _result.not_null() && _index < _mirrors->length() && _mirrors->obj_at(_index) != NULL;
   }
 };
 
@@ -2416,12 +2425,11 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
   int max_depth = MaxJavaStackTraceDepth;
   JavaThread* thread = THREAD->as_Java_thread();
 
-  BacktraceBuilder bt(CHECK);
-
   // If there is no Java frame just return the method that was being called
   // with bci 0
   if (!thread->has_last_Java_frame()) {
     if (max_depth >= 1 && method() != NULL) {
+      BacktraceBuilder bt(1, CHECK);
       bt.push(method(), 0, CHECK);
       log_info(stacktrace)("%s, %d", throwable->klass()->external_name(), 1);
       set_depth(throwable(), 1);
@@ -2439,6 +2447,13 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
 #ifdef ASSERT
   vframeStream st(thread);
 #endif
+  // The frames are first collected into a resource area buffer, so that
+  // the walk does not allocate in the Java heap and the backtrace arrays
+  // can then be allocated at once with their final size.
+  GrowableArray<Method*> methods(32);
+  GrowableArray<int> bcis(32);
+  bool has_hidden_top_frame = false;
+
   int total_count = 0;
   RegisterMap map(thread, false);
   int decode_offset = 0;
@@ -2523,15 +2538,26 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
       if (skip_hidden) {
         if (total_count == 0) {
           // The top frame will be hidden from the stack trace.
-          bt.set_has_hidden_top_frame(CHECK);
+          has_hidden_top_frame = true;
         }
         continue;
       }
     }
-    bt.push(method, bci, CHECK);
+    methods.append(method);
+    bcis.append(bci);
     total_count++;
   }
 
+  // The methods are on this thread's stack, which keeps them alive and
+  // prevents their deallocation by RedefineClasses across the allocation.
+  BacktraceBuilder bt(total_count, CHECK);
+  if (has_hidden_top_frame) {
+    bt.set_has_hidden_top_frame(CHECK);
+  }
+  for (int i = 0; i < total_count; i++) {
+    bt.push(methods.at(i), bcis.at(i), CHECK);
+  }
+
   log_info(stacktrace)("%s, %d", throwable->klass()->external_name(), total_count);
 
   // Put completed stack trace into throwable object
@@ -2835,6 +2861,19 @@ void java_lang_StackFrameInfo::set_method_and_bci(Handle stackFrame, const metho
   java_lang_StackFrameInfo::set_version(stackFrame(), (short)version);
 }
 
+// Make stackFrame refer to the same method as other, which has been filled
+// by set_method_and_bci, without resolving the method again.
+void java_lang_StackFrameInfo::copy_method_and_set_bci(oop stackFrame, oop other, int bci) {
+  oop mname = stackFrame->obj_field(_memberName_offset);
+  oop other_mname = other->obj_field(_memberName_offset);
+  java_lang_invoke_MemberName::set_flags  (mname, java_lang_invoke_MemberName::flags(other_mname));
+  java_lang_invoke_MemberName::set_method (mname, java_lang_invoke_MemberName::method(other_mname));
+  java_lang_invoke_MemberName::set_vmindex(mname, java_lang_invoke_MemberName::vmindex(other_mname));
+  java_lang_invoke_MemberName::set_clazz  (mname, java_lang_invoke_MemberName::clazz(other_mname));
+  java_lang_StackFrameInfo::set_bci(stackFrame, bci);
+  java_lang_StackFrameInfo::set_version(stackFrame, other->short_field(_version_offset));
+}
+
 void java_lang_StackFrameInfo::to_stack_trace_element(Handle stackFrame, Handle stack_trace_element, TRAPS) {
   ResourceMark rm(THREAD);
   HandleMark hm(THREAD);
@@ -3888,6 +3927,11 @@ bool java_lang_invoke_MemberName::is_method(oop mname) {
   return (flags(mname) & (MN_IS_METHOD | MN_IS_CONSTRUCTOR)) > 0;
 }
 
+oop java_lang_invoke_MemberName::method(oop mname) {
+  assert(is_instance(mname), "wrong type");
+  return mname->obj_field(_method_offset);
+}
+
 void java_lang_invoke_MemberName::set_method(oop mname, oop resolved_method) {
   assert(is_instance(mname), "wrong type");
   mname->obj_field_put(_method_offset, resolved_method);
@@ -1106,6 +1106,7 @@ class java_lang_invoke_MemberName: AllStatic {
 
   // Link through ResolvedMethodName field to get Method*
   static Method*        vmtarget(oop mname);
+  static oop            method(oop mname);
   static void       set_method(oop mname, oop method);
 
   static intptr_t       vmindex(oop mname);
@@ -1443,6 +1444,7 @@ private:
 public:
   // Setters
   static void set_method_and_bci(Handle stackFrame, const methodHandle& method, int bci, TRAPS);
+  static void copy_method_and_set_bci(oop stackFrame, oop other, int bci);
   static void set_bci(oop info, int value);
 
   static void set_version(oop info, short value);
@@ -30,6 +30,7 @@
 #include "classfile/classLoaderData.inline.hpp"
 #include "classfile/classLoadInfo.hpp"
 #include "classfile/klassFactory.hpp"
+#include "compiler/profileCache.hpp"
 #include "memory/filemap.hpp"
 #include "memory/metaspaceShared.hpp"
 #include "memory/resourceArea.hpp"
@@ -218,6 +219,10 @@ InstanceKlass* KlassFactory::create_from_stream(ClassFileStream* stream,
 
   JFR_ONLY(ON_KLASS_CREATION(result, parser, THREAD);)
 
+  if (ProfileCache::is_recording()) {
+    ProfileCache::record_class_file(result, stream);
+  }
+
 #if INCLUDE_CDS
   if (Arguments::is_dumping_archive()) {
     ClassLoader::record_result(result, stream, THREAD);
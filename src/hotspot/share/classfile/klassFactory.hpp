@@ -67,6 +67,7 @@ class KlassFactory : AllStatic {
   friend class ClassLoader;
   friend class ClassLoaderExt;
   friend class SystemDictionary;
+  friend class LambdaFormInvokers;
 
  private:
   static InstanceKlass* create_from_stream(ClassFileStream* stream,
@@ -34,6 +34,7 @@
 #include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/weakHandle.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "utilities/hashtable.inline.hpp"
 
 unsigned int ProtectionDomainCacheTable::compute_hash(Handle protection_domain) {
@@ -58,15 +59,30 @@ void ProtectionDomainCacheTable::trigger_cleanup() {
 }
 
 class CleanProtectionDomainEntries : public CLDClosure {
+  GrowableArray<ProtectionDomainEntry*>* _delete_list;
+ public:
+  CleanProtectionDomainEntries(GrowableArray<ProtectionDomainEntry*>* delete_list) :
+    _delete_list(delete_list) {}
+
   void do_cld(ClassLoaderData* data) {
     Dictionary* dictionary = data->dictionary();
     if (dictionary != NULL) {
-      dictionary->clean_cached_protection_domains();
+      dictionary->clean_cached_protection_domains(_delete_list);
     }
   }
 };
 
+class HandshakeForPD : public HandshakeClosure {
+ public:
+  HandshakeForPD() : HandshakeClosure("HandshakeForPD") {}
+
+  void do_thread(Thread* thread) {
+    log_trace(protectiondomain)("HandshakeForPD::do_thread: thread=" INTPTR_FORMAT, p2i(thread));
+  }
+};
+
 void ProtectionDomainCacheTable::unlink() {
+  GrowableArray<ProtectionDomainEntry*> delete_list(20, mtClass);
   {
     // First clean cached pd lists in loaded CLDs
     // It's unlikely, but some loaded classes in a dictionary might
@@ -74,10 +90,23 @@ void ProtectionDomainCacheTable::unlink() {
     // The dictionary pd_set points at entries in the ProtectionDomainCacheTable.
     MutexLocker ml(ClassLoaderDataGraph_lock);
     MutexLocker mldict(SystemDictionary_lock);  // need both.
-    CleanProtectionDomainEntries clean;
+    CleanProtectionDomainEntries clean(&delete_list);
     ClassLoaderDataGraph::loaded_cld_do(&clean);
   }
 
+  // The pd_set lists are read without locking by JavaThreads that don't
+  // stop for safepoints or handshakes while traversing them. After a
+  // handshake with all of them, no thread can still see the unlinked
+  // entries, or the cache entries below that they point to. This is rare:
+  // a protection domain stays alive as long as its classes are loaded.
+  if (delete_list.length() > 0) {
+    HandshakeForPD hs_pd;
+    Handshake::execute(&hs_pd);
+    for (int i = 0; i < delete_list.length(); i++) {
+      delete delete_list.at(i);
+    }
+  }
+
   MutexLocker ml(SystemDictionary_lock);
   int oops_removed = 0;
   for (int i = 0; i < table_size(); ++i) {
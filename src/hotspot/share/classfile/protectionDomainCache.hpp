@@ -28,6 +28,7 @@
 #include "oops/oop.hpp"
 #include "oops/weakHandle.hpp"
 #include "memory/iterator.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/hashtable.hpp"
 
 // This class caches the approved protection domains that can access loaded classes.
@@ -107,7 +108,7 @@ public:
 class ProtectionDomainEntry :public CHeapObj<mtClass> {
   friend class VMStructs;
  public:
-  ProtectionDomainEntry* _next;
+  ProtectionDomainEntry* volatile _next;
   ProtectionDomainCacheEntry* _pd_cache;
 
   ProtectionDomainEntry(ProtectionDomainCacheEntry* pd_cache, ProtectionDomainEntry* next) {
@@ -115,8 +116,8 @@ class ProtectionDomainEntry :public CHeapObj<mtClass> {
     _next     = next;
   }
 
-  ProtectionDomainEntry* next() { return _next; }
-  void set_next(ProtectionDomainEntry* entry) { _next = entry; }
+  ProtectionDomainEntry* next_acquire() { return Atomic::load_acquire(&_next); }
+  void release_set_next(ProtectionDomainEntry* entry) { Atomic::release_store(&_next, entry); }
   oop object();
   oop object_no_keepalive();
 };
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/altHashing.hpp"
 #include "classfile/compactHashtable.hpp"
+#include "classfile/concurrentTableWorkBudget.hpp"
 #include "classfile/javaClasses.inline.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -379,23 +380,24 @@ oop StringTable::do_intern(Handle string_or_null_h, const jchar* name,
 // Concurrent work
 void StringTable::grow(JavaThread* jt) {
   StringTableHash::GrowTask gt(_local_table);
+  gt.set_task_size_log2(ConcurrentTableWorkChunkLog2);
   if (!gt.prepare(jt)) {
     return;
   }
   log_trace(stringtable)("Started to grow");
+  ConcurrentTableWorkBudget budget(jt, "StringTable", "Grow");
   {
     TraceTime timer("Grow", TRACETIME_LOG(Debug, stringtable, perf));
     while (gt.do_task(jt)) {
       gt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
-      }
+      budget.yield();
       gt.cont(jt);
     }
   }
   gt.done(jt);
   _current_size = table_size();
-  log_debug(stringtable)("Grown to size:" SIZE_FORMAT, _current_size);
+  budget.commit(_current_size, get_load_factor(), 0);
+  log_debug(stringtable)("Grown to size:" SIZE_FORMAT " yields: %u", _current_size, budget.yields());
 }
 
 struct StringTableDoDelete : StackObj {
@@ -422,24 +424,25 @@ struct StringTableDeleteCheck : StackObj {
 
 void StringTable::clean_dead_entries(JavaThread* jt) {
   StringTableHash::BulkDeleteTask bdt(_local_table);
+  bdt.set_task_size_log2(ConcurrentTableWorkChunkLog2);
   if (!bdt.prepare(jt)) {
     return;
   }
 
   StringTableDeleteCheck stdc;
   StringTableDoDelete stdd;
+  ConcurrentTableWorkBudget budget(jt, "StringTable", "Clean");
   {
     TraceTime timer("Clean", TRACETIME_LOG(Debug, stringtable, perf));
     while(bdt.do_task(jt, stdc, stdd)) {
       bdt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
-      }
+      budget.yield();
       bdt.cont(jt);
     }
     bdt.done(jt);
   }
-  log_debug(stringtable)("Cleaned %ld of %ld", stdc._count, stdc._item);
+  budget.commit(table_size(), get_load_factor(), stdc._count);
+  log_debug(stringtable)("Cleaned %ld of %ld yields: %u", stdc._count, stdc._item, budget.yields());
 }
 
 void StringTable::gc_notification(size_t num_dead) {
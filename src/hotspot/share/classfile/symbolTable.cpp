@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/altHashing.hpp"
 #include "classfile/compactHashtable.hpp"
+#include "classfile/concurrentTableWorkBudget.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/symbolTable.hpp"
 #include "memory/allocation.inline.hpp"
@@ -50,6 +51,8 @@ const double PREF_AVG_LIST_LEN = 8.0;
 const size_t END_SIZE = 24;
 // If a chain gets to 100 something might be wrong
 const size_t REHASH_LEN = 100;
+// If we have as many dead items as 50% of the number of bucket
+const double CLEAN_DEAD_HIGH_WATER_MARK = 0.5;
 
 const size_t ON_STACK_BUFFER_LENGTH = 128;
 
@@ -88,6 +91,10 @@ static size_t _current_size = 0;
 
 static volatile size_t _items_count = 0;
 static volatile bool   _has_items_to_clean = false;
+// Symbols whose refcount dropped to zero since the last full cleaning.
+// It may overcount, since dead symbols are also removed by inserts
+// into the same bucket.
+static volatile size_t _uncleaned_items_count = 0;
 
 
 static volatile bool _alt_hash = false;
@@ -202,10 +209,18 @@ void SymbolTable::item_removed() {
   Atomic::dec(&_items_count);
 }
 
+void SymbolTable::item_died() {
+  Atomic::inc(&_uncleaned_items_count);
+}
+
 double SymbolTable::get_load_factor() {
   return (double)_items_count/_current_size;
 }
 
+double SymbolTable::get_dead_factor() {
+  return (double)Atomic::load(&_uncleaned_items_count)/_current_size;
+}
+
 size_t SymbolTable::table_size() {
   return ((size_t)1) << _local_table->get_size_log2(Thread::current());
 }
@@ -216,6 +231,19 @@ void SymbolTable::trigger_cleanup() {
   Service_lock->notify_all();
 }
 
+void SymbolTable::unloading_notification() {
+  if (_has_work) {
+    return;
+  }
+  // Cleaning walks the whole table, so don't do it after every unloading
+  // of a few classes; wait until enough of their symbols have died.
+  double dead_factor = get_dead_factor();
+  if (dead_factor > CLEAN_DEAD_HIGH_WATER_MARK) {
+    log_debug(symboltable)("Concurrent work triggered after unloading, dead factor: %g", dead_factor);
+    trigger_cleanup();
+  }
+}
+
 Symbol* SymbolTable::allocate_symbol(const char* name, int len, bool c_heap) {
   assert (len <= Symbol::max_length(), "should be checked by caller");
 
@@ -644,23 +672,26 @@ void SymbolTable::serialize_shared_table_header(SerializeClosure* soc,
 // Concurrent work
 void SymbolTable::grow(JavaThread* jt) {
   SymbolTableHash::GrowTask gt(_local_table);
+  gt.set_task_size_log2(ConcurrentTableWorkChunkLog2);
   if (!gt.prepare(jt)) {
     return;
   }
   log_trace(symboltable)("Started to grow");
+  // Growing also removes all dead items.
+  Atomic::store(&_uncleaned_items_count, (size_t)0);
+  ConcurrentTableWorkBudget budget(jt, "SymbolTable", "Grow");
   {
     TraceTime timer("Grow", TRACETIME_LOG(Debug, symboltable, perf));
     while (gt.do_task(jt)) {
       gt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
-      }
+      budget.yield();
       gt.cont(jt);
     }
   }
   gt.done(jt);
   _current_size = table_size();
-  log_debug(symboltable)("Grown to size:" SIZE_FORMAT, _current_size);
+  budget.commit(_current_size, get_load_factor(), 0);
+  log_debug(symboltable)("Grown to size:" SIZE_FORMAT " yields: %u", _current_size, budget.yields());
 }
 
 struct SymbolTableDoDelete : StackObj {
@@ -689,19 +720,23 @@ struct SymbolTableDeleteCheck : StackObj {
 
 void SymbolTable::clean_dead_entries(JavaThread* jt) {
   SymbolTableHash::BulkDeleteTask bdt(_local_table);
+  bdt.set_task_size_log2(ConcurrentTableWorkChunkLog2);
   if (!bdt.prepare(jt)) {
     return;
   }
 
+  // Symbols dying from here on may be missed by this walk and are counted
+  // for the next one.
+  Atomic::store(&_uncleaned_items_count, (size_t)0);
+
   SymbolTableDeleteCheck stdc;
   SymbolTableDoDelete stdd;
+  ConcurrentTableWorkBudget budget(jt, "SymbolTable", "Clean");
   {
     TraceTime timer("Clean", TRACETIME_LOG(Debug, symboltable, perf));
     while (bdt.do_task(jt, stdc, stdd)) {
       bdt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
-      }
+      budget.yield();
       bdt.cont(jt);
     }
     reset_has_items_to_clean();
@@ -709,9 +744,10 @@ void SymbolTable::clean_dead_entries(JavaThread* jt) {
   }
 
   Atomic::add(&_symbols_counted, stdc._processed);
+  budget.commit(table_size(), get_load_factor(), stdd._deleted);
 
-  log_debug(symboltable)("Cleaned " SIZE_FORMAT " of " SIZE_FORMAT,
-                         stdd._deleted, stdc._processed);
+  log_debug(symboltable)("Cleaned " SIZE_FORMAT " of " SIZE_FORMAT " yields: %u",
+                         stdd._deleted, stdc._processed, budget.yields());
 }
 
 void SymbolTable::check_concurrent_work() {
@@ -113,11 +113,13 @@ class SymbolTable : public AllStatic {
   static void clean_dead_entries(JavaThread* jt);
 
   static double get_load_factor();
+  static double get_dead_factor();
 
   static void check_concurrent_work();
 
   static void item_added();
   static void item_removed();
+  static void item_died();
 
   // For cleaning
   static void reset_has_items_to_clean();
@@ -167,6 +169,9 @@ public:
   static void do_concurrent_work(JavaThread* jt);
   static bool has_work() { return _has_work; }
   static void trigger_cleanup();
+  // Called after class unloading; triggers cleanup only if enough
+  // symbols have died since the last one.
+  static void unloading_notification();
 
   // Probing
   // Needed for preloading classes in signatures when compiling.
@@ -1934,7 +1934,7 @@ bool SystemDictionary::do_unloading(GCTimer* gc_timer) {
   GCTraceTime(Debug, gc, phases) t("Trigger cleanups", gc_timer);
 
   if (unloading_occurred) {
-    SymbolTable::trigger_cleanup();
+    SymbolTable::unloading_notification();
 
     // Oops referenced by the protection domain cache table may get unreachable independently
     // of the class loader (eg. cached protection domain oops). So we need to
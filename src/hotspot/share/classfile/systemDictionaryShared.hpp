@@ -281,6 +281,7 @@ public:
   static void check_verification_constraints(InstanceKlass* klass,
                                              TRAPS) NOT_CDS_RETURN;
   static void set_class_has_failed_verification(InstanceKlass* ik) NOT_CDS_RETURN;
+  static void set_excluded(InstanceKlass* k) NOT_CDS_RETURN;
   static bool has_class_failed_verification(InstanceKlass* ik) NOT_CDS_RETURN_(false);
   static void add_lambda_proxy_class(InstanceKlass* caller_ik,
                                      InstanceKlass* lambda_ik,
@@ -670,6 +670,9 @@
   template(toFileURL_name,                         "toFileURL")                                                   \
   template(toFileURL_signature,                    "(Ljava/lang/String;)Ljava/net/URL;")                          \
   template(url_void_signature,                     "(Ljava/net/URL;)V")                                           \
+  template(java_lang_invoke_GenerateJLIClassesHelper, "java/lang/invoke/GenerateJLIClassesHelper")                \
+  template(cdsGenerateHolderClasses,               "cdsGenerateHolderClasses")                                    \
+  template(cdsGenerateHolderClasses_signature,     "([Ljava/lang/String;)[Ljava/lang/Object;")                    \
                                                                                                                   \
   /*end*/
 
@@ -1024,6 +1027,9 @@
   do_intrinsic(_vectorizedMismatch, jdk_internal_util_ArraysSupport, vectorizedMismatch_name, vectorizedMismatch_signature, F_S)\
    do_name(vectorizedMismatch_name, "vectorizedMismatch")                                                               \
    do_signature(vectorizedMismatch_signature, "(Ljava/lang/Object;JLjava/lang/Object;JII)I")                            \
+  do_intrinsic(_vectorizedHashCode, jdk_internal_util_ArraysSupport, vectorizedHashCode_name, vectorizedHashCode_signature, F_S)\
+   do_name(vectorizedHashCode_name, "vectorizedHashCode")                                                               \
+   do_signature(vectorizedHashCode_signature, "(Ljava/lang/Object;IIII)I")                                              \
                                                                                                                         \
   /* java/lang/ref/Reference */                                                                                         \
   do_intrinsic(_Reference_get,            java_lang_ref_Reference, get_name,    void_object_signature, F_R)             \
@@ -1083,6 +1089,18 @@
   do_name(encodeBlock_name, "encodeBlock")                                                                              \
   do_signature(encodeBlock_signature, "([BII[BIZ)V")                                                                    \
                                                                                                                         \
+   /* support for java.util.Base64.Decoder*/                                                                            \
+  do_class(java_util_Base64_Decoder, "java/util/Base64$Decoder")                                                        \
+  do_intrinsic(_base64_decodeBlock, java_util_Base64_Decoder, decodeBlock_name, decodeBlock_signature, F_R)             \
+  do_name(decodeBlock_name, "decodeBlock")                                                                              \
+  do_signature(decodeBlock_signature, "([BII[BIZZ)I")                                                                   \
+                                                                                                                        \
+  /* support for com.sun.crypto.provider.ChaCha20Cipher */                                                              \
+  do_class(com_sun_crypto_provider_chacha20cipher, "com/sun/crypto/provider/ChaCha20Cipher")                            \
+  do_intrinsic(_chacha20Block, com_sun_crypto_provider_chacha20cipher, chacha20Block_name, chacha20Block_signature, F_S) \
+   do_name(chacha20Block_name, "implChaCha20Block")                                                                     \
+   do_signature(chacha20Block_signature, "([I[B)I")                                                                     \
+                                                                                                                        \
   /* support for com.sun.crypto.provider.GHASH */                                                                       \
   do_class(com_sun_crypto_provider_ghash, "com/sun/crypto/provider/GHASH")                                              \
   do_intrinsic(_ghash_processBlocks, com_sun_crypto_provider_ghash, processBlocks_name, ghash_processBlocks_signature, F_S) \
@@ -27,6 +27,7 @@
 #include "code/codeBlob.hpp"
 #include "code/codeCache.hpp"
 #include "code/icBuffer.hpp"
+#include "code/perfMap.hpp"
 #include "code/relocInfo.hpp"
 #include "code/vtableStubs.hpp"
 #include "compiler/disassembler.hpp"
@@ -192,6 +193,7 @@ void RuntimeBlob::trace_new_stub(RuntimeBlob* stub, const char* name1, const cha
       tty->cr();
     }
     Forte::register_stub(stub_id, stub->code_begin(), stub->code_end());
+    LINUX_ONLY(PerfMap::register_stub(NULL, stub_id, stub->code_begin(), stub->code_end());)
 
     if (JvmtiExport::should_post_dynamic_code_generated()) {
       const char* stub_name = name2;
@@ -209,6 +209,11 @@ public:
   // OopMap for frame
   ImmutableOopMapSet* oop_maps() const           { return _oop_maps; }
   void set_oop_maps(OopMapSet* p);
+  // Install an ImmutableOopMapSet built ahead of time; ownership passes to the blob.
+  void install_oop_maps(ImmutableOopMapSet* p) {
+    assert(_oop_maps == NULL, "oop maps already set");
+    _oop_maps = p;
+  }
   const ImmutableOopMap* oop_map_for_return_address(address return_address);
   virtual void preserve_callee_argument_oops(frame fr, const RegisterMap* reg_map, OopClosure* f) = 0;
 
@@ -33,6 +33,7 @@
 #include "code/icBuffer.hpp"
 #include "code/nmethod.hpp"
 #include "code/pcDesc.hpp"
+#include "code/perfMap.hpp"
 #include "compiler/compilationPolicy.hpp"
 #include "compiler/compileBroker.hpp"
 #include "jfr/jfrEvents.hpp"
@@ -792,6 +793,7 @@ CodeCache::UnloadingScope::UnloadingScope(BoolObjectClosure* is_alive)
 CodeCache::UnloadingScope::~UnloadingScope() {
   IsUnloadingBehaviour::set_current(_saved_behaviour);
   DependencyContext::cleaning_end();
+  NMethodSweeper::report_unloading_cycle();
 }
 
 void CodeCache::verify_oops() {
@@ -961,6 +963,8 @@ void CodeCache::initialize() {
 }
 
 void codeCache_init() {
+  // Before the first stubs are generated by CodeCache::initialize().
+  LINUX_ONLY(PerfMap::initialize();)
   CodeCache::initialize();
   // Load AOT libraries and add AOT code heaps.
   AOTLoader::initialize();
@@ -1194,12 +1198,21 @@ void CodeCache::flush_dependents_on(InstanceKlass* dependee) {
 
   if (number_of_nmethods_with_dependencies() == 0) return;
 
+  EventDependencyInvalidation event;
   KlassDepChange changes(dependee);
 
   // Compute the dependent nmethods
-  if (mark_for_deoptimization(changes) > 0) {
-    // At least one nmethod has been marked for deoptimization
+  int marked = mark_for_deoptimization(changes);
+  if (marked > 0) {
+    // At least one nmethod has been marked for deoptimization.
+    // All of them are made not entrant and their activations are
+    // deoptimized by a single handshake.
     Deoptimization::deoptimize_all_marked();
+    if (event.should_commit()) {
+      event.set_dependee(dependee);
+      event.set_invalidatedNMethods(marked);
+      event.commit();
+    }
   }
 }
 
@@ -1560,9 +1573,9 @@ void CodeCache::log_state(outputStream* st) {
 
 //---<  BEGIN  >--- CodeHeap State Analytics.
 
-void CodeCache::aggregate(outputStream *out, size_t granularity) {
+void CodeCache::aggregate(outputStream *out, size_t granularity, bool yield_lock) {
   FOR_ALL_ALLOCABLE_HEAPS(heap) {
-    CodeHeapState::aggregate(out, (*heap), granularity);
+    CodeHeapState::aggregate(out, (*heap), granularity, yield_lock);
   }
 }
 
@@ -1607,4 +1620,10 @@ void CodeCache::print_names(outputStream *out) {
     CodeHeapState::print_names(out, (*heap));
   }
 }
+
+void CodeCache::print_compact(outputStream *out) {
+  FOR_ALL_ALLOCABLE_HEAPS(heap) {
+    CodeHeapState::print_compact(out, (*heap));
+  }
+}
 //---<  END  >--- CodeHeap State Analytics.
@@ -294,7 +294,7 @@ class CodeCache : AllStatic {
 
   // CodeHeap State Analytics.
   // interface methods for CodeHeap printing, called by CompileBroker
-  static void aggregate(outputStream *out, size_t granularity);
+  static void aggregate(outputStream *out, size_t granularity, bool yield_lock);
   static void discard(outputStream *out);
   static void print_usedSpace(outputStream *out);
   static void print_freeSpace(outputStream *out);
@@ -302,6 +302,7 @@ class CodeCache : AllStatic {
   static void print_space(outputStream *out);
   static void print_age(outputStream *out);
   static void print_names(outputStream *out);
+  static void print_compact(outputStream *out);
 };
 
 
@@ -409,7 +410,13 @@ struct NMethodFilter {
   static const GrowableArray<CodeHeap*>* heaps() { return CodeCache::nmethod_heaps(); }
 };
 
+struct AllCodeBlobsFilter {
+  static bool apply(CodeBlob* cb) { return true; }
+  static const GrowableArray<CodeHeap*>* heaps() { return CodeCache::heaps(); }
+};
+
 typedef CodeBlobIterator<CompiledMethod, CompiledMethodFilter> CompiledMethodIterator;
 typedef CodeBlobIterator<nmethod, NMethodFilter> NMethodIterator;
+typedef CodeBlobIterator<CodeBlob, AllCodeBlobsFilter> AllCodeBlobsIterator;
 
 #endif // SHARE_CODE_CODECACHE_HPP
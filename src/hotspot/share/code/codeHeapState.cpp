@@ -26,6 +26,8 @@
 #include "precompiled.hpp"
 #include "code/codeHeapState.hpp"
 #include "compiler/compileBroker.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/sweeper.hpp"
 #include "utilities/powerOfTwo.hpp"
 
@@ -47,7 +49,11 @@
 //
 // The CodeHeap is a living thing. Therefore, protection against concurrent
 // modification (by acquiring the CodeCache_lock) is necessary. It has
-// to be provided by the caller of the analysis functions.
+// to be provided by the caller of the analysis functions. If the caller
+// allows it (yield_lock), the aggregate step releases it briefly every now
+// and then while walking the CodeHeap, so that compilations and nmethod
+// installation are not stalled for the whole walk. Callers which hold the
+// lock across aggregation and printing to get a consistent picture don't.
 // If the CodeCache_lock is not held, the analysis functions may print
 // less detailed information or may just do nothing. It is by intention
 // that an unprotected invocation is not abnormally terminated.
@@ -531,7 +537,7 @@ void CodeHeapState::discard(outputStream* out, CodeHeap* heap) {
   }
 }
 
-void CodeHeapState::aggregate(outputStream* out, CodeHeap* heap, size_t granularity) {
+void CodeHeapState::aggregate(outputStream* out, CodeHeap* heap, size_t granularity, bool yield_lock) {
   unsigned int nBlocks_free    = 0;
   unsigned int nBlocks_used    = 0;
   unsigned int nBlocks_zomb    = 0;
@@ -549,6 +555,7 @@ void CodeHeapState::aggregate(outputStream* out, CodeHeap* heap, size_t granular
 
   bool  done             = false;
   const int min_granules = 256;
+  const unsigned int blocks_per_lock_hold = 1000; // let compilations and nmethod installations in between
   const int max_granules = 512*K; // limits analyzable CodeHeap (with segment_granules) to 32M..128M
                                   // results in StatArray size of 24M (= max_granules * 48 Bytes per element)
                                   // For a 1GB CodeHeap, the granule size must be at least 2kB to not violate the max_granles limit.
@@ -577,6 +584,8 @@ void CodeHeapState::aggregate(outputStream* out, CodeHeap* heap, size_t granular
   // Since we are (and must be) analyzing the CodeHeap contents under the CodeCache_lock,
   // all heap information is "constant" and can be safely extracted/calculated before we
   // enter the while() loop. Actually, the loop will only be iterated once.
+  // With yield_lock, the lock is released briefly every blocks_per_lock_hold blocks
+  // during the walk (see below). Should the heap be expanded meanwhile, the walk ends early.
   char*  low_bound     = heap->low_boundary();
   size_t size          = heap->capacity();
   size_t res_size      = heap->max_capacity();
@@ -705,7 +714,31 @@ void CodeHeapState::aggregate(outputStream* out, CodeHeap* heap, size_t granular
     minTemp       = (int)(res_size > M ? (res_size/M)*2 : 1);
     maxTemp       = -minTemp;
 
+    unsigned int blocks_in_lock_hold = 0;
     for (HeapBlock *h = heap->first_block(); h != NULL && !insane; h = heap->next_block(h)) {
+      //---<  Walking a large CodeHeap takes long. Don't block compilations all the time.  >---
+      // After reacquiring the CodeCache_lock, resume with the first block at or after
+      // the position we stopped at. Blocks which were merged with an already visited
+      // block are skipped, blocks allocated in the visited part are missed.
+      if (yield_lock && (++blocks_in_lock_hold > blocks_per_lock_hold)) {
+        blocks_in_lock_hold = 0;
+        char* resume_point = (char*)h;
+        {
+          MutexUnlocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+          os::naked_yield();
+        }
+        if (size != heap->capacity()) {
+          ast->print_cr("CodeHeap capacity has changed (" SIZE_FORMAT "K to " SIZE_FORMAT "K) during analysis. Analysis data is incomplete.",
+                        size/(size_t)K, heap->capacity()/(size_t)K);
+          BUFFEREDSTREAM_FLUSH("")
+          break;
+        }
+        h = heap->first_block_at_or_after(resume_point);
+        if (h == NULL) {
+          break;
+        }
+      }
+
       unsigned int hb_len     = (unsigned int)h->length();  // despite being size_t, length can never overflow an unsigned int.
       size_t       hb_bytelen = ((size_t)hb_len)<<log2_seg_size;
       unsigned int ix_beg     = (unsigned int)(((char*)h-low_bound)/granule_size);
@@ -2179,6 +2212,54 @@ void CodeHeapState::print_age(outputStream* out, CodeHeap* heap) {
 }
 
 
+// Prints one line of key=value pairs per CodeHeap, summarizing the data
+// of the latest aggregate step. Intended for periodic monitoring.
+void CodeHeapState::print_compact(outputStream* out, CodeHeap* heap) {
+  if (!initialization_complete) {
+    return;
+  }
+
+  const char* heapName = get_heapName(heap);
+  get_HeapStatGlobals(out, heapName);
+
+  if ((StatArray == NULL) || (alloc_granules == 0)) {
+    out->print_cr("heap=\"%s\" aggregated=false", heapName);
+    return;
+  }
+
+  size_t t1_space = 0;
+  size_t t2_space = 0;
+  size_t tx_space = 0;
+  size_t dead_space = 0;
+  size_t stub_space = 0;
+  for (unsigned int ix = 0; ix < alloc_granules; ix++) {
+    t1_space   += StatArray[ix].t1_space;
+    t2_space   += StatArray[ix].t2_space;
+    tx_space   += StatArray[ix].tx_space;
+    dead_space += StatArray[ix].dead_space;
+    stub_space += StatArray[ix].stub_space;
+  }
+  size_t free_space = 0;
+  size_t max_free   = 0;
+  if (FreeArray != NULL) {
+    for (unsigned int ix = 0; ix < alloc_freeBlocks; ix++) {
+      free_space += FreeArray[ix].len;
+      max_free    = MAX2(max_free, (size_t)FreeArray[ix].len);
+    }
+  }
+
+  out->print_cr("heap=\"%s\" aggregated=true capacity=" SIZE_FORMAT " max_capacity=" SIZE_FORMAT
+                " t1_count=%u t1_bytes=" SIZE_FORMAT " t2_count=%u t2_bytes=" SIZE_FORMAT
+                " alive_count=%u alive_bytes=" SIZE_FORMAT " dead_count=%u dead_bytes=" SIZE_FORMAT
+                " stub_count=%u stub_bytes=" SIZE_FORMAT " free_count=%u free_bytes=" SIZE_FORMAT
+                " max_free_bytes=" SIZE_FORMAT " min_temp=%d avg_temp=%d max_temp=%d",
+                heapName, heap->capacity(), heap->max_capacity(),
+                nBlocks_t1, t1_space << log2_seg_size, nBlocks_t2, t2_space << log2_seg_size,
+                nBlocks_alive, tx_space << log2_seg_size, nBlocks_dead, dead_space << log2_seg_size,
+                nBlocks_stub, stub_space << log2_seg_size, alloc_freeBlocks, free_space,
+                max_free, minTemp, avgTemp, maxTemp);
+}
+
 void CodeHeapState::print_names(outputStream* out, CodeHeap* heap) {
   if (!initialization_complete) {
     return;
@@ -99,13 +99,14 @@ class CodeHeapState : public CHeapObj<mtCode> {
 
  public:
   static void discard(outputStream* out, CodeHeap* heap);
-  static void aggregate(outputStream* out, CodeHeap* heap, size_t granularity);
+  static void aggregate(outputStream* out, CodeHeap* heap, size_t granularity, bool yield_lock);
   static void print_usedSpace(outputStream* out, CodeHeap* heap);
   static void print_freeSpace(outputStream* out, CodeHeap* heap);
   static void print_count(outputStream* out, CodeHeap* heap);
   static void print_space(outputStream* out, CodeHeap* heap);
   static void print_age(outputStream* out, CodeHeap* heap);
   static void print_names(outputStream* out, CodeHeap* heap);
+  static void print_compact(outputStream* out, CodeHeap* heap);
 };
 
 //----------------
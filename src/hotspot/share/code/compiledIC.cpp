@@ -246,7 +246,7 @@ bool CompiledIC::set_to_megamorphic(CallInfo* call_info, Bytecodes::Code bytecod
                                     bool& needs_ic_stub_refill, TRAPS) {
   assert(CompiledICLocker::is_safe(_method), "mt unsafe call");
   assert(!is_optimized(), "cannot set an optimized virtual call to megamorphic");
-  assert(is_call_to_compiled() || is_call_to_interpreted(), "going directly to megamorphic?");
+  assert(is_call_to_compiled() || is_call_to_interpreted() || is_polymorphic(), "going directly to megamorphic?");
 
   address entry;
   if (call_info->call_kind() == CallInfo::itable_call) {
@@ -312,6 +312,85 @@ bool CompiledIC::is_megamorphic() const {
   return VtableStubs::entry_point(ic_destination()) != NULL;
 }
 
+// true if destination is the polymorphic inline cache stub
+bool CompiledIC::is_polymorphic() const {
+  assert(CompiledICLocker::is_safe(_method), "mt unsafe call");
+  address stub = StubRoutines::polymorphic_ic_stub();
+  return !is_optimized() && stub != NULL && ic_destination() == stub;
+}
+
+bool CompiledIC::set_to_polymorphic(CallInfo* call_info, Bytecodes::Code bytecode, Klass* receiver_klass,
+                                    bool& needs_ic_stub_refill) {
+  assert(CompiledICLocker::is_safe(_method), "mt unsafe call");
+  assert(!is_optimized(), "cannot set an optimized virtual call to polymorphic");
+  assert(PolymorphicInlineCacheSize <= CompiledICHolder::max_pic_length, "checked by flag range");
+
+  address entry = StubRoutines::polymorphic_ic_stub();
+  if (entry == NULL || PolymorphicInlineCacheSize < 2 ||
+      bytecode != Bytecodes::_invokeinterface ||
+      call_info->call_kind() != CallInfo::itable_call) {
+    return false;
+  }
+
+  // Collect the receiver klasses this call site has dispatched to so far.
+  CompiledICHolder::PICEntry entries[CompiledICHolder::max_pic_length];
+  int length = 0;
+  if (is_polymorphic()) {
+    CompiledICHolder* old_holder = cached_icholder();
+    assert(old_holder->is_polymorphic(), "must be");
+    for (; length < old_holder->pic_length(); length++) {
+      entries[length] = old_holder->pic_entry_at(length);
+    }
+  } else if (is_call_to_interpreted()) {
+    CompiledICHolder* old_holder = cached_icholder();
+    entries[length]._klass = old_holder->holder_klass();
+    entries[length]._method = (Method*)old_holder->holder_metadata();
+    length++;
+  } else if (is_call_to_compiled()) {
+    Metadata* klass = cached_metadata();
+    CodeBlob* cb = CodeCache::find_blob_unsafe(ic_destination());
+    if (klass == NULL || !klass->is_klass()) {
+      return false;
+    }
+    entries[length]._klass = (Klass*)klass;
+    entries[length]._method = cb->as_compiled_method()->method();
+    length++;
+  } else {
+    return false;
+  }
+
+  for (int i = 0; i < length; i++) {
+    if (entries[i]._klass == receiver_klass) {
+      // Benign race with another thread that already added this receiver klass,
+      // or a stale monomorphic target. Either way there is nothing to extend.
+      return is_polymorphic();
+    }
+  }
+  if (length >= PolymorphicInlineCacheSize) {
+    return false;
+  }
+  entries[length]._klass = receiver_klass;
+  entries[length]._method = call_info->selected_method();
+  length++;
+
+  CompiledICHolder* holder = new CompiledICHolder(call_info->resolved_method()->method_holder(),
+                                                  call_info->resolved_klass(), entries, length);
+  holder->claim();
+  if (!InlineCacheBuffer::create_transition_stub(this, holder, entry)) {
+    delete holder;
+    needs_ic_stub_refill = true;
+    return false;
+  }
+
+  if (TraceICs) {
+    ResourceMark rm;
+    tty->print_cr ("IC@" INTPTR_FORMAT ": to polymorphic (%d) %s entry: " INTPTR_FORMAT,
+                   p2i(instruction_address()), length,
+                   call_info->selected_method()->print_value_string(), p2i(entry));
+  }
+  return true;
+}
+
 bool CompiledIC::is_call_to_compiled() const {
   assert(CompiledICLocker::is_safe(_method), "mt unsafe call");
 
@@ -565,6 +644,10 @@ void CompiledIC::compute_monomorphic_entry(const methodHandle& method,
 
 
 bool CompiledIC::is_icholder_entry(address entry) {
+  // the polymorphic inline cache stub uses a CompiledICHolder with entries
+  if (entry != NULL && entry == StubRoutines::polymorphic_ic_stub()) {
+    return true;
+  }
   CodeBlob* cb = CodeCache::find_blob_unsafe(entry);
   if (cb != NULL && cb->is_adapter_blob()) {
     return true;
@@ -714,7 +797,7 @@ address CompiledDirectStaticCall::resolve_call_stub() const {
 void CompiledIC::verify() {
   _call->verify();
   assert(is_clean() || is_call_to_compiled() || is_call_to_interpreted()
-          || is_optimized() || is_megamorphic(), "sanity check");
+          || is_optimized() || is_megamorphic() || is_polymorphic(), "sanity check");
 }
 
 void CompiledIC::print() {
@@ -47,6 +47,11 @@
 //       [4] \                      / [4] \->-/
 //            \->-  Megamorphic -<-/
 //              (CompiledICHolder*)
+//                       ^
+//                   [4] |  /-<-\
+//                       | /     \ [5]
+//                   Polymorphic  |
+//               (CompiledICHolder*)
 //
 // The text in parentheses () refers to the value of the inline cache receiver (mov instruction)
 //
@@ -54,7 +59,10 @@
 // [1]: Initial fixup. Receiver it found from debug information
 // [2]: Compilation of a method
 // [3]: Recompilation of a method (note: only entry is changed. The Klass* must stay the same)
-// [4]: Inline cache miss. We go directly to megamorphic call.
+// [4]: Inline cache miss. We go directly to megamorphic call, except at interface
+//      call sites which first go polymorphic (from Interpreted or Monomorphic).
+// [5]: Inline cache miss at a polymorphic call site. The receiver klass is added
+//      until PolymorphicInlineCacheSize klasses are cached, then we go megamorphic.
 //
 // The class automatically inserts transition stubs (using the InlineCacheBuffer) when an MT-unsafe
 // transition is made to a stub.
@@ -255,6 +263,7 @@ class CompiledIC: public ResourceObj {
   // State
   bool is_clean() const;
   bool is_megamorphic() const;
+  bool is_polymorphic() const;
   bool is_call_to_compiled() const;
   bool is_call_to_interpreted() const;
 
@@ -278,6 +287,12 @@ class CompiledIC: public ResourceObj {
   // allocation in the code cache fails, or ic stub refill is required.
   bool set_to_megamorphic(CallInfo* call_info, Bytecodes::Code bytecode, bool& needs_ic_stub_refill, TRAPS);
 
+  // Returns true if the receiver klass is now dispatched by the polymorphic
+  // inline cache of this call site. Returns false if the call site should go
+  // megamorphic instead, or if ic stub refill is required.
+  bool set_to_polymorphic(CallInfo* call_info, Bytecodes::Code bytecode, Klass* receiver_klass,
+                          bool& needs_ic_stub_refill);
+
   static void compute_monomorphic_entry(const methodHandle& method, Klass* receiver_klass,
                                         bool is_optimized, bool static_bound, bool caller_is_nmethod,
                                         CompiledICInfo& info, TRAPS);
@@ -31,6 +31,7 @@
 #include "code/dependencies.hpp"
 #include "code/nativeInst.hpp"
 #include "code/nmethod.hpp"
+#include "code/perfMap.hpp"
 #include "code/scopeDesc.hpp"
 #include "compiler/abstractCompiler.hpp"
 #include "compiler/compileBroker.hpp"
@@ -430,6 +431,8 @@ void nmethod::init_defaults() {
   _has_flushed_dependencies   = 0;
   _lock_count                 = 0;
   _stack_traversal_mark       = 0;
+  _seen_active                = false;
+  _compile_time_ticks         = 0;
   _load_reported              = false; // jvmti state
   _unload_reported            = false;
   _is_far_code                = false; // nmethods are located in CodeCache
@@ -507,6 +510,10 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
 {
   assert(debug_info->oop_recorder() == code_buffer->oop_recorder(), "shared OR");
   code_buffer->finalize_oop_references(method);
+  // Building the immutable oop maps does not depend on where the nmethod
+  // ends up, so do it before taking CodeCache_lock to keep the time spent
+  // holding the lock short when several compiler threads install at once.
+  ImmutableOopMapSet* immutable_oop_maps = oop_maps != NULL ? ImmutableOopMapSet::build_from(oop_maps) : NULL;
   // create nmethod
   nmethod* nm = NULL;
   { MutexLocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
@@ -528,7 +535,7 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
     nm = new (nmethod_size, comp_level)
     nmethod(method(), compiler->type(), nmethod_size, compile_id, entry_bci, offsets,
             orig_pc_offset, debug_info, dependencies, code_buffer, frame_size,
-            oop_maps,
+            NULL /* oop maps are installed below */,
             handler_table,
             nul_chk_table,
             compiler,
@@ -541,6 +548,7 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
             );
 
     if (nm != NULL) {
+      nm->install_oop_maps(immutable_oop_maps);
 #if INCLUDE_JVMCI
       if (compiler->is_jvmci()) {
         // Initialize the JVMCINMethodData object inlined into nm
@@ -572,6 +580,9 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
       NOT_PRODUCT(if (nm != NULL)  note_java_nmethod(nm));
     }
   }
+  if (nm == NULL) {
+    FREE_C_HEAP_ARRAY(unsigned char, immutable_oop_maps);
+  }
   // Do verification and logging outside CodeCache_lock.
   if (nm != NULL) {
     // Safepoints in nmethod::verify aren't allowed because nm hasn't been installed yet.
@@ -1587,6 +1598,10 @@ void nmethod::post_compiled_method_load_event(JvmtiThreadState* state) {
       m->signature()->utf8_length(),
       insts_begin(), insts_size());
 
+  // A JVMTI GenerateEvents replay (state != NULL) is not a new nmethod.
+  if (state == NULL) {
+    LINUX_ONLY(PerfMap::register_nmethod(this);)
+  }
 
   if (JvmtiExport::should_post_compiled_method_load()) {
     // Only post unload events if load events are found.
@@ -1664,8 +1679,7 @@ void nmethod::metadata_do(MetadataClosure* f) {
         CompiledIC *ic = CompiledIC_at(&iter);
         if (ic->is_icholder_call()) {
           CompiledICHolder* cichk = ic->cached_icholder();
-          f->do_metadata(cichk->holder_metadata());
-          f->do_metadata(cichk->holder_klass());
+          cichk->metadata_do(f);
         } else {
           Metadata* ic_oop = ic->cached_metadata();
           if (ic_oop != NULL) {
@@ -264,6 +264,12 @@ class nmethod : public CompiledMethod {
   // counter is decreased (by 1) while sweeping.
   int _hotness_counter;
 
+  // Set once the nmethod has been seen active during stack scanning.
+  // Used together with _compile_time_ticks to account compilations whose
+  // code went cold without ever being observed running (see CITime).
+  bool  _seen_active;
+  jlong _compile_time_ticks;
+
   // Local state used to keep track of whether unloading is happening or not
   volatile uint8_t _is_unloading_state;
 
@@ -441,6 +447,11 @@ class nmethod : public CompiledMethod {
   void set_hotness_counter(int val) { _hotness_counter = val; }
   int  hotness_counter() const      { return _hotness_counter; }
 
+  void  mark_as_seen_active()                 { _seen_active = true; }
+  bool  seen_active() const                   { return _seen_active; }
+  void  set_compile_time_ticks(jlong ticks)   { _compile_time_ticks = ticks; }
+  jlong compile_time_ticks() const            { return _compile_time_ticks; }
+
   // Containment
   bool oops_contains         (oop*    addr) const { return oops_begin         () <= addr && addr < oops_end         (); }
   bool metadata_contains     (Metadata** addr) const   { return metadata_begin     () <= addr && addr < metadata_end     (); }
@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+
+#ifdef LINUX
+
+#include "jvm.h"
+#include "code/codeBlob.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "code/perfMap.hpp"
+#include "code/stubs.hpp"
+#include "compiler/compilerDefinitions.hpp"
+#include "interpreter/abstractInterpreter.hpp"
+#include "interpreter/interpreter.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/stubCodeGenerator.hpp"
+#include "runtime/task.hpp"
+#include "utilities/ostream.hpp"
+
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Record layouts of the jitdump format, version 1, as described in
+// tools/perf/Documentation/jitdump-specification.txt of the Linux sources.
+// All fields are in the byte order of the running process.
+
+static const uint32_t JITDUMP_MAGIC   = 0x4A695444;   // "JiTD"
+static const uint32_t JITDUMP_VERSION = 1;
+
+enum JitDumpRecordType {
+  JIT_CODE_LOAD  = 0,
+  JIT_CODE_CLOSE = 3
+};
+
+struct JitDumpFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t total_size;
+  uint32_t elf_mach;
+  uint32_t pad1;
+  uint32_t pid;
+  uint64_t timestamp;
+  uint64_t flags;
+};
+
+struct JitDumpRecordHeader {
+  uint32_t id;
+  uint32_t total_size;
+  uint64_t timestamp;
+};
+
+// Followed by the NUL terminated name and code_size bytes of code.
+struct JitDumpCodeLoad {
+  JitDumpRecordHeader header;
+  uint32_t pid;
+  uint32_t tid;
+  uint64_t vma;
+  uint64_t code_addr;
+  uint64_t code_size;
+  uint64_t code_index;
+};
+
+#if defined(AMD64)
+static const uint32_t JITDUMP_ELF_MACH = EM_X86_64;
+#elif defined(IA32)
+static const uint32_t JITDUMP_ELF_MACH = EM_386;
+#elif defined(AARCH64)
+static const uint32_t JITDUMP_ELF_MACH = EM_AARCH64;
+#elif defined(ARM)
+static const uint32_t JITDUMP_ELF_MACH = EM_ARM;
+#elif defined(PPC64)
+static const uint32_t JITDUMP_ELF_MACH = EM_PPC64;
+#elif defined(S390)
+static const uint32_t JITDUMP_ELF_MACH = EM_S390;
+#else
+static const uint32_t JITDUMP_ELF_MACH = EM_NONE;
+#endif
+
+// A growable byte buffer. Entries are appended to one buffer while the
+// flush task writes out the other one.
+class PerfMapBuffer : public CHeapObj<mtCode> {
+  char*  _data;
+  size_t _size;
+  size_t _capacity;
+
+ public:
+  PerfMapBuffer() : _data(NULL), _size(0), _capacity(0) {}
+
+  bool is_empty() const { return _size == 0; }
+
+  void append(const void* p, size_t n) {
+    if (_size + n > _capacity) {
+      size_t capacity = MAX2(MAX2(_capacity * 2, _size + n), (size_t)(64 * K));
+      _data = REALLOC_C_HEAP_ARRAY(char, _data, capacity, mtCode);
+      _capacity = capacity;
+    }
+    memcpy(_data + _size, p, n);
+    _size += n;
+  }
+
+  // Writes the contents to fd and empties the buffer. Errors are ignored;
+  // losing profiler symbols is not a reason to disturb the application.
+  void write_to(int fd) {
+    const char* p = _data;
+    size_t left = _size;
+    while (left > 0) {
+      unsigned int chunk = (unsigned int)MIN2(left, (size_t)(1 * G));
+      ssize_t n = (ssize_t)os::write(fd, p, chunk);
+      if (n <= 0) {
+        break;
+      }
+      p += n;
+      left -= n;
+    }
+    _size = 0;
+  }
+};
+
+bool PerfMap::_enabled = false;
+
+// Protects the pending buffers and the code index. Taken by threads that
+// register code, some of which already hold VtableStubs_lock.
+static Mutex* _buffer_lock = NULL;
+// Serializes writes to the files. Held while taking CodeCache_lock and
+// _buffer_lock, so it ranks above both.
+static Mutex* _file_lock = NULL;
+
+static PerfMapBuffer* _map_pending = NULL;
+static PerfMapBuffer* _map_writing = NULL;
+static PerfMapBuffer* _dump_pending = NULL;
+static PerfMapBuffer* _dump_writing = NULL;
+
+static int      _map_fd = -1;
+static int      _dump_fd = -1;
+static void*    _dump_marker = NULL;
+static uint64_t _code_index = 0;
+
+static const size_t NAME_LENGTH = 1024;
+static const int    FLUSH_INTERVAL_MS = 100;
+
+// perf expects CLOCK_MONOTONIC timestamps ("perf record -k mono"), which is
+// what os::javaTimeNanos() uses on Linux.
+static uint64_t timestamp() {
+  return (uint64_t)os::javaTimeNanos();
+}
+
+static void map_file_name(char* buf, size_t len) {
+  jio_snprintf(buf, len, "/tmp/perf-%d.map", os::current_process_id());
+}
+
+static void dump_file_name(char* buf, size_t len) {
+  jio_snprintf(buf, len, "/tmp/jit-%d.dump", os::current_process_id());
+}
+
+class PerfMapFlushTask : public PeriodicTask {
+ public:
+  PerfMapFlushTask() : PeriodicTask(FLUSH_INTERVAL_MS) {}
+  virtual void task() { PerfMap::flush(); }
+};
+
+static PerfMapFlushTask* _flush_task = NULL;
+
+static int open_output(const char* path) {
+  int fd = os::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  if (fd == -1) {
+    log_warning(os)("Could not open %s: %s", path, os::strerror(errno));
+  }
+  return fd;
+}
+
+static bool open_jitdump() {
+  char path[JVM_MAXPATHLEN];
+  dump_file_name(path, sizeof(path));
+  // perf needs to read the file back, so it is opened read-write.
+  int fd = os::open(path, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  if (fd == -1) {
+    log_warning(os)("Could not open %s: %s", path, os::strerror(errno));
+    return false;
+  }
+
+  JitDumpFileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic      = JITDUMP_MAGIC;
+  header.version    = JITDUMP_VERSION;
+  header.total_size = sizeof(header);
+  header.elf_mach   = JITDUMP_ELF_MACH;
+  header.pid        = (uint32_t)os::current_process_id();
+  header.timestamp  = timestamp();
+  if (os::write(fd, &header, sizeof(header)) != sizeof(header)) {
+    log_warning(os)("Could not write %s: %s", path, os::strerror(errno));
+    ::close(fd);
+    return false;
+  }
+
+  // perf record learns about the file from this executable mapping of it.
+  void* marker = ::mmap(NULL, os::vm_page_size(), PROT_READ | PROT_EXEC, MAP_PRIVATE, fd, 0);
+  if (marker == MAP_FAILED) {
+    log_warning(os)("Could not map %s: %s", path, os::strerror(errno));
+    ::close(fd);
+    return false;
+  }
+
+  _dump_fd = fd;
+  _dump_marker = marker;
+  return true;
+}
+
+void PerfMap::initialize() {
+  _buffer_lock = new Mutex(Mutex::leaf, "PerfMapBuffer_lock", true, Mutex::_safepoint_check_never);
+  _file_lock = new Mutex(Mutex::leaf + 1, "PerfMapFile_lock", true, Mutex::_safepoint_check_never);
+
+  if (WritePerfMap) {
+    char path[JVM_MAXPATHLEN];
+    map_file_name(path, sizeof(path));
+    _map_fd = open_output(path);
+    if (_map_fd != -1) {
+      _map_pending = new PerfMapBuffer();
+      _map_writing = new PerfMapBuffer();
+    }
+  }
+  if (WriteJitDump && open_jitdump()) {
+    _dump_pending = new PerfMapBuffer();
+    _dump_writing = new PerfMapBuffer();
+  }
+
+  _enabled = _map_fd != -1 || _dump_fd != -1;
+  if (_enabled) {
+    _flush_task = new PerfMapFlushTask();
+    _flush_task->enroll();
+  }
+}
+
+void PerfMap::flush() {
+  MutexLocker fl(_file_lock, Mutex::_no_safepoint_check_flag);
+  {
+    MutexLocker bl(_buffer_lock, Mutex::_no_safepoint_check_flag);
+    swap(_map_pending, _map_writing);
+    swap(_dump_pending, _dump_writing);
+  }
+  if (_map_writing != NULL && !_map_writing->is_empty()) {
+    _map_writing->write_to(_map_fd);
+  }
+  if (_dump_writing != NULL && !_dump_writing->is_empty()) {
+    _dump_writing->write_to(_dump_fd);
+  }
+}
+
+void PerfMap::shutdown() {
+  if (!_enabled) {
+    return;
+  }
+  if (_flush_task != NULL) {
+    _flush_task->disenroll();
+  }
+  {
+    MutexLocker bl(_buffer_lock, Mutex::_no_safepoint_check_flag);
+    _enabled = false;
+    if (_dump_pending != NULL) {
+      JitDumpRecordHeader close;
+      close.id = JIT_CODE_CLOSE;
+      close.total_size = sizeof(close);
+      close.timestamp = timestamp();
+      _dump_pending->append(&close, sizeof(close));
+    }
+  }
+  flush();
+
+  MutexLocker fl(_file_lock, Mutex::_no_safepoint_check_flag);
+  if (_map_fd != -1) {
+    ::close(_map_fd);
+    _map_fd = -1;
+  }
+  if (_dump_fd != -1) {
+    ::munmap(_dump_marker, os::vm_page_size());
+    ::close(_dump_fd);
+    _dump_fd = -1;
+  }
+}
+
+static void register_code(const char* name, address start, address end) {
+  if (start >= end) {
+    return;
+  }
+  size_t size = pointer_delta(end, start, sizeof(u1));
+
+  MutexLocker bl(_buffer_lock, Mutex::_no_safepoint_check_flag);
+  if (!PerfMap::is_enabled()) {
+    return;
+  }
+  if (_map_pending != NULL) {
+    char line[NAME_LENGTH + 64];
+    int len = jio_snprintf(line, sizeof(line), INTPTR_FORMAT " " INTPTR_FORMAT " %s\n",
+                           p2i(start), (intptr_t)size, name);
+    if (len < 0 || (size_t)len >= sizeof(line)) {
+      // Truncated; keep the line terminated.
+      len = (int)sizeof(line) - 1;
+      line[len - 1] = '\n';
+    }
+    _map_pending->append(line, len);
+  }
+  if (_dump_pending != NULL) {
+    size_t name_size = strlen(name) + 1;
+    JitDumpCodeLoad record;
+    record.header.id         = JIT_CODE_LOAD;
+    record.header.total_size = (uint32_t)(sizeof(record) + name_size + size);
+    record.header.timestamp  = timestamp();
+    record.pid               = (uint32_t)os::current_process_id();
+    record.tid               = (uint32_t)os::current_thread_id();
+    record.vma               = (uint64_t)p2i(start);
+    record.code_addr         = (uint64_t)p2i(start);
+    record.code_size         = size;
+    record.code_index        = _code_index++;
+    _dump_pending->append(&record, sizeof(record));
+    _dump_pending->append(name, name_size);
+    // The code is copied now; it may be gone by the time it is flushed.
+    _dump_pending->append(start, size);
+  }
+}
+
+void PerfMap::register_stub(const char* group, const char* name, address start, address end) {
+  if (!is_enabled()) {
+    return;
+  }
+  if (group != NULL) {
+    char buf[NAME_LENGTH];
+    jio_snprintf(buf, sizeof(buf), "%s::%s", group, name);
+    register_code(buf, start, end);
+  } else {
+    register_code(name, start, end);
+  }
+}
+
+static void print_codelet_name(char* buf, size_t len, InterpreterCodelet* codelet) {
+  jio_snprintf(buf, len, "Interpreter: %s", codelet->description());
+}
+
+void PerfMap::register_interpreter(StubQueue* code) {
+  if (!is_enabled()) {
+    return;
+  }
+  for (Stub* s = code->first(); s != NULL; s = code->next(s)) {
+    InterpreterCodelet* codelet = (InterpreterCodelet*)s;
+    char buf[NAME_LENGTH];
+    print_codelet_name(buf, sizeof(buf), codelet);
+    register_code(buf, codelet->code_begin(), codelet->code_end());
+  }
+}
+
+static void print_nmethod_name(char* buf, size_t len, nmethod* nm) {
+  ResourceMark rm;
+  const char* compiler = compilertype2name(nm->compiler_type());
+  jio_snprintf(buf, len, "%s [%s%s]", nm->method()->external_name(),
+               compiler != NULL ? compiler : "unknown",
+               nm->is_osr_method() ? ", osr" : "");
+}
+
+void PerfMap::register_nmethod(nmethod* nm) {
+  if (!is_enabled()) {
+    return;
+  }
+  char buf[NAME_LENGTH];
+  print_nmethod_name(buf, sizeof(buf), nm);
+  register_code(buf, nm->code_begin(), nm->code_end());
+}
+
+// Blobs that hold StubCodeDescs or interpreter codelets are described by
+// their parts rather than as a whole.
+static bool is_described_by_parts(CodeBlob* cb) {
+  if (!cb->is_buffer_blob()) {
+    return false;
+  }
+  StubQueue* code = AbstractInterpreter::code();
+  if (code != NULL && code->contains(cb->code_begin())) {
+    return true;
+  }
+  for (StubCodeDesc* d = StubCodeDesc::first(); d != NULL; d = StubCodeDesc::next(d)) {
+    if (cb->code_contains(d->begin())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void print_entry(outputStream* st, address start, address end, const char* name) {
+  if (start < end) {
+    st->print_cr(INTPTR_FORMAT " " INTPTR_FORMAT " %s",
+                 p2i(start), (intptr_t)pointer_delta(end, start, sizeof(u1)), name);
+  }
+}
+
+void PerfMap::write_snapshot_entries(outputStream* st) {
+  char buf[NAME_LENGTH];
+
+  MutexLocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  AllCodeBlobsIterator iter(AllCodeBlobsIterator::only_alive_and_not_unloading);
+  while (iter.next()) {
+    CodeBlob* cb = iter.method();
+    if (cb->is_nmethod()) {
+      print_nmethod_name(buf, sizeof(buf), (nmethod*)cb);
+      print_entry(st, cb->code_begin(), cb->code_end(), buf);
+    } else if (!is_described_by_parts(cb)) {
+      print_entry(st, cb->code_begin(), cb->code_end(), cb->name());
+    }
+  }
+
+  for (StubCodeDesc* d = StubCodeDesc::first(); d != NULL; d = StubCodeDesc::next(d)) {
+    jio_snprintf(buf, sizeof(buf), "%s::%s", d->group(), d->name());
+    print_entry(st, d->begin(), d->end(), buf);
+  }
+
+  StubQueue* code = AbstractInterpreter::code();
+  if (code != NULL) {
+    for (Stub* s = code->first(); s != NULL; s = code->next(s)) {
+      InterpreterCodelet* codelet = (InterpreterCodelet*)s;
+      print_codelet_name(buf, sizeof(buf), codelet);
+      print_entry(st, codelet->code_begin(), codelet->code_end(), buf);
+    }
+  }
+}
+
+void PerfMap::write_perf_map(outputStream* st) {
+  char path[JVM_MAXPATHLEN];
+  map_file_name(path, sizeof(path));
+
+  ResourceMark rm;
+  stringStream ss;
+
+  // Hold the file lock so the flush task cannot append between truncating
+  // and rewriting the file. Entries registered meanwhile stay pending and
+  // are appended by the next flush.
+  MutexLocker fl(_file_lock, Mutex::_no_safepoint_check_flag);
+  write_snapshot_entries(&ss);
+
+  int fd = os::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    st->print_cr("Could not open %s: %s", path, os::strerror(errno));
+    return;
+  }
+  const char* p = ss.base();
+  size_t left = ss.size();
+  while (left > 0) {
+    ssize_t n = (ssize_t)os::write(fd, p, (unsigned int)MIN2(left, (size_t)(1 * G)));
+    if (n <= 0) {
+      st->print_cr("Could not write %s: %s", path, os::strerror(errno));
+      break;
+    }
+    p += n;
+    left -= n;
+  }
+  ::close(fd);
+  if (left == 0) {
+    st->print_cr("Wrote " SIZE_FORMAT " bytes to %s", ss.size(), path);
+  }
+}
+
+#endif // LINUX
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_CODE_PERFMAP_HPP
+#define SHARE_CODE_PERFMAP_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class nmethod;
+class outputStream;
+class StubQueue;
+
+// PerfMap describes generated code to external profilers that cannot walk
+// the code cache themselves (Linux perf and tools reading its formats).
+//
+// With -XX:+WritePerfMap every stub, interpreter codelet and nmethod is
+// appended to /tmp/perf-<pid>.map as "<start> <size> <name>" when it is
+// generated. With -XX:+WriteJitDump the same events, including a copy of
+// the instructions, are written to /tmp/jit-<pid>.dump in the jitdump
+// format consumed by "perf inject --jit".
+//
+// Registration only appends to an in-memory buffer; the files are written
+// by a periodic task on the WatcherThread and once more at VM exit, so
+// compiler threads never block on file I/O.
+//
+// Neither format can express that code was unloaded. perf resolves an
+// address to the most recent entry covering it, so a later entry for
+// reused code cache memory supersedes the stale one.
+class PerfMap : AllStatic {
+  friend class PerfMapFlushTask;
+
+  static bool _enabled;
+
+  static void flush();
+  static void write_snapshot_entries(outputStream* st);
+
+ public:
+  // Opens the output files and starts the flush task, if enabled.
+  static void initialize();
+  // Flushes all pending entries and closes the output files.
+  static void shutdown();
+
+  static bool is_enabled() { return _enabled; }
+
+  // group may be NULL; StubCodeDescs are named "<group>::<name>".
+  static void register_stub(const char* group, const char* name, address start, address end);
+  static void register_interpreter(StubQueue* code);
+  static void register_nmethod(nmethod* nm);
+
+  // Rewrites /tmp/perf-<pid>.map from the current code cache contents.
+  // Reports the result on st.
+  static void write_perf_map(outputStream* st);
+};
+
+#endif // SHARE_CODE_PERFMAP_HPP
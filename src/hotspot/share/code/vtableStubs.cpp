@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "code/perfMap.hpp"
 #include "code/vtableStubs.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/disassembler.hpp"
@@ -233,6 +234,8 @@ address VtableStubs::find_stub(bool is_vtable_stub, int vtable_index) {
                       is_vtable_stub? "vtbl": "itbl", vtable_index, p2i(VtableStub::receiver_location()));
         Disassembler::decode(s->code_begin(), s->code_end());
       }
+      LINUX_ONLY(PerfMap::register_stub(NULL, is_vtable_stub? "vtable stub": "itable stub",
+                                        s->code_begin(), s->code_end());)
       // Notify JVMTI about this stub. The event will be recorded by the enclosing
       // JvmtiDynamicCodeEventCollector and posted when this thread has released
       // all locks. Only post this event if a new state is not required. Creating a new state would
@@ -180,10 +180,10 @@ CompileTask* CompilationPolicy::select_task_helper(CompileQueue* compile_queue)
      * to service non-compiler related compilations sooner and reduce the
      * chance of such compilations timing out.
      */
-    for (CompileTask* task = compile_queue->first(); task != NULL; task = task->next()) {
-      if (task->is_blocking()) {
-        return task;
-      }
+    if (compile_queue->has_blocking()) {
+      // Blocking tasks are kept at the front of the queue.
+      assert(compile_queue->first()->is_blocking(), "must be");
+      return compile_queue->first();
     }
   }
 #endif
@@ -36,6 +36,7 @@
 #include "compiler/compilerEvent.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "compiler/directivesParser.hpp"
+#include "compiler/profileCache.hpp"
 #include "interpreter/linkResolver.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
@@ -59,12 +60,14 @@
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/sweeper.hpp"
+#include "runtime/timer.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/vframe.inline.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/events.hpp"
 #include "utilities/formatBuffer.hpp"
+#include "utilities/latencyHistogram.hpp"
 #include "utilities/macros.hpp"
 #ifdef COMPILER1
 #include "c1/c1_Compiler.hpp"
@@ -141,6 +144,8 @@ PerfCounter* CompileBroker::_perf_osr_compilation = NULL;
 PerfCounter* CompileBroker::_perf_standard_compilation = NULL;
 
 PerfCounter* CompileBroker::_perf_total_bailout_count = NULL;
+PerfCounter* CompileBroker::_perf_total_throttle_count = NULL;
+PerfCounter* CompileBroker::_perf_total_throttle_time = NULL;
 PerfCounter* CompileBroker::_perf_total_invalidated_count = NULL;
 PerfCounter* CompileBroker::_perf_total_compile_count = NULL;
 PerfCounter* CompileBroker::_perf_total_osr_compile_count = NULL;
@@ -161,6 +166,7 @@ PerfVariable*       CompileBroker::_perf_last_invalidated_type = NULL;
 
 // Timers and counters for generating statistics
 elapsedTimer CompileBroker::_t_total_compilation;
+elapsedTimer CompileBroker::_t_unused_compilation;
 elapsedTimer CompileBroker::_t_osr_compilation;
 elapsedTimer CompileBroker::_t_standard_compilation;
 elapsedTimer CompileBroker::_t_invalidated_compilation;
@@ -168,6 +174,7 @@ elapsedTimer CompileBroker::_t_bailedout_compilation;
 
 int CompileBroker::_total_bailout_count            = 0;
 int CompileBroker::_total_invalidated_count        = 0;
+int CompileBroker::_total_unused_count            = 0;
 int CompileBroker::_total_compile_count            = 0;
 int CompileBroker::_total_osr_compile_count        = 0;
 int CompileBroker::_total_standard_compile_count   = 0;
@@ -357,6 +364,19 @@ void CompileQueue::add(CompileTask* task) {
     assert(_first == NULL, "queue is empty");
     _first = task;
     _last = task;
+  } else if (task->is_blocking() && _last_blocking != _last) {
+    // Insert the task at the end of the blocking segment, ahead of
+    // all non-blocking tasks.
+    CompileTask* next = first_non_blocking();
+    assert(next != NULL && !next->is_blocking(), "must be non-blocking");
+    task->set_prev(_last_blocking);
+    task->set_next(next);
+    if (_last_blocking != NULL) {
+      _last_blocking->set_next(task);
+    } else {
+      _first = task;
+    }
+    next->set_prev(task);
   } else {
     // Append the task to the queue.
     assert(_last->next() == NULL, "not last");
@@ -364,7 +384,12 @@ void CompileQueue::add(CompileTask* task) {
     task->set_prev(_last);
     _last = task;
   }
+  if (task->is_blocking()) {
+    _last_blocking = task;
+    ++_blocking_size;
+  }
   ++_size;
+  update_perf_length();
 
   // Mark the method as being in the compile queue.
   task->method()->set_queued_for_compilation();
@@ -404,11 +429,18 @@ void CompileQueue::free_all() {
     CompileTask::free(current);
   }
   _first = NULL;
+  _last = NULL;
+  _last_blocking = NULL;
+  _size = 0;
+  _blocking_size = 0;
+  update_perf_length();
 
   // Wake up all threads that block on the queue.
   MethodCompileQueue_lock->notify_all();
 }
 
+static LatencyHistogram _queue_wait_histogram("Compile queue wait");
+
 /**
  * Get the next CompileTask from a CompileQueue
  */
@@ -468,6 +500,13 @@ CompileTask* CompileQueue::get() {
     save_hot_method = methodHandle(thread, task->hot_method());
 
     remove(task);
+
+    jlong wait_ticks = os::elapsed_counter() - task->time_queued();
+    _queue_wait_histogram.record((jlong)(TimeHelper::counter_to_seconds(wait_ticks) * NANOSECS_PER_SEC));
+    if (_perf_dequeued != NULL) {
+      _perf_dequeued->inc();
+      _perf_wait_time->inc(wait_ticks);
+    }
   }
   purge_stale_tasks(); // may temporarily release MCQ lock
   return task;
@@ -513,7 +552,41 @@ void CompileQueue::remove(CompileTask* task) {
     assert(task == _last, "Sanity");
     _last = task->prev();
   }
+
+  if (task->is_blocking()) {
+    if (task == _last_blocking) {
+      // The blocking segment only holds blocking tasks.
+      assert(task->prev() == NULL || task->prev()->is_blocking(), "Sanity");
+      _last_blocking = task->prev();
+    }
+    --_blocking_size;
+  }
   --_size;
+  update_perf_length();
+}
+
+CompileTask* CompileQueue::first_non_blocking() const {
+  return _last_blocking == NULL ? _first : _last_blocking->next();
+}
+
+void CompileQueue::update_perf_length() {
+  if (_perf_length != NULL) {
+    _perf_length->set_value(_size);
+  }
+}
+
+/**
+ * Create the jvmstat counters of this queue, named <prefix>Length,
+ * <prefix>Dequeued and <prefix>WaitTime in the sun.ci name space.
+ */
+void CompileQueue::initialize_perf_counters(const char* prefix, TRAPS) {
+  char name[64];
+  jio_snprintf(name, sizeof(name), "%sLength", prefix);
+  _perf_length = PerfDataManager::create_variable(SUN_CI, name, PerfData::U_Events, CHECK);
+  jio_snprintf(name, sizeof(name), "%sDequeued", prefix);
+  _perf_dequeued = PerfDataManager::create_counter(SUN_CI, name, PerfData::U_Events, CHECK);
+  jio_snprintf(name, sizeof(name), "%sWaitTime", prefix);
+  _perf_wait_time = PerfDataManager::create_counter(SUN_CI, name, PerfData::U_Ticks, CHECK);
 }
 
 void CompileQueue::remove_and_mark_stale(CompileTask* task) {
@@ -588,6 +661,7 @@ void CompileQueue::print_tty() {
 CompilerCounters::CompilerCounters() {
   _current_method[0] = '\0';
   _compile_type = CompileBroker::no_compile;
+  _throttle_count = 0;
 }
 
 #if INCLUDE_JFR && COMPILER2_OR_JVMCI
@@ -626,6 +700,8 @@ void CompileBroker::compilation_init_phase1(Thread* THREAD) {
   if (!UseCompiler) {
     return;
   }
+  ProfileCache::load();
+
   // Set the interface to the current compiler(s).
   _c1_count = CompilationPolicy::policy()->compiler_count(CompLevel_simple);
   _c2_count = CompilationPolicy::policy()->compiler_count(CompLevel_full_optimization);
@@ -711,6 +787,14 @@ void CompileBroker::compilation_init_phase1(Thread* THREAD) {
                  PerfDataManager::create_counter(SUN_CI, "totalInvalidates",
                                                  PerfData::U_Events, CHECK);
 
+    _perf_total_throttle_count =
+                 PerfDataManager::create_counter(SUN_CI, "totalThrottles",
+                                                 PerfData::U_Events, CHECK);
+
+    _perf_total_throttle_time =
+                 PerfDataManager::create_counter(SUN_CI, "throttleTime",
+                                                 PerfData::U_Ticks, CHECK);
+
     _perf_total_compile_count =
                  PerfDataManager::create_counter(SUN_CI, "totalCompiles",
                                                  PerfData::U_Events, CHECK);
@@ -777,6 +861,13 @@ void CompileBroker::compilation_init_phase1(Thread* THREAD) {
                                           PerfData::U_None,
                                           (jlong)CompileBroker::no_compile,
                                           CHECK);
+
+    if (_c2_compile_queue != NULL) {
+      _c2_compile_queue->initialize_perf_counters("c2Queue", CHECK);
+    }
+    if (_c1_compile_queue != NULL) {
+      _c1_compile_queue->initialize_perf_counters("c1Queue", CHECK);
+    }
   }
 }
 
@@ -847,6 +938,10 @@ JavaThread* CompileBroker::make_thread(jobject thread_handle, CompileQueue* queu
         }
       }
       os::set_native_priority(new_thread, native_prio);
+      if (comp != NULL && CompilerThreadCPUs != NULL &&
+          os::set_native_affinity(new_thread, CompilerThreadCPUs) != OS_OK) {
+        warning("Could not bind compiler thread to CPUs %s", CompilerThreadCPUs);
+      }
 
       java_lang_Thread::set_daemon(JNIHandles::resolve_non_null(thread_handle));
 
@@ -966,12 +1061,24 @@ void CompileBroker::possibly_add_compiler_threads(Thread* THREAD) {
   size_t available_cc_np  = CodeCache::unallocated_capacity(CodeBlobType::MethodNonProfiled),
          available_cc_p   = CodeCache::unallocated_capacity(CodeBlobType::MethodProfiled);
 
+  // The thread counts were chosen for the processors available at startup.
+  // Scale them down if fewer are available now, e.g. because the CPU quota
+  // of the container was lowered.
+  int c1_limit = _c1_count;
+  int c2_limit = _c2_count;
+  int active_cpus = os::active_processor_count();
+  int initial_cpus = os::initial_active_processor_count();
+  if (active_cpus < initial_cpus) {
+    c1_limit = MAX2(1, _c1_count * active_cpus / initial_cpus);
+    c2_limit = MAX2(1, _c2_count * active_cpus / initial_cpus);
+  }
+
   // Only do attempt to start additional threads if the lock is free.
   if (!CompileThread_lock->try_lock()) return;
 
   if (_c2_compile_queue != NULL) {
     int old_c2_count = _compilers[1]->num_compiler_threads();
-    int new_c2_count = MIN4(_c2_count,
+    int new_c2_count = MIN4(c2_limit,
         _c2_compile_queue->size() / 2,
         (int)(available_memory / (200*M)),
         (int)(available_cc_np / (128*K)));
@@ -1024,7 +1131,7 @@ void CompileBroker::possibly_add_compiler_threads(Thread* THREAD) {
 
   if (_c1_compile_queue != NULL) {
     int old_c1_count = _compilers[0]->num_compiler_threads();
-    int new_c1_count = MIN4(_c1_count,
+    int new_c1_count = MIN4(c1_limit,
         _c1_compile_queue->size() / 4,
         (int)(available_memory / (100*M)),
         (int)(available_cc_p / (128*K)));
@@ -1818,6 +1925,35 @@ CompileLog* CompileBroker::get_log(CompilerThread* ct) {
 // CompileBroker::compiler_thread_loop
 //
 // The main loop run by a CompilerThread.
+// Back off while the system is busier than CompilationCPULoadThreshold so
+// compilations do not take CPU time from application threads. A thread
+// waits at most one second before it goes on with the next task.
+void CompileBroker::throttle_compilation(CompilerThread* thread) {
+  if (CompilationCPULoadThreshold == 0) {
+    return;
+  }
+  const int slice_ms = 10;
+  const int max_slices = 100;
+  int slices = 0;
+  while (slices < max_slices) {
+    double load;
+    if (os::loadavg(&load, 1) != 1 ||
+        load * 100 / os::active_processor_count() <= (double)CompilationCPULoadThreshold) {
+      break;
+    }
+    ThreadBlockInVM tbivm(thread);
+    os::naked_short_sleep(slice_ms);
+    slices++;
+  }
+  if (slices > 0) {
+    thread->counters()->inc_throttle_count();
+    if (UsePerfData) {
+      _perf_total_throttle_count->inc();
+      _perf_total_throttle_time->inc(slices * slice_ms * (os::elapsed_frequency() / 1000));
+    }
+  }
+}
+
 void CompileBroker::compiler_thread_loop() {
   CompilerThread* thread = CompilerThread::current();
   CompileQueue* queue = thread->queue();
@@ -1862,6 +1998,8 @@ void CompileBroker::compiler_thread_loop() {
     // We need this HandleMark to avoid leaking VM handles.
     HandleMark hm(thread);
 
+    throttle_compilation(thread);
+
     CompileTask* task = queue->get();
     if (task == NULL) {
       if (UseDynamicNumberOfCompilerThreads) {
@@ -2072,7 +2210,23 @@ static void post_compilation_event(EventCompilation& event, CompileTask* task) {
                                         task->is_success(),
                                         task->osr_bci() != CompileBroker::standard_entry_bci,
                                         (task->code() == NULL) ? 0 : task->code()->total_size(),
-                                        task->num_inlined_bytecodes());
+                                        task->num_inlined_bytecodes(),
+                                        task->num_eliminated_boxes(),
+                                        task->num_eliminated_allocations(),
+                                        task->num_optimized_string_concats());
+}
+
+static void post_compilation_memory_limit_event(CompileTask* task, size_t peak) {
+  EventCompilationMemoryLimit event;
+  if (event.should_commit()) {
+    CompilerEvent::CompilationMemoryLimitEvent::post(event,
+                                                     task->compile_id(),
+                                                     task->compiler()->type(),
+                                                     task->method(),
+                                                     task->comp_level(),
+                                                     peak,
+                                                     CompileArenaMemoryLimit);
+  }
 }
 
 int DirectivesStack::_depth = 0;
@@ -2186,6 +2340,9 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
     NoHandleMark  nhm;
     ThreadToNativeFromVM ttn(thread);
 
+    // Start accounting compiler arena memory before ciEnv creates its arena
+    thread->reset_arena_statistics();
+
     ciEnv ci_env(task);
     if (should_break) {
       ci_env.set_break_at_compile(true);
@@ -2239,6 +2396,13 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
       ci_env.record_method_not_compilable("compile failed", !TieredCompilation);
     }
 
+    if (thread->arena_limit_hit()) {
+      // Retrying at this tier would most likely hit the limit again.
+      ci_env.record_method_not_compilable("out of compile arena memory", !TieredCompilation);
+      post_compilation_memory_limit_event(task, thread->arena_peak());
+    }
+    log_debug(jit, compilation)("%d arena peak " SIZE_FORMAT " bytes", compile_id, thread->arena_peak());
+
     // Copy this bit to the enclosing block:
     compilable = ci_env.compilable();
 
@@ -2493,6 +2657,7 @@ void CompileBroker::collect_statistics(CompilerThread* thread, elapsedTimer time
     // update compilation ticks - used by the implementation of
     // java.lang.management.CompilationMXBean
     _perf_total_compilation->inc(time.ticks());
+    code->set_compile_time_ticks(time.ticks());
     _peak_compilation_time = time.milliseconds() > _peak_compilation_time ? time.milliseconds() : _peak_compilation_time;
 
     if (CITime) {
@@ -2670,6 +2835,9 @@ void CompileBroker::print_times(bool per_compiler, bool aggregate) {
   tty->print_cr("    Invalidated            : %7.3f s, Average : %2.3f s",
                 CompileBroker::_t_invalidated_compilation.seconds(),
                 total_invalidated_count == 0 ? 0.0 : CompileBroker::_t_invalidated_compilation.seconds() / total_invalidated_count);
+  tty->print_cr("    Never executed         : %7.3f s, Count   : %d",
+                CompileBroker::_t_unused_compilation.seconds(),
+                CompileBroker::_total_unused_count);
 
   AbstractCompiler *comp = compiler(CompLevel_simple);
   if (comp != NULL) {
@@ -2697,6 +2865,14 @@ void CompileBroker::print_times(bool per_compiler, bool aggregate) {
   tty->print_cr("  nmethod total size        : %8d bytes", nmethods_size);
 }
 
+void CompileBroker::record_unused_compilation(nmethod* nm) {
+  // Only called by the sweeper thread, like the other sweeper statistics
+  // these are not updated under CompileStatistics_lock.
+  assert(Thread::current()->is_Code_cache_sweeper_thread(), "must be");
+  _total_unused_count++;
+  _t_unused_compilation.add(elapsedTimer(nm->compile_time_ticks(), os::elapsed_frequency()));
+}
+
 // Print general/accumulated JIT information.
 void CompileBroker::print_info(outputStream *out) {
   if (out == NULL) out = tty;
@@ -2744,17 +2920,33 @@ void CompileBroker::print_heapinfo(outputStream* out, const char* function, size
   bool methodAge = !strcmp(function, "MethodAge") || allFun;
   bool methodNames = !strcmp(function, "MethodNames") || allFun;
   bool discard = !strcmp(function, "discard") || allFun;
+  bool compact = !strcmp(function, "compact");
 
   if (out == NULL) {
     out = tty;
   }
 
-  if (!(aggregate || usedSpace || freeSpace || methodCount || methodSpace || methodAge || methodNames || discard)) {
+  if (!(aggregate || usedSpace || freeSpace || methodCount || methodSpace || methodAge || methodNames || discard || compact)) {
     out->print_cr("\n__ CodeHeapStateAnalytics: Function %s is not supported", function);
     out->cr();
     return;
   }
 
+  if (compact) {
+    // Aggregate quietly and print one machine readable line per CodeHeap.
+    // The aggregate step releases the CodeCache_lock every now and then,
+    // which makes this cheap enough to be run periodically.
+    ResourceMark rm;
+    stringStream aggregate_output;
+    MutexLocker mu1(CodeHeapStateAnalytics_lock, Mutex::_no_safepoint_check_flag);
+    {
+      MutexLocker mu2(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+      CodeCache::aggregate(&aggregate_output, granularity, true /* yield_lock */);
+    }
+    CodeCache::print_compact(out);
+    return;
+  }
+
   ts_total.update(); // record starting point
 
   if (aggregate) {
@@ -2795,7 +2987,9 @@ void CompileBroker::print_heapinfo(outputStream* out, const char* function, size
     }
 
     ts.update(); // record starting point
-    CodeCache::aggregate(out, granularity);
+    // The CodeCache_lock may only be released during the walk if it is not
+    // held as the global lock for a consistent picture.
+    CodeCache::aggregate(out, granularity, function_lock != NULL);
     if (function_lock != NULL) {
       out->print_cr("\n__ CodeCache (function) lock hold took %10.3f seconds _________\n", ts.seconds());
     }
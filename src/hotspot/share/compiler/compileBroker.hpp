@@ -54,6 +54,7 @@ class CompilerCounters : public CHeapObj<mtCompiler> {
 
     char _current_method[cmname_buffer_length];
     int  _compile_type;
+    int  _throttle_count;  // number of times compilation was delayed for CPU load
 
   public:
     CompilerCounters();
@@ -73,44 +74,69 @@ class CompilerCounters : public CHeapObj<mtCompiler> {
 
     int compile_type()                       { return _compile_type; }
 
+    void inc_throttle_count()                { _throttle_count++; }
+    int throttle_count()                     { return _throttle_count; }
+
 };
 
 // CompileQueue
 //
-// A list of CompileTasks.
+// A list of CompileTasks. Blocking tasks are kept in a segment at the
+// front of the list, ahead of all non-blocking tasks, so that the
+// compilation policy can service them without walking the whole queue.
 class CompileQueue : public CHeapObj<mtCompiler> {
  private:
   const char* _name;
 
   CompileTask* _first;
   CompileTask* _last;
+  CompileTask* _last_blocking; // last task of the blocking segment
 
   CompileTask* _first_stale;
 
   int _size;
+  int _blocking_size;
+
+  // jvmstat counters, NULL unless UsePerfData
+  PerfVariable* _perf_length;
+  PerfCounter*  _perf_dequeued;
+  PerfCounter*  _perf_wait_time;
 
   void purge_stale_tasks();
+  void update_perf_length();
  public:
   CompileQueue(const char* name) {
     _name = name;
     _first = NULL;
     _last = NULL;
+    _last_blocking = NULL;
     _size = 0;
+    _blocking_size = 0;
     _first_stale = NULL;
+    _perf_length = NULL;
+    _perf_dequeued = NULL;
+    _perf_wait_time = NULL;
   }
 
   const char*  name() const                      { return _name; }
 
+  void         initialize_perf_counters(const char* prefix, TRAPS);
+
   void         add(CompileTask* task);
   void         remove(CompileTask* task);
   void         remove_and_mark_stale(CompileTask* task);
   CompileTask* first()                           { return _first; }
   CompileTask* last()                            { return _last;  }
 
+  // The blocking segment is [first(), first_non_blocking()).
+  bool         has_blocking() const              { return _last_blocking != NULL; }
+  CompileTask* first_non_blocking() const;
+
   CompileTask* get();
 
   bool         is_empty() const                  { return _first == NULL; }
   int          size()     const                  { return _size;          }
+  int          blocking_size() const             { return _blocking_size; }
 
 
   // Redefine Classes support
@@ -184,6 +210,8 @@ class CompileBroker: AllStatic {
   static PerfCounter* _perf_standard_compilation;
 
   static PerfCounter* _perf_total_bailout_count;
+  static PerfCounter* _perf_total_throttle_count;
+  static PerfCounter* _perf_total_throttle_time;
   static PerfCounter* _perf_total_invalidated_count;
   static PerfCounter* _perf_total_compile_count;
   static PerfCounter* _perf_total_native_compile_count;
@@ -209,10 +237,12 @@ class CompileBroker: AllStatic {
   static elapsedTimer _t_standard_compilation;
   static elapsedTimer _t_invalidated_compilation;
   static elapsedTimer _t_bailedout_compilation;
+  static elapsedTimer _t_unused_compilation;
 
   static int _total_compile_count;
   static int _total_bailout_count;
   static int _total_invalidated_count;
+  static int _total_unused_count;
   static int _total_native_compile_count;
   static int _total_osr_compile_count;
   static int _total_standard_compile_count;
@@ -318,6 +348,7 @@ public:
   static uint assign_compile_id_unlocked(Thread* thread, const methodHandle& method, int osr_bci);
 
   static void compiler_thread_loop();
+  static void throttle_compilation(CompilerThread* thread);
   static uint get_compilation_id() { return _compilation_id; }
 
   // Set _should_block.
@@ -379,6 +410,10 @@ public:
   // Print a detailed accounting of compilation time
   static void print_times(bool per_compiler = true, bool aggregate = true);
 
+  // Account the compilation of an nmethod flushed as cold by the sweeper
+  // before it was ever seen running.
+  static void record_unused_compilation(nmethod* nm);
+
   // compiler name for debugging
   static const char* compiler_name(int comp_level);
 
@@ -103,6 +103,9 @@ void CompileTask::initialize(int compile_id,
   JVMCI_ONLY(_blocking_jvmci_compile_state = NULL;)
   _comp_level = comp_level;
   _num_inlined_bytecodes = 0;
+  _num_eliminated_boxes = 0;
+  _num_eliminated_allocations = 0;
+  _num_optimized_string_concats = 0;
 
   _is_complete = false;
   _is_success = false;
@@ -405,6 +408,15 @@ void CompileTask::log_task_done(CompileLog* log) {
   if (_num_inlined_bytecodes != 0) {
     log->print(" inlined_bytes='%d'", _num_inlined_bytecodes);
   }
+  if (_num_eliminated_boxes != 0) {
+    log->print(" eliminated_boxes='%u'", _num_eliminated_boxes);
+  }
+  if (_num_eliminated_allocations != 0) {
+    log->print(" eliminated_allocations='%u'", _num_eliminated_allocations);
+  }
+  if (_num_optimized_string_concats != 0) {
+    log->print(" string_concats='%u'", _num_optimized_string_concats);
+  }
   log->stamp();
   log->end_elem();
   log->clear_identities();   // next task will have different CI
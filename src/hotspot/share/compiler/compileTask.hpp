@@ -88,6 +88,9 @@ class CompileTask : public CHeapObj<mtCompiler> {
 #endif
   int          _comp_level;
   int          _num_inlined_bytecodes;
+  uint         _num_eliminated_boxes;
+  uint         _num_eliminated_allocations;
+  uint         _num_optimized_string_concats;
   nmethodLocker* _code_handle;  // holder of eventual result
   CompileTask* _next, *_prev;
   bool         _is_free;
@@ -162,6 +165,7 @@ class CompileTask : public CHeapObj<mtCompiler> {
   void         mark_complete()                   { _is_complete = true; }
   void         mark_success()                    { _is_success = true; }
   void         mark_started(jlong time)          { _time_started = time; }
+  jlong        time_queued() const               { return _time_queued; }
 
   int          comp_level()                      { return _comp_level;}
   void         set_comp_level(int comp_level)    { _comp_level = comp_level;}
@@ -172,6 +176,15 @@ class CompileTask : public CHeapObj<mtCompiler> {
   int          num_inlined_bytecodes() const     { return _num_inlined_bytecodes; }
   void         set_num_inlined_bytecodes(int n)  { _num_inlined_bytecodes = n; }
 
+  uint         num_eliminated_boxes() const      { return _num_eliminated_boxes; }
+  uint         num_eliminated_allocations() const { return _num_eliminated_allocations; }
+  uint         num_optimized_string_concats() const { return _num_optimized_string_concats; }
+  void         set_elimination_counts(uint boxes, uint allocations, uint string_concats) {
+    _num_eliminated_boxes = boxes;
+    _num_eliminated_allocations = allocations;
+    _num_optimized_string_concats = string_concats;
+  }
+
   CompileTask* next() const                      { return _next; }
   void         set_next(CompileTask* next)       { _next = next; }
   CompileTask* prev() const                      { return _prev; }
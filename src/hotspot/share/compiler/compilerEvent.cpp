@@ -114,7 +114,8 @@ int CompilerEvent::PhaseEvent::get_phase_id(const char* phase_name, bool may_exi
   return index;
 }
 
-void CompilerEvent::CompilationEvent::post(EventCompilation& event, int compile_id, CompilerType compiler_type, Method* method, int compile_level, bool success, bool is_osr, int code_size, int inlined_bytecodes) {
+void CompilerEvent::CompilationEvent::post(EventCompilation& event, int compile_id, CompilerType compiler_type, Method* method, int compile_level, bool success, bool is_osr, int code_size, int inlined_bytecodes,
+                                            uint eliminated_boxes, uint eliminated_allocations, uint optimized_string_concats) {
   event.set_compileId(compile_id);
   event.set_compiler(compiler_type);
   event.set_method(method);
@@ -123,6 +124,9 @@ void CompilerEvent::CompilationEvent::post(EventCompilation& event, int compile_
   event.set_isOsr(is_osr);
   event.set_codeSize(code_size);
   event.set_inlinedBytes(inlined_bytecodes);
+  event.set_eliminatedBoxes(eliminated_boxes);
+  event.set_eliminatedAllocations(eliminated_allocations);
+  event.set_optimizedStringConcats(optimized_string_concats);
   event.commit();
 }
 
@@ -132,6 +136,16 @@ void CompilerEvent::CompilationFailureEvent::post(EventCompilationFailure& event
   event.commit();
 }
 
+void CompilerEvent::CompilationMemoryLimitEvent::post(EventCompilationMemoryLimit& event, int compile_id, CompilerType compiler_type, Method* method, int compile_level, size_t peak, size_t limit) {
+  event.set_compileId(compile_id);
+  event.set_compiler(compiler_type);
+  event.set_method(method);
+  event.set_compileLevel((short)compile_level);
+  event.set_peak(peak);
+  event.set_limit(limit);
+  event.commit();
+}
+
 void CompilerEvent::PhaseEvent::post(EventCompilerPhase& event, const Ticks& start_time, int phase, int compile_id, int level) {
   event.set_starttime(start_time);
   event.set_phase((u1) phase);
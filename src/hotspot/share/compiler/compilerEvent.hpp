@@ -40,6 +40,7 @@ class GrowableArray;
 class Method;
 class EventCompilation;
 class EventCompilationFailure;
+class EventCompilationMemoryLimit;
 class EventCompilerInlining;
 class EventCompilerPhase;
 struct JfrStructCalleeMethod;
@@ -53,7 +54,8 @@ class CompilerEvent : AllStatic {
 
   class CompilationEvent : AllStatic {
    public:
-    static void post(EventCompilation& event, int compile_id, CompilerType type, Method* method, int compile_level, bool success, bool is_osr, int code_size, int inlined_bytecodes) NOT_JFR_RETURN();
+    static void post(EventCompilation& event, int compile_id, CompilerType type, Method* method, int compile_level, bool success, bool is_osr, int code_size, int inlined_bytecodes,
+                     uint eliminated_boxes, uint eliminated_allocations, uint optimized_string_concats) NOT_JFR_RETURN();
   };
 
   class CompilationFailureEvent : AllStatic {
@@ -61,6 +63,11 @@ class CompilerEvent : AllStatic {
     static void post(EventCompilationFailure& event, int compile_id, const char* reason) NOT_JFR_RETURN();
   };
 
+  class CompilationMemoryLimitEvent : AllStatic {
+   public:
+    static void post(EventCompilationMemoryLimit& event, int compile_id, CompilerType type, Method* method, int compile_level, size_t peak, size_t limit) NOT_JFR_RETURN();
+  };
+
   class PhaseEvent : AllStatic {
     friend class CompilerPhaseTypeConstant;
    public:
@@ -44,6 +44,12 @@ class frame;
 class RegisterMap;
 class OopClosure;
 
+enum class DerivedPointerIterationMode {
+  _with_table,
+  _directly,
+  _ignore
+};
+
 class OopMapValue: public StackObj {
   friend class VMStructs;
 private:
@@ -221,13 +227,15 @@ class OopMapSet : public ResourceObj {
 
   // Iterates through frame for a compiled method
   static void oops_do            (const frame* fr,
-                                  const RegisterMap* reg_map, OopClosure* f);
+                                  const RegisterMap* reg_map,
+                                  OopClosure* f,
+                                  DerivedPointerIterationMode mode);
   static void update_register_map(const frame* fr, RegisterMap *reg_map);
 
   // Iterates through frame for a compiled method for dead ones and values, too
   static void all_do(const frame* fr, const RegisterMap* reg_map,
                      OopClosure* oop_fn,
-                     void derived_oop_fn(oop* base, oop* derived),
+                     void derived_oop_fn(oop* base, oop* derived, OopClosure* oop_fn),
                      OopClosure* value_fn);
 
   // Printing
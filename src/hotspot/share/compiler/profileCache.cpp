@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classFileStream.hpp"
+#include "classfile/classLoader.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/symbolTable.hpp"
+#include "compiler/compilerDefinitions.hpp"
+#include "compiler/profileCache.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+static const char* const profile_cache_header = "# HotSpot profile cache 1";
+
+// A class recorded in ProfileCacheFile. The state is resolved against the
+// class file CRC observed in this run the first time one of its methods is
+// looked up.
+class ProfileCacheClass : public CHeapObj<mtCompiler> {
+ public:
+  enum State { unknown, valid, invalid };
+
+  Symbol* const _name;
+  const juint   _crc;
+  volatile int  _state;
+
+  ProfileCacheClass(Symbol* name, juint crc) : _name(name), _crc(crc), _state(unknown) {}
+};
+
+class ProfileCacheMethodKey {
+ public:
+  Symbol* _klass;
+  Symbol* _name;
+  Symbol* _signature;
+
+  ProfileCacheMethodKey() : _klass(NULL), _name(NULL), _signature(NULL) {}
+  ProfileCacheMethodKey(Symbol* klass, Symbol* name, Symbol* signature) :
+    _klass(klass), _name(name), _signature(signature) {}
+
+  static unsigned hash(const ProfileCacheMethodKey& k) {
+    return k._klass->identity_hash() ^ (k._name->identity_hash() * 31) ^ (k._signature->identity_hash() * 961);
+  }
+  static bool equals(const ProfileCacheMethodKey& a, const ProfileCacheMethodKey& b) {
+    return a._klass == b._klass && a._name == b._name && a._signature == b._signature;
+  }
+};
+
+class ProfileCacheMethod {
+ public:
+  ProfileCacheClass* _holder;
+  int                _level;
+
+  ProfileCacheMethod() : _holder(NULL), _level(CompLevel_none) {}
+  ProfileCacheMethod(ProfileCacheClass* holder, int level) : _holder(holder), _level(level) {}
+};
+
+// Class file CRC observed in this run. A name loaded from class files
+// with different contents is marked as conflicting and never trusted.
+class ProfileCacheCrc {
+ public:
+  juint _crc;
+  bool  _conflict;
+
+  ProfileCacheCrc() : _crc(0), _conflict(false) {}
+  ProfileCacheCrc(juint crc) : _crc(crc), _conflict(false) {}
+};
+
+typedef ResourceHashtable<ProfileCacheMethodKey, ProfileCacheMethod,
+                          ProfileCacheMethodKey::hash, ProfileCacheMethodKey::equals,
+                          1031, ResourceObj::C_HEAP, mtCompiler> ProfileCacheMethodTable;
+
+typedef ResourceHashtable<Symbol*, ProfileCacheCrc,
+                          primitive_hash<Symbol*>, primitive_equals<Symbol*>,
+                          1031, ResourceObj::C_HEAP, mtCompiler> ProfileCacheCrcTable;
+
+bool ProfileCache::_is_loaded = false;
+static ProfileCacheMethodTable* _methods = NULL;
+static ProfileCacheCrcTable* _observed = NULL; // protected by ProfileCache_lock
+
+void ProfileCache::record_class_file(InstanceKlass* ik, const ClassFileStream* stream) {
+  assert(is_recording(), "must be");
+  if (ik->is_hidden() || ik->is_unsafe_anonymous()) {
+    return;
+  }
+  juint crc = (juint)ClassLoader::crc32(0, (const char*)stream->buffer(), stream->length());
+  Symbol* name = ik->name();
+
+  MutexLocker ml(ProfileCache_lock, Mutex::_no_safepoint_check_flag);
+  if (_observed == NULL) {
+    _observed = new (ResourceObj::C_HEAP, mtCompiler) ProfileCacheCrcTable();
+  }
+  ProfileCacheCrc* observed = _observed->get(name);
+  if (observed == NULL) {
+    // Keep the name alive so that the key is not reused by another symbol
+    // after the class is unloaded.
+    name->increment_refcount();
+    _observed->put(name, ProfileCacheCrc(crc));
+  } else if (observed->_crc != crc) {
+    observed->_conflict = true;
+  }
+}
+
+static bool lookup_observed_crc(Symbol* name, juint* crc) {
+  MutexLocker ml(ProfileCache_lock, Mutex::_no_safepoint_check_flag);
+  ProfileCacheCrc* observed = (_observed != NULL) ? _observed->get(name) : NULL;
+  if (observed == NULL || observed->_conflict) {
+    return false;
+  }
+  *crc = observed->_crc;
+  return true;
+}
+
+static bool is_valid(ProfileCacheClass* klass) {
+  int state = Atomic::load_acquire(&klass->_state);
+  if (state == ProfileCacheClass::unknown) {
+    juint crc;
+    if (!lookup_observed_crc(klass->_name, &crc)) {
+      // Not loaded from a class file (yet).
+      return false;
+    }
+    state = (crc == klass->_crc) ? ProfileCacheClass::valid : ProfileCacheClass::invalid;
+    Atomic::release_store(&klass->_state, state);
+    if (state == ProfileCacheClass::invalid) {
+      ResourceMark rm;
+      log_info(jit, compilation)("Profile cache: ignoring %s, class file has changed", klass->_name->as_C_string());
+    }
+  }
+  return state == ProfileCacheClass::valid;
+}
+
+double ProfileCache::threshold_scaling(const Method* method, int cur_level) {
+  if (!_is_loaded) {
+    return 1.0;
+  }
+  ProfileCacheMethodKey key(method->klass_name(), method->name(), method->signature());
+  ProfileCacheMethod* entry = _methods->get(key);
+  if (entry == NULL || entry->_level <= cur_level || !is_valid(entry->_holder)) {
+    return 1.0;
+  }
+  return ProfileCacheThresholdScaling;
+}
+
+void ProfileCache::load() {
+  assert(!_is_loaded, "only once");
+  if (ProfileCacheFile == NULL) {
+    return;
+  }
+  FILE* stream = fopen(ProfileCacheFile, "rt");
+  if (stream == NULL) {
+    log_warning(jit, compilation)("Profile cache: cannot open %s", ProfileCacheFile);
+    return;
+  }
+
+  ResourceMark rm;
+  const size_t buffer_length = 4 * K;
+  char* line = NEW_RESOURCE_ARRAY(char, buffer_length);
+  char* name = NEW_RESOURCE_ARRAY(char, buffer_length);
+  char* signature = NEW_RESOURCE_ARRAY(char, buffer_length);
+
+  if (fgets(line, (int)buffer_length, stream) == NULL ||
+      strncmp(line, profile_cache_header, strlen(profile_cache_header)) != 0) {
+    log_warning(jit, compilation)("Profile cache: %s is not a profile cache file", ProfileCacheFile);
+    fclose(stream);
+    return;
+  }
+
+  _methods = new (ResourceObj::C_HEAP, mtCompiler) ProfileCacheMethodTable();
+  ProfileCacheClass* holder = NULL;
+  int line_no = 1;
+  int num_methods = 0;
+  while (fgets(line, (int)buffer_length, stream) != NULL) {
+    line_no++;
+    juint crc;
+    int level;
+    if (sscanf(line, "class %4095s %u", name, &crc) == 2) {
+      holder = new ProfileCacheClass(SymbolTable::new_symbol(name), crc);
+    } else if (sscanf(line, "method %4095s %4095s %d", name, signature, &level) == 3) {
+      if (holder == NULL || level <= CompLevel_none || level > CompLevel_full_optimization) {
+        log_warning(jit, compilation)("Profile cache: %s:%d: invalid method record", ProfileCacheFile, line_no);
+        continue;
+      }
+      ProfileCacheMethodKey key(holder->_name, SymbolTable::new_symbol(name), SymbolTable::new_symbol(signature));
+      _methods->put(key, ProfileCacheMethod(holder, level));
+      num_methods++;
+    } else if (line[0] != '#' && line[0] != '\n') {
+      log_warning(jit, compilation)("Profile cache: %s:%d: unrecognized record", ProfileCacheFile, line_no);
+    }
+  }
+  fclose(stream);
+
+  _is_loaded = true;
+  log_info(jit, compilation)("Profile cache: loaded %d methods from %s", num_methods, ProfileCacheFile);
+}
+
+class ProfileCacheDumpClosure : public KlassClosure {
+  outputStream* _st;
+  int           _num_methods;
+
+ public:
+  ProfileCacheDumpClosure(outputStream* st) : _st(st), _num_methods(0) {}
+
+  int num_methods() const { return _num_methods; }
+
+  void do_klass(Klass* k) {
+    if (!k->is_instance_klass()) {
+      return;
+    }
+    InstanceKlass* ik = InstanceKlass::cast(k);
+    juint crc;
+    if (!ik->is_linked() || !lookup_observed_crc(ik->name(), &crc)) {
+      return;
+    }
+    ResourceMark rm;
+    bool printed_class = false;
+    Array<Method*>* methods = ik->methods();
+    for (int i = 0; i < methods->length(); i++) {
+      Method* m = methods->at(i);
+      if (m->method_counters() == NULL) {
+        continue;
+      }
+      int level = MAX2(m->highest_comp_level(), m->highest_osr_comp_level());
+      if (level <= CompLevel_none) {
+        continue;
+      }
+      if (!printed_class) {
+        _st->print_cr("class %s %u", ik->name()->as_C_string(), crc);
+        printed_class = true;
+      }
+      // The counts are informational, only the level is replayed.
+      _st->print_cr("method %s %s %d %d %d", m->name()->as_C_string(), m->signature()->as_C_string(),
+                    level, m->invocation_count(), m->backedge_count());
+      _num_methods++;
+    }
+  }
+};
+
+void ProfileCache::dump() {
+  if (DumpProfileCacheFile == NULL) {
+    return;
+  }
+  fileStream fs(DumpProfileCacheFile, "w");
+  if (!fs.is_open()) {
+    log_warning(jit, compilation)("Profile cache: cannot open %s", DumpProfileCacheFile);
+    return;
+  }
+  fs.print_cr("%s", profile_cache_header);
+
+  ProfileCacheDumpClosure cl(&fs);
+  {
+    MutexLocker ml(ClassLoaderDataGraph_lock);
+    ClassLoaderDataGraph::loaded_classes_do(&cl);
+  }
+  log_info(jit, compilation)("Profile cache: dumped %d methods to %s", cl.num_methods(), DumpProfileCacheFile);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_COMPILER_PROFILECACHE_HPP
+#define SHARE_COMPILER_PROFILECACHE_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+#include "utilities/exceptions.hpp"
+
+class ClassFileStream;
+class InstanceKlass;
+class Method;
+
+// ProfileCache carries tiered warmup state from one run to the next.
+//
+// With -XX:DumpProfileCacheFile=<file> the highest tier reached and the
+// invocation and backedge counts of every compiled method are written at
+// VM exit. With -XX:ProfileCacheFile=<file> a later run reads them back
+// and scales the compile thresholds of the recorded methods by
+// ProfileCacheThresholdScaling, up to the recorded tier, so they reach
+// their steady state compilation level after a much shorter warmup.
+//
+// Records are keyed by class name, method name and signature. A class is
+// only trusted if the CRC32 of its class file matches the one recorded at
+// dump time; classes that are not parsed from a class file (CDS archived
+// and hidden classes) are neither dumped nor replayed.
+class ProfileCache : AllStatic {
+ private:
+  static bool _is_loaded;
+
+ public:
+  static bool is_recording() {
+    return ProfileCacheFile != NULL || DumpProfileCacheFile != NULL;
+  }
+  static bool is_loaded() { return _is_loaded; }
+
+  // Read ProfileCacheFile.
+  static void load();
+  // Write DumpProfileCacheFile.
+  static void dump();
+
+  // Remember the class file CRC of a newly parsed class.
+  static void record_class_file(InstanceKlass* ik, const ClassFileStream* stream);
+
+  // Threshold scaling to apply to the method when it is compiled at a level
+  // above cur_level; 1.0 if the method is not in the cache.
+  static double threshold_scaling(const Method* method, int cur_level);
+};
+
+#endif // SHARE_COMPILER_PROFILECACHE_HPP
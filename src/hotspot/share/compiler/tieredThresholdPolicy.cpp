@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/profileCache.hpp"
 #include "compiler/tieredThresholdPolicy.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/arguments.hpp"
@@ -48,6 +49,7 @@ bool TieredThresholdPolicy::call_predicate_helper(const methodHandle& method, Co
   if (CompilerOracle::has_option_value(method, "CompileThresholdScaling", threshold_scaling)) {
     scale *= threshold_scaling;
   }
+  scale *= ProfileCache::threshold_scaling(method(), cur_level);
   switch(cur_level) {
   case CompLevel_aot:
     if (CompilationModeFlag::disable_intermediate()) {
@@ -79,6 +81,7 @@ bool TieredThresholdPolicy::loop_predicate_helper(const methodHandle& method, Co
   if (CompilerOracle::has_option_value(method, "CompileThresholdScaling", threshold_scaling)) {
     scale *= threshold_scaling;
   }
+  scale *= ProfileCache::threshold_scaling(method(), cur_level);
   switch(cur_level) {
   case CompLevel_aot:
     if (CompilationModeFlag::disable_intermediate()) {
@@ -399,8 +402,11 @@ CompileTask* TieredThresholdPolicy::select_task(CompileQueue* compile_queue) {
   CompileTask *max_task = NULL;
   Method* max_method = NULL;
   jlong t = nanos_to_millis(os::javaTimeNanos());
+  // Blocking tasks are always preferred. They are kept at the front of the
+  // queue, so if there are any only that segment needs to be scanned.
+  CompileTask* end = compile_queue->has_blocking() ? compile_queue->first_non_blocking() : NULL;
   // Iterate through the queue and find a method with a maximum rate.
-  for (CompileTask* task = compile_queue->first(); task != NULL;) {
+  for (CompileTask* task = compile_queue->first(); task != end;) {
     CompileTask* next_task = task->next();
     Method* method = task->method();
     // If a method was unloaded or has been stale for some time, remove it from the queue.
@@ -622,7 +628,12 @@ void TieredThresholdPolicy::update_rate(jlong t, Method* m) {
     if (delta_t >= TieredRateUpdateMinTime && delta_e > 0) {
       m->set_prev_time(t);
       m->set_prev_event_count(event_count);
-      m->set_rate((float)delta_e / (float)delta_t); // Rate is events per millisecond
+      float rate = (float)delta_e / (float)delta_t; // Rate is events per millisecond
+      if (TieredPayoffSelection) {
+        // Exponentially decay the previous samples
+        rate = (rate + m->rate()) / 2;
+      }
+      m->set_rate(rate);
     } else {
       if (delta_t > TieredRateUpdateMaxTime && delta_e == 0) {
         // If nothing happened for 25ms, zero the rate. Don't modify prev values.
@@ -653,6 +664,12 @@ bool TieredThresholdPolicy::is_old(Method* method) {
 }
 
 double TieredThresholdPolicy::weight(Method* method) {
+  if (TieredPayoffSelection) {
+    // Expected payoff of the compilation over its estimated cost. The cost
+    // is counted in units of a small inlineable method (35 bytecodes).
+    double cost = 1.0 + (double)method->code_size() / 35;
+    return (double)(method->rate() + 1) / cost;
+  }
   return (double)(method->rate() + 1) *
     (method->invocation_count() + 1) * (method->backedge_count() + 1);
 }
@@ -856,11 +873,24 @@ void TieredThresholdPolicy::create_mdo(const methodHandle& mh, JavaThread* THREA
  *    or because of a deopt that didn't require reprofiling (compilation won't happen in this case because
  *    the compiled version already exists).
  *
+ * f. AOT -> 4.
+ *    AOT code counts invocations and backedges in the MethodCounters. If Tier4AOTInvocationThreshold
+ *    or Tier4AOTBackEdgeThreshold is set and crossed, the method is compiled by C2 right away instead
+ *    of being reprofiled at level 3.
+ *
  * Note that since state 0 can be reached from any other state via deoptimization different loops
  * are possible.
  *
  */
 
+bool TieredThresholdPolicy::aot_should_skip_profiling(Predicate p, int i, int b) {
+  double k = threshold_scale(CompLevel_full_optimization, Tier4LoadFeedback);
+  if (p == &TieredThresholdPolicy::loop_predicate) {
+    return Tier4AOTBackEdgeThreshold > 0 && b >= Tier4AOTBackEdgeThreshold * k;
+  }
+  return Tier4AOTInvocationThreshold > 0 && i >= Tier4AOTInvocationThreshold * k;
+}
+
 // Common transition function. Given a predicate determines if a method should transition to another level.
 CompLevel TieredThresholdPolicy::common(Predicate p, const methodHandle& method, CompLevel cur_level, bool disable_feedback) {
   CompLevel next_level = cur_level;
@@ -886,6 +916,8 @@ CompLevel TieredThresholdPolicy::common(Predicate p, const methodHandle& method,
           // If we were at full profile level, would we switch to full opt?
           if (common(p, method, CompLevel_full_profile, disable_feedback) == CompLevel_full_optimization) {
             next_level = CompLevel_full_optimization;
+          } else if (aot_should_skip_profiling(p, i, b)) {
+            next_level = CompLevel_full_optimization;
           } else if (disable_feedback || (CompileBroker::queue_size(CompLevel_full_optimization) <=
                                           Tier3DelayOff * compiler_count(CompLevel_full_optimization) &&
                                          (this->*p)(i, b, cur_level, method))) {
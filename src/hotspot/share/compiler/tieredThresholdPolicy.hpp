@@ -160,6 +160,12 @@ class CompileQueue;
  * - TieredRateUpdateMinTime and TieredRateUpdateMaxTime are parameters of the rate computation.
  *   Basically, the rate is not computed more frequently than TieredRateUpdateMinTime and is considered
  *   to be zero if no events occurred in TieredRateUpdateMaxTime.
+ *
+ * - TieredPayoffSelection changes the priority used by select_task(). Instead of weighting the rate by
+ *   the total invocation and backedge counts, which favors methods that were hot during startup
+ *   long after they went cold, the rate is smoothed across samples (so it decays rather than jumps)
+ *   and divided by a compilation cost estimate that grows with the bytecode size of the method, as
+ *   large methods also tend to bring in large inline trees.
  */
 
 class TieredThresholdPolicy : public CompilationPolicy {
@@ -184,6 +190,8 @@ class TieredThresholdPolicy : public CompilationPolicy {
   bool loop_predicate(int i, int b, CompLevel cur_level, const methodHandle& method);
   // Common transition function. Given a predicate determines if a method should transition to another level.
   CompLevel common(Predicate p, const methodHandle& method, CompLevel cur_level, bool disable_feedback = false);
+  // Is AOT code hot enough to go to tier 4 without profiling at tier 3?
+  bool aot_should_skip_profiling(Predicate p, int i, int b);
   // Transition functions.
   // call_event determines if a method should be compiled at a different
   // level with a regular invocation entry.
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/epsilon/epsilonArenaDCmd.hpp"
+#include "gc/epsilon/epsilonHeap.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/vmOperations.hpp"
+#include "runtime/vmThread.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+
+class VM_EpsilonArena : public VM_Operation {
+  const bool _begin;
+  bool _success;
+  bool _referenced;
+  size_t _released;
+public:
+  VM_EpsilonArena(bool begin) : _begin(begin), _success(false), _referenced(false), _released(0) {}
+
+  VMOp_Type type() const { return VMOp_EpsilonArena; }
+
+  void doit() {
+    EpsilonHeap* heap = EpsilonHeap::heap();
+    if (_begin) {
+      _success = heap->begin_arena();
+    } else if (heap->num_arenas() > 0) {
+      _success = heap->release_arena(&_released);
+      _referenced = !_success;
+    }
+  }
+
+  bool success() const    { return _success; }
+  bool referenced() const { return _referenced; }
+  size_t released() const { return _released; }
+};
+
+EpsilonArenaDCmd::EpsilonArenaDCmd(outputStream* output, bool heap)
+  : DCmdWithParser(output, heap)
+  , _action("action", "\"begin\" to start a new arena, \"release\" to release the innermost arena.",
+            "STRING", true)
+{
+  _dcmdparser.add_dcmd_argument(&_action);
+}
+
+int EpsilonArenaDCmd::num_arguments() {
+  ResourceMark rm;
+  EpsilonArenaDCmd* dcmd = new EpsilonArenaDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+void EpsilonArenaDCmd::execute(DCmdSource source, TRAPS) {
+  if (!EpsilonArenas) {
+    output()->print_cr("Epsilon arenas are not enabled, use -XX:+EpsilonArenas.");
+    return;
+  }
+
+  const char* action = _action.value();
+  bool begin;
+  if (strcmp(action, "begin") == 0) {
+    begin = true;
+  } else if (strcmp(action, "release") == 0) {
+    begin = false;
+  } else {
+    output()->print_cr("Unknown action \"%s\", expected \"begin\" or \"release\".", action);
+    return;
+  }
+
+  VM_EpsilonArena op(begin);
+  VMThread::execute(&op);
+
+  if (begin) {
+    if (op.success()) {
+      output()->print_cr("Arena %u started.", EpsilonHeap::heap()->num_arenas());
+    } else {
+      output()->print_cr("Too many active arenas.");
+    }
+  } else {
+    if (op.success()) {
+      output()->print_cr("Arena released, " SIZE_FORMAT "%s freed.",
+                         byte_size_in_proper_unit(op.released()), proper_unit_for_byte_size(op.released()));
+    } else if (op.referenced()) {
+      output()->print_cr("Arena not released, it is still referenced from outside, see -Xlog:gc.");
+    } else {
+      output()->print_cr("No active arena.");
+    }
+  }
+}
@@ -23,18 +23,30 @@
  */
 
 #include "precompiled.hpp"
+#include "aot/aotLoader.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "code/codeCache.hpp"
 #include "gc/epsilon/epsilonHeap.hpp"
 #include "gc/epsilon/epsilonInitLogger.hpp"
 #include "gc/epsilon/epsilonMemoryPool.hpp"
 #include "gc/epsilon/epsilonThreadLocalData.hpp"
 #include "gc/shared/gcArguments.hpp"
 #include "gc/shared/locationPrinter.inline.hpp"
+#include "gc/shared/oopStorageSet.inline.hpp"
+#include "gc/shared/spaceDecorator.hpp"
+#include "gc/shared/weakProcessor.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/iterator.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "runtime/atomic.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/oop.inline.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/synchronizer.hpp"
+#include "runtime/thread.hpp"
 
 jint EpsilonHeap::initialize() {
   size_t align = HeapAlignment;
@@ -277,6 +289,152 @@ void EpsilonHeap::object_iterate(ObjectClosure *cl) {
   _space->object_iterate(cl);
 }
 
+bool EpsilonHeap::begin_arena() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at safepoint");
+  assert(EpsilonArenas, "Arenas should be enabled");
+
+  if (_num_arenas == MaxArenas) {
+    return false;
+  }
+
+  // Retire all TLABs, so that all allocations from now on happen above
+  // the bottom of the new arena.
+  ensure_parsability(true);
+
+  HeapWord* bottom = _space->top();
+  _arena_bottoms[_num_arenas++] = bottom;
+  log_info(gc)("Arena %u started at " PTR_FORMAT, _num_arenas, p2i(bottom));
+  return true;
+}
+
+// Finds references into the arena [bottom, top) from outside of it, that is
+// from roots or from objects below the arena.
+class EpsilonArenaReferenceClosure : public BasicOopIterateClosure {
+  HeapWord* const _bottom;
+  HeapWord* const _top;
+  const void* _referrer;
+  size_t _count;
+
+  template <class T>
+  void do_oop_work(T* p) {
+    oop obj = RawAccess<>::oop_load(p);
+    HeapWord* addr = cast_from_oop<HeapWord*>(obj);
+    if (addr >= _bottom && addr < _top) {
+      if (_count < 10) {
+        log_info(gc)("Arena referenced at " PTR_FORMAT " from %s " PTR_FORMAT ": " PTR_FORMAT,
+                     p2i(p), _referrer != NULL ? "object" : "root", p2i(_referrer), p2i(addr));
+      }
+      _count++;
+    }
+  }
+
+public:
+  EpsilonArenaReferenceClosure(HeapWord* bottom, HeapWord* top) :
+    _bottom(bottom), _top(top), _referrer(NULL), _count(0) {}
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+
+  void set_referrer(const void* referrer) { _referrer = referrer; }
+  size_t count() const { return _count; }
+};
+
+class EpsilonBelowArenaObjectClosure : public ObjectClosure {
+  HeapWord* const _bottom;
+  EpsilonArenaReferenceClosure* const _cl;
+public:
+  EpsilonBelowArenaObjectClosure(HeapWord* bottom, EpsilonArenaReferenceClosure* cl) :
+    _bottom(bottom), _cl(cl) {}
+
+  virtual void do_object(oop obj) {
+    if (cast_from_oop<HeapWord*>(obj) < _bottom) {
+      _cl->set_referrer(obj);
+      obj->oop_iterate(_cl);
+    }
+  }
+};
+
+// Returns the number of strong references into [bottom, top) from roots
+// and from objects below bottom.
+size_t EpsilonHeap::count_references_into(HeapWord* bottom, HeapWord* top) {
+  EpsilonArenaReferenceClosure cl(bottom, top);
+
+  // Roots
+  CLDToOopClosure cld_cl(&cl, ClassLoaderData::_claim_none);
+  ClassLoaderDataGraph::cld_do(&cld_cl);
+  Threads::oops_do(&cl, NULL);
+  ObjectSynchronizer::oops_do(&cl);
+  OopStorageSet::strong_oops_do(&cl);
+  AOTLoader::oops_do(&cl);
+  CodeBlobToOopClosure blobs_cl(&cl, false /* fix_relocations */);
+  CodeCache::blobs_do(&blobs_cl);
+
+  // The rest of the heap
+  EpsilonBelowArenaObjectClosure objects_cl(bottom, &cl);
+  _space->object_iterate(&objects_cl);
+
+  return cl.count();
+}
+
+// Objects below the bottom of the arena being released are considered alive.
+class EpsilonIsBelowArenaClosure : public BoolObjectClosure {
+  HeapWord* const _bottom;
+public:
+  EpsilonIsBelowArenaClosure(HeapWord* bottom) : _bottom(bottom) {}
+
+  virtual bool do_object_b(oop obj) {
+    return cast_from_oop<HeapWord*>(obj) < _bottom;
+  }
+};
+
+bool EpsilonHeap::release_arena(size_t* released_bytes) {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at safepoint");
+  assert(EpsilonArenas, "Arenas should be enabled");
+  assert(_num_arenas > 0, "No arena to release");
+
+  // TLABs may extend into the arena.
+  ensure_parsability(true);
+
+  HeapWord* bottom = _arena_bottoms[_num_arenas - 1];
+  HeapWord* top = _space->top();
+  assert(bottom <= top, "Arena bottom " PTR_FORMAT " above top " PTR_FORMAT, p2i(bottom), p2i(top));
+
+  // The VM itself keeps strong references, e.g. to mirrors or to resolved
+  // constant pool strings created while the arena was active. Refuse to
+  // release the arena while anything outside of it still refers to it.
+  size_t references = count_references_into(bottom, top);
+  if (references > 0) {
+    log_info(gc)("Arena %u not released, referenced " SIZE_FORMAT " times from outside",
+                 _num_arenas, references);
+    return false;
+  }
+  _num_arenas--;
+
+  // The VM still holds weak references, e.g. from the string table; clear
+  // the ones into the arena, so that they are not handed out after the
+  // memory is reused.
+  EpsilonIsBelowArenaClosure is_alive(bottom);
+  DoNothingClosure keep_alive;
+  WeakProcessor::weak_oops_do(&is_alive, &keep_alive);
+
+  _space->set_top(bottom);
+  if (ZapUnusedHeapArea) {
+    SpaceMangler::mangle_region(MemRegion(bottom, top));
+  }
+
+  size_t used = _space->used();
+  Atomic::store(&_last_counter_update, used);
+  Atomic::store(&_last_heap_print, used);
+  _monitoring_support->update_counters();
+
+  size_t released = pointer_delta(top, bottom, 1);
+  log_info(gc)("Arena %u released: " SIZE_FORMAT "%s", _num_arenas + 1,
+               byte_size_in_proper_unit(released), proper_unit_for_byte_size(released));
+  print_heap_info(used);
+  *released_bytes = released;
+  return true;
+}
+
 void EpsilonHeap::print_on(outputStream *st) const {
   st->print_cr("Epsilon Heap");
 
@@ -288,6 +446,11 @@ void EpsilonHeap::print_on(outputStream *st) const {
     _space->print_on(st);
   }
 
+  for (uint i = 0; i < _num_arenas; i++) {
+    st->print_cr("Arena %u: [" PTR_FORMAT ", " PTR_FORMAT ")", i + 1, p2i(_arena_bottoms[i]),
+                 p2i(i + 1 < _num_arenas ? _arena_bottoms[i + 1] : _space->top()));
+  }
+
   MetaspaceUtils::print_on(st);
 }
 
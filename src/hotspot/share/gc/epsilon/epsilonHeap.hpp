@@ -48,12 +48,19 @@ private:
   volatile size_t _last_counter_update;
   volatile size_t _last_heap_print;
 
+  // Arenas are nested ranges at the top of the heap that are released in bulk,
+  // see EpsilonArenas. Each entry is the heap top at the start of the arena.
+  static const uint MaxArenas = 16;
+  HeapWord* _arena_bottoms[MaxArenas];
+  uint _num_arenas;
+
 public:
   static EpsilonHeap* heap();
 
   EpsilonHeap() :
           _memory_manager("Epsilon Heap", ""),
-          _space(NULL) {};
+          _space(NULL),
+          _num_arenas(0) {};
 
   virtual Name kind() const {
     return CollectedHeap::Epsilon;
@@ -107,6 +114,15 @@ public:
   // Heap walking support
   virtual void object_iterate(ObjectClosure* cl);
 
+  // Arena support, must be called at a safepoint.
+  // Starts a new arena at the current heap top. Returns false if too many
+  // arenas are active.
+  bool begin_arena();
+  // Releases the innermost arena and returns true, unless anything outside
+  // the arena still references it.
+  bool release_arena(size_t* released_bytes);
+  uint num_arenas() const { return _num_arenas; }
+
   // Object pinning support: every object is implicitly pinned
   virtual bool supports_object_pinning() const           { return true; }
   virtual oop pin_object(JavaThread* thread, oop obj)    { return obj; }
@@ -139,6 +155,7 @@ public:
 private:
   void print_heap_info(size_t used) const;
   void print_metaspace_info() const;
+  size_t count_references_into(HeapWord* bottom, HeapWord* top);
 
 };
 
@@ -86,7 +86,13 @@
   product(size_t, EpsilonMinHeapExpand, 128 * M, EXPERIMENTAL,              \
           "Min expansion step for heap. Larger value improves performance " \
           "at the potential expense of memory waste.")                      \
-          range(1, max_intx)
+          range(1, max_intx)                                                \
+                                                                            \
+  product(bool, EpsilonArenas, false, EXPERIMENTAL,                         \
+          "Allow the heap to be released in bulk down to the start of an "  \
+          "arena with the GC.epsilon_arena diagnostic command. The "        \
+          "release is refused while anything outside the arena still "      \
+          "references objects allocated in it.")
 
 // end of GC_EPSILON_FLAGS
 
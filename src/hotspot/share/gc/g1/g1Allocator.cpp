@@ -33,6 +33,7 @@
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionSet.inline.hpp"
 #include "gc/g1/heapRegionType.hpp"
+#include "logging/log.hpp"
 #include "utilities/align.hpp"
 
 G1Allocator::G1Allocator(G1CollectedHeap* heap) :
@@ -43,16 +44,21 @@ G1Allocator::G1Allocator(G1CollectedHeap* heap) :
   _num_alloc_regions(_numa->num_active_nodes()),
   _mutator_alloc_regions(NULL),
   _survivor_gc_alloc_regions(NULL),
-  _old_gc_alloc_region(heap->alloc_buffer_stats(G1HeapRegionAttr::Old)),
-  _retained_old_gc_alloc_region(NULL) {
+  _old_gc_alloc_regions(NULL),
+  _retained_old_gc_alloc_regions(NULL) {
 
   _mutator_alloc_regions = NEW_C_HEAP_ARRAY(MutatorAllocRegion, _num_alloc_regions, mtGC);
   _survivor_gc_alloc_regions = NEW_C_HEAP_ARRAY(SurvivorGCAllocRegion, _num_alloc_regions, mtGC);
+  _old_gc_alloc_regions = NEW_C_HEAP_ARRAY(OldGCAllocRegion, _num_alloc_regions, mtGC);
+  _retained_old_gc_alloc_regions = NEW_C_HEAP_ARRAY(HeapRegion*, _num_alloc_regions, mtGC);
   G1EvacStats* stat = heap->alloc_buffer_stats(G1HeapRegionAttr::Young);
+  G1EvacStats* old_stat = heap->alloc_buffer_stats(G1HeapRegionAttr::Old);
 
   for (uint i = 0; i < _num_alloc_regions; i++) {
     ::new(_mutator_alloc_regions + i) MutatorAllocRegion(i);
     ::new(_survivor_gc_alloc_regions + i) SurvivorGCAllocRegion(stat, i);
+    ::new(_old_gc_alloc_regions + i) OldGCAllocRegion(old_stat, i);
+    _retained_old_gc_alloc_regions[i] = NULL;
   }
 }
 
@@ -60,9 +66,12 @@ G1Allocator::~G1Allocator() {
   for (uint i = 0; i < _num_alloc_regions; i++) {
     _mutator_alloc_regions[i].~MutatorAllocRegion();
     _survivor_gc_alloc_regions[i].~SurvivorGCAllocRegion();
+    _old_gc_alloc_regions[i].~OldGCAllocRegion();
   }
   FREE_C_HEAP_ARRAY(MutatorAllocRegion, _mutator_alloc_regions);
   FREE_C_HEAP_ARRAY(SurvivorGCAllocRegion, _survivor_gc_alloc_regions);
+  FREE_C_HEAP_ARRAY(OldGCAllocRegion, _old_gc_alloc_regions);
+  FREE_C_HEAP_ARRAY(HeapRegion*, _retained_old_gc_alloc_regions);
 }
 
 #ifdef ASSERT
@@ -87,7 +96,12 @@ void G1Allocator::release_mutator_alloc_regions() {
 }
 
 bool G1Allocator::is_retained_old_region(HeapRegion* hr) {
-  return _retained_old_gc_alloc_region == hr;
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    if (_retained_old_gc_alloc_regions[i] == hr) {
+      return true;
+    }
+  }
+  return false;
 }
 
 void G1Allocator::reuse_retained_old_region(G1EvacuationInfo& evacuation_info,
@@ -119,7 +133,8 @@ void G1Allocator::reuse_retained_old_region(G1EvacuationInfo& evacuation_info,
     _g1h->old_set_remove(retained_region);
     old->set(retained_region);
     _g1h->hr_printer()->reuse(retained_region);
-    evacuation_info.set_alloc_regions_used_before(retained_region->used());
+    evacuation_info.set_alloc_regions_used_before(evacuation_info.alloc_regions_used_before() +
+                                                  retained_region->used());
   }
 }
 
@@ -133,35 +148,38 @@ void G1Allocator::init_gc_alloc_regions(G1EvacuationInfo& evacuation_info) {
     survivor_gc_alloc_region(i)->init();
   }
 
-  _old_gc_alloc_region.init();
-  reuse_retained_old_region(evacuation_info,
-                            &_old_gc_alloc_region,
-                            &_retained_old_gc_alloc_region);
+  evacuation_info.set_alloc_regions_used_before(0);
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    old_gc_alloc_region(i)->init();
+    reuse_retained_old_region(evacuation_info,
+                              old_gc_alloc_region(i),
+                              &_retained_old_gc_alloc_regions[i]);
+  }
 }
 
 void G1Allocator::release_gc_alloc_regions(G1EvacuationInfo& evacuation_info) {
-  uint survivor_region_count = 0;
+  uint region_count = 0;
   for (uint node_index = 0; node_index < _num_alloc_regions; node_index++) {
-    survivor_region_count += survivor_gc_alloc_region(node_index)->count();
+    region_count += survivor_gc_alloc_region(node_index)->count();
     survivor_gc_alloc_region(node_index)->release();
   }
-  evacuation_info.set_allocation_regions(survivor_region_count +
-                                         old_gc_alloc_region()->count());
-
-  // If we have an old GC alloc region to release, we'll save it in
-  // _retained_old_gc_alloc_region. If we don't
-  // _retained_old_gc_alloc_region will become NULL. This is what we
-  // want either way so no reason to check explicitly for either
-  // condition.
-  _retained_old_gc_alloc_region = old_gc_alloc_region()->release();
+  for (uint node_index = 0; node_index < _num_alloc_regions; node_index++) {
+    region_count += old_gc_alloc_region(node_index)->count();
+    // If we have an old GC alloc region to release, we'll save it in
+    // _retained_old_gc_alloc_regions. If we don't the entry will become
+    // NULL. This is what we want either way so no reason to check
+    // explicitly for either condition.
+    _retained_old_gc_alloc_regions[node_index] = old_gc_alloc_region(node_index)->release();
+  }
+  evacuation_info.set_allocation_regions(region_count);
 }
 
 void G1Allocator::abandon_gc_alloc_regions() {
   for (uint i = 0; i < _num_alloc_regions; i++) {
     assert(survivor_gc_alloc_region(i)->get() == NULL, "pre-condition");
+    assert(old_gc_alloc_region(i)->get() == NULL, "pre-condition");
+    _retained_old_gc_alloc_regions[i] = NULL;
   }
-  assert(old_gc_alloc_region()->get() == NULL, "pre-condition");
-  _retained_old_gc_alloc_region = NULL;
 }
 
 bool G1Allocator::survivor_is_full() const {
@@ -228,7 +246,7 @@ HeapWord* G1Allocator::par_allocate_during_gc(G1HeapRegionAttr dest,
     case G1HeapRegionAttr::Young:
       return survivor_attempt_allocation(min_word_size, desired_word_size, actual_word_size, node_index);
     case G1HeapRegionAttr::Old:
-      return old_attempt_allocation(min_word_size, desired_word_size, actual_word_size);
+      return old_attempt_allocation(min_word_size, desired_word_size, actual_word_size, node_index);
     default:
       ShouldNotReachHere();
       return NULL; // Keep some compilers happy
@@ -262,18 +280,19 @@ HeapWord* G1Allocator::survivor_attempt_allocation(size_t min_word_size,
 
 HeapWord* G1Allocator::old_attempt_allocation(size_t min_word_size,
                                               size_t desired_word_size,
-                                              size_t* actual_word_size) {
+                                              size_t* actual_word_size,
+                                              uint node_index) {
   assert(!_g1h->is_humongous(desired_word_size),
          "we should not be seeing humongous-size allocations in this path");
 
-  HeapWord* result = old_gc_alloc_region()->attempt_allocation(min_word_size,
-                                                               desired_word_size,
-                                                               actual_word_size);
+  HeapWord* result = old_gc_alloc_region(node_index)->attempt_allocation(min_word_size,
+                                                                         desired_word_size,
+                                                                         actual_word_size);
   if (result == NULL && !old_is_full()) {
     MutexLocker x(FreeList_lock, Mutex::_no_safepoint_check_flag);
-    result = old_gc_alloc_region()->attempt_allocation_locked(min_word_size,
-                                                              desired_word_size,
-                                                              actual_word_size);
+    result = old_gc_alloc_region(node_index)->attempt_allocation_locked(min_word_size,
+                                                                        desired_word_size,
+                                                                        actual_word_size);
     if (result == NULL) {
       set_old_full();
     }
@@ -297,12 +316,25 @@ G1PLABAllocator::G1PLABAllocator(G1Allocator* allocator) :
   _g1h(G1CollectedHeap::heap()),
   _allocator(allocator),
   _survivor_alignment_bytes(calc_survivor_alignment_bytes()) {
+  if (ResizePLAB) {
+    // See G1EvacStats::compute_desired_plab_sz for why this is the expected
+    // number of refills per thread. Pad it a bit, as the limits on PLAB size
+    // and region boundaries cause some extra refills anyway.
+    double const expected_refills = G1LastPLABAverageOccupancy / TargetPLABWastePct;
+    _tolerated_refills = (size_t)(MAX2(expected_refills, 1.0) * 1.5);
+  } else {
+    _tolerated_refills = SIZE_MAX;
+  }
   for (region_type_t state = 0; state < G1HeapRegionAttr::Num; state++) {
     _direct_allocated[state] = 0;
+    _num_plab_fills[state] = 0;
+    _num_direct_allocations[state] = 0;
+    _cur_desired_plab_size[state] = _g1h->desired_plab_sz(state);
+    _plab_fill_counter[state] = _tolerated_refills;
     uint length = alloc_buffers_length(state);
     _alloc_buffers[state] = NEW_C_HEAP_ARRAY(PLAB*, length, mtGC);
     for (uint node_index = 0; node_index < length; node_index++) {
-      _alloc_buffers[state][node_index] = new PLAB(_g1h->desired_plab_sz(state));
+      _alloc_buffers[state][node_index] = new PLAB(_cur_desired_plab_size[state]);
     }
   }
 }
@@ -321,11 +353,28 @@ bool G1PLABAllocator::may_throw_away_buffer(size_t const allocation_word_sz, siz
   return (allocation_word_sz * 100 < buffer_size * ParallelGCBufferWastePct);
 }
 
+void G1PLABAllocator::note_plab_refill(region_type_t dest) {
+  _num_plab_fills[dest]++;
+  if (_plab_fill_counter[dest] > 0) {
+    _plab_fill_counter[dest]--;
+    return;
+  }
+  _plab_fill_counter[dest] = _tolerated_refills;
+  // PLAB::max_size() is below the humongous object threshold.
+  size_t const new_size = MIN2(_cur_desired_plab_size[dest] * 2, PLAB::max_size());
+  if (new_size > _cur_desired_plab_size[dest]) {
+    log_trace(gc, plab)("%s PLAB size increased to " SIZE_FORMAT "B after " SIZE_FORMAT " refills",
+                        dest == G1HeapRegionAttr::Old ? "Old" : "Young",
+                        new_size * HeapWordSize, _num_plab_fills[dest]);
+    _cur_desired_plab_size[dest] = new_size;
+  }
+}
+
 HeapWord* G1PLABAllocator::allocate_direct_or_new_plab(G1HeapRegionAttr dest,
                                                        size_t word_sz,
                                                        bool* plab_refill_failed,
                                                        uint node_index) {
-  size_t plab_word_size = _g1h->desired_plab_sz(dest);
+  size_t plab_word_size = _cur_desired_plab_size[dest.type()];
   size_t required_in_plab = PLAB::size_required_for_allocation(word_sz);
 
   // Only get a new PLAB if the allocation fits and it would not waste more than
@@ -335,6 +384,7 @@ HeapWord* G1PLABAllocator::allocate_direct_or_new_plab(G1HeapRegionAttr dest,
 
     PLAB* alloc_buf = alloc_buffer(dest, node_index);
     alloc_buf->retire();
+    note_plab_refill(dest.type());
 
     size_t actual_plab_size = 0;
     HeapWord* buf = _allocator->par_allocate_during_gc(dest,
@@ -363,6 +413,7 @@ HeapWord* G1PLABAllocator::allocate_direct_or_new_plab(G1HeapRegionAttr dest,
   HeapWord* result = _allocator->par_allocate_during_gc(dest, word_sz, node_index);
   if (result != NULL) {
     _direct_allocated[dest.type()] += word_sz;
+    _num_direct_allocations[dest.type()]++;
   }
   return result;
 }
@@ -381,7 +432,11 @@ void G1PLABAllocator::flush_and_retire_stats() {
       }
     }
     stats->add_direct_allocated(_direct_allocated[state]);
+    stats->add_num_plab_filled(_num_plab_fills[state]);
+    stats->add_num_direct_allocated(_num_direct_allocations[state]);
     _direct_allocated[state] = 0;
+    _num_plab_fills[state] = 0;
+    _num_direct_allocations[state] = 0;
   }
 }
 
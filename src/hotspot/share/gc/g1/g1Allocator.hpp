@@ -57,10 +57,11 @@ private:
   SurvivorGCAllocRegion* _survivor_gc_alloc_regions;
 
   // Alloc region used to satisfy allocation requests by the GC for
-  // old objects.
-  OldGCAllocRegion _old_gc_alloc_region;
+  // old objects, one per memory node.
+  OldGCAllocRegion* _old_gc_alloc_regions;
 
-  HeapRegion* _retained_old_gc_alloc_region;
+  // Old GC alloc regions retained across GCs, one per memory node.
+  HeapRegion** _retained_old_gc_alloc_regions;
 
   bool survivor_is_full() const;
   bool old_is_full() const;
@@ -75,7 +76,7 @@ private:
   // Accessors to the allocation regions.
   inline MutatorAllocRegion* mutator_alloc_region(uint node_index);
   inline SurvivorGCAllocRegion* survivor_gc_alloc_region(uint node_index);
-  inline OldGCAllocRegion* old_gc_alloc_region();
+  inline OldGCAllocRegion* old_gc_alloc_region(uint node_index);
 
   // Allocation attempt during GC for a survivor object / PLAB.
   HeapWord* survivor_attempt_allocation(size_t min_word_size,
@@ -86,7 +87,8 @@ private:
   // Allocation attempt during GC for an old object / PLAB.
   HeapWord* old_attempt_allocation(size_t min_word_size,
                                    size_t desired_word_size,
-                                   size_t* actual_word_size);
+                                   size_t* actual_word_size,
+                                   uint node_index);
 
   // Node index of current thread.
   inline uint current_node_index() const;
@@ -158,6 +160,21 @@ private:
 
   // Number of words allocated directly (not counting PLAB allocation).
   size_t _direct_allocated[G1HeapRegionAttr::Num];
+  // Number of PLAB refills and direct allocations so far.
+  size_t _num_plab_fills[G1HeapRegionAttr::Num];
+  size_t _num_direct_allocations[G1HeapRegionAttr::Num];
+
+  // The PLAB size used for refills. It starts out as the desired PLAB size
+  // for this GC, and is doubled whenever this thread refilled its PLAB
+  // _tolerated_refills times, so that a burst of promotion that was not
+  // anticipated by the PLAB statistics does not make all threads go to the
+  // shared allocation regions for every few objects.
+  size_t _cur_desired_plab_size[G1HeapRegionAttr::Num];
+  // Number of PLAB refills left until the next increase of the PLAB size.
+  size_t _plab_fill_counter[G1HeapRegionAttr::Num];
+  size_t _tolerated_refills;
+
+  void note_plab_refill(region_type_t dest);
 
   void flush_and_retire_stats();
   inline PLAB* alloc_buffer(G1HeapRegionAttr dest, uint node_index) const;
@@ -44,8 +44,9 @@ inline SurvivorGCAllocRegion* G1Allocator::survivor_gc_alloc_region(uint node_in
   return &_survivor_gc_alloc_regions[node_index];
 }
 
-inline OldGCAllocRegion* G1Allocator::old_gc_alloc_region() {
-  return &_old_gc_alloc_region;
+inline OldGCAllocRegion* G1Allocator::old_gc_alloc_region(uint node_index) {
+  assert(node_index < _num_alloc_regions, "Invalid index: %u", node_index);
+  return &_old_gc_alloc_regions[node_index];
 }
 
 inline HeapWord* G1Allocator::attempt_allocation(size_t min_word_size,
@@ -84,17 +85,13 @@ inline PLAB* G1PLABAllocator::alloc_buffer(region_type_t dest, uint node_index)
   assert(dest < G1HeapRegionAttr::Num,
          "Allocation buffer index out of bounds: %u", dest);
 
-  if (dest == G1HeapRegionAttr::Young) {
-    assert(node_index < alloc_buffers_length(dest),
-           "Allocation buffer index out of bounds: %u, %u", dest, node_index);
-    return _alloc_buffers[dest][node_index];
-  } else {
-    return _alloc_buffers[dest][0];
-  }
+  assert(node_index < alloc_buffers_length(dest),
+         "Allocation buffer index out of bounds: %u, %u", dest, node_index);
+  return _alloc_buffers[dest][node_index];
 }
 
 inline uint G1PLABAllocator::alloc_buffers_length(region_type_t dest) const {
-  if (dest == G1HeapRegionAttr::Young) {
+  if (dest == G1HeapRegionAttr::Young || dest == G1HeapRegionAttr::Old) {
     return _allocator->num_nodes();
   } else {
     return 1;
@@ -403,6 +403,27 @@ void G1BlockOffsetTablePart::zero_bottom_entry_raw() {
   _bot->set_offset_array_raw(bottom_index, 0);
 }
 
+void G1BlockOffsetTablePart::update_for_block(HeapWord* blk_start, HeapWord* blk_end) {
+  size_t index = _bot->index_for(blk_start);
+  HeapWord* threshold = _bot->address_for_index(index);
+  if (threshold != blk_start) {
+    index++;
+    threshold += BOTConstants::N_words;
+  }
+  if (blk_end > threshold) {
+    alloc_block_work(&threshold, &index, blk_start, blk_end);
+  }
+}
+
+void G1BlockOffsetTablePart::set_threshold_at(HeapWord* addr) {
+  _next_offset_index = _bot->index_for_raw(addr);
+  _next_offset_threshold = _bot->address_for_index_raw(_next_offset_index);
+  if (_next_offset_threshold != addr) {
+    _next_offset_index++;
+    _next_offset_threshold += BOTConstants::N_words;
+  }
+}
+
 HeapWord* G1BlockOffsetTablePart::initialize_threshold() {
   _next_offset_index = _bot->index_for(_hr->bottom());
   _next_offset_index++;
@@ -104,6 +104,10 @@ public:
   inline HeapWord* address_for_index_raw(size_t index) const {
     return _reserved.start() + (index << BOTConstants::LogN_words);
   }
+
+  // Prefetch the offset array entry for the given index in preparation of a
+  // block start lookup for the corresponding card.
+  inline void prefetch_entry(size_t index) const;
 };
 
 class G1BlockOffsetTablePart {
@@ -223,6 +227,14 @@ public:
     alloc_block(blk, blk+size);
   }
 
+  // Record the block [blk_start, blk_end) without consulting or advancing the
+  // threshold. Updates of non-overlapping blocks touch disjoint entries, so
+  // they may be done in parallel; callers must call set_threshold_at() when
+  // done.
+  void update_for_block(HeapWord* blk_start, HeapWord* blk_end);
+  // Set the threshold to the first boundary at or after "addr".
+  void set_threshold_at(HeapWord* addr);
+
   void set_for_starts_humongous(HeapWord* obj_top, size_t fill_size);
   void set_object_can_span(bool can_span) NOT_DEBUG_RETURN;
 
@@ -29,6 +29,7 @@
 #include "gc/g1/heapRegion.hpp"
 #include "gc/shared/memset_with_concurrent_readers.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/prefetch.inline.hpp"
 
 inline HeapWord* G1BlockOffsetTablePart::block_start(const void* addr) {
   if (addr >= _hr->bottom() && addr < _hr->end()) {
@@ -54,6 +55,11 @@ u_char G1BlockOffsetTable::offset_array(size_t index) const {
   return Atomic::load(&_offset_array[index]);
 }
 
+void G1BlockOffsetTable::prefetch_entry(size_t index) const {
+  check_index(index, "index out of range");
+  Prefetch::read((void*)&_offset_array[index], 0);
+}
+
 void G1BlockOffsetTable::set_offset_array_raw(size_t index, u_char offset) {
   Atomic::store(&_offset_array[index], offset);
 }
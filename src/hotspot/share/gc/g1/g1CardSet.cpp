@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CardSet.inline.hpp"
+#include "gc/g1/heapRegion.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+
+// Percentage of the cards of a region set in a bitmap container at which
+// it is coarsened to a full container.
+static const uint G1CardSetFullThresholdPercent = 50;
+
+// Hash tables start small, most card sets contain only a few regions.
+static const uint G1CardSetInitialTableSizeLog = 2;
+
+uint G1CardSet::_inline_capacity = 0;
+uint G1CardSet::_inline_card_bits = 0;
+uint G1CardSet::_array_capacity = 0;
+uint G1CardSet::_max_bitmaps = 0;
+size_t G1CardSet::_full_threshold = 0;
+
+jint G1CardSet::_n_coarsenings = 0;
+
+void G1CardSetStats::add(const G1CardSetStats& other) {
+  _num_inline += other._num_inline;
+  _num_array += other._num_array;
+  _num_bitmap += other._num_bitmap;
+  _num_full += other._num_full;
+  _array_mem_size += other._array_mem_size;
+  _bitmap_mem_size += other._bitmap_mem_size;
+}
+
+void G1CardSetStats::print_on(outputStream* out) const {
+  out->print_cr("    Containers: inline " SIZE_FORMAT ", array " SIZE_FORMAT " (" SIZE_FORMAT "%s), "
+                "bitmap " SIZE_FORMAT " (" SIZE_FORMAT "%s), full " SIZE_FORMAT ".",
+                _num_inline,
+                _num_array, byte_size_in_proper_unit(_array_mem_size), proper_unit_for_byte_size(_array_mem_size),
+                _num_bitmap, byte_size_in_proper_unit(_bitmap_mem_size), proper_unit_for_byte_size(_bitmap_mem_size),
+                _num_full);
+}
+
+void G1CardSet::initialize() {
+  assert(HeapRegion::CardsPerRegion > 0, "region size must have been set up");
+  assert(HeapRegion::CardsPerRegion <= (size_t)max_jushort + 1, "card indices must fit into CardElem");
+
+  _inline_card_bits = (uint)HeapRegion::LogCardsPerRegion;
+  _inline_capacity = MIN2((uint)((BitsPerWord - InlineCardsShift) / _inline_card_bits), InlineMaxCards);
+
+  _array_capacity = (uint)MIN2((size_t)G1RSetSparseRegionEntries, HeapRegion::CardsPerRegion);
+  _array_capacity = MAX2(_array_capacity, _inline_capacity + 1);
+
+  _max_bitmaps = (uint)G1RSetRegionEntries;
+
+  _full_threshold = HeapRegion::CardsPerRegion * G1CardSetFullThresholdPercent / 100;
+  _full_threshold = MAX2(_full_threshold, (size_t)_array_capacity + 1);
+}
+
+G1CardSet::G1CardSet(Mutex* m) :
+  _m(m),
+  _table(NULL),
+  _num_entries(0),
+  _num_bitmaps(0),
+  _num_occupied(0),
+  _retired_containers(0),
+  _retired_tables(NULL) {
+}
+
+G1CardSet::~G1CardSet() {
+  clear();
+}
+
+G1CardSet::AddResult G1CardSet::inline_add(ContainerPtr volatile* slot, ContainerPtr container, CardElem card) {
+  while (true) {
+    uint num_cards = inline_num_cards(container);
+    for (uint i = 0; i < num_cards; i++) {
+      if (inline_card_at(container, i) == card) {
+        return Found;
+      }
+    }
+    if (num_cards == _inline_capacity) {
+      return Overflow;
+    }
+    ContainerPtr new_container = (container + ((ContainerPtr)1 << InlineNumCardsShift)) |
+                                 ((ContainerPtr)card << (InlineCardsShift + num_cards * _inline_card_bits));
+    ContainerPtr old = Atomic::cmpxchg(slot, container, new_container);
+    if (old == container) {
+      return Added;
+    }
+    if (container_type(old) != ContainerInline) {
+      // Replaced by a larger container concurrently.
+      return Overflow;
+    }
+    container = old;
+  }
+}
+
+G1CardSet::Entry* G1CardSet::find_entry(uint region_idx) const {
+  HashTable* table = Atomic::load_acquire(&_table);
+  if (table == NULL) {
+    return NULL;
+  }
+  Entry* entry = Atomic::load_acquire(table->bucket_addr(region_idx));
+  while (entry != NULL && entry->_region_idx != region_idx) {
+    entry = Atomic::load_acquire(&entry->_next);
+  }
+  return entry;
+}
+
+G1CardSet::Entry* G1CardSet::find_or_create_entry(uint region_idx) {
+  Entry* entry = find_entry(region_idx);
+  if (entry != NULL) {
+    return entry;
+  }
+
+  MutexLocker x(_m, Mutex::_no_safepoint_check_flag);
+  // Confirm that it's really not there...
+  entry = find_entry(region_idx);
+  if (entry != NULL) {
+    return entry;
+  }
+
+  HashTable* table = _table;
+  if (table == NULL) {
+    table = HashTable::create(G1CardSetInitialTableSizeLog);
+    Atomic::release_store(&_table, table);
+  } else if (_num_entries >= table->size()) {
+    grow_table_locked();
+    table = _table;
+  }
+
+  Entry* volatile* bucket = table->bucket_addr(region_idx);
+  entry = new Entry(region_idx, *bucket);
+  // Publish the completely initialized entry to concurrent readers.
+  Atomic::release_store(bucket, entry);
+  _num_entries++;
+  return entry;
+}
+
+// Moves all entries into a table of twice the size. Concurrent readers of the
+// old table may fail to find entries while they are moved, which is all right
+// because failing lookups are retried with the lock held. The old table is
+// retired, as readers may still access it.
+void G1CardSet::grow_table_locked() {
+  assert(_m->owned_by_self(), "Precondition");
+  HashTable* old_table = _table;
+  HashTable* new_table = HashTable::create(old_table->_size_log + 1);
+
+  for (uint i = 0; i < old_table->size(); i++) {
+    Entry* entry = old_table->_buckets[i];
+    while (entry != NULL) {
+      Entry* next = entry->_next;
+      Entry* volatile* bucket = new_table->bucket_addr(entry->_region_idx);
+      Atomic::release_store(&entry->_next, *bucket);
+      *bucket = entry;
+      entry = next;
+    }
+  }
+
+  Atomic::release_store(&_table, new_table);
+
+  old_table->_next_retired = _retired_tables;
+  _retired_tables = old_table;
+}
+
+void G1CardSet::retire_container(ContainerPtr container) {
+  ContainerPtr volatile* next_addr;
+  switch (container_type(container)) {
+    case ContainerArray:
+      next_addr = &container_ptr<ArrayContainer>(container)->_next_retired;
+      break;
+    case ContainerBitMap:
+      next_addr = &container_ptr<BitMapContainer>(container)->_next_retired;
+      break;
+    default:
+      // Inline and full containers take no memory.
+      return;
+  }
+  ContainerPtr head = Atomic::load(&_retired_containers);
+  while (true) {
+    *next_addr = head;
+    ContainerPtr old = Atomic::cmpxchg(&_retired_containers, head, container);
+    if (old == head) {
+      return;
+    }
+    head = old;
+  }
+}
+
+void G1CardSet::free_container(ContainerPtr container) {
+  switch (container_type(container)) {
+    case ContainerArray:
+      ArrayContainer::destroy(container_ptr<ArrayContainer>(container));
+      break;
+    case ContainerBitMap:
+      delete container_ptr<BitMapContainer>(container);
+      break;
+    default:
+      break;
+  }
+}
+
+size_t G1CardSet::container_mem_size(ContainerPtr container) {
+  switch (container_type(container)) {
+    case ContainerArray:
+      return container_ptr<ArrayContainer>(container)->mem_size();
+    case ContainerBitMap:
+      return container_ptr<BitMapContainer>(container)->mem_size();
+    default:
+      return 0;
+  }
+}
+
+bool G1CardSet::container_contains(ContainerPtr container, CardElem card) {
+  switch (container_type(container)) {
+    case ContainerInline: {
+      uint num_cards = inline_num_cards(container);
+      for (uint i = 0; i < num_cards; i++) {
+        if (inline_card_at(container, i) == card) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case ContainerArray:
+      return container_ptr<ArrayContainer>(container)->contains(card);
+    case ContainerBitMap:
+      return container_ptr<BitMapContainer>(container)->contains(card);
+    default:
+      return true;
+  }
+}
+
+bool G1CardSet::coarsen_to_full(Entry* entry, ContainerPtr container, size_t num_cards) {
+  if (Atomic::cmpxchg(&entry->_container, container, FullCardSet) != container) {
+    return false;
+  }
+  if (container_type(container) == ContainerBitMap) {
+    Atomic::dec(&_num_bitmaps);
+  }
+  retire_container(container);
+  Atomic::add(&_num_occupied, HeapRegion::CardsPerRegion - num_cards, memory_order_relaxed);
+  Atomic::inc(&_n_coarsenings);
+  return true;
+}
+
+bool G1CardSet::coarsen_container(Entry* entry, ContainerPtr container, CardElem card) {
+  if (Atomic::load_acquire(&entry->_container) != container) {
+    // Somebody else replaced the container already.
+    return false;
+  }
+
+  switch (container_type(container)) {
+    case ContainerInline: {
+      ArrayContainer* array = ArrayContainer::create(_array_capacity);
+      uint num_cards = inline_num_cards(container);
+      for (uint i = 0; i < num_cards; i++) {
+        array->add_unsynchronized(inline_card_at(container, i));
+      }
+      array->add_unsynchronized(card);
+      ContainerPtr new_container = make_container_ptr(array, ContainerArray);
+      if (Atomic::cmpxchg(&entry->_container, container, new_container) != container) {
+        // Lost the race, nobody else could have seen the array.
+        ArrayContainer::destroy(array);
+        return false;
+      }
+      Atomic::inc(&_num_occupied, memory_order_relaxed);
+      return true;
+    }
+    case ContainerArray: {
+      ArrayContainer* array = container_ptr<ArrayContainer>(container);
+      if (!array->try_freeze()) {
+        // Wait for the thread that froze the array to install its replacement.
+        while (Atomic::load_acquire(&entry->_container) == container) {
+          SpinPause();
+        }
+        return false;
+      }
+      // We own the array now, nobody else can add to it any more.
+      uint num_cards = array->num_entries();
+      if (Atomic::add(&_num_bitmaps, 1u) <= _max_bitmaps) {
+        BitMapContainer* bitmap = new BitMapContainer(HeapRegion::CardsPerRegion);
+        for (uint i = 0; i < num_cards; i++) {
+          bitmap->bm()->set_bit(array->at(i));
+        }
+        bitmap->bm()->set_bit(card);
+        bitmap->_num_bits_set = num_cards + 1;
+        Atomic::release_store(&entry->_container, make_container_ptr(bitmap, ContainerBitMap));
+        retire_container(container);
+        Atomic::inc(&_num_occupied, memory_order_relaxed);
+      } else {
+        // Too many bitmaps; cover the whole region instead.
+        Atomic::dec(&_num_bitmaps);
+        coarsen_to_full(entry, container, num_cards);
+      }
+      return true;
+    }
+    default:
+      ShouldNotReachHere();
+      return false;
+  }
+}
+
+bool G1CardSet::add_card(uint region_idx, CardElem card) {
+  assert(card < HeapRegion::CardsPerRegion, "card index %u out of bounds", card);
+  Entry* entry = find_or_create_entry(region_idx);
+
+  while (true) {
+    ContainerPtr container = Atomic::load_acquire(&entry->_container);
+    AddResult result;
+    switch (container_type(container)) {
+      case ContainerInline:
+        result = inline_add(&entry->_container, container, card);
+        break;
+      case ContainerArray:
+        result = container_ptr<ArrayContainer>(container)->add(card);
+        break;
+      case ContainerBitMap: {
+        size_t num_cards = 0;
+        result = container_ptr<BitMapContainer>(container)->add(card, &num_cards);
+        if (result == Added && num_cards >= _full_threshold) {
+          // Concurrent adders may all see counts at or above the threshold,
+          // and a bitmap may start out at the threshold already. The first
+          // one to install the full container wins; cards added by the others
+          // are covered by it.
+          coarsen_to_full(entry, container, num_cards - 1);
+          return true;
+        }
+        break;
+      }
+      default:
+        // Full container.
+        return false;
+    }
+
+    if (result == Added) {
+      Atomic::inc(&_num_occupied, memory_order_relaxed);
+      return true;
+    } else if (result == Found) {
+      return false;
+    }
+
+    if (coarsen_container(entry, container, card)) {
+      return true;
+    }
+  }
+}
+
+bool G1CardSet::contains_card(uint region_idx, CardElem card) const {
+  Entry* entry = find_entry(region_idx);
+  if (entry == NULL) {
+    MutexLocker x(_m, Mutex::_no_safepoint_check_flag);
+    entry = find_entry(region_idx);
+    if (entry == NULL) {
+      return false;
+    }
+  }
+  return container_contains(Atomic::load_acquire(&entry->_container), card);
+}
+
+size_t G1CardSet::mem_size() const {
+  size_t sum = sizeof(G1CardSet);
+  HashTable* table = Atomic::load_acquire(&_table);
+  if (table != NULL) {
+    sum += table->mem_size();
+    for (uint i = 0; i < table->size(); i++) {
+      for (Entry* entry = table->_buckets[i]; entry != NULL; entry = entry->_next) {
+        sum += sizeof(Entry) + container_mem_size(Atomic::load_acquire(&entry->_container));
+      }
+    }
+  }
+  for (HashTable* cur = _retired_tables; cur != NULL; cur = cur->_next_retired) {
+    sum += cur->mem_size();
+  }
+  ContainerPtr cur = Atomic::load(&_retired_containers);
+  while (cur != 0) {
+    sum += container_mem_size(cur);
+    cur = container_type(cur) == ContainerArray ? container_ptr<ArrayContainer>(cur)->_next_retired
+                                                : container_ptr<BitMapContainer>(cur)->_next_retired;
+  }
+  return sum;
+}
+
+void G1CardSet::collect_stats(G1CardSetStats* stats) const {
+  HashTable* table = Atomic::load_acquire(&_table);
+  if (table == NULL) {
+    return;
+  }
+  for (uint i = 0; i < table->size(); i++) {
+    for (Entry* entry = table->_buckets[i]; entry != NULL; entry = entry->_next) {
+      ContainerPtr container = Atomic::load_acquire(&entry->_container);
+      switch (container_type(container)) {
+        case ContainerInline:
+          stats->_num_inline++;
+          break;
+        case ContainerArray:
+          stats->_num_array++;
+          stats->_array_mem_size += container_mem_size(container);
+          break;
+        case ContainerBitMap:
+          stats->_num_bitmap++;
+          stats->_bitmap_mem_size += container_mem_size(container);
+          break;
+        default:
+          stats->_num_full++;
+          break;
+      }
+    }
+  }
+}
+
+void G1CardSet::clear() {
+  HashTable* table = _table;
+  if (table != NULL) {
+    for (uint i = 0; i < table->size(); i++) {
+      Entry* entry = table->_buckets[i];
+      while (entry != NULL) {
+        Entry* next = entry->_next;
+        free_container(entry->_container);
+        delete entry;
+        entry = next;
+      }
+    }
+    HashTable::destroy(table);
+    _table = NULL;
+  }
+
+  while (_retired_tables != NULL) {
+    HashTable* next = _retired_tables->_next_retired;
+    HashTable::destroy(_retired_tables);
+    _retired_tables = next;
+  }
+
+  ContainerPtr cur = _retired_containers;
+  while (cur != 0) {
+    ContainerPtr next = container_type(cur) == ContainerArray ? container_ptr<ArrayContainer>(cur)->_next_retired
+                                                              : container_ptr<BitMapContainer>(cur)->_next_retired;
+    free_container(cur);
+    cur = next;
+  }
+  _retired_containers = 0;
+
+  _num_entries = 0;
+  _num_bitmaps = 0;
+  _num_occupied = 0;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_GC_G1_G1CARDSET_HPP
+#define SHARE_GC_G1_G1CARDSET_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/bitMap.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class Mutex;
+class outputStream;
+
+// Statistics about the containers used by one or more G1CardSets.
+class G1CardSetStats {
+public:
+  size_t _num_inline;
+  size_t _num_array;
+  size_t _num_bitmap;
+  size_t _num_full;
+
+  size_t _array_mem_size;
+  size_t _bitmap_mem_size;
+
+  G1CardSetStats() :
+    _num_inline(0),
+    _num_array(0),
+    _num_bitmap(0),
+    _num_full(0),
+    _array_mem_size(0),
+    _bitmap_mem_size(0) { }
+
+  void add(const G1CardSetStats& other);
+  void print_on(outputStream* out) const;
+};
+
+// The set of cards of other ("from") regions that may contain references
+// into the owning region.
+//
+// Cards are grouped by the region they are located in. For every such
+// region the card set keeps a single container whose representation
+// adapts to the number of cards it holds:
+//
+// - Inline: up to a handful of card indices packed directly into the
+//   container slot, without any additional memory.
+// - Array: an array of up to G1RSetSparseRegionEntries card indices.
+// - BitMap: one bit per card of the region; only G1RSetRegionEntries of
+//   these may exist per card set at the same time.
+// - Full: the whole region may contain references and must be scanned.
+//   This takes no memory either.
+//
+// Containers only ever grow towards Full. The containers are referenced
+// by tagged pointers, whose lowest two bits give the container type.
+//
+// Adding cards to existing containers is lock-free. Only the creation of
+// new per-region entries, and the growth of the entry hash table that
+// results from it, take the given mutex. Readers may find entries without
+// locking; a failing lookup must be retried with the lock held. As
+// concurrent adders may still access containers that have been replaced by
+// a larger one, replaced containers and hash tables are only freed when
+// the card set is cleared, which happens at a safepoint or while the
+// owning remembered set is not tracked.
+class G1CardSet {
+public:
+  // The maximum region size limits card indices within a region to 16 bits.
+  typedef uint16_t CardElem;
+
+  enum AddResult {
+    Overflow, // The container can not hold the card; a larger one is needed.
+    Found,    // The card is already in the container.
+    Added     // The card has been added to the container.
+  };
+
+private:
+  typedef uintptr_t ContainerPtr;
+
+  static const uintptr_t ContainerInline = 0x0;
+  static const uintptr_t ContainerArray  = 0x1;
+  static const uintptr_t ContainerBitMap = 0x2;
+  static const uintptr_t ContainerFull   = 0x3;
+  static const uintptr_t ContainerTypeMask = 0x3;
+
+  static const ContainerPtr FullCardSet = ContainerFull;
+
+  // Inline containers keep the number of cards above the tag bits, followed
+  // by the card indices.
+  static const uint InlineNumCardsShift = 2;
+  static const uint InlineNumCardsBits = 3;
+  static const uint InlineCardsShift = InlineNumCardsShift + InlineNumCardsBits;
+  static const uint InlineMaxCards = (1u << InlineNumCardsBits) - 1;
+
+  class ArrayContainer;
+  class BitMapContainer;
+  class HashTable;
+  struct Entry;
+
+  static uint _inline_capacity;
+  static uint _inline_card_bits;
+  static uint _array_capacity;
+  static uint _max_bitmaps;
+  static size_t _full_threshold;
+
+  static jint _n_coarsenings;
+
+  Mutex* _m;
+
+  HashTable* volatile _table;
+  uint _num_entries;
+
+  // Number of bitmap containers currently installed.
+  volatile uint _num_bitmaps;
+
+  size_t volatile _num_occupied;
+
+  // Replaced containers and hash tables, freed on clear().
+  ContainerPtr volatile _retired_containers;
+  HashTable* volatile _retired_tables;
+
+  static uintptr_t container_type(ContainerPtr container) {
+    return container & ContainerTypeMask;
+  }
+
+  template <class T>
+  static T* container_ptr(ContainerPtr container) {
+    return (T*)(container & ~ContainerTypeMask);
+  }
+
+  static ContainerPtr make_container_ptr(void* container, uintptr_t type) {
+    assert(((uintptr_t)container & ContainerTypeMask) == 0, "must be aligned");
+    return (ContainerPtr)container | type;
+  }
+
+  // Inline containers.
+  static inline uint inline_num_cards(ContainerPtr container);
+  static inline CardElem inline_card_at(ContainerPtr container, uint i);
+  static AddResult inline_add(ContainerPtr volatile* slot, ContainerPtr container, CardElem card);
+
+  static inline uint region_hash(uint region_idx, uint size_log);
+
+  Entry* find_entry(uint region_idx) const;
+  Entry* find_or_create_entry(uint region_idx);
+  void grow_table_locked();
+
+  // Replace the container in the entry's slot by a container with more
+  // capacity containing all cards of the old one and the given card.
+  // Returns false if some other thread replaced the container first.
+  bool coarsen_container(Entry* entry, ContainerPtr container, CardElem card);
+  // Replaces the given container, holding num_cards cards, with the full
+  // container. Returns false if some other thread replaced it first.
+  bool coarsen_to_full(Entry* entry, ContainerPtr container, size_t num_cards);
+  void retire_container(ContainerPtr container);
+  static void free_container(ContainerPtr container);
+  static size_t container_mem_size(ContainerPtr container);
+
+  static bool container_contains(ContainerPtr container, CardElem card);
+
+public:
+  G1CardSet(Mutex* m);
+  ~G1CardSet();
+
+  // Sets up sizing of containers. Must be called after region size has
+  // been determined.
+  static void initialize();
+
+  // Adds the given card of the given region. Returns whether the card has
+  // been newly added.
+  bool add_card(uint region_idx, CardElem card);
+
+  bool contains_card(uint region_idx, CardElem card) const;
+
+  // Returns the number of cards contained in this card set.
+  size_t occupied() const { return Atomic::load(&_num_occupied); }
+  bool is_empty() const { return occupied() == 0; }
+
+  static jint n_coarsenings() { return _n_coarsenings; }
+
+  // Returns size of the card set data structures in bytes.
+  size_t mem_size() const;
+
+  void collect_stats(G1CardSetStats* stats) const;
+
+  // Clear the entire contents of this card set.
+  void clear();
+
+  // Calls one of the following methods of the given closure for every region
+  // represented in this card set:
+  //
+  // next_full(uint region_idx) - all cards of the region are in the set.
+  // next_bitmap(uint region_idx, BitMap* bm) - the set bits of the bitmap
+  //   give the cards.
+  // next_cards(uint region_idx, const CardElem* cards, uint num_cards) - the
+  //   cards are listed in the given array.
+  template <class Closure>
+  inline void iterate_for_merge(Closure& cl);
+};
+
+#endif // SHARE_GC_G1_G1CARDSET_HPP
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_GC_G1_G1CARDSET_INLINE_HPP
+#define SHARE_GC_G1_G1CARDSET_INLINE_HPP
+
+#include "gc/g1/g1CardSet.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
+#include "utilities/bitMap.inline.hpp"
+
+// Array of up to a fixed number of cards. Adders reserve the next free slot
+// by setting the lock bit in _num_entries, so that readers only ever see
+// completely written entries. A frozen array does not accept additions any
+// more; it is about to be replaced by a larger container.
+class G1CardSet::ArrayContainer {
+  friend class G1CardSet;
+
+  static const uint LockBit   = 1u << 31;
+  static const uint FrozenBit = 1u << 30;
+  static const uint NumMask   = FrozenBit - 1;
+
+  ContainerPtr _next_retired;
+  volatile uint _num_entries;
+  uint const _capacity;
+  CardElem _data[1];
+
+  ArrayContainer(uint capacity) :
+    _next_retired(0),
+    _num_entries(0),
+    _capacity(capacity) { }
+
+public:
+  static size_t size_in_bytes(uint capacity) {
+    return sizeof(ArrayContainer) + (capacity - 1) * sizeof(CardElem);
+  }
+
+  static ArrayContainer* create(uint capacity) {
+    void* mem = AllocateHeap(size_in_bytes(capacity), mtGC);
+    return ::new (mem) ArrayContainer(capacity);
+  }
+
+  static void destroy(ArrayContainer* array) {
+    FreeHeap(array);
+  }
+
+  size_t mem_size() const { return size_in_bytes(_capacity); }
+
+  uint num_entries() const { return Atomic::load_acquire(&_num_entries) & NumMask; }
+  CardElem at(uint i) const { return _data[i]; }
+
+  // Only for arrays not yet visible to other threads.
+  void add_unsynchronized(CardElem card) {
+    assert(_num_entries < _capacity, "must have room");
+    _data[_num_entries++] = card;
+  }
+
+  inline AddResult add(CardElem card);
+  inline bool contains(CardElem card) const;
+
+  // Prevents any further additions. Returns false if some other thread
+  // froze this array already.
+  inline bool try_freeze();
+};
+
+// Bitmap with one bit per card of the region.
+class G1CardSet::BitMapContainer : public CHeapObj<mtGC> {
+  friend class G1CardSet;
+
+  ContainerPtr _next_retired;
+  size_t volatile _num_bits_set;
+  CHeapBitMap _bm;
+
+public:
+  BitMapContainer(size_t num_cards) :
+    _next_retired(0),
+    _num_bits_set(0),
+    _bm(num_cards, mtGC) { }
+
+  size_t mem_size() const { return sizeof(BitMapContainer) + _bm.size_in_words() * HeapWordSize; }
+
+  BitMap* bm() { return &_bm; }
+  size_t num_bits_set() const { return Atomic::load(&_num_bits_set); }
+
+  // Adds the card, and returns the number of cards in the bitmap after
+  // adding it in num_cards.
+  AddResult add(CardElem card, size_t* num_cards) {
+    if (_bm.par_set_bit(card)) {
+      *num_cards = Atomic::add(&_num_bits_set, (size_t)1, memory_order_relaxed);
+      return Added;
+    }
+    return Found;
+  }
+
+  bool contains(CardElem card) const { return _bm.at(card); }
+};
+
+struct G1CardSet::Entry : public CHeapObj<mtGC> {
+  uint const _region_idx;
+  ContainerPtr volatile _container;
+  Entry* volatile _next;
+
+  Entry(uint region_idx, Entry* next) :
+    _region_idx(region_idx),
+    _container(ContainerInline),
+    _next(next) { }
+};
+
+// Open hash table of Entries, keyed by region index.
+class G1CardSet::HashTable {
+  friend class G1CardSet;
+
+  HashTable* _next_retired;
+  uint const _size_log;
+  Entry* volatile _buckets[1];
+
+  HashTable(uint size_log) : _next_retired(NULL), _size_log(size_log) {
+    for (uint i = 0; i < size(); i++) {
+      _buckets[i] = NULL;
+    }
+  }
+
+public:
+  static size_t size_in_bytes(uint size_log) {
+    return sizeof(HashTable) + ((1u << size_log) - 1) * sizeof(Entry*);
+  }
+
+  static HashTable* create(uint size_log) {
+    void* mem = AllocateHeap(size_in_bytes(size_log), mtGC);
+    return ::new (mem) HashTable(size_log);
+  }
+
+  static void destroy(HashTable* table) {
+    FreeHeap(table);
+  }
+
+  uint size() const { return 1u << _size_log; }
+  size_t mem_size() const { return size_in_bytes(_size_log); }
+
+  Entry* volatile* bucket_addr(uint region_idx) {
+    return &_buckets[region_hash(region_idx, _size_log)];
+  }
+};
+
+inline G1CardSet::AddResult G1CardSet::ArrayContainer::add(CardElem card) {
+  uint num = Atomic::load_acquire(&_num_entries);
+  uint checked = 0;
+  while (true) {
+    if ((num & FrozenBit) != 0) {
+      return Overflow;
+    }
+    if ((num & LockBit) != 0) {
+      SpinPause();
+      num = Atomic::load_acquire(&_num_entries);
+      continue;
+    }
+    for (; checked < num; checked++) {
+      if (_data[checked] == card) {
+        return Found;
+      }
+    }
+    if (num == _capacity) {
+      return Overflow;
+    }
+    uint old = Atomic::cmpxchg(&_num_entries, num, num | LockBit);
+    if (old == num) {
+      _data[num] = card;
+      Atomic::release_store(&_num_entries, num + 1);
+      return Added;
+    }
+    num = old;
+  }
+}
+
+inline bool G1CardSet::ArrayContainer::contains(CardElem card) const {
+  uint num = num_entries();
+  for (uint i = 0; i < num; i++) {
+    if (_data[i] == card) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool G1CardSet::ArrayContainer::try_freeze() {
+  uint num = Atomic::load_acquire(&_num_entries);
+  while (true) {
+    if ((num & FrozenBit) != 0) {
+      return false;
+    }
+    if ((num & LockBit) != 0) {
+      SpinPause();
+      num = Atomic::load_acquire(&_num_entries);
+      continue;
+    }
+    uint old = Atomic::cmpxchg(&_num_entries, num, num | FrozenBit);
+    if (old == num) {
+      return true;
+    }
+    num = old;
+  }
+}
+
+inline uint G1CardSet::inline_num_cards(ContainerPtr container) {
+  assert(container_type(container) == ContainerInline, "must be");
+  return (uint)((container >> InlineNumCardsShift) & InlineMaxCards);
+}
+
+inline G1CardSet::CardElem G1CardSet::inline_card_at(ContainerPtr container, uint i) {
+  assert(i < inline_num_cards(container), "out of bounds");
+  return (CardElem)((container >> (InlineCardsShift + i * _inline_card_bits)) & right_n_bits(_inline_card_bits));
+}
+
+inline uint G1CardSet::region_hash(uint region_idx, uint size_log) {
+  return region_idx & ((1u << size_log) - 1);
+}
+
+template <class Closure>
+inline void G1CardSet::iterate_for_merge(Closure& cl) {
+  HashTable* table = Atomic::load_acquire(&_table);
+  if (table == NULL) {
+    return;
+  }
+  for (uint i = 0; i < table->size(); i++) {
+    for (Entry* entry = table->_buckets[i]; entry != NULL; entry = entry->_next) {
+      ContainerPtr container = Atomic::load_acquire(&entry->_container);
+      switch (container_type(container)) {
+        case ContainerInline: {
+          CardElem cards[InlineMaxCards];
+          uint num_cards = inline_num_cards(container);
+          for (uint j = 0; j < num_cards; j++) {
+            cards[j] = inline_card_at(container, j);
+          }
+          if (num_cards > 0) {
+            cl.next_cards(entry->_region_idx, cards, num_cards);
+          }
+          break;
+        }
+        case ContainerArray: {
+          ArrayContainer* array = container_ptr<ArrayContainer>(container);
+          cl.next_cards(entry->_region_idx, array->_data, array->num_entries());
+          break;
+        }
+        case ContainerBitMap: {
+          cl.next_bitmap(entry->_region_idx, container_ptr<BitMapContainer>(container)->bm());
+          break;
+        }
+        default: {
+          cl.next_full(entry->_region_idx);
+          break;
+        }
+      }
+    }
+  }
+}
+
+#endif // SHARE_GC_G1_G1CARDSET_INLINE_HPP
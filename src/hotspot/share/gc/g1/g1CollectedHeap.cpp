@@ -1033,6 +1033,12 @@ void G1CollectedHeap::prepare_heap_for_mutators() {
   hrm()->prepare_for_full_collection_end();
 
   // Delete metaspaces for unloaded class loaders and clean up loader_data graph
+  if (DeferClassUnloadingPurge &&
+      !GCCause::is_metadata_allocation_failure_gc(gc_cause())) {
+    // The ServiceThread deletes the unloaded class loaders after the pause.
+    // A failed metadata allocation needs the space back before it retries.
+    ClassLoaderDataGraph::defer_purge();
+  }
   ClassLoaderDataGraph::purge(/*at_safepoint*/true);
   MetaspaceUtils::verify_metrics();
 
@@ -1336,6 +1342,44 @@ void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
   }
 }
 
+size_t G1CollectedHeap::concurrent_uncommit_amount() {
+  MutexLocker ml(Heap_lock);
+  return _heap_sizing_policy->concurrent_uncommit_amount();
+}
+
+uint G1CollectedHeap::uncommit_free_regions(size_t max_bytes) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "must not be at a safepoint");
+
+  // Holding the Heap_lock keeps out pauses and mutators looking for new regions.
+  MutexLocker ml(Heap_lock);
+
+  // Concurrent marking and bitmap clearing access the auxiliary data of all
+  // committed regions, so let the cycle finish first. A new cycle can not
+  // start while we hold the Heap_lock.
+  if (_cm_thread->during_cycle()) {
+    return 0;
+  }
+  // The heterogeneous heap manages its committed regions per memory type.
+  if (is_heterogeneous_heap()) {
+    return 0;
+  }
+
+  size_t uncommit_bytes = MIN2(max_bytes, _heap_sizing_policy->concurrent_uncommit_amount());
+  uint num_regions_to_remove = (uint)(uncommit_bytes / HeapRegion::GrainBytes);
+  if (num_regions_to_remove == 0) {
+    return 0;
+  }
+
+  uint num_regions_removed = _hrm->uncommit_free_regions(num_regions_to_remove);
+  if (num_regions_removed > 0) {
+    policy()->record_new_heap_size(num_regions());
+    g1mm()->update_sizes();
+  }
+  log_debug(gc, ergo, heap)("Concurrent uncommit. requested: %u regions uncommitted: %u regions capacity: " SIZE_FORMAT "B",
+                            num_regions_to_remove, num_regions_removed, capacity());
+  return num_regions_removed;
+}
+
 void G1CollectedHeap::shrink(size_t shrink_bytes) {
   _verifier->verify_region_sets_optional();
 
@@ -1718,9 +1762,14 @@ jint G1CollectedHeap::initialize() {
   _cm_thread = _cm->cm_thread();
 
   // Now expand into the initial heap size.
-  if (!expand(init_byte_size, _workers)) {
-    vm_shutdown_during_initialization("Failed to allocate initial heap.");
-    return JNI_ENOMEM;
+  {
+    // With G1PreTouchInBackground the service thread pre-touches the initial
+    // heap after startup instead.
+    FlagSetting fs(AlwaysPreTouch, AlwaysPreTouch && !G1PreTouchInBackground);
+    if (!expand(init_byte_size, _workers)) {
+      vm_shutdown_during_initialization("Failed to allocate initial heap.");
+      return JNI_ENOMEM;
+    }
   }
 
   // Perform any initialization actions delegated to the policy.
@@ -1767,6 +1816,8 @@ jint G1CollectedHeap::initialize() {
 
   _collection_set.initialize(max_regions());
 
+  _evac_failure_objects.initialize(max_regions(), ParallelGCThreads);
+
   G1InitLogger::print();
 
   return JNI_OK;
@@ -2394,6 +2445,12 @@ size_t G1CollectedHeap::max_capacity() const {
   return _hrm->max_expandable_length() * HeapRegion::GrainBytes;
 }
 
+size_t G1CollectedHeap::soft_max_capacity() const {
+  // SoftMaxHeapSize is manageable and may change at any time.
+  size_t soft_max = align_down(Atomic::load(&SoftMaxHeapSize), HeapRegion::GrainBytes);
+  return clamp(soft_max, MinHeapSize, max_capacity());
+}
+
 void G1CollectedHeap::deduplicate_string(oop str) {
   assert(java_lang_String::is_instance(str), "invariant");
 
@@ -2414,6 +2471,15 @@ bool G1CollectedHeap::supports_concurrent_gc_breakpoints() const {
   return true;
 }
 
+oop G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  heap_region_containing(obj)->increment_pinned_object_count();
+  return obj;
+}
+
+void G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  heap_region_containing(obj)->decrement_pinned_object_count();
+}
+
 bool G1CollectedHeap::is_heterogeneous_heap() const {
   return G1Arguments::is_heterogeneous_heap();
 }
@@ -3128,8 +3194,15 @@ void G1CollectedHeap::do_collection_pause_at_safepoint_helper(double target_paus
 }
 
 void G1CollectedHeap::remove_self_forwarding_pointers(G1RedirtyCardsQueueSet* rdcqs) {
-  G1ParRemoveSelfForwardPtrsTask rsfp_task(rdcqs);
+  _evac_failure_objects.prepare_for_removal(workers());
+
+  phase_times()->record_evac_fail_objects(_evac_failure_objects.total_objects(),
+                                          _evac_failure_objects.num_regions());
+
+  G1ParRemoveSelfForwardPtrsTask rsfp_task(rdcqs, &_evac_failure_objects);
   workers()->run_task(&rsfp_task);
+
+  _evac_failure_objects.clear();
 }
 
 void G1CollectedHeap::restore_after_evac_failure(G1RedirtyCardsQueueSet* rdcqs) {
@@ -3148,6 +3221,7 @@ void G1CollectedHeap::preserve_mark_during_evac_failure(uint worker_id, oop obj,
 
   _evacuation_failed_info_array[worker_id].register_copy_failure(obj->size());
   _preserved_marks_set.get(worker_id)->push_if_necessary(obj, m);
+  _evac_failure_objects.record(worker_id, obj);
 }
 
 bool G1ParEvacuateFollowersClosure::offer_termination() {
@@ -3579,6 +3653,12 @@ class G1PrepareEvacuationTask : public AbstractGangTask {
       if (!region->rem_set()->is_complete()) {
         return false;
       }
+
+      // A JNI critical section may still access the object even though no
+      // reference to it remains in the heap.
+      if (region->has_pinned_objects()) {
+        return false;
+      }
       // Candidate selection must satisfy the following constraints
       // while concurrent marking is in progress:
       //
@@ -3600,10 +3680,14 @@ class G1PrepareEvacuationTask : public AbstractGangTask {
       // structures don't support efficiently performing the needed
       // additional tests or scrubbing of the mark stack.
       //
-      // However, we presently only nominate is_typeArray() objects.
-      // A humongous object containing references induces remembered
-      // set entries on other regions.  In order to reclaim such an
-      // object, those remembered sets would need to be cleaned up.
+      // Besides is_typeArray() objects we also nominate is_objArray()
+      // objects. A humongous object containing references induces
+      // remembered set entries for its cards on other regions. These
+      // entries become stale once the object is reclaimed, but stale
+      // entries are already tolerated: card scanning is limited by the
+      // region's scan top and concurrent refinement filters cards in
+      // free regions and cards above top. Other kinds of objects are
+      // rare as humongous objects and are not nominated.
       //
       // We also treat is_typeArray() objects specially, allowing them
       // to be reclaimed even if allocated before the start of
@@ -3615,8 +3699,16 @@ class G1PrepareEvacuationTask : public AbstractGangTask {
       // important use case for eager reclaim, and this special handling
       // may reduce needed headroom.
 
-      return obj->is_typeArray() &&
-             _g1h->is_potential_eager_reclaim_candidate(region);
+      if (!_g1h->is_potential_eager_reclaim_candidate(region)) {
+        return false;
+      }
+      if (obj->is_typeArray()) {
+        return true;
+      }
+      return G1EagerReclaimHumongousObjArrays &&
+             obj->is_objArray() &&
+             (!_g1h->collector_state()->mark_or_rebuild_in_progress() ||
+              region->obj_allocated_since_next_marking(obj));
     }
 
   public:
@@ -4379,10 +4471,13 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
   uint _humongous_objects_reclaimed;
   uint _humongous_regions_reclaimed;
   size_t _freed_bytes;
+  uint _obj_arrays_reclaimed;
+  size_t _obj_array_bytes_freed;
  public:
 
   G1FreeHumongousRegionClosure(FreeRegionList* free_region_list) :
-    _free_region_list(free_region_list), _proxy_set(NULL), _humongous_objects_reclaimed(0), _humongous_regions_reclaimed(0), _freed_bytes(0) {
+    _free_region_list(free_region_list), _proxy_set(NULL), _humongous_objects_reclaimed(0), _humongous_regions_reclaimed(0), _freed_bytes(0),
+    _obj_arrays_reclaimed(0), _obj_array_bytes_freed(0) {
   }
 
   virtual bool do_heap_region(HeapRegion* r) {
@@ -4419,10 +4514,9 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
     // are completely up-to-date wrt to references to the humongous object.
     //
     // Other implementation considerations:
-    // - never consider object arrays at this time because they would pose
-    // considerable effort for cleaning up the the remembered sets. This is
-    // required because stale remembered sets might reference locations that
-    // are currently allocated into.
+    // - object arrays leave stale remembered set entries for their cards in
+    // other regions. Remembered set scanning and concurrent refinement already
+    // filter stale cards, so these entries need not be cleaned up here.
     uint region_idx = r->hrm_index();
     if (!g1h->is_humongous_reclaim_candidate(region_idx) ||
         !r->rem_set()->is_empty()) {
@@ -4439,8 +4533,8 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       return false;
     }
 
-    guarantee(obj->is_typeArray(),
-              "Only eagerly reclaiming type arrays is supported, but the object "
+    guarantee(obj->is_typeArray() || obj->is_objArray(),
+              "Only eagerly reclaiming type and object arrays is supported, but the object "
               PTR_FORMAT " is not.", p2i(r->bottom()));
 
     log_debug(gc, humongous)("Dead humongous region %u object size " SIZE_FORMAT " start " PTR_FORMAT " with remset " SIZE_FORMAT " code roots " SIZE_FORMAT " is marked %d reclaim candidate %d type array %d",
@@ -4462,14 +4556,21 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
            BOOL_TO_STR(cm->is_marked_in_prev_bitmap(obj)),
            BOOL_TO_STR(cm->is_marked_in_next_bitmap(obj)));
     _humongous_objects_reclaimed++;
+    bool is_obj_array = obj->is_objArray();
+    size_t object_bytes_freed = 0;
     do {
       HeapRegion* next = g1h->next_region_in_humongous(r);
-      _freed_bytes += r->used();
+      object_bytes_freed += r->used();
       r->set_containing_set(NULL);
       _humongous_regions_reclaimed++;
       g1h->free_humongous_region(r, _free_region_list);
       r = next;
     } while (r != NULL);
+    _freed_bytes += object_bytes_freed;
+    if (is_obj_array) {
+      _obj_arrays_reclaimed++;
+      _obj_array_bytes_freed += object_bytes_freed;
+    }
 
     return false;
   }
@@ -4485,6 +4586,14 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
   size_t bytes_freed() const {
     return _freed_bytes;
   }
+
+  uint obj_arrays_reclaimed() const {
+    return _obj_arrays_reclaimed;
+  }
+
+  size_t obj_array_bytes_freed() const {
+    return _obj_array_bytes_freed;
+  }
 };
 
 void G1CollectedHeap::eagerly_reclaim_humongous_regions() {
@@ -4517,6 +4626,12 @@ void G1CollectedHeap::eagerly_reclaim_humongous_regions() {
   prepend_to_freelist(&local_cleanup_list);
   decrement_summary_bytes(cl.bytes_freed());
 
+  log_debug(gc, humongous)("Eagerly reclaimed humongous objects: type arrays %u (" SIZE_FORMAT " bytes), object arrays %u (" SIZE_FORMAT " bytes)",
+                           cl.humongous_objects_reclaimed() - cl.obj_arrays_reclaimed(),
+                           cl.bytes_freed() - cl.obj_array_bytes_freed(),
+                           cl.obj_arrays_reclaimed(),
+                           cl.obj_array_bytes_freed());
+
   phase_times()->record_fast_reclaim_humongous_time_ms((os::elapsedTime() - start_time) * 1000.0,
                                                        cl.humongous_objects_reclaimed());
 }
@@ -33,6 +33,7 @@
 #include "gc/g1/g1ConcurrentMark.hpp"
 #include "gc/g1/g1EdenRegions.hpp"
 #include "gc/g1/g1EvacFailure.hpp"
+#include "gc/g1/g1EvacFailureObjects.hpp"
 #include "gc/g1/g1EvacStats.hpp"
 #include "gc/g1/g1EvacuationInfo.hpp"
 #include "gc/g1/g1GCPhaseTimes.hpp"
@@ -733,6 +734,14 @@ public:
 
   oop materialize_archived_object(oop obj);
 
+  // Concurrent uncommit support, used by the G1ServiceThread.
+  // Returns the amount of committed memory above the desired heap capacity.
+  size_t concurrent_uncommit_amount();
+  // Uncommit free regions worth at most the given amount of memory, but not
+  // more than concurrent_uncommit_amount(), outside of a pause. Returns the
+  // number of regions uncommitted.
+  uint uncommit_free_regions(size_t max_bytes);
+
 private:
 
   // Shrink the garbage-first heap by at most the given size (in bytes!).
@@ -837,6 +846,9 @@ public:
 
   PreservedMarksSet _preserved_marks_set;
 
+  // The objects that failed evacuation in the current collection.
+  G1EvacFailureObjects _evac_failure_objects;
+
   // Preserve the mark of "obj", if necessary, in preparation for its mark
   // word being overwritten with a self-forwarding-pointer.
   void preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m);
@@ -1278,6 +1290,12 @@ public:
   // Print the maximum heap capacity.
   virtual size_t max_capacity() const;
 
+  // The heap capacity G1 tries to stay within, derived from the manageable
+  // SoftMaxHeapSize flag. G1 collects more aggressively instead of expanding
+  // beyond it, but allocation failures may still grow the heap up to
+  // max_capacity().
+  size_t soft_max_capacity() const;
+
   Tickspan time_since_last_collection() const { return Ticks::now() - _collection_pause_end; }
 
   // Convenience function to be used in situations where the heap type can be
@@ -1418,6 +1436,12 @@ public:
   virtual bool supports_concurrent_gc_breakpoints() const;
   bool is_heterogeneous_heap() const;
 
+  // Objects are pinned by pinning the region that contains them: pinned
+  // regions are not evacuated or compacted until the pin count drops to zero.
+  virtual bool supports_object_pinning() const { return true; }
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   virtual WorkGang* safepoint_workers() { return _workers; }
 
   // The methods below are here for convenience and dispatch the
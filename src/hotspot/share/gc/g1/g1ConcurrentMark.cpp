@@ -46,6 +46,7 @@
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "gc/shared/gcVMOperations.hpp"
 #include "gc/shared/genOopClosures.inline.hpp"
+#include "gc/shared/markPrefetchWindow.hpp"
 #include "gc/shared/referencePolicy.hpp"
 #include "gc/shared/strongRootsScope.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
@@ -1143,6 +1144,10 @@ void G1ConcurrentMark::remark() {
     // Clean out dead classes
     if (ClassUnloadingWithConcurrentMark) {
       GCTraceTime(Debug, gc, phases) debug("Purge Metaspace", _gc_timer_cm);
+      if (DeferClassUnloadingPurge) {
+        // The ServiceThread deletes the unloaded class loaders after the pause.
+        ClassLoaderDataGraph::defer_purge();
+      }
       ClassLoaderDataGraph::purge(/*at_safepoint*/true);
     }
 
@@ -1823,6 +1828,10 @@ void G1ConcurrentMark::clear_range_in_prev_bitmap(MemRegion mr) {
   _prev_mark_bitmap->clear_range(mr);
 }
 
+void G1ConcurrentMark::par_clear_range_in_prev_bitmap(MemRegion mr) {
+  _prev_mark_bitmap->par_clear_range(mr);
+}
+
 HeapRegion*
 G1ConcurrentMark::claim_region(uint worker_id) {
   // "checkpoint" the finger
@@ -2279,14 +2288,29 @@ void G1CMTask::drain_local_queue(bool partially) {
   }
 
   if (_task_queue->size() > target_size) {
+    MarkPrefetchWindow<G1TaskQueueEntry> window(MAX2(G1MarkPrefetchWindow, 1u));
     G1TaskQueueEntry entry;
-    bool ret = _task_queue->pop_local(entry);
-    while (ret) {
+    for (;;) {
+      // Pop entries ahead of scanning them and prefetch their objects.
+      while (!window.is_full() &&
+             _task_queue->size() > target_size &&
+             _task_queue->pop_local(entry)) {
+        prefetch_task_entry(entry);
+        window.push(entry);
+      }
+
+      if (!window.pop(entry)) {
+        break;
+      }
+
       scan_task_entry(entry);
-      if (_task_queue->size() <= target_size || has_aborted()) {
-        ret = false;
-      } else {
-        ret = _task_queue->pop_local(entry);
+
+      if (has_aborted()) {
+        // Return the entries popped ahead to the queue.
+        while (window.pop(entry)) {
+          push(entry);
+        }
+        break;
       }
     }
   }
@@ -2382,6 +2406,10 @@ void G1CMTask::print_stats() {
   size_t const misses = _mark_stats_cache.misses();
   log_debug(gc, stats)("  Mark Stats Cache: hits " SIZE_FORMAT " misses " SIZE_FORMAT " ratio %.3f",
                        hits, misses, percent_of(hits, hits + misses));
+  double const step_time_s = _step_times_ms.sum() / 1000.0;
+  log_debug(gc, stats)("  Words Scanned (cum): " SIZE_FORMAT ", marking rate = %1.2lfMB/s",
+                       _total_words_scanned,
+                       step_time_s > 0.0 ? (double)(_total_words_scanned * HeapWordSize) / M / step_time_s : 0.0);
 }
 
 bool G1ConcurrentMark::try_stealing(uint worker_id, G1TaskQueueEntry& task_entry) {
@@ -2751,6 +2779,7 @@ void G1CMTask::do_marking_step(double time_target_ms,
   double elapsed_time_ms = end_time_ms - _start_time_ms;
   // Update the step history.
   _step_times_ms.add(elapsed_time_ms);
+  _total_words_scanned += _words_scanned;
 
   if (has_aborted()) {
     // The task was aborted for some reason.
@@ -2829,6 +2858,7 @@ G1CMTask::G1CMTask(uint worker_id,
   _finger(NULL),
   _region_limit(NULL),
   _words_scanned(0),
+  _total_words_scanned(0),
   _words_scanned_limit(0),
   _real_words_scanned_limit(0),
   _refs_reached(0),
@@ -2979,7 +3009,7 @@ G1PrintRegionLivenessInfoClosure::~G1PrintRegionLivenessInfoClosure() {
   }
 
   // add static memory usages to remembered set sizes
-  _total_remset_bytes += HeapRegionRemSet::fl_mem_size() + HeapRegionRemSet::static_mem_size();
+  _total_remset_bytes += HeapRegionRemSet::static_mem_size();
   // Print the footer of the output.
   log_trace(gc, liveness)(G1PPRL_LINE_PREFIX);
   log_trace(gc, liveness)(G1PPRL_LINE_PREFIX
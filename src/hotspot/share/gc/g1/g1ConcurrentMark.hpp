@@ -564,11 +564,16 @@ public:
   // Mark in the previous bitmap. Caution: the prev bitmap is usually read-only, so use
   // this carefully.
   inline void mark_in_prev_bitmap(oop p);
+  // Same as above, but may be used concurrently by multiple threads. Returns
+  // whether this call marked the object.
+  inline bool par_mark_in_prev_bitmap(oop p);
 
   // Clears marks for all objects in the given range, for the prev or
   // next bitmaps.  Caution: the previous bitmap is usually
   // read-only, so use this carefully!
   void clear_range_in_prev_bitmap(MemRegion mr);
+  // Same as above, but disjoint ranges may be cleared concurrently.
+  void par_clear_range_in_prev_bitmap(MemRegion mr);
 
   inline bool is_marked_in_prev_bitmap(oop p) const;
 
@@ -649,6 +654,8 @@ private:
 
   // Number of words this task has scanned
   size_t                      _words_scanned;
+  // Number of words this task has scanned over all marking steps
+  size_t                      _total_words_scanned;
   // When _words_scanned reaches this limit, the regular clock is
   // called. Notice that this might be decreased under certain
   // circumstances (i.e. when we believe that we did an expensive
@@ -787,6 +794,8 @@ public:
 
   // Scans an object and visits its children.
   inline void scan_task_entry(G1TaskQueueEntry task_entry);
+  // Prefetches the object or array slice of a task entry ahead of scanning it.
+  inline void prefetch_task_entry(G1TaskQueueEntry task_entry);
 
   // Pushes an object on the local queue.
   inline void push(G1TaskQueueEntry task_entry);
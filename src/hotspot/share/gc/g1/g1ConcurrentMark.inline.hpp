@@ -37,6 +37,7 @@
 #include "gc/g1/heapRegion.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
+#include "runtime/prefetch.inline.hpp"
 #include "utilities/bitMap.inline.hpp"
 
 inline bool G1CMIsAliveClosure::do_object_b(oop obj) {
@@ -105,6 +106,18 @@ inline void G1CMMarkStack::iterate(Fn fn) const {
 // It scans an object and visits its children.
 inline void G1CMTask::scan_task_entry(G1TaskQueueEntry task_entry) { process_grey_task_entry<true>(task_entry); }
 
+inline void G1CMTask::prefetch_task_entry(G1TaskQueueEntry task_entry) {
+  // Objects are marked when pushed, so only the object (or slice)
+  // contents will be touched when scanning.
+  if (G1MarkPrefetchWindow > 0) {
+    if (task_entry.is_array_slice()) {
+      Prefetch::read(task_entry.slice(), 0);
+    } else {
+      Prefetch::read(cast_from_oop<HeapWord*>(task_entry.obj()), 0);
+    }
+  }
+}
+
 inline void G1CMTask::push(G1TaskQueueEntry task_entry) {
   assert(task_entry.is_array_slice() || _g1h->is_in_reserved(task_entry.obj()), "invariant");
   assert(task_entry.is_array_slice() || !_g1h->is_on_master_free_list(
@@ -272,6 +285,10 @@ inline void G1ConcurrentMark::mark_in_prev_bitmap(oop p) {
  _prev_mark_bitmap->mark(p);
 }
 
+inline bool G1ConcurrentMark::par_mark_in_prev_bitmap(oop p) {
+  return _prev_mark_bitmap->par_mark(p);
+}
+
 bool G1ConcurrentMark::is_marked_in_prev_bitmap(oop p) const {
   assert(p != NULL && oopDesc::is_oop(p), "expected an oop");
   return _prev_mark_bitmap->is_marked(cast_from_oop<HeapWord*>(p));
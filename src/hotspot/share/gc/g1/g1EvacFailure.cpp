@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -73,6 +73,10 @@ public:
   }
 };
 
+// Processes a chunk of the objects that failed evacuation in a region, in
+// address order. Chunks of the same region are processed in parallel, so all
+// updates of the BOT and the prev bitmap must be confined to the chunk or use
+// atomic operations.
 class RemoveSelfForwardPtrObjClosure: public ObjectClosure {
   G1CollectedHeap* _g1h;
   G1ConcurrentMark* _cm;
@@ -87,7 +91,8 @@ public:
   RemoveSelfForwardPtrObjClosure(HeapRegion* hr,
                                  UpdateLogBuffersDeferred* log_buffer_cl,
                                  bool during_concurrent_start,
-                                 uint worker_id) :
+                                 uint worker_id,
+                                 HeapWord* start) :
     _g1h(G1CollectedHeap::heap()),
     _cm(_g1h->concurrent_mark()),
     _hr(hr),
@@ -95,66 +100,62 @@ public:
     _log_buffer_cl(log_buffer_cl),
     _during_concurrent_start(during_concurrent_start),
     _worker_id(worker_id),
-    _last_forwarded_object_end(hr->bottom()) { }
+    _last_forwarded_object_end(start) { }
 
   size_t marked_bytes() { return _marked_bytes; }
 
-  // Iterate over the live objects in the region to find self-forwarded objects
-  // that need to be kept live. We need to update the remembered sets of these
-  // objects. Further update the BOT and marks.
-  // We can coalesce and overwrite the remaining heap contents with dummy objects
-  // as they have either been dead or evacuated (which are unreferenced now, i.e.
-  // dead too) already.
+  // Handle a self-forwarded object that needs to be kept live. We need to
+  // update the remembered sets of these objects. Further update the BOT and
+  // marks.
+  // We can coalesce and overwrite the heap contents since the previous
+  // self-forwarded object with dummy objects as they have either been dead or
+  // evacuated (which are unreferenced now, i.e. dead too) already.
   void do_object(oop obj) {
     HeapWord* obj_addr = cast_from_oop<HeapWord*>(obj);
     assert(_hr->is_in(obj_addr), "sanity");
-
-    if (obj->is_forwarded() && obj->forwardee() == obj) {
-      // The object failed to move.
-
-      zap_dead_objects(_last_forwarded_object_end, obj_addr);
-      // We consider all objects that we find self-forwarded to be
-      // live. What we'll do is that we'll update the prev marking
-      // info so that they are all under PTAMS and explicitly marked.
-      if (!_cm->is_marked_in_prev_bitmap(obj)) {
-        _cm->mark_in_prev_bitmap(obj);
-      }
-      if (_during_concurrent_start) {
-        // For the next marking info we'll only mark the
-        // self-forwarded objects explicitly if we are during
-        // concurrent start (since, normally, we only mark objects pointed
-        // to by roots if we succeed in copying them). By marking all
-        // self-forwarded objects we ensure that we mark any that are
-        // still pointed to be roots. During concurrent marking, and
-        // after concurrent start, we don't need to mark any objects
-        // explicitly and all objects in the CSet are considered
-        // (implicitly) live. So, we won't mark them explicitly and
-        // we'll leave them over NTAMS.
-        _cm->mark_in_next_bitmap(_worker_id, _hr, obj);
-      }
-      size_t obj_size = obj->size();
-
-      _marked_bytes += (obj_size * HeapWordSize);
-      PreservedMarks::init_forwarded_mark(obj);
-
-      // While we were processing RSet buffers during the collection,
-      // we actually didn't scan any cards on the collection set,
-      // since we didn't want to update remembered sets with entries
-      // that point into the collection set, given that live objects
-      // from the collection set are about to move and such entries
-      // will be stale very soon.
-      // This change also dealt with a reliability issue which
-      // involved scanning a card in the collection set and coming
-      // across an array that was being chunked and looking malformed.
-      // The problem is that, if evacuation fails, we might have
-      // remembered set entries missing given that we skipped cards on
-      // the collection set. So, we'll recreate such entries now.
-      obj->oop_iterate(_log_buffer_cl);
-
-      HeapWord* obj_end = obj_addr + obj_size;
-      _last_forwarded_object_end = obj_end;
-      _hr->cross_threshold(obj_addr, obj_end);
+    assert(obj->is_forwarded() && obj->forwardee() == obj, "Object " PTR_FORMAT " must be self-forwarded", p2i(obj_addr));
+    assert(obj_addr >= _last_forwarded_object_end, "Objects must be processed in address order");
+
+    zap_dead_objects(_last_forwarded_object_end, obj_addr);
+    // We consider all objects that we find self-forwarded to be
+    // live. What we'll do is that we'll update the prev marking
+    // info so that they are all under PTAMS and explicitly marked.
+    _cm->par_mark_in_prev_bitmap(obj);
+    if (_during_concurrent_start) {
+      // For the next marking info we'll only mark the
+      // self-forwarded objects explicitly if we are during
+      // concurrent start (since, normally, we only mark objects pointed
+      // to by roots if we succeed in copying them). By marking all
+      // self-forwarded objects we ensure that we mark any that are
+      // still pointed to be roots. During concurrent marking, and
+      // after concurrent start, we don't need to mark any objects
+      // explicitly and all objects in the CSet are considered
+      // (implicitly) live. So, we won't mark them explicitly and
+      // we'll leave them over NTAMS.
+      _cm->mark_in_next_bitmap(_worker_id, _hr, obj);
     }
+    size_t obj_size = obj->size();
+
+    _marked_bytes += (obj_size * HeapWordSize);
+    PreservedMarks::init_forwarded_mark(obj);
+
+    // While we were processing RSet buffers during the collection,
+    // we actually didn't scan any cards on the collection set,
+    // since we didn't want to update remembered sets with entries
+    // that point into the collection set, given that live objects
+    // from the collection set are about to move and such entries
+    // will be stale very soon.
+    // This change also dealt with a reliability issue which
+    // involved scanning a card in the collection set and coming
+    // across an array that was being chunked and looking malformed.
+    // The problem is that, if evacuation fails, we might have
+    // remembered set entries missing given that we skipped cards on
+    // the collection set. So, we'll recreate such entries now.
+    obj->oop_iterate(_log_buffer_cl);
+
+    HeapWord* obj_end = obj_addr + obj_size;
+    _last_forwarded_object_end = obj_end;
+    _hr->update_bot_for_block(obj_addr, obj_end);
   }
 
   // Fill the memory area from start to end with filler objects, and update the BOT
@@ -170,13 +171,13 @@ public:
       CollectedHeap::fill_with_objects(start, gap_size);
 
       HeapWord* end_first_obj = start + ((oop)start)->size();
-      _hr->cross_threshold(start, end_first_obj);
+      _hr->update_bot_for_block(start, end_first_obj);
       // Fill_with_objects() may have created multiple (i.e. two)
       // objects, as the max_fill_size() is half a region.
       // After updating the BOT for the first object, also update the
       // BOT for the second object to make the BOT complete.
       if (end_first_obj != end) {
-        _hr->cross_threshold(end_first_obj, end);
+        _hr->update_bot_for_block(end_first_obj, end);
 #ifdef ASSERT
         size_t size_second_obj = ((oop)end_first_obj)->size();
         HeapWord* end_of_second_obj = end_first_obj + size_second_obj;
@@ -187,7 +188,7 @@ public:
 #endif
       }
     }
-    _cm->clear_range_in_prev_bitmap(mr);
+    _cm->par_clear_range_in_prev_bitmap(mr);
   }
 
   void zap_remainder() {
@@ -195,69 +196,77 @@ public:
   }
 };
 
-class RemoveSelfForwardPtrHRClosure: public HeapRegionClosure {
-  G1CollectedHeap* _g1h;
-  uint _worker_id;
+G1ParRemoveSelfForwardPtrsTask::G1ParRemoveSelfForwardPtrsTask(G1RedirtyCardsQueueSet* rdcqs,
+                                                               G1EvacFailureObjects* objects) :
+  AbstractGangTask("G1 Remove Self-forwarding Pointers"),
+  _g1h(G1CollectedHeap::heap()),
+  _rdcqs(rdcqs),
+  _objects(objects),
+  _during_concurrent_start(_g1h->collector_state()->in_concurrent_start_gc()) {
+
+  bool during_concurrent_mark = _g1h->collector_state()->mark_or_rebuild_in_progress();
+  // The region set up must be complete before any chunk of the region is
+  // processed. It is cheap, so do it up front.
+  for (uint i = 0; i < _objects->num_regions(); i++) {
+    HeapRegion* hr = _g1h->region_at(_objects->region_idx_at(i));
+    assert(!hr->is_pinned(), "Unexpected pinned region at index %u", hr->hrm_index());
+    assert(hr->in_collection_set(), "bad CS");
+    assert(hr->evacuation_failed(), "Region %u has failed objects but did not fail evacuation", hr->hrm_index());
 
-  G1RedirtyCardsQueue _rdcq;
-  UpdateLogBuffersDeferred _log_buffer_cl;
+    hr->clear_index_in_opt_cset();
+    hr->note_self_forwarding_removal_start(_during_concurrent_start,
+                                           during_concurrent_mark);
+    _g1h->verifier()->check_bitmaps("Self-Forwarding Ptr Removal", hr);
 
-public:
-  RemoveSelfForwardPtrHRClosure(G1RedirtyCardsQueueSet* rdcqs, uint worker_id) :
-    _g1h(G1CollectedHeap::heap()),
-    _worker_id(worker_id),
-    _rdcq(rdcqs),
-    _log_buffer_cl(&_rdcq) {
+    hr->reset_bot();
   }
+}
 
-  size_t remove_self_forward_ptr_by_walking_hr(HeapRegion* hr,
-                                               bool during_concurrent_start) {
-    RemoveSelfForwardPtrObjClosure rspc(hr,
-                                        &_log_buffer_cl,
-                                        during_concurrent_start,
-                                        _worker_id);
-    hr->object_iterate(&rspc);
+void G1ParRemoveSelfForwardPtrsTask::process_chunk(const G1EvacFailureObjects::Chunk* chunk,
+                                                   UpdateLogBuffersDeferred* log_buffer_cl,
+                                                   uint worker_id) {
+  HeapRegion* hr = _g1h->region_at(chunk->_region_idx);
+  oop* objects = _objects->objects(chunk->_region_idx);
+  uint num_objects = _objects->num_objects(chunk->_region_idx);
+
+  // The dead area before the first object of this chunk starts at the end of
+  // the last object of the previous chunk.
+  HeapWord* start = hr->bottom();
+  if (chunk->_start > 0) {
+    oop prev = objects[chunk->_start - 1];
+    start = cast_from_oop<HeapWord*>(prev) + prev->size();
+  }
+
+  RemoveSelfForwardPtrObjClosure rspc(hr,
+                                      log_buffer_cl,
+                                      _during_concurrent_start,
+                                      worker_id,
+                                      start);
+  for (uint i = chunk->_start; i < chunk->_end; i++) {
+    rspc.do_object(objects[i]);
+  }
+  if (chunk->_end == num_objects) {
     // Need to zap the remainder area of the processed region.
     rspc.zap_remainder();
-
-    return rspc.marked_bytes();
   }
 
-  bool do_heap_region(HeapRegion *hr) {
-    assert(!hr->is_pinned(), "Unexpected pinned region at index %u", hr->hrm_index());
-    assert(hr->in_collection_set(), "bad CS");
-
-    if (hr->evacuation_failed()) {
-      hr->clear_index_in_opt_cset();
-
-      bool during_concurrent_start = _g1h->collector_state()->in_concurrent_start_gc();
-      bool during_concurrent_mark = _g1h->collector_state()->mark_or_rebuild_in_progress();
-
-      hr->note_self_forwarding_removal_start(during_concurrent_start,
-                                             during_concurrent_mark);
-      _g1h->verifier()->check_bitmaps("Self-Forwarding Ptr Removal", hr);
-
-      hr->reset_bot();
+  size_t live_bytes;
+  if (_objects->chunk_done(chunk->_region_idx, rspc.marked_bytes(), &live_bytes)) {
+    hr->set_bot_threshold_at(hr->top());
 
-      size_t live_bytes = remove_self_forward_ptr_by_walking_hr(hr, during_concurrent_start);
+    hr->rem_set()->clean_strong_code_roots(hr);
+    hr->rem_set()->clear_locked(true);
 
-      hr->rem_set()->clean_strong_code_roots(hr);
-      hr->rem_set()->clear_locked(true);
-
-      hr->note_self_forwarding_removal_end(live_bytes);
-    }
-    return false;
+    hr->note_self_forwarding_removal_end(live_bytes);
   }
-};
-
-G1ParRemoveSelfForwardPtrsTask::G1ParRemoveSelfForwardPtrsTask(G1RedirtyCardsQueueSet* rdcqs) :
-  AbstractGangTask("G1 Remove Self-forwarding Pointers"),
-  _g1h(G1CollectedHeap::heap()),
-  _rdcqs(rdcqs),
-  _hrclaimer(_g1h->workers()->active_workers()) { }
+}
 
 void G1ParRemoveSelfForwardPtrsTask::work(uint worker_id) {
-  RemoveSelfForwardPtrHRClosure rsfp_cl(_rdcqs, worker_id);
+  G1RedirtyCardsQueue rdcq(_rdcqs);
+  UpdateLogBuffersDeferred log_buffer_cl(&rdcq);
 
-  _g1h->collection_set_iterate_increment_from(&rsfp_cl, &_hrclaimer, worker_id);
+  const G1EvacFailureObjects::Chunk* chunk;
+  while ((chunk = _objects->claim_chunk()) != NULL) {
+    process_chunk(chunk, &log_buffer_cl, worker_id);
+  }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,7 @@
 #ifndef SHARE_GC_G1_G1EVACFAILURE_HPP
 #define SHARE_GC_G1_G1EVACFAILURE_HPP
 
+#include "gc/g1/g1EvacFailureObjects.hpp"
 #include "gc/g1/g1OopClosures.hpp"
 #include "gc/g1/heapRegionManager.hpp"
 #include "gc/shared/workgroup.hpp"
@@ -32,17 +33,27 @@
 
 class G1CollectedHeap;
 class G1RedirtyCardsQueueSet;
+class UpdateLogBuffersDeferred;
 
 // Task to fixup self-forwarding pointers
 // installed as a result of an evacuation failure.
+// Only the objects recorded as failed are visited. Workers claim chunks of
+// them, so that a single region with many failed objects is also processed
+// in parallel.
 class G1ParRemoveSelfForwardPtrsTask: public AbstractGangTask {
 protected:
   G1CollectedHeap* _g1h;
   G1RedirtyCardsQueueSet* _rdcqs;
-  HeapRegionClaimer _hrclaimer;
+  G1EvacFailureObjects* _objects;
+  bool _during_concurrent_start;
+
+  void process_chunk(const G1EvacFailureObjects::Chunk* chunk,
+                     UpdateLogBuffersDeferred* log_buffer_cl,
+                     uint worker_id);
 
 public:
-  G1ParRemoveSelfForwardPtrsTask(G1RedirtyCardsQueueSet* rdcqs);
+  // Requires objects to have been prepared for removal.
+  G1ParRemoveSelfForwardPtrsTask(G1RedirtyCardsQueueSet* rdcqs, G1EvacFailureObjects* objects);
 
   void work(uint worker_id);
 };
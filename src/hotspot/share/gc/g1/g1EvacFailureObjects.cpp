@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CollectedHeap.inline.hpp"
+#include "gc/g1/g1EvacFailureObjects.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/quickSort.hpp"
+
+class G1DistributeEvacFailureObjectsTask : public AbstractGangTask {
+  G1EvacFailureObjects* _objects;
+
+public:
+  G1DistributeEvacFailureObjectsTask(G1EvacFailureObjects* objects) :
+    AbstractGangTask("G1 Distribute Evacuation Failure Objects"),
+    _objects(objects) { }
+
+  void work(uint worker_id) {
+    _objects->distribute_objects();
+  }
+};
+
+class G1SortEvacFailureObjectsTask : public AbstractGangTask {
+  G1EvacFailureObjects* _objects;
+
+public:
+  G1SortEvacFailureObjectsTask(G1EvacFailureObjects* objects) :
+    AbstractGangTask("G1 Sort Evacuation Failure Objects"),
+    _objects(objects) { }
+
+  void work(uint worker_id) {
+    _objects->sort_objects();
+  }
+};
+
+static int order_oops(oop a, oop b) {
+  HeapWord* addr_a = cast_from_oop<HeapWord*>(a);
+  HeapWord* addr_b = cast_from_oop<HeapWord*>(b);
+  if (addr_a < addr_b) {
+    return -1;
+  } else if (addr_a > addr_b) {
+    return 1;
+  }
+  return 0;
+}
+
+G1EvacFailureObjects::G1EvacFailureObjects() :
+  _max_regions(0),
+  _max_workers(0),
+  _worker_objects(NULL),
+  _num_objects(NULL),
+  _objects(NULL),
+  _num_distributed(NULL),
+  _chunks_remaining(NULL),
+  _live_bytes(NULL),
+  _regions(NULL),
+  _num_regions(0),
+  _chunks(NULL),
+  _num_chunks(0),
+  _total_objects(0),
+  _lists_claimed(0),
+  _regions_claimed(0),
+  _chunks_claimed(0) { }
+
+void G1EvacFailureObjects::initialize(uint max_regions, uint max_workers) {
+  assert(_worker_objects == NULL, "initialize only once");
+  _max_regions = max_regions;
+  _max_workers = max_workers;
+
+  _worker_objects = NEW_C_HEAP_ARRAY(ObjectList, max_workers, mtGC);
+  for (uint i = 0; i < max_workers; i++) {
+    ::new (&_worker_objects[i]) ObjectList(0);
+  }
+
+  _num_objects = NEW_C_HEAP_ARRAY(uint, max_regions, mtGC);
+  _objects = NEW_C_HEAP_ARRAY(oop*, max_regions, mtGC);
+  _num_distributed = NEW_C_HEAP_ARRAY(uint, max_regions, mtGC);
+  _chunks_remaining = NEW_C_HEAP_ARRAY(uint, max_regions, mtGC);
+  _live_bytes = NEW_C_HEAP_ARRAY(size_t, max_regions, mtGC);
+  _regions = NEW_C_HEAP_ARRAY(uint, max_regions, mtGC);
+  for (uint i = 0; i < max_regions; i++) {
+    _num_objects[i] = 0;
+    _objects[i] = NULL;
+    _num_distributed[i] = 0;
+    _chunks_remaining[i] = 0;
+    _live_bytes[i] = 0;
+  }
+}
+
+void G1EvacFailureObjects::record(uint worker_id, oop obj) {
+  assert(worker_id < _max_workers, "Invalid worker id %u", worker_id);
+  uint region_idx = G1CollectedHeap::heap()->addr_to_region(cast_from_oop<HeapWord*>(obj));
+  _worker_objects[worker_id].append(obj);
+  Atomic::inc(&_num_objects[region_idx]);
+}
+
+void G1EvacFailureObjects::prepare_for_removal(WorkGang* workers) {
+  assert(_num_regions == 0 && _num_chunks == 0, "must be cleared");
+
+  // Size the per-region arrays and the chunks. Only regions that failed
+  // evacuation have recorded objects, so this is a cheap scan of counters.
+  for (uint i = 0; i < _max_regions; i++) {
+    uint n = _num_objects[i];
+    if (n == 0) {
+      continue;
+    }
+    _objects[i] = NEW_C_HEAP_ARRAY(oop, n, mtGC);
+    _chunks_remaining[i] = (n + ObjectsPerChunk - 1) / ObjectsPerChunk;
+    _regions[_num_regions++] = i;
+    _num_chunks += _chunks_remaining[i];
+    _total_objects += n;
+  }
+
+  _chunks = NEW_C_HEAP_ARRAY(Chunk, MAX2(_num_chunks, 1u), mtGC);
+  uint chunk = 0;
+  for (uint i = 0; i < _num_regions; i++) {
+    uint region_idx = _regions[i];
+    uint n = _num_objects[region_idx];
+    for (uint start = 0; start < n; start += ObjectsPerChunk) {
+      _chunks[chunk]._region_idx = region_idx;
+      _chunks[chunk]._start = start;
+      _chunks[chunk]._end = MIN2(start + ObjectsPerChunk, n);
+      chunk++;
+    }
+  }
+  assert(chunk == _num_chunks, "must be");
+
+  G1DistributeEvacFailureObjectsTask distribute_task(this);
+  workers->run_task(&distribute_task);
+
+  G1SortEvacFailureObjectsTask sort_task(this);
+  workers->run_task(&sort_task);
+}
+
+void G1EvacFailureObjects::distribute_objects() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  uint i;
+  while ((i = Atomic::fetch_and_add(&_lists_claimed, 1u)) < _max_workers) {
+    ObjectList* list = &_worker_objects[i];
+    for (int j = 0; j < list->length(); j++) {
+      oop obj = list->at(j);
+      uint region_idx = g1h->addr_to_region(cast_from_oop<HeapWord*>(obj));
+      uint slot = Atomic::fetch_and_add(&_num_distributed[region_idx], 1u);
+      assert(slot < _num_objects[region_idx], "more objects than recorded for region %u", region_idx);
+      _objects[region_idx][slot] = obj;
+    }
+    list->clear_and_deallocate();
+  }
+}
+
+void G1EvacFailureObjects::sort_objects() {
+  uint i;
+  while ((i = Atomic::fetch_and_add(&_regions_claimed, 1u)) < _num_regions) {
+    uint region_idx = _regions[i];
+    assert(_num_distributed[region_idx] == _num_objects[region_idx], "all objects must have been distributed");
+    QuickSort::sort(_objects[region_idx], _num_objects[region_idx], order_oops, false);
+  }
+}
+
+const G1EvacFailureObjects::Chunk* G1EvacFailureObjects::claim_chunk() {
+  uint i = Atomic::fetch_and_add(&_chunks_claimed, 1u);
+  return i < _num_chunks ? &_chunks[i] : NULL;
+}
+
+bool G1EvacFailureObjects::chunk_done(uint region_idx, size_t live_bytes, size_t* region_live_bytes) {
+  Atomic::add(&_live_bytes[region_idx], live_bytes);
+  if (Atomic::sub(&_chunks_remaining[region_idx], 1u) != 0) {
+    return false;
+  }
+  // All other chunks of the region have added their live bytes before
+  // decrementing the counter.
+  *region_live_bytes = Atomic::load(&_live_bytes[region_idx]);
+  return true;
+}
+
+void G1EvacFailureObjects::clear() {
+  for (uint i = 0; i < _num_regions; i++) {
+    uint region_idx = _regions[i];
+    FREE_C_HEAP_ARRAY(oop, _objects[region_idx]);
+    _objects[region_idx] = NULL;
+    _num_objects[region_idx] = 0;
+    _num_distributed[region_idx] = 0;
+    _chunks_remaining[region_idx] = 0;
+    _live_bytes[region_idx] = 0;
+  }
+  if (_chunks != NULL) {
+    FREE_C_HEAP_ARRAY(Chunk, _chunks);
+    _chunks = NULL;
+  }
+  _num_regions = 0;
+  _num_chunks = 0;
+  _total_objects = 0;
+  _lists_claimed = 0;
+  _regions_claimed = 0;
+  _chunks_claimed = 0;
+}
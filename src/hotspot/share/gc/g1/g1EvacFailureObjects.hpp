@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1EVACFAILUREOBJECTS_HPP
+#define SHARE_GC_G1_G1EVACFAILUREOBJECTS_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/growableArray.hpp"
+
+class WorkGang;
+
+// Records the objects that failed evacuation during a collection so that
+// self-forwarding pointer removal only visits those objects instead of
+// walking every object of the regions that failed evacuation.
+//
+// Workers record the objects they self-forward during evacuation. Before
+// removal the objects are distributed to per-region arrays and sorted by
+// address. Each region's array is then split into chunks of consecutive
+// objects that may be processed by different workers.
+class G1EvacFailureObjects {
+public:
+  // The objects [_start, _end) of the sorted objects of region _region_idx.
+  struct Chunk {
+    uint _region_idx;
+    uint _start;
+    uint _end;
+  };
+
+private:
+  typedef GrowableArrayCHeap<oop, mtGC> ObjectList;
+
+  static const uint ObjectsPerChunk = 256;
+
+  uint _max_regions;
+  uint _max_workers;
+
+  // Objects recorded by each worker during evacuation.
+  ObjectList* _worker_objects;
+
+  // Per region: number of recorded objects, the objects themselves and the
+  // number of objects distributed into that array so far. The counters are
+  // updated atomically.
+  uint* _num_objects;
+  oop** _objects;
+  uint* _num_distributed;
+
+  // Per region: number of chunks not yet completed and the live bytes
+  // reported by the completed chunks, both updated atomically.
+  uint* _chunks_remaining;
+  size_t* _live_bytes;
+
+  // Indices of the regions with recorded objects.
+  uint* _regions;
+  uint _num_regions;
+
+  Chunk* _chunks;
+  uint _num_chunks;
+
+  size_t _total_objects;
+
+  volatile uint _lists_claimed;
+  volatile uint _regions_claimed;
+  volatile uint _chunks_claimed;
+
+  friend class G1DistributeEvacFailureObjectsTask;
+  friend class G1SortEvacFailureObjectsTask;
+
+  void distribute_objects();
+  void sort_objects();
+
+public:
+  G1EvacFailureObjects();
+
+  void initialize(uint max_regions, uint max_workers);
+
+  // Record that obj failed evacuation. Called by the worker that installed
+  // the self-forwarding pointer.
+  void record(uint worker_id, oop obj);
+
+  // Organize the recorded objects by region, in address order, and split
+  // them into chunks.
+  void prepare_for_removal(WorkGang* workers);
+
+  uint num_regions() const { return _num_regions; }
+  uint region_idx_at(uint i) const { return _regions[i]; }
+  size_t total_objects() const { return _total_objects; }
+
+  uint num_objects(uint region_idx) const { return _num_objects[region_idx]; }
+  oop* objects(uint region_idx) const { return _objects[region_idx]; }
+
+  // Claim the next chunk to process, or return NULL if all have been claimed.
+  const Chunk* claim_chunk();
+
+  // Report that a chunk of the given region has been processed and that it
+  // contained live_bytes bytes of live objects. Returns true, setting
+  // region_live_bytes, if this was the last chunk of the region.
+  bool chunk_done(uint region_idx, size_t live_bytes, size_t* region_live_bytes);
+
+  // Drop all recorded objects after removal has completed.
+  void clear();
+};
+
+#endif // SHARE_GC_G1_G1EVACFAILUREOBJECTS_HPP
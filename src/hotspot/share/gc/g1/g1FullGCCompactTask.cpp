@@ -54,6 +54,10 @@ public:
         }
       }
       current->reset_humongous_during_compaction();
+    } else if (!current->is_pinned() && current->has_pinned_objects()) {
+      // Regions with pinned objects are not compacted, so their marks
+      // are not cleared during compaction.
+      _bitmap->clear_region(current);
     }
     return false;
   }
@@ -49,7 +49,13 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
     } else {
       free_humongous_region(hr);
     }
-  } else if (!hr->is_pinned()) {
+  } else if (hr->is_pinned()) {
+    // Archive regions never move and are left as they are. A JNI critical
+    // section may hold an archived object, but closed archive objects are
+    // never marked, so prepare_pinned_region() must not see them.
+  } else if (hr->has_pinned_objects()) {
+    prepare_pinned_region(hr);
+  } else {
     prepare_for_compaction(hr);
   }
 
@@ -110,6 +116,40 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::free_humongous_region(Heap
   dummy_free_list.remove_all();
 }
 
+void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_pinned_region(HeapRegion* hr) {
+  // Objects pinned by JNI critical sections must not move, so the region is
+  // kept as is. Live objects get a mark that does not look like a forwarding
+  // pointer, dead objects are overwritten with filler objects to keep the
+  // region parsable, and the block offset table is rebuilt since the region
+  // may have been a young region without one.
+  assert(!hr->is_pinned(), "archive region %u must be left alone", hr->hrm_index());
+  hr->reset_bot();
+  HeapWord* threshold = hr->initialize_threshold();
+  HeapWord* const limit = hr->top();
+  HeapWord* next = hr->bottom();
+  while (next < limit) {
+    HeapWord* live = _bitmap->get_next_marked_addr(next, limit);
+    if (live > next) {
+      CollectedHeap::fill_with_objects(next, pointer_delta(live, next));
+      if (live > threshold) {
+        threshold = hr->cross_threshold(next, live);
+      }
+    }
+    if (live < limit) {
+      oop obj = oop(live);
+      if (obj->forwardee() != NULL) {
+        obj->init_mark_raw();
+      }
+      next = live + obj->size();
+      if (next > threshold) {
+        threshold = hr->cross_threshold(live, next);
+      }
+    } else {
+      next = limit;
+    }
+  }
+}
+
 void G1FullGCPrepareTask::G1CalculatePointersClosure::reset_region_metadata(HeapRegion* hr) {
   hr->rem_set()->clear();
   hr->clear_cardtable();
@@ -59,6 +59,7 @@ protected:
     virtual void prepare_for_compaction(HeapRegion* hr);
     void prepare_for_compaction_work(G1FullGCCompactionPoint* cp, HeapRegion* hr);
     void free_humongous_region(HeapRegion* hr);
+    void prepare_pinned_region(HeapRegion* hr);
     void reset_region_metadata(HeapRegion* hr);
 
   public:
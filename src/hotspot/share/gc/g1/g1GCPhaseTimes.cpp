@@ -36,6 +36,7 @@
 #include "logging/logStream.hpp"
 #include "runtime/timer.hpp"
 #include "runtime/os.hpp"
+#include "utilities/latencyHistogram.hpp"
 #include "utilities/macros.hpp"
 
 static const char* indent(uint level) {
@@ -75,15 +76,15 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
   _gc_par_phases[MergeER] = new WorkerDataArray<double>("MergeER", "Eager Reclaim (ms):", max_gc_threads);
 
   _gc_par_phases[MergeRS] = new WorkerDataArray<double>("MergeRS", "Remembered Sets (ms):", max_gc_threads);
-  _gc_par_phases[MergeRS]->create_thread_work_items("Merged Sparse:", MergeRSMergedSparse);
-  _gc_par_phases[MergeRS]->create_thread_work_items("Merged Fine:", MergeRSMergedFine);
-  _gc_par_phases[MergeRS]->create_thread_work_items("Merged Coarse:", MergeRSMergedCoarse);
+  _gc_par_phases[MergeRS]->create_thread_work_items("Merged Cards:", MergeRSMergedCards);
+  _gc_par_phases[MergeRS]->create_thread_work_items("Merged BitMap:", MergeRSMergedBitMap);
+  _gc_par_phases[MergeRS]->create_thread_work_items("Merged Full:", MergeRSMergedFull);
   _gc_par_phases[MergeRS]->create_thread_work_items("Dirty Cards:", MergeRSDirtyCards);
 
   _gc_par_phases[OptMergeRS] = new WorkerDataArray<double>("OptMergeRS", "Optional Remembered Sets (ms):", max_gc_threads);
-  _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Sparse:", MergeRSMergedSparse);
-  _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Fine:", MergeRSMergedFine);
-  _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Coarse:", MergeRSMergedCoarse);
+  _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Cards:", MergeRSMergedCards);
+  _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged BitMap:", MergeRSMergedBitMap);
+  _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Full:", MergeRSMergedFull);
   _gc_par_phases[OptMergeRS]->create_thread_work_items("Dirty Cards:", MergeRSDirtyCards);
 
   _gc_par_phases[MergeLB] = new WorkerDataArray<double>("MergeLB", "Log Buffers (ms):", max_gc_threads);
@@ -109,10 +110,12 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
   _gc_par_phases[ScanHR]->create_thread_work_items("Scanned Cards:", ScanHRScannedCards);
   _gc_par_phases[ScanHR]->create_thread_work_items("Scanned Blocks:", ScanHRScannedBlocks);
   _gc_par_phases[ScanHR]->create_thread_work_items("Claimed Chunks:", ScanHRClaimedChunks);
+  _gc_par_phases[ScanHR]->create_thread_work_items("Scanned Batches:", ScanHRScannedBatches);
 
   _gc_par_phases[OptScanHR]->create_thread_work_items("Scanned Cards:", ScanHRScannedCards);
   _gc_par_phases[OptScanHR]->create_thread_work_items("Scanned Blocks:", ScanHRScannedBlocks);
   _gc_par_phases[OptScanHR]->create_thread_work_items("Claimed Chunks:", ScanHRClaimedChunks);
+  _gc_par_phases[OptScanHR]->create_thread_work_items("Scanned Batches:", ScanHRScannedBatches);
   _gc_par_phases[OptScanHR]->create_thread_work_items("Scanned Refs:", ScanHRScannedOptRefs);
   _gc_par_phases[OptScanHR]->create_thread_work_items("Used Memory:", ScanHRUsedMemory);
 
@@ -159,6 +162,8 @@ void G1GCPhaseTimes::reset() {
   _cur_optional_prepare_merge_heap_roots_time_ms = 0.0;
   _cur_evac_fail_recalc_used = 0.0;
   _cur_evac_fail_remove_self_forwards = 0.0;
+  _cur_evac_fail_objects = 0;
+  _cur_evac_fail_regions = 0;
   _cur_string_deduplication_time_ms = 0.0;
   _cur_prepare_tlab_time_ms = 0.0;
   _cur_resize_tlab_time_ms = 0.0;
@@ -186,6 +191,7 @@ void G1GCPhaseTimes::reset() {
   _cur_fast_reclaim_humongous_total = 0;
   _cur_fast_reclaim_humongous_candidates = 0;
   _cur_fast_reclaim_humongous_reclaimed = 0;
+  _cur_scan_heap_roots_chunk_size = 0;
   _cur_verify_before_time_ms = 0.0;
   _cur_verify_after_time_ms = 0.0;
 
@@ -218,8 +224,12 @@ double G1GCPhaseTimes::worker_time(GCParPhases phase, uint worker) {
   return 0.0;
 }
 
+static LatencyHistogram _gc_pause_histogram("G1 pause");
+
 void G1GCPhaseTimes::note_gc_end() {
-  _gc_pause_time_ms = TimeHelper::counter_to_millis(os::elapsed_counter() - _gc_start_counter);
+  jlong pause_ticks = os::elapsed_counter() - _gc_start_counter;
+  _gc_pause_time_ms = TimeHelper::counter_to_millis(pause_ticks);
+  _gc_pause_histogram.record((jlong)(TimeHelper::counter_to_seconds(pause_ticks) * NANOSECS_PER_SEC));
 
   double uninitialized = WorkerDataArray<double>::uninitialized();
 
@@ -448,6 +458,7 @@ double G1GCPhaseTimes::print_evacuate_initial_collection_set() const {
     trace_phase(_gc_par_phases[i]);
   }
   debug_phase(_gc_par_phases[ScanHR]);
+  trace_count("Scan Chunk Size (Cards)", _cur_scan_heap_roots_chunk_size);
   debug_phase(_gc_par_phases[CodeRoots]);
   debug_phase(_gc_par_phases[ObjCopy]);
   debug_phase(_gc_par_phases[Termination]);
@@ -498,6 +509,8 @@ double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
     debug_time("Evacuation Failure", evac_fail_handling);
     trace_time("Recalculate Used", _cur_evac_fail_recalc_used);
     trace_time("Remove Self Forwards",_cur_evac_fail_remove_self_forwards);
+    trace_count("Failed Objects", _cur_evac_fail_objects);
+    trace_count("Failed Regions", _cur_evac_fail_regions);
   }
 
   debug_phase(_gc_par_phases[MergePSS], 0);
@@ -86,9 +86,9 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   static const GCParPhases ExtRootScanSubPhasesLast = GCParPhases(MergeER - 1);
 
   enum GCMergeRSWorkTimes {
-    MergeRSMergedSparse,
-    MergeRSMergedFine,
-    MergeRSMergedCoarse,
+    MergeRSMergedCards,
+    MergeRSMergedBitMap,
+    MergeRSMergedFull,
     MergeRSDirtyCards
   };
 
@@ -96,6 +96,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     ScanHRScannedCards,
     ScanHRScannedBlocks,
     ScanHRClaimedChunks,
+    ScanHRScannedBatches,
     ScanHRScannedOptRefs,
     ScanHRUsedMemory
   };
@@ -129,6 +130,8 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   double _cur_evac_fail_recalc_used;
   double _cur_evac_fail_remove_self_forwards;
+  size_t _cur_evac_fail_objects;
+  size_t _cur_evac_fail_regions;
 
   double _cur_string_deduplication_time_ms;
 
@@ -184,6 +187,8 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   size_t _cur_fast_reclaim_humongous_candidates;
   size_t _cur_fast_reclaim_humongous_reclaimed;
 
+  size_t _cur_scan_heap_roots_chunk_size;
+
   double _cur_verify_before_time_ms;
   double _cur_verify_after_time_ms;
 
@@ -308,6 +313,11 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_evac_fail_remove_self_forwards = ms;
   }
 
+  void record_evac_fail_objects(size_t objects, size_t regions) {
+    _cur_evac_fail_objects = objects;
+    _cur_evac_fail_regions = regions;
+  }
+
   void record_string_deduplication_time(double ms) {
     _cur_string_deduplication_time_ms = ms;
   }
@@ -347,6 +357,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_fast_reclaim_humongous_reclaimed = reclaimed;
   }
 
+  void record_scan_heap_roots_chunk_size(size_t chunk_size) {
+    _cur_scan_heap_roots_chunk_size = chunk_size;
+  }
+
   void record_young_cset_choice_time_ms(double time_ms) {
     _recorded_young_cset_choice_time_ms = time_ms;
   }
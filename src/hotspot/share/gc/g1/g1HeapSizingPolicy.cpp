@@ -26,6 +26,8 @@
 #include "gc/g1/g1CollectedHeap.hpp"
 #include "gc/g1/g1HeapSizingPolicy.hpp"
 #include "gc/g1/g1Analytics.hpp"
+#include "gc/g1/g1Policy.hpp"
+#include "gc/g1/heapRegion.hpp"
 #include "logging/log.hpp"
 #include "runtime/globals.hpp"
 #include "utilities/debug.hpp"
@@ -176,6 +178,18 @@ size_t G1HeapSizingPolicy::young_collection_expansion_amount() {
     // and at most the remaining uncommitted byte size.
     expand_bytes = clamp(expand_bytes, min_expand_bytes, uncommitted_bytes);
 
+    // Do not expand beyond the soft max heap size because of GC overhead.
+    // Allocation failures may still expand the heap up to its maximum size.
+    size_t soft_max_bytes = _g1h->soft_max_capacity();
+    if (committed_bytes >= soft_max_bytes) {
+      log_debug(gc, ergo, heap)("Heap expansion limited by soft max heap size. "
+                                "Capacity: " SIZE_FORMAT "B soft max: " SIZE_FORMAT "B",
+                                committed_bytes, soft_max_bytes);
+      expand_bytes = 0;
+    } else {
+      expand_bytes = MIN2(expand_bytes, soft_max_bytes - committed_bytes);
+    }
+
     clear_ratio_check_data();
   } else {
     // An expansion was not triggered. If we've started counting, increment
@@ -232,6 +246,10 @@ size_t G1HeapSizingPolicy::full_collection_resize_amount(bool& expand) {
   // it with respect to the heap min size as it's a lower bound (i.e.,
   // we'll try to make the capacity larger than it, not smaller).
   minimum_desired_capacity = MIN2(minimum_desired_capacity, MaxHeapSize);
+  // Shrink towards the soft max heap size, but not below what
+  // MinHeapFreeRatio asks for.
+  maximum_desired_capacity = MIN2(maximum_desired_capacity,
+                                  MAX2(_g1h->soft_max_capacity(), minimum_desired_capacity));
   // Should not be less than the heap min size. No need to adjust it
   // with respect to the heap max size as it's an upper bound (i.e.,
   // we'll try to make the capacity smaller than it, not greater).
@@ -266,3 +284,17 @@ size_t G1HeapSizingPolicy::full_collection_resize_amount(bool& expand) {
   return 0;
 }
 
+size_t G1HeapSizingPolicy::concurrent_uncommit_amount() {
+  assert_heap_locked();
+
+  const size_t capacity = _g1h->capacity();
+  const size_t used = capacity - _g1h->num_free_regions() * HeapRegion::GrainBytes;
+  const size_t young_target = _g1h->policy()->young_list_target_length() * HeapRegion::GrainBytes;
+
+  size_t desired_capacity = MAX2(target_heap_capacity(used, MaxHeapFreeRatio), used + young_target);
+  desired_capacity = MIN2(desired_capacity, _g1h->soft_max_capacity());
+  desired_capacity = MAX2(desired_capacity, MinHeapSize);
+
+  return capacity > desired_capacity ? capacity - desired_capacity : 0;
+}
+
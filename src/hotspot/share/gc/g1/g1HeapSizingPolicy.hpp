@@ -59,6 +59,11 @@ public:
   // Returns the amount of bytes to resize the heap; if expand is set, the heap
   // should by expanded by that amount, shrunk otherwise.
   size_t full_collection_resize_amount(bool& expand);
+  // Returns the amount of bytes of committed memory above the desired heap
+  // capacity that may be uncommitted outside of a pause. The desired capacity
+  // covers the current occupancy with MaxHeapFreeRatio, and the young gen
+  // target; it is bounded by SoftMaxHeapSize and MinHeapSize.
+  size_t concurrent_uncommit_amount();
   // Clear ratio tracking data used by expansion_amount().
   void clear_ratio_check_data();
 
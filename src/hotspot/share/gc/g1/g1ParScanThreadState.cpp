@@ -35,11 +35,14 @@
 #include "memory/allocation.inline.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/prefetch.inline.hpp"
 
 G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h,
                                            G1RedirtyCardsQueueSet* rdcqs,
                                            uint worker_id,
+                                           uint* worker_node_indexes,
+                                           uint num_workers,
                                            size_t young_cset_length,
                                            size_t optional_cset_length)
   : _g1h(g1h),
@@ -62,7 +65,13 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h,
     _old_gen_is_full(false),
     _num_optional_regions(optional_cset_length),
     _numa(g1h->numa()),
-    _obj_alloc_stat(NULL)
+    _node_index(_numa->index_of_current_thread()),
+    _obj_alloc_stat(NULL),
+    _old_obj_alloc_stat(NULL),
+    _worker_node_indexes(worker_node_indexes),
+    _num_workers(num_workers),
+    _same_node_workers(NULL),
+    _num_same_node_workers(0)
 {
   // We allocate number of young gen regions in the collection set plus one
   // entries, since entry 0 keeps track of surviving bytes for non-young regions.
@@ -86,6 +95,9 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h,
 
   _oops_into_optional_regions = new G1OopStarChunkedList[_num_optional_regions];
 
+  // Publish our node so that workers on the same node steal from us first.
+  Atomic::store(&_worker_node_indexes[worker_id], _node_index);
+
   initialize_numa_stats();
 }
 
@@ -110,6 +122,8 @@ G1ParScanThreadState::~G1ParScanThreadState() {
   FREE_C_HEAP_ARRAY(size_t, _surviving_young_words_base);
   delete[] _oops_into_optional_regions;
   FREE_C_HEAP_ARRAY(size_t, _obj_alloc_stat);
+  FREE_C_HEAP_ARRAY(size_t, _old_obj_alloc_stat);
+  FREE_C_HEAP_ARRAY(uint, _same_node_workers);
 }
 
 size_t G1ParScanThreadState::lab_waste_words() const {
@@ -273,9 +287,23 @@ void G1ParScanThreadState::trim_queue_to_threshold(uint threshold) {
 }
 
 ATTRIBUTE_FLATTEN
+void G1ParScanThreadState::initialize_same_node_workers() {
+  assert(_same_node_workers == NULL, "only once");
+  _same_node_workers = NEW_C_HEAP_ARRAY(uint, _num_workers, mtGC);
+  for (uint i = 0; i < _num_workers; i++) {
+    // Workers that have not started yet have an unknown node index.
+    if (i != _worker_id && Atomic::load(&_worker_node_indexes[i]) == _node_index) {
+      _same_node_workers[_num_same_node_workers++] = i;
+    }
+  }
+}
+
 void G1ParScanThreadState::steal_and_trim_queue(G1ScannerTasksQueueSet* task_queues) {
+  if (_numa->is_enabled() && _same_node_workers == NULL) {
+    initialize_same_node_workers();
+  }
   ScannerTask stolen_task;
-  while (task_queues->steal(_worker_id, stolen_task)) {
+  while (task_queues->steal_half(_worker_id, _same_node_workers, _num_same_node_workers, stolen_task)) {
     dispatch_task(stolen_task);
     // Processing stolen task may have added tasks to our queue.
     trim_queue();
@@ -369,7 +397,7 @@ HeapWord* G1ParScanThreadState::allocate_copy_slow(G1HeapRegionAttr* dest_attr,
     }
   }
   if (obj_ptr != NULL) {
-    update_numa_stats(node_index);
+    update_numa_stats(*dest_attr, node_index);
     if (_g1h->_gc_tracer_stw->should_report_promotion_events()) {
       // The events are checked individually as part of the actual commit
       report_promotion_event(*dest_attr, old, word_sz, age, obj_ptr, node_index);
@@ -401,6 +429,13 @@ oop G1ParScanThreadState::do_copy_to_survivor_space(G1HeapRegionAttr const regio
   HeapRegion* const from_region = _g1h->heap_region_containing(old);
   uint node_index = from_region->node_index();
 
+  // Objects in a region pinned by a JNI critical section must stay where they
+  // are. Fail their evacuation so that they are self-forwarded in place and the
+  // region is retained as an old region.
+  if (from_region->has_pinned_objects()) {
+    return handle_evacuation_failure_par(old, old_mark);
+  }
+
   HeapWord* obj_ptr = _plab_allocator->plab_allocate(dest_attr, word_sz, node_index);
 
   // PLAB allocations should succeed most of the time, so we'll
@@ -503,7 +538,8 @@ G1ParScanThreadState* G1ParScanThreadStateSet::state_for_worker(uint worker_id)
   assert(worker_id < _n_workers, "out of bounds access");
   if (_states[worker_id] == NULL) {
     _states[worker_id] =
-      new G1ParScanThreadState(_g1h, _rdcqs, worker_id, _young_cset_length, _optional_cset_length);
+      new G1ParScanThreadState(_g1h, _rdcqs, worker_id, _worker_node_indexes, _n_workers,
+                               _young_cset_length, _optional_cset_length);
   }
   return _states[worker_id];
 }
@@ -595,20 +631,28 @@ void G1ParScanThreadState::initialize_numa_stats() {
       // Record only if there are multiple active nodes.
       _obj_alloc_stat = NEW_C_HEAP_ARRAY(size_t, num_nodes, mtGC);
       memset(_obj_alloc_stat, 0, sizeof(size_t) * num_nodes);
+      _old_obj_alloc_stat = NEW_C_HEAP_ARRAY(size_t, num_nodes, mtGC);
+      memset(_old_obj_alloc_stat, 0, sizeof(size_t) * num_nodes);
     }
   }
 }
 
 void G1ParScanThreadState::flush_numa_stats() {
   if (_obj_alloc_stat != NULL) {
-    uint node_index = _numa->index_of_current_thread();
-    _numa->copy_statistics(G1NUMAStats::LocalObjProcessAtCopyToSurv, node_index, _obj_alloc_stat);
+    // Flushing happens on the VM thread, attribute the counts to the node
+    // the worker was running on.
+    _numa->copy_statistics(G1NUMAStats::LocalObjProcessAtCopyToSurv, _node_index, _obj_alloc_stat);
+    _numa->copy_statistics(G1NUMAStats::LocalObjProcessAtCopyToOld, _node_index, _old_obj_alloc_stat);
   }
 }
 
-void G1ParScanThreadState::update_numa_stats(uint node_index) {
+void G1ParScanThreadState::update_numa_stats(G1HeapRegionAttr dest_attr, uint node_index) {
   if (_obj_alloc_stat != NULL) {
-    _obj_alloc_stat[node_index]++;
+    if (dest_attr.is_young()) {
+      _obj_alloc_stat[node_index]++;
+    } else {
+      _old_obj_alloc_stat[node_index]++;
+    }
   }
 }
 
@@ -620,6 +664,7 @@ G1ParScanThreadStateSet::G1ParScanThreadStateSet(G1CollectedHeap* g1h,
     _g1h(g1h),
     _rdcqs(rdcqs),
     _states(NEW_C_HEAP_ARRAY(G1ParScanThreadState*, n_workers, mtGC)),
+    _worker_node_indexes(NEW_C_HEAP_ARRAY(uint, n_workers, mtGC)),
     _surviving_young_words_total(NEW_C_HEAP_ARRAY(size_t, young_cset_length + 1, mtGC)),
     _young_cset_length(young_cset_length),
     _optional_cset_length(optional_cset_length),
@@ -627,6 +672,7 @@ G1ParScanThreadStateSet::G1ParScanThreadStateSet(G1CollectedHeap* g1h,
     _flushed(false) {
   for (uint i = 0; i < n_workers; ++i) {
     _states[i] = NULL;
+    _worker_node_indexes[i] = G1NUMA::UnknownNodeIndex;
   }
   memset(_surviving_young_words_total, 0, (young_cset_length + 1) * sizeof(size_t));
 }
@@ -634,5 +680,6 @@ G1ParScanThreadStateSet::G1ParScanThreadStateSet(G1CollectedHeap* g1h,
 G1ParScanThreadStateSet::~G1ParScanThreadStateSet() {
   assert(_flushed, "thread local state from the per thread states should have been flushed");
   FREE_C_HEAP_ARRAY(G1ParScanThreadState*, _states);
+  FREE_C_HEAP_ARRAY(uint, _worker_node_indexes);
   FREE_C_HEAP_ARRAY(size_t, _surviving_young_words_total);
 }
@@ -95,16 +95,31 @@ class G1ParScanThreadState : public CHeapObj<mtGC> {
   G1OopStarChunkedList* _oops_into_optional_regions;
 
   G1NUMA* _numa;
+  // Node index of the worker thread when this state was created.
+  uint _node_index;
 
-  // Records how many object allocations happened at each node during copy to survivor.
-  // Only starts recording when log of gc+heap+numa is enabled and its data is
-  // transferred when flushed.
+  // Records how many object allocations happened at each node during copy to
+  // survivor and old respectively. Only starts recording when log of gc+heap+numa
+  // is enabled and its data is transferred when flushed.
   size_t* _obj_alloc_stat;
+  size_t* _old_obj_alloc_stat;
+
+  // Node index of every worker, shared by all states of the set, and the ids
+  // of the workers on the same node as this one, which are tried first when
+  // stealing. The latter is computed lazily on the first steal attempt.
+  uint* _worker_node_indexes;
+  uint _num_workers;
+  uint* _same_node_workers;
+  uint _num_same_node_workers;
+
+  void initialize_same_node_workers();
 
 public:
   G1ParScanThreadState(G1CollectedHeap* g1h,
                        G1RedirtyCardsQueueSet* rdcqs,
                        uint worker_id,
+                       uint* worker_node_indexes,
+                       uint num_workers,
                        size_t young_cset_length,
                        size_t optional_cset_length);
   virtual ~G1ParScanThreadState();
@@ -202,7 +217,7 @@ private:
   // NUMA statistics related methods.
   void initialize_numa_stats();
   void flush_numa_stats();
-  inline void update_numa_stats(uint node_index);
+  inline void update_numa_stats(G1HeapRegionAttr dest_attr, uint node_index);
 
 public:
   oop copy_to_survivor_space(G1HeapRegionAttr region_attr, oop obj, markWord old_mark);
@@ -229,6 +244,7 @@ class G1ParScanThreadStateSet : public StackObj {
   G1CollectedHeap* _g1h;
   G1RedirtyCardsQueueSet* _rdcqs;
   G1ParScanThreadState** _states;
+  uint* _worker_node_indexes;
   size_t* _surviving_young_words_total;
   size_t _young_cset_length;
   size_t _optional_cset_length;
@@ -68,6 +68,7 @@ G1Policy::G1Policy(STWGCTimer* gc_timer) :
   _survivor_surv_rate_group(new G1SurvRateGroup()),
   _reserve_factor((double) G1ReservePercent / 100.0),
   _reserve_regions(0),
+  _soft_max_capacity(0),
   _young_gen_sizer(G1YoungGenSizer::create_gen_sizer()),
   _free_regions_at_end_of_collection(0),
   _rs_length(0),
@@ -184,9 +185,16 @@ void G1Policy::record_new_heap_size(uint new_number_of_regions) {
   // smaller than 1.0) we'll get 1.
   _reserve_regions = (uint) ceil(reserve_regions_d);
 
-  _young_gen_sizer->heap_size_changed(new_number_of_regions);
+  // Size the young gen and start marking as if the heap were no larger than
+  // the soft max heap capacity, so that G1 collects more aggressively rather
+  // than growing beyond it. Called before init() during heap initialization.
+  _soft_max_capacity = G1CollectedHeap::heap()->soft_max_capacity();
+  uint soft_max_regions = (uint)(_soft_max_capacity / HeapRegion::GrainBytes);
+  uint sizing_regions = MAX2(MIN2(new_number_of_regions, soft_max_regions), 1u);
 
-  _ihop_control->update_target_occupancy(new_number_of_regions * HeapRegion::GrainBytes);
+  _young_gen_sizer->heap_size_changed(sizing_regions);
+
+  _ihop_control->update_target_occupancy(sizing_regions * HeapRegion::GrainBytes);
 }
 
 uint G1Policy::calculate_young_list_desired_min_length(uint base_min_length) const {
@@ -793,6 +801,11 @@ void G1Policy::record_collection_pause_end(double pause_time_ms) {
 
   _free_regions_at_end_of_collection = _g1h->num_free_regions();
 
+  // SoftMaxHeapSize is manageable; pick up changes made since the last resize.
+  if (_g1h->soft_max_capacity() != _soft_max_capacity) {
+    record_new_heap_size(_g1h->num_regions());
+  }
+
   update_rs_length_prediction();
 
   // Do not update dynamic IHOP due to G1 periodic collection as it is highly likely
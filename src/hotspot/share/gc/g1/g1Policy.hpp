@@ -94,6 +94,8 @@ class G1Policy: public CHeapObj<mtGC> {
   // This will be set when the heap is expanded
   // for the first time during initialization.
   uint   _reserve_regions;
+  // The soft max heap capacity at the last call to record_new_heap_size().
+  size_t _soft_max_capacity;
 
   G1YoungGenSizer* _young_gen_sizer;
 
@@ -305,7 +307,9 @@ public:
   // higher, recalculate the young list target length prediction.
   void revise_young_list_target_length_if_necessary(size_t rs_length);
 
-  // This should be called after the heap is resized.
+  // This should be called after the heap is resized. Young gen sizing and
+  // the IHOP target occupancy are based on the smaller of the new heap size
+  // and the soft max heap capacity.
   void record_new_heap_size(uint new_number_of_regions);
 
   virtual void init(G1CollectedHeap* g1h, G1CollectionSet* collection_set);
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "gc/g1/g1BarrierSet.hpp"
 #include "gc/g1/g1BlockOffsetTable.inline.hpp"
+#include "gc/g1/g1CardSet.inline.hpp"
 #include "gc/g1/g1CardTable.inline.hpp"
 #include "gc/g1/g1CardTableEntryClosure.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
@@ -41,7 +42,6 @@
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionManager.inline.hpp"
 #include "gc/g1/heapRegionRemSet.inline.hpp"
-#include "gc/g1/sparsePRT.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "gc/shared/ptrQueue.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
@@ -52,6 +52,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
+#include "runtime/prefetch.inline.hpp"
 #include "utilities/align.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/stack.inline.hpp"
@@ -622,7 +623,20 @@ public:
 };
 
 // Scans a heap region for dirty cards.
+//
+// Contiguous runs of dirty cards within a claimed chunk are gathered into
+// batches of up to MaxCardBlocksPerBatch entries. While gathering, the BOT
+// entry and the first heap word of every run are prefetched, so that the block
+// start lookups and object header accesses when processing the batch afterwards
+// are more likely to hit the cache.
 class G1ScanHRForRegionClosure : public HeapRegionClosure {
+  static const uint MaxCardBlocksPerBatch = 8;
+
+  struct CardBlock {
+    size_t _first_card;
+    size_t _num_cards;
+  };
+
   G1CollectedHeap* _g1h;
   G1CardTable* _ct;
   G1BlockOffsetTable* _bot;
@@ -638,6 +652,10 @@ class G1ScanHRForRegionClosure : public HeapRegionClosure {
   size_t _cards_scanned;
   size_t _blocks_scanned;
   size_t _chunks_claimed;
+  size_t _batches_scanned;
+
+  CardBlock _batch[MaxCardBlocksPerBatch];
+  uint _batch_length;
 
   Tickspan _rem_set_root_scan_time;
   Tickspan _rem_set_trim_partially_time;
@@ -686,6 +704,29 @@ class G1ScanHRForRegionClosure : public HeapRegionClosure {
     _blocks_scanned++;
   }
 
+  void add_to_batch(uint const region_idx, size_t const first_card, size_t const num_cards) {
+    assert(_batch_length < MaxCardBlocksPerBatch, "Batch overflow");
+    HeapWord* const card_start = _bot->address_for_index_raw(first_card);
+    if (card_start < _scan_state->scan_top(region_idx)) {
+      _bot->prefetch_entry(first_card);
+      Prefetch::read(card_start, 0);
+    }
+    _batch[_batch_length]._first_card = first_card;
+    _batch[_batch_length]._num_cards = num_cards;
+    _batch_length++;
+  }
+
+  void flush_batch(uint const region_idx) {
+    if (_batch_length == 0) {
+      return;
+    }
+    for (uint i = 0; i < _batch_length; i++) {
+      do_card_block(region_idx, _batch[i]._first_card, _batch[i]._num_cards);
+    }
+    _batch_length = 0;
+    _batches_scanned++;
+  }
+
    void scan_heap_roots(HeapRegion* r) {
     EventGCPhaseParallel event;
     uint const region_idx = r->hrm_index();
@@ -713,7 +754,10 @@ class G1ScanHRForRegionClosure : public HeapRegionClosure {
         size_t const last_scan_idx = scan.find_next_non_dirty();
         size_t const len = last_scan_idx - first_scan_idx;
 
-        do_card_block(region_idx, region_card_base_idx + first_scan_idx, len);
+        add_to_batch(region_idx, region_card_base_idx + first_scan_idx, len);
+        if (_batch_length == MaxCardBlocksPerBatch) {
+          flush_batch(region_idx);
+        }
 
         if (last_scan_idx == claim.size()) {
           break;
@@ -721,6 +765,7 @@ class G1ScanHRForRegionClosure : public HeapRegionClosure {
 
         first_scan_idx = scan.find_next_dirty();
       }
+      flush_batch(region_idx);
       _chunks_claimed++;
     }
 
@@ -742,6 +787,8 @@ public:
     _cards_scanned(0),
     _blocks_scanned(0),
     _chunks_claimed(0),
+    _batches_scanned(0),
+    _batch_length(0),
     _rem_set_root_scan_time(),
     _rem_set_trim_partially_time(),
     _scanned_to(NULL) {
@@ -766,6 +813,7 @@ public:
   size_t cards_scanned() const { return _cards_scanned; }
   size_t blocks_scanned() const { return _blocks_scanned; }
   size_t chunks_claimed() const { return _chunks_claimed; }
+  size_t batches_scanned() const { return _batches_scanned; }
 };
 
 void G1RemSet::scan_heap_roots(G1ParScanThreadState* pss,
@@ -783,6 +831,7 @@ void G1RemSet::scan_heap_roots(G1ParScanThreadState* pss,
   p->record_or_add_thread_work_item(scan_phase, worker_id, cl.cards_scanned(), G1GCPhaseTimes::ScanHRScannedCards);
   p->record_or_add_thread_work_item(scan_phase, worker_id, cl.blocks_scanned(), G1GCPhaseTimes::ScanHRScannedBlocks);
   p->record_or_add_thread_work_item(scan_phase, worker_id, cl.chunks_claimed(), G1GCPhaseTimes::ScanHRClaimedChunks);
+  p->record_or_add_thread_work_item(scan_phase, worker_id, cl.batches_scanned(), G1GCPhaseTimes::ScanHRScannedBatches);
 }
 
 // Heap region closure to be applied to all regions in the current collection set
@@ -921,9 +970,9 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
     G1RemSetScanState* _scan_state;
     G1CardTable* _ct;
 
-    uint _merged_sparse;
-    uint _merged_fine;
-    uint _merged_coarse;
+    uint _merged_cards;
+    uint _merged_bitmap;
+    uint _merged_full;
 
     size_t _cards_dirty;
 
@@ -940,29 +989,29 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
     G1MergeCardSetClosure(G1RemSetScanState* scan_state) :
       _scan_state(scan_state),
       _ct(G1CollectedHeap::heap()->card_table()),
-      _merged_sparse(0),
-      _merged_fine(0),
-      _merged_coarse(0),
+      _merged_cards(0),
+      _merged_bitmap(0),
+      _merged_full(0),
       _cards_dirty(0) { }
 
-    void next_coarse_prt(uint const region_idx) {
+    void next_full(uint const region_idx) {
       if (!remember_if_interesting(region_idx)) {
         return;
       }
 
-      _merged_coarse++;
+      _merged_full++;
 
       size_t region_base_idx = (size_t)region_idx << HeapRegion::LogCardsPerRegion;
       _cards_dirty += _ct->mark_region_dirty(region_base_idx, HeapRegion::CardsPerRegion);
       _scan_state->set_chunk_region_dirty(region_base_idx);
     }
 
-    void next_fine_prt(uint const region_idx, BitMap* bm) {
+    void next_bitmap(uint const region_idx, BitMap* bm) {
       if (!remember_if_interesting(region_idx)) {
         return;
       }
 
-      _merged_fine++;
+      _merged_bitmap++;
 
       size_t const region_base_idx = (size_t)region_idx << HeapRegion::LogCardsPerRegion;
       BitMap::idx_t cur = bm->get_next_one_offset(0);
@@ -973,12 +1022,12 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
       }
     }
 
-    void next_sparse_prt(uint const region_idx, SparsePRTEntry::card_elem_t* cards, uint const num_cards) {
+    void next_cards(uint const region_idx, const G1CardSet::CardElem* cards, uint const num_cards) {
       if (!remember_if_interesting(region_idx)) {
         return;
       }
 
-      _merged_sparse++;
+      _merged_cards++;
 
       size_t const region_base_idx = (size_t)region_idx << HeapRegion::LogCardsPerRegion;
       for (uint i = 0; i < num_cards; i++) {
@@ -993,15 +1042,15 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
 
       HeapRegionRemSet* rem_set = r->rem_set();
       if (!rem_set->is_empty()) {
-        rem_set->iterate_prts(*this);
+        rem_set->iterate_for_merge(*this);
       }
 
       return false;
     }
 
-    size_t merged_sparse() const { return _merged_sparse; }
-    size_t merged_fine() const { return _merged_fine; }
-    size_t merged_coarse() const { return _merged_coarse; }
+    size_t merged_cards() const { return _merged_cards; }
+    size_t merged_bitmap() const { return _merged_bitmap; }
+    size_t merged_full() const { return _merged_full; }
 
     size_t cards_dirty() const { return _cards_dirty; }
   };
@@ -1046,9 +1095,9 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
       return false;
     }
 
-    size_t merged_sparse() const { return _cl.merged_sparse(); }
-    size_t merged_fine() const { return _cl.merged_fine(); }
-    size_t merged_coarse() const { return _cl.merged_coarse(); }
+    size_t merged_cards() const { return _cl.merged_cards(); }
+    size_t merged_bitmap() const { return _cl.merged_bitmap(); }
+    size_t merged_full() const { return _cl.merged_full(); }
 
     size_t cards_dirty() const { return _cl.cards_dirty(); }
   };
@@ -1149,9 +1198,9 @@ public:
       G1FlushHumongousCandidateRemSets cl(_scan_state);
       g1h->heap_region_iterate(&cl);
 
-      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_sparse(), G1GCPhaseTimes::MergeRSMergedSparse);
-      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_fine(), G1GCPhaseTimes::MergeRSMergedFine);
-      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_coarse(), G1GCPhaseTimes::MergeRSMergedCoarse);
+      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_cards(), G1GCPhaseTimes::MergeRSMergedCards);
+      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_bitmap(), G1GCPhaseTimes::MergeRSMergedBitMap);
+      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_full(), G1GCPhaseTimes::MergeRSMergedFull);
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.cards_dirty(), G1GCPhaseTimes::MergeRSDirtyCards);
     }
 
@@ -1161,9 +1210,9 @@ public:
       G1MergeCardSetClosure cl(_scan_state);
       g1h->collection_set_iterate_increment_from(&cl, &_hr_claimer, worker_id);
 
-      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_sparse(), G1GCPhaseTimes::MergeRSMergedSparse);
-      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_fine(), G1GCPhaseTimes::MergeRSMergedFine);
-      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_coarse(), G1GCPhaseTimes::MergeRSMergedCoarse);
+      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_cards(), G1GCPhaseTimes::MergeRSMergedCards);
+      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_bitmap(), G1GCPhaseTimes::MergeRSMergedBitMap);
+      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_full(), G1GCPhaseTimes::MergeRSMergedFull);
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.cards_dirty(), G1GCPhaseTimes::MergeRSDirtyCards);
     }
 
@@ -1220,6 +1269,7 @@ void G1RemSet::merge_heap_roots(bool initial_evacuation) {
     Tickspan total = Ticks::now() - start;
     if (initial_evacuation) {
       g1h->phase_times()->record_prepare_merge_heap_roots_time(total.seconds() * 1000.0);
+      g1h->phase_times()->record_scan_heap_roots_chunk_size(_scan_state->scan_chunk_size());
     } else {
       g1h->phase_times()->record_or_add_optional_prepare_merge_heap_roots_time(total.seconds() * 1000.0);
     }
@@ -1284,13 +1334,6 @@ bool G1RemSet::clean_card_before_refine(CardValue** const card_ptr_addr) {
 
   check_card_ptr(card_ptr, _ct);
 
-  // If the card is no longer dirty, nothing to do.
-  // We cannot load the card value before the "r == NULL" check, because G1
-  // could uncommit parts of the card table covering uncommitted regions.
-  if (*card_ptr != G1CardTable::dirty_card_val()) {
-    return false;
-  }
-
   // This check is needed for some uncommon cases where we should
   // ignore the card.
   //
@@ -1310,10 +1353,23 @@ bool G1RemSet::clean_card_before_refine(CardValue** const card_ptr_addr) {
   // In the normal (non-stale) case, the synchronization between the
   // enqueueing of the card and processing it here will have ensured
   // we see the up-to-date region type here.
+  //
+  // Free regions may also be uncommitted concurrently (G1ConcurrentUncommit),
+  // together with their part of the card table, so the region type must be
+  // checked before loading the card value. Old, humongous and archive regions
+  // only become free during a pause, which refinement does not run in.
   if (!r->is_old_or_humongous_or_archive()) {
     return false;
   }
 
+  // If the card is no longer dirty, nothing to do.
+  // We cannot load the card value before the "r == NULL" and region type
+  // checks, because G1 could uncommit parts of the card table covering
+  // uncommitted regions.
+  if (*card_ptr != G1CardTable::dirty_card_val()) {
+    return false;
+  }
+
   // The result from the hot card cache insert call is either:
   //   * pointer to the current card
   //     (implying that the current card is not 'hot'),
@@ -193,6 +193,8 @@ private:
   RegionTypeCounter _archive;
   RegionTypeCounter _all;
 
+  G1CardSetStats _card_set_stats;
+
   size_t _max_rs_mem_sz;
   HeapRegion* _max_rs_mem_sz_region;
 
@@ -214,6 +216,7 @@ private:
 public:
   HRRSStatsIter() : _young("Young"), _humongous("Humongous"),
     _free("Free"), _old("Old"), _archive("Archive"), _all("All"),
+    _card_set_stats(),
     _max_rs_mem_sz(0), _max_rs_mem_sz_region(NULL),
     _max_code_root_mem_sz(0), _max_code_root_mem_sz_region(NULL)
   {}
@@ -235,6 +238,7 @@ public:
       _max_code_root_mem_sz_region = r;
     }
     size_t code_root_elems = hrrs->strong_code_roots_list_length();
+    hrrs->collect_card_set_stats(&_card_set_stats);
 
     RegionTypeCounter* current = NULL;
     if (r->is_free()) {
@@ -270,12 +274,10 @@ public:
       (*current)->print_rs_mem_info_on(out, total_rs_mem_sz());
     }
 
-    out->print_cr("   Static structures = " SIZE_FORMAT "%s,"
-                  " free_lists = " SIZE_FORMAT "%s.",
+    out->print_cr("   Static structures = " SIZE_FORMAT "%s.",
                   byte_size_in_proper_unit(HeapRegionRemSet::static_mem_size()),
-                  proper_unit_for_byte_size(HeapRegionRemSet::static_mem_size()),
-                  byte_size_in_proper_unit(HeapRegionRemSet::fl_mem_size()),
-                  proper_unit_for_byte_size(HeapRegionRemSet::fl_mem_size()));
+                  proper_unit_for_byte_size(HeapRegionRemSet::static_mem_size()));
+    _card_set_stats.print_on(out);
 
     out->print_cr("    " SIZE_FORMAT " occupied cards represented.",
                   total_cards_occupied());
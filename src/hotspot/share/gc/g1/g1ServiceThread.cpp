@@ -32,6 +32,7 @@
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
+#include "logging/log.hpp"
 #include "memory/universe.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
@@ -43,6 +44,7 @@ G1ServiceThread::G1ServiceThread() :
              true,
              Monitor::_safepoint_check_never),
     _last_periodic_gc_attempt_s(os::elapsedTime()),
+    _excess_capacity_since_s(0.0),
     _vtime_accum(0) {
   set_name("G1 Service");
   create_and_start();
@@ -100,9 +102,64 @@ void G1ServiceThread::check_for_periodic_gc(){
   }
 }
 
+void G1ServiceThread::check_for_uncommit() {
+  if (!G1ConcurrentUncommit) {
+    return;
+  }
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  if (g1h->concurrent_uncommit_amount() == 0) {
+    _excess_capacity_since_s = 0.0;
+    return;
+  }
+  double now = os::elapsedTime();
+  if (_excess_capacity_since_s == 0.0) {
+    _excess_capacity_since_s = now;
+  }
+  // Only give back memory that has been unused for a while, and only a
+  // bounded amount per iteration to keep Heap_lock hold times short.
+  if ((now - _excess_capacity_since_s) >= (double)G1UncommitDelay) {
+    g1h->uncommit_free_regions(G1UncommitChunkSize);
+  }
+}
+
+// Touch the committed heap regions while the application runs. The thread
+// is part of the suspendible thread set, so regions can only be uncommitted
+// at the safepoints it yields to; availability is checked again after every
+// yield. Concurrent uncommit is done by this thread as well.
+void G1ServiceThread::pretouch_heap() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  HeapRegionManager* hrm = g1h->hrm();
+  const size_t page_size = os::vm_page_size();
+  const size_t chunk_size = align_up(MIN2(PreTouchParallelChunkSize, HeapRegion::GrainBytes), page_size);
+  double start = os::elapsedTime();
+  size_t touched = 0;
+
+  SuspendibleThreadSetJoiner sts;
+  for (uint i = 0; i < g1h->max_regions() && !should_terminate(); i++) {
+    char* cur = (char*)g1h->bottom_addr_for_region(i);
+    char* const end = cur + HeapRegion::GrainBytes;
+    while (cur < end && hrm->is_available(i)) {
+      char* chunk_end = MIN2(cur + chunk_size, end);
+      os::pretouch_memory(cur, chunk_end, page_size);
+      touched += pointer_delta(chunk_end, cur, sizeof(char));
+      cur = chunk_end;
+      if (sts.should_yield()) {
+        sts.yield();
+      }
+    }
+  }
+
+  log_info(gc, heap)("Pre-touched " SIZE_FORMAT "M of heap in background in %.3fs",
+                     touched / M, os::elapsedTime() - start);
+}
+
 void G1ServiceThread::run_service() {
   double vtime_start = os::elapsedVTime();
 
+  if (AlwaysPreTouch && G1PreTouchInBackground) {
+    pretouch_heap();
+  }
+
   while (!should_terminate()) {
     sample_young_list_rs_length();
 
@@ -114,6 +171,8 @@ void G1ServiceThread::run_service() {
 
     check_for_periodic_gc();
 
+    check_for_uncommit();
+
     sleep_before_next_cycle();
   }
 }
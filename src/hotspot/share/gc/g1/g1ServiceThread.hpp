@@ -32,11 +32,16 @@
 //   - re-assess the validity of the prediction for the
 //     remembered set lengths of the young generation.
 //   - check if a periodic GC should be scheduled.
+//   - uncommit excess free regions if G1ConcurrentUncommit is enabled.
+//   - pre-touch the initial heap at startup if G1PreTouchInBackground is enabled.
 class G1ServiceThread: public ConcurrentGCThread {
 private:
   Monitor _monitor;
 
   double _last_periodic_gc_attempt_s;
+  // Time at which the heap was first found to have excess committed
+  // capacity, or 0 if there is currently none.
+  double _excess_capacity_since_s;
 
   double _vtime_accum;  // Accumulated virtual time.
 
@@ -53,8 +58,12 @@ private:
   // increase the young gen size to keep pause time length goal.
   void sample_young_list_rs_length();
 
+  // Pre-touch the committed heap for AlwaysPreTouch with G1PreTouchInBackground.
+  void pretouch_heap();
+
   void run_service();
   void check_for_periodic_gc();
+  void check_for_uncommit();
 
   void stop_service();
 
@@ -73,6 +73,11 @@
           "draining concurrent marking work queues.")                       \
           range(1, INT_MAX)                                                 \
                                                                             \
+  product(uint, G1MarkPrefetchWindow, 8, EXPERIMENTAL,                      \
+          "The number of entries concurrent marking pops from its local "   \
+          "queue and prefetches ahead of scanning them (0 means off).")     \
+          range(0, 64)                                                      \
+                                                                            \
   product(bool, G1UseReferencePrecleaning, true, EXPERIMENTAL,              \
                "Concurrently preclean java.lang.ref.references instances "  \
                "before the Remark pause.")                                  \
@@ -158,18 +163,20 @@
           range(1, max_jint/wordSize)                                       \
                                                                             \
   product(intx, G1RSetRegionEntries, 0,                                     \
-          "Max number of regions for which we keep bitmaps."                \
+          "Max number of regions for which a remembered set keeps bitmaps. "\
+          "Further regions are coarsened to cover the whole region. "       \
           "Will be set ergonomically by default")                           \
           range(0, max_jint/wordSize)                                       \
           constraint(G1RSetRegionEntriesConstraintFunc,AfterErgo)           \
                                                                             \
   develop(intx, G1RSetSparseRegionEntriesBase, 4,                           \
-          "Max number of entries per region in a sparse table "             \
-          "per MB.")                                                        \
+          "Max number of cards per region in a remembered set array "       \
+          "container per MB.")                                              \
           range(1, max_jint/wordSize)                                       \
                                                                             \
   product(intx, G1RSetSparseRegionEntries, 0,                               \
-          "Max number of entries per region in a sparse table."             \
+          "Max number of cards per region in a remembered set array "       \
+          "container. "                                                     \
           "Will be set ergonomically by default.")                          \
           range(0, max_jint/wordSize)                                       \
           constraint(G1RSetSparseRegionEntriesConstraintFunc,AfterErgo)     \
@@ -240,6 +247,10 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  product(bool, G1EagerReclaimHumongousObjArrays, true, EXPERIMENTAL,       \
+          "Try to reclaim dead large object arrays, and not only primitive "\
+          "arrays, at every young GC.")                                     \
+                                                                            \
   product(size_t, G1RebuildRemSetChunkSize, 256 * K, EXPERIMENTAL,          \
           "Chunk size used for rebuilding the remembered set.")             \
           range(4 * K, 32 * M)                                              \
@@ -304,6 +315,24 @@
           "disables this check.")                                           \
           range(0.0, (double)max_uintx)                                     \
                                                                             \
+  product(bool, G1ConcurrentUncommit, false, EXPERIMENTAL,                  \
+          "Uncommit free regions outside of pauses when the heap capacity " \
+          "has exceeded its desired size for G1UncommitDelay seconds")      \
+                                                                            \
+  product(uintx, G1UncommitDelay, 300, EXPERIMENTAL,                        \
+          "Number of seconds the heap capacity must exceed its desired "    \
+          "size before free regions are uncommitted concurrently")          \
+                                                                            \
+  product(size_t, G1UncommitChunkSize, 64 * M, EXPERIMENTAL,                \
+          "Maximum amount of memory uncommitted in one step of concurrent " \
+          "uncommit")                                                       \
+          range(1, max_uintx)                                               \
+                                                                            \
+  product(bool, G1PreTouchInBackground, false, EXPERIMENTAL,               \
+          "With AlwaysPreTouch, pre-touch the initial heap from the "       \
+          "service thread after startup instead of during heap "           \
+          "initialization")                                                 \
+                                                                            \
   product(uintx, G1YoungExpansionBufferPercent, 10, EXPERIMENTAL,           \
                "When heterogenous heap is enabled by AllocateOldGenAt "     \
                "option, after every GC, young gen is re-sized which "       \
@@ -122,6 +122,8 @@ void HeapRegion::hr_clear(bool clear_space) {
          "we should have already filtered out humongous regions");
   assert(!in_collection_set(),
          "Should not clear heap region %u in the collection set", hrm_index());
+  assert(!has_pinned_objects(),
+         "Should not clear heap region %u with pinned objects", hrm_index());
 
   clear_young_index_in_cset();
   clear_index_in_opt_cset();
@@ -246,6 +248,7 @@ HeapRegion::HeapRegion(uint hrm_index,
   _humongous_start_region(NULL),
   _evacuation_failed(false),
   _index_in_opt_cset(InvalidCSetIndex),
+  _pinned_object_count(0),
   _next(NULL), _prev(NULL),
 #ifdef ASSERT
   _containing_set(NULL),
@@ -195,6 +195,15 @@ public:
     _bot_part.reset_bot();
   }
 
+  // Update the BOT for a block without using the threshold; see
+  // G1BlockOffsetTablePart::update_for_block().
+  void update_bot_for_block(HeapWord* start, HeapWord* end) {
+    _bot_part.update_for_block(start, end);
+  }
+  void set_bot_threshold_at(HeapWord* addr) {
+    _bot_part.set_threshold_at(addr);
+  }
+
 private:
   // The remembered set for this region.
   HeapRegionRemSet* _rem_set;
@@ -216,6 +225,10 @@ private:
   // is considered optional during a mixed collections.
   uint _index_in_opt_cset;
 
+  // Number of objects in this region currently pinned by JNI critical
+  // sections. Objects in a region with pinned objects are not moved.
+  volatile size_t _pinned_object_count;
+
   // Fields used by the HeapRegionSetBase class and subclasses.
   HeapRegion* _next;
   HeapRegion* _prev;
@@ -526,6 +539,14 @@ public:
   void set_index_in_opt_cset(uint index) { _index_in_opt_cset = index; }
   void clear_index_in_opt_cset() { _index_in_opt_cset = InvalidCSetIndex; }
 
+  // Pinning of individual objects by JNI critical sections. Unlike is_pinned(),
+  // which depends on the region type, this is a transient property: while the
+  // count is non-zero no object in the region may be moved.
+  inline size_t pinned_object_count() const;
+  inline bool has_pinned_objects() const;
+  inline void increment_pinned_object_count();
+  inline void decrement_pinned_object_count();
+
   void calc_gc_efficiency(void);
   double gc_efficiency() const { return _gc_efficiency;}
 
@@ -371,6 +371,23 @@ HeapWord* HeapRegion::oops_on_memregion_seq_iterate_careful(MemRegion mr,
   }
 }
 
+inline size_t HeapRegion::pinned_object_count() const {
+  return Atomic::load(&_pinned_object_count);
+}
+
+inline bool HeapRegion::has_pinned_objects() const {
+  return pinned_object_count() != 0;
+}
+
+inline void HeapRegion::increment_pinned_object_count() {
+  Atomic::inc(&_pinned_object_count);
+}
+
+inline void HeapRegion::decrement_pinned_object_count() {
+  assert(has_pinned_objects(), "Region %u has no pinned objects", hrm_index());
+  Atomic::dec(&_pinned_object_count);
+}
+
 inline int HeapRegion::age_in_surv_rate_group() const {
   assert(has_surv_rate_group(), "pre-condition");
   assert(has_valid_age_in_surv_rate(), "pre-condition");
@@ -36,6 +36,7 @@
 #include "memory/allocation.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/safepoint.hpp"
 #include "utilities/bitMap.inline.hpp"
 
 class MasterFreeRegionListChecker : public HeapRegionSetChecker {
@@ -567,6 +568,36 @@ uint HeapRegionManager::shrink_by(uint num_regions_to_remove) {
   return removed;
 }
 
+uint HeapRegionManager::uncommit_free_regions(uint num_regions_to_remove) {
+  assert_heap_locked();
+  assert(!SafepointSynchronize::is_at_safepoint(), "use shrink_by() in a pause");
+
+  uint removed = 0;
+  uint cur = _allocated_heapregions_length;
+  // Never remove the last region.
+  while (removed < num_regions_to_remove && cur > 0 && length() > 1) {
+    cur--;
+    if (!is_available(cur) || !at(cur)->is_free()) {
+      continue;
+    }
+    // Extend the range of free regions downwards. The free list is ordered,
+    // so the regions in the range are consecutive in it.
+    const uint end = cur + 1;
+    const uint limit = MIN2(num_regions_to_remove - removed, length() - 1);
+    while (cur > 0 && end - cur < limit && is_available(cur - 1) && at(cur - 1)->is_free()) {
+      cur--;
+    }
+    const uint num_regions = end - cur;
+    _free_list.remove_starting_at(at(cur), num_regions);
+    uncommit_regions(cur, num_regions);
+    removed += num_regions;
+  }
+
+  verify_optional();
+
+  return removed;
+}
+
 void HeapRegionManager::shrink_at(uint index, size_t num_regions) {
 #ifdef ASSERT
   for (uint i = index; i < (index + num_regions); i++) {
@@ -292,6 +292,12 @@ public:
   // Return the actual number of uncommitted regions.
   virtual uint shrink_by(uint num_regions_to_remove);
 
+  // Uncommit up to num_regions_to_remove free regions outside of a pause,
+  // starting from the end of the heap. The regions are taken off the free
+  // list first so they can not be allocated concurrently. Must be called
+  // with the Heap_lock held. Returns the number of regions uncommitted.
+  uint uncommit_free_regions(uint num_regions_to_remove);
+
   // Uncommit a number of regions starting at the specified index, which must be available,
   // empty, and free.
   void shrink_at(uint index, size_t num_regions);
@@ -45,6 +45,7 @@
 #include "memory/metaspaceCounters.hpp"
 #include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/vmThread.hpp"
@@ -610,6 +611,27 @@ void ParallelScavengeHeap::gc_threads_do(ThreadClosure* tc) const {
   ParallelScavengeHeap::heap()->workers().threads_do(tc);
 }
 
+HeapWord* ParallelScavengeHeap::allocate_loaded_archive_space(size_t word_size) {
+  MutexLocker ml(Heap_lock);
+  // The dense prefix of the old generation, which starts with the
+  // objects placed there first and kept alive, is never moved.
+  if (old_gen()->used_in_words() != 0) {
+    return NULL;
+  }
+  return old_gen()->allocate(word_size);
+}
+
+void ParallelScavengeHeap::complete_loaded_archive_space(MemRegion archive_space) {
+  assert(old_gen()->object_space()->used_region().contains(archive_space),
+         "should be in the old generation");
+  // The allocation recorded only the start of the whole space.
+  HeapWord* cur = archive_space.start();
+  while (cur < archive_space.end()) {
+    old_gen()->start_array()->allocate_block(cur);
+    cur += oop(cur)->size();
+  }
+}
+
 void ParallelScavengeHeap::print_tracing_info() const {
   AdaptiveSizePolicyOutput::print();
   log_debug(gc, heap, exit)("Accumulated young generation GC time %3.7f secs", PSScavenge::accumulated_time()->seconds());
@@ -692,13 +714,48 @@ PSCardTable* ParallelScavengeHeap::card_table() {
   return static_cast<PSCardTable*>(barrier_set()->card_table());
 }
 
+size_t ParallelScavengeHeap::soft_max_capacity() const {
+  // SoftMaxHeapSize is manageable and may change at any time.
+  return MAX2(Atomic::load(&SoftMaxHeapSize), MinHeapSize);
+}
+
 void ParallelScavengeHeap::resize_young_gen(size_t eden_size,
                                             size_t survivor_size) {
+  // Keep the young generation within what the soft max heap size leaves
+  // after the old generation. Eden is never sized below its current use.
+  size_t soft_max = soft_max_capacity();
+  if (soft_max < MaxHeapSize) {
+    size_t old_capacity = _old_gen->capacity_in_bytes();
+    size_t young_limit = soft_max > old_capacity ? soft_max - old_capacity : 0;
+    size_t eden_limit = young_limit > 2 * survivor_size ? young_limit - 2 * survivor_size : 0;
+    eden_limit = MAX2(eden_limit, _young_gen->eden_space()->used_in_bytes());
+    if (eden_size > eden_limit) {
+      log_debug(gc, ergo)("Desired eden size " SIZE_FORMAT " limited to " SIZE_FORMAT
+                          " by soft max heap size " SIZE_FORMAT,
+                          eden_size, eden_limit, soft_max);
+      eden_size = eden_limit;
+    }
+  }
   // Delegate the resize to the generation.
   _young_gen->resize(eden_size, survivor_size);
 }
 
 void ParallelScavengeHeap::resize_old_gen(size_t desired_free_space) {
+  // Keep the old generation within what the soft max heap size leaves
+  // after the young generation, but leave room for at least the padded
+  // average promotion so that scavenges are still attempted.
+  size_t soft_max = soft_max_capacity();
+  if (soft_max < MaxHeapSize) {
+    size_t committed = _young_gen->capacity_in_bytes() + _old_gen->used_in_bytes();
+    size_t free_limit = soft_max > committed ? soft_max - committed : 0;
+    free_limit = MAX2(free_limit, _size_policy->padded_average_promoted_in_bytes());
+    if (desired_free_space > free_limit) {
+      log_debug(gc, ergo)("Desired old gen free space " SIZE_FORMAT " limited to " SIZE_FORMAT
+                          " by soft max heap size " SIZE_FORMAT,
+                          desired_free_space, free_limit, soft_max);
+      desired_free_space = free_limit;
+    }
+  }
   // Delegate the resize to the generation.
   _old_gen->resize(desired_free_space);
 }
@@ -222,6 +222,11 @@ class ParallelScavengeHeap : public CollectedHeap {
 
   virtual WorkGang* safepoint_workers() { return &_workers; }
 
+  // Support for loading CDS archived heap objects.
+  virtual bool can_load_archived_objects() const { return true; }
+  virtual HeapWord* allocate_loaded_archive_space(size_t word_size);
+  virtual void complete_loaded_archive_space(MemRegion archive_space);
+
   PreGenGCValues get_pre_gc_values() const;
   void print_heap_change(const PreGenGCValues& pre_gc_values) const;
 
@@ -232,12 +237,18 @@ class ParallelScavengeHeap : public CollectedHeap {
 
   // Resize the young generation.  The reserved space for the
   // generation may be expanded in preparation for the resize.
+  // The desired sizes are limited by SoftMaxHeapSize.
   void resize_young_gen(size_t eden_size, size_t survivor_size);
 
   // Resize the old generation.  The reserved space for the
   // generation may be expanded in preparation for the resize.
+  // The desired free space is limited by SoftMaxHeapSize.
   void resize_old_gen(size_t desired_free_space);
 
+  // The committed heap size the adaptive size policy tries to stay within.
+  // Allocation failures may still expand the heap beyond it.
+  size_t soft_max_capacity() const;
+
   // Save the tops of the spaces in all generations
   void record_gen_tops_before_GC() PRODUCT_RETURN;
 
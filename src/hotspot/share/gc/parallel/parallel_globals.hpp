@@ -55,6 +55,12 @@
           "limiter (a number between 0-100)")                               \
           range(0, 100)                                                     \
                                                                             \
+  product(uintx, ParallelOldFileBackedDeadRatio, 10, EXPERIMENTAL,        \
+          "The percentage of the old generation that full collections "     \
+          "may leave as dead space when it is allocated on a file with "    \
+          "AllocateOldGenAt, to avoid moving objects on slower memory")     \
+          range(0, 100)                                                     \
+                                                                            \
   develop(uintx, GCWorkerDelayMillis, 0,                                    \
           "Delay in scheduling GC workers (in milliseconds)")               \
                                                                             \
@@ -951,6 +951,57 @@ void PSParallelCompact::initialize_dead_wood_limiter()
   _dwl_adjustment = normal_distribution(1.0);
 }
 
+// Clears the marking bitmap and the summary data covering a range of regions.
+// The marking bitmap of a large heap is big enough for clearing it serially
+// to dominate the end of a full GC, so the range is cleared in chunks
+// claimed by the GC workers.
+class PCClearDataTask : public AbstractGangTask {
+  typedef ParMarkBitMap::idx_t idx_t;
+
+  // 32M of heap per chunk with 64-bit words
+  static const size_t RegionsPerChunk = 64;
+
+  const size_t    _beg_region;
+  const size_t    _end_region;
+  const idx_t     _beg_bit;
+  const idx_t     _end_bit;
+  volatile size_t _claimed;
+
+public:
+  PCClearDataTask(size_t beg_region, size_t end_region, idx_t beg_bit, idx_t end_bit) :
+      AbstractGangTask("PCClearDataTask"),
+      _beg_region(beg_region),
+      _end_region(end_region),
+      _beg_bit(beg_bit),
+      _end_bit(end_bit),
+      _claimed(beg_region) {}
+
+  size_t num_chunks() const {
+    return (_end_region - _beg_region + RegionsPerChunk - 1) / RegionsPerChunk;
+  }
+
+  virtual void work(uint worker_id) {
+    ParMarkBitMap* const bitmap = PSParallelCompact::mark_bitmap();
+    ParallelCompactData& sd = PSParallelCompact::summary_data();
+
+    for (size_t beg = Atomic::fetch_and_add(&_claimed, RegionsPerChunk);
+         beg < _end_region;
+         beg = Atomic::fetch_and_add(&_claimed, RegionsPerChunk)) {
+      const size_t end = MIN2(beg + RegionsPerChunk, _end_region);
+      sd.clear_range(beg, end);
+
+      // The bitmap is only cleared up to the old top, which may end
+      // before the summary data range does.
+      const idx_t beg_bit = MAX2(_beg_bit, bitmap->addr_to_bit(sd.region_to_addr(beg)));
+      const idx_t end_bit = (end == _end_region) ? _end_bit :
+                            MIN2(_end_bit, bitmap->addr_to_bit(sd.region_to_addr(end)));
+      if (beg_bit < end_bit) {
+        bitmap->clear_range(beg_bit, end_bit);
+      }
+    }
+  }
+};
+
 void
 PSParallelCompact::clear_data_covering_space(SpaceId id)
 {
@@ -965,12 +1016,20 @@ PSParallelCompact::clear_data_covering_space(SpaceId id)
 
   const idx_t beg_bit = _mark_bitmap.addr_to_bit(bot);
   const idx_t end_bit = _mark_bitmap.align_range_end(_mark_bitmap.addr_to_bit(top));
-  _mark_bitmap.clear_range(beg_bit, end_bit);
 
   const size_t beg_region = _summary_data.addr_to_region_idx(bot);
   const size_t end_region =
     _summary_data.addr_to_region_idx(_summary_data.region_align_up(max_top));
-  _summary_data.clear_range(beg_region, end_region);
+  assert(beg_bit == end_bit || beg_region < end_region, "bitmap range outside of summary range");
+
+  if (beg_region < end_region) {
+    PCClearDataTask task(beg_region, end_region, beg_bit, end_bit);
+    if (task.num_chunks() > 1) {
+      ParallelScavengeHeap::heap()->workers().run_task(&task);
+    } else {
+      task.work(0);
+    }
+  }
 
   // Clear the data used to 'split' regions.
   SplitInfo& split_info = _space_info[id].split_info();
@@ -1057,6 +1116,12 @@ void PSParallelCompact::post_compact()
   }
 
   // Delete metaspaces for unloaded class loaders and clean up loader_data graph
+  if (DeferClassUnloadingPurge &&
+      !GCCause::is_metadata_allocation_failure_gc(heap->gc_cause())) {
+    // The ServiceThread deletes the unloaded class loaders after the pause.
+    // A failed metadata allocation needs the space back before it retries.
+    ClassLoaderDataGraph::defer_purge();
+  }
   ClassLoaderDataGraph::purge(/*at_safepoint*/true);
   MetaspaceUtils::verify_metrics();
 
@@ -1407,7 +1472,11 @@ PSParallelCompact::compute_dense_prefix(const SpaceId id,
   const size_t space_capacity = space->capacity_in_words();
 
   const double density = double(space_live) / double(space_capacity);
-  const size_t min_percent_free = MarkSweepDeadRatio;
+  // Compacting an old generation on NV-DIMM writes to media that is slower
+  // than DRAM and wears out; allow more dead space to stay in the prefix.
+  const bool file_backed = id == old_space_id && AllocateOldGenAt != NULL;
+  const size_t min_percent_free = file_backed ? MAX2(MarkSweepDeadRatio, ParallelOldFileBackedDeadRatio)
+                                              : MarkSweepDeadRatio;
   const double limiter = dead_wood_limiter(density, min_percent_free);
   const size_t dead_wood_max = space_used - space_live;
   const size_t dead_wood_limit = MIN2(size_t(space_capacity * limiter),
@@ -30,6 +30,7 @@
 #include "gc/parallel/psPromotionManager.inline.hpp"
 #include "gc/parallel/psScavenge.inline.hpp"
 #include "gc/shared/gcTrace.hpp"
+#include "gc/shared/plab.hpp"
 #include "gc/shared/preservedMarks.inline.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
 #include "logging/log.hpp"
@@ -121,6 +122,9 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
       promotion_failure_occurred = true;
     }
     manager->flush_labs();
+    if (ResizePLAB) {
+      manager->resize_old_plab(i);
+    }
   }
   if (!promotion_failure_occurred) {
     // If there was no promotion failure, the preserved mark stacks
@@ -183,7 +187,10 @@ PSPromotionManager::reset_stats() {
 }
 #endif // TASKQUEUE_STATS
 
-PSPromotionManager::PSPromotionManager() {
+PSPromotionManager::PSPromotionManager() :
+    _old_plab_size(OldPLABSize),
+    _promoted_words(0),
+    _promoted_words_avg(PLABWeight) {
   ParallelScavengeHeap* heap = ParallelScavengeHeap::heap();
 
   // We set the old lab's start array.
@@ -226,12 +233,32 @@ void PSPromotionManager::reset() {
   lab_base = old_gen()->object_space()->top();
   _old_lab.initialize(MemRegion(lab_base, (size_t)0));
   _old_gen_is_full = false;
+  _promoted_words = 0;
 
   _promotion_failed_info.reset();
 
   TASKQUEUE_STATS_ONLY(reset_stats());
 }
 
+// Size the old PLABs of this manager so that the space left unused at the
+// end of its last PLAB is about TargetPLABWastePct of what it promotes. The
+// amount promoted varies a lot between workers, so a single fixed size either
+// makes busy workers contend on the old gen top, or wastes space in the PLABs
+// of idle ones.
+void PSPromotionManager::resize_old_plab(uint index) {
+  _promoted_words_avg.sample((float)_promoted_words);
+
+  // On average half of the last PLAB is wasted.
+  const size_t target_refills = MAX2((size_t)1, (size_t)(100 / (2 * TargetPLABWastePct)));
+  const size_t desired = (size_t)_promoted_words_avg.average() / target_refills;
+  _old_plab_size = align_object_size(clamp(desired, PLAB::min_size(), PLAB::max_size()));
+
+  log_trace(gc, plab)("Old PLAB worker %u: promoted: " SIZE_FORMAT "B avg: " SIZE_FORMAT "B size: " SIZE_FORMAT "B",
+                      index, _promoted_words * HeapWordSize,
+                      (size_t)_promoted_words_avg.average() * HeapWordSize,
+                      _old_plab_size * HeapWordSize);
+}
+
 void PSPromotionManager::register_preserved_marks(PreservedMarks* preserved_marks) {
   assert(_preserved_marks == NULL, "do not set it twice");
   _preserved_marks = preserved_marks;
@@ -27,6 +27,7 @@
 
 #include "gc/parallel/psPromotionLAB.hpp"
 #include "gc/shared/copyFailedInfo.hpp"
+#include "gc/shared/gcUtil.hpp"
 #include "gc/shared/gcTrace.hpp"
 #include "gc/shared/preservedMarks.hpp"
 #include "gc/shared/taskqueue.hpp"
@@ -82,6 +83,12 @@ class PSPromotionManager {
   bool                                _young_gen_is_full;
   bool                                _old_gen_is_full;
 
+  // Size of the old gen promotion LABs, adapted to the amount this
+  // manager promotes if ResizePLAB is set.
+  size_t                              _old_plab_size;
+  size_t                              _promoted_words;
+  AdaptiveWeightedAverage             _promoted_words_avg;
+
   PSScannerTasksQueue                 _claimed_stack_depth;
   OverflowTaskQueue<oop, mtGC>        _claimed_stack_breadth;
 
@@ -112,6 +119,8 @@ class PSPromotionManager {
 
   static PSScannerTasksQueueSet* stack_array_depth() { return _stack_array_depth; }
 
+  void resize_old_plab(uint index);
+
  public:
   // Static
   static void initialize();
@@ -194,7 +194,7 @@ inline oop PSPromotionManager::copy_to_survivor_space(oop o) {
       if (new_obj == NULL) {
         if (!_old_gen_is_full) {
           // Do we allocate directly, or flush and refill?
-          if (new_obj_size > (OldPLABSize / 2)) {
+          if (new_obj_size > (_old_plab_size / 2)) {
             // Allocate this object directly
             new_obj = (oop)old_gen()->cas_allocate(new_obj_size);
             promotion_trace_event(new_obj, o, new_obj_size, age, true, NULL);
@@ -202,7 +202,7 @@ inline oop PSPromotionManager::copy_to_survivor_space(oop o) {
             // Flush and fill
             _old_lab.flush();
 
-            HeapWord* lab_base = old_gen()->cas_allocate(OldPLABSize);
+            HeapWord* lab_base = old_gen()->cas_allocate(_old_plab_size);
             if(lab_base != NULL) {
 #ifdef ASSERT
               // Delay the initialization of the promotion lab (plab).
@@ -211,10 +211,14 @@ inline oop PSPromotionManager::copy_to_survivor_space(oop o) {
                 os::naked_sleep(GCWorkerDelayMillis);
               }
 #endif
-              _old_lab.initialize(MemRegion(lab_base, OldPLABSize));
+              _old_lab.initialize(MemRegion(lab_base, _old_plab_size));
               // Try the old lab allocation again.
               new_obj = (oop) _old_lab.allocate(new_obj_size);
               promotion_trace_event(new_obj, o, new_obj_size, age, true, &_old_lab);
+            } else {
+              // A resized PLAB may not fit where the object alone still does.
+              new_obj = (oop)old_gen()->cas_allocate(new_obj_size);
+              promotion_trace_event(new_obj, o, new_obj_size, age, true, NULL);
             }
           }
         }
@@ -249,6 +253,8 @@ inline oop PSPromotionManager::copy_to_survivor_space(oop o) {
       if (!new_obj_is_tenured) {
         new_obj->incr_age();
         assert(young_space()->contains(new_obj), "Attempt to push non-promoted obj");
+      } else {
+        _promoted_words += new_obj_size;
       }
 
       // Do the size comparison first with new_obj_size, which we
@@ -346,7 +352,7 @@ inline void PSPromotionManager::process_popped_location_depth(ScannerTask task)
 }
 
 inline bool PSPromotionManager::steal_depth(int queue_num, ScannerTask& t) {
-  return stack_array_depth()->steal(queue_num, t);
+  return stack_array_depth()->steal_half(queue_num, t);
 }
 
 #if TASKQUEUE_STATS
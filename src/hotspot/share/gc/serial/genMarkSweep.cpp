@@ -32,6 +32,8 @@
 #include "code/codeCache.hpp"
 #include "code/icBuffer.hpp"
 #include "gc/serial/genMarkSweep.hpp"
+#include "gc/serial/parMarkSweep.hpp"
+#include "gc/serial/serialHeap.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "gc/shared/gcHeapSummary.hpp"
 #include "gc/shared/gcTimer.hpp"
@@ -45,17 +47,23 @@
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
 #include "gc/shared/space.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/taskTerminator.hpp"
 #include "gc/shared/weakProcessor.hpp"
+#include "gc/shared/workerPolicy.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/instanceRefKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/events.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/stack.inline.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmci.hpp"
@@ -89,6 +97,16 @@ void GenMarkSweep::invoke_at_safepoint(ReferenceProcessor* rp, bool clear_all_so
 
   allocate_stacks();
 
+  WorkGang* workers = SerialHeap::heap()->workers();
+  if (workers != NULL) {
+    uint active_workers = WorkerPolicy::calc_active_workers(workers->total_workers(),
+                                                            workers->active_workers(),
+                                                            Threads::number_of_non_daemon_threads());
+    active_workers = workers->update_active_workers(active_workers);
+    log_debug(gc, task)("Using %u workers of %u for marking and pointer adjustment",
+                        active_workers, workers->total_workers());
+  }
+
   mark_sweep_phase1(clear_all_softrefs);
 
   mark_sweep_phase2();
@@ -104,6 +122,9 @@ void GenMarkSweep::invoke_at_safepoint(ReferenceProcessor* rp, bool clear_all_so
   mark_sweep_phase4();
 
   restore_marks();
+  if (workers != NULL) {
+    ParMarkSweepManager::preserved_marks_set()->restore(workers);
+  }
 
   // Set saved marks for allocation profiler (and other things? -- dld)
   // (Should this be in general part?)
@@ -172,6 +193,30 @@ void GenMarkSweep::deallocate_stacks() {
   _objarray_stack.clear(true);
 }
 
+// Marks the strong roots and everything reachable from them in parallel.
+class GenMarkSweepMarkTask : public AbstractGangTask {
+  StrongRootsScope _strong_roots_scope;
+  TaskTerminator _terminator;
+
+public:
+  GenMarkSweepMarkTask(uint active_workers) :
+      AbstractGangTask("GenMarkSweepMarkTask"),
+      _strong_roots_scope(active_workers),
+      _terminator(active_workers, ParMarkSweepManager::oop_task_queues()) { }
+
+  virtual void work(uint worker_id) {
+    ParMarkSweepManager* manager = ParMarkSweepManager::manager(worker_id);
+    GenCollectedHeap::heap()->full_process_roots(&_strong_roots_scope,
+                                                 false, // not the adjust phase
+                                                 GenCollectedHeap::SO_None,
+                                                 ClassUnloading, // only strong roots if ClassUnloading
+                                                                 // is enabled
+                                                 manager->mark_and_push_closure(),
+                                                 manager->follow_cld_closure());
+    manager->complete_marking(&_terminator, worker_id);
+  }
+};
+
 void GenMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
   // Recursively traverse all live objects and mark them
   GCTraceTime(Info, gc, phases) tm("Phase 1: Mark live objects", _gc_timer);
@@ -181,7 +226,15 @@ void GenMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
   // Need new claim bits before marking starts.
   ClassLoaderDataGraph::clear_claimed_marks();
 
-  {
+  WorkGang* workers = SerialHeap::heap()->workers();
+  if (workers != NULL) {
+    // Every worker discovers references into its own discovered lists.
+    ReferenceProcessorMTDiscoveryMutator rp_mut_discovery(ref_processor(), true);
+    ParMarkSweepManager::set_ref_processor(ref_processor());
+
+    GenMarkSweepMarkTask task(workers->active_workers());
+    workers->run_task(&task);
+  } else {
     StrongRootsScope srs(1);
 
     gch->full_process_roots(&srs,
@@ -262,6 +315,75 @@ public:
   }
 };
 
+// Adjusts the strong roots, the marks preserved by GenMarkSweepMarkTask and
+// the chunks of live objects recorded in phase 2 in parallel.
+class GenMarkSweepAdjustTask : public AbstractGangTask {
+  class CollectSpacesClosure : public GenCollectedHeap::GenClosure, public SpaceClosure {
+    GrowableArray<CompactibleSpace*>* _spaces;
+  public:
+    CollectSpacesClosure(GrowableArray<CompactibleSpace*>* spaces) : _spaces(spaces) { }
+    void do_generation(Generation* gen) {
+      gen->space_iterate(this, true);
+    }
+    void do_space(Space* sp) {
+      assert(sp->toContiguousSpace() != NULL, "all Serial spaces are contiguous");
+      _spaces->append(sp->toContiguousSpace());
+    }
+  };
+
+  StrongRootsScope _strong_roots_scope;
+  GrowableArray<CompactibleSpace*> _spaces;
+  uint _num_chunks;
+  volatile uint _claimed_chunks;
+  uint _active_workers;
+
+  void adjust_chunk(uint chunk) {
+    for (int i = 0; i < _spaces.length(); i++) {
+      CompactibleSpace* sp = _spaces.at(i);
+      if (chunk < sp->num_adjust_chunks()) {
+        sp->adjust_pointers_in_chunk(chunk);
+        return;
+      }
+      chunk -= sp->num_adjust_chunks();
+    }
+    ShouldNotReachHere();
+  }
+
+public:
+  GenMarkSweepAdjustTask(uint active_workers) :
+      AbstractGangTask("GenMarkSweepAdjustTask"),
+      _strong_roots_scope(active_workers),
+      _spaces(4),
+      _num_chunks(0),
+      _claimed_chunks(0),
+      _active_workers(active_workers) {
+    CollectSpacesClosure cl(&_spaces);
+    GenCollectedHeap::heap()->generation_iterate(&cl, true);
+    for (int i = 0; i < _spaces.length(); i++) {
+      _num_chunks += _spaces.at(i)->num_adjust_chunks();
+    }
+  }
+
+  virtual void work(uint worker_id) {
+    GenCollectedHeap::heap()->full_process_roots(&_strong_roots_scope,
+                                                 true,  // this is the adjust phase
+                                                 GenCollectedHeap::SO_AllCodeCache,
+                                                 false, // all roots
+                                                 &MarkSweep::adjust_pointer_closure,
+                                                 &MarkSweep::adjust_cld_closure);
+
+    PreservedMarksSet* preserved_marks_set = ParMarkSweepManager::preserved_marks_set();
+    for (uint i = worker_id; i < preserved_marks_set->num(); i += _active_workers) {
+      preserved_marks_set->get(i)->adjust_during_full_gc();
+    }
+
+    uint chunk;
+    while ((chunk = Atomic::fetch_and_add(&_claimed_chunks, 1u)) < _num_chunks) {
+      adjust_chunk(chunk);
+    }
+  }
+};
+
 void GenMarkSweep::mark_sweep_phase3() {
   GenCollectedHeap* gch = GenCollectedHeap::heap();
 
@@ -271,7 +393,12 @@ void GenMarkSweep::mark_sweep_phase3() {
   // Need new claim bits for the pointer adjustment tracing.
   ClassLoaderDataGraph::clear_claimed_marks();
 
-  {
+  WorkGang* workers = SerialHeap::heap()->workers();
+  if (workers != NULL) {
+    ResourceMark rm;
+    GenMarkSweepAdjustTask task(workers->active_workers());
+    workers->run_task(&task);
+  } else {
     StrongRootsScope srs(1);
 
     gch->full_process_roots(&srs,
@@ -285,8 +412,10 @@ void GenMarkSweep::mark_sweep_phase3() {
   gch->gen_process_weak_roots(&adjust_pointer_closure);
 
   adjust_marks();
-  GenAdjustPointersClosure blk;
-  gch->generation_iterate(&blk, true);
+  if (workers == NULL) {
+    GenAdjustPointersClosure blk;
+    gch->generation_iterate(&blk, true);
+  }
 }
 
 class GenCompactClosure: public GenCollectedHeap::GenClosure {
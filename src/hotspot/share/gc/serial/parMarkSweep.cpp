@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.inline.hpp"
+#include "gc/serial/parMarkSweep.hpp"
+#include "gc/shared/preservedMarks.inline.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "gc/shared/taskTerminator.hpp"
+#include "memory/iterator.inline.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/compressedOops.inline.hpp"
+#include "oops/instanceClassLoaderKlass.inline.hpp"
+#include "oops/instanceKlass.inline.hpp"
+#include "oops/instanceMirrorKlass.inline.hpp"
+#include "oops/instanceRefKlass.inline.hpp"
+#include "oops/markWord.inline.hpp"
+#include "oops/objArrayKlass.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "oops/typeArrayOop.inline.hpp"
+
+uint                                       ParMarkSweepManager::_num_workers = 0;
+ParMarkSweepManager**                      ParMarkSweepManager::_manager_array = NULL;
+ParMarkSweepManager::OopTaskQueueSet*      ParMarkSweepManager::_oop_task_queues = NULL;
+ParMarkSweepManager::ObjArrayTaskQueueSet* ParMarkSweepManager::_objarray_task_queues = NULL;
+PreservedMarksSet*                         ParMarkSweepManager::_preserved_marks_set = NULL;
+
+ParMarkSweepManager::ParMarkSweepManager(PreservedMarks* preserved_marks) :
+    _marking_stack(),
+    _objarray_stack(),
+    _preserved_marks(preserved_marks),
+    _mark_and_push_closure(this),
+    _follow_cld_closure(&_mark_and_push_closure, ClassLoaderData::_claim_strong) {
+  _marking_stack.initialize();
+  _objarray_stack.initialize();
+}
+
+void ParMarkSweepManager::initialize(uint num_workers) {
+  assert(_manager_array == NULL, "already initialized");
+  assert(num_workers > 0, "must have workers");
+
+  _num_workers = num_workers;
+  _manager_array = NEW_C_HEAP_ARRAY(ParMarkSweepManager*, num_workers, mtGC);
+  _oop_task_queues = new OopTaskQueueSet(num_workers);
+  _objarray_task_queues = new ObjArrayTaskQueueSet(num_workers);
+  _preserved_marks_set = new PreservedMarksSet(true /* in_c_heap */);
+  _preserved_marks_set->init(num_workers);
+
+  for (uint i = 0; i < num_workers; i++) {
+    _manager_array[i] = new ParMarkSweepManager(_preserved_marks_set->get(i));
+    _oop_task_queues->register_queue(i, &_manager_array[i]->_marking_stack);
+    _objarray_task_queues->register_queue(i, &_manager_array[i]->_objarray_stack);
+  }
+}
+
+void ParMarkSweepManager::set_ref_processor(ReferenceProcessor* rp) {
+  for (uint i = 0; i < _num_workers; i++) {
+    _manager_array[i]->_mark_and_push_closure.set_ref_discoverer(rp);
+  }
+}
+
+bool ParMarkSweepManager::steal(uint queue_num, oop& t) {
+  return _oop_task_queues->steal(queue_num, t);
+}
+
+bool ParMarkSweepManager::steal_objarray(uint queue_num, ObjArrayTask& t) {
+  return _objarray_task_queues->steal(queue_num, t);
+}
+
+bool ParMarkSweepManager::mark_object(oop obj) {
+  markWord mark = obj->mark_raw();
+  if (mark.is_marked()) {
+    return false;
+  }
+  // Mark words only change during a full GC pause by being marked, so a
+  // failed CAS means that another worker marked the object first.
+  if (obj->cas_set_mark_raw(markWord::prototype().set_marked(), mark) != mark) {
+    return false;
+  }
+  // Some marks may contain information we need to preserve so we store them
+  // away. They are restored after compaction.
+  if (obj->mark_must_be_preserved(mark)) {
+    _preserved_marks->push(obj, mark);
+  }
+  return true;
+}
+
+template <class T> void ParMarkSweepManager::mark_and_push(T* p) {
+  T heap_oop = RawAccess<>::oop_load(p);
+  if (!CompressedOops::is_null(heap_oop)) {
+    oop obj = CompressedOops::decode_not_null(heap_oop);
+    if (mark_object(obj)) {
+      _marking_stack.push(obj);
+    }
+  }
+}
+
+void ParMarkSweepManager::follow_klass(Klass* klass) {
+  oop op = klass->class_loader_data()->holder_no_keepalive();
+  mark_and_push(&op);
+}
+
+void ParMarkSweepManager::follow_cld(ClassLoaderData* cld) {
+  _follow_cld_closure.do_cld(cld);
+}
+
+void ParMarkSweepManager::push_objarray(oop obj, size_t index) {
+  ObjArrayTask task(obj, index);
+  assert(task.is_valid(), "bad ObjArrayTask");
+  _objarray_stack.push(task);
+}
+
+void ParMarkSweepManager::follow_contents(oop obj) {
+  assert(obj->is_gc_marked(), "should be marked");
+  if (obj->is_objArray()) {
+    // Handle object arrays explicitly to allow them to
+    // be split into chunks and stolen by other workers.
+    follow_klass(obj->klass());
+    // Don't push empty arrays to avoid unnecessary work.
+    if (objArrayOop(obj)->length() > 0) {
+      push_objarray(obj, 0);
+    }
+  } else {
+    obj->oop_iterate(&_mark_and_push_closure);
+  }
+}
+
+void ParMarkSweepManager::follow_array(objArrayOop array, int index) {
+  const int len = array->length();
+  const int beg_index = index;
+  assert(beg_index < len || len == 0, "index too large");
+
+  const int stride = MIN2(len - beg_index, (int) ObjArrayMarkingStride);
+  const int end_index = beg_index + stride;
+
+  // Push the continuation first so that other workers can steal it.
+  if (end_index < len) {
+    push_objarray(array, end_index);
+  }
+
+  array->oop_iterate_range(&_mark_and_push_closure, beg_index, end_index);
+}
+
+bool ParMarkSweepManager::marking_stacks_empty() const {
+  return _marking_stack.is_empty() && _objarray_stack.is_empty();
+}
+
+void ParMarkSweepManager::follow_marking_stacks() {
+  do {
+    // Drain the overflow stack first, to allow stealing from the marking stack.
+    oop obj;
+    while (_marking_stack.pop_overflow(obj)) {
+      follow_contents(obj);
+    }
+    while (_marking_stack.pop_local(obj)) {
+      follow_contents(obj);
+    }
+
+    // Process ObjArrays one at a time to avoid marking stack bloat.
+    ObjArrayTask task;
+    if (_objarray_stack.pop_overflow(task) || _objarray_stack.pop_local(task)) {
+      follow_array(objArrayOop(task.obj()), task.index());
+    }
+  } while (!marking_stacks_empty());
+}
+
+void ParMarkSweepManager::complete_marking(TaskTerminator* terminator, uint worker_id) {
+  follow_marking_stacks();
+
+  oop obj = NULL;
+  ObjArrayTask task;
+  do {
+    while (steal_objarray(worker_id, task)) {
+      follow_array(objArrayOop(task.obj()), task.index());
+      follow_marking_stacks();
+    }
+    while (steal(worker_id, obj)) {
+      follow_contents(obj);
+      follow_marking_stacks();
+    }
+  } while (!terminator->offer_termination());
+
+  assert(marking_stacks_empty(), "must be");
+}
+
+template <typename T>
+inline void ParMarkSweepMarkAndPushClosure::do_oop_work(T* p) { _manager->mark_and_push(p); }
+void ParMarkSweepMarkAndPushClosure::do_oop(oop* p)           { do_oop_work(p); }
+void ParMarkSweepMarkAndPushClosure::do_oop(narrowOop* p)     { do_oop_work(p); }
+void ParMarkSweepMarkAndPushClosure::do_klass(Klass* k)       { _manager->follow_klass(k); }
+void ParMarkSweepMarkAndPushClosure::do_cld(ClassLoaderData* cld) { _manager->follow_cld(cld); }
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_GC_SERIAL_PARMARKSWEEP_HPP
+#define SHARE_GC_SERIAL_PARMARKSWEEP_HPP
+
+#include "gc/shared/preservedMarks.hpp"
+#include "gc/shared/taskqueue.hpp"
+#include "memory/allocation.hpp"
+#include "memory/iterator.hpp"
+
+class ParMarkSweepManager;
+class ReferenceProcessor;
+class TaskTerminator;
+
+class ParMarkSweepMarkAndPushClosure: public OopIterateClosure {
+  ParMarkSweepManager* _manager;
+public:
+  ParMarkSweepMarkAndPushClosure(ParMarkSweepManager* manager) : _manager(manager) { }
+
+  template <typename T> void do_oop_work(T* p);
+  virtual void do_oop(oop* p);
+  virtual void do_oop(narrowOop* p);
+
+  virtual bool do_metadata() { return true; }
+  virtual void do_klass(Klass* k);
+  virtual void do_cld(ClassLoaderData* cld);
+
+  void set_ref_discoverer(ReferenceDiscoverer* rd) {
+    set_ref_discoverer_internal(rd);
+  }
+};
+
+// Per-worker marking state for the parallel marking phase of Serial full
+// GCs (SerialFullGCParallelPhases). Like MarkSweep, objects are marked by
+// overwriting their mark word, but the new mark word is installed with a
+// CAS so that exactly one worker marks and pushes each live object. Mark
+// words that must be preserved are saved in per-worker PreservedMarks.
+class ParMarkSweepManager : public CHeapObj<mtGC> {
+  typedef OverflowTaskQueue<oop, mtGC>                  OopTaskQueue;
+  typedef GenericTaskQueueSet<OopTaskQueue, mtGC>       OopTaskQueueSet;
+  typedef OverflowTaskQueue<ObjArrayTask, mtGC>         ObjArrayTaskQueue;
+  typedef GenericTaskQueueSet<ObjArrayTaskQueue, mtGC>  ObjArrayTaskQueueSet;
+
+  static uint                  _num_workers;
+  static ParMarkSweepManager** _manager_array;
+  static OopTaskQueueSet*      _oop_task_queues;
+  static ObjArrayTaskQueueSet* _objarray_task_queues;
+  static PreservedMarksSet*    _preserved_marks_set;
+
+  OopTaskQueue      _marking_stack;
+  ObjArrayTaskQueue _objarray_stack;
+  PreservedMarks*   _preserved_marks;
+
+  ParMarkSweepMarkAndPushClosure _mark_and_push_closure;
+  CLDToOopClosure                _follow_cld_closure;
+
+  ParMarkSweepManager(PreservedMarks* preserved_marks);
+
+  static bool steal(uint queue_num, oop& t);
+  static bool steal_objarray(uint queue_num, ObjArrayTask& t);
+
+  // Returns true if this worker marked the object.
+  bool mark_object(oop obj);
+  void push_objarray(oop obj, size_t index);
+  void follow_contents(oop obj);
+  void follow_array(objArrayOop array, int index);
+
+  bool marking_stacks_empty() const;
+
+public:
+  static void initialize(uint num_workers);
+
+  static ParMarkSweepManager* manager(uint worker_id) {
+    assert(worker_id < _num_workers, "out of range");
+    return _manager_array[worker_id];
+  }
+
+  static TaskQueueSetSuper* oop_task_queues() { return _oop_task_queues; }
+
+  // The preserved marks of all workers. They must be adjusted in the pointer
+  // adjustment phase and restored after compaction.
+  static PreservedMarksSet* preserved_marks_set() { return _preserved_marks_set; }
+
+  // Install the reference discoverer used by all workers.
+  static void set_ref_processor(ReferenceProcessor* rp);
+
+  template <class T> void mark_and_push(T* p);
+  void follow_klass(Klass* klass);
+  void follow_cld(ClassLoaderData* cld);
+
+  OopIterateClosure* mark_and_push_closure() { return &_mark_and_push_closure; }
+  CLDClosure* follow_cld_closure() { return &_follow_cld_closure; }
+
+  // Empty the local marking stacks.
+  void follow_marking_stacks();
+
+  // Empty the local marking stacks and steal from other workers until
+  // all workers agree to terminate.
+  void complete_marking(TaskTerminator* terminator, uint worker_id);
+};
+
+#endif // SHARE_GC_SERIAL_PARMARKSWEEP_HPP
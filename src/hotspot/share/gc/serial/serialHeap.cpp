@@ -24,11 +24,15 @@
 
 #include "precompiled.hpp"
 #include "gc/serial/defNewGeneration.inline.hpp"
+#include "gc/serial/parMarkSweep.hpp"
 #include "gc/serial/serialHeap.hpp"
 #include "gc/serial/tenuredGeneration.inline.hpp"
 #include "gc/shared/genMemoryPools.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/workerPolicy.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/universe.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "services/memoryManager.hpp"
 
 SerialHeap* SerialHeap::heap() {
@@ -41,11 +45,34 @@ SerialHeap::SerialHeap() :
                      "Copy:MSC"),
     _eden_pool(NULL),
     _survivor_pool(NULL),
-    _old_pool(NULL) {
+    _old_pool(NULL),
+    _workers(NULL) {
   _young_manager = new GCMemoryManager("Copy", "end of minor GC");
   _old_manager = new GCMemoryManager("MarkSweepCompact", "end of major GC");
 }
 
+jint SerialHeap::initialize() {
+  jint status = GenCollectedHeap::initialize();
+  if (status != JNI_OK) {
+    return status;
+  }
+
+  if (SerialFullGCParallelPhases) {
+    // Created before post_initialize() sets up the reference processors,
+    // which size their discovered lists by the number of workers.
+    _workers = new WorkGang("GC Thread",
+                            WorkerPolicy::parallel_worker_threads(),
+                            true /* are_GC_task_threads */,
+                            false /* are_ConcurrentGC_threads */);
+    if (_workers == NULL) {
+      return JNI_ENOMEM;
+    }
+    _workers->initialize_workers();
+    ParMarkSweepManager::initialize(_workers->total_workers());
+  }
+  return JNI_OK;
+}
+
 void SerialHeap::initialize_serviceability() {
 
   DefNewGeneration* young = young_gen();
@@ -81,6 +108,30 @@ GrowableArray<GCMemoryManager*> SerialHeap::memory_managers() {
   return memory_managers;
 }
 
+void SerialHeap::gc_threads_do(ThreadClosure* tc) const {
+  if (_workers != NULL) {
+    _workers->threads_do(tc);
+  }
+}
+
+HeapWord* SerialHeap::allocate_loaded_archive_space(size_t word_size) {
+  MutexLocker ml(Heap_lock);
+  // Mark-compact slides live objects towards the bottom of the tenured
+  // space, so objects placed there first and kept alive never move.
+  if (old_gen()->used() != 0) {
+    return NULL;
+  }
+  HeapWord* result = old_gen()->allocate(word_size, false /* is_tlab */);
+  if (result == NULL) {
+    result = old_gen()->expand_and_allocate(word_size, false /* is_tlab */);
+  }
+  return result;
+}
+
+void SerialHeap::complete_loaded_archive_space(MemRegion archive_space) {
+  old_gen()->complete_loaded_archive_space(archive_space);
+}
+
 GrowableArray<MemoryPool*> SerialHeap::memory_pools() {
   GrowableArray<MemoryPool*> memory_pools(3);
   memory_pools.append(_eden_pool);
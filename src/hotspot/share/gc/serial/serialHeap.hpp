@@ -34,6 +34,7 @@ class GCMemoryManager;
 class MemoryPool;
 class OopIterateClosure;
 class TenuredGeneration;
+class WorkGang;
 
 class SerialHeap : public GenCollectedHeap {
 private:
@@ -41,6 +42,10 @@ private:
   MemoryPool* _survivor_pool;
   MemoryPool* _old_pool;
 
+  // Workers for the parallel phases of full GCs, or NULL if
+  // SerialFullGCParallelPhases is disabled.
+  WorkGang* _workers;
+
   virtual void initialize_serviceability();
 
 public:
@@ -48,6 +53,8 @@ public:
 
   SerialHeap();
 
+  virtual jint initialize();
+
   virtual Name kind() const {
     return CollectedHeap::Serial;
   }
@@ -59,6 +66,15 @@ public:
   virtual GrowableArray<GCMemoryManager*> memory_managers();
   virtual GrowableArray<MemoryPool*> memory_pools();
 
+  virtual void gc_threads_do(ThreadClosure* tc) const;
+
+  // Support for loading CDS archived heap objects.
+  virtual bool can_load_archived_objects() const { return true; }
+  virtual HeapWord* allocate_loaded_archive_space(size_t word_size);
+  virtual void complete_loaded_archive_space(MemRegion archive_space);
+
+  WorkGang* workers() const { return _workers; }
+
   DefNewGeneration* young_gen() const {
     assert(_young_gen->kind() == Generation::DefNew, "Wrong generation type");
     return static_cast<DefNewGeneration*>(_young_gen);
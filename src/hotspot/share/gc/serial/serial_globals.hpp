@@ -25,13 +25,18 @@
 #ifndef SHARE_GC_SERIAL_SERIAL_GLOBALS_HPP
 #define SHARE_GC_SERIAL_SERIAL_GLOBALS_HPP
 
-#define GC_SERIAL_FLAGS(develop,     \
-                        develop_pd,  \
-                        product,     \
-                        product_pd,  \
-                        notproduct,  \
-                        range,       \
-                        constraint)
+#define GC_SERIAL_FLAGS(develop,                                            \
+                        develop_pd,                                         \
+                        product,                                            \
+                        product_pd,                                         \
+                        notproduct,                                         \
+                        range,                                              \
+                        constraint)                                         \
+                                                                            \
+  product(bool, SerialFullGCParallelPhases, false, EXPERIMENTAL,            \
+          "Use ParallelGCThreads worker threads for the marking and "       \
+          "pointer adjustment phases of Serial full GCs. Compaction "       \
+          "remains serial.")
 
 // end of GC_SERIAL_FLAGS
 
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/serial/genMarkSweep.hpp"
+#include "gc/serial/serialHeap.hpp"
 #include "gc/serial/tenuredGeneration.inline.hpp"
 #include "gc/shared/blockOffsetTable.inline.hpp"
 #include "gc/shared/cardGeneration.inline.hpp"
@@ -34,6 +35,7 @@
 #include "gc/shared/genOopClosures.inline.hpp"
 #include "gc/shared/generationSpec.hpp"
 #include "gc/shared/space.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "oops/oop.inline.hpp"
@@ -159,6 +161,24 @@ bool TenuredGeneration::promotion_attempt_is_safe(size_t max_promotion_in_bytes)
   return res;
 }
 
+void TenuredGeneration::ref_processor_init() {
+  WorkGang* workers = SerialHeap::heap()->workers();
+  if (workers == NULL) {
+    Generation::ref_processor_init();
+    return;
+  }
+  // Parallel full GC marking discovers references into one list per worker.
+  // They are processed serially.
+  assert(_ref_processor == NULL, "a reference processor already exists");
+  _span_based_discoverer.set_span(_reserved);
+  _ref_processor =
+    new ReferenceProcessor(&_span_based_discoverer,
+                           false,                    // mt processing
+                           1,                        // mt processing degree
+                           false,                    // mt discovery
+                           workers->total_workers()); // mt discovery degree
+}
+
 void TenuredGeneration::collect(bool   full,
                                 bool   clear_all_soft_refs,
                                 size_t size,
@@ -187,6 +207,18 @@ void TenuredGeneration::collect(bool   full,
   gc_tracer->report_gc_end(gc_timer->gc_end(), gc_timer->time_partitions());
 }
 
+void TenuredGeneration::complete_loaded_archive_space(MemRegion archive_space) {
+  assert(archive_space.start() == _the_space->bottom(), "must be at the bottom of the space");
+  TenuredSpace* space = (TenuredSpace*)_the_space;
+  space->initialize_threshold();
+  HeapWord* start = archive_space.start();
+  while (start < archive_space.end()) {
+    size_t word_size = block_size(start);
+    space->alloc_block(start, start + word_size);
+    start += word_size;
+  }
+}
+
 HeapWord*
 TenuredGeneration::expand_and_allocate(size_t word_size,
                                        bool is_tlab,
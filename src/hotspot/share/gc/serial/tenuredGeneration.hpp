@@ -86,6 +86,10 @@ class TenuredGeneration: public CardGeneration {
 
   inline size_t block_size(const HeapWord* addr) const;
 
+  // Record the objects in a block of loaded CDS archived heap objects in
+  // the block offset table; the allocation only recorded the whole block.
+  void complete_loaded_archive_space(MemRegion archive_space);
+
   inline bool block_is_obj(const HeapWord* addr) const;
 
   virtual void collect(bool full,
@@ -93,6 +97,8 @@ class TenuredGeneration: public CardGeneration {
                        size_t size,
                        bool is_tlab);
 
+  virtual void ref_processor_init();
+
   HeapWord* expand_and_allocate(size_t size,
                                 bool is_tlab,
                                 bool parallel = false);
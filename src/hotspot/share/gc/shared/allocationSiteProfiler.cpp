@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/allocationSiteProfiler.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/vframe.inline.hpp"
+#include "utilities/ostream.hpp"
+
+// One entry per allocation site, in an open addressed hash table keyed by
+// method and bci. The names are copied to the C heap since the methods may be
+// unloaded later on; the Method* is only compared, never dereferenced again.
+// Once the table is three quarters full, further sites are accounted to a
+// single overflow entry.
+struct AllocationSiteEntry {
+  Method*  _method;
+  int      _bci;
+  char*    _name;
+  uint64_t _samples;
+  uint64_t _bytes;
+};
+
+static const int site_table_size = 4096;
+static const int max_sites = site_table_size / 4 * 3;
+static AllocationSiteEntry _table[site_table_size];
+static int _num_sites = 0;
+static AllocationSiteEntry _no_java_frame;
+static AllocationSiteEntry _overflow;
+static jlong _start_ns = 0;
+
+static const char* const no_java_frame_name = "<no Java frame>";
+static const char* const overflow_name = "<other sites>";
+
+static AllocationSiteEntry* find_or_add_entry(Method* method, int bci) {
+  uintptr_t hash = (p2i(method) >> LogBytesPerWord) * 31 + (uintptr_t)bci;
+  int i = (int)(hash % site_table_size);
+  while (_table[i]._method != NULL) {
+    if (_table[i]._method == method && _table[i]._bci == bci) {
+      return &_table[i];
+    }
+    i = (i + 1) % site_table_size;
+  }
+  if (_num_sites == max_sites) {
+    return &_overflow;
+  }
+  ResourceMark rm;
+  AllocationSiteEntry* entry = &_table[i];
+  entry->_method = method;
+  entry->_bci = bci;
+  entry->_name = os::strdup_check_oom(method->name_and_sig_as_C_string(), mtInternal);
+  _num_sites++;
+  return entry;
+}
+
+void AllocationSiteProfiler::record(Thread* thread, size_t bytes) {
+  Method* method = NULL;
+  int bci = 0;
+  if (thread->is_Java_thread()) {
+    JavaThread* jt = thread->as_Java_thread();
+    if (jt->has_last_Java_frame()) {
+      vframeStream vfst(jt, false /* stop_at_java_call_stub */, false /* process_frames */);
+      if (!vfst.at_end()) {
+        method = vfst.method();
+        bci = vfst.bci();
+      }
+    }
+  }
+
+  MutexLocker ml(AllocationSiteProfile_lock, Mutex::_no_safepoint_check_flag);
+  if (_start_ns == 0) {
+    _start_ns = os::javaTimeNanos();
+  }
+  AllocationSiteEntry* entry = method != NULL ? find_or_add_entry(method, bci) : &_no_java_frame;
+  entry->_samples++;
+  entry->_bytes += bytes;
+}
+
+static int compare_by_bytes(const void* a, const void* b) {
+  uint64_t ba = ((const AllocationSiteEntry*)a)->_bytes;
+  uint64_t bb = ((const AllocationSiteEntry*)b)->_bytes;
+  return ba < bb ? 1 : (ba > bb ? -1 : 0);
+}
+
+void AllocationSiteProfiler::print_on(outputStream* st, int limit) {
+  ResourceMark rm;
+  MutexLocker ml(AllocationSiteProfile_lock, Mutex::_no_safepoint_check_flag);
+
+  int length = 0;
+  AllocationSiteEntry* sorted = NEW_RESOURCE_ARRAY(AllocationSiteEntry, max_sites + 2);
+  for (int i = 0; i < site_table_size; i++) {
+    if (_table[i]._method != NULL) {
+      sorted[length++] = _table[i];
+    }
+  }
+  if (_no_java_frame._samples > 0) {
+    sorted[length] = _no_java_frame;
+    sorted[length++]._name = (char*)no_java_frame_name;
+  }
+  if (_overflow._samples > 0) {
+    sorted[length] = _overflow;
+    sorted[length++]._name = (char*)overflow_name;
+  }
+  qsort(sorted, length, sizeof(AllocationSiteEntry), compare_by_bytes);
+
+  jlong elapsed_ns = _start_ns != 0 ? os::javaTimeNanos() - _start_ns : 0;
+  double seconds = MAX2((double)elapsed_ns / NANOSECS_PER_SEC, 0.001);
+  st->print_cr("Allocation site profile: %d sites over %.3f s", _num_sites, seconds);
+  st->print_cr("%16s %14s %10s  %s", "Bytes", "Bytes/s", "Samples", "Site");
+  if (limit > 0) {
+    length = MIN2(length, limit);
+  }
+  for (int i = 0; i < length; i++) {
+    if (sorted[i]._method != NULL) {
+      st->print_cr(UINT64_FORMAT_W(16) " " UINT64_FORMAT_W(14) " " UINT64_FORMAT_W(10) "  %s @ %d",
+                   sorted[i]._bytes, (uint64_t)(sorted[i]._bytes / seconds), sorted[i]._samples,
+                   sorted[i]._name, sorted[i]._bci);
+    } else {
+      st->print_cr(UINT64_FORMAT_W(16) " " UINT64_FORMAT_W(14) " " UINT64_FORMAT_W(10) "  %s",
+                   sorted[i]._bytes, (uint64_t)(sorted[i]._bytes / seconds), sorted[i]._samples,
+                   sorted[i]._name);
+    }
+  }
+}
+
+void AllocationSiteProfiler::reset() {
+  MutexLocker ml(AllocationSiteProfile_lock, Mutex::_no_safepoint_check_flag);
+  for (int i = 0; i < site_table_size; i++) {
+    if (_table[i]._name != NULL) {
+      os::free(_table[i]._name);
+    }
+    _table[i]._method = NULL;
+    _table[i]._bci = 0;
+    _table[i]._name = NULL;
+    _table[i]._samples = 0;
+    _table[i]._bytes = 0;
+  }
+  _num_sites = 0;
+  _no_java_frame._samples = _no_java_frame._bytes = 0;
+  _overflow._samples = _overflow._bytes = 0;
+  _start_ns = 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_SHARED_ALLOCATIONSITEPROFILER_HPP
+#define SHARE_GC_SHARED_ALLOCATIONSITEPROFILER_HPP
+
+#include "memory/allocation.hpp"
+
+class outputStream;
+class Thread;
+
+// Allocation site profiling, enabled with ProfileAllocationSites.
+//
+// Only allocations that refill a TLAB or go outside of TLABs are recorded,
+// which keeps the cost off the fast path. A TLAB refill is accounted with the
+// size of the new TLAB, so that sites are weighted by the bytes they allocate
+// as with the JFR ObjectAllocationInNewTLAB event. Sites are the innermost
+// Java method and bci of the allocating thread.
+class AllocationSiteProfiler : AllStatic {
+ public:
+  static void record(Thread* thread, size_t bytes);
+
+  static void print_on(outputStream* st, int limit);
+  static void reset();
+};
+
+#endif // SHARE_GC_SHARED_ALLOCATIONSITEPROFILER_HPP
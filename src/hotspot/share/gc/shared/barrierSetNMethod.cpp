@@ -28,6 +28,7 @@
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/barrierSetNMethod.hpp"
 #include "logging/log.hpp"
+#include "runtime/sweeper.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/debug.hpp"
 
@@ -75,6 +76,8 @@ int BarrierSetNMethod::nmethod_stub_entry_barrier(address* return_address_ptr) {
   if (!may_enter) {
     log_trace(nmethod, barrier)("Deoptimizing nmethod: " PTR_FORMAT, p2i(nm));
     bs_nm->deoptimize(nm, return_address_ptr);
+  } else {
+    NMethodSweeper::report_nmethod_entry(nm);
   }
   return may_enter ? 0 : 1;
 }
@@ -91,5 +94,9 @@ bool BarrierSetNMethod::nmethod_osr_entry_barrier(nmethod* nm) {
 
   assert(nm->is_osr_method(), "Should not reach here");
   log_trace(nmethod, barrier)("Running osr nmethod entry barrier: " PTR_FORMAT, p2i(nm));
-  return nmethod_entry_barrier(nm);
+  bool may_enter = nmethod_entry_barrier(nm);
+  if (may_enter) {
+    NMethodSweeper::report_nmethod_entry(nm);
+  }
+  return may_enter;
 }
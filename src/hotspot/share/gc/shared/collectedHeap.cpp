@@ -66,12 +66,14 @@ void GCHeapLog::log_heap(CollectedHeap* heap, bool before) {
   }
 
   double timestamp = fetch_timestamp();
-  MutexLocker ml(&_mutex, Mutex::_no_safepoint_check_flag);
-  int index = compute_log_index();
-  _records[index].thread = NULL; // Its the GC thread so it's not that interesting.
-  _records[index].timestamp = timestamp;
-  _records[index].data.is_before = before;
-  stringStream st(_records[index].data.buffer(), _records[index].data.size());
+  size_t seq;
+  // Its the GC thread so it's not that interesting.
+  Record* r = claim_record(NULL, timestamp, &seq);
+  if (r == NULL) {
+    return;
+  }
+  r->data.is_before = before;
+  stringStream st(r->data.buffer(), r->data.size());
 
   st.print_cr("{Heap %s GC invocations=%u (full %u):",
                  before ? "before" : "after",
@@ -80,6 +82,7 @@ void GCHeapLog::log_heap(CollectedHeap* heap, bool before) {
 
   heap->print_on(&st);
   st.print_cr("}");
+  publish_record(r, seq);
 }
 
 size_t CollectedHeap::unused() const {
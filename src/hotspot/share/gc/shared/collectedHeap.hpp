@@ -520,6 +520,16 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // Deduplicate the string, iff the GC supports string deduplication.
   virtual void deduplicate_string(oop str);
 
+  // Support for loading the CDS archived heap objects into collectors that
+  // cannot map them (see FileMapInfo::load_heap_regions()). The space is
+  // allocated at VM startup, before any other object, at the bottom of the
+  // old generation. The loaded objects are kept alive, so the collector must
+  // guarantee that full GCs do not move them from there.
+  virtual bool can_load_archived_objects() const { return false; }
+  virtual HeapWord* allocate_loaded_archive_space(size_t word_size) { return NULL; }
+  // Called once the objects in the space are parsable.
+  virtual void complete_loaded_archive_space(MemRegion archive_space) { }
+
   virtual bool is_oop(oop object) const;
 
   // Non product verification and debugging.
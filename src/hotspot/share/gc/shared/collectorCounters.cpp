@@ -28,7 +28,8 @@
 #include "memory/resourceArea.hpp"
 #include "runtime/os.hpp"
 
-CollectorCounters::CollectorCounters(const char* name, int ordinal) {
+CollectorCounters::CollectorCounters(const char* name, int ordinal) :
+    _time_histogram(NULL) {
 
   if (UsePerfData) {
     EXCEPTION_MARK;
@@ -59,6 +60,9 @@ CollectorCounters::CollectorCounters(const char* name, int ordinal) {
     _last_exit_time = PerfDataManager::create_variable(SUN_GC, cname,
                                                        PerfData::U_Ticks,
                                                        CHECK);
+
+    cname = PerfDataManager::counter_name(_name_space, "timeHistogram");
+    _time_histogram = PerfDataManager::create_histogram(SUN_GC, cname, CHECK);
   }
 }
 
@@ -77,6 +81,8 @@ TraceCollectorStats::TraceCollectorStats(CollectorCounters* c) :
 
 TraceCollectorStats::~TraceCollectorStats() {
   if (UsePerfData) {
-    _c->last_exit_counter()->set_value(os::elapsed_counter());
+    jlong now = os::elapsed_counter();
+    _c->last_exit_counter()->set_value(now);
+    _c->time_histogram()->sample_ticks(now - _c->last_entry_counter()->get_value());
   }
 }
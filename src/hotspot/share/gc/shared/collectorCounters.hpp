@@ -38,6 +38,7 @@ class CollectorCounters: public CHeapObj<mtGC> {
     PerfCounter*      _time;
     PerfVariable*     _last_entry_time;
     PerfVariable*     _last_exit_time;
+    PerfHistogram*    _time_histogram;
 
     // Constant PerfData types don't need to retain a reference.
     // However, it's a good idea to document them here.
@@ -59,6 +60,8 @@ class CollectorCounters: public CHeapObj<mtGC> {
 
     inline PerfVariable* last_exit_counter() const  { return _last_exit_time; }
 
+    inline PerfHistogram* time_histogram() const    { return _time_histogram; }
+
     const char* name_space() const                  { return _name_space; }
 };
 
@@ -128,6 +128,13 @@ class GCCause : public AllStatic {
             cause == GCCause::_shenandoah_allocation_failure_evac);
   }
 
+  // Causes for collections triggered by a metadata allocation that is retried
+  // after the collection
+  inline static bool is_metadata_allocation_failure_gc(GCCause::Cause cause) {
+    return (cause == GCCause::_metadata_GC_threshold ||
+            cause == GCCause::_metadata_GC_clear_soft_refs);
+  }
+
   // Return a string describing the GCCause.
   static const char* to_string(GCCause::Cause cause);
 };
@@ -132,6 +132,15 @@
           "Number of parallel threads parallel gc will use")                \
           constraint(ParallelGCThreadsConstraintFunc,AfterErgo)             \
                                                                             \
+  product(ccstr, GCThreadCPUs, NULL,                                        \
+          "List of CPUs and CPU ranges (such as 0-3,8) GC worker threads "  \
+          "are bound to (Linux only)")                                      \
+                                                                            \
+  product(intx, GCThreadPriority, -1,                                       \
+          "The native priority at which GC worker threads should run "      \
+          "(-1 means no change)")                                           \
+          range(-1, 127)                                                    \
+                                                                            \
   product(bool, UseDynamicNumberOfGCThreads, true,                          \
           "Dynamically choose the number of threads up to a maximum of "    \
           "ParallelGCThreads parallel collectors will use for garbage "     \
@@ -304,6 +313,11 @@
   product(bool, TLABStats, true,                                            \
           "Provide more detailed and expensive TLAB statistics.")           \
                                                                             \
+  product(bool, ProfileAllocationSites, false,                              \
+          "Aggregate the bytes allocated by each Java allocation site, "    \
+          "sampled at TLAB refills and outside-TLAB allocations (see "      \
+          "GC.allocation_sites)")                                           \
+                                                                            \
   product_pd(bool, NeverActAsServerClassMachine,                            \
           "Never act like a server-class machine")                          \
                                                                             \
@@ -669,6 +683,16 @@
           range(0, max_jint)                                                \
           constraint(TLABWasteIncrementConstraintFunc,AfterMemoryInit)      \
                                                                             \
+  product(bool, TLABLargeAllocatorSizing, false, EXPERIMENTAL,              \
+          "Classify threads that allocated a large fraction of eden "       \
+          "during each of the last GCs as large allocators, and size "      \
+          "their TLABs for the upper end of their recent allocation")       \
+                                                                            \
+  product(uintx, TLABLargeAllocatorPercent, 10, EXPERIMENTAL,               \
+          "Minimum percentage of eden a thread must allocate in TLABs "     \
+          "between each of the last GCs to be a large allocator")           \
+          range(1, 100)                                                     \
+                                                                            \
   product(uintx, SurvivorRatio, 8,                                          \
           "Ratio of eden/survivor space size")                              \
           range(1, max_uintx-2)                                             \
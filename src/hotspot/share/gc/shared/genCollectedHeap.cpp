@@ -661,6 +661,12 @@ void GenCollectedHeap::do_collection(bool           full,
     _young_gen->compute_new_size();
 
     // Delete metaspaces for unloaded class loaders and clean up loader_data graph
+    if (DeferClassUnloadingPurge &&
+        !GCCause::is_metadata_allocation_failure_gc(gc_cause())) {
+      // The ServiceThread deletes the unloaded class loaders after the pause.
+      // A failed metadata allocation needs the space back before it retries.
+      ClassLoaderDataGraph::defer_purge();
+    }
     ClassLoaderDataGraph::purge(/*at_safepoint*/true);
     MetaspaceUtils::verify_metrics();
     // Resize the metaspace capacity after full collections
@@ -60,6 +60,16 @@ void MarkBitMap::do_clear(MemRegion mr, bool large) {
   }
 }
 
+void MarkBitMap::par_clear_range(MemRegion mr) {
+  MemRegion intersection = mr.intersection(_covered);
+  assert(!intersection.is_empty(),
+         "Given range from " PTR_FORMAT " to " PTR_FORMAT " is completely outside the heap",
+         p2i(mr.start()), p2i(mr.end()));
+  size_t beg = addr_to_offset(intersection.start());
+  size_t end = addr_to_offset(intersection.end());
+  _bm.par_at_put_range(beg, end, false);
+}
+
 #ifdef ASSERT
 void MarkBitMap::check_mark(HeapWord* addr) {
   assert(Universe::heap()->is_in(addr),
@@ -97,6 +97,9 @@ public:
   void clear()                         { do_clear(_covered, true); }
   void clear_range(MemRegion mr)       { do_clear(mr, false);      }
   void clear_range_large(MemRegion mr) { do_clear(mr, true);       }
+  // Clear the given range using atomic updates of the boundary words, so that
+  // disjoint ranges may be cleared concurrently.
+  void par_clear_range(MemRegion mr);
 };
 
 #endif // SHARE_GC_SHARED_MARKBITMAP_HPP
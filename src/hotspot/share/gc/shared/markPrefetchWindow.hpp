@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_SHARED_MARKPREFETCHWINDOW_HPP
+#define SHARE_GC_SHARED_MARKPREFETCHWINDOW_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+// A small FIFO of mark stack entries that have been popped but not yet
+// processed. Marking pops entries into the window some time before it
+// processes them, and prefetches what each entry refers to when it is
+// popped, so that the cache misses of several entries overlap instead
+// of being taken one at a time.
+template <typename E>
+class MarkPrefetchWindow : public StackObj {
+public:
+  static const uint MaxCapacity = 64; // Must be a power of two
+
+private:
+  E          _entries[MaxCapacity];
+  const uint _capacity;
+  uint       _head;
+  uint       _size;
+
+public:
+  // A capacity of one degenerates to popping and processing one entry
+  // at a time.
+  MarkPrefetchWindow(uint capacity) :
+      _capacity(capacity),
+      _head(0),
+      _size(0) {
+    STATIC_ASSERT((MaxCapacity & (MaxCapacity - 1)) == 0);
+    assert(capacity >= 1 && capacity <= MaxCapacity, "Invalid capacity %u", capacity);
+  }
+
+  bool is_empty() const {
+    return _size == 0;
+  }
+
+  bool is_full() const {
+    return _size == _capacity;
+  }
+
+  void push(E entry) {
+    assert(!is_full(), "Window is full");
+    _entries[(_head + _size) & (MaxCapacity - 1)] = entry;
+    _size++;
+  }
+
+  bool pop(E& entry) {
+    if (is_empty()) {
+      return false;
+    }
+
+    entry = _entries[_head];
+    _head = (_head + 1) & (MaxCapacity - 1);
+    _size--;
+    return true;
+  }
+};
+
+#endif // SHARE_GC_SHARED_MARKPREFETCHWINDOW_HPP
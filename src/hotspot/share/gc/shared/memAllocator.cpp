@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
 #include "gc/shared/allocTracer.hpp"
+#include "gc/shared/allocationSiteProfiler.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/memAllocator.hpp"
 #include "gc/shared/threadLocalAllocBuffer.inline.hpp"
@@ -59,6 +60,7 @@ class MemAllocator::Allocation: StackObj {
   void notify_allocation_low_memory_detector();
   void notify_allocation_jfr_sampler();
   void notify_allocation_dtrace_sampler();
+  void notify_allocation_site_profiler();
   void check_for_bad_heap_word_value() const;
 #ifdef ASSERT
   void check_for_valid_allocation_state() const;
@@ -244,10 +246,22 @@ void MemAllocator::Allocation::notify_allocation_dtrace_sampler() {
   }
 }
 
+void MemAllocator::Allocation::notify_allocation_site_profiler() {
+  if (ProfileAllocationSites) {
+    if (_allocated_outside_tlab) {
+      AllocationSiteProfiler::record(_thread, _allocator._word_size * HeapWordSize);
+    } else if (_allocated_tlab_size != 0) {
+      // TLAB was refilled
+      AllocationSiteProfiler::record(_thread, _allocated_tlab_size * HeapWordSize);
+    }
+  }
+}
+
 void MemAllocator::Allocation::notify_allocation() {
   notify_allocation_low_memory_detector();
   notify_allocation_jfr_sampler();
   notify_allocation_dtrace_sampler();
+  notify_allocation_site_profiler();
   notify_allocation_jvmti_sampler();
 }
 
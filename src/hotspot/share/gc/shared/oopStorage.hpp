@@ -104,6 +104,16 @@ public:
   // postcondition: *result == NULL.
   oop* allocate();
 
+  // Maybe allocates more than one entry.  Returns the number of allocated
+  // entries, which is in [0,size], and stores them in ptrs[0..result).
+  // Entries are only taken from a single block, so the result may be less
+  // than size even if more entries are available.  Returns 0 if memory
+  // allocation failed.  Locks _allocation_mutex once, rather than once
+  // per entry as repeated calls to allocate() would.
+  // precondition: size > 0.
+  // postcondition: *ptrs[i] == NULL, for i in [0,result).
+  size_t allocate(oop** ptrs, size_t size);
+
   // Deallocates ptr.  No locking.
   // precondition: ptr is a valid allocated entry.
   // precondition: *ptr == NULL.
@@ -406,7 +406,14 @@ void CompactibleSpace::adjust_pointers() {
     return;   // Nothing to do.
   }
 
-  scan_and_adjust_pointers(this);
+  scan_and_adjust_pointers(this, bottom(), _end_of_live);
+}
+
+void CompactibleSpace::adjust_pointers_in_chunk(uint chunk) {
+  assert(chunk < _num_adjust_chunks, "chunk %u out of range", chunk);
+  HeapWord* start = _adjust_chunk_starts[chunk];
+  HeapWord* end = (chunk + 1 < _num_adjust_chunks) ? _adjust_chunk_starts[chunk + 1] : _end_of_live;
+  scan_and_adjust_pointers(this, start, end);
 }
 
 void CompactibleSpace::compact() {
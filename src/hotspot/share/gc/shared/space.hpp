@@ -360,7 +360,7 @@ private:
 
 public:
   CompactibleSpace() :
-   _compaction_top(NULL), _next_compaction_space(NULL) {}
+   _compaction_top(NULL), _next_compaction_space(NULL), _num_adjust_chunks(0) {}
 
   virtual void initialize(MemRegion mr, bool clear_space, bool mangle_space);
   virtual void clear(bool mangle_space);
@@ -405,6 +405,11 @@ public:
   virtual void prepare_for_compaction(CompactPoint* cp) = 0;
   // MarkSweep support phase3
   virtual void adjust_pointers();
+  // Parallel MarkSweep support phase3. The live part of the space is split
+  // into chunks at object starts recorded by prepare_for_compaction(), so
+  // that the chunks can be adjusted independently.
+  uint num_adjust_chunks() const { return used() == 0 ? 0 : _num_adjust_chunks; }
+  void adjust_pointers_in_chunk(uint chunk);
   // MarkSweep support phase4
   virtual void compact();
 #endif // INCLUDE_SERIALGC
@@ -446,6 +451,12 @@ protected:
   HeapWord* _first_dead;
   HeapWord* _end_of_live;
 
+  // Start addresses of the chunks for parallel pointer adjustment.
+  // The first chunk always starts at bottom().
+  static const uint MaxAdjustChunks = 64;
+  HeapWord* _adjust_chunk_starts[MaxAdjustChunks];
+  uint      _num_adjust_chunks;
+
   // This the function is invoked when an allocation of an object covering
   // "start" to "end occurs crosses the threshold; returns the next
   // threshold.  (The default implementation does nothing.)
@@ -462,7 +473,7 @@ protected:
 #if INCLUDE_SERIALGC
   // Frequently calls adjust_obj_size().
   template <class SpaceType>
-  static inline void scan_and_adjust_pointers(SpaceType* space);
+  static inline void scan_and_adjust_pointers(SpaceType* space, HeapWord* start, HeapWord* end);
 #endif
 
   // Frequently calls obj_size().
@@ -724,6 +735,12 @@ class OffsetTableContigSpace: public ContiguousSpace {
   virtual inline HeapWord* allocate(size_t word_size);
   inline HeapWord* par_allocate(size_t word_size);
 
+  // Record a block that is already allocated in the offset table,
+  // for blocks laid out after initialize_threshold().
+  void alloc_block(HeapWord* start, HeapWord* end) {
+    _offsets.alloc_block(start, end);
+  }
+
   // MarkSweep support phase3
   virtual HeapWord* initialize_threshold();
   virtual HeapWord* cross_threshold(HeapWord* start, HeapWord* end);
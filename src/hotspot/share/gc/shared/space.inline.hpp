@@ -162,12 +162,23 @@ inline void CompactibleSpace::scan_and_forward(SpaceType* space, CompactPoint* c
   HeapWord* cur_obj = space->bottom();
   HeapWord* scan_limit = space->scan_limit();
 
+  // Record live object starts at about equal distances for parallel
+  // pointer adjustment.
+  const size_t adjust_chunk_words = MAX2(pointer_delta(scan_limit, cur_obj) / MaxAdjustChunks, (size_t)1);
+  HeapWord* next_adjust_chunk = cur_obj + adjust_chunk_words;
+  space->_adjust_chunk_starts[0] = cur_obj;
+  space->_num_adjust_chunks = 1;
+
   while (cur_obj < scan_limit) {
     assert(!space->scanned_block_is_obj(cur_obj) ||
            oop(cur_obj)->mark_raw().is_marked() || oop(cur_obj)->mark_raw().is_unlocked() ||
            oop(cur_obj)->mark_raw().has_bias_pattern(),
            "these are the only valid states during a mark sweep");
     if (space->scanned_block_is_obj(cur_obj) && oop(cur_obj)->is_gc_marked()) {
+      if (cur_obj >= next_adjust_chunk && space->_num_adjust_chunks < MaxAdjustChunks) {
+        space->_adjust_chunk_starts[space->_num_adjust_chunks++] = cur_obj;
+        next_adjust_chunk = cur_obj + adjust_chunk_words;
+      }
       // prefetch beyond cur_obj
       Prefetch::write(cur_obj, interval);
       size_t size = space->scanned_block_size(cur_obj);
@@ -219,15 +230,18 @@ inline void CompactibleSpace::scan_and_forward(SpaceType* space, CompactPoint* c
 }
 
 template <class SpaceType>
-inline void CompactibleSpace::scan_and_adjust_pointers(SpaceType* space) {
+inline void CompactibleSpace::scan_and_adjust_pointers(SpaceType* space, HeapWord* start, HeapWord* end) {
   // adjust all the interior pointers to point at the new locations of objects
   // Used by MarkSweep::mark_sweep_phase3()
+  // The range [start, end) must begin at bottom() or at a live object, and
+  // must end at end_of_live or at a live object.
 
-  HeapWord* cur_obj = space->bottom();
-  HeapWord* const end_of_live = space->_end_of_live;  // Established by "scan_and_forward".
+  HeapWord* cur_obj = start;
+  HeapWord* const end_of_live = end;
   HeapWord* const first_dead = space->_first_dead;    // Established by "scan_and_forward".
 
-  assert(first_dead <= end_of_live, "Stands to reason, no?");
+  assert(first_dead <= space->_end_of_live, "Stands to reason, no?");
+  assert(end <= space->_end_of_live, "must be");
 
   const intx interval = PrefetchScanIntervalInBytes;
 
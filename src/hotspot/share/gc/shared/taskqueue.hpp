@@ -459,8 +459,13 @@ private:
   uint _n;
   T** _queues;
 
+  // Upper bound on the number of extra tasks taken by steal_half().
+  static const uint MaxStealBatch = 32;
+
   bool steal_best_of_2(uint queue_num, E& t);
 
+  void transfer_from_last_victim(uint queue_num);
+
 public:
   GenericTaskQueueSet(uint n);
   ~GenericTaskQueueSet();
@@ -473,6 +478,18 @@ public:
   // Returns if stealing succeeds, and sets "t" to the stolen task.
   bool steal(uint queue_num, E& t);
 
+  // As above, but first try the queues in preferred (e.g. those of workers
+  // on the same NUMA node), starting at a random one, before falling back
+  // to stealing from any queue.
+  bool steal(uint queue_num, const uint* preferred, uint num_preferred, E& t);
+
+  // As the steal() variants above, but after a successful steal also move
+  // up to half of the tasks left in the victim's queue to queue_num's queue,
+  // so that a thief does not have to come back for every single task. Only
+  // for callers that drain their own queue after each steal.
+  bool steal_half(uint queue_num, E& t);
+  bool steal_half(uint queue_num, const uint* preferred, uint num_preferred, E& t);
+
   DEBUG_ONLY(virtual void assert_empty() const;)
 
   virtual uint tasks() const;
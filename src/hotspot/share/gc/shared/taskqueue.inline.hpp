@@ -313,7 +313,11 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
-    return _queues[k]->pop_global(t);
+    if (_queues[k]->pop_global(t)) {
+      _queues[queue_num]->set_last_stolen_queue_id(k);
+      return true;
+    }
+    return false;
   } else {
     assert(_n == 1, "can't be zero.");
     return false;
@@ -332,6 +336,65 @@ GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
   return false;
 }
 
+template<class T, MEMFLAGS F> bool
+GenericTaskQueueSet<T, F>::steal(uint queue_num, const uint* preferred, uint num_preferred, E& t) {
+  if (num_preferred > 0) {
+    uint start = _queues[queue_num]->next_random_queue_id() % num_preferred;
+    for (uint i = 0; i < num_preferred; i++) {
+      uint k = preferred[(start + i) % num_preferred];
+      assert(k != queue_num && k < _n, "invalid victim %u", k);
+      TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal_attempt());
+      if (_queues[k]->size() > 0 && _queues[k]->pop_global(t)) {
+        TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal());
+        _queues[queue_num]->set_last_stolen_queue_id(k);
+        return true;
+      }
+    }
+  }
+  return steal(queue_num, t);
+}
+
+template<class T, MEMFLAGS F> void
+GenericTaskQueueSet<T, F>::transfer_from_last_victim(uint queue_num) {
+  T* const local_queue = _queues[queue_num];
+  if (!local_queue->is_last_stolen_queue_id_valid()) {
+    return;
+  }
+  T* const victim = _queues[local_queue->last_stolen_queue_id()];
+  // Stay clear of the capacity of the local queue, so pushing cannot fail.
+  // The owner only pops concurrently, so the local size can only shrink.
+  uint local_size = local_queue->size() + 1;
+  uint room = local_queue->max_elems() > local_size ? local_queue->max_elems() - local_size : 0;
+  uint n = MIN3(victim->size() / 2, MaxStealBatch, room);
+  for (uint i = 0; i < n; i++) {
+    E e;
+    if (!victim->pop_global(e)) {
+      break;
+    }
+    bool pushed = local_queue->push(e);
+    assert(pushed, "push must not fail");
+    TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal());
+  }
+}
+
+template<class T, MEMFLAGS F> bool
+GenericTaskQueueSet<T, F>::steal_half(uint queue_num, E& t) {
+  if (steal(queue_num, t)) {
+    transfer_from_last_victim(queue_num);
+    return true;
+  }
+  return false;
+}
+
+template<class T, MEMFLAGS F> bool
+GenericTaskQueueSet<T, F>::steal_half(uint queue_num, const uint* preferred, uint num_preferred, E& t) {
+  if (steal(queue_num, preferred, num_preferred, t)) {
+    transfer_from_last_victim(queue_num);
+    return true;
+  }
+  return false;
+}
+
 template<class E, MEMFLAGS F, unsigned int N>
 template<class Fn>
 inline void GenericTaskQueue<E, F, N>::iterate(Fn fn) {
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/threadLocalAllocBuffer.inline.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -72,13 +73,17 @@ void ThreadLocalAllocBuffer::accumulate_and_reset_statistics(ThreadLocalAllocSta
       // Keep alloc_frac as float and not double to avoid the double to float conversion
       float alloc_frac = MIN2(1.0f, allocated_since_last_gc / (float) used);
       _allocation_fraction.sample(alloc_frac);
+      if (TLABLargeAllocatorSizing) {
+        sample_allocation_history(alloc_frac);
+      }
     }
 
     stats->update_fast_allocations(_number_of_refills,
                                    _allocated_size,
                                    _gc_waste,
                                    _fast_refill_waste,
-                                   _slow_refill_waste);
+                                   _slow_refill_waste,
+                                   _large_allocator);
   } else {
     assert(_number_of_refills == 0 && _fast_refill_waste == 0 &&
            _slow_refill_waste == 0 && _gc_waste          == 0,
@@ -90,6 +95,35 @@ void ThreadLocalAllocBuffer::accumulate_and_reset_statistics(ThreadLocalAllocSta
   reset_statistics();
 }
 
+void ThreadLocalAllocBuffer::sample_allocation_history(float alloc_frac) {
+  _allocation_history[_allocation_history_next] = alloc_frac;
+  _allocation_history_next = (_allocation_history_next + 1) % AllocationHistoryLength;
+  _allocation_history_length = MIN2(_allocation_history_length + 1, AllocationHistoryLength);
+
+  // A thread is a large allocator if it allocated at least TLABLargeAllocatorPercent
+  // of eden between each of the last GCs. Requiring this for every entry of a full
+  // history keeps threads with an occasional burst out of the classification.
+  bool large_allocator = (_allocation_history_length == AllocationHistoryLength);
+  for (uint i = 0; large_allocator && i < _allocation_history_length; i++) {
+    large_allocator = (_allocation_history[i] * 100.0f >= TLABLargeAllocatorPercent);
+  }
+
+  if (large_allocator != _large_allocator) {
+    log_debug(gc, tlab)("TLAB: thread: " INTPTR_FORMAT " [id: %2d] %s large allocator",
+                        p2i(thread()), thread()->osthread()->thread_id(),
+                        large_allocator ? "became" : "no longer");
+  }
+  _large_allocator = large_allocator;
+}
+
+float ThreadLocalAllocBuffer::max_allocation_history() const {
+  float result = 0.0f;
+  for (uint i = 0; i < _allocation_history_length; i++) {
+    result = MAX2(result, _allocation_history[i]);
+  }
+  return result;
+}
+
 void ThreadLocalAllocBuffer::insert_filler() {
   assert(end() != NULL, "Must not be retired");
   if (top() < hard_end()) {
@@ -129,7 +163,13 @@ void ThreadLocalAllocBuffer::retire_before_allocation() {
 void ThreadLocalAllocBuffer::resize() {
   // Compute the next tlab size using expected allocation amount
   assert(ResizeTLAB, "Should not call this otherwise");
-  size_t alloc = (size_t)(_allocation_fraction.average() *
+  float alloc_frac = _allocation_fraction.average();
+  if (_large_allocator) {
+    // Size for the upper end of the recent allocation of this thread instead
+    // of the decaying average, which lags behind allocation bursts.
+    alloc_frac = MAX2(alloc_frac, max_allocation_history());
+  }
+  size_t alloc = (size_t)(alloc_frac *
                           (Universe::heap()->tlab_capacity(thread()) / HeapWordSize));
   size_t new_size = alloc / _target_refills;
 
@@ -138,9 +178,10 @@ void ThreadLocalAllocBuffer::resize() {
   size_t aligned_new_size = align_object_size(new_size);
 
   log_trace(gc, tlab)("TLAB new size: thread: " INTPTR_FORMAT " [id: %2d]"
-                      " refills %d  alloc: %8.6f desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT,
+                      " refills %d  alloc: %8.6f%s desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT,
                       p2i(thread()), thread()->osthread()->thread_id(),
-                      _target_refills, _allocation_fraction.average(), desired_size(), aligned_new_size);
+                      _target_refills, alloc_frac, _large_allocator ? " (large)" : "",
+                      desired_size(), aligned_new_size);
 
   set_desired_size(aligned_new_size);
   set_refill_waste_limit(initial_refill_waste_limit());
@@ -318,6 +359,7 @@ HeapWord* ThreadLocalAllocBuffer::hard_end() {
 }
 
 PerfVariable* ThreadLocalAllocStats::_perf_allocating_threads;
+PerfVariable* ThreadLocalAllocStats::_perf_large_allocating_threads;
 PerfVariable* ThreadLocalAllocStats::_perf_total_refills;
 PerfVariable* ThreadLocalAllocStats::_perf_max_refills;
 PerfVariable* ThreadLocalAllocStats::_perf_total_allocations;
@@ -343,6 +385,7 @@ void ThreadLocalAllocStats::initialize() {
   if (UsePerfData) {
     EXCEPTION_MARK;
     _perf_allocating_threads      = create_perf_variable("allocThreads", PerfData::U_None,  CHECK);
+    _perf_large_allocating_threads = create_perf_variable("largeAllocThreads", PerfData::U_None, CHECK);
     _perf_total_refills           = create_perf_variable("fills",        PerfData::U_None,  CHECK);
     _perf_max_refills             = create_perf_variable("maxFills",     PerfData::U_None,  CHECK);
     _perf_total_allocations       = create_perf_variable("alloc",        PerfData::U_Bytes, CHECK);
@@ -359,6 +402,7 @@ void ThreadLocalAllocStats::initialize() {
 
 ThreadLocalAllocStats::ThreadLocalAllocStats() :
     _allocating_threads(0),
+    _large_allocating_threads(0),
     _total_refills(0),
     _max_refills(0),
     _total_allocations(0),
@@ -379,8 +423,10 @@ void ThreadLocalAllocStats::update_fast_allocations(unsigned int refills,
                                        size_t allocations,
                                        size_t gc_waste,
                                        size_t fast_refill_waste,
-                                       size_t slow_refill_waste) {
+                                       size_t slow_refill_waste,
+                                       bool large_allocator) {
   _allocating_threads      += 1;
+  _large_allocating_threads += large_allocator ? 1 : 0;
   _total_refills           += refills;
   _max_refills              = MAX2(_max_refills, refills);
   _total_allocations       += allocations;
@@ -399,6 +445,7 @@ void ThreadLocalAllocStats::update_slow_allocations(unsigned int allocations) {
 
 void ThreadLocalAllocStats::update(const ThreadLocalAllocStats& other) {
   _allocating_threads      += other._allocating_threads;
+  _large_allocating_threads += other._large_allocating_threads;
   _total_refills           += other._total_refills;
   _max_refills              = MAX2(_max_refills, other._max_refills);
   _total_allocations       += other._total_allocations;
@@ -414,6 +461,7 @@ void ThreadLocalAllocStats::update(const ThreadLocalAllocStats& other) {
 
 void ThreadLocalAllocStats::reset() {
   _allocating_threads      = 0;
+  _large_allocating_threads = 0;
   _total_refills           = 0;
   _max_refills             = 0;
   _total_allocations       = 0;
@@ -436,12 +484,12 @@ void ThreadLocalAllocStats::publish() {
 
   const size_t waste = _total_gc_waste + _total_slow_refill_waste + _total_fast_refill_waste;
   const double waste_percent = percent_of(waste, _total_allocations);
-  log_debug(gc, tlab)("TLAB totals: thrds: %d  refills: %d max: %d"
+  log_debug(gc, tlab)("TLAB totals: thrds: %d large: %d  refills: %d max: %d"
                       " slow allocs: %d max %d waste: %4.1f%%"
                       " gc: " SIZE_FORMAT "B max: " SIZE_FORMAT "B"
                       " slow: " SIZE_FORMAT "B max: " SIZE_FORMAT "B"
                       " fast: " SIZE_FORMAT "B max: " SIZE_FORMAT "B",
-                      _allocating_threads, _total_refills, _max_refills,
+                      _allocating_threads, _large_allocating_threads, _total_refills, _max_refills,
                       _total_slow_allocations, _max_slow_allocations, waste_percent,
                       _total_gc_waste * HeapWordSize, _max_gc_waste * HeapWordSize,
                       _total_slow_refill_waste * HeapWordSize, _max_slow_refill_waste * HeapWordSize,
@@ -449,6 +497,7 @@ void ThreadLocalAllocStats::publish() {
 
   if (UsePerfData) {
     _perf_allocating_threads      ->set_value(_allocating_threads);
+    _perf_large_allocating_threads->set_value(_large_allocating_threads);
     _perf_total_refills           ->set_value(_total_refills);
     _perf_max_refills             ->set_value(_max_refills);
     _perf_total_allocations       ->set_value(_total_allocations);
@@ -461,6 +510,18 @@ void ThreadLocalAllocStats::publish() {
     _perf_total_slow_allocations  ->set_value(_total_slow_allocations);
     _perf_max_slow_allocations    ->set_value(_max_slow_allocations);
   }
+
+  EventTLABStatistics event;
+  if (event.should_commit()) {
+    event.set_allocatingThreads(_allocating_threads);
+    event.set_largeAllocatingThreads(_large_allocating_threads);
+    event.set_refills(_total_refills);
+    event.set_allocated(_total_allocations * HeapWordSize);
+    event.set_gcWaste(_total_gc_waste * HeapWordSize);
+    event.set_slowRefillWaste(_total_slow_refill_waste * HeapWordSize);
+    event.set_fastRefillWaste(_total_fast_refill_waste * HeapWordSize);
+    event.commit();
+  }
 }
 
 size_t ThreadLocalAllocBuffer::end_reserve() {
@@ -70,6 +70,13 @@ private:
 
   AdaptiveWeightedAverage _allocation_fraction;  // fraction of eden allocated in tlabs
 
+  // Allocation history over the last GCs, used with TLABLargeAllocatorSizing.
+  static const uint AllocationHistoryLength = 4;
+  float     _allocation_history[AllocationHistoryLength]; // fractions of eden allocated in tlabs
+  uint      _allocation_history_length;          // number of valid entries in _allocation_history
+  uint      _allocation_history_next;            // next entry of _allocation_history to overwrite
+  bool      _large_allocator;                    // allocated a large fraction of eden in each of the last GCs
+
   void reset_statistics();
 
   void set_start(HeapWord* start)                { _start = start; }
@@ -80,7 +87,10 @@ private:
   void set_desired_size(size_t desired_size)     { _desired_size = desired_size; }
   void set_refill_waste_limit(size_t waste)      { _refill_waste_limit = waste;  }
 
-  size_t initial_refill_waste_limit()            { return desired_size() / TLABRefillWasteFraction; }
+  size_t initial_refill_waste_limit() {
+    // Large allocators get larger TLABs; keep their waste at refill proportionally lower.
+    return desired_size() / (_large_allocator ? 2 * TLABRefillWasteFraction : TLABRefillWasteFraction);
+  }
 
   static int    target_refills()                 { return _target_refills; }
   size_t initial_desired_size();
@@ -98,6 +108,11 @@ private:
 
   void accumulate_and_reset_statistics(ThreadLocalAllocStats* stats);
 
+  // Record the fraction of eden allocated since the last GC and update
+  // the large allocator classification.
+  void sample_allocation_history(float alloc_frac);
+  float max_allocation_history() const;
+
   void print_stats(const char* tag);
 
   Thread* thread();
@@ -112,7 +127,8 @@ private:
 
 public:
   ThreadLocalAllocBuffer() : _allocated_before_last_gc(0), _bytes_since_last_sample_point(0),
-    _allocation_fraction(TLABAllocationWeight) {
+    _allocation_fraction(TLABAllocationWeight), _allocation_history_length(0),
+    _allocation_history_next(0), _large_allocator(false) {
     // do nothing.  tlabs must be inited by initialize() calls
   }
 
@@ -133,6 +149,7 @@ public:
   // Don't discard tlab if remaining space is larger than this.
   size_t refill_waste_limit() const              { return _refill_waste_limit; }
   size_t bytes_since_last_sample_point() const   { return _bytes_since_last_sample_point; }
+  bool is_large_allocator() const                { return _large_allocator; }
 
   // Allocate size HeapWords. The memory is NOT initialized to zero.
   inline HeapWord* allocate(size_t size);
@@ -194,6 +211,7 @@ public:
 class ThreadLocalAllocStats : public StackObj {
 private:
   static PerfVariable* _perf_allocating_threads;
+  static PerfVariable* _perf_large_allocating_threads;
   static PerfVariable* _perf_total_refills;
   static PerfVariable* _perf_max_refills;
   static PerfVariable* _perf_total_allocations;
@@ -209,6 +227,7 @@ private:
   static AdaptiveWeightedAverage _allocating_threads_avg;
 
   unsigned int _allocating_threads;
+  unsigned int _large_allocating_threads;
   unsigned int _total_refills;
   unsigned int _max_refills;
   size_t       _total_allocations;
@@ -231,7 +250,8 @@ public:
                                size_t allocations,
                                size_t gc_waste,
                                size_t fast_refill_waste,
-                               size_t slow_refill_waste);
+                               size_t slow_refill_waste,
+                               bool large_allocator);
   void update_slow_allocations(unsigned int allocations);
   void update(const ThreadLocalAllocStats& other);
 
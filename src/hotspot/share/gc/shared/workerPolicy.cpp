@@ -127,6 +127,18 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
       MAX2(min_workers, (prev_active_workers + new_active_workers) / 2);
   }
 
+  // The total number of workers was chosen for the processors available
+  // at startup. Do not use more than the share of them matching the
+  // processors available now, e.g. after the CPU quota of the container
+  // was lowered.
+  uintx active_workers_by_cpus = total_workers;
+  uint active_cpus = (uint) os::active_processor_count();
+  uint initial_cpus = (uint) os::initial_active_processor_count();
+  if (active_cpus < initial_cpus) {
+    active_workers_by_cpus = MAX2(min_workers, total_workers * active_cpus / initial_cpus);
+    new_active_workers = MIN2(new_active_workers, active_workers_by_cpus);
+  }
+
   // Check once more that the number of workers is within the limits.
   assert(min_workers <= total_workers, "Minimum workers not consistent with total workers");
   assert(new_active_workers >= min_workers, "Minimum workers not observed");
@@ -135,9 +147,10 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
   log_trace(gc, task)("WorkerPolicy::calc_default_active_workers() : "
     "active_workers(): " UINTX_FORMAT "  new_active_workers: " UINTX_FORMAT "  "
     "prev_active_workers: " UINTX_FORMAT "\n"
-    " active_workers_by_JT: " UINTX_FORMAT "  active_workers_by_heap_size: " UINTX_FORMAT,
+    " active_workers_by_JT: " UINTX_FORMAT "  active_workers_by_heap_size: " UINTX_FORMAT
+    "  active_workers_by_cpus: " UINTX_FORMAT,
     active_workers, new_active_workers, prev_active_workers,
-    active_workers_by_JT, active_workers_by_heap_size);
+    active_workers_by_JT, active_workers_by_heap_size, active_workers_by_cpus);
   assert(new_active_workers > 0, "Always need at least 1");
   return new_active_workers;
 }
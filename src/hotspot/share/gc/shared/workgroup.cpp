@@ -233,6 +233,12 @@ void AbstractGangWorker::run() {
 void AbstractGangWorker::initialize() {
   assert(_gang != NULL, "No gang to run in");
   os::set_priority(this, NearMaxPriority);
+  if (GCThreadPriority != -1) {
+    os::set_native_priority(this, (int)GCThreadPriority);
+  }
+  if (GCThreadCPUs != NULL && os::set_native_affinity(this, GCThreadCPUs) != OS_OK) {
+    log_warning(gc)("Could not bind %s to CPUs %s", name(), GCThreadCPUs);
+  }
   log_develop_trace(gc, workgang)("Running gang worker for gang %s id %u", gang()->name(), id());
   assert(!Thread::current()->is_VM_thread(), "VM thread should not be part"
          " of a work gang");
@@ -28,6 +28,7 @@
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahPacer.hpp"
 #include "gc/shenandoah/shenandoahPhaseTimings.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
 
@@ -191,6 +192,8 @@ void ShenandoahPacer::restart_with(size_t non_taxable_bytes, double tax_rate) {
   STATIC_ASSERT(sizeof(size_t) <= sizeof(intptr_t));
   Atomic::xchg(&_budget, (intptr_t)initial);
   Atomic::store(&_tax_rate, tax_rate);
+  Atomic::store(&_alloc_words, (size_t)0);
+  Atomic::store(&_alloc_threads, (size_t)0);
   Atomic::inc(&_epoch);
 
   // Shake up stalled waiters after budget update.
@@ -231,9 +234,28 @@ intptr_t ShenandoahPacer::epoch() {
   return Atomic::load(&_epoch);
 }
 
+// Record the allocation against the thread and the current epoch, and tell
+// whether the thread allocated less than the average allocating thread in
+// this epoch. The counters are updated racily around epoch changes, which
+// only makes the estimate a bit less precise.
+bool ShenandoahPacer::is_below_fair_share(JavaThread* thread, size_t words) {
+  bool first = false;
+  const size_t thread_words =
+    ShenandoahThreadLocalData::add_pacing_alloc_words(thread, Atomic::load(&_epoch), words, &first);
+  if (first) {
+    Atomic::inc(&_alloc_threads);
+  }
+  const size_t total_words = Atomic::add(&_alloc_words, words);
+  const size_t threads = MAX2<size_t>(1, Atomic::load(&_alloc_threads));
+  return thread_words < total_words / threads;
+}
+
 void ShenandoahPacer::pace_for_alloc(size_t words) {
   assert(ShenandoahPacing, "Only be here when pacing is enabled");
 
+  JavaThread* const thread = JavaThread::current();
+  const bool below_fair_share = ShenandoahPacingFairness && is_below_fair_share(thread, words);
+
   // Fast path: try to allocate right away
   bool claimed = claim_for_alloc(words, false);
   if (claimed) {
@@ -250,10 +272,19 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
   // Threads that are attaching should not block at all: they are not
   // fully initialized yet. Blocking them would be awkward.
   // This is probably the path that allocates the thread oop itself.
-  if (JavaThread::current()->is_attaching_via_jni()) {
+  if (thread->is_attaching_via_jni()) {
+    return;
+  }
+
+  // Threads that allocated less than their share in this cycle do not wait,
+  // their claim is taken from the budget and has to be repaid by GC progress
+  // before the heavier allocators get to proceed. This keeps the pacing delay
+  // on the threads that cause it.
+  if (below_fair_share) {
     return;
   }
 
+  EventShenandoahAllocationPacing event;
   double start = os::elapsedTime();
 
   size_t max_ms = ShenandoahPacingMaxDelay;
@@ -273,7 +304,8 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
       //     Breaking out and allocating anyway, which may mean we outpace GC,
       //     and start Degenerated GC cycle.
       //  b) The budget had been replenished, which means our claim is satisfied.
-      ShenandoahThreadLocalData::add_paced_time(JavaThread::current(), end - start);
+      ShenandoahThreadLocalData::add_paced_time(thread, end - start);
+      event.commit(words * HeapWordSize);
       break;
     }
   }
@@ -62,6 +62,12 @@ private:
   volatile intptr_t _progress;
   shenandoah_padding(3);
 
+  // Allocations paced in this epoch, and the number of threads that made them
+  shenandoah_padding(4);
+  volatile size_t _alloc_words;
+  volatile size_t _alloc_threads;
+  shenandoah_padding(5);
+
 public:
   ShenandoahPacer(ShenandoahHeap* heap) :
           _heap(heap),
@@ -71,7 +77,9 @@ public:
           _epoch(0),
           _tax_rate(1),
           _budget(0),
-          _progress(PACING_PROGRESS_UNINIT) {}
+          _progress(PACING_PROGRESS_UNINIT),
+          _alloc_words(0),
+          _alloc_threads(0) {}
 
   void setup_for_idle();
   void setup_for_mark();
@@ -107,6 +115,8 @@ private:
 
   size_t update_and_get_progress_history();
 
+  bool is_below_fair_share(JavaThread* thread, size_t words);
+
   void wait(size_t time_ms);
 };
 
@@ -50,6 +50,8 @@ private:
   bool _force_satb_flush;
   int  _disarmed_value;
   double _paced_time;
+  intptr_t _pacing_epoch;
+  size_t _pacing_alloc_words;
 
   ShenandoahThreadLocalData() :
     _gc_state(0),
@@ -61,7 +63,9 @@ private:
     _worker_id(INVALID_WORKER_ID),
     _force_satb_flush(false),
     _disarmed_value(0),
-    _paced_time(0) {
+    _paced_time(0),
+    _pacing_epoch(0),
+    _pacing_alloc_words(0) {
 
     // At least on x86_64, nmethod entry barrier encodes _disarmed_value offset
     // in instruction as disp8 immed
@@ -153,6 +157,18 @@ public:
     data(thread)->_paced_time = 0;
   }
 
+  // Words allocated by the thread since the given pacing epoch started
+  static size_t add_pacing_alloc_words(Thread* thread, intptr_t epoch, size_t words, bool* first) {
+    ShenandoahThreadLocalData* const d = data(thread);
+    *first = d->_pacing_epoch != epoch;
+    if (*first) {
+      d->_pacing_epoch = epoch;
+      d->_pacing_alloc_words = 0;
+    }
+    d->_pacing_alloc_words += words;
+    return d->_pacing_alloc_words;
+  }
+
   static void set_disarmed_value(Thread* thread, int value) {
     data(thread)->_disarmed_value = value;
   }
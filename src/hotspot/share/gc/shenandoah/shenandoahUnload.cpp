@@ -44,6 +44,7 @@
 #include "memory/iterator.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/access.inline.hpp"
+#include "runtime/sweeper.hpp"
 
 class ShenandoahIsUnloadingOopClosure : public OopClosure {
 private:
@@ -193,6 +194,8 @@ void ShenandoahUnload::unload() {
       CodeCache::purge_exception_caches();
     }
   }
+
+  NMethodSweeper::report_unloading_cycle();
 }
 
 void ShenandoahUnload::finish() {
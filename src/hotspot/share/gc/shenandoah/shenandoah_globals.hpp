@@ -234,6 +234,12 @@
           "GC effectively stall the threads indefinitely instead of going " \
           "to degenerated or Full GC.")                                     \
                                                                             \
+  product(bool, ShenandoahPacingFairness, true, EXPERIMENTAL,               \
+          "Only stall the threads that allocated more than the average "    \
+          "allocating thread during the current GC phase, and let the "     \
+          "lighter allocators proceed. This keeps the pacing delays on "    \
+          "the threads that cause them.")                                   \
+                                                                            \
   product(uintx, ShenandoahPacingIdleSlack, 2, EXPERIMENTAL,                \
           "How much of heap counted as non-taxable allocations during idle "\
           "phases. Larger value makes the pacing milder when collector is " \
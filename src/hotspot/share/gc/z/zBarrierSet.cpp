@@ -27,7 +27,9 @@
 #include "gc/z/zBarrierSetNMethod.hpp"
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zHeap.inline.hpp"
+#include "gc/z/zStackWatermark.hpp"
 #include "gc/z/zThreadLocalData.hpp"
+#include "runtime/stackWatermarkSet.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/macros.hpp"
 #ifdef COMPILER1
@@ -89,6 +91,11 @@ void ZBarrierSet::on_thread_destroy(Thread* thread) {
 void ZBarrierSet::on_thread_attach(Thread* thread) {
   // Set thread local address bad mask
   ZThreadLocalData::set_address_bad_mask(thread, ZAddressBadMask);
+  if (thread->is_Java_thread()) {
+    // Install stack watermark for lazy processing of the thread's frames
+    JavaThread* const jt = thread->as_Java_thread();
+    StackWatermarkSet::add_watermark(jt, new ZStackWatermark(jt));
+  }
 }
 
 void ZBarrierSet::on_thread_detach(Thread* thread) {
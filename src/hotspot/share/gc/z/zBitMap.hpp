@@ -37,6 +37,8 @@ public:
   ZBitMap(idx_t size_in_bits);
 
   bool par_set_bit_pair(idx_t bit, bool finalizable, bool& inc_live);
+
+  void prefetch_bit(idx_t bit) const;
 };
 
 #endif // SHARE_GC_Z_ZBITMAP_HPP
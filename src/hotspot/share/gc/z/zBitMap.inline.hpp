@@ -26,6 +26,7 @@
 
 #include "gc/z/zBitMap.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/prefetch.inline.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/debug.hpp"
 
@@ -76,4 +77,8 @@ inline bool ZBitMap::par_set_bit_pair(idx_t bit, bool finalizable, bool& inc_liv
   }
 }
 
+inline void ZBitMap::prefetch_bit(idx_t bit) const {
+  Prefetch::write(const_cast<bm_word_t*>(word_addr(bit)), 0);
+}
+
 #endif // SHARE_GC_Z_ZBITMAP_INLINE_HPP
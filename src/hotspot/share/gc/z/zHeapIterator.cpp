@@ -33,6 +33,7 @@
 #include "gc/z/zRootsIterator.hpp"
 #include "gc/z/zStat.hpp"
 #include "memory/iterator.inline.hpp"
+#include "runtime/stackWatermarkSet.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/stack.inline.hpp"
 
@@ -75,6 +76,15 @@ public:
   ZHeapIteratorRootOopClosure(ZHeapIterator* iter) :
       _iter(iter) {}
 
+  virtual void do_thread(Thread* thread) {
+    if (thread->is_Java_thread()) {
+      // Frames are processed lazily, make sure they have been
+      // processed before they are visited.
+      StackWatermarkSet::finish_processing(thread->as_Java_thread(), NULL /* context */, StackWatermarkKind::gc);
+    }
+    thread->oops_do_frames(this, NULL /* cf */);
+  }
+
   virtual void do_oop(oop* p) {
     const oop obj = load_oop(p);
     _iter->push(obj);
@@ -109,6 +119,15 @@ public:
     return VisitReferents ? DO_FIELDS : DO_FIELDS_EXCEPT_REFERENT;
   }
 
+  virtual void do_thread(Thread* thread) {
+    if (thread->is_Java_thread()) {
+      // Frames are processed lazily, make sure they have been
+      // processed before they are visited.
+      StackWatermarkSet::finish_processing(thread->as_Java_thread(), NULL /* context */, StackWatermarkKind::gc);
+    }
+    thread->oops_do_frames(this, NULL /* cf */);
+  }
+
   virtual void do_oop(oop* p) {
     const oop obj = load_oop(p);
     _iter->push(obj);
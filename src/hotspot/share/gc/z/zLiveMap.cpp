@@ -43,6 +43,7 @@ ZLiveMap::ZLiveMap(uint32_t size) :
     _seqnum(0),
     _live_objects(0),
     _live_bytes(0),
+    _live_largest(0),
     _segment_live_bits(0),
     _segment_claim_bits(0),
     _bitmap(bitmap_size(size, nsegments)),
@@ -62,6 +63,7 @@ void ZLiveMap::reset(size_t index) {
       // Reset marking information
       _live_bytes = 0;
       _live_objects = 0;
+      _live_largest = 0;
 
       // Clear segment claimed/live bits
       segment_live_bits().clear();
@@ -38,6 +38,7 @@ private:
   volatile uint32_t _seqnum;
   volatile uint32_t _live_objects;
   volatile size_t   _live_bytes;
+  volatile size_t   _live_largest;
   BitMap::bm_word_t _segment_live_bits;
   BitMap::bm_word_t _segment_claim_bits;
   ZBitMap           _bitmap;
@@ -78,11 +79,13 @@ public:
 
   uint32_t live_objects() const;
   size_t live_bytes() const;
+  size_t live_largest() const;
 
   bool get(size_t index) const;
   bool set(size_t index, bool finalizable, bool& inc_live);
+  void prefetch(size_t index) const;
 
-  void inc_live(uint32_t objects, size_t bytes);
+  void inc_live(uint32_t objects, size_t bytes, size_t largest);
 
   void iterate(ObjectClosure* cl, uintptr_t page_start, size_t page_object_alignment_shift);
 };
@@ -51,6 +51,11 @@ inline size_t ZLiveMap::live_bytes() const {
   return _live_bytes;
 }
 
+inline size_t ZLiveMap::live_largest() const {
+  assert(ZGlobalPhase != ZPhaseMark, "Invalid phase");
+  return _live_largest;
+}
+
 inline const BitMapView ZLiveMap::segment_live_bits() const {
   return BitMapView(const_cast<BitMap::bm_word_t*>(&_segment_live_bits), nsegments);
 }
@@ -119,9 +124,22 @@ inline bool ZLiveMap::set(size_t index, bool finalizable, bool& inc_live) {
   return _bitmap.par_set_bit_pair(index, finalizable, inc_live);
 }
 
-inline void ZLiveMap::inc_live(uint32_t objects, size_t bytes) {
+inline void ZLiveMap::prefetch(size_t index) const {
+  _bitmap.prefetch_bit(index);
+}
+
+inline void ZLiveMap::inc_live(uint32_t objects, size_t bytes, size_t largest) {
   Atomic::add(&_live_objects, objects);
   Atomic::add(&_live_bytes, bytes);
+
+  // Raise the size of the largest live object
+  for (size_t prev = Atomic::load(&_live_largest); largest > prev;) {
+    const size_t res = Atomic::cmpxchg(&_live_largest, prev, largest);
+    if (res == prev) {
+      break;
+    }
+    prev = res;
+  }
 }
 
 inline BitMap::idx_t ZLiveMap::segment_start(BitMap::idx_t segment) const {
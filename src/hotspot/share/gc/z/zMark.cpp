@@ -23,6 +23,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoaderDataGraph.hpp"
+#include "gc/shared/markPrefetchWindow.hpp"
 #include "gc/z/zBarrier.inline.hpp"
 #include "gc/z/zMark.inline.hpp"
 #include "gc/z/zMarkCache.inline.hpp"
@@ -46,6 +47,7 @@
 #include "runtime/handshake.hpp"
 #include "runtime/prefetch.inline.hpp"
 #include "runtime/safepointMechanism.hpp"
+#include "runtime/stackWatermarkSet.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/align.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -57,6 +59,7 @@ static const ZStatSubPhase ZSubPhaseConcurrentMarkTryFlush("Concurrent Mark Try
 static const ZStatSubPhase ZSubPhaseConcurrentMarkIdle("Concurrent Mark Idle");
 static const ZStatSubPhase ZSubPhaseConcurrentMarkTryTerminate("Concurrent Mark Try Terminate");
 static const ZStatSubPhase ZSubPhaseMarkTryComplete("Pause Mark Try Complete");
+static const ZStatSubPhase ZSubPhaseConcurrentMarkRootsJavaThreads("Concurrent Mark Roots Java Threads");
 
 ZMark::ZMark(ZWorkers* workers, ZPageTable* page_table) :
     _workers(workers),
@@ -67,8 +70,12 @@ ZMark::ZMark(ZWorkers* workers, ZPageTable* page_table) :
     _work_terminateflush(true),
     _work_nproactiveflush(0),
     _work_nterminateflush(0),
+    _work_nlocalsteal(0),
+    _work_nremotesteal(0),
     _nproactiveflush(0),
     _nterminateflush(0),
+    _nlocalsteal(0),
+    _nremotesteal(0),
     _ntrycomplete(0),
     _ncontinue(0),
     _nworkers(0) {}
@@ -90,9 +97,11 @@ void ZMark::prepare_mark() {
   // marking information for all pages.
   ZGlobalSeqNum++;
 
-  // Reset flush/continue counters
+  // Reset flush/steal/continue counters
   _nproactiveflush = 0;
   _nterminateflush = 0;
+  _nlocalsteal = 0;
+  _nremotesteal = 0;
   _ntrycomplete = 0;
   _ncontinue = 0;
 
@@ -108,8 +117,11 @@ void ZMark::prepare_mark() {
   ZStatMark::set_at_mark_start(nstripes);
 
   // Print worker/stripe distribution
+  // Workers using NUMA-affine stripes select their stripe when they start
+  // working, based on the NUMA node they run on, so there is nothing to
+  // print up front.
   LogTarget(Debug, gc, marking) log;
-  if (log.is_enabled()) {
+  if (log.is_enabled() && !_stripes.is_numa_affine()) {
     log.print("Mark Worker/Stripe Distribution");
     for (uint worker_id = 0; worker_id < _nworkers; worker_id++) {
       const ZMarkStripe* const stripe = _stripes.stripe_for_worker(_nworkers, worker_id);
@@ -197,15 +209,18 @@ void ZMark::prepare_work() {
   // Set number of active workers
   _terminate.reset(_nworkers);
 
-  // Reset flush counters
+  // Reset flush/steal counters
   _work_nproactiveflush = _work_nterminateflush = 0;
+  _work_nlocalsteal = _work_nremotesteal = 0;
   _work_terminateflush = true;
 }
 
 void ZMark::finish_work() {
-  // Accumulate proactive/terminate flush counters
+  // Accumulate proactive/terminate flush and local/remote steal counters
   _nproactiveflush += _work_nproactiveflush;
   _nterminateflush += _work_nterminateflush;
+  _nlocalsteal += _work_nlocalsteal;
+  _nremotesteal += _work_nremotesteal;
 }
 
 bool ZMark::is_array(uintptr_t addr) const {
@@ -215,7 +230,7 @@ bool ZMark::is_array(uintptr_t addr) const {
 void ZMark::push_partial_array(uintptr_t addr, size_t size, bool finalizable) {
   assert(is_aligned(addr, ZMarkPartialArrayMinSize), "Address misaligned");
   ZMarkThreadLocalStacks* const stacks = ZThreadLocalData::stacks(Thread::current());
-  ZMarkStripe* const stripe = _stripes.stripe_for_addr(addr);
+  ZMarkStripe* const stripe = stripe_for_addr(addr);
   const uintptr_t offset = ZAddress::offset(addr) >> ZMarkPartialArrayMinSizeShift;
   const uintptr_t length = size / oopSize;
   const ZMarkStackEntry entry(offset, length, finalizable);
@@ -368,17 +383,43 @@ void ZMark::mark_and_follow(ZMarkCache* cache, ZMarkStackEntry entry) {
   }
 }
 
+void ZMark::prefetch(ZMarkStackEntry entry) {
+  if (ZMarkPrefetchWindow == 0 || entry.partial_array()) {
+    // Partial arrays are not marked, only followed
+    return;
+  }
+
+  // Prefetch the mark bit and the object header
+  const uintptr_t addr = entry.object_address();
+  _page_table->get(addr)->prefetch_mark(addr);
+  Prefetch::read((void*)addr, 0);
+}
+
 template <typename T>
 bool ZMark::drain(ZMarkStripe* stripe, ZMarkThreadLocalStacks* stacks, ZMarkCache* cache, T* timeout) {
+  MarkPrefetchWindow<ZMarkStackEntry> window(MAX2(ZMarkPrefetchWindow, 1u));
   ZMarkStackEntry entry;
 
   // Drain stripe stacks
-  while (stacks->pop(&_allocator, &_stripes, stripe, entry)) {
+  for (;;) {
+    // Pop entries ahead of marking them and prefetch their objects
+    while (!window.is_full() && stacks->pop(&_allocator, &_stripes, stripe, entry)) {
+      prefetch(entry);
+      window.push(entry);
+    }
+
+    if (!window.pop(entry)) {
+      break;
+    }
+
     mark_and_follow(cache, entry);
 
     // Check timeout
     if (timeout->has_expired()) {
-      // Timeout
+      // Timeout, but first mark the entries popped ahead
+      while (window.pop(entry)) {
+        mark_and_follow(cache, entry);
+      }
       return false;
     }
   }
@@ -398,14 +439,18 @@ bool ZMark::drain_and_flush(ZMarkStripe* stripe, ZMarkThreadLocalStacks* stacks,
 }
 
 bool ZMark::try_steal(ZMarkStripe* stripe, ZMarkThreadLocalStacks* stacks) {
-  // Try to steal a stack from another stripe
-  for (ZMarkStripe* victim_stripe = _stripes.stripe_next(stripe);
-       victim_stripe != stripe;
-       victim_stripe = _stripes.stripe_next(victim_stripe)) {
+  // Try to steal a stack from another stripe. Visiting the stripes in
+  // the order given by xor-ing the stripe id with an increasing number
+  // visits all other stripes of the same NUMA node before any stripe of
+  // another node, since a node's stripes only differ in the low bits.
+  const size_t stripe_id = _stripes.stripe_id(stripe);
+  for (size_t i = 1; i < _stripes.nstripes(); i++) {
+    ZMarkStripe* const victim_stripe = _stripes.stripe_at(stripe_id ^ i);
     ZMarkStack* const stack = victim_stripe->steal_stack();
     if (stack != NULL) {
       // Success, install the stolen stack
       stacks->install(&_stripes, stripe, stack);
+      Atomic::inc(_stripes.is_same_node(stripe, victim_stripe) ? &_work_nlocalsteal : &_work_nremotesteal);
       return true;
     }
   }
@@ -641,10 +686,25 @@ public:
 };
 
 
+class ZMarkConcurrentStacksClosure : public ThreadClosure {
+private:
+  ZMarkConcurrentRootsIteratorClosure* const _cl;
+
+public:
+  ZMarkConcurrentStacksClosure(ZMarkConcurrentRootsIteratorClosure* cl) :
+      _cl(cl) {}
+
+  virtual void do_thread(Thread* thread) {
+    // Process the frames not already processed by the thread itself
+    StackWatermarkSet::finish_processing(thread->as_Java_thread(), _cl, StackWatermarkKind::gc);
+  }
+};
+
 class ZMarkConcurrentRootsTask : public ZTask {
 private:
   SuspendibleThreadSetJoiner          _sts_joiner;
   ZConcurrentRootsIteratorClaimStrong _roots;
+  ZJavaThreadsIterator                _java_threads;
   ZMarkConcurrentRootsIteratorClosure _cl;
 
 public:
@@ -652,6 +712,7 @@ public:
       ZTask("ZMarkConcurrentRootsTask"),
       _sts_joiner(),
       _roots(),
+      _java_threads(),
       _cl() {
     ClassLoaderDataGraph_lock->lock();
   }
@@ -662,6 +723,10 @@ public:
 
   virtual void work() {
     _roots.oops_do(&_cl);
+
+    ZStatTimer timer(ZSubPhaseConcurrentMarkRootsJavaThreads);
+    ZMarkConcurrentStacksClosure stacks_cl(&_cl);
+    _java_threads.threads_do(&stacks_cl);
   }
 };
 
@@ -735,7 +800,7 @@ bool ZMark::end() {
   }
 
   // Update statistics
-  ZStatMark::set_at_mark_end(_nproactiveflush, _nterminateflush, _ntrycomplete, _ncontinue);
+  ZStatMark::set_at_mark_end(_nproactiveflush, _nterminateflush, _nlocalsteal, _nremotesteal, _ntrycomplete, _ncontinue);
 
   // Mark completed
   return true;
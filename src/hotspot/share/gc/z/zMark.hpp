@@ -49,8 +49,12 @@ private:
   volatile bool       _work_terminateflush;
   volatile size_t     _work_nproactiveflush;
   volatile size_t     _work_nterminateflush;
+  volatile size_t     _work_nlocalsteal;
+  volatile size_t     _work_nremotesteal;
   size_t              _nproactiveflush;
   size_t              _nterminateflush;
+  size_t              _nlocalsteal;
+  size_t              _nremotesteal;
   size_t              _ntrycomplete;
   size_t              _ncontinue;
   uint                _nworkers;
@@ -58,6 +62,8 @@ private:
   size_t calculate_nstripes(uint nworkers) const;
   void prepare_mark();
 
+  ZMarkStripe* stripe_for_addr(uintptr_t addr);
+
   bool is_array(uintptr_t addr) const;
   void push_partial_array(uintptr_t addr, size_t size, bool finalizable);
   void follow_small_array(uintptr_t addr, size_t size, bool finalizable);
@@ -68,6 +74,7 @@ private:
   void follow_object(oop obj, bool finalizable);
   bool try_mark_object(ZMarkCache* cache, uintptr_t addr, bool finalizable);
   void mark_and_follow(ZMarkCache* cache, ZMarkStackEntry entry);
+  void prefetch(ZMarkStackEntry entry);
 
   template <typename T> bool drain(ZMarkStripe* stripe,
                                    ZMarkThreadLocalStacks* stacks,
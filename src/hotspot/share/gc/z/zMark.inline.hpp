@@ -27,15 +27,26 @@
 #include "gc/z/zAddress.inline.hpp"
 #include "gc/z/zMark.hpp"
 #include "gc/z/zMarkStack.inline.hpp"
+#include "gc/z/zPage.inline.hpp"
+#include "gc/z/zPageTable.inline.hpp"
 #include "gc/z/zThreadLocalData.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/debug.hpp"
 
+inline ZMarkStripe* ZMark::stripe_for_addr(uintptr_t addr) {
+  if (_stripes.is_numa_affine()) {
+    ZPage* const page = _page_table->get(addr);
+    return _stripes.stripe_for_addr(addr, page->numa_id());
+  }
+
+  return _stripes.stripe_for_addr(addr);
+}
+
 template <bool follow, bool finalizable, bool publish>
 inline void ZMark::mark_object(uintptr_t addr) {
   assert(ZAddress::is_marked(addr), "Should be marked");
   ZMarkThreadLocalStacks* const stacks = ZThreadLocalData::stacks(Thread::current());
-  ZMarkStripe* const stripe = _stripes.stripe_for_addr(addr);
+  ZMarkStripe* const stripe = stripe_for_addr(addr);
   ZMarkStackEntry entry(addr, follow, finalizable);
 
   stacks->push(&_allocator, &_stripes, stripe, entry, publish);
@@ -29,7 +29,8 @@
 ZMarkCacheEntry::ZMarkCacheEntry() :
     _page(NULL),
     _objects(0),
-    _bytes(0) {}
+    _bytes(0),
+    _largest(0) {}
 
 ZMarkCache::ZMarkCache(size_t nstripes) :
     _shift(ZMarkStripeShift + exact_log2(nstripes)) {}
@@ -34,6 +34,7 @@ private:
   ZPage*   _page;
   uint32_t _objects;
   size_t   _bytes;
+  size_t   _largest;
 
 public:
   ZMarkCacheEntry();
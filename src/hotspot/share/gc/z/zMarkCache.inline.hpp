@@ -32,19 +32,21 @@ inline void ZMarkCacheEntry::inc_live(ZPage* page, size_t bytes) {
     // Cache hit
     _objects++;
     _bytes += bytes;
+    _largest = MAX2(_largest, bytes);
   } else {
     // Cache miss
     evict();
     _page = page;
     _objects = 1;
     _bytes = bytes;
+    _largest = bytes;
   }
 }
 
 inline void ZMarkCacheEntry::evict() {
   if (_page != NULL) {
     // Write cached data out to page
-    _page->inc_live(_objects, _bytes);
+    _page->inc_live(_objects, _bytes, _largest);
     _page = NULL;
   }
 }
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "gc/z/zMarkStack.inline.hpp"
 #include "gc/z/zMarkStackAllocator.hpp"
+#include "gc/z/zNUMA.inline.hpp"
 #include "logging/log.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/powerOfTwo.hpp"
@@ -35,6 +36,9 @@ ZMarkStripe::ZMarkStripe() :
 ZMarkStripeSet::ZMarkStripeSet() :
     _nstripes(0),
     _nstripes_mask(0),
+    _numa_affine(false),
+    _nstripes_per_node_shift(0),
+    _nstripes_per_node_mask(0),
     _stripes() {}
 
 void ZMarkStripeSet::set_nstripes(size_t nstripes) {
@@ -46,7 +50,21 @@ void ZMarkStripeSet::set_nstripes(size_t nstripes) {
   _nstripes = nstripes;
   _nstripes_mask = nstripes - 1;
 
-  log_debug(gc, marking)("Using " SIZE_FORMAT " mark stripes", _nstripes);
+  // When there are enough stripes, split them into equally sized groups,
+  // one per NUMA node, so that objects are marked by workers on the node
+  // their memory lives on. Otherwise all stripes belong to one group.
+  const size_t nnodes = ZNUMA::count();
+  _numa_affine = ZNUMA::is_enabled() && nnodes > 1 && is_power_of_2(nnodes) && nstripes >= nnodes;
+  const size_t nstripes_per_node = _numa_affine ? nstripes / nnodes : nstripes;
+  _nstripes_per_node_shift = exact_log2(nstripes_per_node);
+  _nstripes_per_node_mask = nstripes_per_node - 1;
+
+  if (_numa_affine) {
+    log_debug(gc, marking)("Using " SIZE_FORMAT " mark stripes, " SIZE_FORMAT " per NUMA node",
+                           _nstripes, nstripes_per_node);
+  } else {
+    log_debug(gc, marking)("Using " SIZE_FORMAT " mark stripes", _nstripes);
+  }
 }
 
 bool ZMarkStripeSet::is_empty() const {
@@ -60,6 +78,16 @@ bool ZMarkStripeSet::is_empty() const {
 }
 
 ZMarkStripe* ZMarkStripeSet::stripe_for_worker(uint nworkers, uint worker_id) {
+  if (_numa_affine) {
+    // Use a stripe of the NUMA node the worker currently runs on. How
+    // many workers run on each node is not known up front, so workers
+    // are spread over the node's stripes by worker id.
+    const size_t index = ((size_t)ZNUMA::id() << _nstripes_per_node_shift) |
+                         (worker_id & _nstripes_per_node_mask);
+    assert(index < _nstripes, "Invalid index");
+    return &_stripes[index];
+  }
+
   const size_t spillover_limit = (nworkers / _nstripes) * _nstripes;
   size_t index;
 
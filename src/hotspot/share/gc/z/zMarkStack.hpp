@@ -89,6 +89,9 @@ class ZMarkStripeSet {
 private:
   size_t      _nstripes;
   size_t      _nstripes_mask;
+  bool        _numa_affine;
+  size_t      _nstripes_per_node_shift;
+  size_t      _nstripes_per_node_mask;
   ZMarkStripe _stripes[ZMarkStripesMax];
 
 public:
@@ -98,12 +101,14 @@ public:
   void set_nstripes(size_t nstripes);
 
   bool is_empty() const;
+  bool is_numa_affine() const;
+  bool is_same_node(const ZMarkStripe* stripe0, const ZMarkStripe* stripe1) const;
 
   size_t stripe_id(const ZMarkStripe* stripe) const;
   ZMarkStripe* stripe_at(size_t index);
-  ZMarkStripe* stripe_next(ZMarkStripe* stripe);
   ZMarkStripe* stripe_for_worker(uint nworkers, uint worker_id);
   ZMarkStripe* stripe_for_addr(uintptr_t addr);
+  ZMarkStripe* stripe_for_addr(uintptr_t addr, uint32_t numa_id);
 };
 
 class ZMarkStackAllocator;
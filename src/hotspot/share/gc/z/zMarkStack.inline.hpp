@@ -188,6 +188,14 @@ inline size_t ZMarkStripeSet::nstripes() const {
   return _nstripes;
 }
 
+inline bool ZMarkStripeSet::is_numa_affine() const {
+  return _numa_affine;
+}
+
+inline bool ZMarkStripeSet::is_same_node(const ZMarkStripe* stripe0, const ZMarkStripe* stripe1) const {
+  return (stripe_id(stripe0) >> _nstripes_per_node_shift) == (stripe_id(stripe1) >> _nstripes_per_node_shift);
+}
+
 inline size_t ZMarkStripeSet::stripe_id(const ZMarkStripe* stripe) const {
   const size_t index = ((uintptr_t)stripe - (uintptr_t)_stripes) / sizeof(ZMarkStripe);
   assert(index < _nstripes, "Invalid index");
@@ -199,14 +207,16 @@ inline ZMarkStripe* ZMarkStripeSet::stripe_at(size_t index) {
   return &_stripes[index];
 }
 
-inline ZMarkStripe* ZMarkStripeSet::stripe_next(ZMarkStripe* stripe) {
-  const size_t index = (stripe_id(stripe) + 1) & _nstripes_mask;
+inline ZMarkStripe* ZMarkStripeSet::stripe_for_addr(uintptr_t addr) {
+  const size_t index = (addr >> ZMarkStripeShift) & _nstripes_mask;
   assert(index < _nstripes, "Invalid index");
   return &_stripes[index];
 }
 
-inline ZMarkStripe* ZMarkStripeSet::stripe_for_addr(uintptr_t addr) {
-  const size_t index = (addr >> ZMarkStripeShift) & _nstripes_mask;
+inline ZMarkStripe* ZMarkStripeSet::stripe_for_addr(uintptr_t addr, uint32_t numa_id) {
+  // Select a stripe among the stripes of the NUMA node the address lives on
+  const size_t index = ((size_t)numa_id << _nstripes_per_node_shift) |
+                       ((addr >> ZMarkStripeShift) & _nstripes_per_node_mask);
   assert(index < _nstripes, "Invalid index");
   return &_stripes[index];
 }
@@ -26,6 +26,8 @@
 #include "gc/z/zLock.inline.hpp"
 #include "gc/z/zMarkStack.inline.hpp"
 #include "gc/z/zMarkStackAllocator.hpp"
+#include "gc/z/zNUMA.hpp"
+#include "gc/z/zValue.inline.hpp"
 #include "logging/log.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
@@ -166,21 +168,34 @@ ZMarkStackMagazine* ZMarkStackAllocator::create_magazine_from_space(uintptr_t ad
 }
 
 ZMarkStackMagazine* ZMarkStackAllocator::alloc_magazine() {
-  // Try allocating from the free list first
-  ZMarkStackMagazine* const magazine = _freelist.pop();
+  // Try allocating from the free list of the local NUMA node first
+  ZMarkStackMagazine* const magazine = _freelist.get().pop();
   if (magazine != NULL) {
     return magazine;
   }
 
-  // Allocate new magazine
+  // Allocate new magazine, its memory will be first touched, and
+  // hence placed, on the local NUMA node
   const uintptr_t addr = _space.alloc(ZMarkStackMagazineSize);
-  if (addr == 0) {
-    return NULL;
+  if (addr != 0) {
+    return create_magazine_from_space(addr, ZMarkStackMagazineSize);
+  }
+
+  // Out of space, try allocating from the free lists of remote NUMA nodes
+  ZPerNUMAIterator<ZMarkStackMagazineList> iter(&_freelist);
+  for (ZMarkStackMagazineList* freelist; iter.next(&freelist);) {
+    ZMarkStackMagazine* const remote_magazine = freelist->pop();
+    if (remote_magazine != NULL) {
+      return remote_magazine;
+    }
   }
 
-  return create_magazine_from_space(addr, ZMarkStackMagazineSize);
+  return NULL;
 }
 
 void ZMarkStackAllocator::free_magazine(ZMarkStackMagazine* magazine) {
-  _freelist.push(magazine);
+  // Return the magazine to the free list of the NUMA node its memory
+  // lives on, which is not necessarily the node of the freeing thread
+  const uint32_t numa_id = ZNUMA::memory_id((uintptr_t)magazine);
+  _freelist.get(numa_id).push(magazine);
 }
@@ -26,6 +26,7 @@
 
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zLock.hpp"
+#include "gc/z/zValue.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 class ZMarkStackSpace {
@@ -50,7 +51,7 @@ public:
 
 class ZMarkStackAllocator {
 private:
-  ZCACHE_ALIGNED ZMarkStackMagazineList _freelist;
+  ZPerNUMA<ZMarkStackMagazineList>      _freelist;
   ZCACHE_ALIGNED ZMarkStackSpace        _space;
 
   void prime_freelist();
@@ -94,10 +94,12 @@ public:
   bool is_object_live(uintptr_t addr) const;
   bool is_object_strongly_live(uintptr_t addr) const;
   bool mark_object(uintptr_t addr, bool finalizable, bool& inc_live);
+  void prefetch_mark(uintptr_t addr) const;
 
-  void inc_live(uint32_t objects, size_t bytes);
+  void inc_live(uint32_t objects, size_t bytes, size_t largest);
   uint32_t live_objects() const;
   size_t live_bytes() const;
+  size_t live_largest() const;
 
   void object_iterate(ObjectClosure* cl);
 
@@ -200,8 +200,13 @@ inline bool ZPage::mark_object(uintptr_t addr, bool finalizable, bool& inc_live)
   return _livemap.set(index, finalizable, inc_live);
 }
 
-inline void ZPage::inc_live(uint32_t objects, size_t bytes) {
-  _livemap.inc_live(objects, bytes);
+inline void ZPage::prefetch_mark(uintptr_t addr) const {
+  const size_t index = ((ZAddress::offset(addr) - start()) >> object_alignment_shift()) * 2;
+  _livemap.prefetch(index);
+}
+
+inline void ZPage::inc_live(uint32_t objects, size_t bytes, size_t largest) {
+  _livemap.inc_live(objects, bytes, largest);
 }
 
 inline uint32_t ZPage::live_objects() const {
@@ -214,6 +219,11 @@ inline size_t ZPage::live_bytes() const {
   return _livemap.live_bytes();
 }
 
+inline size_t ZPage::live_largest() const {
+  assert(is_marked(), "Should be marked");
+  return _livemap.live_largest();
+}
+
 inline void ZPage::object_iterate(ObjectClosure* cl) {
   _livemap.iterate(cl, ZAddress::good(start()), object_alignment_shift());
 }
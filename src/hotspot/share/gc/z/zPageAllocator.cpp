@@ -49,6 +49,7 @@
 
 static const ZStatCounter       ZCounterAllocationRate("Memory", "Allocation Rate", ZStatUnitBytesPerSecond);
 static const ZStatCounter       ZCounterPageCacheFlush("Memory", "Page Cache Flush", ZStatUnitBytesPerSecond);
+static const ZStatCounter       ZCounterPageCacheMerge("Memory", "Page Cache Merge", ZStatUnitBytesPerSecond);
 static const ZStatCriticalPhase ZCriticalPhaseAllocationStall("Allocation Stall");
 
 enum ZPageAllocationStall {
@@ -547,6 +548,57 @@ bool ZPageAllocator::alloc_page_or_stall(ZPageAllocation* allocation) {
   return alloc_page_stall(allocation);
 }
 
+ZPage* ZPageAllocator::alloc_page_merge(ZPageAllocation* allocation) {
+  // If the flushed pages cover the whole allocation and are contiguous in
+  // the address space, they are already committed and mapped in the right
+  // place. Merge them into the new page instead of unmapping and remapping.
+  ZList<ZPage>* const pages = allocation->pages();
+  const ZPage* const first = pages->first();
+  if (first == NULL) {
+    return NULL;
+  }
+
+  const uintptr_t start = first->start();
+  uintptr_t end = start;
+
+  ZListIterator<ZPage> iter(pages);
+  for (ZPage* page; iter.next(&page);) {
+    if (page->start() != end) {
+      // Not contiguous
+      return NULL;
+    }
+
+    end = page->end();
+  }
+
+  const size_t size = allocation->size();
+  if (end - start != size) {
+    // Not covering the allocation
+    return NULL;
+  }
+
+  const ZVirtualMemory vmem(start, size);
+  ZPhysicalMemory pmem;
+
+  // Harvest physical memory from merged pages
+  ZListRemoveIterator<ZPage> iter_remove(pages);
+  for (ZPage* page; iter_remove.next(&page);) {
+    ZPhysicalMemory& fmem = page->physical_memory();
+    pmem.add_segments(fmem);
+    fmem.remove_segments();
+
+    // The virtual and physical memory now belong to the new page
+    _safe_delete(page);
+  }
+
+  // Update statistics
+  ZStatInc(ZCounterPageCacheMerge, size);
+  log_debug(gc, heap)("Page Cache Merged: " SIZE_FORMAT "M", size / M);
+
+  // Create new page
+  return new ZPage(allocation->type(), vmem, pmem);
+}
+
 ZPage* ZPageAllocator::alloc_page_create(ZPageAllocation* allocation) {
   const size_t size = allocation->size();
 
@@ -612,6 +664,12 @@ ZPage* ZPageAllocator::alloc_page_finalize(ZPageAllocation* allocation) {
     return allocation->pages()->remove_first();
   }
 
+  // Medium path, no remapping needed
+  ZPage* const merged_page = alloc_page_merge(allocation);
+  if (merged_page != NULL) {
+    return merged_page;
+  }
+
   // Slow path
   ZPage* const page = alloc_page_create(allocation);
   if (page == NULL) {
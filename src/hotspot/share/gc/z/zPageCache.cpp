@@ -22,6 +22,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/z/zArray.inline.hpp"
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zList.inline.hpp"
 #include "gc/z/zNUMA.hpp"
@@ -199,6 +200,84 @@ void ZPageCache::free_page(ZPage* page) {
   }
 }
 
+void ZPageCache::remove_page(ZPage* page) {
+  const uint8_t type = page->type();
+  if (type == ZPageTypeSmall) {
+    _small.get(page->numa_id()).remove(page);
+  } else if (type == ZPageTypeMedium) {
+    _medium.remove(page);
+  } else {
+    _large.remove(page);
+  }
+}
+
+class ZPageCacheCollectClosure : public ZPageClosure {
+private:
+  ZArray<ZPage*>* const _pages;
+
+public:
+  ZPageCacheCollectClosure(ZArray<ZPage*>* pages) :
+      _pages(pages) {}
+
+  virtual void do_page(const ZPage* page) {
+    _pages->append(const_cast<ZPage*>(page));
+  }
+};
+
+static int compare_page_start(ZPage** p1, ZPage** p2) {
+  const uintptr_t start1 = (*p1)->start();
+  const uintptr_t start2 = (*p2)->start();
+  return start1 < start2 ? -1 : (start1 > start2 ? 1 : 0);
+}
+
+bool ZPageCache::flush_contiguous_for_allocation(size_t requested, ZList<ZPage>* to) {
+  // Cached pages that are adjacent in the address space can be merged
+  // into a new page without being unmapped and remapped. Look for the
+  // first run of such pages that is large enough.
+  ZArray<ZPage*> pages;
+  ZPageCacheCollectClosure cl(&pages);
+  pages_do(&cl);
+  pages.sort(compare_page_start);
+
+  int run_start = 0;
+  size_t run_size = 0;
+
+  for (int i = 0; i < pages.length(); i++) {
+    ZPage* const page = pages.at(i);
+    if (i == 0 || pages.at(i - 1)->end() != page->start()) {
+      // Start new run
+      run_start = i;
+      run_size = 0;
+    }
+
+    run_size += page->size();
+    if (run_size < requested) {
+      continue;
+    }
+
+    // Flush run, re-insert the part of the last page that is not needed
+    size_t flushed = 0;
+    for (int j = run_start; j <= i; j++) {
+      ZPage* flush_page = pages.at(j);
+      remove_page(flush_page);
+
+      const size_t needed = requested - flushed;
+      if (flush_page->size() > needed) {
+        ZPage* const remainder = flush_page;
+        flush_page = remainder->split(needed);
+        free_page(remainder);
+      }
+
+      to->insert_last(flush_page);
+      flushed += flush_page->size();
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
 bool ZPageCache::flush_list_inner(ZPageCacheFlushClosure* cl, ZList<ZPage>* from, ZList<ZPage>* to) {
   ZPage* const page = from->last();
   if (page == NULL || !cl->do_page(page)) {
@@ -271,6 +350,11 @@ public:
 };
 
 void ZPageCache::flush_for_allocation(size_t requested, ZList<ZPage>* to) {
+  // Prefer flushing pages that can be merged without being remapped
+  if (flush_contiguous_for_allocation(requested, to)) {
+    return;
+  }
+
   ZPageCacheFlushForAllocationClosure cl(requested);
   flush(&cl, to);
 }
@@ -45,6 +45,9 @@ private:
   ZPage* alloc_oversized_large_page(size_t size);
   ZPage* alloc_oversized_page(size_t size);
 
+  void remove_page(ZPage* page);
+  bool flush_contiguous_for_allocation(size_t requested, ZList<ZPage>* to);
+
   bool flush_list_inner(ZPageCacheFlushClosure* cl, ZList<ZPage>* from, ZList<ZPage>* to);
   void flush_list(ZPageCacheFlushClosure* cl, ZList<ZPage>* from, ZList<ZPage>* to);
   void flush_per_numa_lists(ZPageCacheFlushClosure* cl, ZPerNUMA<ZList<ZPage> >* from, ZList<ZPage>* to);
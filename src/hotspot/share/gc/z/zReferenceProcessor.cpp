@@ -33,6 +33,7 @@
 #include "gc/z/zTracer.inline.hpp"
 #include "gc/z/zUtils.inline.hpp"
 #include "gc/z/zValue.inline.hpp"
+#include "gc/z/zWorkers.inline.hpp"
 #include "memory/universe.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -113,6 +114,7 @@ ZReferenceProcessor::ZReferenceProcessor(ZWorkers* workers) :
     _discovered_count(),
     _enqueued_count(),
     _discovered_list(NULL),
+    _claimed_list(0),
     _pending_list(NULL),
     _pending_list_tail(_pending_list.addr()) {}
 
@@ -299,9 +301,8 @@ oop* ZReferenceProcessor::keep(oop reference, ReferenceType type) {
   return reference_discovered_addr(reference);
 }
 
-void ZReferenceProcessor::work() {
+void ZReferenceProcessor::process_list(oop* list) {
   // Process discovered references
-  oop* const list = _discovered_list.addr();
   oop* p = list;
 
   while (*p != NULL) {
@@ -328,6 +329,48 @@ void ZReferenceProcessor::work() {
   }
 }
 
+void ZReferenceProcessor::work() {
+  // Discovered lists are claimed rather than owned by the worker that
+  // discovered them. This allows the lists to be processed by fewer workers
+  // than there are lists, and lets workers that finish early pick up lists
+  // that would otherwise have been processed by a busy worker.
+  for (;;) {
+    const uint32_t index = Atomic::fetch_and_add(&_claimed_list, 1u);
+    if (index >= ZPerWorkerStorage::count()) {
+      // All lists claimed
+      return;
+    }
+
+    process_list(_discovered_list.addr(index));
+  }
+}
+
+size_t ZReferenceProcessor::discovered_count() const {
+  size_t count = 0;
+
+  ZPerWorkerConstIterator<Counters> iter(&_discovered_count);
+  for (const Counters* counters; iter.next(&counters);) {
+    for (int i = REF_SOFT; i <= REF_PHANTOM; i++) {
+      count += (*counters)[i];
+    }
+  }
+
+  return count;
+}
+
+uint ZReferenceProcessor::nworkers() const {
+  const uint max_workers = _workers->nconcurrent();
+  if (ReferencesPerThread == 0) {
+    // Always use all workers
+    return max_workers;
+  }
+
+  // Use one worker per ReferencesPerThread discovered references
+  const size_t count = discovered_count();
+  const size_t workers = (count + ReferencesPerThread - 1) / ReferencesPerThread;
+  return (uint)clamp(workers, (size_t)1, (size_t)max_workers);
+}
+
 bool ZReferenceProcessor::is_empty() const {
   ZPerWorkerConstIterator<oop> iter(&_discovered_list);
   for (const oop* list; iter.next(&list);) {
@@ -432,8 +475,12 @@ void ZReferenceProcessor::process_references() {
   ZStatTimer timer(ZSubPhaseConcurrentReferencesProcess);
 
   // Process discovered lists
+  const uint nworkers = this->nworkers();
+  log_debug(gc, ref)("Processing References, Active Workers: %u", nworkers);
+
+  Atomic::store(&_claimed_list, 0u);
   ZReferenceProcessorTask task(this);
-  _workers->run_concurrent(&task);
+  _workers->run_concurrent(&task, nworkers);
 
   // Update SoftReference clock
   soft_reference_update_clock();
@@ -43,6 +43,7 @@ private:
   ZPerWorker<Counters> _discovered_count;
   ZPerWorker<Counters> _enqueued_count;
   ZPerWorker<oop>      _discovered_list;
+  volatile uint32_t    _claimed_list;
   ZContended<oop>      _pending_list;
   oop*                 _pending_list_tail;
 
@@ -62,6 +63,10 @@ private:
 
   bool is_empty() const;
 
+  size_t discovered_count() const;
+  uint nworkers() const;
+
+  void process_list(oop* list);
   void work();
   void collect_statistics();
 
@@ -22,6 +22,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
 #include "gc/z/zAddress.inline.hpp"
 #include "gc/z/zBarrier.inline.hpp"
 #include "gc/z/zForwarding.inline.hpp"
@@ -37,8 +38,11 @@
 #include "gc/z/zThreadLocalAllocBuffer.hpp"
 #include "gc/z/zWorkers.hpp"
 #include "logging/log.hpp"
+#include "runtime/stackWatermarkSet.hpp"
+#include "runtime/thread.hpp"
 
 static const ZStatCounter ZCounterRelocationContention("Contention", "Relocation Contention", ZStatUnitOpsPerSecond);
+static const ZStatSubPhase ZSubPhaseConcurrentRelocateRootsJavaThreads("Concurrent Relocate Roots Java Threads");
 
 ZRelocate::ZRelocate(ZWorkers* workers) :
     _workers(workers) {}
@@ -228,7 +232,60 @@ public:
   }
 };
 
+class ZRelocateConcurrentStacksOopClosure : public OopClosure {
+public:
+  virtual void do_oop(oop* p) {
+    ZBarrier::relocate_barrier_on_root_oop_field(p);
+  }
+
+  virtual void do_oop(narrowOop* p) {
+    ShouldNotReachHere();
+  }
+};
+
+class ZRelocateConcurrentStacksClosure : public ThreadClosure {
+private:
+  ZRelocateConcurrentStacksOopClosure* const _cl;
+
+public:
+  ZRelocateConcurrentStacksClosure(ZRelocateConcurrentStacksOopClosure* cl) :
+      _cl(cl) {}
+
+  virtual void do_thread(Thread* thread) {
+    // Process the frames not already processed by the thread itself
+    StackWatermarkSet::finish_processing(thread->as_Java_thread(), _cl, StackWatermarkKind::gc);
+  }
+};
+
+class ZRelocateConcurrentStacksTask : public ZTask {
+private:
+  SuspendibleThreadSetJoiner          _sts_joiner;
+  ZJavaThreadsIterator                _java_threads;
+  ZRelocateConcurrentStacksOopClosure _cl;
+
+public:
+  ZRelocateConcurrentStacksTask() :
+      ZTask("ZRelocateConcurrentStacksTask"),
+      _sts_joiner(),
+      _java_threads(),
+      _cl() {}
+
+  virtual void work() {
+    ZStatTimer timer(ZSubPhaseConcurrentRelocateRootsJavaThreads);
+    ZRelocateConcurrentStacksClosure stacks_cl(&_cl);
+    _java_threads.threads_do(&stacks_cl);
+  }
+};
+
 bool ZRelocate::relocate(ZRelocationSet* relocation_set) {
+  {
+    // Finish processing all stacks in the relocate epoch, so that no
+    // frame still refers to the relocation set when the next cycle
+    // discards its forwarding information.
+    ZRelocateConcurrentStacksTask task;
+    _workers->run_concurrent(&task);
+  }
+
   ZRelocateTask task(this, relocation_set);
   _workers->run_concurrent(&task);
   return !task.failed();
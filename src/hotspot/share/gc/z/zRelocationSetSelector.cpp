@@ -144,18 +144,24 @@ void ZRelocationSetSelectorGroup::select_inner() {
   size_t selected_from = 0;
   size_t selected_to = 0;
   size_t from_size = 0;
+  size_t from_largest = 0;
 
   semi_sort();
 
   for (size_t from = 1; from <= npages; from++) {
     // Add page to the candidate relocation set
     from_size += _sorted_pages[from - 1]->live_bytes();
+    from_largest = MAX2(from_largest, _sorted_pages[from - 1]->live_largest());
 
     // Calculate the maximum number of pages needed by the candidate relocation set.
-    // By subtracting the object size limit from the pages size we get the maximum
-    // number of pages that the relocation set is guaranteed to fit in, regardless
-    // of in which order the objects are relocated.
-    const size_t to = ceil((double)(from_size) / (double)(_page_size - _object_size_limit));
+    // A target page can at most waste the size of the largest object that did not
+    // fit at its end. By subtracting the size of the largest live object in the
+    // candidate relocation set from the page size we get the maximum number of
+    // pages that the relocation set is guaranteed to fit in, regardless of in
+    // which order the objects are relocated. This is usually much less than the
+    // object size limit, in particular for medium pages.
+    const size_t waste = MIN2(from_largest, _object_size_limit);
+    const size_t to = ceil((double)(from_size) / (double)(_page_size - waste));
 
     // Calculate the relative difference in reclaimable space compared to our
     // currently selected final relocation set. If this number is larger than the
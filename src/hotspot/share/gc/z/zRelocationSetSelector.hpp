@@ -50,6 +50,7 @@ public:
   size_t live() const;
   size_t garbage() const;
   size_t empty() const;
+  size_t fragmentation() const;
   size_t compacting_from() const;
   size_t compacting_to() const;
 };
@@ -46,6 +46,12 @@ inline size_t ZRelocationSetSelectorGroupStats::empty() const {
   return _empty;
 }
 
+// Garbage on pages that still contain live objects, which can only
+// be reclaimed by relocating those objects.
+inline size_t ZRelocationSetSelectorGroupStats::fragmentation() const {
+  return _garbage - _empty;
+}
+
 inline size_t ZRelocationSetSelectorGroupStats::compacting_from() const {
   return _compacting_from;
 }
@@ -25,7 +25,6 @@
 #include "classfile/classLoaderDataGraph.hpp"
 #include "classfile/stringTable.hpp"
 #include "code/codeCache.hpp"
-#include "compiler/oopMap.hpp"
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/barrierSetNMethod.hpp"
 #include "gc/shared/oopStorageSet.hpp"
@@ -162,7 +161,9 @@ public:
 
   virtual void do_thread(Thread* thread) {
     ZRootsIteratorCodeBlobClosure code_cl(_cl);
-    thread->oops_do(_cl, ClassUnloading ? &code_cl : NULL);
+    // The frames of Java threads are processed lazily after the pause,
+    // by the threads themselves or by the concurrent roots iteration.
+    thread->oops_do_no_frames(_cl, ClassUnloading ? &code_cl : NULL);
     _cl->do_thread(thread);
   }
 };
@@ -191,7 +192,6 @@ ZRootsIterator::ZRootsIterator(bool visit_jvmti_weak_export) :
     _code_cache(this) {
   assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
   ZStatTimer timer(ZSubPhasePauseRootsSetup);
-  COMPILER2_OR_JVMCI_PRESENT(DerivedPointerTable::clear());
   if (ClassUnloading) {
     nmethod::oops_do_marking_prologue();
   } else {
@@ -207,8 +207,6 @@ ZRootsIterator::~ZRootsIterator() {
   } else {
     ZNMethod::oops_do_end();
   }
-
-  COMPILER2_OR_JVMCI_PRESENT(DerivedPointerTable::update_pointers());
 }
 
 void ZRootsIterator::do_object_synchronizer(ZRootsIteratorClosure* cl) {
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "compiler/oopMap.hpp"
+#include "gc/shared/barrierSet.hpp"
+#include "gc/shared/barrierSetNMethod.hpp"
+#include "gc/z/zGlobals.hpp"
+#include "gc/z/zOopClosures.inline.hpp"
+#include "gc/z/zStackWatermark.hpp"
+#include "runtime/frame.inline.hpp"
+#include "utilities/debug.hpp"
+
+ZOnStackCodeBlobClosure::ZOnStackCodeBlobClosure() :
+    _bs_nm(BarrierSet::barrier_set()->barrier_set_nmethod()) {}
+
+void ZOnStackCodeBlobClosure::do_code_blob(CodeBlob* cb) {
+  nmethod* const nm = cb->as_nmethod_or_null();
+  if (nm != NULL) {
+    const bool result = _bs_nm->nmethod_entry_barrier(nm);
+    assert(result, "NMethod on-stack must be alive");
+  }
+}
+
+static uint32_t z_epoch_id() {
+  // The mark and relocate phases of a GC cycle flip the roots in
+  // separate pauses, so each of them starts a new epoch.
+  return (ZGlobalSeqNum << 1) | (ZGlobalPhase == ZPhaseRelocate ? 1 : 0);
+}
+
+ZStackWatermark::ZStackWatermark(JavaThread* jt) :
+    StackWatermark(jt, StackWatermarkKind::gc, z_epoch_id()),
+    _jt_cl(),
+    _cb_cl() {}
+
+OopClosure* ZStackWatermark::closure_from_context(void* context) {
+  if (context != NULL) {
+    // Processing by a GC worker, using the closure of the current phase
+    return reinterpret_cast<OopClosure*>(context);
+  } else {
+    // Processing by the thread itself or by a stack walker
+    return &_jt_cl;
+  }
+}
+
+uint32_t ZStackWatermark::epoch_id() const {
+  return z_epoch_id();
+}
+
+void ZStackWatermark::process(frame& fr, RegisterMap& register_map, void* context) {
+  // Derived pointers are fixed directly, since the frames are processed
+  // outside of the pause where the derived pointer table is used.
+  fr.oops_do(closure_from_context(context),
+             ClassUnloading ? &_cb_cl : NULL,
+             &register_map,
+             DerivedPointerIterationMode::_directly);
+}
@@ -1091,38 +1091,59 @@ void ZStatLoad::print() {
 //
 // Stat mark
 //
+Ticks  ZStatMark::_start;
+Ticks  ZStatMark::_end;
 size_t ZStatMark::_nstripes;
 size_t ZStatMark::_nproactiveflush;
 size_t ZStatMark::_nterminateflush;
+size_t ZStatMark::_nlocalsteal;
+size_t ZStatMark::_nremotesteal;
 size_t ZStatMark::_ntrycomplete;
 size_t ZStatMark::_ncontinue;
 
 void ZStatMark::set_at_mark_start(size_t nstripes) {
+  _start = Ticks::now();
   _nstripes = nstripes;
 }
 
 void ZStatMark::set_at_mark_end(size_t nproactiveflush,
                                 size_t nterminateflush,
+                                size_t nlocalsteal,
+                                size_t nremotesteal,
                                 size_t ntrycomplete,
                                 size_t ncontinue) {
+  _end = Ticks::now();
   _nproactiveflush = nproactiveflush;
   _nterminateflush = nterminateflush;
+  _nlocalsteal = nlocalsteal;
+  _nremotesteal = nremotesteal;
   _ntrycomplete = ntrycomplete;
   _ncontinue = ncontinue;
 }
 
 void ZStatMark::print() {
+  // The marking rate is the live bytes found by marking over the
+  // time from mark start to mark end.
+  const double duration = (_end - _start).seconds();
+  const double rate = duration > 0.0 ? (double)ZStatHeap::live_at_mark_end() / M / duration : 0.0;
+
   log_info(gc, marking)("Mark: "
                         SIZE_FORMAT " stripe(s), "
                         SIZE_FORMAT " proactive flush(es), "
                         SIZE_FORMAT " terminate flush(es), "
+                        SIZE_FORMAT " local steal(s), "
+                        SIZE_FORMAT " remote steal(s), "
                         SIZE_FORMAT " completion(s), "
-                        SIZE_FORMAT " continuation(s) ",
+                        SIZE_FORMAT " continuation(s), "
+                        "%.1fMB/s mark rate ",
                         _nstripes,
                         _nproactiveflush,
                         _nterminateflush,
+                        _nlocalsteal,
+                        _nremotesteal,
                         _ntrycomplete,
-                        _ncontinue);
+                        _ncontinue,
+                        rate);
 }
 
 //
@@ -1142,11 +1163,12 @@ void ZStatRelocation::set_at_relocate_end(bool success) {
 void ZStatRelocation::print(const char* name, const ZRelocationSetSelectorGroupStats& group) {
   const size_t total = _stats.small().total() + _stats.medium().total() + _stats.large().total();
 
-  log_info(gc, reloc)("%s Pages: " SIZE_FORMAT " / " ZSIZE_FMT ", Empty: " ZSIZE_FMT ", Compacting: " ZSIZE_FMT "->" ZSIZE_FMT,
+  log_info(gc, reloc)("%s Pages: " SIZE_FORMAT " / " ZSIZE_FMT ", Empty: " ZSIZE_FMT ", Fragmented: " ZSIZE_FMT ", Compacting: " ZSIZE_FMT "->" ZSIZE_FMT,
                       name,
                       group.npages(),
                       ZSIZE_ARGS_WITH_MAX(group.total(), total),
                       ZSIZE_ARGS_WITH_MAX(group.empty(), total),
+                      ZSIZE_ARGS_WITH_MAX(group.fragmentation(), total),
                       ZSIZE_ARGS_WITH_MAX(group.compacting_from(), total),
                       ZSIZE_ARGS_WITH_MAX(group.compacting_to(), total));
 }
@@ -1346,6 +1368,10 @@ size_t ZStatHeap::used_at_mark_start() {
   return _at_mark_start.used;
 }
 
+size_t ZStatHeap::live_at_mark_end() {
+  return _at_mark_end.live;
+}
+
 size_t ZStatHeap::used_at_relocate_end() {
   return _at_relocate_end.used;
 }
@@ -399,9 +399,13 @@ public:
 //
 class ZStatMark : public AllStatic {
 private:
+  static Ticks  _start;
+  static Ticks  _end;
   static size_t _nstripes;
   static size_t _nproactiveflush;
   static size_t _nterminateflush;
+  static size_t _nlocalsteal;
+  static size_t _nremotesteal;
   static size_t _ntrycomplete;
   static size_t _ncontinue;
 
@@ -409,6 +413,8 @@ public:
   static void set_at_mark_start(size_t nstripes);
   static void set_at_mark_end(size_t nproactiveflush,
                               size_t nterminateflush,
+                              size_t nlocalsteal,
+                              size_t nremotesteal,
                               size_t ntrycomplete,
                               size_t ncontinue);
 
@@ -558,6 +564,7 @@ public:
 
   static size_t max_capacity();
   static size_t used_at_mark_start();
+  static size_t live_at_mark_end();
   static size_t used_at_relocate_end();
 
   static void print();
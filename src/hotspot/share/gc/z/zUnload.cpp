@@ -35,6 +35,7 @@
 #include "gc/z/zStat.hpp"
 #include "gc/z/zUnload.hpp"
 #include "oops/access.inline.hpp"
+#include "runtime/sweeper.hpp"
 
 static const ZStatSubPhase ZSubPhaseConcurrentClassesUnlink("Concurrent Classes Unlink");
 static const ZStatSubPhase ZSubPhaseConcurrentClassesPurge("Concurrent Classes Purge");
@@ -159,6 +160,7 @@ void ZUnload::purge() {
 
   ClassLoaderDataGraph::purge(/*at_safepoint*/false);
   CodeCache::purge_exception_caches();
+  NMethodSweeper::report_unloading_cycle();
 }
 
 void ZUnload::finish() {
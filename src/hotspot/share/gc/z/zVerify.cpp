@@ -33,6 +33,8 @@
 #include "gc/z/zVerify.hpp"
 #include "memory/iterator.inline.hpp"
 #include "oops/oop.hpp"
+#include "runtime/stackWatermark.hpp"
+#include "runtime/stackWatermarkSet.hpp"
 
 #define BAD_OOP_ARG(o, p)   "Bad oop " PTR_FORMAT " found at " PTR_FORMAT, p2i(o), p2i(p)
 
@@ -54,8 +56,42 @@ static void z_verify_possibly_weak_oop(oop* p) {
   }
 }
 
+static void z_verify_stale_oop(oop* p) {
+  const oop o = RawAccess<>::oop_load(p);
+  if (o != NULL) {
+    // Frames not yet processed in the current epoch can legitimately
+    // contain pointers with a stale color, but they must still refer
+    // to valid objects.
+    const uintptr_t addr = ZOop::to_address(o);
+    guarantee(oopDesc::is_oop(ZOop::from_address(ZAddress::good(addr))), BAD_OOP_ARG(o, p));
+  }
+}
+
+class ZVerifyStaleOopClosure : public OopClosure {
+public:
+  virtual void do_oop(oop* p) {
+    z_verify_stale_oop(p);
+  }
+
+  virtual void do_oop(narrowOop*) {
+    ShouldNotReachHere();
+  }
+};
+
 class ZVerifyRootClosure : public ZRootsIteratorClosure {
 public:
+  virtual void do_thread(Thread* thread) {
+    if (thread->is_Java_thread()) {
+      const StackWatermark* const watermark = StackWatermarkSet::get(thread->as_Java_thread(), StackWatermarkKind::gc);
+      if (watermark != NULL && !watermark->processing_completed()) {
+        ZVerifyStaleOopClosure cl;
+        thread->oops_do_frames(&cl, NULL /* cf */);
+        return;
+      }
+    }
+    thread->oops_do_frames(this, NULL /* cf */);
+  }
+
   virtual void do_oop(oop* p) {
     z_verify_oop(p);
   }
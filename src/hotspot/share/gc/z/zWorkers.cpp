@@ -109,6 +109,11 @@ void ZWorkers::run_concurrent(ZTask* task) {
   run(task, nconcurrent());
 }
 
+void ZWorkers::run_concurrent(ZTask* task, uint nworkers) {
+  assert(nworkers > 0 && nworkers <= nconcurrent(), "Invalid number of workers");
+  run(task, nworkers);
+}
+
 void ZWorkers::threads_do(ThreadClosure* tc) const {
   _workers.threads_do(tc);
 }
@@ -50,6 +50,7 @@ public:
 
   void run_parallel(ZTask* task);
   void run_concurrent(ZTask* task);
+  void run_concurrent(ZTask* task, uint nworkers);
 
   void threads_do(ThreadClosure* tc) const;
 };
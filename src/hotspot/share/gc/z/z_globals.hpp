@@ -42,6 +42,11 @@
           "Maximum number of bytes allocated for mark stacks")              \
           range(32*M, 1024*G)                                               \
                                                                             \
+  product(uint, ZMarkPrefetchWindow, 8, EXPERIMENTAL,                       \
+          "The number of entries marking pops from its mark stacks and "    \
+          "prefetches ahead of marking them (0 means off)")                 \
+          range(0, 64)                                                      \
+                                                                            \
   product(uint, ZCollectionInterval, 0,                                     \
           "Force GC at a fixed time interval (in seconds)")                 \
                                                                             \
@@ -206,6 +206,12 @@ JVM_IsCDSSharingEnabled(JNIEnv* env);
 JNIEXPORT jlong JNICALL
 JVM_GetRandomSeedForCDSDump();
 
+JNIEXPORT jboolean JNICALL
+JVM_IsDumpingClassList(JNIEnv* env);
+
+JNIEXPORT void JNICALL
+JVM_LogLambdaFormInvoker(JNIEnv* env, jstring line);
+
 /*
  * java.lang.Throwable
  */
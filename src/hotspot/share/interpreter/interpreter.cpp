@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "asm/macroAssembler.hpp"
 #include "asm/macroAssembler.inline.hpp"
+#include "code/perfMap.hpp"
 #include "compiler/disassembler.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
 #include "interpreter/interpreter.hpp"
@@ -138,6 +139,7 @@ void interpreter_init_code() {
     AbstractInterpreter::code()->code_start(),
     AbstractInterpreter::code()->code_end()
   );
+  LINUX_ONLY(PerfMap::register_interpreter(AbstractInterpreter::code());)
 
   // notify JVMTI profiler
   if (JvmtiExport::should_post_dynamic_code_generated()) {
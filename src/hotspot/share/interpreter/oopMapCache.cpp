@@ -486,12 +486,15 @@ void OopMapCache::flush_obsolete_entries() {
   }
 }
 
-// Called by GC for thread root scan during a safepoint only.  The other interpreted frame oopmaps
-// are generated locally and not cached.
+// Called by GC for thread root scan during a safepoint, and by Java threads walking
+// interpreted frames. Java threads never run during the safepoints that replace and
+// free entries, so they only add entries to empty slots and leave replacement to GC.
+// Oop maps computed outside a GC thus save work for the next GC's stack scan.
 void OopMapCache::lookup(const methodHandle& method,
                          int bci,
                          InterpreterOopMap* entry_for) {
-  assert(SafepointSynchronize::is_at_safepoint(), "called by GC in a safepoint");
+  assert(SafepointSynchronize::is_at_safepoint() || Thread::current()->is_Java_thread(),
+         "called by GC in a safepoint or by a Java thread");
   int probe = hash_value_for(method, bci);
   int i;
   OopMapCacheEntry* entry = NULL;
@@ -528,6 +531,7 @@ void OopMapCache::lookup(const methodHandle& method,
     // at this time. We give the caller of lookup() a copy of the
     // interesting info via parameter entry_for, but we don't add it to
     // the cache. See the gory details in Method*.cpp.
+    tmp->flush();
     FREE_C_HEAP_OBJ(tmp);
     return;
   }
@@ -543,6 +547,13 @@ void OopMapCache::lookup(const methodHandle& method,
     }
   }
 
+  if (!SafepointSynchronize::is_at_safepoint()) {
+    // Replaced entries can only be freed after GC, when nothing is reading them.
+    tmp->flush();
+    FREE_C_HEAP_OBJ(tmp);
+    return;
+  }
+
   log_debug(interpreter, oopmap)("*** collision in oopmap cache - flushing item ***");
 
   // No empty slot (uncommon case). Use (some approximation of a) LRU algorithm
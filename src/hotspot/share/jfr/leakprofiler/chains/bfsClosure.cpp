@@ -118,7 +118,7 @@ void BFSClosure::closure_impl(UnifiedOopRef reference, const oop pointee) {
   assert(!reference.is_null(), "invariant");
   assert(reference.dereference() == pointee, "invariant");
 
-  if (GranularTimer::is_finished()) {
+  if (GranularTimer::is_finished() || _edge_store->all_leak_candidates_found()) {
      return;
   }
 
@@ -133,6 +133,7 @@ void BFSClosure::closure_impl(UnifiedOopRef reference, const oop pointee) {
     // is the pointee a sample object?
     if (pointee->mark().is_marked()) {
       add_chain(reference, pointee);
+      _edge_store->leak_candidate_found();
     }
 
     // if we are processinig initial root set, don't add to queue
@@ -172,6 +173,10 @@ void BFSClosure::process_queue() {
 
   _next_frontier_idx = _edge_queue->top();
   while (!is_complete()) {
+    if (_edge_store->all_leak_candidates_found()) {
+      log_trace(jfr, system)("BFS front: " SIZE_FORMAT " reached all leak candidates", _current_frontier_level);
+      return;
+    }
     iterate(_edge_queue->remove()); // edge_queue.remove() increments bottom
   }
 }
@@ -77,7 +77,7 @@ void DFSClosure::closure_impl(UnifiedOopRef reference, const oop pointee) {
   assert(pointee != NULL, "invariant");
   assert(!reference.is_null(), "invariant");
 
-  if (GranularTimer::is_finished()) {
+  if (GranularTimer::is_finished() || _edge_store->all_leak_candidates_found()) {
     return;
   }
   if (_depth == 0 && _ignore_root_set) {
@@ -96,6 +96,10 @@ void DFSClosure::closure_impl(UnifiedOopRef reference, const oop pointee) {
   // is the pointee a sample object?
   if (pointee->mark().is_marked()) {
     add_chain();
+    if (!(_depth == 0 && _ignore_root_set)) {
+      // not already found while marking the root set
+      _edge_store->leak_candidate_found();
+    }
   }
 
   assert(_max_depth >= 1, "invariant");
@@ -36,7 +36,7 @@ StoredEdge::StoredEdge(const StoredEdge& edge) : Edge(edge), _gc_root_id(edge._g
 
 traceid EdgeStore::_edge_id_counter = 0;
 
-EdgeStore::EdgeStore() : _edges(NULL) {
+EdgeStore::EdgeStore() : _edges(NULL), _leak_candidates_left(max_uintx) {
   _edges = new EdgeHashTable(this);
 }
 
@@ -72,6 +72,7 @@ class EdgeStore : public CHeapObj<mtTracing> {
  private:
   static traceid _edge_id_counter;
   EdgeHashTable* _edges;
+  size_t _leak_candidates_left;
 
   // Hash table callbacks
   void on_link(EdgeEntry* entry);
@@ -103,6 +104,15 @@ class EdgeStore : public CHeapObj<mtTracing> {
   bool is_empty() const;
   traceid get_id(const Edge* edge) const;
   void put_chain(const Edge* chain, size_t length);
+
+  // The path to gc roots search can stop once every marked
+  // leak candidate has been reached.
+  void set_leak_candidates(size_t count) { _leak_candidates_left = count; }
+  void leak_candidate_found() {
+    assert(_leak_candidates_left > 0, "invariant");
+    --_leak_candidates_left;
+  }
+  bool all_leak_candidates_found() const { return _leak_candidates_left == 0; }
 };
 
 #endif // SHARE_JFR_LEAKPROFILER_CHAINS_EDGESTORE_HPP
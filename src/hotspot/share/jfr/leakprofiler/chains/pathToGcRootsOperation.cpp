@@ -100,10 +100,14 @@ void PathToGcRootsOperation::doit() {
   // Save the original markWord for the potential leak objects,
   // to be restored on function exit
   ObjectSampleMarker marker;
-  if (ObjectSampleCheckpoint::save_mark_words(_sampler, marker, _emit_all) == 0) {
+  const int leak_candidates = ObjectSampleCheckpoint::save_mark_words(_sampler, marker, _emit_all);
+  if (leak_candidates == 0) {
     // no valid samples to process
     return;
   }
+  // Stop the search as soon as all marked samples have been reached,
+  // rather than traversing the rest of the heap.
+  _edge_store->set_leak_candidates((size_t)leak_candidates);
 
   // Necessary condition for attempting a root set iteration
   Universe::heap()->ensure_parsability(false);
@@ -65,6 +65,10 @@
 #include "services/threadService.hpp"
 #include "utilities/exceptions.hpp"
 #include "utilities/globalDefinitions.hpp"
+#ifdef COMPILER2
+#include "opto/runtime.hpp"
+#include "runtime/rtmLocking.hpp"
+#endif
 #if INCLUDE_G1GC
 #include "gc/g1/g1HeapRegionEventSender.hpp"
 #endif
@@ -577,6 +581,33 @@ TRACE_REQUEST_FUNC(CompilerStatistics) {
   event.commit();
 }
 
+TRACE_REQUEST_FUNC(RTMLockingStatistics) {
+#if defined(COMPILER2) && INCLUDE_RTM_OPT
+  if (!UseRTMLocking) {
+    return;
+  }
+  // Named counters are only ever prepended, so the list can be walked
+  // while compiler threads keep adding to it.
+  for (NamedCounter* c = OptoRuntime::named_counters(); c != NULL; c = c->next()) {
+    if (c->tag() != NamedCounter::RTMLockingCounter) {
+      continue;
+    }
+    RTMLockingCounters* rlc = ((RTMLockingNamedCounter*)c)->counters();
+    if (!rlc->nonzero()) {
+      continue;
+    }
+    EventRTMLockingStatistics event;
+    event.set_lockSite(c->name());
+    event.set_totalCount(rlc->total_count() * RTMTotalCountIncrRate);
+    event.set_abortCount(rlc->abort_count());
+    event.set_retryAbortCount(rlc->abortX_count(1));
+    event.set_conflictAbortCount(rlc->abortX_count(2));
+    event.set_capacityAbortCount(rlc->abortX_count(3));
+    event.commit();
+  }
+#endif
+}
+
 TRACE_REQUEST_FUNC(CompilerConfiguration) {
   EventCompilerConfiguration event;
   event.set_threadCount(CICompilerCount);
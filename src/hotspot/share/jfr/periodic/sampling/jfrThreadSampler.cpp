@@ -35,6 +35,7 @@
 #include "logging/log.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/semaphore.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
@@ -101,15 +102,19 @@ class JfrThreadSampleClosure {
   bool do_sample_thread(JavaThread* thread, JfrStackFrame* frames, u4 max_frames, JfrSampleType type);
   uint java_entries() { return _added_java; }
   uint native_entries() { return _added_native; }
+  uint requested_entries() { return _requested_java; }
+  static void process_sample_request(JavaThread* thread);
 
  private:
   bool sample_thread_in_java(JavaThread* thread, JfrStackFrame* frames, u4 max_frames);
   bool sample_thread_in_native(JavaThread* thread, JfrStackFrame* frames, u4 max_frames);
+  bool request_sample(JavaThread* thread);
   EventExecutionSample* _events;
   EventNativeMethodSample* _events_native;
   Thread* _self;
   uint _added_java;
   uint _added_native;
+  uint _requested_java;
 };
 
 class OSThreadSampler : public os::SuspendedThreadTask {
@@ -286,6 +291,23 @@ bool JfrThreadSampleClosure::sample_thread_in_native(JavaThread* thread, JfrStac
   return true;
 }
 
+/*
+ * Instead of suspending the thread, ask it to record its own stack trace
+ * the next time it polls for a safepoint or handshake. The request time
+ * becomes the sample time, so the event reflects when the thread was seen
+ * running Java code, but the stack trace is taken at the poll.
+ */
+bool JfrThreadSampleClosure::request_sample(JavaThread* thread) {
+  if (!thread->jfr_thread_local()->set_sample_request(JfrTicks::now())) {
+    // The previous request has not been processed yet.
+    return false;
+  }
+  // Release semantics so the request is seen before the armed poll.
+  SafepointMechanism::arm_local_poll_release(thread);
+  _requested_java++;
+  return true;
+}
+
 static const uint MAX_NR_OF_JAVA_SAMPLES = 5;
 static const uint MAX_NR_OF_NATIVE_SAMPLES = 1;
 
@@ -309,7 +331,8 @@ JfrThreadSampleClosure::JfrThreadSampleClosure(EventExecutionSample* events, Eve
   _events_native(events_native),
   _self(Thread::current()),
   _added_java(0),
-  _added_native(0) {
+  _added_native(0),
+  _requested_java(0) {
 }
 
 class JfrThreadSampler : public NonJavaThread {
@@ -368,6 +391,11 @@ bool JfrThreadSampleClosure::do_sample_thread(JavaThread* thread, JfrStackFrame*
     return false;
   }
 
+  if (JAVA_SAMPLE == type && JfrOptionSet::async_sampling()) {
+    // The thread is not suspended so there is no transition to block.
+    return thread_state_in_java(thread) && request_sample(thread);
+  }
+
   bool ret = false;
   thread->set_trace_flag();  // Provides StoreLoad, needed to keep read of thread state from floating up.
   if (JAVA_SAMPLE == type) {
@@ -384,6 +412,42 @@ bool JfrThreadSampleClosure::do_sample_thread(JavaThread* thread, JfrStackFrame*
   return ret;
 }
 
+/*
+ * Executed by the sampled thread itself at a safepoint poll or handshake.
+ * The stack is walkable and owned by the current thread, so the walk needs
+ * neither suspension nor crash protection, and the stack trace can be added
+ * to the repository directly.
+ */
+void JfrThreadSampleClosure::process_sample_request(JavaThread* thread) {
+  assert(thread == Thread::current(), "invariant");
+  JfrThreadLocal* const tl = thread->jfr_thread_local();
+  JfrTicks request_time;
+  if (!tl->clear_sample_request(&request_time)) {
+    return;
+  }
+  if (!thread->has_last_Java_frame() || is_excluded(thread)) {
+    return;
+  }
+  JfrStackFrame* const frames = tl->stackframes();
+  if (frames == NULL) {
+    // pending oom
+    return;
+  }
+  JfrStackTrace stacktrace(frames, tl->stackdepth());
+  if (!stacktrace.record_safe(thread, 0)) {
+    return;
+  }
+  const traceid id = JfrStackTraceRepository::add(stacktrace);
+  assert(id != 0, "Stacktrace id should not be 0");
+  EventExecutionSample event(UNTIMED);
+  event.set_starttime(request_time);
+  event.set_endtime(request_time); // fake to not take an end time
+  event.set_sampledThread(JFR_THREAD_ID(thread));
+  event.set_state(java_lang_Thread::get_thread_status(thread->threadObj()));
+  event.set_stackTrace(id);
+  event.commit();
+}
+
 JfrThreadSampler::JfrThreadSampler(size_t interval_java, size_t interval_native, u4 max_frames) :
   _sample(),
   _sampler_thread(NULL),
@@ -551,10 +615,12 @@ void JfrThreadSampler::task_stacktrace(JfrSampleType type, JavaThread** last_thr
       *last_thread = current;  // remember the thread we last attempted to sample
     }
     sample_time.stop();
-    log_trace(jfr)("JFR thread sampling done in %3.7f secs with %d java %d native samples",
-                   sample_time.seconds(), sample_task.java_entries(), sample_task.native_entries());
+    log_trace(jfr)("JFR thread sampling done in %3.7f secs with %d java %d native samples %d requests",
+                   sample_time.seconds(), sample_task.java_entries(), sample_task.native_entries(),
+                   sample_task.requested_entries());
   }
-  if (num_samples > 0) {
+  // Requested samples are committed by the sampled threads themselves.
+  if (num_samples > sample_task.requested_entries()) {
     sample_task.commit_events(type);
   }
 }
@@ -643,3 +709,7 @@ void JfrThreadSampling::set_native_sample_interval(size_t period) {
 void JfrThreadSampling::on_javathread_suspend(JavaThread* thread) {
   JfrThreadSampler::on_javathread_suspend(thread);
 }
+
+void JfrThreadSampling::on_sample_request(JavaThread* thread) {
+  JfrThreadSampleClosure::process_sample_request(thread);
+}
@@ -126,6 +126,14 @@ void JfrOptionSet::set_sample_threads(jboolean sample) {
   _sample_threads = sample;
 }
 
+bool JfrOptionSet::async_sampling() {
+  return _async_sampling == JNI_TRUE;
+}
+
+void JfrOptionSet::set_async_sampling(jboolean value) {
+  _async_sampling = value;
+}
+
 bool JfrOptionSet::can_retransform() {
   return _retransform == JNI_TRUE;
 }
@@ -169,6 +177,7 @@ const char* const default_memory_size = "10m";
 const char* const default_thread_buffer_size = "8k";
 const char* const default_max_chunk_size = "12m";
 const char* const default_sample_threads = "true";
+const char* const default_async_sampling = "false";
 const char* const default_stack_depth = "64";
 const char* const default_retransform = "true";
 const char* const default_old_object_queue_size = "256";
@@ -231,6 +240,13 @@ static DCmdArgument<bool> _dcmd_sample_threads(
   false,
   default_sample_threads);
 
+static DCmdArgument<bool> _dcmd_async_sampling(
+  "asyncsampling",
+  "Sampled threads record their own stack trace at the next safepoint poll instead of being suspended (false by default)",
+  "BOOLEAN",
+  false,
+  default_async_sampling);
+
 #ifdef ASSERT
 static DCmdArgument<bool> _dcmd_sample_protection(
   "sampleprotection",
@@ -265,6 +281,7 @@ static void register_parser_options() {
   _parser.add_dcmd_option(&_dcmd_maxchunksize);
   _parser.add_dcmd_option(&_dcmd_stackdepth);
   _parser.add_dcmd_option(&_dcmd_sample_threads);
+  _parser.add_dcmd_option(&_dcmd_async_sampling);
   _parser.add_dcmd_option(&_dcmd_retransform);
   _parser.add_dcmd_option(&_dcmd_old_object_queue_size);
   DEBUG_ONLY(_parser.add_dcmd_option(&_dcmd_sample_protection);)
@@ -307,6 +324,7 @@ jlong JfrOptionSet::_num_global_buffers = 0;
 jlong JfrOptionSet::_old_object_queue_size = 0;
 u4 JfrOptionSet::_stack_depth = STACK_DEPTH_DEFAULT;
 jboolean JfrOptionSet::_sample_threads = JNI_TRUE;
+jboolean JfrOptionSet::_async_sampling = JNI_FALSE;
 jboolean JfrOptionSet::_retransform = JNI_TRUE;
 #ifdef ASSERT
 jboolean JfrOptionSet::_sample_protection = JNI_FALSE;
@@ -322,6 +340,9 @@ bool JfrOptionSet::initialize(Thread* thread) {
   if (_dcmd_retransform.is_set()) {
     set_retransform(_dcmd_retransform.value());
   }
+  if (_dcmd_async_sampling.is_set()) {
+    set_async_sampling(_dcmd_async_sampling.value());
+  }
   set_old_object_queue_size(_dcmd_old_object_queue_size.value());
   return adjust_memory_options();
 }
@@ -46,6 +46,7 @@ class JfrOptionSet : public AllStatic {
   static jlong _old_object_queue_size;
   static u4 _stack_depth;
   static jboolean _sample_threads;
+  static jboolean _async_sampling;
   static jboolean _retransform;
   static jboolean _sample_protection;
 
@@ -70,6 +71,8 @@ class JfrOptionSet : public AllStatic {
   static void set_stackdepth(u4 depth);
   static bool sample_threads();
   static void set_sample_threads(jboolean sample);
+  static bool async_sampling();
+  static void set_async_sampling(jboolean value);
   static bool can_retransform();
   static void set_retransform(jboolean value);
   static bool compressed_integers();
@@ -79,6 +79,18 @@ JfrStackTrace::~JfrStackTrace() {
   }
 }
 
+// Overwrite this trace with trace, reusing the frame array.
+void JfrStackTrace::copy(traceid id, const JfrStackTrace& trace) {
+  assert(_frames_ownership, "invariant");
+  assert(trace._nr_of_frames <= _max_frames, "invariant");
+  _id = id;
+  _hash = trace._hash;
+  _nr_of_frames = trace._nr_of_frames;
+  _reached_root = trace._reached_root;
+  _lineno = trace._lineno;
+  memcpy(_frames, trace._frames, trace._nr_of_frames * sizeof(JfrStackFrame));
+}
+
 template <typename Writer>
 static void write_stacktrace(Writer& w, traceid id, bool reached_root, u4 nr_of_frames, const JfrStackFrame* frames) {
   w.write((u8)id);
@@ -134,7 +146,7 @@ void JfrStackFrame::write(JfrCheckpointWriter& cpw) const {
 class vframeStreamSamples : public vframeStreamCommon {
  public:
   // constructor that starts with sender of frame fr (top_frame)
-  vframeStreamSamples(JavaThread *jt, frame fr, bool stop_at_java_call_stub) : vframeStreamCommon(jt) {
+  vframeStreamSamples(JavaThread *jt, frame fr, bool stop_at_java_call_stub) : vframeStreamCommon(jt, false /* process_frames */) {
     _stop_at_java_call_stub = stop_at_java_call_stub;
     _frame = fr;
 
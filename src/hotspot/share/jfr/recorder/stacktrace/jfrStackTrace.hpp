@@ -64,6 +64,8 @@ class JfrStackFrame {
 class JfrStackTrace : public JfrCHeapObj {
   friend class JfrNativeSamplerCallback;
   friend class JfrStackTraceRepository;
+  friend class JfrThreadLocal;
+  friend class JfrThreadSampleClosure;
   friend class ObjectSampleCheckpoint;
   friend class ObjectSampler;
   friend class OSThreadSampler;
@@ -92,6 +94,7 @@ class JfrStackTrace : public JfrCHeapObj {
   void set_hash(unsigned int hash) { _hash = hash; }
   void set_reached_root(bool reached_root) { _reached_root = reached_root; }
   void resolve_linenos() const;
+  void copy(traceid id, const JfrStackTrace& trace);
 
   bool record_thread(JavaThread& thread, frame& frame);
   bool record_safe(JavaThread* thread, int skip);
@@ -32,7 +32,7 @@
 
 static JfrStackTraceRepository* _instance = NULL;
 
-JfrStackTraceRepository::JfrStackTraceRepository() : _next_id(0), _entries(0) {
+JfrStackTraceRepository::JfrStackTraceRepository() : _next_id(0), _last_cleared_id(0), _entries(0) {
   memset(_table, 0, sizeof(_table));
 }
 
@@ -101,6 +101,7 @@ size_t JfrStackTraceRepository::write(JfrChunkWriter& sw, bool clear) {
   if (clear) {
     memset(_table, 0, sizeof(_table));
     _entries = 0;
+    _last_cleared_id = _next_id;
   }
   last_id = _next_id;
   return count;
@@ -122,6 +123,7 @@ size_t JfrStackTraceRepository::clear() {
   memset(_table, 0, sizeof(_table));
   const size_t processed = _entries;
   _entries = 0;
+  _last_cleared_id = _next_id;
   return processed;
 }
 
@@ -145,9 +147,29 @@ traceid JfrStackTraceRepository::record(Thread* thread, int skip /* 0 */) {
   return instance().record_for(thread->as_Java_thread(), skip, frames, tl->stackdepth());
 }
 
+// A thread often records the same stack trace many times in a row, e.g. when
+// allocating in a loop. Each thread remembers the last trace it added, so a
+// repeated trace is resolved without taking JfrStacktrace_lock. The table is
+// only cleared at a safepoint, so the remembered id stays valid while the
+// caller is in the VM.
 traceid JfrStackTraceRepository::record_for(JavaThread* thread, int skip, JfrStackFrame *frames, u4 max_frames) {
   JfrStackTrace stacktrace(frames, max_frames);
-  return stacktrace.record_safe(thread, skip) ? add(stacktrace) : 0;
+  if (!stacktrace.record_safe(thread, skip)) {
+    return 0;
+  }
+  JfrThreadLocal* const tl = thread->jfr_thread_local();
+  JfrStackTrace* last = tl->last_stack_trace();
+  if (last != NULL && last->id() > _last_cleared_id && last->equals(stacktrace)) {
+    return last->id();
+  }
+  const traceid id = add(stacktrace);
+  if (last == NULL) {
+    last = new JfrStackTrace(NEW_C_HEAP_ARRAY(JfrStackFrame, max_frames, mtTracing), max_frames);
+    last->_frames_ownership = true;
+    tl->set_last_stack_trace(last);
+  }
+  last->copy(id, stacktrace);
+  return id;
 }
 
 traceid JfrStackTraceRepository::add(const JfrStackTrace& stacktrace) {
@@ -46,6 +46,7 @@ class JfrStackTraceRepository : public JfrCHeapObj {
   static const u4 TABLE_SIZE = 2053;
   JfrStackTrace* _table[TABLE_SIZE];
   traceid _next_id;
+  traceid _last_cleared_id; // ids up to this one are no longer in the table
   u4 _entries;
 
   JfrStackTraceRepository();
@@ -26,6 +26,7 @@
 #define SHARE_JFR_RECORDER_STORAGE_JFRMEMORYSPACERETRIEVAL_HPP
 
 #include "jfr/utilities/jfrIterator.hpp"
+#include "runtime/os.hpp"
 
 /* Some policy classes for getting mspace memory. */
 
@@ -38,23 +39,60 @@ class JfrMspaceRetrieval {
       StopOnNullCondition<typename Mspace::FreeList> iterator(mspace->free_list());
       return acquire(mspace, iterator, thread, size);
     }
-    StopOnNullCondition<typename Mspace::LiveList> iterator(mspace->live_list(previous_epoch));
-    return acquire(mspace, iterator, thread, size);
+    return acquire_live(mspace, thread, size, previous_epoch);
   }
  private:
+  // Threads on different cpus start scanning the live list at different nodes,
+  // so that concurrent promotions are not all racing to acquire the same few
+  // buffers at the head of the list. The scan wraps around to cover every node.
+  static const uint live_list_spread = 32;
+
+  static Node* acquire_live(Mspace* mspace, Thread* thread, size_t size, bool previous_epoch) {
+    typename Mspace::LiveList& list = mspace->live_list(previous_epoch);
+    Node* const head = list.head();
+    Node* start = head;
+    for (uint skip = os::processor_id() % live_list_spread; skip > 0 && start != NULL; --skip) {
+      start = (Node*)start->_next;
+      if (start == NULL) {
+        start = list.head();
+      }
+    }
+    if (start == NULL) {
+      return NULL;
+    }
+    for (Node* node = start; node != NULL; node = (Node*)node->_next) {
+      if (try_acquire(mspace, node, thread, size)) {
+        return node;
+      }
+    }
+    for (Node* node = head; node != NULL && node != start; node = (Node*)node->_next) {
+      if (try_acquire(mspace, node, thread, size)) {
+        return node;
+      }
+    }
+    return NULL;
+  }
+
+  static bool try_acquire(Mspace* mspace, Node* node, Thread* thread, size_t size) {
+    if (node->retired()) return false;
+    if (node->try_acquire(thread)) {
+      assert(!node->retired(), "invariant");
+      if (node->free_size() >= size) {
+        return true;
+      }
+      node->set_retired();
+      mspace->register_full(node, thread);
+    }
+    return false;
+  }
+
   template <typename Iterator>
   static Node* acquire(Mspace* mspace, Iterator& iterator, Thread* thread, size_t size) {
     assert(mspace != NULL, "invariant");
     while (iterator.has_next()) {
       Node* const node = iterator.next();
-      if (node->retired()) continue;
-      if (node->try_acquire(thread)) {
-        assert(!node->retired(), "invariant");
-        if (node->free_size() >= size) {
-          return node;
-        }
-        node->set_retired();
-        mspace->register_full(node, thread);
+      if (try_acquire(mspace, node, thread, size)) {
+        return node;
       }
     }
     return NULL;
@@ -0,0 +1,49 @@
+/*
+* Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* This code is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License version 2 only, as
+* published by the Free Software Foundation.
+*
+* This code is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+* version 2 for more details (a copy is included in the LICENSE file that
+* accompanied this code).
+*
+* You should have received a copy of the GNU General Public License version
+* 2 along with this work; if not, write to the Free Software Foundation,
+* Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+*
+* Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+* or visit www.oracle.com if you need additional information or have any
+* questions.
+*
+*/
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrNativeAllocationSampler.hpp"
+#include "jfr/support/jfrThreadLocal.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/thread.hpp"
+
+void JfrNativeAllocationSampler::sample(void* addr, size_t size, JavaThread* thread) {
+  if (addr == NULL || !EventNativeMemoryAllocationSample::is_enabled()) {
+    return;
+  }
+  JfrThreadLocal* const tl = thread->jfr_thread_local();
+  const size_t allocated = tl->add_native_allocated_bytes(size);
+  if (allocated < NativeAllocationSampleInterval) {
+    return;
+  }
+  tl->clear_native_allocated_bytes();
+  EventNativeMemoryAllocationSample event;
+  if (event.should_commit()) {
+    event.set_address((u8)(uintptr_t)addr);
+    event.set_allocationSize(size);
+    event.set_weight(allocated);
+    event.commit();
+  }
+}
@@ -48,4 +48,6 @@
 
 #define SUSPEND_THREAD_CONDITIONAL(thread) if ((thread)->is_trace_suspend()) JfrThreadSampling::on_javathread_suspend(thread)
 
+#define SAMPLE_THREAD_CONDITIONAL(thread) if ((thread)->jfr_thread_local()->has_sample_request()) JfrThreadSampling::on_sample_request(thread)
+
 #endif // SHARE_JFR_SUPPORT_JFRTHREADEXTENSION_HPP
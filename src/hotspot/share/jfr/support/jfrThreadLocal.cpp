@@ -31,9 +31,11 @@
 #include "jfr/recorder/checkpoint/types/traceid/jfrTraceIdEpoch.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
+#include "jfr/recorder/stacktrace/jfrStackTrace.hpp"
 #include "jfr/recorder/storage/jfrStorage.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 #include "utilities/sizes.hpp"
@@ -46,9 +48,11 @@ JfrThreadLocal::JfrThreadLocal() :
   _load_barrier_buffer_epoch_0(NULL),
   _load_barrier_buffer_epoch_1(NULL),
   _stackframes(NULL),
+  _last_stack_trace(NULL),
   _trace_id(JfrTraceId::assign_thread_id()),
   _thread(),
   _data_lost(0),
+  _native_allocated_bytes(0),
   _stack_trace_id(max_julong),
   _user_time(0),
   _cpu_time(0),
@@ -56,12 +60,35 @@ JfrThreadLocal::JfrThreadLocal() :
   _stack_trace_hash(0),
   _stackdepth(0),
   _entering_suspend_flag(0),
+  _sample_request_time(),
+  _sample_request(false),
   _excluded(false),
   _dead(false) {
   Thread* thread = Thread::current_or_null();
   _parent_trace_id = thread != NULL ? thread->jfr_thread_local()->trace_id() : (traceid)0;
 }
 
+// Called by the sampler thread. Returns false if a previous request is still pending.
+bool JfrThreadLocal::set_sample_request(const JfrTicks& request_time) {
+  if (Atomic::load_acquire(&_sample_request)) {
+    return false;
+  }
+  _sample_request_time = request_time;
+  Atomic::release_store(&_sample_request, true);
+  return true;
+}
+
+// Called by the owning thread. Returns false if there is no pending request.
+bool JfrThreadLocal::clear_sample_request(JfrTicks* request_time) {
+  assert(request_time != NULL, "invariant");
+  if (!Atomic::load_acquire(&_sample_request)) {
+    return false;
+  }
+  *request_time = _sample_request_time;
+  Atomic::release_store(&_sample_request, false);
+  return true;
+}
+
 u8 JfrThreadLocal::add_data_lost(u8 value) {
   _data_lost += value;
   return _data_lost;
@@ -134,6 +161,10 @@ void JfrThreadLocal::release(Thread* t) {
     FREE_C_HEAP_ARRAY(JfrStackFrame, _stackframes);
     _stackframes = NULL;
   }
+  if (_last_stack_trace != NULL) {
+    delete _last_stack_trace;
+    _last_stack_trace = NULL;
+  }
   if (_load_barrier_buffer_epoch_0 != NULL) {
     _load_barrier_buffer_epoch_0->set_retired();
     _load_barrier_buffer_epoch_0 = NULL;
@@ -26,11 +26,13 @@
 #define SHARE_JFR_SUPPORT_JFRTHREADLOCAL_HPP
 
 #include "jfr/utilities/jfrBlob.hpp"
+#include "jfr/utilities/jfrTime.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
 
 class JavaThread;
 class JfrBuffer;
 class JfrStackFrame;
+class JfrStackTrace;
 class Thread;
 
 class JfrThreadLocal {
@@ -42,9 +44,11 @@ class JfrThreadLocal {
   JfrBuffer* _load_barrier_buffer_epoch_0;
   JfrBuffer* _load_barrier_buffer_epoch_1;
   mutable JfrStackFrame* _stackframes;
+  JfrStackTrace* _last_stack_trace;
   mutable traceid _trace_id;
   JfrBlobHandle _thread;
   u8 _data_lost;
+  size_t _native_allocated_bytes;
   traceid _stack_trace_id;
   jlong _user_time;
   jlong _cpu_time;
@@ -52,6 +56,8 @@ class JfrThreadLocal {
   unsigned int _stack_trace_hash;
   mutable u4 _stackdepth;
   volatile jint _entering_suspend_flag;
+  JfrTicks _sample_request_time;
+  volatile bool _sample_request;
   bool _excluded;
   bool _dead;
   traceid _parent_trace_id;
@@ -119,6 +125,24 @@ class JfrThreadLocal {
 
   u4 stackdepth() const;
 
+  JfrStackTrace* last_stack_trace() const {
+    return _last_stack_trace;
+  }
+
+  void set_last_stack_trace(JfrStackTrace* stacktrace) {
+    _last_stack_trace = stacktrace;
+  }
+
+  // Native bytes allocated since the last NativeMemoryAllocationSample
+  size_t add_native_allocated_bytes(size_t size) {
+    _native_allocated_bytes += size;
+    return _native_allocated_bytes;
+  }
+
+  void clear_native_allocated_bytes() {
+    _native_allocated_bytes = 0;
+  }
+
   void set_stackdepth(u4 depth) {
     _stackdepth = depth;
   }
@@ -169,6 +193,15 @@ class JfrThreadLocal {
     return _entering_suspend_flag != 0;
   }
 
+  // A pending request for this thread to record its own execution
+  // sample at the next safepoint poll or handshake.
+  bool has_sample_request() const {
+    return _sample_request;
+  }
+
+  bool set_sample_request(const JfrTicks& request_time);
+  bool clear_sample_request(JfrTicks* request_time);
+
   u8 data_lost() const {
     return _data_lost;
   }
@@ -1576,6 +1576,18 @@ JVMCI::CodeInstallResult JVMCIRuntime::register_method(JVMCIEnv* JVMCIENV,
     nmethod_mirror_index = -1;
   }
 
+  // Encode the dependencies now, so we can check them right away.
+  // Encoding only touches this compilation's recorder, so it is done
+  // before taking the install locks that serialize all compiler threads.
+  dependencies->encode_content_bytes();
+
+  // Record the dependencies for the current compile in the log
+  if (LogCompilation) {
+    for (Dependencies::DepStream deps(dependencies); deps.next(); ) {
+      deps.log_dependency();
+    }
+  }
+
   JVMCI::CodeInstallResult result;
   {
     // To prevent compile queue updates.
@@ -1585,16 +1597,6 @@ JVMCI::CodeInstallResult JVMCIRuntime::register_method(JVMCIEnv* JVMCIENV,
     // and invalidating our dependencies until we install this method.
     MutexLocker ml(Compile_lock);
 
-    // Encode the dependencies now, so we can check them right away.
-    dependencies->encode_content_bytes();
-
-    // Record the dependencies for the current compile in the log
-    if (LogCompilation) {
-      for (Dependencies::DepStream deps(dependencies); deps.next(); ) {
-        deps.log_dependency();
-      }
-    }
-
     // Check for {class loads, evolution, breakpoints} during compilation
     result = validate_compile_task_dependencies(dependencies, JVMCIENV->compile_state(), &failure_detail);
     if (result != JVMCI::ok) {
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logConfiguration.hpp"
+#include "logging/logFileStreamOutput.hpp"
+#include "logging/logTagSet.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.inline.hpp"
+#include "utilities/ostream.hpp"
+
+// The vwrite buffer in LogTagSet bounds the typical message size.
+static const size_t AsyncLogTypicalMessageSize = 512;
+
+class AsyncLogLocker : public StackObj {
+  os::PlatformMonitor& _lock;
+
+ public:
+  AsyncLogLocker(os::PlatformMonitor& lock) : _lock(lock) {
+    _lock.lock();
+  }
+
+  ~AsyncLogLocker() {
+    _lock.unlock();
+  }
+};
+
+void AsyncLogMessage::writeback() {
+  _output.write_blocking(_decorations, _message);
+  destroy();
+}
+
+void AsyncLogMessage::destroy() {
+  os::free(_message);
+  _message = NULL;
+}
+
+AsyncLogWriter* AsyncLogWriter::_instance = NULL;
+
+AsyncLogWriter::AsyncLogWriter()
+  : _lock(),
+    _flush_sem(0),
+    _initialized(false),
+    _should_terminate(false),
+    _terminated(false),
+    _buffer(NULL),
+    _capacity(MAX2(AsyncLogBufferSize / (sizeof(AsyncLogMessage) + AsyncLogTypicalMessageSize), (size_t)1)),
+    _head(0),
+    _count(0),
+    _data_available(false),
+    _pending_flushes(0),
+    _blocked_producers(0),
+    _stats() {
+  _buffer = NEW_C_HEAP_ARRAY_RETURN_NULL(AsyncLogMessage, _capacity, mtLogging);
+  if (_buffer != NULL && os::create_thread(this, os::asynclog_thread)) {
+    _initialized = true;
+  } else {
+    log_warning(logging, thread)("AsyncLogging failed to create thread. Falling back to synchronous logging.");
+  }
+
+  log_info(logging)("The maximum entries of AsyncLogBuffer: " SIZE_FORMAT ", estimated memory use: " SIZE_FORMAT " bytes",
+                    _capacity, AsyncLogBufferSize);
+}
+
+void AsyncLogWriter::account_dropped_locked(LogFileStreamOutput& output, size_t n) {
+  bool created;
+  uint32_t* counter = _stats.put_if_absent(&output, 0, &created);
+  *counter = *counter + (uint32_t)n;
+}
+
+// Waits for room with AsyncLogBlockWhenFull, except on the writer thread,
+// which would wait for itself. Returns whether there is room.
+bool AsyncLogWriter::wait_for_room_locked(size_t n) {
+  if (AsyncLogBlockWhenFull && n <= _capacity && Thread::current_or_null() != this) {
+    while (!has_room_locked(n)) {
+      _blocked_producers++;
+      _lock.wait(0 /* no timeout */);
+      _blocked_producers--;
+    }
+  }
+  return has_room_locked(n);
+}
+
+// Producers blocked on a full buffer wait on the same monitor as the
+// writer, so they must not take the notification meant for the writer.
+void AsyncLogWriter::notify_locked() {
+  if (_blocked_producers > 0) {
+    _lock.notify_all();
+  } else {
+    _lock.notify();
+  }
+}
+
+void AsyncLogWriter::enqueue_locked(LogFileStreamOutput& output, const LogDecorations& decorations, char* msg) {
+  ::new (slot_at(_head + _count)) AsyncLogMessage(output, decorations, msg);
+  _count++;
+}
+
+void AsyncLogWriter::enqueue(LogFileStreamOutput& output, const LogDecorations& decorations, const char* msg) {
+  char* const copy = os::strdup(msg, mtLogging);
+  bool enqueued = false;
+  {
+    AsyncLogLocker locker(_lock);
+    // Treat a failed copy like a full buffer
+    if (copy != NULL && wait_for_room_locked(1)) {
+      enqueue_locked(output, decorations, copy);
+      _data_available = true;
+      notify_locked();
+      enqueued = true;
+    } else {
+      // Drop the message and account for it
+      account_dropped_locked(output, 1);
+    }
+  }
+  if (!enqueued) {
+    os::free(copy);
+  }
+}
+
+// LogMessageBuffer consists of a multiple-part/multiple-line message.
+// The lines are enqueued as a whole, so that they are either all written
+// or all dropped.
+void AsyncLogWriter::enqueue(LogFileStreamOutput& output, LogMessageBuffer::Iterator msg_iterator) {
+  size_t lines = 0;
+  for (LogMessageBuffer::Iterator it = msg_iterator; !it.is_at_end(); it++) {
+    lines++;
+  }
+
+  char** const copies = NEW_C_HEAP_ARRAY_RETURN_NULL(char*, lines, mtLogging);
+  bool copied = copies != NULL;
+  if (copied) {
+    size_t i = 0;
+    for (LogMessageBuffer::Iterator it = msg_iterator; !it.is_at_end(); it++, i++) {
+      copies[i] = os::strdup(it.message(), mtLogging);
+      copied = copied && copies[i] != NULL;
+    }
+  }
+
+  bool enqueued = false;
+  {
+    AsyncLogLocker locker(_lock);
+    if (copied && wait_for_room_locked(lines)) {
+      size_t i = 0;
+      for (; !msg_iterator.is_at_end(); msg_iterator++, i++) {
+        enqueue_locked(output, msg_iterator.decorations(), copies[i]);
+      }
+      _data_available = true;
+      notify_locked();
+      enqueued = true;
+    } else {
+      account_dropped_locked(output, lines);
+    }
+  }
+
+  if (copies != NULL) {
+    if (!enqueued) {
+      for (size_t i = 0; i < lines; i++) {
+        os::free(copies[i]);
+      }
+    }
+    FREE_C_HEAP_ARRAY(char*, copies);
+  }
+}
+
+class AsyncLogMapIterator {
+  AsyncLogMap& _map;
+  LogFileStreamOutput** _outputs;
+  uint32_t* _dropped;
+  size_t _n;
+  const size_t _max;
+
+ public:
+  AsyncLogMapIterator(AsyncLogMap& map, LogFileStreamOutput** outputs, uint32_t* dropped, size_t max)
+    : _map(map), _outputs(outputs), _dropped(dropped), _n(0), _max(max) {}
+
+  bool do_entry(LogFileStreamOutput* const& output, uint32_t const& counter) {
+    if (counter > 0 && _n < _max) {
+      _outputs[_n] = output;
+      _dropped[_n] = counter;
+      _n++;
+    }
+    return true;
+  }
+
+  size_t count() const { return _n; }
+};
+
+bool AsyncLogWriter::write() {
+  // Outputs with dropped messages; there are only a handful of outputs,
+  // more than MaxReports of them losing messages at once is unlikely.
+  const size_t MaxReports = 16;
+  LogFileStreamOutput* outputs[MaxReports];
+  uint32_t dropped[MaxReports];
+  size_t nreports;
+  size_t start;
+  size_t n;
+  uint flushes;
+  bool terminate;
+
+  {
+    AsyncLogLocker locker(_lock);
+    while (!_data_available && !_should_terminate) {
+      _lock.wait(0 /* no timeout */);
+    }
+    _data_available = false;
+    terminate = _should_terminate;
+
+    start = _head;
+    n = _count;
+    flushes = _pending_flushes;
+    _pending_flushes = 0;
+
+    AsyncLogMapIterator iter(_stats, outputs, dropped, MaxReports);
+    _stats.iterate(&iter);
+    nreports = iter.count();
+    for (size_t i = 0; i < nreports; i++) {
+      _stats.remove(outputs[i]);
+    }
+  }
+
+  // The slots [start, start + n) stay reserved while they are written,
+  // producers only append after them.
+  for (size_t i = 0; i < n; i++) {
+    AsyncLogMessage* const msg = slot_at(start + i);
+    msg->writeback();
+    msg->~AsyncLogMessage();
+  }
+
+  for (size_t i = 0; i < nreports; i++) {
+    LogDecorations decorations(LogLevel::Warning, LogTagSetMapping<LogTag::_logging>::tagset(),
+                               outputs[i]->decorators());
+    stringStream ss;
+    ss.print(UINT32_FORMAT_W(6) " messages dropped due to async logging", dropped[i]);
+    outputs[i]->write_blocking(decorations, ss.as_string(false));
+  }
+
+  bool done = false;
+  {
+    AsyncLogLocker locker(_lock);
+    _head = (start + n) % _capacity;
+    _count -= n;
+    if (_blocked_producers > 0) {
+      _lock.notify_all();
+    }
+    // Log sites have stopped enqueuing before termination was requested,
+    // see terminate(). Stay around for flush requests that raced with it.
+    if (terminate && _count == 0 && _pending_flushes == 0) {
+      _terminated = true;
+      done = true;
+    }
+  }
+
+  for (uint i = 0; i < flushes; i++) {
+    _flush_sem.signal();
+  }
+  return !done;
+}
+
+void AsyncLogWriter::run() {
+  while (write()) {
+  }
+}
+
+void AsyncLogWriter::print_on(outputStream* st) const {
+  st->print("\"%s\" ", name());
+  Thread::print_on(st);
+  st->cr();
+}
+
+AsyncLogWriter* AsyncLogWriter::instance() {
+  return Atomic::load_acquire(&_instance);
+}
+
+// Inserts a flush token into the async output buffer and waits until the
+// AsyncLog thread signals that it has seen it and all preceding messages
+// have been written.
+void AsyncLogWriter::flush() {
+  AsyncLogWriter* const writer = instance();
+  if (writer == NULL || Thread::current_or_null() == writer) {
+    // Nothing to flush, or called by the writer itself
+    return;
+  }
+  {
+    AsyncLogLocker locker(writer->_lock);
+    if (writer->_terminated) {
+      // Everything has been written already
+      return;
+    }
+    writer->_pending_flushes++;
+    writer->_data_available = true;
+    writer->notify_locked();
+  }
+  writer->_flush_sem.wait();
+}
+
+void AsyncLogWriter::flush_on_error() {
+  AsyncLogWriter* const writer = instance();
+  if (writer == NULL || Thread::current_or_null() == writer) {
+    return;
+  }
+  // Whenever there are buffered messages the writer is already busy with
+  // them, so just watch the buffer drain, without taking the lock.
+  for (int i = 0; i < 100 && Atomic::load(&writer->_count) > 0; i++) {
+    os::naked_short_sleep(10);
+  }
+}
+
+void AsyncLogWriter::terminate() {
+  AsyncLogWriter* const writer = instance();
+  if (writer == NULL) {
+    return;
+  }
+  // New log sites write synchronously. Wait for the ones that may still
+  // be enqueuing, using the RCU counters of LogOutputList as initialize()
+  // does, then have the writer drain the buffer and exit.
+  Atomic::release_store_fence(&AsyncLogWriter::_instance, (AsyncLogWriter*)NULL);
+  for (LogTagSet* ts = LogTagSet::first(); ts != NULL; ts = ts->next()) {
+    ts->wait_until_no_readers();
+  }
+  {
+    AsyncLogLocker locker(writer->_lock);
+    writer->_should_terminate = true;
+    writer->_pending_flushes++;
+    writer->_data_available = true;
+    writer->notify_locked();
+  }
+  writer->_flush_sem.wait();
+  log_debug(logging, thread)("Async logging thread terminated.");
+}
+
+void AsyncLogWriter::initialize() {
+  if (!LogConfiguration::is_async_mode()) return;
+
+  assert(_instance == NULL, "initialize() should only be invoked once.");
+
+  AsyncLogWriter* self = new AsyncLogWriter();
+  if (self->_initialized) {
+    Atomic::release_store_fence(&AsyncLogWriter::_instance, self);
+    // All readers of _instance after the fence see non-NULL.
+    // We use LogOutputList's RCU counters to ensure all synchronous logsites have completed.
+    // After that, we start AsyncLog Thread and it exclusively takes over all logging I/O.
+    for (LogTagSet* ts = LogTagSet::first(); ts != NULL; ts = ts->next()) {
+      ts->wait_until_no_readers();
+    }
+    os::start_thread(self);
+    log_debug(logging, thread)("Async logging thread started.");
+  }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_LOGGING_LOGASYNCWRITER_HPP
+#define SHARE_LOGGING_LOGASYNCWRITER_HPP
+
+#include "logging/logDecorations.hpp"
+#include "logging/logMessageBuffer.hpp"
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+#include "runtime/semaphore.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/resourceHash.hpp"
+
+class LogFileStreamOutput;
+
+// A message waiting to be written by the AsyncLogWriter. The decorations
+// are captured when the message is logged, so timestamps and thread ids
+// reflect the logging site and not the writer thread.
+class AsyncLogMessage {
+  LogFileStreamOutput& _output;
+  const LogDecorations _decorations;
+  char* _message;
+
+ public:
+  AsyncLogMessage(LogFileStreamOutput& output, const LogDecorations& decorations, char* msg)
+    : _output(output), _decorations(decorations), _message(msg) {}
+
+  // Write the message to its output, and release the message string.
+  void writeback();
+  void destroy();
+};
+
+typedef ResourceHashtable<LogFileStreamOutput*,
+                          uint32_t,
+                          primitive_hash<LogFileStreamOutput*>,
+                          primitive_equals<LogFileStreamOutput*>,
+                          17, /*table_size*/
+                          ResourceObj::C_HEAP,
+                          mtLogging> AsyncLogMap;
+
+//
+// ASYNC LOGGING SUPPORT
+//
+// Summary:
+// With -Xlog:async, the logging sites enqueue messages into a bounded
+// buffer and return right away. A dedicated NonJavaThread, the
+// AsyncLogWriter, drains the buffer and does the actual I/O, so a slow
+// disk or a full pipe no longer stalls the threads that log, including
+// GC workers and the VM thread inside a safepoint.
+//
+// The buffer holds AsyncLogBufferSize bytes worth of messages. When it is
+// full, new messages are dropped and counted per output. The writer
+// reports the number of dropped messages on the affected output the next
+// time it runs. With AsyncLogBlockWhenFull, the logging threads instead
+// wait for the writer to make room.
+//
+// Messages are copied before the buffer is locked, the critical section
+// only appends them and never does I/O. The writer takes a batch of
+// messages under the lock and writes them without holding it.
+//
+// The writer is terminated when the logging configuration is finalized at
+// VM exit, after it has written all buffered messages. Logging is
+// synchronous from then on.
+//
+class AsyncLogWriter : public NonJavaThread {
+  static AsyncLogWriter* _instance;
+
+  // A low-level monitor is used because it can be used without
+  // Thread::current() and from any kind of thread.
+  os::PlatformMonitor _lock;
+  // Signalled once for every flush request when its messages are written.
+  Semaphore _flush_sem;
+
+  volatile bool _initialized;
+  bool          _should_terminate;
+  bool          _terminated;
+
+  // Fixed-capacity ring buffer of messages, protected by _lock.
+  // Slots [_head, _head + _count) are in use. The writer keeps the slots
+  // it is currently writing as in use, so producers never reuse them.
+  AsyncLogMessage* _buffer;
+  const size_t     _capacity;
+  size_t           _head;
+  size_t           _count;
+  bool             _data_available;
+  uint             _pending_flushes;
+  uint             _blocked_producers;
+  AsyncLogMap      _stats; // Messages dropped, per output
+
+  AsyncLogWriter();
+
+  void enqueue_locked(LogFileStreamOutput& output, const LogDecorations& decorations, char* msg);
+  void account_dropped_locked(LogFileStreamOutput& output, size_t n);
+  bool has_room_locked(size_t n) const { return _count + n <= _capacity; }
+  bool wait_for_room_locked(size_t n);
+  void notify_locked();
+  AsyncLogMessage* slot_at(size_t index) const { return &_buffer[index % _capacity]; }
+
+  // Returns false once the writer has terminated.
+  bool write();
+
+ protected:
+  virtual void run();
+
+ public:
+  // Printing
+  virtual char* name() const { return (char*)"AsyncLog Thread"; }
+  void print_on(outputStream* st) const;
+
+  void enqueue(LogFileStreamOutput& output, const LogDecorations& decorations, const char* msg);
+  void enqueue(LogFileStreamOutput& output, LogMessageBuffer::Iterator msg_iterator);
+
+  static AsyncLogWriter* instance();
+  static void initialize();
+  // Block until all messages enqueued before the call have been written.
+  static void flush();
+  // Wait a bounded time for the buffered messages to be written, for use
+  // during error reporting, when the writer may be stuck or the calling
+  // thread may hold the lock of the buffer.
+  static void flush_on_error();
+  // Write all buffered messages and stop the writer thread.
+  static void terminate();
+};
+
+#endif // SHARE_LOGGING_LOGASYNCWRITER_HPP
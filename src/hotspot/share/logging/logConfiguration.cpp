@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logDecorators.hpp"
@@ -44,6 +45,7 @@ size_t      LogConfiguration::_n_outputs = 0;
 
 LogConfiguration::UpdateListenerFunction* LogConfiguration::_listener_callbacks = NULL;
 size_t      LogConfiguration::_n_listener_callbacks = 0;
+bool        LogConfiguration::_async_mode = false;
 
 // LogFileOutput is the default type of output, its type prefix should be used if no type was specified
 static const char* implicit_output_prefix = LogFileOutput::Prefix;
@@ -110,6 +112,8 @@ void LogConfiguration::initialize(jlong vm_start_time) {
 }
 
 void LogConfiguration::finalize() {
+  // Write out pending asynchronous messages, logging is synchronous from here on
+  AsyncLogWriter::terminate();
   for (size_t i = _n_outputs; i > 0; i--) {
     disable_output(i - 1);
   }
@@ -205,6 +209,8 @@ void LogConfiguration::delete_output(size_t idx) {
   assert(idx > 1 && idx < _n_outputs,
          "idx must be in range 1 < idx < _n_outputs, but idx = " SIZE_FORMAT
          " and _n_outputs = " SIZE_FORMAT, idx, _n_outputs);
+  // Write out any pending asynchronous messages before the output goes away
+  AsyncLogWriter::flush();
   LogOutput* output = _outputs[idx];
   // Swap places with the last output and shrink the array
   _outputs[idx] = _outputs[--_n_outputs];
@@ -286,6 +292,8 @@ void LogConfiguration::disable_output(size_t idx) {
   if (idx > 1) {
     delete_output(idx);
   } else {
+    // Write out the asynchronous messages already logged to stdout or stderr
+    AsyncLogWriter::flush();
     out->set_config_string("all=off");
   }
 }
@@ -536,6 +544,14 @@ void LogConfiguration::print_command_line_help(outputStream* out) {
                                     " If set to 0, log rotation is disabled."
                                     " This will cause existing log files to be overwritten.");
   out->cr();
+  out->print_cr("\nAsynchronous logging (off by default):");
+  out->print_cr(" -Xlog:async");
+  out->print_cr("  All log messages are written to an intermediate buffer first and will then be flushed"
+                " to the corresponding log outputs by a standalone thread. Writing log messages to an"
+                " intermediate buffer does not block the calling thread. Use -XX:AsyncLogBufferSize to"
+                " set the buffer size; messages are dropped when the buffer is full, unless"
+                " -XX:+AsyncLogBlockWhenFull is set.");
+  out->cr();
 
   out->print_cr("Some examples:");
   out->print_cr(" -Xlog");
@@ -37,6 +37,17 @@ LogDecorations::LogDecorations(LogLevelType level, const LogTagSet &tagset, cons
   create_decorations(decorators);
 }
 
+LogDecorations::LogDecorations(const LogDecorations& other)
+    : _level(other._level), _tagset(other._tagset) {
+  // The decoration offsets point into the decorations buffer, so they
+  // need to be rebased on the copied buffer.
+  memcpy(_decorations_buffer, other._decorations_buffer, sizeof(_decorations_buffer));
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    const char* offset = other._decoration_offset[i];
+    _decoration_offset[i] = (offset == NULL) ? NULL : _decorations_buffer + (offset - other._decorations_buffer);
+  }
+}
+
 const char* LogDecorations::host_name() {
   const char* host_name = Atomic::load_acquire(&_host_name);
   if (host_name == NULL) {
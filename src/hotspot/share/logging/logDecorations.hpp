@@ -47,6 +47,7 @@ class LogDecorations {
 
  public:
   LogDecorations(LogLevelType level, const LogTagSet& tagset, const LogDecorators& decorators);
+  LogDecorations(const LogDecorations& other);
 
   void set_level(LogLevelType level) {
     _level = level;
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logFileOutput.hpp"
 #include "memory/allocation.inline.hpp"
@@ -290,8 +291,23 @@ int LogFileOutput::write(const LogDecorations& decorations, const char* msg) {
     return 0;
   }
 
+  AsyncLogWriter* aio_writer = AsyncLogWriter::instance();
+  if (aio_writer != NULL) {
+    aio_writer->enqueue(*this, decorations, msg);
+    return 0;
+  }
+
+  return write_blocking(decorations, msg);
+}
+
+int LogFileOutput::write_blocking(const LogDecorations& decorations, const char* msg) {
+  if (_stream == NULL) {
+    // An error has occurred with this output, avoid writing to it.
+    return 0;
+  }
+
   _rotation_semaphore.wait();
-  int written = LogFileStreamOutput::write(decorations, msg);
+  int written = LogFileStreamOutput::write_blocking(decorations, msg);
   _current_size += written;
 
   if (should_rotate()) {
@@ -308,6 +324,12 @@ int LogFileOutput::write(LogMessageBuffer::Iterator msg_iterator) {
     return 0;
   }
 
+  AsyncLogWriter* aio_writer = AsyncLogWriter::instance();
+  if (aio_writer != NULL) {
+    aio_writer->enqueue(*this, msg_iterator);
+    return 0;
+  }
+
   _rotation_semaphore.wait();
   int written = LogFileStreamOutput::write(msg_iterator);
   _current_size += written;
@@ -25,6 +25,7 @@
 #include "jvm.h"
 #include "logging/logDecorators.hpp"
 #include "logging/logDecorations.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logFileStreamOutput.hpp"
 #include "logging/logMessageBuffer.hpp"
 #include "memory/allocation.inline.hpp"
@@ -73,6 +74,15 @@ int LogFileStreamOutput::write_decorations(const LogDecorations& decorations) {
 }
 
 int LogFileStreamOutput::write(const LogDecorations& decorations, const char* msg) {
+  AsyncLogWriter* aio_writer = AsyncLogWriter::instance();
+  if (aio_writer != NULL) {
+    aio_writer->enqueue(*this, decorations, msg);
+    return 0;
+  }
+  return write_blocking(decorations, msg);
+}
+
+int LogFileStreamOutput::write_blocking(const LogDecorations& decorations, const char* msg) {
   const bool use_decorations = !_decorators.is_empty();
 
   int written = 0;
@@ -89,6 +99,14 @@ int LogFileStreamOutput::write(const LogDecorations& decorations, const char* ms
 }
 
 int LogFileStreamOutput::write(LogMessageBuffer::Iterator msg_iterator) {
+  AsyncLogWriter* aio_writer = AsyncLogWriter::instance();
+  if (aio_writer != NULL) {
+    // The lines of a multi-line message are enqueued together, so they
+    // stay contiguous in the output.
+    aio_writer->enqueue(*this, msg_iterator);
+    return 0;
+  }
+
   const bool use_decorations = !_decorators.is_empty();
 
   int written = 0;
@@ -55,6 +55,10 @@ class LogFileStreamOutput : public LogOutput {
  public:
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
+  // Write the message to the stream right away, on the calling thread.
+  // Used directly unless asynchronous logging is enabled, in which case
+  // it is called by the AsyncLogWriter thread.
+  virtual int write_blocking(const LogDecorations& decorations, const char* msg);
 };
 
 class LogStdoutOutput : public LogFileStreamOutput {
@@ -63,9 +63,11 @@ class LogOutputList {
   // Bookkeeping functions to keep track of number of active readers/iterators for the list.
   jint increase_readers();
   jint decrease_readers();
-  void wait_until_no_readers() const;
 
  public:
+  // Wait until all current readers/iterators of the list are done.
+  void wait_until_no_readers() const;
+
   LogOutputList() : _active_readers(0) {
     for (size_t i = 0; i < LogLevel::Count; i++) {
       _level_start[i] = NULL;
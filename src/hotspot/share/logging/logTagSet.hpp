@@ -109,6 +109,10 @@ class LogTagSet {
   int label(char *buf, size_t len, const char* separator = ",") const;
   bool has_output(const LogOutput* output);
 
+  void wait_until_no_readers() const {
+    _output_list.wait_until_no_readers();
+  }
+
   // The implementation of this function is put here to ensure
   // that it is inline:able by the log_is_enabled(level, ...) macro.
   bool is_level(LogLevelType level) const {
@@ -29,6 +29,7 @@
 #include "memory/resourceArea.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
+#include "runtime/thread.inline.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
@@ -49,6 +50,8 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* _medium_pool;
   static ChunkPool* _small_pool;
   static ChunkPool* _tiny_pool;
+  // Pools for oversized chunks, see Chunk::pooled_length()
+  static ChunkPool* _huge_pools[Chunk::huge_pool_count];
 
   // return first element or null
   void* get_first() {
@@ -74,7 +77,7 @@ class ChunkPool: public CHeapObj<mtInternal> {
       _num_used++;
       p = get_first();
     }
-    if (p == NULL) p = os::malloc(bytes, mtChunk, CURRENT_PC);
+    if (p == NULL) p = os::malloc(bytes, mtChunk, MALLOC_CURRENT_PC);
     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "ChunkPool::allocate");
     }
@@ -129,19 +132,51 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* small_pool()  { assert(_small_pool  != NULL, "must be initialized"); return _small_pool;  }
   static ChunkPool* tiny_pool()   { assert(_tiny_pool   != NULL, "must be initialized"); return _tiny_pool;   }
 
+  static size_t huge_length(int i) { return (Chunk::huge_min_size << i) - Chunk::slack; }
+
+  // Returns the pool for chunks of exactly this length, or NULL
+  static ChunkPool* pool_for(size_t length) {
+    switch (length) {
+     case Chunk::size:        return large_pool();
+     case Chunk::medium_size: return medium_pool();
+     case Chunk::init_size:   return small_pool();
+     case Chunk::tiny_size:   return tiny_pool();
+     default:                 return huge_pool(length);
+    }
+  }
+
+  // Returns the pool for oversized chunks of exactly this length, or NULL
+  static ChunkPool* huge_pool(size_t length) {
+    for (int i = 0; i < Chunk::huge_pool_count; i++) {
+      if (length == huge_length(i)) {
+        assert(_huge_pools[i] != NULL, "must be initialized");
+        return _huge_pools[i];
+      }
+    }
+    return NULL;
+  }
+
   static void initialize() {
     _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
     _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
     _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size());
     _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
+    for (int i = 0; i < Chunk::huge_pool_count; i++) {
+      _huge_pools[i] = new ChunkPool(huge_length(i) + Chunk::aligned_overhead_size());
+    }
   }
 
   static void clean() {
-    enum { BlocksToKeep = 5 };
+    enum { BlocksToKeep = 5, HugeBlocksToKeep = 1 };
      _tiny_pool->free_all_but(BlocksToKeep);
      _small_pool->free_all_but(BlocksToKeep);
      _medium_pool->free_all_but(BlocksToKeep);
      _large_pool->free_all_but(BlocksToKeep);
+     // Huge chunks are only kept around long enough to be reused by the
+     // next few compilations, they would otherwise pin a lot of memory.
+     for (int i = 0; i < Chunk::huge_pool_count; i++) {
+       _huge_pools[i]->free_all_but(HugeBlocksToKeep);
+     }
   }
 };
 
@@ -149,6 +184,7 @@ ChunkPool* ChunkPool::_large_pool  = NULL;
 ChunkPool* ChunkPool::_medium_pool = NULL;
 ChunkPool* ChunkPool::_small_pool  = NULL;
 ChunkPool* ChunkPool::_tiny_pool   = NULL;
+ChunkPool* ChunkPool::_huge_pools[Chunk::huge_pool_count] = { NULL };
 
 void chunkpool_init() {
   ChunkPool::initialize();
@@ -174,6 +210,46 @@ class ChunkPoolCleaner : public PeriodicTask {
    }
 };
 
+//--------------------------------------------------------------------------------------
+// ChunkCache implementation
+
+int ChunkCache::index_for(size_t length) {
+  switch (length) {
+   case Chunk::init_size:   return 0;
+   case Chunk::tiny_size:   return 1;
+   default:                 return -1;
+  }
+}
+
+void* ChunkCache::take(size_t length) {
+  int i = index_for(length);
+  if (i < 0) {
+    return NULL;
+  }
+  Chunk* c = _chunks[i];
+  _chunks[i] = NULL;
+  return c;
+}
+
+bool ChunkCache::put(Chunk* c) {
+  int i = index_for(c->length());
+  if (i < 0 || _chunks[i] != NULL) {
+    return false;
+  }
+  _chunks[i] = c;
+  return true;
+}
+
+void ChunkCache::flush() {
+  for (int i = 0; i < cache_size; i++) {
+    Chunk* c = _chunks[i];
+    if (c != NULL) {
+      _chunks[i] = NULL;
+      ChunkPool::pool_for(c->length())->free(c);
+    }
+  }
+}
+
 //--------------------------------------------------------------------------------------
 // Chunk implementation
 
@@ -184,32 +260,47 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
   // expect requested_size but if sizeof(Chunk) doesn't match isn't proper size we must align it.
   assert(ARENA_ALIGN(requested_size) == aligned_overhead_size(), "Bad alignment");
   size_t bytes = ARENA_ALIGN(requested_size) + length;
-  switch (length) {
-   case Chunk::size:        return ChunkPool::large_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::medium_size: return ChunkPool::medium_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::init_size:   return ChunkPool::small_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::tiny_size:   return ChunkPool::tiny_pool()->allocate(bytes, alloc_failmode);
-   default: {
-     void* p = os::malloc(bytes, mtChunk, CALLER_PC);
-     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
-       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
-     }
-     return p;
-   }
+  Thread* thread = Thread::current_or_null_safe();
+  if (thread != NULL) {
+    void* p = thread->chunk_cache()->take(length);
+    if (p != NULL) {
+      return p;
+    }
   }
+  ChunkPool* pool = ChunkPool::pool_for(length);
+  if (pool != NULL) {
+    return pool->allocate(bytes, alloc_failmode);
+  }
+  void* p = os::malloc(bytes, mtChunk, MALLOC_CALLER_PC);
+  if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
+    vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
+  }
+  return p;
 }
 
 void Chunk::operator delete(void* p) {
   Chunk* c = (Chunk*)p;
-  switch (c->length()) {
-   case Chunk::size:        ChunkPool::large_pool()->free(c); break;
-   case Chunk::medium_size: ChunkPool::medium_pool()->free(c); break;
-   case Chunk::init_size:   ChunkPool::small_pool()->free(c); break;
-   case Chunk::tiny_size:   ChunkPool::tiny_pool()->free(c); break;
-   default:
-     ThreadCritical tc;  // Free chunks under TC lock so that NMT adjustment is stable.
-     os::free(c);
+  Thread* thread = Thread::current_or_null_safe();
+  if (thread != NULL && thread->chunk_cache()->put(c)) {
+    return;
+  }
+  ChunkPool* pool = ChunkPool::pool_for(c->length());
+  if (pool != NULL) {
+    pool->free(c);
+    return;
+  }
+  ThreadCritical tc;  // Free chunks under TC lock so that NMT adjustment is stable.
+  os::free(c);
+}
+
+size_t Chunk::pooled_length(size_t length) {
+  for (int i = 0; i < huge_pool_count; i++) {
+    size_t huge = ChunkPool::huge_length(i);
+    if (length <= huge) {
+      return huge;
+    }
   }
+  return length;
 }
 
 Chunk::Chunk(size_t length) : _len(length) {
@@ -296,11 +387,11 @@ void* Arena::operator new (size_t size, const std::nothrow_t&  nothrow_constant)
 
   // dynamic memory type binding
 void* Arena::operator new(size_t size, MEMFLAGS flags) throw() {
-  return (void *) AllocateHeap(size, flags, CALLER_PC);
+  return (void *) AllocateHeap(size, flags, MALLOC_CALLER_PC);
 }
 
 void* Arena::operator new(size_t size, const std::nothrow_t& nothrow_constant, MEMFLAGS flags) throw() {
-  return (void*)AllocateHeap(size, flags, CALLER_PC, AllocFailStrategy::RETURN_NULL);
+  return (void*)AllocateHeap(size, flags, MALLOC_CALLER_PC, AllocFailStrategy::RETURN_NULL);
 }
 
 void Arena::operator delete(void* p) {
@@ -327,6 +418,13 @@ void Arena::set_size_in_bytes(size_t size) {
     ssize_t delta = size - size_in_bytes();
     _size_in_bytes = size;
     MemTracker::record_arena_size_change(delta, _flags);
+    if (_flags == mtCompiler) {
+      // Account compiler memory against the current compilation
+      Thread* thread = Thread::current_or_null();
+      if (thread != NULL && thread->is_Compiler_thread()) {
+        thread->as_Java_thread()->as_CompilerThread()->update_arena_statistics(delta);
+      }
+    }
   }
 }
 
@@ -349,6 +447,11 @@ void Arena::signal_out_of_memory(size_t sz, const char* whence) const {
 void* Arena::grow(size_t x, AllocFailType alloc_failmode) {
   // Get minimal required size.  Either real big, or even bigger for giant objs
   size_t len = MAX2(x, (size_t) Chunk::size);
+  if (len > (size_t) Chunk::size) {
+    // Round up to a pooled size so that big chunks, e.g. the node arrays
+    // of large C2 compilations, get recycled instead of malloc'ed each time
+    len = Chunk::pooled_length(len);
+  }
 
   Chunk *k = _chunk;            // Get filled-up chunk address
   _chunk = new (alloc_failmode, len) Chunk(len);
@@ -70,6 +70,16 @@ class Chunk: CHeapObj<mtChunk> {
     non_pool_size = init_size + 32 // An initial size which is not one of above
   };
 
+  enum {
+    // Oversized chunks whose length is one of huge_pool_count power-of-two
+    // sizes starting at huge_min_size (minus slack) are pooled as well
+    huge_min_size   = 64*K,
+    huge_pool_count = 5
+  };
+
+  // Round length up to a pooled chunk size, if there is one large enough
+  static size_t pooled_length(size_t length);
+
   void chop();                  // Chop this chunk
   void next_chop();             // Chop next chunk
   static size_t aligned_overhead_size(void) { return ARENA_ALIGN(sizeof(Chunk)); }
@@ -89,6 +99,38 @@ class Chunk: CHeapObj<mtChunk> {
   static void clean_chunk_pool();
 };
 
+//------------------------------ChunkCache-------------------------------------
+// Per-thread cache holding at most one free tiny and one free small chunk.
+// Arenas that are created and destroyed repeatedly on one thread (resource
+// areas, handle areas, short-lived arenas) reuse the memory that thread
+// touched last, without taking the ThreadCritical lock of the global
+// ChunkPools. Medium and large chunks are not cached: the ChunkPoolCleaner
+// cannot drain the caches of idle threads, so each thread would keep over
+// 40K of malloc memory until it exits.
+class ChunkCache {
+ public:
+  enum { cache_size = 2 };
+
+ private:
+  Chunk* _chunks[cache_size];
+
+  static int index_for(size_t length);
+
+ public:
+  ChunkCache() {
+    for (int i = 0; i < cache_size; i++) {
+      _chunks[i] = NULL;
+    }
+  }
+
+  // Returns a cached chunk of this length, or NULL
+  void* take(size_t length);
+  // Caches the chunk if its slot is empty, returns false otherwise
+  bool put(Chunk* c);
+  // Returns all cached chunks to the global pools
+  void flush();
+};
+
 //------------------------------Arena------------------------------------------
 // Fast allocation of memory
 class Arena : public CHeapObj<mtNone> {
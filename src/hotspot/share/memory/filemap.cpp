@@ -1677,6 +1677,13 @@ static int num_closed_archive_heap_ranges = 0;
 static int num_open_archive_heap_ranges = 0;
 
 #if INCLUDE_CDS_JAVA_HEAP
+// Used instead of the ranges above when the heap regions are loaded.
+// Indexed by region, relative to the first closed archive heap region.
+static const int num_archive_heap_regions = MetaspaceShared::last_open_archive_heap_region -
+                                            MetaspaceShared::first_closed_archive_heap_region + 1;
+static MemRegion loaded_archive_heap_ranges[num_archive_heap_regions];
+static MemRegion loaded_archive_heap_space;
+
 bool FileMapInfo::has_heap_regions() {
   return (space_at(MetaspaceShared::first_closed_archive_heap_region)->used() > 0);
 }
@@ -1836,7 +1843,11 @@ void FileMapInfo::map_heap_regions_impl() {
 
 void FileMapInfo::map_heap_regions() {
   if (has_heap_regions()) {
-    map_heap_regions_impl();
+    if (HeapShared::can_load()) {
+      load_heap_regions();
+    } else {
+      map_heap_regions_impl();
+    }
   }
 
   if (!HeapShared::closed_archive_heap_region_mapped()) {
@@ -1849,6 +1860,97 @@ void FileMapInfo::map_heap_regions() {
   }
 }
 
+//
+// Load the closed and open archive heap objects into the heap of a collector
+// that cannot map them (see CollectedHeap::can_load_archived_objects()).
+//
+// The used part of each region is copied, back to back, into one block that
+// the collector allocates at the bottom of its old generation. The loaded
+// objects are ordinary heap objects. Their embedded pointers are patched in
+// patch_archived_heap_embedded_pointers(), and HeapShared::decode_from_archive()
+// translates the narrow oops kept in the archived metadata to the new locations.
+void FileMapInfo::load_heap_regions() {
+  log_info(cds)("CDS archive was created with narrow_klass_base = " PTR_FORMAT ", narrow_klass_shift = %d",
+                p2i(narrow_klass_base()), narrow_klass_shift());
+  if (narrow_klass_base() != CompressedKlassPointers::base() ||
+      narrow_klass_shift() != CompressedKlassPointers::shift()) {
+    log_info(cds)("CDS heap data cannot be used because the archive was created with an incompatible narrow klass encoding mode.");
+    return;
+  }
+
+  // The bitmap is needed to patch the embedded pointers. Map it now, so
+  // that a failure leaves the heap untouched.
+  if (map_bitmap_region() == NULL) {
+    return;
+  }
+
+  // The dump time narrow oops are decoded with the dump time encoding,
+  // then moved to where their region is loaded.
+  HeapShared::init_narrow_oop_decoding(narrow_oop_base(), narrow_oop_shift());
+
+  char* mapped_bases[num_archive_heap_regions];
+  size_t total_bytes = 0;
+  bool success = true;
+  for (int i = 0; i < num_archive_heap_regions; i++) {
+    FileMapRegion* si = space_at(MetaspaceShared::first_closed_archive_heap_region + i);
+    mapped_bases[i] = NULL;
+    if (si->used() == 0 || !success) {
+      continue;
+    }
+    char* base = os::map_memory(_fd, _full_path, si->file_offset(),
+                                NULL, si->used_aligned(), true /* read_only */,
+                                false /* allow_exec */, mtClassShared);
+    if (base == NULL) {
+      log_info(cds)("UseSharedSpaces: Unable to map heap region #%d for loading",
+                    MetaspaceShared::first_closed_archive_heap_region + i);
+      success = false;
+      continue;
+    }
+    mapped_bases[i] = base;
+    if (VerifySharedSpaces && !region_crc_check(base, si->used(), si->crc())) {
+      log_info(cds)("UseSharedSpaces: loaded heap regions are corrupt");
+      success = false;
+      continue;
+    }
+    total_bytes += si->used();
+  }
+
+  HeapWord* buffer = NULL;
+  if (success) {
+    buffer = Universe::heap()->allocate_loaded_archive_space(total_bytes / HeapWordSize);
+    if (buffer == NULL) {
+      log_info(cds)("UseSharedSpaces: Unable to allocate " SIZE_FORMAT " bytes in the java heap for the archived heap objects",
+                    total_bytes);
+    }
+  }
+
+  char* top = (char*)buffer;
+  for (int i = 0; i < num_archive_heap_regions; i++) {
+    if (mapped_bases[i] == NULL) {
+      continue;
+    }
+    FileMapRegion* si = space_at(MetaspaceShared::first_closed_archive_heap_region + i);
+    if (buffer != NULL) {
+      memcpy(top, mapped_bases[i], si->used());
+      HeapShared::add_loaded_region(start_address_as_decoded_from_archive(si), si->used(), (address)top);
+      loaded_archive_heap_ranges[i] = MemRegion((HeapWord*)top, si->used() / HeapWordSize);
+      log_info(cds)("Loaded heap data: region[%d] at " INTPTR_FORMAT ", size = " SIZE_FORMAT_W(8) " bytes",
+                    MetaspaceShared::first_closed_archive_heap_region + i, p2i(top), si->used());
+      top += si->used();
+    }
+    if (!os::unmap_memory(mapped_bases[i], si->used_aligned())) {
+      fatal("os::unmap_memory of heap region #%d failed", MetaspaceShared::first_closed_archive_heap_region + i);
+    }
+  }
+
+  if (buffer != NULL) {
+    assert(top == (char*)buffer + total_bytes, "must have loaded all regions");
+    loaded_archive_heap_space = MemRegion(buffer, total_bytes / HeapWordSize);
+    HeapShared::set_loaded();
+    _heap_pointers_need_patching = true;
+  }
+}
+
 bool FileMapInfo::map_heap_data(MemRegion **heap_mem, int first,
                                 int max, int* num, bool is_open_archive) {
   MemRegion* regions = MemRegion::create_array(max, mtInternal);
@@ -1932,6 +2034,17 @@ void FileMapInfo::patch_archived_heap_embedded_pointers() {
     return;
   }
 
+  if (HeapShared::is_loaded()) {
+    for (int i = 0; i < num_archive_heap_regions; i++) {
+      if (!loaded_archive_heap_ranges[i].is_empty()) {
+        patch_archived_heap_embedded_pointers(&loaded_archive_heap_ranges[i], 1,
+                                              MetaspaceShared::first_closed_archive_heap_region + i);
+      }
+    }
+    HeapShared::complete_loading(loaded_archive_heap_space);
+    return;
+  }
+
   patch_archived_heap_embedded_pointers(closed_archive_heap_ranges,
                                         num_closed_archive_heap_ranges,
                                         MetaspaceShared::first_closed_archive_heap_region);
@@ -358,6 +358,7 @@ void CodeHeap::deallocate_tail(void* p, size_t used_size) {
 
   HeapBlock* f = split_block(b, used_number_of_segments);
   add_to_freelist(f);
+  trim_freelist_tail();
   NOT_PRODUCT(verify());
 }
 
@@ -371,6 +372,7 @@ void CodeHeap::deallocate(void* p) {
             "starting with "  INTPTR_FORMAT " and ending with " INTPTR_FORMAT,
             p2i(b), p2i(_memory.low_boundary()), p2i(_memory.high()));
   add_to_freelist(b);
+  trim_freelist_tail();
   NOT_PRODUCT(verify());
 }
 
@@ -537,6 +539,19 @@ HeapBlock* CodeHeap::next_block(HeapBlock *b) const {
   return NULL;
 }
 
+// Returns the first Heap block starting at or after p, e.g. to resume
+// a walk over the heap after the CodeCache_lock was released.
+// The returned pointer points to the block header.
+HeapBlock* CodeHeap::first_block_at_or_after(void* p) const {
+  if (segment_for(p) >= _next_segment) {
+    return NULL;
+  }
+  HeapBlock* b = (HeapBlock*)find_block_for(p);
+  if (b != NULL && (void*)b < p) {
+    b = next_block(b);
+  }
+  return b;
+}
 
 // Returns current capacity
 size_t CodeHeap::capacity() const {
@@ -661,6 +676,55 @@ void CodeHeap::add_to_freelist(HeapBlock* a) {
   _last_insert_point = prev;
 }
 
+/**
+ * If the highest free block ends at _next_segment, give it back to the
+ * unallocated part of the heap instead of keeping it on the freelist.
+ * This keeps the allocated part of the heap compact: blobs that do not
+ * fit any free block are placed as low as possible, and fewer pages
+ * (or large pages) are spanned by live code.
+ */
+void CodeHeap::trim_freelist_tail() {
+  if (_next_segment == 0) {
+    return;
+  }
+  FreeBlock* top = (FreeBlock*)find_block_for(address_for(_next_segment - 1));
+  if (top == NULL || !top->free()) {
+    // Common case, the highest block is in use
+    return;
+  }
+  assert(top->link() == NULL, "highest free block must be last on the freelist");
+
+  FreeBlock* prev = NULL;
+  FreeBlock* cur  = _freelist;
+  if (_last_insert_point != NULL) {
+    _last_insert_point = (FreeBlock*)find_block_for(_last_insert_point);
+    if ((_last_insert_point != NULL) && _last_insert_point->free() && (_last_insert_point < top)) {
+      prev = _last_insert_point;
+      cur  = prev->link();
+    }
+  }
+  while (cur != top) {
+    assert(cur != NULL, "must find the highest free block on the freelist");
+    prev = cur;
+    cur  = cur->link();
+  }
+
+  if (prev == NULL) {
+    _freelist = NULL;
+  } else {
+    prev->set_link(NULL);
+  }
+  if (_last_insert_point == top) {
+    _last_insert_point = NULL;
+  }
+  _freelist_length--;
+  _freelist_segments -= top->length();
+
+  size_t beg = segment_for(top);
+  clear(beg, _next_segment);
+  _next_segment = beg;
+}
+
 /**
  * Search freelist for an entry on the list with the best fit.
  * @return NULL, if no one was found
@@ -136,6 +136,7 @@ class CodeHeap : public CHeapObj<mtCode> {
   // Toplevel freelist management
   void add_to_freelist(HeapBlock* b);
   HeapBlock* search_freelist(size_t length);
+  void trim_freelist_tail();
 
   // Iteration helpers
   void*      next_used(HeapBlock* b) const;
@@ -192,6 +193,7 @@ class CodeHeap : public CHeapObj<mtCode> {
   size_t segment_size()         const { return _segment_size; }  // for CodeHeapState
   HeapBlock* first_block() const;                                // for CodeHeapState
   HeapBlock* next_block(HeapBlock* b) const;                     // for CodeHeapState
+  HeapBlock* first_block_at_or_after(void* p) const;             // for CodeHeapState
   HeapBlock* split_block(HeapBlock* b, size_t split_seg);        // split one block into two
 
   FreeBlock* freelist()         const { return _freelist; }      // for CodeHeapState
@@ -40,6 +40,7 @@
 #include "services/memTracker.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/spinYield.hpp"
 #include "utilities/stack.inline.hpp"
 
 // HeapInspection
@@ -174,7 +175,7 @@ KlassInfoTable::KlassInfoTable(bool add_all_classes) {
   _ref = (HeapWord*) Universe::boolArrayKlassObj();
   _buckets =
     (KlassInfoBucket*)  AllocateHeap(sizeof(KlassInfoBucket) * _num_buckets,
-       mtInternal, CURRENT_PC, AllocFailStrategy::RETURN_NULL);
+       mtInternal, MALLOC_CURRENT_PC, AllocFailStrategy::RETURN_NULL);
   if (_buckets != NULL) {
     for (int index = 0; index < _num_buckets; index++) {
       _buckets[index].initialize();
@@ -274,6 +275,41 @@ bool KlassInfoTable::merge(KlassInfoTable* table) {
   return closure.success();
 }
 
+class KlassInfoTable::BucketMerger : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  size_t _words;
+  bool _success;
+ public:
+  BucketMerger(KlassInfoTable* dest) : _dest(dest), _words(0), _success(true) {}
+  void do_cinfo(KlassInfoEntry* cie) {
+    KlassInfoEntry* elt = _dest->lookup(cie->klass());
+    if (elt != NULL) {
+      elt->set_count(elt->count() + cie->count());
+      elt->set_words(elt->words() + cie->words());
+      _words += cie->words();
+    } else {
+      _success = false;
+    }
+  }
+  size_t words() const { return _words; }
+  bool success() const { return _success; }
+};
+
+// Merge buckets [from, to) of table into this table. Both tables hash a
+// klass to the same bucket, so callers merging disjoint bucket ranges
+// concurrently never touch the same bucket of this table.
+bool KlassInfoTable::merge_buckets(KlassInfoTable* table, int from, int to) {
+  assert(0 <= from && from <= to && to <= _num_buckets, "invalid bucket range");
+  assert(table->_ref == _ref, "tables must hash alike");
+  BucketMerger merger(this);
+  for (int index = from; index < to; index++) {
+    table->_buckets[index].iterate(&merger);
+  }
+  Atomic::add(&_size_of_instances_in_words, merger.words());
+  return merger.success();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -560,10 +596,7 @@ void ParHeapInspectTask::work(uint worker_id) {
   RecordInstanceClosure ric(&cit, _filter);
   _poi->object_iterate(&ric, worker_id);
   missed_count = ric.missed_count();
-  {
-    MutexLocker x(&_mutex);
-    merge_success = _shared_cit->merge(&cit);
-  }
+  merge_success = merge_stripes(&cit, worker_id);
   if (merge_success) {
     Atomic::add(&_missed_count, missed_count);
   } else {
@@ -571,6 +604,40 @@ void ParHeapInspectTask::work(uint worker_id) {
   }
 }
 
+// Merge every stripe of cit into the shared table, starting at a stripe
+// picked by worker_id and skipping stripes another worker is merging.
+bool ParHeapInspectTask::merge_stripes(KlassInfoTable* cit, uint worker_id) {
+  const int num_buckets = KlassInfoTable::num_buckets();
+  bool merged[_num_merge_stripes] = { false };
+  int remaining = _num_merge_stripes;
+  int stripe = (int)(worker_id % _num_merge_stripes);
+  bool success = true;
+  bool progress = false;
+  SpinYield yield;
+  while (remaining > 0) {
+    if (!merged[stripe] &&
+        !Atomic::load(&_stripe_locked[stripe]) &&
+        !Atomic::cmpxchg(&_stripe_locked[stripe], false, true)) {
+      const int from = (int)((int64_t)num_buckets * stripe / _num_merge_stripes);
+      const int to = (int)((int64_t)num_buckets * (stripe + 1) / _num_merge_stripes);
+      success &= _shared_cit->merge_buckets(cit, from, to);
+      Atomic::release_store(&_stripe_locked[stripe], false);
+      merged[stripe] = true;
+      remaining--;
+      progress = true;
+    }
+    stripe = (stripe + 1) % _num_merge_stripes;
+    if (stripe == (int)(worker_id % _num_merge_stripes)) {
+      // A full lap without claiming a stripe; the rest are held by others.
+      if (!progress) {
+        yield.wait();
+      }
+      progress = false;
+    }
+  }
+  return success;
+}
+
 uintx HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter, uint parallel_thread_num) {
 
   // Try parallel first.
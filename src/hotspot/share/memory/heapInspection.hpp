@@ -117,8 +117,11 @@ class KlassInfoTable: public StackObj {
   KlassInfoEntry* lookup(Klass* k); // allocates if not found!
 
   class AllClassesFinder;
+  class BucketMerger;
 
  public:
+  static int num_buckets() { return _num_buckets; }
+
   KlassInfoTable(bool add_all_classes);
   ~KlassInfoTable();
   bool record_instance(const oop obj);
@@ -127,6 +130,7 @@ class KlassInfoTable: public StackObj {
   size_t size_of_instances_in_words() const;
   bool merge(KlassInfoTable* table);
   bool merge_entry(const KlassInfoEntry* cie);
+  bool merge_buckets(KlassInfoTable* table, int from, int to);
 
   friend class KlassInfoHisto;
   friend class KlassHierarchy;
@@ -226,14 +230,23 @@ class HeapInspection : public StackObj {
 // Parallel heap inspection task. Parallel inspection can fail due to
 // a native OOM when allocating memory for TL-KlassInfoTable.
 // _success will be set false on an OOM, and serial inspection tried.
+//
+// Workers merge their TL-KlassInfoTable into the shared table stripe by
+// stripe. A stripe is a range of buckets guarded by its own lock, and
+// each worker starts at a different stripe, so the merges of different
+// workers proceed in parallel instead of queueing on a single lock.
 class ParHeapInspectTask : public AbstractGangTask {
  private:
+  static const int _num_merge_stripes = 64;
+
   ParallelObjectIterator* _poi;
   KlassInfoTable* _shared_cit;
   BoolObjectClosure* _filter;
   uintx _missed_count;
   bool _success;
-  Mutex _mutex;
+  volatile bool _stripe_locked[_num_merge_stripes];
+
+  bool merge_stripes(KlassInfoTable* cit, uint worker_id);
 
  public:
   ParHeapInspectTask(ParallelObjectIterator* poi,
@@ -244,8 +257,11 @@ class ParHeapInspectTask : public AbstractGangTask {
       _shared_cit(shared_cit),
       _filter(filter),
       _missed_count(0),
-      _success(true),
-      _mutex(Mutex::leaf, "Parallel heap iteration data merge lock") {}
+      _success(true) {
+    for (int i = 0; i < _num_merge_stripes; i++) {
+      _stripe_locked[i] = false;
+    }
+  }
 
   uintx missed_count() const {
     return _missed_count;
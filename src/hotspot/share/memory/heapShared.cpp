@@ -32,6 +32,7 @@
 #include "classfile/systemDictionary.hpp"
 #include "classfile/systemDictionaryShared.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "logging/log.hpp"
 #include "logging/logMessage.hpp"
@@ -48,6 +49,7 @@
 #include "oops/compressedOops.inline.hpp"
 #include "oops/fieldStreams.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "oops/oopHandle.inline.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/safepointVerifiers.hpp"
@@ -63,6 +65,10 @@ bool HeapShared::_open_archive_heap_region_mapped = false;
 bool HeapShared::_archive_heap_region_fixed = false;
 address   HeapShared::_narrow_oop_base;
 int       HeapShared::_narrow_oop_shift;
+HeapShared::LoadedRegion HeapShared::_loaded_regions[MetaspaceShared::max_closed_archive_heap_region +
+                                                     MetaspaceShared::max_open_archive_heap_region];
+int       HeapShared::_num_loaded_regions = 0;
+bool      HeapShared::_is_loaded = false;
 DumpedInternedStrings *HeapShared::_dumped_interned_strings = NULL;
 
 //
@@ -215,6 +221,9 @@ oop HeapShared::materialize_archived_object(narrowOop v) {
          "must be called after archive heap regions are fixed");
   if (!CompressedOops::is_null(v)) {
     oop obj = HeapShared::decode_from_archive(v);
+    if (is_loaded()) {
+      return obj;
+    }
     return G1CollectedHeap::heap()->materialize_archived_object(obj);
   }
   return NULL;
@@ -345,6 +354,52 @@ void HeapShared::init_narrow_oop_decoding(address base, int shift) {
   _narrow_oop_shift = shift;
 }
 
+bool HeapShared::can_load() {
+  return UseCompressedOops && UseCompressedClassPointers &&
+         Universe::heap()->can_load_archived_objects();
+}
+
+void HeapShared::add_loaded_region(address dumptime_base, size_t byte_size, address runtime_base) {
+  assert(!_is_loaded, "must add all regions before decoding with them");
+  assert(_num_loaded_regions < MetaspaceShared::max_closed_archive_heap_region +
+                               MetaspaceShared::max_open_archive_heap_region, "too many regions");
+  LoadedRegion* r = &_loaded_regions[_num_loaded_regions++];
+  r->_dumptime_base = (uintptr_t)dumptime_base;
+  r->_byte_size = byte_size;
+  r->_runtime_offset = runtime_base - dumptime_base;
+}
+
+void HeapShared::set_loaded() {
+  assert(_num_loaded_regions > 0, "no regions loaded");
+  _is_loaded = true;
+  set_closed_archive_heap_region_mapped();
+  set_open_archive_heap_region_mapped();
+}
+
+// Called once the embedded pointers in the loaded objects have been patched.
+void HeapShared::complete_loading(MemRegion loaded_space) {
+  assert(is_loaded(), "sanity");
+  Universe::heap()->complete_loaded_archive_space(loaded_space);
+
+  // Many of the loaded objects are only referenced through narrow oops in
+  // the archived metadata (archived mirrors and resolved references, the
+  // shared string table, the subgraph entry fields), which the collectors
+  // do not scan. Keep every loaded object alive with a strong root so none
+  // of them can be reclaimed before it is used. Since they are all live
+  // and at the bottom of the old generation, full GCs also leave them in
+  // place, which keeps those narrow oops valid.
+  int count = 0;
+  HeapWord* p = loaded_space.start();
+  while (p < loaded_space.end()) {
+    oop obj = oop(p);
+    OopHandle keep_alive(Universe::vm_global(), obj); // never released
+    p += obj->size();
+    count++;
+  }
+  log_info(cds)("Loaded %d archived heap objects (" SIZE_FORMAT " bytes) at " PTR_FORMAT,
+                count, loaded_space.byte_size(), p2i(loaded_space.start()));
+}
+
 //
 // Subgraph archiving support
 //
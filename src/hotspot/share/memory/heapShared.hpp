@@ -216,6 +216,21 @@ private:
   static address _narrow_oop_base;
   static int     _narrow_oop_shift;
 
+  // Where the archived heap regions were placed when they were loaded
+  // instead of mapped (see is_loaded()). The regions are loaded back to
+  // back, so each one is moved by its own offset.
+  struct LoadedRegion {
+    uintptr_t _dumptime_base;  // Bottom of the region, as decoded from the archive
+    size_t    _byte_size;
+    intx      _runtime_offset; // Load time address minus dump time address
+  };
+  static LoadedRegion _loaded_regions[MetaspaceShared::max_closed_archive_heap_region +
+                                      MetaspaceShared::max_open_archive_heap_region];
+  static int  _num_loaded_regions;
+  static bool _is_loaded;
+
+  inline static uintptr_t to_loaded_address(uintptr_t dumptime_addr);
+
   typedef ResourceHashtable<oop, bool,
       HeapShared::oop_hash,
       HeapShared::oop_equals,
@@ -330,6 +345,19 @@ private:
 
   static void fixup_mapped_heap_regions() NOT_CDS_JAVA_HEAP_RETURN;
 
+  // Collectors that cannot map the archived heap regions may load them
+  // into the heap instead. The closed and open region flags above then
+  // report whether the regions were loaded. Loaded objects are ordinary
+  // heap objects, so is_archived_object() is false for them.
+  static bool can_load() NOT_CDS_JAVA_HEAP_RETURN_(false);
+  static bool is_loaded() {
+    CDS_JAVA_HEAP_ONLY(return _is_loaded;)
+    NOT_CDS_JAVA_HEAP_RETURN_(false);
+  }
+  static void add_loaded_region(address dumptime_base, size_t byte_size, address runtime_base) NOT_CDS_JAVA_HEAP_RETURN;
+  static void set_loaded() NOT_CDS_JAVA_HEAP_RETURN;
+  static void complete_loading(MemRegion loaded_space) NOT_CDS_JAVA_HEAP_RETURN;
+
   inline static bool is_archived_object(oop p) NOT_CDS_JAVA_HEAP_RETURN_(false);
 
   static void initialize_from_archived_subgraph(Klass* k, TRAPS) NOT_CDS_JAVA_HEAP_RETURN;
@@ -38,9 +38,24 @@ bool HeapShared::is_archived_object(oop p) {
   return (p == NULL) ? false : G1ArchiveAllocator::is_archived_object(p);
 }
 
+inline uintptr_t HeapShared::to_loaded_address(uintptr_t dumptime_addr) {
+  for (int i = 0; i < _num_loaded_regions; i++) {
+    const LoadedRegion& r = _loaded_regions[i];
+    if (dumptime_addr - r._dumptime_base < r._byte_size) {
+      return dumptime_addr + r._runtime_offset;
+    }
+  }
+  ShouldNotReachHere();
+  return 0;
+}
+
 inline oop HeapShared::decode_from_archive(narrowOop v) {
   assert(!CompressedOops::is_null(v), "narrow oop value can never be zero");
-  oop result = (oop)(void*)((uintptr_t)_narrow_oop_base + ((uintptr_t)v << _narrow_oop_shift));
+  uintptr_t p = (uintptr_t)_narrow_oop_base + ((uintptr_t)v << _narrow_oop_shift);
+  if (_is_loaded) {
+    p = to_loaded_address(p);
+  }
+  oop result = (oop)(void*)p;
   assert(is_object_aligned(result), "address not aligned: " INTPTR_FORMAT, p2i((void*) result));
   return result;
 }
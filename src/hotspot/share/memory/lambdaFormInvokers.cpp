@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classFileStream.hpp"
+#include "classfile/classLoadInfo.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "classfile/javaClasses.inline.hpp"
+#include "classfile/klassFactory.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "classfile/systemDictionaryShared.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "logging/log.hpp"
+#include "memory/lambdaFormInvokers.hpp"
+#include "memory/metaspaceShared.hpp"
+#include "memory/oopFactory.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/objArrayOop.inline.hpp"
+#include "oops/typeArrayOop.inline.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
+
+GrowableArray<char*>* LambdaFormInvokers::_lambdaform_lines = NULL;
+
+void LambdaFormInvokers::append(char* line) {
+  if (_lambdaform_lines == NULL) {
+    _lambdaform_lines = new (ResourceObj::C_HEAP, mtClass) GrowableArray<char*>(100, mtClass);
+  }
+  _lambdaform_lines->append(line);
+}
+
+static void log_pending_exception(Thread* thread, const char* what) {
+  oop ex = thread->pending_exception();
+  oop message = java_lang_Throwable::message(ex);
+  log_info(cds)("%s: %s: %s", what, ex->klass()->external_name(),
+                message == NULL ? "" : java_lang_String::as_utf8_string(message));
+}
+
+void LambdaFormInvokers::regenerate_holder_classes(TRAPS) {
+  assert(_lambdaform_lines != NULL, "no lines to regenerate from");
+  ResourceMark rm(THREAD);
+
+  Symbol* helper_name = vmSymbols::java_lang_invoke_GenerateJLIClassesHelper();
+  Klass* helper_klass = SystemDictionary::resolve_or_null(helper_name, THREAD);
+  if (helper_klass == NULL) {
+    CLEAR_PENDING_EXCEPTION;
+    log_info(cds)("%s not found, holder classes are not regenerated", helper_name->as_C_string());
+    return;
+  }
+
+  int len = _lambdaform_lines->length();
+  objArrayHandle list_lines = oopFactory::new_objArray_handle(SystemDictionary::String_klass(), len, CHECK);
+  for (int i = 0; i < len; i++) {
+    Handle h_line = java_lang_String::create_from_str(_lambdaform_lines->at(i), CHECK);
+    list_lines->obj_at_put(i, h_line());
+  }
+
+  // The helper returns an array of alternating class names and class file bytes.
+  JavaValue result(T_OBJECT);
+  JavaCalls::call_static(&result, helper_klass,
+                         vmSymbols::cdsGenerateHolderClasses(),
+                         vmSymbols::cdsGenerateHolderClasses_signature(),
+                         list_lines, THREAD);
+  if (HAS_PENDING_EXCEPTION) {
+    log_pending_exception(THREAD, "Failed to regenerate holder classes");
+    CLEAR_PENDING_EXCEPTION;
+    return;
+  }
+
+  objArrayHandle h_array(THREAD, (objArrayOop)result.get_jobject());
+  int sz = h_array->length();
+  assert(sz % 2 == 0, "must be pairs of names and bytes");
+  for (int i = 0; i < sz; i += 2) {
+    Handle h_name(THREAD, h_array->obj_at(i));
+    typeArrayHandle h_bytes(THREAD, (typeArrayOop)h_array->obj_at(i + 1));
+    assert(h_name.not_null() && h_bytes.not_null(), "must be");
+
+    char* class_name = java_lang_String::as_utf8_string(h_name());
+    int bytes_len = h_bytes->length();
+    // Copy the class bytes out of the Java heap, since parsing may safepoint.
+    u1* buf = NEW_RESOURCE_ARRAY_IN_THREAD(THREAD, u1, bytes_len);
+    memcpy(buf, h_bytes->byte_at_addr(0), bytes_len);
+    ClassFileStream st(buf, bytes_len, NULL, ClassFileStream::verify);
+
+    reload_class(class_name, st, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      log_pending_exception(THREAD, "Failed to reload holder class");
+      CLEAR_PENDING_EXCEPTION;
+      return;
+    }
+  }
+}
+
+// Replace the archived copy of an existing holder class with one parsed from
+// the regenerated class bytes. The old class stays in the system dictionary
+// for the rest of the dump, but is excluded from the archive.
+void LambdaFormInvokers::reload_class(char* name, ClassFileStream& st, TRAPS) {
+  Symbol* sym = SymbolTable::new_symbol((const char*)name, (int)strlen(name));
+  Klass* klass = SystemDictionary::resolve_or_null(sym, THREAD);
+  if (klass == NULL) {
+    CLEAR_PENDING_EXCEPTION;
+    log_info(cds)("Holder class %s not loaded, skipped", name);
+    return;
+  }
+  InstanceKlass* old_ik = InstanceKlass::cast(klass);
+
+  ClassLoaderData* cld = ClassLoaderData::the_null_class_loader_data();
+  Handle protection_domain;
+  ClassLoadInfo cl_info(protection_domain);
+  InstanceKlass* result = KlassFactory::create_from_stream(&st, sym, cld, cl_info, CHECK);
+  {
+    MutexLocker mu_r(THREAD, Compile_lock); // add_to_hierarchy asserts this.
+    SystemDictionary::add_to_hierarchy(result, CHECK);
+  }
+  MetaspaceShared::try_link_class(result, THREAD);
+  guarantee(!HAS_PENDING_EXCEPTION, "exception in link_class");
+
+  SystemDictionaryShared::set_excluded(old_ik);
+  log_info(cds)("Replaced holder class %s, old: " INTPTR_FORMAT " new: " INTPTR_FORMAT,
+                name, p2i(old_ik), p2i(result));
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_MEMORY_LAMBDAFORMINVOKERS_HPP
+#define SHARE_MEMORY_LAMBDAFORMINVOKERS_HPP
+
+#include "memory/allStatic.hpp"
+#include "runtime/handles.hpp"
+#include "utilities/growableArray.hpp"
+
+class ClassFileStream;
+
+// The java.lang.invoke holder classes (Invokers$Holder, DirectMethodHandle$Holder,
+// DelegatingMethodHandle$Holder and LambdaForm$Holder) contain pre-generated
+// LambdaForm methods, so that commonly used method handle shapes do not need
+// a class to be spun at runtime. The JDK build only pre-generates a fixed set.
+//
+// When -XX:DumpLoadedClassList is specified, the library logs every LambdaForm
+// it resolves or spins as an "@lambda-form-invoker" line in the classlist.
+// At static dump time, these lines are handed back to the library, which
+// regenerates the holder classes to include the shapes used by the training
+// run. The regenerated classes replace the original ones in the archive.
+class LambdaFormInvokers : public AllStatic {
+ private:
+  static GrowableArray<char*>* _lambdaform_lines;
+  static void reload_class(char* name, ClassFileStream& st, TRAPS);
+ public:
+  static const char* lambda_form_invoker_tag() {
+    return "@lambda-form-invoker";
+  }
+
+  // Takes ownership of the line, which must be C heap allocated.
+  static void append(char* line);
+  static void regenerate_holder_classes(TRAPS);
+  static GrowableArray<char*>* lambdaform_lines() {
+    return _lambdaform_lines;
+  }
+};
+
+#endif // SHARE_MEMORY_LAMBDAFORMINVOKERS_HPP
@@ -34,7 +34,10 @@
 #include "memory/metaspace/metaspaceStatistics.hpp"
 #include "memory/metaspace/occupancyMap.hpp"
 #include "memory/metaspace/virtualSpaceNode.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/ostream.hpp"
@@ -135,6 +138,7 @@ bool ChunkManager::attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex
   // Add new chunk to its freelist.
   ChunkList* const list = free_chunks(target_chunk_type);
   list->return_chunk_at_head(p_new_chunk);
+  uncommit_free_chunk(p_new_chunk);
 
   // And adjust ChunkManager:: _free_chunks_count (_free_chunks_total
   // should not have changed, because the size of the space should be the same)
@@ -160,6 +164,52 @@ bool ChunkManager::attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex
   return true;
 }
 
+bool ChunkManager::uncommittable_payload(const Metachunk* chunk, char** start, size_t* size) {
+  if (!MetaspaceUncommitFreeChunks || chunk->container()->is_pre_committed()) {
+    return false;
+  }
+  const ChunkIndex index = chunk->get_chunk_type();
+  if (index != MediumIndex && index != HumongousIndex) {
+    return false;
+  }
+  // Leave the chunk header - which for humongous chunks includes the tree node
+  // of the dictionary - committed, since it is read while the chunk is free.
+  const size_t header_bytes = sizeof(TreeChunk<Metachunk, FreeList<Metachunk> >);
+  char* const from = align_up((char*)chunk + header_bytes, os::vm_page_size());
+  char* const to = align_down((char*)chunk->end(), os::vm_page_size());
+  if (from >= to) {
+    return false;
+  }
+  *start = from;
+  *size = pointer_delta(to, from, 1);
+  return true;
+}
+
+void ChunkManager::uncommit_free_chunk(Metachunk* chunk) {
+  char* start;
+  size_t size;
+  if (uncommittable_payload(chunk, &start, &size)) {
+    // If this fails the memory just stays committed.
+    if (os::uncommit_memory(start, size)) {
+      log_trace(gc, metaspace, freelist)("%s: uncommitted " SIZE_FORMAT_HEX " bytes of free chunk at " PTR_FORMAT ".",
+        (is_class() ? "class space" : "metaspace"), size, p2i(chunk));
+    }
+  }
+}
+
+bool ChunkManager::commit_free_chunk(Metachunk* chunk) {
+  char* start;
+  size_t size;
+  if (uncommittable_payload(chunk, &start, &size)) {
+    if (!os::commit_memory(start, size, false)) {
+      log_warning(gc, metaspace, freelist)("%s: failed to commit " SIZE_FORMAT_HEX " bytes of free chunk at " PTR_FORMAT ".",
+        (is_class() ? "class space" : "metaspace"), size, p2i(chunk));
+      return false;
+    }
+  }
+  return true;
+}
+
 // Remove all chunks in the given area - the chunks are supposed to be free -
 // from their corresponding freelists. Mark them as invalid.
 // - This does not correct the occupancy map.
@@ -421,6 +471,11 @@ Metachunk* ChunkManager::free_chunks_get(size_t word_size) {
         assert(larger_chunk->word_size() > word_size, "Sanity");
         assert(larger_chunk->get_chunk_type() == larger_chunk_index, "Sanity");
 
+        // Splitting writes chunk headers all over the larger chunk.
+        if (!commit_free_chunk(larger_chunk)) {
+          return NULL;
+        }
+
         // We found a larger chunk. Lets split it up:
         // - remove old chunk
         // - in its place, create new smaller chunks, with at least one chunk
@@ -451,6 +506,10 @@ Metachunk* ChunkManager::free_chunks_get(size_t word_size) {
       return NULL;
     }
 
+    if (!commit_free_chunk(chunk)) {
+      return NULL;
+    }
+
     // Remove the chunk as the head of the list.
     free_list->remove_chunk(chunk);
 
@@ -464,6 +523,11 @@ Metachunk* ChunkManager::free_chunks_get(size_t word_size) {
       return NULL;
     }
 
+    if (!commit_free_chunk(chunk)) {
+      _humongous_dictionary.return_chunk(chunk);
+      return NULL;
+    }
+
     log_trace(gc, metaspace, alloc)("Free list allocate humongous chunk size " SIZE_FORMAT " for requested size " SIZE_FORMAT " waste " SIZE_FORMAT,
                                     chunk->word_size(), word_size, chunk->word_size() - word_size);
   }
@@ -578,7 +642,11 @@ void ChunkManager::return_single_chunk(Metachunk* chunk) {
 
   // Attempt coalesce returned chunks with its neighboring chunks:
   // if this chunk is small or special, attempt to coalesce to a medium chunk.
-  if (index == SmallIndex || index == SpecializedIndex) {
+  // Medium and humongous chunks are not merged further; give their payload
+  // back to the OS until they are handed out again.
+  if (index == MediumIndex || index == HumongousIndex) {
+    uncommit_free_chunk(chunk);
+  } else {
     if (!attempt_to_coalesce_around_chunk(chunk, MediumIndex)) {
       // This did not work. But if this chunk is special, we still may form a small chunk?
       if (index == SpecializedIndex) {
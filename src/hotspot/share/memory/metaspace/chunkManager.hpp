@@ -96,6 +96,15 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // Note that this chunk is supposed to be removed from the freelist right away.
   Metachunk* split_chunk(size_t target_chunk_word_size, Metachunk* chunk);
 
+  // Free medium and humongous chunks keep only the page holding their header
+  // committed; the rest of their payload is given back to the OS while they
+  // sit in the freelist and is committed again when they are handed out.
+  // Returns false if the chunk's payload does not span a whole page, or
+  // uncommitting is disabled for it.
+  static bool uncommittable_payload(const Metachunk* chunk, char** start, size_t* size);
+  void uncommit_free_chunk(Metachunk* chunk);
+  bool commit_free_chunk(Metachunk* chunk);
+
  public:
 
   ChunkManager(bool is_class);
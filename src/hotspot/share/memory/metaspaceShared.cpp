@@ -46,6 +46,7 @@
 #include "memory/dynamicArchive.hpp"
 #include "memory/filemap.hpp"
 #include "memory/heapShared.inline.hpp"
+#include "memory/lambdaFormInvokers.hpp"
 #include "memory/metaspace.hpp"
 #include "memory/metaspaceClosure.hpp"
 #include "memory/metaspaceShared.hpp"
@@ -56,6 +57,8 @@
 #include "oops/objArrayOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/oopHandle.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/globals_extension.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/os.hpp"
 #include "runtime/safepointVerifiers.hpp"
@@ -1079,6 +1082,14 @@ void MetaspaceShared::preload_and_dump(TRAPS) {
     }
     log_info(cds)("Loading classes to share: done.");
 
+    if (LambdaFormInvokers::lambdaform_lines() != NULL) {
+      // Regenerate the java.lang.invoke holder classes to include the LambdaForms
+      // recorded in the classlist, so they do not need to be spun at runtime.
+      log_info(cds)("Regenerating LambdaForm holder classes ...");
+      LambdaFormInvokers::regenerate_holder_classes(THREAD);
+      log_info(cds)("Regenerating LambdaForm holder classes: done.");
+    }
+
     log_info(cds)("Shared spaces: preloaded %d classes", class_count);
 
     if (SharedArchiveConfigFile) {
@@ -1302,6 +1313,9 @@ void MetaspaceShared::initialize_runtime_shared_and_meta_spaces() {
       FileMapInfo::set_shared_path_table(dynamic_mapinfo);
     } else {
       FileMapInfo::set_shared_path_table(static_mapinfo);
+      if (AutoCreateSharedArchive) {
+        enable_auto_dynamic_dumping(static_mapinfo);
+      }
     }
     _requested_base_address = static_mapinfo->requested_base_address();
   } else {
@@ -1321,6 +1335,26 @@ void MetaspaceShared::initialize_runtime_shared_and_meta_spaces() {
   }
 }
 
+// -XX:+AutoCreateSharedArchive: the dynamic archive named by SharedArchiveFile does
+// not exist yet, or it cannot be used with this JVM or class path. Record a new one
+// at exit, the same way as -XX:ArchiveClassesAtExit would.
+void MetaspaceShared::enable_auto_dynamic_dumping(FileMapInfo* static_mapinfo) {
+  // Same restrictions as checked in Arguments and FileMapInfo::validate_shared_path_table()
+  // when dynamic dumping is requested on the command line.
+  if (!BytecodeVerificationRemote) {
+    log_info(cds)("Not creating %s: remote bytecode verification is disabled", SharedArchiveFile);
+    return;
+  }
+  if (static_mapinfo->app_class_paths_start_index() > 1 || static_mapinfo->num_module_paths() > 0) {
+    log_info(cds)("Not creating %s: the base archive has an appended boot class path or a module path",
+                  SharedArchiveFile);
+    return;
+  }
+  Arguments::set_shared_dynamic_archive_path(SharedArchiveFile);
+  FLAG_SET_ERGO(DynamicDumpSharedSpaces, true);
+  log_info(cds)("Dynamic archive %s will be created at exit", SharedArchiveFile);
+}
+
 FileMapInfo* MetaspaceShared::open_static_archive() {
   FileMapInfo* mapinfo = new FileMapInfo(true);
   if (!mapinfo->initialize()) {
@@ -1628,6 +1662,14 @@ char* MetaspaceShared::reserve_address_space_for_archives(FileMapInfo* static_ma
     // Reserve at the given archive base address, or not at all.
     total_rs = ReservedSpace(total_range_size, archive_space_alignment,
                              false /* bool large */, (char*) base_address);
+    if (!total_rs.is_reserved()) {
+      // Some other mapping (often placed there by ASLR) overlaps the range. Relocating
+      // the archive dirties every page holding a pointer, which defeats sharing those
+      // pages between JVMs, so first try to keep the archive at its requested address
+      // and move the class space further up within the narrow Klass encoding range.
+      return reserve_archive_and_split_class_space(base_address, ccs_begin_offset,
+                                                   archive_space_rs, class_space_rs);
+    }
   } else {
     // Reserve at any address, but leave it up to the platform to choose a good one.
     total_rs = Metaspace::reserve_address_space_for_compressed_classes(total_range_size);
@@ -1669,6 +1711,52 @@ char* MetaspaceShared::reserve_address_space_for_archives(FileMapInfo* static_ma
 
 }
 
+#ifdef _LP64
+// Reserve [base_address, base_address + archive_space_size) for the archives and put
+// the class space at the lowest free, suitably aligned, address above it such that
+// both spaces remain within the 4G encoding range CompressedKlassPointers::initialize()
+// uses when CDS is enabled. Returns NULL if either space cannot be reserved.
+char* MetaspaceShared::reserve_archive_and_split_class_space(address base_address,
+                                                             size_t archive_space_size,
+                                                             ReservedSpace& archive_space_rs,
+                                                             ReservedSpace& class_space_rs) {
+  const size_t archive_space_alignment = MetaspaceShared::reserved_space_alignment();
+  const size_t class_space_alignment = Metaspace::reserve_alignment();
+  const size_t class_space_size = CompressedClassSpaceSize;
+  const size_t encoding_range = 4 * G;
+
+  if (archive_space_size + class_space_size > encoding_range) {
+    return NULL;
+  }
+  ReservedSpace rs(archive_space_size, archive_space_alignment,
+                   false /* bool large */, (char*)base_address);
+  if (!rs.is_reserved()) {
+    log_debug(cds)("Archive space at " PTR_FORMAT " is not available", p2i(base_address));
+    return NULL;
+  }
+
+  // A handful of probes is enough; each one skips a quarter of the class space.
+  const size_t stride = align_up(MAX2(class_space_size / 4, class_space_alignment), class_space_alignment);
+  for (size_t offset = archive_space_size; offset + class_space_size <= encoding_range; offset += stride) {
+    ReservedSpace ccs(class_space_size, class_space_alignment,
+                      false /* bool large */, (char*)base_address + offset);
+    if (ccs.is_reserved()) {
+      log_info(cds)("Reserved class space at " PTR_FORMAT " to keep the archive at its requested address",
+                    p2i(ccs.base()));
+      archive_space_rs = rs;
+      class_space_rs = ccs;
+      MemTracker::record_virtual_memory_type(archive_space_rs.base(), mtClassShared);
+      MemTracker::record_virtual_memory_type(class_space_rs.base(), mtClass);
+      return archive_space_rs.base();
+    }
+  }
+
+  log_debug(cds)("No class space available within the encoding range of " PTR_FORMAT, p2i(base_address));
+  rs.release();
+  return NULL;
+}
+#endif // _LP64
+
 void MetaspaceShared::release_reserved_spaces(ReservedSpace& archive_space_rs,
                                               ReservedSpace& class_space_rs) {
   if (archive_space_rs.is_reserved()) {
@@ -1818,7 +1906,8 @@ intx MetaspaceShared::final_delta() {
 
 bool MetaspaceShared::use_full_module_graph() {
   bool result = _use_optimized_module_handling && _use_full_module_graph &&
-    (UseSharedSpaces || DumpSharedSpaces) && HeapShared::is_heap_object_archiving_allowed();
+    (UseSharedSpaces || DumpSharedSpaces) &&
+    (HeapShared::is_heap_object_archiving_allowed() || HeapShared::is_loaded());
   if (result && UseSharedSpaces) {
     // Classes used by the archived full module graph are loaded in JVMTI early phase.
     assert(!(JvmtiExport::should_post_class_file_load_hook() && JvmtiExport::has_early_class_hook_env()),
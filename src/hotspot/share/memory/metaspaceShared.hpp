@@ -282,6 +282,7 @@ private:
   static void read_extra_data(const char* filename, TRAPS) NOT_CDS_RETURN;
   static FileMapInfo* open_static_archive();
   static FileMapInfo* open_dynamic_archive();
+  static void enable_auto_dynamic_dumping(FileMapInfo* static_mapinfo);
   // use_requested_addr: If true (default), attempt to map at the address the
   static MapArchiveResult map_archives(FileMapInfo* static_mapinfo, FileMapInfo* dynamic_mapinfo,
                                        bool use_requested_addr);
@@ -290,6 +291,12 @@ private:
                                                   bool use_archive_base_addr,
                                                   ReservedSpace& archive_space_rs,
                                                   ReservedSpace& class_space_rs);
+#ifdef _LP64
+  static char* reserve_archive_and_split_class_space(address base_address,
+                                                     size_t archive_space_size,
+                                                     ReservedSpace& archive_space_rs,
+                                                     ReservedSpace& class_space_rs);
+#endif
   static void release_reserved_spaces(ReservedSpace& archive_space_rs,
                                       ReservedSpace& class_space_rs);
   static MapArchiveResult map_archive(FileMapInfo* mapinfo, char* mapped_base_address, ReservedSpace rs);
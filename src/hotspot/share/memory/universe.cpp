@@ -26,6 +26,7 @@
 #include "aot/aotLoader.hpp"
 #include "classfile/classLoader.hpp"
 #include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/hotFieldTable.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
@@ -434,7 +435,7 @@ void Universe::initialize_basic_type_mirrors(TRAPS) {
     if (UseSharedSpaces &&
         HeapShared::open_archive_heap_region_mapped() &&
         _mirrors[T_INT].resolve() != NULL) {
-      assert(HeapShared::is_heap_object_archiving_allowed(), "Sanity");
+      assert(HeapShared::is_heap_object_archiving_allowed() || HeapShared::is_loaded(), "Sanity");
 
       // check that all mirrors are mapped also
       for (int i = T_BOOLEAN; i < T_VOID+1; i++) {
@@ -785,6 +786,8 @@ jint universe_init() {
     StringTable::create_table();
   }
 
+  HotFieldTable::initialize();
+
 #if INCLUDE_CDS
   if (Arguments::is_dumping_archive()) {
     MetaspaceShared::prepare_for_dumping();
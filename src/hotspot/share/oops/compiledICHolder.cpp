@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "memory/iterator.hpp"
 #include "oops/compiledICHolder.hpp"
 #include "runtime/atomic.hpp"
 
@@ -31,19 +32,46 @@ volatile int CompiledICHolder::_live_not_claimed_count;
 
 
 CompiledICHolder::CompiledICHolder(Metadata* metadata, Klass* klass, bool is_method)
-  : _holder_metadata(metadata), _holder_klass(klass), _is_metadata_method(is_method) {
+  : _holder_metadata(metadata), _holder_klass(klass), _is_metadata_method(is_method),
+    _pic_length(0), _pic_entries(NULL) {
 #ifdef ASSERT
   Atomic::inc(&_live_count);
   Atomic::inc(&_live_not_claimed_count);
 #endif // ASSERT
 }
 
+CompiledICHolder::CompiledICHolder(Klass* interface_klass, Klass* resolved_klass,
+                                   const PICEntry* entries, int length)
+  : _holder_metadata(interface_klass), _holder_klass(resolved_klass), _is_metadata_method(false),
+    _pic_length(length), _pic_entries(NEW_C_HEAP_ARRAY(PICEntry, length, mtCompiler)) {
+  assert(length > 0 && length <= max_pic_length, "invalid polymorphic inline cache length");
+  for (int i = 0; i < length; i++) {
+    _pic_entries[i] = entries[i];
+  }
 #ifdef ASSERT
+  Atomic::inc(&_live_count);
+  Atomic::inc(&_live_not_claimed_count);
+#endif // ASSERT
+}
+
 CompiledICHolder::~CompiledICHolder() {
+  if (_pic_entries != NULL) {
+    FREE_C_HEAP_ARRAY(PICEntry, _pic_entries);
+  }
+#ifdef ASSERT
   assert(_live_count > 0, "underflow");
   Atomic::dec(&_live_count);
-}
 #endif // ASSERT
+}
+
+void CompiledICHolder::metadata_do(MetadataClosure* f) {
+  f->do_metadata(holder_metadata());
+  f->do_metadata(holder_klass());
+  for (int i = 0; i < _pic_length; i++) {
+    f->do_metadata(_pic_entries[i]._klass);
+    f->do_metadata(_pic_entries[i]._method);
+  }
+}
 
 // Printing
 
@@ -51,6 +79,13 @@ void CompiledICHolder::print_on(outputStream* st) const {
   st->print("%s", internal_name());
   st->print(" - metadata: "); holder_metadata()->print_value_on(st); st->cr();
   st->print(" - klass:    "); holder_klass()->print_value_on(st); st->cr();
+  for (int i = 0; i < _pic_length; i++) {
+    st->print(" - entry %d:  ", i);
+    _pic_entries[i]._klass->print_value_on(st);
+    st->print(" -> ");
+    _pic_entries[i]._method->print_value_on(st);
+    st->cr();
+  }
 }
 
 void CompiledICHolder::print_value_on(outputStream* st) const {
@@ -63,6 +98,10 @@ void CompiledICHolder::print_value_on(outputStream* st) const {
 void CompiledICHolder::verify_on(outputStream* st) {
   guarantee(holder_metadata()->is_method() || holder_metadata()->is_klass(), "should be method or klass");
   guarantee(holder_klass()->is_klass(),   "should be klass");
+  for (int i = 0; i < _pic_length; i++) {
+    guarantee(_pic_entries[i]._klass->is_klass(),   "should be klass");
+    guarantee(_pic_entries[i]._method->is_method(), "should be method");
+  }
 }
 
 #ifdef ASSERT
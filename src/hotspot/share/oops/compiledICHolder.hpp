@@ -34,6 +34,9 @@
 // It holds:
 //   (1) (method+klass pair) when converting from compiled to an interpreted call
 //   (2) (klass+klass pair) when calling itable stub from megamorphic compiled call
+//   (3) (klass+klass pair) plus a short array of (receiver klass+method) entries
+//       when calling the polymorphic inline cache stub from a polymorphic
+//       interface call
 //
 // These are always allocated in the C heap and are freed during a
 // safepoint by the ICBuffer logic.  It's unsafe to free them earlier
@@ -43,6 +46,18 @@
 
 class CompiledICHolder : public CHeapObj<mtCompiler> {
   friend class VMStructs;
+ public:
+  // A receiver klass and the method selected for it at a polymorphic call site.
+  struct PICEntry {
+    Klass*  _klass;
+    Method* _method;
+
+    static int klass_offset()  { return offset_of(PICEntry, _klass); }
+    static int method_offset() { return offset_of(PICEntry, _method); }
+  };
+
+  enum { max_pic_length = 16 };
+
  private:
   static volatile int _live_count; // allocated
   static volatile int _live_not_claimed_count; // allocated but not yet in use so not
@@ -52,11 +67,14 @@ class CompiledICHolder : public CHeapObj<mtCompiler> {
   Klass*    _holder_klass;    // to avoid name conflict with oopDesc::_klass
   CompiledICHolder* _next;
   bool _is_metadata_method;
+  int       _pic_length;      // number of polymorphic entries, 0 if not polymorphic
+  PICEntry* _pic_entries;
 
  public:
   // Constructor
   CompiledICHolder(Metadata* metadata, Klass* klass, bool is_method = true);
-  ~CompiledICHolder() NOT_DEBUG_RETURN;
+  CompiledICHolder(Klass* interface_klass, Klass* resolved_klass, const PICEntry* entries, int length);
+  ~CompiledICHolder();
 
   static int live_count() { return _live_count; }
   static int live_not_claimed_count() { return _live_not_claimed_count; }
@@ -68,6 +86,16 @@ class CompiledICHolder : public CHeapObj<mtCompiler> {
   static int holder_metadata_offset() { return offset_of(CompiledICHolder, _holder_metadata); }
   static int holder_klass_offset()    { return offset_of(CompiledICHolder, _holder_klass); }
 
+  bool      is_polymorphic() const    { return _pic_length > 0; }
+  int       pic_length() const        { return _pic_length; }
+  const PICEntry& pic_entry_at(int i) const {
+    assert(i >= 0 && i < _pic_length, "index out of bounds");
+    return _pic_entries[i];
+  }
+
+  static int pic_length_offset()      { return offset_of(CompiledICHolder, _pic_length); }
+  static int pic_entries_offset()     { return offset_of(CompiledICHolder, _pic_entries); }
+
   CompiledICHolder* next()     { return _next; }
   void set_next(CompiledICHolder* n) { _next = n; }
 
@@ -79,9 +107,18 @@ class CompiledICHolder : public CHeapObj<mtCompiler> {
     if (!_holder_klass->is_loader_alive()) {
       return false;
     }
+    for (int i = 0; i < _pic_length; i++) {
+      if (!_pic_entries[i]._klass->is_loader_alive() ||
+          !_pic_entries[i]._method->method_holder()->is_loader_alive()) {
+        return false;
+      }
+    }
     return true;
   }
 
+  // Apply f to all metadata referenced by this holder
+  void metadata_do(MetadataClosure* f);
+
   // Verify
   void verify_on(outputStream* st);
 
@@ -76,6 +76,14 @@ void ConstantPoolCacheEntry::reinitialize(bool f2_used) {
   }
 }
 
+void ConstantPoolCacheEntry::metaspace_pointers_do(MetaspaceClosure* it) {
+  // Only field entries kept by ConstantPoolCache::can_archive_resolved_entry()
+  // carry a metadata pointer into the archive; it's the field holder.
+  if (is_field_entry() && !is_f1_null()) {
+    it->push((Klass**)&_f1);
+  }
+}
+
 int ConstantPoolCacheEntry::make_flags(TosState state,
                                        int option_bits,
                                        int field_index_or_method_params) {
@@ -719,6 +727,8 @@ void ConstantPoolCache::walk_entries_for_initialization(bool check_only) {
   //
   // - We keep the ConstantPoolCache::constant_pool_index() bits for all entries.
   // - We keep the "f2" field for entries used by invokedynamic and invokehandle
+  // - We keep resolved entries that are safe to reuse at runtime, see
+  //   can_archive_resolved_entry().
   // - All other bits in the entries are cleared to zero.
   ResourceMark rm;
 
@@ -758,9 +768,75 @@ void ConstantPoolCache::walk_entries_for_initialization(bool check_only) {
         entry_at(i)->verify_just_initialized(f2_used[i]);
       })
   } else {
+    int archived = 0;
     for (int i=0; i<length(); i++) {
-      entry_at(i)->reinitialize(f2_used[i]);
+      if (!f2_used[i] && can_archive_resolved_entry(i)) {
+        archived++;
+      } else {
+        entry_at(i)->reinitialize(f2_used[i]);
+      }
+    }
+    if (archived > 0) {
+      log_trace(cds)("Archived %d resolved cpCache entries of %s", archived, ik->external_name());
+    }
+  }
+}
+
+// Is k a class that the accessor can reach at runtime without any resolution
+// side effect (class loading, initialization, loader constraints, access checks)?
+// This holds for the accessor itself and its superclasses, as long as they
+// are defined by the same loader into the same module: they are loaded before
+// the accessor and resolve to the same archived classes.
+static bool is_archivable_reference(InstanceKlass* accessor, Klass* k) {
+  return k != NULL &&
+         accessor->is_subclass_of(k) &&
+         k->class_loader_data() == accessor->class_loader_data() &&
+         k->is_instance_klass() &&
+         InstanceKlass::cast(k)->module() == accessor->module();
+}
+
+// Only called for the static archive, on the source classes: the referenced
+// metadata must still be live and the entry must not depend on anything that
+// is done lazily at runtime. Entries resolved for getstatic/putstatic and
+// invokestatic require class initialization barriers, invokespecial,
+// invokeinterface and vfinal invokevirtual entries keep Method* pointers,
+// and invokedynamic/invokehandle entries refer to heap objects, so all of
+// these are re-resolved at runtime as before.
+bool ConstantPoolCache::can_archive_resolved_entry(int i) {
+  if (!DumpSharedSpaces || !ArchiveResolvedConstantPoolEntries) {
+    return false;
+  }
+  ConstantPoolCacheEntry* e = entry_at(i);
+  Bytecodes::Code b1 = e->bytecode_1();
+  Bytecodes::Code b2 = e->bytecode_2();
+  if (b1 == 0 && b2 == 0) {
+    return false; // not resolved
+  }
+  InstanceKlass* accessor = constant_pool()->pool_holder();
+  if (e->is_field_entry()) {
+    if ((b1 != 0 && b1 != Bytecodes::_getfield) ||
+        (b2 != 0 && b2 != Bytecodes::_putfield)) {
+      return false;
+    }
+    return is_archivable_reference(accessor, e->f1_as_klass());
+  } else {
+    if (b1 != 0 || b2 != Bytecodes::_invokevirtual ||
+        e->is_vfinal() || !e->is_f1_null() || e->has_appendix()) {
+      return false;
+    }
+    // The entry only holds the vtable index. Find the referenced class in the
+    // accessor's hierarchy and check the selected method from there.
+    Symbol* klass_name = constant_pool()->uncached_klass_ref_at_noresolve(e->constant_pool_index());
+    for (Klass* k = accessor; k != NULL; k = k->super()) {
+      if (k->name() == klass_name) {
+        if (!is_archivable_reference(accessor, k)) {
+          return false;
+        }
+        Method* m = k->method_at_vtable(e->f2_as_index());
+        return m != NULL && is_archivable_reference(accessor, m->method_holder());
+      }
     }
+    return false;
   }
 }
 
@@ -835,6 +911,13 @@ void ConstantPoolCache::metaspace_pointers_do(MetaspaceClosure* it) {
   log_trace(cds)("Iter(ConstantPoolCache): %p", this);
   it->push(&_constant_pool);
   it->push(&_reference_map);
+  if (DumpSharedSpaces) {
+    for (int i = 0; i < length(); i++) {
+      if (can_archive_resolved_entry(i)) {
+        entry_at(i)->metaspace_pointers_do(it);
+      }
+    }
+  }
 }
 
 // Printing
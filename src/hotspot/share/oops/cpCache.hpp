@@ -392,6 +392,7 @@ class ConstantPoolCacheEntry {
 
   void verify_just_initialized(bool f2_used);
   void reinitialize(bool f2_used);
+  void metaspace_pointers_do(MetaspaceClosure* it);
 };
 
 
@@ -458,6 +459,7 @@ class ConstantPoolCache: public MetaspaceObj {
   void verify_just_initialized();
  private:
   void walk_entries_for_initialization(bool check_only);
+  bool can_archive_resolved_entry(int i);
   void set_length(int length)                    { _length = length; }
 
   static int header_size()                       { return sizeof(ConstantPoolCache) / wordSize; }
@@ -1509,15 +1509,18 @@ void InstanceKlass::mask_for(const methodHandle& method, int bci,
   // Lock-free access requires load_acquire.
   OopMapCache* oop_map_cache = Atomic::load_acquire(&_oop_map_cache);
   if (oop_map_cache == NULL) {
-    MutexLocker x(OopMapCacheAlloc_lock);
-    // Check if _oop_map_cache was allocated while we were waiting for this lock
-    if ((oop_map_cache = _oop_map_cache) == NULL) {
-      oop_map_cache = new OopMapCache();
-      // Ensure _oop_map_cache is stable, since it is examined without a lock
-      Atomic::release_store(&_oop_map_cache, oop_map_cache);
+    // Install a new cache unless another thread got there first. Lookups
+    // come from GC workers at a safepoint and from Java threads, some of
+    // which may not block, so a lock is not used.
+    OopMapCache* new_cache = new OopMapCache();
+    oop_map_cache = Atomic::cmpxchg(&_oop_map_cache, (OopMapCache*)NULL, new_cache);
+    if (oop_map_cache == NULL) {
+      oop_map_cache = new_cache;
+    } else {
+      delete new_cache;
     }
   }
-  // _oop_map_cache is constant after init; lookup below does its own locking.
+  // _oop_map_cache is constant after init; lookup below is lock-free.
   oop_map_cache->lookup(method, bci, entry_for);
 }
 
@@ -49,7 +49,9 @@
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/population_count.hpp"
 #include "utilities/powerOfTwo.hpp"
+#include "utilities/quickSort.hpp"
 #include "utilities/stack.inline.hpp"
 
 void Klass::set_java_mirror(Handle m) {
@@ -85,6 +87,7 @@ void Klass::set_is_cloneable() {
 void Klass::set_name(Symbol* n) {
   _name = n;
   if (_name != NULL) _name->increment_refcount();
+  _hash_slot = compute_hash_slot(n);
 
   if (Arguments::is_dumping_archive() && is_instance_klass()) {
     SystemDictionaryShared::init_dumptime_info(InstanceKlass::cast(this));
@@ -115,6 +118,15 @@ bool Klass::search_secondary_supers(Klass* k) const {
   // This is necessary, since I am never in my own secondary_super list.
   if (this == k)
     return true;
+  // The hashed table answers without a linear scan. A hit still updates
+  // the cache, which the compiled fast paths check first.
+  if (UseSecondarySupersTable && _secondary_supers_bitmap != SECONDARY_SUPERS_BITMAP_FULL) {
+    if (lookup_secondary_supers_table(k)) {
+      ((Klass*)this)->set_secondary_super_cache(k);
+      return true;
+    }
+    return false;
+  }
   // Scan the array-of-objects for a match
   int cnt = secondary_supers()->length();
   for (int i = 0; i < cnt; i++) {
@@ -126,6 +138,86 @@ bool Klass::search_secondary_supers(Klass* k) const {
   return false;
 }
 
+// The secondary supers of a hashed klass are ordered by hash slot, and the
+// bitmap has a bit set for each occupied slot. A clear bit is a definite miss.
+// Otherwise the entries in lower slots number at least the population count
+// of the lower bits, so the scan for k starts there and ends at the first
+// entry in a higher slot. Without collisions that is a single probe.
+bool Klass::lookup_secondary_supers_table(Klass* k) const {
+  uintx bitmap = _secondary_supers_bitmap;
+  assert(bitmap != SECONDARY_SUPERS_BITMAP_FULL, "not hashed");
+  int slot = k->hash_slot();
+  if ((bitmap & ((uintx)1 << slot)) == 0) {
+    return false;
+  }
+  int cnt = secondary_supers()->length();
+  for (int i = population_count(bitmap & (((uintx)1 << slot) - 1)); i < cnt; i++) {
+    Klass* s = secondary_supers()->at(i);
+    if (s == k) {
+      return true;
+    }
+    if (s->hash_slot() > slot) {
+      break;
+    }
+  }
+  return false;
+}
+
+uint8_t Klass::compute_hash_slot(Symbol* n) {
+  // Derived from the name bytes rather than the Symbol address, so that the
+  // order of archived secondary supers stays valid.
+  juint hash = 0;
+  if (n != NULL) {
+    for (int i = 0; i < n->utf8_length(); i++) {
+      hash = 31 * hash + (juint)(u1)n->char_at(i);
+    }
+  }
+  // Fibonacci hashing: the top bits of the product are the best mixed.
+  uint8_t slot = (uint8_t)((hash * 0x9E3779B9u) >> (32 - LogBitsPerWord));
+  assert(slot < SECONDARY_SUPERS_TABLE_SIZE, "out of range");
+  return slot;
+}
+
+static int compare_hash_slot(Klass* a, Klass* b) {
+  return (int)a->hash_slot() - (int)b->hash_slot();
+}
+
+// Order the secondary supers by hash slot and install them together with the
+// bitmap of occupied slots. An array that is shared with other metadata (the
+// transitive interfaces) is copied rather than reordered.
+void Klass::hash_secondary_supers(Array<Klass*>* secondaries, bool is_owned, TRAPS) {
+  int length = secondaries->length();
+  uintx bitmap = SECONDARY_SUPERS_BITMAP_EMPTY;
+  bool sorted = true;
+  for (int i = 0; i < length; i++) {
+    Klass* k = secondaries->at(i);
+    if (k == NULL) {
+      // Bootstrapping placeholder, keep the linear scan.
+      set_secondary_supers(secondaries);
+      _secondary_supers_bitmap = SECONDARY_SUPERS_BITMAP_FULL;
+      return;
+    }
+    if (i > 0 && secondaries->at(i - 1)->hash_slot() > k->hash_slot()) {
+      sorted = false;
+    }
+    bitmap |= (uintx)1 << k->hash_slot();
+  }
+
+  if (!sorted) {
+    if (!is_owned) {
+      Array<Klass*>* copy = MetadataFactory::new_array<Klass*>(class_loader_data(), length, CHECK);
+      for (int i = 0; i < length; i++) {
+        copy->at_put(i, secondaries->at(i));
+      }
+      secondaries = copy;
+    }
+    QuickSort::sort(secondaries->data(), length, compare_hash_slot, false);
+  }
+
+  set_secondary_supers(secondaries);
+  _secondary_supers_bitmap = bitmap;
+}
+
 // Return self, except for abstract classes with exactly 1
 // implementor.  Then return the 1 concrete implementation.
 Klass *Klass::up_cast_abstract() {
@@ -207,6 +299,7 @@ Klass::Klass(KlassID id) : _id(id),
   CDS_JAVA_HEAP_ONLY(_archived_mirror = 0;)
   _primary_supers[0] = this;
   set_super_check_offset(in_bytes(primary_supers_offset()));
+  _secondary_supers_bitmap = SECONDARY_SUPERS_BITMAP_FULL;
 }
 
 jint Klass::array_layout_helper(BasicType etype) {
@@ -303,7 +396,11 @@ void Klass::initialize_supers(Klass* k, Array<InstanceKlass*>* transitive_interf
     // Compute the "real" non-extra secondaries.
     GrowableArray<Klass*>* secondaries = compute_secondary_supers(extras, transitive_interfaces);
     if (secondaries == NULL) {
-      // secondary_supers set by compute_secondary_supers
+      // secondary_supers set by compute_secondary_supers, possibly to an
+      // array shared with other klasses
+      if (secondary_supers() != Universe::the_array_interfaces_array()) {
+        hash_secondary_supers(secondary_supers(), false, CHECK);
+      }
       return;
     }
 
@@ -347,7 +444,7 @@ void Klass::initialize_supers(Klass* k, Array<InstanceKlass*>* transitive_interf
     }
   #endif
 
-    set_secondary_supers(s2);
+    hash_secondary_supers(s2, true, CHECK);
   }
 }
 
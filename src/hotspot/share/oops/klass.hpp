@@ -128,6 +128,9 @@ class Klass : public Metadata {
   // secondary supers, else is &_primary_supers[depth()].
   juint       _super_check_offset;
 
+  // Slot of this klass in the hashed secondary supers tables of its subtypes.
+  uint8_t     _hash_slot;
+
   // Class name.  Instance classes: java/lang/String, etc.  Array classes: [I,
   // [Ljava/lang/String;, etc.  Set to zero for all other kinds of classes.
   Symbol*     _name;
@@ -136,6 +139,9 @@ class Klass : public Metadata {
   Klass*      _secondary_super_cache;
   // Array of all secondary supertypes
   Array<Klass*>* _secondary_supers;
+  // Bitmap of the hash slots occupied in _secondary_supers, or
+  // SECONDARY_SUPERS_BITMAP_FULL if _secondary_supers is not ordered by hash slot
+  uintx       _secondary_supers_bitmap;
   // Ordered list of all primary supertypes
   Klass*      _primary_supers[_primary_super_limit];
   // java/lang/Class instance mirroring this class
@@ -228,6 +234,15 @@ protected:
   Array<Klass*>* secondary_supers() const { return _secondary_supers; }
   void set_secondary_supers(Array<Klass*>* k) { _secondary_supers = k; }
 
+  // Hashed secondary supers table, see lookup_secondary_supers_table()
+  static const int   SECONDARY_SUPERS_TABLE_SIZE   = sizeof(uintx) * BitsPerByte;
+  static const int   SECONDARY_SUPERS_TABLE_MASK   = SECONDARY_SUPERS_TABLE_SIZE - 1;
+  static const uintx SECONDARY_SUPERS_BITMAP_EMPTY = 0;
+  static const uintx SECONDARY_SUPERS_BITMAP_FULL  = ~(uintx)0;
+
+  uint8_t hash_slot() const               { return _hash_slot; }
+  uintx secondary_supers_bitmap() const   { return _secondary_supers_bitmap; }
+
   // Return the element of the _super chain of the given depth.
   // If there is no such element, return either NULL or this.
   Klass* primary_super_of_depth(juint i) const {
@@ -345,6 +360,8 @@ protected:
   static ByteSize primary_supers_offset()        { return in_ByteSize(offset_of(Klass, _primary_supers)); }
   static ByteSize secondary_super_cache_offset() { return in_ByteSize(offset_of(Klass, _secondary_super_cache)); }
   static ByteSize secondary_supers_offset()      { return in_ByteSize(offset_of(Klass, _secondary_supers)); }
+  static ByteSize secondary_supers_bitmap_offset() { return in_ByteSize(offset_of(Klass, _secondary_supers_bitmap)); }
+  static ByteSize hash_slot_offset()             { return in_ByteSize(offset_of(Klass, _hash_slot)); }
   static ByteSize java_mirror_offset()           { return in_ByteSize(offset_of(Klass, _java_mirror)); }
   static ByteSize class_loader_data_offset()     { return in_ByteSize(offset_of(Klass, _class_loader_data)); }
   static ByteSize modifier_flags_offset()        { return in_ByteSize(offset_of(Klass, _modifier_flags)); }
@@ -464,6 +481,13 @@ protected:
   }
 
   bool search_secondary_supers(Klass* k) const;
+  bool lookup_secondary_supers_table(Klass* k) const;
+
+ private:
+  static uint8_t compute_hash_slot(Symbol* n);
+  void hash_secondary_supers(Array<Klass*>* secondaries, bool is_owned, TRAPS);
+
+ public:
 
   // Find LCA in class hierarchy
   Klass *LCA( Klass *k );
@@ -1198,6 +1198,26 @@ int klassItable::method_count_for_interface(InstanceKlass* interf) {
 }
 
 
+// Returns the itable method entries of the super class for interf, or NULL
+// if the super class does not implement interf or its itable is not set up.
+static itableMethodEntry* super_itable_entries_for(InstanceKlass* klass, InstanceKlass* interf) {
+  InstanceKlass* super = klass->java_super();
+  if (super == NULL || super->itable_length() <= itableOffsetEntry::size()) {
+    return NULL;
+  }
+  klassItable super_itable(super);
+  for (int i = 0; i < super_itable.size_offset_table(); i++) {
+    itableOffsetEntry* ioe = super_itable.offset_entry(i);
+    if (ioe->interface_klass() == NULL) {
+      break;
+    }
+    if (ioe->interface_klass() == interf) {
+      return ioe->first_method_entry(super);
+    }
+  }
+  return NULL;
+}
+
 void klassItable::initialize_itable_for_interface(int method_table_offset, InstanceKlass* interf, bool checkconstraints, TRAPS) {
   assert(interf->is_interface(), "must be");
   Array<Method*>* methods = interf->methods();
@@ -1206,9 +1226,26 @@ void klassItable::initialize_itable_for_interface(int method_table_offset, Insta
   Handle interface_loader (THREAD, interf->class_loader());
 
   int ime_count = method_count_for_interface(interf);
+  itableMethodEntry* super_entries = super_itable_entries_for(_klass, interf);
   for (int i = 0; i < nof_methods; i++) {
     Method* m = methods->at(i);
     Method* target = NULL;
+    if (m->has_itable_index() && super_entries != NULL) {
+      // If the super class selected a class method for this entry and this
+      // class declares no method with that name and signature, the selection
+      // search below finds the same method. Its loader constraints were
+      // checked when the super class was linked, so take it as is. This keeps
+      // linking of deep hierarchies with many interfaces cheap.
+      Method* inherited = super_entries[m->itable_index()].method();
+      if (inherited != NULL &&
+          inherited != Universe::throw_illegal_access_error() &&
+          !inherited->method_holder()->is_interface() &&
+          _klass->find_method(m->name(), m->signature()) == NULL) {
+        assert(m->itable_index() < ime_count, "oob");
+        itableOffsetEntry::method_entry(_klass, method_table_offset)[m->itable_index()].initialize(inherited);
+        continue;
+      }
+    }
     if (m->has_itable_index()) {
       // This search must match the runtime resolution, i.e. selection search for invokeinterface
       // to correctly enforce loader constraints for interface method inheritance.
@@ -39,6 +39,8 @@ void markWord::print_on(outputStream* st) const {
     } else {
       mon->print_on(st);
     }
+  } else if (is_fast_locked()) {  // last bits = 00, header in place
+    st->print(" fast-locked(" INTPTR_FORMAT ")", value());
   } else if (is_locked()) {  // last bits != 01 => 00
     // thin locked
     st->print(" locked(" INTPTR_FORMAT ")", value());
@@ -90,6 +90,13 @@
 //  - INFLATING() is a distinguished markword value of all zeros that is
 //    used when inflating an existing stack-lock into an ObjectMonitor.
 //    See below for is_being_inflated() and INFLATING().
+//
+//  - With UseLightweightLocking the locked state keeps the header in place
+//    and the owner is found on the owning thread's lock stack instead:
+//
+//    [header      | 0 | 00]  fast-locked        header stays in the object
+//
+//    There is no displaced header and no inflating state in this mode.
 
 class BasicLock;
 class ObjectMonitor;
@@ -227,7 +234,7 @@ class markWord {
 
   // Special temporary state of the markWord while being inflated.
   // Code that looks at mark outside a lock need to take this into account.
-  bool is_being_inflated() const { return (value() == 0); }
+  bool is_being_inflated() const { return !UseLightweightLocking && (value() == 0); }
 
   // Distinguished markword value - used when inflating over
   // an existing stack-lock.  0 indicates the markword is "BUSY".
@@ -268,7 +275,7 @@ class markWord {
     return markWord(value() | unlocked_value);
   }
   bool has_locker() const {
-    return ((value() & lock_mask_in_place) == locked_value);
+    return !UseLightweightLocking && ((value() & lock_mask_in_place) == locked_value);
   }
   BasicLock* locker() const {
     assert(has_locker(), "check");
@@ -277,12 +284,21 @@ class markWord {
   bool has_monitor() const {
     return ((value() & monitor_value) != 0);
   }
+  bool is_fast_locked() const {
+    return UseLightweightLocking && ((value() & lock_mask_in_place) == locked_value);
+  }
+  markWord set_fast_locked() const {
+    return markWord(value() & ~lock_mask_in_place);
+  }
   ObjectMonitor* monitor() const {
     assert(has_monitor(), "check");
     // Use xor instead of &~ to provide one extra tag-bit check.
     return (ObjectMonitor*) (value() ^ monitor_value);
   }
   bool has_displaced_mark_helper() const {
+    if (UseLightweightLocking) {
+      return ((value() & lock_mask_in_place) == monitor_value);
+    }
     return ((value() & unlocked_value) == 0);
   }
   markWord displaced_mark_helper() const {
@@ -262,9 +262,10 @@ int Method::fast_exception_handler_bci_for(const methodHandle& mh, Klass* ex_kla
 
 void Method::mask_for(int bci, InterpreterOopMap* mask) {
   methodHandle h_this(Thread::current(), this);
-  // Only GC uses the OopMapCache during thread stack root scanning
-  // any other uses generate an oopmap but do not save it in the cache.
-  if (Universe::heap()->is_gc_active()) {
+  // GC uses the OopMapCache during thread stack root scanning, and Java
+  // threads share it so that oop maps they compute are ready for the next
+  // GC. Other uses generate an oopmap but do not save it in the cache.
+  if (Universe::heap()->is_gc_active() || Thread::current()->is_Java_thread()) {
     method_holder()->mask_for(h_this, bci, mask);
   } else {
     OopMapCache::compute_one_oop_map(h_this, bci, mask);
@@ -2462,7 +2463,7 @@ void Method::log_touched(TRAPS) {
   MutexLocker ml(THREAD, TouchedMethodLog_lock);
   if (_touched_method_table == NULL) {
     _touched_method_table = NEW_C_HEAP_ARRAY2(TouchedMethodRecord*, table_size,
-                                              mtTracing, CURRENT_PC);
+                                              mtTracing, MALLOC_CURRENT_PC);
     memset(_touched_method_table, 0, sizeof(TouchedMethodRecord*)*table_size);
   }
 
@@ -28,6 +28,7 @@
 #include "oops/metadata.hpp"
 #include "compiler/compilerDefinitions.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/profileCache.hpp"
 #include "interpreter/invocationCounter.hpp"
 #include "utilities/align.hpp"
 
@@ -95,6 +96,7 @@ class MethodCounters : public Metadata {
     // Set per-method thresholds.
     double scale = 1.0;
     CompilerOracle::has_option_value(mh, "CompileThresholdScaling", scale);
+    scale *= ProfileCache::threshold_scaling(mh(), CompLevel_none);
 
     int compile_threshold = CompilerConfig::scaled_compile_threshold(CompileThreshold, scale);
     _interpreter_invocation_limit = compile_threshold << InvocationCounter::count_shift;
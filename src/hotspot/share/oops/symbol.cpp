@@ -26,6 +26,7 @@
 #include "precompiled.hpp"
 #include "classfile/altHashing.hpp"
 #include "classfile/classLoaderData.hpp"
+#include "classfile/symbolTable.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
@@ -336,6 +337,9 @@ void Symbol::decrement_refcount() {
     } else {
       found = Atomic::cmpxchg(&_hash_and_refcount, old_value, old_value - 1);
       if (found == old_value) {
+        if (refc == 1) {
+          SymbolTable::item_died();
+        }
         return;  // successfully updated.
       }
       // refcount changed, try again.
@@ -103,6 +103,13 @@ uint Block::compute_loop_alignment() {
     if (n->is_MachIf() && n->as_MachIf()->_prob < 0.01) {
       return unit_sz; // Loop does not loop, more often than not!
     }
+    // Loops that run many iterations per entry get a stronger alignment
+    // so their head starts a decoded instruction cache line. The code
+    // is only aligned to CodeEntryAlignment and CodeCacheSegmentSize.
+    if (n->is_MachIf() && n->as_MachIf()->_prob >= 0.9) {
+      intx hot = MIN3(OptoHotLoopAlignment, CodeEntryAlignment, (intx)CodeCacheSegmentSize);
+      return (uint)MAX2(hot, OptoLoopAlignment);
+    }
     return OptoLoopAlignment; // Otherwise align loop head
   }
 
@@ -1398,6 +1405,12 @@ extern "C" int trace_frequency_order(const void *p0, const void *p1) {
     return b1->is_connector() ? -1 : 1;
   }
 
+  // Cold traces go after all others, so that uncommon trap and slow
+  // paths do not end up between hot traces
+  if (tr0->is_cold() != tr1->is_cold()) {
+    return tr1->is_cold() ? -1 : 1;
+  }
+
   // Pull more frequently executed blocks to the beginning
   float freq0 = b0->_freq;
   float freq1 = b1->_freq;
@@ -1637,6 +1650,12 @@ void PhaseBlockLayout::reorder_traces(int count) {
   Trace *tr = trace(_cfg.get_root_block());
   assert(tr == new_traces[0], "entry trace misplaced");
 
+  if (BlockLayoutColdTracesLast) {
+    for (int i = 1; i < new_count; i++) {
+      new_traces[i]->compute_is_cold(_cfg);
+    }
+  }
+
   // Sort the new trace list by frequency
   qsort(new_traces + 1, new_count - 1, sizeof(new_traces[0]), trace_frequency_order);
 
@@ -1754,6 +1773,17 @@ bool Trace::backedge(CFGEdge *e) {
 
 // push blocks onto the CFG list
 // ensure that blocks have the correct two-way branch sense
+// A trace is cold if all of its blocks are uncommon
+void Trace::compute_is_cold(PhaseCFG &cfg) {
+  _is_cold = true;
+  for (Block *b = first_block(); b != NULL; b = next(b)) {
+    if (!b->is_connector() && !cfg.is_uncommon(b)) {
+      _is_cold = false;
+      return;
+    }
+  }
+}
+
 void Trace::fixup_blocks(PhaseCFG &cfg) {
   Block *last = last_block();
   for (Block *b = first_block(); b != NULL; b = next(b)) {
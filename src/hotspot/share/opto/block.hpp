@@ -783,6 +783,7 @@ class Trace : public ResourceObj {
   Block ** _prev_list;  // Array mapping index to previous block
   Block * _first;       // First block in the trace
   Block * _last;        // Last block in the trace
+  bool _is_cold;        // All blocks in the trace are uncommon
 
   // Return the block that follows "b" in the trace.
   Block * next(Block *b) const { return _next_list[b->_pre_order]; }
@@ -808,7 +809,8 @@ class Trace : public ResourceObj {
     _next_list(next_list),
     _prev_list(prev_list),
     _first(b),
-    _last(b) {
+    _last(b),
+    _is_cold(false) {
     set_next(b, NULL);
     set_prev(b, NULL);
   };
@@ -823,6 +825,10 @@ class Trace : public ResourceObj {
   // Return the last block in the trace
   Block * last_block() const { return _last; }
 
+  // Cold traces are laid out after all other traces
+  bool is_cold() const { return _is_cold; }
+  void compute_is_cold(PhaseCFG &cfg);
+
   // Insert a trace in the middle of this one after b
   void insert_after(Block *b, Trace *tr) {
     set_next(tr->last_block(), next(b));
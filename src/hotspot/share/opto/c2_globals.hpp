@@ -67,6 +67,12 @@
           "value")                                                          \
           range(0, max_jint)                                                \
                                                                             \
+  product(intx, OptoHotLoopAlignment, 32,                                   \
+          "Align heads of hot inner loops to this many bytes "              \
+          "(at most CodeEntryAlignment, at least OptoLoopAlignment)")       \
+          range(1, 256)                                                     \
+          constraint(OptoHotLoopAlignmentConstraintFunc, AfterErgo)         \
+                                                                            \
   product(intx, MaxVectorSize, 64,                                          \
           "Max vector size in bytes, "                                      \
           "actual size could be less depending on elements type")           \
@@ -212,6 +218,10 @@
   product(bool, UseCountedLoopSafepoints, false,                            \
           "Force counted loops to keep a safepoint")                        \
                                                                             \
+  product(bool, UseLongCountedLoops, true, DIAGNOSTIC,                      \
+          "Convert loops with a long induction variable into a loop nest "  \
+          "with an int counted inner loop")                                 \
+                                                                            \
   product(bool, UseLoopPredicate, true,                                     \
           "Generate a predicate to select fast/slow loop versions")         \
                                                                             \
@@ -381,6 +391,14 @@
   product(bool, UseOnlyInlinedBimorphic, true,                              \
           "Don't use BimorphicInlining if can't inline a second method")    \
                                                                             \
+  product(bool, UsePolymorphicInlining, true,                               \
+          "Profiling based guarded inlining for more than two receivers "   \
+          "(needs TypeProfileWidth > 2)")                                   \
+                                                                            \
+  product(intx, PolymorphicInlineLimit, 4,                                  \
+          "Maximum number of receivers inlined at a polymorphic call site") \
+          range(2, 4)                                                       \
+                                                                            \
   develop(bool, SubsumeLoads, true,                                         \
           "Attempt to compile while subsuming loads into machine "          \
           "instructions.")                                                  \
@@ -518,6 +536,10 @@
   product(bool, EliminateAllocations, true,                                 \
           "Use escape analysis to eliminate allocations")                   \
                                                                             \
+  product(bool, SplitLoadsThroughAllocationMerges, true, DIAGNOSTIC,        \
+          "Split field loads through Phis which merge new allocations, "    \
+          "so that escape analysis can scalar replace them")                \
+                                                                            \
   notproduct(bool, PrintEliminateAllocations, false,                        \
           "Print out when allocations are eliminated")                      \
                                                                             \
@@ -566,6 +588,10 @@
   product(bool, BlockLayoutRotateLoops, true,                               \
           "Allow back branches to be fall throughs in the block layout")    \
                                                                             \
+  product(bool, BlockLayoutColdTracesLast, true, DIAGNOSTIC,                \
+          "Lay out traces made of uncommon blocks after all other traces "  \
+          "in the block layout")                                            \
+                                                                            \
   product(bool, InlineReflectionGetCallerClass, true, DIAGNOSTIC,           \
           "inline sun.reflect.Reflection.getCallerClass(), known to be "    \
           "part of base library DLL")                                       \
@@ -762,11 +788,23 @@
           "Loop with fewer iterations are not strip mined")                 \
           range(0, max_juint)                                               \
                                                                             \
+  product(uintx, LoopStripMiningReferenceBodySize, 40, DIAGNOSTIC,          \
+          "Loop body size (in nodes) that runs LoopStripMiningIter "        \
+          "iterations between safepoints. Strip mined loops with larger "   \
+          "or smaller bodies run proportionally fewer or more iterations. " \
+          "0 disables the scaling")                                         \
+          range(0, 1000)                                                    \
+                                                                            \
   product(bool, UseProfiledLoopPredicate, true,                             \
           "Move predicates out of loops based on profiling data")           \
                                                                             \
   product(bool, ExpandSubTypeCheckAtParseTime, false, DIAGNOSTIC,           \
-          "Do not use subtype check macro node")
+          "Do not use subtype check macro node")                            \
+                                                                            \
+  product(bool, DelayCompilerStubsGeneration, true, EXPERIMENTAL,           \
+          "Generate the intrinsic stubs only used by C2 compiled code "     \
+          "in a compiler thread during C2 initialization instead of "       \
+          "in the main thread during VM startup")
 
 // end of C2_FLAGS
 
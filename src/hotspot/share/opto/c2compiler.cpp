@@ -24,12 +24,14 @@
 
 #include "precompiled.hpp"
 #include "runtime/handles.inline.hpp"
+#include "compiler/compileTask.hpp"
 #include "jfr/support/jfrIntrinsics.hpp"
 #include "opto/c2compiler.hpp"
 #include "opto/compile.hpp"
 #include "opto/optoreg.hpp"
 #include "opto/output.hpp"
 #include "opto/runtime.hpp"
+#include "runtime/stubRoutines.hpp"
 #include "utilities/macros.hpp"
 
 
@@ -67,6 +69,10 @@ bool C2Compiler::init_c2_runtime() {
 
   Compile::pd_compiler2_init();
 
+  // Generate the intrinsic stubs only used by C2 compiled code here,
+  // off the main thread, before any method is compiled.
+  StubRoutines::initialize_compiler_stubs(true /* in_compiler_thread */);
+
   CompilerThread* thread = CompilerThread::current();
 
   HandleMark handle_mark(thread);
@@ -141,6 +147,11 @@ void C2Compiler::compile_method(ciEnv* env, ciMethod* target, int entry_bci, boo
         continue;  // retry
       }
     }
+    if (env->task() != NULL) {
+      env->task()->set_elimination_counts(C.eliminated_boxes(),
+                                          C.eliminated_allocations(),
+                                          C.optimized_string_concats());
+    }
     // print inlining for last compilation only
     C.dump_print_inlining();
 
@@ -635,8 +646,11 @@ bool C2Compiler::is_intrinsic_supported(const methodHandle& method, bool is_virt
   case vmIntrinsics::_bigIntegerRightShiftWorker:
   case vmIntrinsics::_bigIntegerLeftShiftWorker:
   case vmIntrinsics::_vectorizedMismatch:
+  case vmIntrinsics::_vectorizedHashCode:
   case vmIntrinsics::_ghash_processBlocks:
+  case vmIntrinsics::_chacha20Block:
   case vmIntrinsics::_base64_encodeBlock:
+  case vmIntrinsics::_base64_decodeBlock:
   case vmIntrinsics::_updateCRC32:
   case vmIntrinsics::_updateBytesCRC32:
   case vmIntrinsics::_updateByteBufferCRC32:
@@ -552,6 +552,9 @@ Compile::Compile( ciEnv* ci_env, ciMethod* target, int osr_bci,
                   _replay_inline_data(NULL),
                   _java_calls(0),
                   _inner_loops(0),
+                  _eliminated_boxes(0),
+                  _eliminated_allocations(0),
+                  _optimized_string_concats(0),
                   _interpreter_frame_size(0)
 #ifndef PRODUCT
                   , _in_dump_cnt(0)
@@ -834,6 +837,9 @@ Compile::Compile( ciEnv* ci_env,
     _replay_inline_data(NULL),
     _java_calls(0),
     _inner_loops(0),
+    _eliminated_boxes(0),
+    _eliminated_allocations(0),
+    _optimized_string_concats(0),
     _interpreter_frame_size(0),
 #ifndef PRODUCT
     _in_dump_cnt(0),
@@ -1897,6 +1903,27 @@ bool Compile::inline_incrementally_one() {
   return (_late_inlines.length() > 0) && !needs_cleanup;
 }
 
+// Drop late inlines at call sites that are not hot according to the
+// profile. Returns true if there is anything left to inline.
+bool Compile::keep_hot_late_inlines() {
+  int j = 0;
+  for (int i = 0; i < _late_inlines.length(); i++) {
+    CallGenerator* cg = _late_inlines.at(i);
+    CallNode* call = cg->call_node();
+    if (call == NULL || call->outcnt() == 0 || call->in(0) == NULL ||
+        call->in(0)->is_top() || call->jvms() == NULL) {
+      continue;
+    }
+    ciMethod* caller = call->jvms()->method();
+    int count = caller->scale_count(caller->call_profile_at_bci(call->jvms()->bci()).count());
+    if (count >= InlineFrequencyCount) {
+      _late_inlines.at_put(j++, cg);
+    }
+  }
+  _late_inlines.trunc_to(j);
+  return j > 0;
+}
+
 void Compile::inline_incrementally_cleanup(PhaseIterGVN& igvn) {
   {
     TracePhase tp("incrementalInline_pru", &timers[_t_incrInline_pru]);
@@ -1931,7 +1958,12 @@ void Compile::inline_incrementally(PhaseIterGVN& igvn) {
       }
 
       if (live_nodes() > (uint)LiveNodeCountInliningCutoff) {
-        break; // finish
+        // Out of budget: keep inlining only at call sites the profile
+        // says are hot, and only within a bounded overshoot.
+        if (live_nodes() > (uint)LiveNodeCountInliningCutoff * 5 / 4 ||
+            !keep_hot_late_inlines()) {
+          break; // finish
+        }
       }
     }
 
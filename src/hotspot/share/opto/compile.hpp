@@ -469,6 +469,9 @@ class Compile : public Phase {
   PhaseCFG*             _cfg;                   // Results of CFG finding
   int                   _java_calls;            // Number of java calls in the method
   int                   _inner_loops;           // Number of inner loops in the method
+  uint                  _eliminated_boxes;      // Number of boxing allocations removed
+  uint                  _eliminated_allocations; // Number of other allocations removed
+  uint                  _optimized_string_concats; // Number of string concatenations replaced
   Matcher*              _matcher;               // Engine to map ideal to machine instructions
   PhaseRegAlloc*        _regalloc;              // Results of register allocation.
   RegMask               _FIRST_STACK_mask;      // All stack slots usable for spills (depends on frame layout)
@@ -961,6 +964,7 @@ class Compile : public Phase {
   bool has_mh_late_inlines() const     { return _number_of_mh_late_inlines > 0; }
 
   bool inline_incrementally_one();
+  bool keep_hot_late_inlines();
   void inline_incrementally_cleanup(PhaseIterGVN& igvn);
   void inline_incrementally(PhaseIterGVN& igvn);
   void inline_string_calls(bool parse_time);
@@ -973,6 +977,12 @@ class Compile : public Phase {
   bool              has_java_calls() const      { return _java_calls > 0; }
   int               java_calls() const          { return _java_calls; }
   int               inner_loops() const         { return _inner_loops; }
+  uint              eliminated_boxes() const    { return _eliminated_boxes; }
+  uint              eliminated_allocations() const { return _eliminated_allocations; }
+  uint              optimized_string_concats() const { return _optimized_string_concats; }
+  void              inc_eliminated_boxes()      { _eliminated_boxes++; }
+  void              inc_eliminated_allocations() { _eliminated_allocations++; }
+  void              inc_optimized_string_concats() { _optimized_string_concats++; }
   Matcher*          matcher()                   { return _matcher; }
   PhaseRegAlloc*    regalloc()                  { return _regalloc; }
   RegMask&          FIRST_STACK_mask()          { return _FIRST_STACK_mask; }
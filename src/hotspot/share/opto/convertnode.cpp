@@ -452,6 +452,9 @@ const Type* ConvL2INode::Value(PhaseGVN* phase) const {
   if (tl->is_con())
   // Easy case.
   return TypeInt::make((jint)tl->get_con());
+  if (tl->_lo >= min_jint && tl->_hi <= max_jint) {
+    return TypeInt::make((jint)tl->_lo, (jint)tl->_hi, tl->_widen);
+  }
   return bottom_type();
 }
 
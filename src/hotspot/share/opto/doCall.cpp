@@ -62,6 +62,62 @@ void trace_type_profile(Compile* C, ciMethod *method, int depth, int bci, ciMeth
   }
 }
 
+// Guarded inlining of the most frequent receivers at a call site with
+// more than two receiver types in its profile. Receivers are tested in
+// order of decreasing frequency and the sum of their sizes is bounded by
+// FreqInlineSize. Calls that miss every guard go through a virtual call
+// unless the profile says all receivers are covered.
+static CallGenerator* polymorphic_call_generator(Compile* C, ciMethod* callee, int vtable_index,
+                                                 JVMState* jvms, bool allow_inline, float prof_factor,
+                                                 ciCallProfile& profile) {
+  ciMethod* caller = jvms->method();
+  int bci = jvms->bci();
+  int site_count = profile.count();
+  int budget = C->freq_inline_size();
+  GrowableArray<CallGenerator*> hit_cgs;
+  GrowableArray<ciMethod*> targets;
+  for (int i = 0; i < PolymorphicInlineLimit && profile.has_receiver(i); i++) {
+    ciMethod* target = callee->resolve_invoke(caller->holder(), profile.receiver(i));
+    if (target == NULL || target->code_size_for_inlining() > budget) {
+      break;
+    }
+    CallGenerator* cg = C->call_generator(target, vtable_index, false, jvms, allow_inline, prof_factor);
+    if (cg == NULL || !(cg->is_inline() || cg->is_late_inline())) {
+      break;
+    }
+    budget -= target->code_size_for_inlining();
+    hit_cgs.append(cg);
+    targets.append(target);
+  }
+  if (hit_cgs.length() < 2) {
+    return NULL;
+  }
+
+  CallGenerator* miss_cg;
+  if (profile.morphism() == hit_cgs.length() &&
+      !C->too_many_traps_or_recompiles(caller, bci, Deoptimization::Reason_bimorphic)) {
+    miss_cg = CallGenerator::for_uncommon_trap(callee, Deoptimization::Reason_bimorphic,
+                                               Deoptimization::Action_maybe_recompile);
+  } else {
+    miss_cg = CallGenerator::for_virtual_call(callee, vtable_index);
+  }
+
+  // Build the guards from the least frequent receiver up. The
+  // probability of a guard is relative to the calls that reach it.
+  int reaching = site_count;
+  for (int i = 0; i < hit_cgs.length() - 1; i++) {
+    reaching -= profile.receiver_count(i);
+  }
+  for (int i = hit_cgs.length() - 1; i >= 0 && miss_cg != NULL; i--) {
+    int receiver_count = profile.receiver_count(i);
+    float hit_prob = reaching > 0 ? MIN2((float)receiver_count / reaching, PROB_MAX) : PROB_MAX;
+    trace_type_profile(C, caller, jvms->depth() - 1, bci, targets.at(i), profile.receiver(i), site_count, receiver_count);
+    miss_cg = CallGenerator::for_predicted_call(profile.receiver(i), miss_cg, hit_cgs.at(i), hit_prob);
+    reaching += (i > 0) ? profile.receiver_count(i - 1) : 0;
+  }
+  return miss_cg;
+}
+
 CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool call_does_dispatch,
                                        JVMState* jvms, bool allow_inline,
                                        float prof_factor, ciKlass* speculative_receiver_type,
@@ -289,6 +345,12 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
           }
         }
       }
+      if (receiver_method == NULL && UsePolymorphicInlining && profile.has_receiver(2)) {
+        // No major receiver among more than two: guard the frequent ones.
+        CallGenerator* cg = polymorphic_call_generator(this, callee, vtable_index, jvms,
+                                                       allow_inline, prof_factor, profile);
+        if (cg != NULL)  return cg;
+      }
     }
 
     // If there is only one implementor of this interface then we
@@ -1275,7 +1275,7 @@ bool ConnectionGraph::complete_connection_graph(
 // and check that we still have non-escaping java objects.
 bool ConnectionGraph::find_non_escaped_objects(GrowableArray<PointsToNode*>& ptnodes_worklist,
                                                GrowableArray<JavaObjectNode*>& non_escaped_worklist) {
-  GrowableArray<PointsToNode*> escape_worklist;
+  GrowableArrayInline<PointsToNode*, 32> escape_worklist;
   // First, put all nodes with GlobalEscape and ArgEscape states on worklist.
   int ptnodes_length = ptnodes_worklist.length();
   for (int next = 0; next < ptnodes_length; ++next) {
@@ -1552,7 +1552,7 @@ int ConnectionGraph::find_init_values(JavaObjectNode* pta, PointsToNode* init_va
 
   InitializeNode* ini = alloc->as_Allocate()->initialization();
   bool visited_bottom_offset = false;
-  GrowableArray<int> offsets_worklist;
+  GrowableArrayInline<int, 16> offsets_worklist;
 
   // Check if an oop field's initializing value is recorded and add
   // a corresponding NULL if field's value if it is not recorded.
@@ -111,6 +111,9 @@ IndexSet::BitBlock *IndexSet::alloc_block() {
 IndexSet::BitBlock *IndexSet::alloc_block_containing(uint element) {
   BitBlock *block = alloc_block();
   uint bi = get_block_index(element);
+  if (bi >= _block_capacity) {
+    grow_blocks(bi + 1);
+  }
   if (bi >= _current_block_limit) {
     _current_block_limit = bi + 1;
   }
@@ -123,7 +126,7 @@ IndexSet::BitBlock *IndexSet::alloc_block_containing(uint element) {
 
 void IndexSet::free_block(uint i) {
   debug_only(check_watch("free block", i));
-  assert(i < _max_blocks, "block index too large");
+  assert(i < _block_capacity, "block index too large");
   BitBlock *block = _blocks[i];
   assert(block != &_empty_block, "cannot free the empty block");
   block->set_next((IndexSet::BitBlock*)Compile::current()->indexSet_free_block_list());
@@ -229,13 +232,12 @@ IndexSet::IndexSet (IndexSet *set) {
   _count = set->_count;
   _current_block_limit = set->_current_block_limit;
   _max_blocks = set->_max_blocks;
-  if (_max_blocks <= preallocated_block_list_size) {
-    _blocks = _preallocated_block_list;
-  } else {
-    _blocks =
-      (IndexSet::BitBlock**) arena()->Amalloc_4(sizeof(IndexSet::BitBlock**) * _max_blocks);
+  _blocks_arena = NULL;
+  initialize_blocks();
+  if (_current_block_limit > _block_capacity) {
+    grow_blocks(_current_block_limit);
   }
-  for (uint i = 0; i < _max_blocks; i++) {
+  for (uint i = 0; i < _current_block_limit; i++) {
     BitBlock *block = set->_blocks[i];
     if (block == &_empty_block) {
       set_block(i, &_empty_block);
@@ -259,15 +261,8 @@ void IndexSet::initialize(uint max_elements) {
   _count = 0;
   _current_block_limit = 0;
   _max_blocks = (max_elements + bits_per_block - 1) / bits_per_block;
-
-  if (_max_blocks <= preallocated_block_list_size) {
-    _blocks = _preallocated_block_list;
-  } else {
-    _blocks = (IndexSet::BitBlock**) arena()->Amalloc_4(sizeof(IndexSet::BitBlock*) * _max_blocks);
-  }
-  for (uint i = 0; i < _max_blocks; i++) {
-    set_block(i, &_empty_block);
-  }
+  _blocks_arena = NULL;
+  initialize_blocks();
 }
 
 //---------------------------- IndexSet::initialize()------------------------------
@@ -284,17 +279,41 @@ void IndexSet::initialize(uint max_elements, Arena *arena) {
   _count = 0;
   _current_block_limit = 0;
   _max_blocks = (max_elements + bits_per_block - 1) / bits_per_block;
+  _blocks_arena = arena;
+  initialize_blocks();
+}
 
-  if (_max_blocks <= preallocated_block_list_size) {
-    _blocks = _preallocated_block_list;
-  } else {
-    _blocks = (IndexSet::BitBlock**) arena->Amalloc_4(sizeof(IndexSet::BitBlock*) * _max_blocks);
-  }
-  for (uint i = 0; i < _max_blocks; i++) {
+//---------------------------- IndexSet::initialize_blocks() -----------------------
+// Start out with the preallocated top level array. Entries for higher blocks are
+// allocated when the first element is inserted into them.
+
+void IndexSet::initialize_blocks() {
+  _blocks = _preallocated_block_list;
+  _block_capacity = MIN2(_max_blocks, (uint)preallocated_block_list_size);
+  for (uint i = 0; i < _block_capacity; i++) {
     set_block(i, &_empty_block);
   }
 }
 
+//---------------------------- IndexSet::grow_blocks() -----------------------------
+// Grow the top level array geometrically, but never beyond what the universe
+// needs. The old array is left in the arena.
+
+void IndexSet::grow_blocks(uint min_capacity) {
+  assert(min_capacity <= _max_blocks, "block index too large");
+  uint new_capacity = MIN2(MAX2(_block_capacity * 2, min_capacity), _max_blocks);
+  Arena* a = (_blocks_arena != NULL) ? _blocks_arena : arena();
+  BitBlock** new_blocks = (BitBlock**) a->Amalloc_4(sizeof(BitBlock*) * new_capacity);
+  for (uint i = 0; i < _block_capacity; i++) {
+    new_blocks[i] = _blocks[i];
+  }
+  for (uint i = _block_capacity; i < new_capacity; i++) {
+    new_blocks[i] = &_empty_block;
+  }
+  _blocks = new_blocks;
+  _block_capacity = new_capacity;
+}
+
 //---------------------------- IndexSet::swap() -----------------------------
 // Exchange two IndexSets.
 
@@ -306,6 +325,12 @@ void IndexSet::swap(IndexSet *set) {
 #endif
 
   uint max = MAX2(_current_block_limit, set->_current_block_limit);
+  if (max > _block_capacity) {
+    grow_blocks(max);
+  }
+  if (max > set->_block_capacity) {
+    set->grow_blocks(max);
+  }
   for (uint i = 0; i < max; i++) {
     BitBlock *temp = _blocks[i];
     set_block(i, set->_blocks[i]);
@@ -344,7 +369,7 @@ void IndexSet::dump() const {
 void IndexSet::tally_iteration_statistics() const {
   inc_stat_counter(&_total_bits, count());
 
-  for (uint i = 0; i < _max_blocks; i++) {
+  for (uint i = 0; i < _block_capacity; i++) {
     if (_blocks[i] != &_empty_block) {
       inc_stat_counter(&_total_used_blocks, 1);
     } else {
@@ -198,9 +198,18 @@ class IndexSet : public ResourceObj {
 
   BitBlock  *_preallocated_block_list[preallocated_block_list_size];
 
-  // The number of top level array entries in use
+  // The number of top level array entries needed to hold the universe
   uint       _max_blocks;
 
+  // The number of top level array entries allocated so far. The array is
+  // grown on demand so that sets over a large universe, like the neighbor
+  // sets of the IFG in huge methods, only pay for the blocks they use.
+  uint       _block_capacity;
+
+  // The arena from which a grown top level array is allocated, or NULL to
+  // use the BitBlock arena.
+  Arena     *_blocks_arena;
+
   // Our assertions need to know the maximum number allowed in the set
 #ifdef ASSERT
   uint       _max_elements;
@@ -227,9 +236,16 @@ class IndexSet : public ResourceObj {
   // Get the block which holds element
   BitBlock *get_block_containing(uint element) const {
     assert(element < _max_elements, "element out of bounds");
-    return _blocks[get_block_index(element)];
+    uint bi = get_block_index(element);
+    return (bi < _block_capacity) ? _blocks[bi] : &_empty_block;
   }
 
+  // Initialize the top level array to the preallocated block list
+  void initialize_blocks();
+
+  // Grow the top level array to hold at least min_capacity entries
+  void grow_blocks(uint min_capacity);
+
   // Set a block in the top level array
   void set_block(uint index, BitBlock *block) {
     _blocks[index] = block;
@@ -304,7 +304,9 @@ class LibraryCallKit : public GraphKit {
   Node* get_key_start_from_aescrypt_object(Node* aescrypt_object);
   Node* get_original_key_start_from_aescrypt_object(Node* aescrypt_object);
   bool inline_ghash_processBlocks();
+  bool inline_chacha20Block();
   bool inline_base64_encodeBlock();
+  bool inline_base64_decodeBlock();
   bool inline_digestBase_implCompress(vmIntrinsics::ID id);
   bool inline_digestBase_implCompressMB(int predicate);
   bool inline_digestBase_implCompressMB(Node* digestBaseObj, ciInstanceKlass* instklass,
@@ -330,6 +332,7 @@ class LibraryCallKit : public GraphKit {
   bool inline_montgomerySquare();
   bool inline_bigIntegerShift(bool isRightShift);
   bool inline_vectorizedMismatch();
+  bool inline_vectorizedHashCode();
   bool inline_fma(vmIntrinsics::ID id);
   bool inline_character_compare(vmIntrinsics::ID id);
   bool inline_fp_min_max(vmIntrinsics::ID id);
@@ -860,11 +863,17 @@ bool LibraryCallKit::try_to_inline(int predicate) {
 
   case vmIntrinsics::_vectorizedMismatch:
     return inline_vectorizedMismatch();
+  case vmIntrinsics::_vectorizedHashCode:
+    return inline_vectorizedHashCode();
 
   case vmIntrinsics::_ghash_processBlocks:
     return inline_ghash_processBlocks();
+  case vmIntrinsics::_chacha20Block:
+    return inline_chacha20Block();
   case vmIntrinsics::_base64_encodeBlock:
     return inline_base64_encodeBlock();
+  case vmIntrinsics::_base64_decodeBlock:
+    return inline_base64_decodeBlock();
 
   case vmIntrinsics::_encodeISOArray:
   case vmIntrinsics::_encodeByteISOArray:
@@ -5396,6 +5405,52 @@ bool LibraryCallKit::inline_vectorizedMismatch() {
   return true;
 }
 
+//-------------inline_vectorizedHashCode------------------------------
+// int ArraysSupport.vectorizedHashCode(Object array, int fromIndex, int length,
+//                                      int initialValue, int basicType)
+// Only intrinsified when basicType is a constant, which selects the stub.
+bool LibraryCallKit::inline_vectorizedHashCode() {
+  assert(UseVectorizedHashCodeIntrinsic, "not implemented on this platform");
+  assert(callee()->signature()->size() == 5, "vectorizedHashCode has 5 parameters");
+
+  Node* array      = argument(0);
+  Node* from_index = argument(1);
+  Node* length     = argument(2);
+  Node* initial    = argument(3);
+  Node* basic_type = argument(4);
+
+  const TypeInt* type_t = gvn().type(basic_type)->isa_int();
+  if (type_t == NULL || !type_t->is_con()) {
+    return false; // the element type must be known at compile time
+  }
+  BasicType elem_type = (BasicType)type_t->get_con();
+  address stubAddr = StubRoutines::vectorizedHashCode(elem_type);
+  if (stubAddr == NULL) {
+    return false; // Intrinsic's stub is not implemented on this platform
+  }
+  const char* stubName = "vectorizedHashCode";
+
+  const TypeAryPtr* top = array->Value(&_gvn)->isa_aryptr();
+  if (top == NULL || top->klass() == NULL) {
+    // failed array check
+    return false;
+  }
+
+  array = must_be_not_null(array, true);
+  // A byte[] holding UTF16 chars is hashed as T_CHAR; the header size is
+  // the same for all these element types, so address by the hashed type.
+  Node* array_start = array_element_address(array, from_index, elem_type);
+
+  Node* call = make_runtime_call(RC_LEAF,
+                                 OptoRuntime::vectorizedHashCode_Type(),
+                                 stubAddr, stubName, TypePtr::BOTTOM,
+                                 array_start, length, initial);
+
+  Node* result = _gvn.transform(new ProjNode(call, TypeFunc::Parms));
+  set_result(result);
+  return true;
+}
+
 /**
  * Calculate CRC32 for byte.
  * int java.util.zip.CRC32.update(int crc, int b)
@@ -6395,6 +6450,38 @@ bool LibraryCallKit::inline_ghash_processBlocks() {
   return true;
 }
 
+//------------------------------inline_chacha20Block-----------------------
+// int com.sun.crypto.provider.ChaCha20Cipher.implChaCha20Block(int[] initState, byte[] result)
+// The stub writes as many key stream blocks as it computes at once and
+// returns the number of bytes written; the caller sizes result for that.
+bool LibraryCallKit::inline_chacha20Block() {
+  assert(UseChaCha20Intrinsics, "need ChaCha20 intrinsics support");
+  assert(callee()->signature()->size() == 2, "implChaCha20Block has 2 parameters");
+
+  address stubAddr = StubRoutines::chacha20Block();
+  if (stubAddr == NULL) return false;
+  const char* stubName = "chacha20Block";
+
+  Node* state  = argument(0);
+  Node* result = argument(1);
+
+  state = must_be_not_null(state, true);
+  result = must_be_not_null(result, true);
+
+  Node* state_start  = array_element_address(state, intcon(0), T_INT);
+  assert(state_start, "state is NULL");
+  Node* result_start = array_element_address(result, intcon(0), T_BYTE);
+  assert(result_start, "result is NULL");
+
+  Node* call = make_runtime_call(RC_LEAF|RC_NO_FP,
+                                 OptoRuntime::chacha20Block_Type(),
+                                 stubAddr, stubName, TypePtr::BOTTOM,
+                                 state_start, result_start);
+  Node* ks_len = _gvn.transform(new ProjNode(call, TypeFunc::Parms));
+  set_result(ks_len);
+  return true;
+}
+
 bool LibraryCallKit::inline_base64_encodeBlock() {
   address stubAddr;
   const char *stubName;
@@ -6427,6 +6514,41 @@ bool LibraryCallKit::inline_base64_encodeBlock() {
   return true;
 }
 
+bool LibraryCallKit::inline_base64_decodeBlock() {
+  address stubAddr;
+  const char *stubName;
+  assert(UseBASE64Intrinsics, "need Base64 intrinsics support");
+  assert(callee()->signature()->size() == 7, "base64_decodeBlock has 7 parameters");
+  stubAddr = StubRoutines::base64_decodeBlock();
+  stubName = "decodeBlock";
+
+  if (!stubAddr) return false;
+  Node* base64obj = argument(0);
+  Node* src = argument(1);
+  Node* src_offset = argument(2);
+  Node* len = argument(3);
+  Node* dest = argument(4);
+  Node* dest_offset = argument(5);
+  Node* isURL = argument(6);
+  Node* isMIME = argument(7);
+
+  src = must_be_not_null(src, true);
+  dest = must_be_not_null(dest, true);
+
+  Node* src_start = array_element_address(src, intcon(0), T_BYTE);
+  assert(src_start, "source array is NULL");
+  Node* dest_start = array_element_address(dest, intcon(0), T_BYTE);
+  assert(dest_start, "destination array is NULL");
+
+  Node* call = make_runtime_call(RC_LEAF,
+                                 OptoRuntime::base64_decodeBlock_Type(),
+                                 stubAddr, stubName, TypePtr::BOTTOM,
+                                 src_start, src_offset, len, dest_start, dest_offset, isURL, isMIME);
+  Node* result = _gvn.transform(new ProjNode(call, TypeFunc::Parms));
+  set_result(result);
+  return true;
+}
+
 //------------------------------inline_digestBase_implCompress-----------------------
 //
 // Calculate MD5 for single-block byte[] array.
@@ -883,6 +883,18 @@ bool IdealLoopTree::policy_unroll(PhaseIdealLoop *phase) {
     return false;
   }
 
+  // Vectorized loops over short arrays spend most of their iterations in the
+  // pre- and post-loops. The pre-loop may execute up to one vector of scalar
+  // iterations to align the main loop, so don't unroll a vectorized loop any
+  // further unless the main loop is still expected to run at least twice.
+  // Anything left over is handled by the vector post-loop, see
+  // insert_vector_post_loop().
+  if (cl->is_vectorized_loop() && cl->slp_max_unroll() > 0 &&
+      cl->profile_trip_cnt() != COUNT_UNKNOWN &&
+      (float)(2 * future_unroll_cnt + cl->slp_max_unroll()) > cl->profile_trip_cnt()) {
+    return false;
+  }
+
   // When unroll count is greater than LoopUnrollMin, don't unroll if:
   //   the residual iterations are more than 10% of the trip count
   //   and rounds of "unroll,optimize" are not making significant progress
@@ -3336,6 +3348,14 @@ bool IdealLoopTree::iteration_split_impl(PhaseIdealLoop *phase, Node_List &old_n
   // Compute loop trip count if possible.
   compute_trip_count(phase);
 
+  if (_head->is_CountedLoop()) {
+    CountedLoopNode* cl = _head->as_CountedLoop();
+    if (cl->is_strip_mined() && cl->is_normal_loop() && cl->strip_mined_body_size() == 0) {
+      // Record the cost of one iteration before unrolling changes it
+      cl->set_strip_mined_body_size(_body.size());
+    }
+  }
+
   // Convert one iteration loop into normal code.
   if (do_one_iteration_loop(phase)) {
     return true;
@@ -86,9 +86,12 @@ bool IdealLoopTree::policy_unswitching( PhaseIdealLoop *phase ) const {
 // Find candidate "if" for unswitching
 IfNode* PhaseIdealLoop::find_unswitching_candidate(const IdealLoopTree *loop) const {
 
-  // Find first invariant test that doesn't exit the loop
+  // Find the most frequently executed invariant test that doesn't
+  // exit the loop. Tests without profile data rank lowest and, at
+  // equal counts, the test closest to the loop head is picked.
   LoopNode *head = loop->_head->as_Loop();
   IfNode* unswitch_iff = NULL;
+  float unswitch_cnt = 0.0f;
   Node* n = head->in(LoopNode::LoopBackControl);
   while (n != head) {
     Node* n_dom = idom(n);
@@ -101,7 +104,11 @@ IfNode* PhaseIdealLoop::find_unswitching_candidate(const IdealLoopTree *loop) co
             // If condition is invariant and not a loop exit,
             // then found reason to unswitch.
             if (loop->is_invariant(bol) && !loop->is_loop_exit(iff)) {
-              unswitch_iff = iff;
+              float cnt = (iff->_fcnt != COUNT_UNKNOWN) ? iff->_fcnt : 0.0f;
+              if (unswitch_iff == NULL || cnt >= unswitch_cnt) {
+                unswitch_iff = iff;
+                unswitch_cnt = cnt;
+              }
             }
           }
         }
@@ -142,6 +149,34 @@ void PhaseIdealLoop::do_unswitching(IdealLoopTree *loop, Node_List &old_new) {
   }
 #endif
 
+  // Other tests of the same invariant condition, or of its negation,
+  // are folded in both versions of the loop as well.
+  Node_List same_cond_iffs;
+  Node_List negated_cond_iffs;
+  BoolNode* unswitch_bol = unswitch_iff->in(1)->as_Bool();
+  Node* unswitch_cmp = unswitch_bol->in(1);
+  for (DUIterator_Fast imax, i = unswitch_cmp->fast_outs(imax); i < imax; i++) {
+    Node* b = unswitch_cmp->fast_out(i);
+    if (!b->is_Bool()) {
+      continue;
+    }
+    bool negated = b->as_Bool()->_test._test == unswitch_bol->_test.negate();
+    if (b != unswitch_bol && !negated) {
+      continue;
+    }
+    for (DUIterator_Fast jmax, j = b->fast_outs(jmax); j < jmax; j++) {
+      Node* use = b->fast_out(j);
+      if (use != unswitch_iff && (use->Opcode() == Op_If || use->Opcode() == Op_RangeCheck) &&
+          loop->is_member(get_loop(use)) && !loop->is_loop_exit(use)) {
+        if (negated) {
+          negated_cond_iffs.push(use);
+        } else {
+          same_cond_iffs.push(use);
+        }
+      }
+    }
+  }
+
   // Need to revert back to normal loop
   if (head->is_CountedLoop() && !head->as_CountedLoop()->is_normal_loop()) {
     head->as_CountedLoop()->set_normal_loop();
@@ -227,6 +262,16 @@ void PhaseIdealLoop::do_unswitching(IdealLoopTree *loop, Node_List &old_new) {
   _igvn.rehash_node_delayed(unswitch_iff_clone);
   dominated_by(proj_false, unswitch_iff_clone, false, false);
 
+  for (uint i = 0; i < same_cond_iffs.size() + negated_cond_iffs.size(); i++) {
+    bool negated = i >= same_cond_iffs.size();
+    Node* iff = negated ? negated_cond_iffs.at(i - same_cond_iffs.size()) : same_cond_iffs.at(i);
+    Node* iff_clone = old_new[iff->_idx];
+    _igvn.rehash_node_delayed(iff);
+    dominated_by(proj_true, iff, negated, false);
+    _igvn.rehash_node_delayed(iff_clone);
+    dominated_by(proj_false, iff_clone, negated, false);
+  }
+
   // Reoptimize loops
   loop->record_for_igvn();
   for(int i = loop->_body.size() - 1; i >= 0 ; i--) {
@@ -998,6 +998,210 @@ bool PhaseIdealLoop::is_counted_loop(Node* x, IdealLoopTree*& loop) {
   return true;
 }
 
+//------------------------------is_long_counted_loop---------------------------
+// Convert a loop with a long induction variable into a loop nest: an
+// outer loop that iterates over the long range and an inner loop with
+// an int induction variable which can then be made a counted loop (and
+// benefit from range check elimination, unrolling, vectorization...).
+//
+//   for (long i = init; i < limit; i += stride) { body(i); }
+//
+// becomes
+//
+//   long j = init;
+//   do {
+//     int n = (int)min(limit - j, max_jint - ABS(stride) - 1);
+//     int k = 0;
+//     do { body(j + k); k += stride; } while (k < n);
+//     j += k;
+//   } while (j < limit);
+//
+// The inner loop exits early when it runs out of int iterations and
+// the original long exit test is kept on the outer loop: whenever the
+// inner loop continues the original loop would have continued too so
+// the loop nest doesn't need a loop limit check.
+bool PhaseIdealLoop::is_long_counted_loop(Node* x, IdealLoopTree*& loop) {
+  if (x->Opcode() != Op_Loop || loop->_child != NULL) {
+    return false;
+  }
+
+  Node* back_control = loop_exit_control(x, loop);
+  if (back_control == NULL) {
+    return false;
+  }
+
+  BoolTest::mask bt = BoolTest::illegal;
+  float cl_prob = 0;
+  Node* incr = NULL;
+  Node* limit = NULL;
+
+  Node* cmp = loop_exit_test(back_control, loop, incr, limit, bt, cl_prob);
+  if (cmp == NULL || cmp->Opcode() != Op_CmpL) {
+    return false;
+  }
+
+  Node* phi_incr = NULL;
+  incr = loop_iv_incr(incr, x, loop, phi_incr);
+  if (incr == NULL || phi_incr != NULL || incr->Opcode() != Op_AddL) {
+    return false; // Only exit tests on the incremented value are supported
+  }
+
+  Node* xphi = NULL;
+  Node* stride = loop_iv_stride(incr, loop, xphi);
+  if (stride == NULL) {
+    return false;
+  }
+
+  PhiNode* phi = loop_iv_phi(xphi, NULL, x, loop);
+  if (phi == NULL || phi->in(LoopNode::LoopBackControl) != incr) {
+    return false;
+  }
+
+  // The stride must be small enough for the inner loop to run a
+  // reasonable number of iterations.
+  jlong stride_con = stride->get_long();
+  assert(stride_con != 0, "missed some peephole opt");
+  if (stride_con >= max_jint / 2 || stride_con <= -(max_jint / 2)) {
+    return false;
+  }
+  if (!(stride_con > 0 && (bt == BoolTest::lt || bt == BoolTest::le)) &&
+      !(stride_con < 0 && (bt == BoolTest::gt || bt == BoolTest::ge))) {
+    return false;
+  }
+
+  if (x->in(LoopNode::LoopBackControl) != back_control) {
+    return false; // Safepoint on the backedge
+  }
+
+  // The outer loop needs a safepoint: clone the one at the exit test.
+  IfNode* iff = back_control->in(0)->as_If();
+  Node* sfpt = iff->in(0);
+  if (sfpt->Opcode() != Op_SafePoint || get_loop(sfpt) != loop) {
+    return false;
+  }
+
+  // =================================================
+  // ---- SUCCESS!   Found A Long Trip-Counted Loop! ----
+  //
+  uint iftrue_op = back_control->Opcode();
+  BoolNode* test = iff->in(1)->as_Bool();
+  Node* init_control = x->in(LoopNode::EntryControl);
+  Node* exit_proj = iff->proj_out(!(iftrue_op == Op_IfTrue));
+
+  // Build the outer loop: the exit of the inner loop goes to a copy
+  // of the safepoint and of the original long exit test.
+  Node* inner_exit = exit_proj->clone();
+  Node* outer_sfpt = sfpt->clone();
+  outer_sfpt->set_req(0, inner_exit);
+  IfNode* outer_iff = new IfNode(outer_sfpt, test, iff->_prob, iff->_fcnt);
+  Node* outer_back = back_control->clone();
+  outer_back->set_req(0, outer_iff);
+  LoopNode* outer_head = new LoopNode(init_control, outer_back);
+
+  IdealLoopTree* outer_ilt = insert_outer_loop(loop, outer_head, outer_back);
+  outer_ilt->_has_sfpt = 1;
+
+  // When this code runs, loop bodies have not yet been populated.
+  const bool body_populated = false;
+  register_control(outer_head, outer_ilt, init_control, body_populated);
+  register_control(inner_exit, outer_ilt, iff, body_populated);
+  register_control(outer_sfpt, outer_ilt, inner_exit, body_populated);
+  register_control(outer_iff, outer_ilt, outer_sfpt, body_populated);
+  register_control(outer_back, outer_ilt, outer_iff, body_populated);
+  _igvn.replace_input_of(exit_proj, 0, outer_iff);
+  set_idom(exit_proj, outer_iff, dom_depth(outer_iff));
+  _igvn.replace_input_of(x, LoopNode::EntryControl, outer_head);
+  set_idom(x, outer_head, dom_depth(outer_head));
+  recompute_dom_depth();
+
+  // Other phis of the loop carry their value from one inner loop to
+  // the next through a phi of the outer loop.
+  Node_List phis;
+  for (DUIterator_Fast imax, i = x->fast_outs(imax); i < imax; i++) {
+    Node* u = x->fast_out(i);
+    if (u->is_Phi() && u != phi) {
+      phis.push(u);
+    }
+  }
+  for (uint i = 0; i < phis.size(); i++) {
+    Node* u = phis.at(i);
+    Node* u_outer = u->clone();
+    u_outer->set_req(0, outer_head);
+    register_new_node(u_outer, outer_head);
+    _igvn.replace_input_of(u, LoopNode::EntryControl, u_outer);
+  }
+
+  // The long induction variable of the outer loop: starts at init and
+  // continues from the last value of the inner loop.
+  Node* outer_phi = phi->clone();
+  outer_phi->set_req(0, outer_head);
+  register_new_node(outer_phi, outer_head);
+
+  // Number of iterations of the inner loop. The difference with the
+  // limit may not fit in a long so it's used as an unsigned value.
+  jlong iters_limit = max_jint - ABS(stride_con) - 1;
+  Node* adjusted_limit = limit;
+  if (bt == BoolTest::le || bt == BoolTest::ge) {
+    // 'i <= limit' is 'i < limit+1'. If limit+1 overflows, the inner
+    // loop runs a single iteration which is slow but correct.
+    adjusted_limit = _igvn.transform(new AddLNode(limit, _igvn.longcon(stride_con > 0 ? 1 : -1)));
+  }
+  Node* inner_iters_max = NULL;
+  if (stride_con > 0) {
+    inner_iters_max = MaxNode::max_diff_with_zero(adjusted_limit, outer_phi, TypeLong::LONG, _igvn);
+  } else {
+    inner_iters_max = MaxNode::max_diff_with_zero(outer_phi, adjusted_limit, TypeLong::LONG, _igvn);
+  }
+  Node* inner_iters_actual = MaxNode::unsigned_min(inner_iters_max, _igvn.longcon(iters_limit),
+                                                   TypeLong::make(0, iters_limit, Type::WidenMin), _igvn);
+  Node* inner_iters_actual_int = _igvn.transform(new ConvL2INode(inner_iters_actual));
+  if (stride_con < 0) {
+    inner_iters_actual_int = _igvn.transform(new SubINode(_igvn.intcon(0), inner_iters_actual_int));
+  }
+  set_subtree_ctrl(inner_iters_actual_int);
+
+  // The int induction variable of the inner loop
+  Node* int_zero = _igvn.intcon(0);
+  set_ctrl(int_zero, C->root());
+  Node* int_stride = _igvn.intcon((jint)stride_con);
+  set_ctrl(int_stride, C->root());
+  Node* inner_phi = new PhiNode(x, TypeInt::INT);
+  Node* inner_incr = new AddINode(inner_phi, int_stride);
+  inner_phi->init_req(LoopNode::EntryControl, int_zero);
+  inner_phi->init_req(LoopNode::LoopBackControl, inner_incr);
+  register_new_node(inner_phi, x);
+  register_new_node(inner_incr, x);
+
+  BoolTest::mask inner_bt = stride_con > 0 ? BoolTest::lt : BoolTest::gt;
+  if (iftrue_op == Op_IfFalse) {
+    inner_bt = BoolTest(inner_bt).negate();
+  }
+  Node* inner_cmp = new CmpINode(inner_incr, inner_iters_actual_int);
+  Node* inner_bol = new BoolNode(inner_cmp, inner_bt);
+  register_new_node(inner_cmp, sfpt);
+  register_new_node(inner_bol, sfpt);
+  _igvn.replace_input_of(iff, 1, inner_bol);
+
+  // Replace the long induction variable by outer_phi + inner_phi. The
+  // increment, which feeds the outer loop backedge and exit test,
+  // follows.
+  Node* inner_phi_long = new ConvI2LNode(inner_phi);
+  register_new_node(inner_phi_long, x);
+  Node* iv_add = new AddLNode(outer_phi, inner_phi_long);
+  register_new_node(iv_add, x);
+  _igvn.replace_node(phi, iv_add);
+
+#ifndef PRODUCT
+  if (TraceLoopOpts) {
+    tty->print("LoopNest     ");
+    outer_ilt->dump_head();
+  }
+#endif
+
+  loop = outer_ilt;
+  return true;
+}
+
 //----------------------exact_limit-------------------------------------------
 Node* PhaseIdealLoop::exact_limit( IdealLoopTree *loop ) {
   assert(loop->_head->is_CountedLoop(), "");
@@ -1455,6 +1659,20 @@ Node* CountedLoopNode::skip_predicates() {
   return in(LoopNode::EntryControl);
 }
 
+// Number of iterations of a strip mined loop between two safepoints:
+// LoopStripMiningIter (possibly overridden per method), scaled by how the
+// estimated cost of the loop body compares to
+// LoopStripMiningReferenceBodySize.
+static jlong strip_mining_iters(Compile* C, CountedLoopNode* inner_cl) {
+  jlong iters = (jlong)MIN2(C->directive()->LoopStripMiningIterOption, (uintx)max_juint);
+  uint body_size = inner_cl->strip_mined_body_size();
+  if (LoopStripMiningReferenceBodySize > 0 && body_size > 0) {
+    jlong scaled = iters * (jlong)LoopStripMiningReferenceBodySize / body_size;
+    iters = MIN2(MAX2(scaled, iters / 4), iters * 4);
+  }
+  return MAX2(iters, (jlong)1);
+}
+
 void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
   // Look for the outer & inner strip mined loop, reduce number of
   // iterations of the inner loop, set exit condition of outer loop,
@@ -1472,7 +1690,7 @@ void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
   CountedLoopEndNode* inner_cle = inner_cl->loopexit();
 
   int stride = inner_cl->stride_con();
-  jlong scaled_iters_long = ((jlong)LoopStripMiningIter) * ABS(stride);
+  jlong scaled_iters_long = strip_mining_iters(igvn->C, inner_cl) * ABS(stride);
   int scaled_iters = (int)scaled_iters_long;
   int short_scaled_iters = LoopStripMiningIterShortLoop* ABS(stride);
   const TypeInt* inner_iv_t = igvn->type(inner_iv_phi)->is_int();
@@ -2553,6 +2771,13 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
     // Look for induction variables
     phase->replace_parallel_iv(this);
 
+  } else if (UseLongCountedLoops && phase->is_long_counted_loop(_head, loop)) {
+    // This loop is now the int inner loop of a loop nest: make it a
+    // counted loop, then move on to the loops that follow the nest.
+    assert(loop->_child == this && _next == NULL, "should be the inner loop of the nest");
+    counted_loop(phase);
+    if (loop->_next)  loop->_next->counted_loop(phase);
+    return;
   } else if (_parent != NULL && !_irreducible) {
     // Not a counted loop. Keep one safepoint.
     bool keep_one_sfpt = true;
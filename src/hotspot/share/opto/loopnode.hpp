@@ -208,6 +208,10 @@ class CountedLoopNode : public LoopNode {
   // unroll,optimize,unroll,optimize,... is making progress
   int _node_count_before_unroll;
 
+  // Size of the loop body before unrolling, for strip mined loops. Used
+  // to scale the number of iterations between safepoints.
+  uint _strip_mined_body_size;
+
   // If slp analysis is performed we record the maximum
   // vector mapped unroll factor here
   int _slp_maximum_unroll_factor;
@@ -216,7 +220,7 @@ public:
   CountedLoopNode( Node *entry, Node *backedge )
     : LoopNode(entry, backedge), _main_idx(0), _trip_count(max_juint),
       _unrolled_count_log2(0), _node_count_before_unroll(0),
-      _slp_maximum_unroll_factor(0) {
+      _strip_mined_body_size(0), _slp_maximum_unroll_factor(0) {
     init_class_id(Class_CountedLoop);
     // Initialize _trip_count to the largest possible value.
     // Will be reset (lower) if the loop's trip count is known.
@@ -297,6 +301,8 @@ public:
 
   void set_node_count_before_unroll(int ct)  { _node_count_before_unroll = ct; }
   int  node_count_before_unroll()            { return _node_count_before_unroll; }
+  void set_strip_mined_body_size(uint sz)    { _strip_mined_body_size = sz; }
+  uint strip_mined_body_size() const         { return _strip_mined_body_size; }
   void set_slp_max_unroll(int unroll_factor) { _slp_maximum_unroll_factor = unroll_factor; }
   int  slp_max_unroll() const                { return _slp_maximum_unroll_factor; }
 
@@ -1044,6 +1050,7 @@ public:
   PhiNode* loop_iv_phi(Node* xphi, Node* phi_incr, Node* x, IdealLoopTree* loop);
 
   bool is_counted_loop(Node* n, IdealLoopTree* &loop);
+  bool is_long_counted_loop(Node* x, IdealLoopTree* &loop);
   IdealLoopTree* insert_outer_loop(IdealLoopTree* loop, LoopNode* outer_l, Node* outer_ift);
   IdealLoopTree* create_outer_strip_mined_loop(BoolNode *test, Node *cmp, Node *init_control,
                                                IdealLoopTree* loop, float cl_prob, float le_fcnt,
@@ -1143,6 +1143,12 @@ bool PhaseMacroExpand::eliminate_allocate_node(AllocateNode *alloc) {
 
   process_users_of_allocation(alloc);
 
+  if (boxing_alloc) {
+    C->inc_eliminated_boxes();
+  } else {
+    C->inc_eliminated_allocations();
+  }
+
 #ifndef PRODUCT
   if (PrintEliminateAllocations) {
     if (alloc->is_AllocateArray())
@@ -1183,6 +1189,7 @@ bool PhaseMacroExpand::eliminate_boxing_node(CallStaticJavaNode *boxing) {
   }
 
   process_users_of_allocation(boxing);
+  C->inc_eliminated_boxes();
 
 #ifndef PRODUCT
   if (PrintEliminateAllocations) {
@@ -1395,6 +1395,42 @@ static bool stable_phi(PhiNode* phi, PhaseGVN *phase) {
   }
   return true;
 }
+//------------------------------is_load_from_allocation_merge------------------
+// Check if this is a field load whose base is a Phi that merges newly
+// allocated objects, possibly with non-null constants. As long as the Phi
+// is used, escape analysis can not scalar replace the merged allocations.
+// Splitting the load through the Phi removes such a use.
+bool LoadNode::is_load_from_allocation_merge(PhaseGVN* phase) const {
+  if (!SplitLoadsThroughAllocationMerges || !EliminateAllocations ||
+      !phase->C->do_escape_analysis()) {
+    return false;
+  }
+  Node* address = in(Address);
+  const TypeOopPtr* t_oop = phase->type(address)->isa_oopptr();
+  if (t_oop == NULL || t_oop->isa_instptr() == NULL ||
+      t_oop->offset() == Type::OffsetBot || !address->is_AddP()) {
+    return false;
+  }
+  intptr_t ignore = 0;
+  Node* base = AddPNode::Ideal_base_and_offset(address, phase, ignore);
+  if (base == NULL || !base->is_Phi() || base != address->in(AddPNode::Base)) {
+    return false;
+  }
+  bool has_allocation = false;
+  for (uint i = 1; i < base->req(); i++) {
+    Node* in = base->in(i);
+    if (in == NULL || phase->type(in) == Type::TOP) {
+      return false; // Wait stable graph
+    }
+    if (AllocateNode::Ideal_allocation(in, phase) != NULL) {
+      has_allocation = true;
+    } else if (!in->is_Con() || !phase->type(in)->higher_equal(TypePtr::NOTNULL)) {
+      return false;
+    }
+  }
+  return has_allocation;
+}
+
 //------------------------------split_through_phi------------------------------
 // Split instance or boxed field load through Phi.
 Node *LoadNode::split_through_phi(PhaseGVN *phase) {
@@ -1404,7 +1440,8 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
 
   assert((t_oop != NULL) &&
          (t_oop->is_known_instance_field() ||
-          t_oop->is_ptr_to_boxed_value()), "invalide conditions");
+          t_oop->is_ptr_to_boxed_value() ||
+          is_load_from_allocation_merge(phase)), "invalide conditions");
 
   Compile* C = phase->C;
   intptr_t ignore = 0;
@@ -1413,9 +1450,11 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   bool load_boxed_values = t_oop->is_ptr_to_boxed_value() && C->aggressive_unboxing() &&
                            (base != NULL) && (base == address->in(AddPNode::Base)) &&
                            phase->type(base)->higher_equal(TypePtr::NOTNULL);
+  bool load_from_merge = !t_oop->is_known_instance_field() && !load_boxed_values &&
+                         is_load_from_allocation_merge(phase);
 
   if (!((mem->is_Phi() || base_is_phi) &&
-        (load_boxed_values || t_oop->is_known_instance_field()))) {
+        (load_boxed_values || load_from_merge || t_oop->is_known_instance_field()))) {
     return NULL; // memory is not Phi
   }
 
@@ -1500,8 +1539,8 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   int this_index  = C->get_alias_index(t_oop);
   int this_offset = t_oop->offset();
   int this_iid    = t_oop->instance_id();
-  if (!t_oop->is_known_instance() && load_boxed_values) {
-    // Use _idx of address base for boxed values.
+  if (!t_oop->is_known_instance() && (load_boxed_values || load_from_merge)) {
+    // Use _idx of address base for boxed values and merged allocations.
     this_iid = base->_idx;
   }
   PhaseIterGVN* igvn = phase->is_IterGVN();
@@ -1658,7 +1697,8 @@ Node *LoadNode::Ideal(PhaseGVN *phase, bool can_reshape) {
     const TypeOopPtr *t_oop = addr_t->isa_oopptr();
     if ((t_oop != NULL) &&
         (t_oop->is_known_instance_field() ||
-         t_oop->is_ptr_to_boxed_value())) {
+         t_oop->is_ptr_to_boxed_value() ||
+         is_load_from_allocation_merge(phase))) {
       PhaseIterGVN *igvn = phase->is_IterGVN();
       if (igvn != NULL && igvn->_worklist.member(opt_mem)) {
         // Delay this transformation until memory Phi is processed.
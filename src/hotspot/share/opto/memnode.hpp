@@ -246,6 +246,7 @@ public:
 
   // Split instance field load through Phi.
   Node* split_through_phi(PhaseGVN *phase);
+  bool is_load_from_allocation_merge(PhaseGVN* phase) const;
 
   // Recover original value from boxed values
   Node *eliminate_autobox(PhaseGVN *phase);
@@ -176,6 +176,45 @@ CMoveNode *CMoveNode::make(Node *c, Node *bol, Node *left, Node *right, const Ty
 }
 
 //=============================================================================
+//------------------------------Ideal_minmax-----------------------------------
+// Match CMoveI(Bool(CmpI(a, b), lt|le|gt|ge), b, a) and the variant with the
+// selected values swapped.
+Node* CMoveINode::Ideal_minmax(PhaseGVN* phase) {
+  if (!in(Condition)->is_Bool()) return NULL;
+  BoolNode* bol = in(Condition)->as_Bool();
+  Node* cmp = bol->in(1);
+  if (cmp->Opcode() != Op_CmpI) return NULL;
+
+  bool is_min;
+  switch (bol->_test._test) {
+  case BoolTest::lt:
+  case BoolTest::le:
+    is_min = true;
+    break;
+  case BoolTest::gt:
+  case BoolTest::ge:
+    is_min = false;
+    break;
+  default:
+    return NULL;
+  }
+
+  Node* a = cmp->in(1);
+  Node* b = cmp->in(2);
+  if (in(IfTrue) == b && in(IfFalse) == a) {
+    // The test selects the other value
+    is_min = !is_min;
+  } else if (in(IfTrue) != a || in(IfFalse) != b) {
+    return NULL;
+  }
+
+  if (is_min) {
+    return new MinINode(a, b);
+  } else {
+    return new MaxINode(a, b);
+  }
+}
+
 //------------------------------Ideal------------------------------------------
 // Return a node which is more "ideal" than the current node.
 // Check for conversions to boolean
@@ -184,6 +223,12 @@ Node *CMoveINode::Ideal(PhaseGVN *phase, bool can_reshape) {
   Node *x = CMoveNode::Ideal(phase, can_reshape);
   if( x ) return x;
 
+  // Convert a move that selects the smaller or the larger of the two compared
+  // values into MinI or MaxI. Loops like 'if (a[i] > m) m = a[i]' are then
+  // picked up by SuperWord as vectorizable min/max reductions.
+  x = Ideal_minmax(phase);
+  if (x != NULL) return x;
+
   // If zero is on the left (false-case, no-move-case) it must mean another
   // constant is on the right (otherwise the shared CMove::Ideal code would
   // have moved the constant to the right).  This situation is bad for Intel
@@ -74,6 +74,7 @@ class CMoveINode : public CMoveNode {
   CMoveINode( Node *bol, Node *left, Node *right, const TypeInt *ti ) : CMoveNode(bol,left,right,ti){}
   virtual int Opcode() const;
   virtual Node *Ideal(PhaseGVN *phase, bool can_reshape);
+  Node* Ideal_minmax(PhaseGVN* phase);
 };
 
 //------------------------------CMoveLNode-------------------------------------
@@ -275,7 +275,7 @@ void PhaseOutput::Output() {
   // The number of new nodes (mostly MachNop) is proportional to
   // the number of java calls and inner loops which are aligned.
   if ( C->check_node_count((NodeLimitFudgeFactor + C->java_calls()*3 +
-                            C->inner_loops()*(OptoLoopAlignment-1)),
+                            C->inner_loops()*(MAX2(OptoLoopAlignment, OptoHotLoopAlignment)-1)),
                            "out of nodes before code generation" ) ) {
     return;
   }
@@ -641,7 +641,7 @@ public:
 
 // Estimate cost of performing a binary search on lo..hi
 static float compute_tree_cost(SwitchRange *lo, SwitchRange *hi, float total_cnt) {
-  GrowableArray<SwitchRanges> tree;
+  GrowableArrayInline<SwitchRanges, 16> tree;
   SwitchRanges root(lo, hi);
   tree.push(root);
 
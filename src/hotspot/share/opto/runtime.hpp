@@ -292,9 +292,12 @@ private:
   static const TypeFunc* bigIntegerShift_Type();
 
   static const TypeFunc* vectorizedMismatch_Type();
+  static const TypeFunc* vectorizedHashCode_Type();
 
   static const TypeFunc* ghash_processBlocks_Type();
   static const TypeFunc* base64_encodeBlock_Type();
+  static const TypeFunc* chacha20Block_Type();
+  static const TypeFunc* base64_decodeBlock_Type();
 
   static const TypeFunc* updateBytesCRC32_Type();
   static const TypeFunc* updateBytesCRC32C_Type();
@@ -332,6 +335,9 @@ private:
  // dumps all the named counters
  static void          print_named_counters();
 
+ // head of the list of named counters, for walking it outside of printing
+ static NamedCounter* named_counters() { return _named_counters; }
+
 };
 
 #endif // SHARE_OPTO_RUNTIME_HPP
@@ -1696,6 +1696,7 @@ ciTypeArray* PhaseStringOpts::get_constant_value(GraphKit& kit, Node* str) {
 void PhaseStringOpts::replace_string_concat(StringConcat* sc) {
   // Log a little info about the transformation
   sc->maybe_log_transform();
+  C->inc_optimized_string_concats();
 
   // pull the JVMState of the allocation into a SafePointNode to serve as
   // as a shim for the insertion of the new code.
@@ -4743,7 +4743,7 @@ bool SuperWord::pack_parallel() {
 }
 
 bool SuperWord::hoist_loads_in_graph() {
-  GrowableArray<Node*> loads;
+  GrowableArrayInline<Node*, 16> loads;
 
 #ifndef PRODUCT
   if (_vector_loop_debug) {
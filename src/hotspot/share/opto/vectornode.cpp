@@ -203,6 +203,10 @@ int VectorNode::opcode(int sopc, BasicType bt) {
   case Op_XorI:
   case Op_XorL:
     return Op_XorV;
+  case Op_MinI:
+    return (bt == T_INT) ? Op_MinV : 0; // Subword min/max are not supported
+  case Op_MaxI:
+    return (bt == T_INT) ? Op_MaxV : 0;
   case Op_MinF:
     assert(bt == T_FLOAT, "must be");
     return Op_MinV;
@@ -739,6 +743,14 @@ int ReductionNode::opcode(int opc, BasicType bt) {
       assert(bt == T_DOUBLE, "must be");
       vopc = Op_MulReductionVD;
       break;
+    case Op_MinI:
+      assert(bt == T_INT, "must be");
+      vopc = Op_MinReductionV;
+      break;
+    case Op_MaxI:
+      assert(bt == T_INT, "must be");
+      vopc = Op_MaxReductionV;
+      break;
     case Op_MinF:
       assert(bt == T_FLOAT, "must be");
       vopc = Op_MinReductionV;
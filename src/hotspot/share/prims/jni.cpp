@@ -3003,11 +3003,43 @@ HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_RETURN();
 JNI_END
 
 
+// The characters of a String live in its value array, which is a separate
+// object that may be in another region than the String itself, so it is the
+// value array that has to be pinned. Latin1 strings are inflated into a C heap
+// copy and need neither pinning nor the GCLocker when pinning is supported.
+static typeArrayOop lock_gc_or_pin_string_value(JavaThread* thread, oop str) {
+  if (Universe::heap()->supports_object_pinning()) {
+    typeArrayOop s_value = java_lang_String::value(str);
+    if (java_lang_String::is_latin1(str)) {
+      return s_value;
+    }
+    return (typeArrayOop) Universe::heap()->pin_object(thread, s_value);
+  } else {
+    Handle h(thread, str);      // Handlize across potential safepoint.
+    GCLocker::lock_critical(thread);
+    return java_lang_String::value(h());
+  }
+}
+
+static void unlock_gc_or_unpin_string_value(JavaThread* thread, oop str, const jchar* chars) {
+  if (Universe::heap()->supports_object_pinning()) {
+    if (!java_lang_String::is_latin1(str)) {
+      // Unpin the array the characters were handed out from, which is not
+      // necessarily the current value of the String.
+      oop s_value = oop((HeapWord*)((address)chars - arrayOopDesc::base_offset_in_bytes(T_CHAR)));
+      Universe::heap()->unpin_object(thread, s_value);
+    }
+  } else {
+    GCLocker::unlock_critical(thread);
+  }
+}
+
 JNI_ENTRY(const jchar*, jni_GetStringCritical(JNIEnv *env, jstring string, jboolean *isCopy))
   JNIWrapper("GetStringCritical");
   HOTSPOT_JNI_GETSTRINGCRITICAL_ENTRY(env, string, (uintptr_t *) isCopy);
-  oop s = lock_gc_or_pin_object(thread, string);
-  typeArrayOop s_value = java_lang_String::value(s);
+  oop s = JNIHandles::resolve_non_null(string);
+  typeArrayOop s_value = lock_gc_or_pin_string_value(thread, s);
+  s = JNIHandles::resolve_non_null(string);
   bool is_latin1 = java_lang_String::is_latin1(s);
   if (isCopy != NULL) {
     *isCopy = is_latin1 ? JNI_TRUE : JNI_FALSE;
@@ -3043,7 +3075,7 @@ JNI_ENTRY(void, jni_ReleaseStringCritical(JNIEnv *env, jstring str, const jchar
     // This assumes that ReleaseStringCritical bookends GetStringCritical.
     FREE_C_HEAP_ARRAY(jchar, chars);
   }
-  unlock_gc_or_unpin_object(thread, str);
+  unlock_gc_or_unpin_string_value(thread, s, chars);
 HOTSPOT_JNI_RELEASESTRINGCRITICAL_RETURN();
 JNI_END
 
@@ -45,6 +45,7 @@
 #include "logging/log.hpp"
 #include "memory/dynamicArchive.hpp"
 #include "memory/heapShared.hpp"
+#include "memory/lambdaFormInvokers.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/referenceType.hpp"
 #include "memory/resourceArea.hpp"
@@ -3842,6 +3843,31 @@ JVM_ENTRY(jboolean, JVM_IsCDSSharingEnabled(JNIEnv* env))
     return UseSharedSpaces;
 JVM_END
 
+JVM_ENTRY(jboolean, JVM_IsDumpingClassList(JNIEnv* env))
+  JVMWrapper("JVM_IsDumpingClassList");
+#if INCLUDE_CDS
+  return DumpLoadedClassList != NULL && classlist_file != NULL && classlist_file->is_open();
+#else
+  return false;
+#endif // INCLUDE_CDS
+JVM_END
+
+// Record a LambdaForm resolved or spun by java.lang.invoke, so that the holder
+// classes can be regenerated to include it when the static archive is dumped.
+JVM_ENTRY(void, JVM_LogLambdaFormInvoker(JNIEnv* env, jstring line))
+  JVMWrapper("JVM_LogLambdaFormInvoker");
+#if INCLUDE_CDS
+  assert(DumpLoadedClassList != NULL && classlist_file->is_open(), "should be set and open");
+  if (line != NULL) {
+    ResourceMark rm(THREAD);
+    Handle h_line(THREAD, JNIHandles::resolve_non_null(line));
+    char* c_line = java_lang_String::as_utf8_string(h_line());
+    classlist_file->print_cr("%s %s", LambdaFormInvokers::lambda_form_invoker_tag(), c_line);
+    classlist_file->flush();
+  }
+#endif // INCLUDE_CDS
+JVM_END
+
 JVM_ENTRY_NO_ENV(jlong, JVM_GetRandomSeedForCDSDump())
   JVMWrapper("JVM_GetRandomSeedForCDSDump");
   if (DumpSharedSpaces) {
@@ -1591,11 +1591,14 @@ JvmtiEnv::GetThreadListStackTraces(jint thread_count, const jthread* thread_list
       *stack_info_ptr = op.stack_info();
     }
   } else {
-    // JVMTI get stack traces at safepoint.
+    // JVMTI get stack traces at safepoint. The buffers are preallocated
+    // and the result copied out here, outside of the safepoint.
+    ResourceMark rm;
     VM_GetThreadListStackTraces op(this, thread_count, thread_list, max_frame_count);
     VMThread::execute(&op);
     err = op.result();
     if (err == JVMTI_ERROR_NONE) {
+      op.allocate_and_fill_stacks();
       *stack_info_ptr = op.stack_info();
     }
   }
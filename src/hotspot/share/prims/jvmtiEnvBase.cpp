@@ -976,7 +976,10 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
       if (!mark.has_monitor()) {
         // this object has a lightweight monitor
 
-        if (mark.has_locker()) {
+        if (mark.is_fast_locked()) {
+          // the owner is found on its lock stack
+          owning_thread = Threads::owning_thread_from_object(tlh.list(), hobj());
+        } else if (mark.has_locker()) {
           owner = (address)mark.locker(); // save the address of the Lock word
         }
         // implied else: no owner
@@ -996,8 +999,12 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
 
     if (owner != NULL) {
       // This monitor is owned so we have to find the owning JavaThread.
-      owning_thread = Threads::owning_thread_from_monitor_owner(tlh.list(), owner);
+      owning_thread = (mon != NULL) ? Threads::owning_thread_from_monitor(tlh.list(), mon)
+                                    : Threads::owning_thread_from_monitor_owner(tlh.list(), owner);
       assert(owning_thread != NULL, "owning JavaThread must not be NULL");
+    }
+
+    if (owning_thread != NULL) {
       Handle     th(current_thread, owning_thread->threadObj());
       ret.owner = (jthread)jni_reference(calling_thread, th);
     }
@@ -1150,9 +1157,19 @@ struct StackInfoNode {
   jvmtiStackInfo info;
 };
 
+// Allocate the nodes and frame buffers for thread_count threads up front
+// in the resource area of the current thread.
+void
+MultipleStackTracesCollector::preallocate(jint thread_count) {
+  _nodes = NEW_RESOURCE_ARRAY(struct StackInfoNode, thread_count);
+  _frames = NEW_RESOURCE_ARRAY(jvmtiFrameInfo, (size_t)thread_count * max_frame_count());
+  _node_count = 0;
+}
+
 // Create a jvmtiStackInfo inside a linked list node and create a
-// buffer for the frame information, both allocated as resource objects.
-// Fill in both the jvmtiStackInfo and the jvmtiFrameInfo.
+// buffer for the frame information, both allocated as resource objects
+// unless they were preallocated. Fill in both the jvmtiStackInfo and the
+// jvmtiFrameInfo.
 // Note that either or both of thr and thread_oop
 // may be null if the thread is new or has exited.
 void
@@ -1166,7 +1183,16 @@ MultipleStackTracesCollector::fill_frames(jthread jt, JavaThread *thr, oop threa
 #endif
 
   jint state = 0;
-  struct StackInfoNode *node = NEW_RESOURCE_OBJ(struct StackInfoNode);
+  struct StackInfoNode *node;
+  jvmtiFrameInfo *frame_buffer;
+  if (_nodes != NULL) {
+    node = &_nodes[_node_count];
+    frame_buffer = _frames + (size_t)_node_count * max_frame_count();
+    _node_count++;
+  } else {
+    node = NEW_RESOURCE_OBJ(struct StackInfoNode);
+    frame_buffer = NULL;
+  }
   jvmtiStackInfo *infop = &(node->info);
   node->next = head();
   set_head(node);
@@ -1194,7 +1220,8 @@ MultipleStackTracesCollector::fill_frames(jthread jt, JavaThread *thr, oop threa
   infop->state = state;
 
   if (thr != NULL && (state & JVMTI_THREAD_STATE_ALIVE) != 0) {
-    infop->frame_buffer = NEW_RESOURCE_ARRAY(jvmtiFrameInfo, max_frame_count());
+    infop->frame_buffer = frame_buffer != NULL ? frame_buffer
+                                               : NEW_RESOURCE_ARRAY(jvmtiFrameInfo, max_frame_count());
     env()->get_stack_trace(thr, 0, max_frame_count(),
                            infop->frame_buffer, &(infop->frame_count));
   } else {
@@ -1263,7 +1290,6 @@ VM_GetThreadListStackTraces::doit() {
     }
     _collector.fill_frames(jt, java_thread, thread_oop);
   }
-  _collector.allocate_and_fill_stacks(_thread_count);
 }
 
 void
@@ -472,6 +472,11 @@ private:
   jvmtiError _result;
   int _frame_count_total;
   struct StackInfoNode *_head;
+  // Optional storage for the nodes and frame buffers, preallocated by the
+  // requesting thread so that fill_frames does not allocate.
+  struct StackInfoNode *_nodes;
+  jvmtiFrameInfo *_frames;
+  jint _node_count;
 
   JvmtiEnvBase *env()                 { return (JvmtiEnvBase *)_env; }
   jint max_frame_count()              { return _max_frame_count; }
@@ -485,9 +490,13 @@ public:
       _stack_info(NULL),
       _result(JVMTI_ERROR_NONE),
       _frame_count_total(0),
-      _head(NULL) {
+      _head(NULL),
+      _nodes(NULL),
+      _frames(NULL),
+      _node_count(0) {
   }
   void set_result(jvmtiError result)  { _result = result; }
+  void preallocate(jint thread_count);
   void fill_frames(jthread jt, JavaThread *thr, oop thread_oop);
   void allocate_and_fill_stacks(jint thread_count);
   jvmtiStackInfo *stack_info()       { return _stack_info; }
@@ -517,6 +526,10 @@ public:
 };
 
 // VM operation to get stack trace at safepoint.
+// The JVMTI spec requires the stacks to be collected simultaneously, so a
+// safepoint is needed. To keep it short, the frame buffers are allocated by
+// the requesting thread in its resource area before the safepoint, and the
+// result is copied into JVMTI memory by allocate_and_fill_stacks() after it.
 class VM_GetThreadListStackTraces : public VM_Operation {
 private:
   jint _thread_count;
@@ -528,9 +541,11 @@ public:
       : _thread_count(thread_count),
         _thread_list(thread_list),
         _collector(env, max_frame_count) {
+    _collector.preallocate(thread_count);
   }
   VMOp_Type type() const { return VMOp_GetThreadListStackTraces; }
   void doit();
+  void allocate_and_fill_stacks() { _collector.allocate_and_fill_stacks(_thread_count); }
   jvmtiStackInfo *stack_info()    { return _collector.stack_info(); }
   jvmtiError result()             { return _collector.result(); }
 };
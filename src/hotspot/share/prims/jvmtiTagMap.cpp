@@ -134,6 +134,14 @@ class JvmtiTagHashmapEntry : public CHeapObj<mtInternal> {
 // A hashmap provides functions for adding, removing, and finding
 // entries. It also provides a function to iterate over all entries
 // in the hashmap.
+//
+// Because the key is the object's address, entries for objects that
+// the GC has moved are in the wrong chain. The GC does not relink
+// them; it only updates the entries and marks the hashmap as needing
+// rehashing, and the entries are rehashed by the next lookup. An
+// agent that tags many objects but only queries them occasionally
+// thus pays for one rehash per query rather than one per GC, and not
+// in the GC pause.
 
 class JvmtiTagHashmap : public CHeapObj<mtInternal> {
  private:
@@ -155,6 +163,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   float _load_factor;                   // load factor as a % of the size
   int _resize_threshold;                // computed threshold to trigger resizing.
   bool _resizing_enabled;               // indicates if hashmap can resize
+  bool _needs_rehashing;                // objects have moved since the last rehash
 
   int _trace_threshold;                 // threshold for trace messages
 
@@ -174,6 +183,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
     _load_factor = load_factor;
     _resize_threshold = (int)(_load_factor * _size);
     _resizing_enabled = true;
+    _needs_rehashing = false;
     size_t s = initial_size * sizeof(JvmtiTagHashmapEntry*);
     _table = (JvmtiTagHashmapEntry**)os::malloc(s, mtInternal);
     if (_table == NULL) {
@@ -197,6 +207,37 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
     return hash(key, _size);
   }
 
+  // relink all entries into the chains for the current object addresses
+  void rehash() {
+    JvmtiTagHashmapEntry* all = NULL;
+    for (int i=0; i<_size; i++) {
+      JvmtiTagHashmapEntry* entry = _table[i];
+      while (entry != NULL) {
+        JvmtiTagHashmapEntry* next = entry->next();
+        entry->set_next(all);
+        all = entry;
+        entry = next;
+      }
+      _table[i] = NULL;
+    }
+    while (all != NULL) {
+      JvmtiTagHashmapEntry* next = all->next();
+      oop key = all->object_peek();
+      assert(key != NULL, "jni weak reference cleared!!");
+      unsigned int h = hash(key);
+      all->set_next(_table[h]);
+      _table[h] = all;
+      all = next;
+    }
+    _needs_rehashing = false;
+  }
+
+  inline void rehash_if_needed() {
+    if (_needs_rehashing) {
+      rehash();
+    }
+  }
+
   // resize the hashmap - allocates a large table and re-hashes
   // all entries into the new table.
   void resize() {
@@ -250,6 +291,9 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
 
     // compute new resize threshold
     _resize_threshold = (int)(_load_factor * _size);
+
+    // all entries are now in the chains for their current addresses
+    _needs_rehashing = false;
   }
 
 
@@ -270,6 +314,9 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   bool is_resizing_enabled() const          { return _resizing_enabled; }
   void set_resizing_enabled(bool enable)    { _resizing_enabled = enable; }
 
+  // called by the GC when it has moved tagged objects
+  void set_needs_rehashing()                { _needs_rehashing = true; }
+
   // debugging
   void print_memory_usage();
   void compute_next_trace_threshold();
@@ -317,6 +364,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
 
   // find an entry in the hashmap, returns NULL if not found.
   inline JvmtiTagHashmapEntry* find(oop key) {
+    rehash_if_needed();
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* entry = _table[h];
     while (entry != NULL) {
@@ -333,6 +381,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   inline void add(oop key, JvmtiTagHashmapEntry* entry) {
     assert(key != NULL, "checking");
     assert(find(key) == NULL, "duplicate detected");
+    rehash_if_needed();
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* anchor = _table[h];
     if (anchor == NULL) {
@@ -357,6 +406,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
 
   // remove an entry with the given key.
   inline JvmtiTagHashmapEntry* remove(oop key) {
+    rehash_if_needed();
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* entry = _table[h];
     JvmtiTagHashmapEntry* prev = NULL;
@@ -3336,8 +3386,6 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
   JvmtiTagHashmapEntry** table = hashmap->table();
   int size = hashmap->size();
 
-  JvmtiTagHashmapEntry* delayed_add = NULL;
-
   for (int pos = 0; pos < size; ++pos) {
     JvmtiTagHashmapEntry* entry = table[pos];
     JvmtiTagHashmapEntry* prev = NULL;
@@ -3363,45 +3411,23 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
 
         ++freed;
       } else {
+        oop old_oop = entry->object_raw();
         f->do_oop(entry->object_addr());
-        oop new_oop = entry->object_raw();
-
-        // if the object has moved then re-hash it and move its
-        // entry to its new location.
-        unsigned int new_pos = JvmtiTagHashmap::hash(new_oop, size);
-        if (new_pos != (unsigned int)pos) {
-          if (prev == NULL) {
-            table[pos] = next;
-          } else {
-            prev->set_next(next);
-          }
-          if (new_pos < (unsigned int)pos) {
-            entry->set_next(table[new_pos]);
-            table[new_pos] = entry;
-          } else {
-            // Delay adding this entry to it's new position as we'd end up
-            // hitting it again during this iteration.
-            entry->set_next(delayed_add);
-            delayed_add = entry;
-          }
+
+        // if the object has moved then its entry is now in the wrong
+        // chain; leave it there and let the next lookup rehash
+        if (entry->object_raw() != old_oop) {
           moved++;
-        } else {
-          // object didn't move
-          prev = entry;
         }
+        prev = entry;
       }
 
       entry = next;
     }
   }
 
-  // Re-add all the entries which were kept aside
-  while (delayed_add != NULL) {
-    JvmtiTagHashmapEntry* next = delayed_add->next();
-    unsigned int pos = JvmtiTagHashmap::hash(delayed_add->object_raw(), size);
-    delayed_add->set_next(table[pos]);
-    table[pos] = delayed_add;
-    delayed_add = next;
+  if (moved > 0) {
+    hashmap->set_needs_rehashing();
   }
 
   log_debug(jvmti, objecttagging)("(%d->%d, %d freed, %d total moves)",
@@ -115,15 +115,19 @@ int StackWalk::fill_in_frames(jlong mode, BaseFrameStream& stream,
   assert(max_nframes > 0, "invalid max_nframes");
   assert(start_index + max_nframes <= frames_array->length(), "oob");
 
+  // skip hidden frames for default StackWalker option (i.e. SHOW_HIDDEN_FRAMES
+  // not set) and when StackWalker::getCallerClass is called
+  const bool skip_hidden = !ShowHiddenFrames && (skip_hidden_frames(mode) || get_caller_class(mode));
+  const bool check_caller_sensitive = !need_method_info(mode) && get_caller_class(mode);
+
+  stream.start_batch();
   int frames_decoded = 0;
   for (; !stream.at_end(); stream.next()) {
     Method* method = stream.method();
 
     if (method == NULL) continue;
 
-    // skip hidden frames for default StackWalker option (i.e. SHOW_HIDDEN_FRAMES
-    // not set) and when StackWalker::getCallerClass is called
-    if (!ShowHiddenFrames && (skip_hidden_frames(mode) || get_caller_class(mode))) {
+    if (skip_hidden) {
       if (method->is_hidden()) {
         LogTarget(Debug, stackwalk) lt;
         if (lt.is_enabled()) {
@@ -147,8 +151,7 @@ int StackWalk::fill_in_frames(jlong mode, BaseFrameStream& stream,
       ls.print_cr(" bci=%d", stream.bci());
     }
 
-    if (!need_method_info(mode) && get_caller_class(mode) &&
-          index == start_index && method->caller_sensitive()) {
+    if (check_caller_sensitive && index == start_index && method->caller_sensitive()) {
       ResourceMark rm(THREAD);
       THROW_MSG_0(vmSymbols::java_lang_UnsupportedOperationException(),
         err_msg("StackWalker::getCallerClass called from @CallerSensitive '%s' method",
@@ -166,7 +169,7 @@ void LiveFrameStream::fill_frame(int index, objArrayHandle  frames_array,
                                  const methodHandle& method, TRAPS) {
   HandleMark hm(THREAD);
   Handle stackFrame(THREAD, frames_array->obj_at(index));
-  fill_live_stackframe(stackFrame, method, CHECK);
+  fill_live_stackframe(stackFrame, method, index, frames_array, CHECK);
 }
 
 // Fill in the StackFrameInfo at the given index in frames_array
@@ -175,7 +178,7 @@ void JavaFrameStream::fill_frame(int index, objArrayHandle  frames_array,
   if (_need_method_info) {
     HandleMark hm(THREAD);
     Handle stackFrame(THREAD, frames_array->obj_at(index));
-    fill_stackframe(stackFrame, method, CHECK);
+    fill_stackframe(stackFrame, method, index, frames_array, CHECK);
   } else {
     frames_array->obj_at_put(index, method->method_holder()->java_mirror());
   }
@@ -278,14 +281,22 @@ objArrayHandle LiveFrameStream::monitors_to_object_array(GrowableArray<MonitorIn
 }
 
 // Fill StackFrameInfo with bci and initialize memberName
-void BaseFrameStream::fill_stackframe(Handle stackFrame, const methodHandle& method, TRAPS) {
-  java_lang_StackFrameInfo::set_method_and_bci(stackFrame, method, bci(), THREAD);
+void BaseFrameStream::fill_stackframe(Handle stackFrame, const methodHandle& method,
+                                      int index, objArrayHandle frames_array, TRAPS) {
+  if (method() == _last_method) {
+    java_lang_StackFrameInfo::copy_method_and_set_bci(stackFrame(), frames_array->obj_at(_last_index), bci());
+  } else {
+    java_lang_StackFrameInfo::set_method_and_bci(stackFrame, method, bci(), CHECK);
+  }
+  _last_method = method();
+  _last_index = index;
 }
 
 // Fill LiveStackFrameInfo with locals, monitors, and expressions
 void LiveFrameStream::fill_live_stackframe(Handle stackFrame,
-                                           const methodHandle& method, TRAPS) {
-  fill_stackframe(stackFrame, method, CHECK);
+                                           const methodHandle& method,
+                                           int index, objArrayHandle frames_array, TRAPS) {
+  fill_stackframe(stackFrame, method, index, frames_array, CHECK);
   if (_jvf != NULL) {
     ResourceMark rm(THREAD);
     HandleMark hm(THREAD);
@@ -44,10 +44,22 @@ private:
 
   JavaThread*           _thread;
   jlong                 _anchor;
+
+  // The method of the last StackFrameInfo filled in the current batch,
+  // and its index in the frames array. A recursive call fills the next
+  // StackFrameInfo from it instead of resolving the method again.
+  Method*               _last_method;
+  int                   _last_index;
 protected:
-  void fill_stackframe(Handle stackFrame, const methodHandle& method, TRAPS);
+  void fill_stackframe(Handle stackFrame, const methodHandle& method,
+                       int index, objArrayHandle frames_array, TRAPS);
 public:
-  BaseFrameStream(JavaThread* thread) : _thread(thread), _anchor(0L) {}
+  BaseFrameStream(JavaThread* thread) : _thread(thread), _anchor(0L),
+    _last_method(NULL), _last_index(-1) {}
+
+  // Forget the last filled frame; the frames array may have been
+  // reused by the caller since the previous batch.
+  void start_batch() { _last_method = NULL; _last_index = -1; }
 
   virtual void    next()=0;
   virtual bool    at_end()=0;
@@ -99,7 +111,8 @@ private:
 
   javaVFrame*           _jvf;
 
-  void fill_live_stackframe(Handle stackFrame, const methodHandle& method, TRAPS);
+  void fill_live_stackframe(Handle stackFrame, const methodHandle& method,
+                            int index, objArrayHandle frames_array, TRAPS);
   static oop create_primitive_slot_instance(StackValueCollection* values,
                                             int i, BasicType type, TRAPS);
   static objArrayHandle monitors_to_object_array(GrowableArray<MonitorInfo*>* monitors,
@@ -55,6 +55,9 @@
 #include "utilities/copy.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/macros.hpp"
+#if INCLUDE_JFR
+#include "jfr/support/jfrNativeAllocationSampler.hpp"
+#endif
 
 /**
  * Implementation of the jdk.internal.misc.Unsafe class
@@ -366,6 +369,7 @@ UNSAFE_ENTRY(jlong, Unsafe_AllocateMemory0(JNIEnv *env, jobject unsafe, jlong si
   assert(is_aligned(sz, HeapWordSize), "sz not aligned");
 
   void* x = os::malloc(sz, mtOther);
+  JFR_ONLY(JfrNativeAllocationSampler::sample(x, sz, thread);)
 
   return addr_to_java(x);
 } UNSAFE_END
@@ -377,6 +381,7 @@ UNSAFE_ENTRY(jlong, Unsafe_ReallocateMemory0(JNIEnv *env, jobject unsafe, jlong
   assert(is_aligned(sz, HeapWordSize), "sz not aligned");
 
   void* x = os::realloc(p, sz, mtOther);
+  JFR_ONLY(JfrNativeAllocationSampler::sample(x, sz, thread);)
 
   return addr_to_java(x);
 } UNSAFE_END
@@ -189,6 +189,9 @@ class Abstract_VM_Version: AllStatic {
   // Does platform support fast class initialization checks for static methods?
   static bool supports_fast_class_init_checks() { return false; }
 
+  // Does platform support lightweight locking (UseLightweightLocking)?
+  static bool supports_lightweight_locking() { return false; }
+
   static bool print_matching_lines_from_file(const char* filename, outputStream* st, const char* keywords_to_match[]);
 };
 
@@ -2899,6 +2899,9 @@ jint Arguments::parse_each_vm_init_arg(const JavaVMInitArgs* args, bool* patch_m
       } else if (strcmp(tail, ":disable") == 0) {
         LogConfiguration::disable_logging();
         ret = true;
+      } else if (strcmp(tail, ":async") == 0) {
+        LogConfiguration::set_async_mode(true);
+        ret = true;
       } else if (*tail == '\0') {
         ret = LogConfiguration::parse_command_line_arguments();
         assert(ret, "-Xlog without arguments should never fail to parse");
@@ -3630,7 +3633,23 @@ void Arguments::extract_shared_archive_paths(const char* archive_path,
   *top_archive_path = cur_path;
 }
 
+void Arguments::set_shared_dynamic_archive_path(const char* path) {
+  if (SharedDynamicArchivePath != NULL) {
+    os::free(SharedDynamicArchivePath);
+  }
+  SharedDynamicArchivePath = os::strdup_check_oom(path, mtArguments);
+}
+
 bool Arguments::init_shared_archive_paths() {
+  if (AutoCreateSharedArchive) {
+    if (DumpSharedSpaces || ArchiveClassesAtExit != NULL) {
+      log_warning(cds)("-XX:+AutoCreateSharedArchive is ignored when dumping a shared archive");
+      FLAG_SET_DEFAULT(AutoCreateSharedArchive, false);
+    } else if (SharedArchiveFile == NULL || num_archives(SharedArchiveFile) != 1) {
+      log_warning(cds)("-XX:+AutoCreateSharedArchive requires -XX:SharedArchiveFile to specify a single archive file");
+      FLAG_SET_DEFAULT(AutoCreateSharedArchive, false);
+    }
+  }
   if (ArchiveClassesAtExit != NULL) {
     if (DumpSharedSpaces) {
       vm_exit_during_initialization("-XX:ArchiveClassesAtExit cannot be used with -Xshare:dump");
@@ -3668,10 +3687,22 @@ bool Arguments::init_shared_archive_paths() {
         int name_size;
         bool success =
           FileMapInfo::get_base_archive_name_from_header(temp_archive_path, &name_size, &SharedArchivePath);
-        if (!success) {
-          SharedArchivePath = temp_archive_path;
-        } else {
+        struct stat st;
+        if (success) {
           SharedDynamicArchivePath = temp_archive_path;
+        } else if (AutoCreateSharedArchive && os::stat(temp_archive_path, &st) != 0) {
+          // No dynamic archive yet. Run on top of the default base archive, the dynamic
+          // archive is created at exit (see MetaspaceShared::initialize_runtime_shared_and_meta_spaces()).
+          SharedArchivePath = get_default_shared_archive_path();
+          os::free(temp_archive_path);
+        } else {
+          if (AutoCreateSharedArchive) {
+            // Never overwrite a file that is not a dynamic archive.
+            log_warning(cds)("-XX:+AutoCreateSharedArchive is ignored: %s is not a dynamic archive",
+                             temp_archive_path);
+            FLAG_SET_DEFAULT(AutoCreateSharedArchive, false);
+          }
+          SharedArchivePath = temp_archive_path;
         }
       } else {
         extract_shared_archive_paths((const char*)SharedArchiveFile,
@@ -4149,6 +4180,26 @@ jint Arguments::apply_ergo() {
     UseBiasedLocking = false;
   }
 
+  if (UseLightweightLocking) {
+    if (!VM_Version::supports_lightweight_locking()) {
+      warning("Lightweight locking is not supported on this platform"
+              "; ignoring UseLightweightLocking flag.");
+      FLAG_SET_DEFAULT(UseLightweightLocking, false);
+    } else if (JVMCI_ONLY(EnableJVMCI ||) AOT_ONLY(UseAOT ||) false) {
+      // The JVMCI and AOT compilers still emit stack-locking code.
+      warning("Lightweight locking is not supported with JVMCI or AOT"
+              "; ignoring UseLightweightLocking flag.");
+      FLAG_SET_DEFAULT(UseLightweightLocking, false);
+    }
+  }
+  if (UseLightweightLocking && UseBiasedLocking) {
+    if (!FLAG_IS_DEFAULT(UseBiasedLocking)) {
+      warning("Biased Locking is not supported with lightweight locking"
+              "; ignoring UseBiasedLocking flag.");
+    }
+    FLAG_SET_DEFAULT(UseBiasedLocking, false);
+  }
+
 #ifdef ZERO
   // Clear flags not supported on zero.
   FLAG_SET_DEFAULT(ProfileInterpreter, false);
@@ -62,7 +62,10 @@ void BasicLock::move_to(oop obj, BasicLock* dest) {
   // is small (given the support for inflated fast-path locking in the fast_lock, etc)
   // we'll leave that optimization for another time.
 
-  if (displaced_header().is_neutral()) {
+  if (UseLightweightLocking) {
+    // The lock is recorded on the owning thread's lock stack, not in the
+    // BasicLock, so there is nothing to move.
+  } else if (displaced_header().is_neutral()) {
     // The object is locked and the resulting ObjectMonitor* will also be
     // locked so it can't be async deflated until ownership is dropped.
     ObjectSynchronizer::inflate_helper(obj);
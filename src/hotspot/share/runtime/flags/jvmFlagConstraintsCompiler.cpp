@@ -381,6 +381,26 @@ JVMFlag::Error RTMTotalCountIncrRateConstraintFunc(int value, bool verbose) {
 }
 
 #ifdef COMPILER2
+JVMFlag::Error OptoHotLoopAlignmentConstraintFunc(intx value, bool verbose) {
+  if (!is_power_of_2(value)) {
+    JVMFlag::printError(verbose,
+                        "OptoHotLoopAlignment (" INTX_FORMAT ") "
+                        "must be a power of two\n",
+                        value);
+    return JVMFlag::VIOLATES_CONSTRAINT;
+  }
+
+  if (value % relocInfo::addr_unit() != 0) {
+    JVMFlag::printError(verbose,
+                        "OptoHotLoopAlignment (" INTX_FORMAT ") must be "
+                        "multiple of NOP size (%d)\n",
+                        value, relocInfo::addr_unit());
+    return JVMFlag::VIOLATES_CONSTRAINT;
+  }
+
+  return JVMFlag::SUCCESS;
+}
+
 JVMFlag::Error LoopStripMiningIterConstraintFunc(uintx value, bool verbose) {
   if (UseCountedLoopSafepoints && LoopStripMiningIter == 0) {
     if (!FLAG_IS_DEFAULT(UseCountedLoopSafepoints) || !FLAG_IS_DEFAULT(LoopStripMiningIter)) {
@@ -54,6 +54,7 @@ COMPILER2_PRESENT(                                      \
   f(intx,  InteriorEntryAlignmentConstraintFunc)        \
   f(intx,  NodeLimitFudgeFactorConstraintFunc)          \
   f(uintx, LoopStripMiningIterConstraintFunc)           \
+  f(intx,  OptoHotLoopAlignmentConstraintFunc)          \
 )
 
 COMPILER_CONSTRAINTS(DECLARE_CONSTRAINT)
@@ -243,6 +243,9 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, UseGHASHIntrinsics, false, DIAGNOSTIC,                      \
           "Use intrinsics for GHASH versions of crypto")                    \
                                                                             \
+  product(bool, UseChaCha20Intrinsics, false, DIAGNOSTIC,                   \
+          "Use intrinsics for ChaCha20 key stream generation")              \
+                                                                            \
   product(bool, UseBASE64Intrinsics, false,                                 \
           "Use intrinsics for java.util.Base64")                            \
                                                                             \
@@ -302,6 +305,16 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, UseInlineCaches, true,                                      \
           "Use Inline Caches for virtual calls ")                           \
                                                                             \
+  product(intx, PolymorphicInlineCacheSize, 0, EXPERIMENTAL,                \
+          "Maximum number of receiver classes cached at an interface call " \
+          "site before it goes megamorphic (values below 2 disable "        \
+          "polymorphic inline caches, the default)")                        \
+          range(0, 16)                                                      \
+                                                                            \
+  product(bool, UseSecondarySupersTable, true, DIAGNOSTIC,                  \
+          "Look up secondary supers in a per-class hash table instead of "  \
+          "scanning them")                                                  \
+                                                                            \
   product(bool, InlineArrayCopy, true, DIAGNOSTIC,                          \
           "Inline arraycopy native that is known to be part of "            \
           "base library DLL")                                               \
@@ -331,6 +344,12 @@ const intx ObjectAlignmentInBytes = 8;
   notproduct(bool, StressCriticalJNINatives, false,                         \
           "Exercise register saving code in critical natives")              \
                                                                             \
+  product(bool, LeafCriticalJNINatives, false, EXPERIMENTAL,                \
+          "Call critical JNI entry points without leaving the Java thread " \
+          "state. Ignored by GCs that pin objects (G1, Shenandoah). The "   \
+          "native code must be short and must not block. Currently only "   \
+          "on x86_64")                                                      \
+                                                                            \
   product(bool, UseAESIntrinsics, false, DIAGNOSTIC,                        \
           "Use intrinsics for AES versions of crypto")                      \
                                                                             \
@@ -364,6 +383,9 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, UseVectorizedMismatchIntrinsic, false, DIAGNOSTIC,          \
           "Enables intrinsification of ArraysSupport.vectorizedMismatch()") \
                                                                             \
+  product(bool, UseVectorizedHashCodeIntrinsic, false, DIAGNOSTIC,          \
+          "Enables intrinsification of ArraysSupport.vectorizedHashCode()") \
+                                                                            \
   product(bool, UseCopySignIntrinsic, false, DIAGNOSTIC,                    \
           "Enables intrinsification of Math.copySign")                      \
                                                                             \
@@ -409,6 +431,15 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, AbortVMOnSafepointTimeout, false, DIAGNOSTIC,               \
           "Abort upon failure to reach safepoint (see SafepointTimeout)")   \
                                                                             \
+  product(bool, ProfileTimeToSafepoint, false, DIAGNOSTIC,                  \
+          "Record where the threads that were the slowest to reach each "   \
+          "safepoint polled (see VM.safepoint_profile)")                    \
+                                                                            \
+  product(uint, ProfileTimeToSafepointThreads, 5, DIAGNOSTIC,               \
+          "Number of slowest threads recorded for each safepoint with "     \
+          "ProfileTimeToSafepoint")                                         \
+          range(1, 64)                                                      \
+                                                                            \
   product(bool, AbortVMOnVMOperationTimeout, false, DIAGNOSTIC,             \
           "Abort upon failure to complete VM operation promptly")           \
                                                                             \
@@ -552,6 +583,21 @@ const intx ObjectAlignmentInBytes = 8;
   product(ccstr, NativeMemoryTracking, "off",                               \
           "Native memory tracking options")                                 \
                                                                             \
+  product(uint, NativeMemoryTrackingSampleInterval, 1,                      \
+          "With NativeMemoryTracking=detail, record the call stack of only "\
+          "one in this many malloc calls, and count each recorded call "    \
+          "this many times. 1 records every call")                          \
+          range(1, max_jint)                                                \
+                                                                            \
+  product(bool, NativeMemoryTrackingPerThread, false,                       \
+          "With NativeMemoryTracking, count the bytes malloc'ed and freed " \
+          "by each thread, reported by jcmd VM.native_memory attribution")  \
+                                                                            \
+  product(bool, NativeMemoryTrackingResident, false,                        \
+          "With NativeMemoryTracking, also report how much of the "         \
+          "committed virtual memory is resident, and how much is backed "   \
+          "by transparent huge pages, as queried from the OS")              \
+                                                                            \
   product(bool, PrintNMTStatistics, false, DIAGNOSTIC,                      \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
@@ -682,6 +728,11 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, ClassUnloadingWithConcurrentMark, true,                     \
           "Do unloading of classes with a concurrent marking cycle")        \
                                                                             \
+  product(bool, DeferClassUnloadingPurge, false, EXPERIMENTAL,              \
+          "Free the metadata of classes unloaded by a full collection or "  \
+          "G1 remark on the ServiceThread after the pause instead of "      \
+          "during the pause")                                               \
+                                                                            \
   develop(bool, DisableStartThread, false,                                  \
           "Disable starting of additional Java threads "                    \
           "(for debugging only)")                                           \
@@ -718,12 +769,24 @@ const intx ObjectAlignmentInBytes = 8;
           "MonitorUsedDeflationThreshold is exceeded (0 is off).")          \
           range(0, max_jint)                                                \
                                                                             \
+  product(intx, MonitorDeflationMax, 1000000, DIAGNOSTIC,                   \
+          "The maximum number of monitors to deflate, unlink and delete "   \
+          "at one time (minimum is 1024).")                                 \
+          range(1024, max_jint)                                             \
+                                                                            \
   product(intx, MonitorUsedDeflationThreshold, 90, EXPERIMENTAL,            \
           "Percentage of used monitors before triggering deflation (0 is "  \
-          "off). The check is performed on GuaranteedSafepointInterval "    \
-          "or AsyncDeflationInterval.")                                     \
+          "off). The check is performed on GuaranteedSafepointInterval, "   \
+          "AsyncDeflationInterval or a combination. The percentage is "     \
+          "computed against the in-use list ceiling, which is estimated "   \
+          "from AvgMonitorsPerThreadEstimate and the thread count.")        \
           range(0, 100)                                                     \
                                                                             \
+  product(intx, AvgMonitorsPerThreadEstimate, 1024, DIAGNOSTIC,             \
+          "Used to estimate a variable ceiling based on number of threads " \
+          "for use with MonitorUsedDeflationThreshold (0 is off).")         \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, hashCode, 5, EXPERIMENTAL,                                  \
                "(Unstable) select hashCode generation algorithm")           \
                                                                             \
@@ -800,9 +863,19 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, RestrictContended, true,                                    \
           "Restrict @Contended to trusted classes")                         \
                                                                             \
+  product(ccstr, HotFieldsFile, NULL,                                       \
+          "File listing frequently accessed instance fields, one "          \
+          "'<class> <field>' pair per line. These fields are laid out "     \
+          "before the other fields of their class")                         \
+                                                                            \
   product(bool, UseBiasedLocking, false,                                    \
           "(Deprecated) Enable biased locking in JVM")                      \
                                                                             \
+  product(bool, UseLightweightLocking, false, EXPERIMENTAL,                 \
+          "Lock objects by CASing the lock bits of the mark word and "      \
+          "recording them on a per-thread lock stack, instead of "          \
+          "biased locking and displaced-header stack-locking")              \
+                                                                            \
   product(intx, BiasedLockingStartupDelay, 0,                               \
           "(Deprecated) Number of milliseconds to wait before enabling "    \
           "biased locking")                                                 \
@@ -1003,6 +1076,10 @@ const intx ObjectAlignmentInBytes = 8;
           range(0, max_jint)                                                \
           constraint(CICompilerCountConstraintFunc, AfterErgo)              \
                                                                             \
+  product(size_t, CompileArenaMemoryLimit, 0, EXPERIMENTAL,                 \
+          "Bail out of a compilation once its compiler arenas use more "    \
+          "than this many bytes (0 means no limit)")                        \
+                                                                            \
   product(bool, UseDynamicNumberOfCompilerThreads, true,                    \
           "Dynamically choose the number of parallel compiler threads")     \
                                                                             \
@@ -1155,6 +1232,15 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, DisplayVMOutputToStdout, false,                             \
           "If DisplayVMOutput is true, display all VM output to stdout")    \
                                                                             \
+  product(size_t, AsyncLogBufferSize, 2*M,                                  \
+          "Memory budget (in bytes) for the buffer of Asynchronous "        \
+          "Logging (-Xlog:async)")                                          \
+          range(100*K, 50*M)                                                \
+                                                                            \
+  product(bool, AsyncLogBlockWhenFull, false,                               \
+          "Make threads wait while the buffer of Asynchronous Logging "     \
+          "(-Xlog:async) is full, instead of dropping their messages")      \
+                                                                            \
   product(bool, ErrorFileToStderr, false,                                   \
           "If true, error data is printed to stderr instead of a file")     \
                                                                             \
@@ -1170,6 +1256,17 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, VerifyStringTableAtExit, false, DIAGNOSTIC,                 \
           "verify StringTable contents at exit")                            \
                                                                             \
+  product(uintx, ConcurrentTableWorkChunkLog2, 12, EXPERIMENTAL,            \
+          "Log2 of the number of buckets of the StringTable and "           \
+          "SymbolTable grown or cleaned between yield points")              \
+          range(1, 30)                                                      \
+                                                                            \
+  product(uintx, ConcurrentTableWorkTimeSliceMillis, 0, EXPERIMENTAL,       \
+          "Time the service thread may spend growing or cleaning the "      \
+          "StringTable or SymbolTable before it backs off for the same "    \
+          "time. 0 means never back off")                                   \
+          range(0, 1000)                                                    \
+                                                                            \
   notproduct(bool, PrintSymbolTableSizeHistogram, false,                    \
           "print histogram of the symbol table")                            \
                                                                             \
@@ -1628,6 +1725,10 @@ const intx ObjectAlignmentInBytes = 8;
           "The maximum expansion of Metaspace without full GC (in bytes)")  \
           range(0, max_uintx)                                               \
                                                                             \
+  product(bool, MetaspaceUncommitFreeChunks, true, DIAGNOSTIC,              \
+          "Uncommit the payload of free medium and humongous metaspace "    \
+          "chunks until they are reused")                                   \
+                                                                            \
   /* stack parameters */                                                    \
   product_pd(intx, StackYellowPages,                                        \
           "Number of yellow zone (recoverable overflows) pages of size "    \
@@ -1826,6 +1927,18 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, DumpReplayDataOnError, true,                                \
           "Record replay data for crashing compiler threads")               \
                                                                             \
+  product(ccstr, ProfileCacheFile, NULL, EXPERIMENTAL,                      \
+          "Read hot method profiles from this file at startup and lower "   \
+          "the compile thresholds of the recorded methods")                 \
+                                                                            \
+  product(ccstr, DumpProfileCacheFile, NULL, EXPERIMENTAL,                  \
+          "Write hot method profiles to this file at VM exit")              \
+                                                                            \
+  product(double, ProfileCacheThresholdScaling, 0.1, EXPERIMENTAL,          \
+          "Factor applied to the compile thresholds of methods recorded "   \
+          "in ProfileCacheFile")                                            \
+          range(0.001, 1.0)                                                 \
+                                                                            \
   product(bool, CICompilerCountPerCPU, false,                               \
           "1 compiler thread for log(N CPUs)")                              \
                                                                             \
@@ -1871,6 +1984,15 @@ const intx ObjectAlignmentInBytes = 8;
           "(-1 means no change)")                                           \
           range(min_jint, max_jint)                                         \
                                                                             \
+  product(ccstr, CompilerThreadCPUs, NULL,                                  \
+          "List of CPUs and CPU ranges (such as 0-3,8) compiler threads "   \
+          "are bound to (Linux only)")                                      \
+                                                                            \
+  product(uintx, CompilationCPULoadThreshold, 0,                            \
+          "Delay compilations while the system load average per active "    \
+          "processor is above this percentage (0 means never)")             \
+          range(0, 1000)                                                    \
+                                                                            \
   product(intx, VMThreadPriority, -1,                                       \
           "The native priority at which the VM thread should run "          \
           "(-1 means no change)")                                           \
@@ -2024,6 +2146,18 @@ const intx ObjectAlignmentInBytes = 8;
           "if coming from AOT")                                             \
           range(0, max_jint)                                                \
                                                                             \
+  product(intx, Tier4AOTInvocationThreshold, 0,                             \
+          "Compile at tier 4 without profiling at tier 3 if number of "     \
+          "method invocations crosses this threshold if coming from AOT "   \
+          "(0 means always profile at tier 3 first)")                       \
+          range(0, max_jint)                                                \
+                                                                            \
+  product(intx, Tier4AOTBackEdgeThreshold, 0,                               \
+          "Back edge threshold at which tier 4 OSR compilation is invoked " \
+          "without profiling at tier 3 if coming from AOT "                 \
+          "(0 means always profile at tier 3 first)")                       \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, Tier0AOTInvocationThreshold, 200, DIAGNOSTIC,               \
           "Switch to interpreter to profile if the number of method "       \
           "invocations crosses this threshold if coming from AOT "          \
@@ -2151,6 +2285,10 @@ const intx ObjectAlignmentInBytes = 8;
           "Maximum rate sampling interval (in milliseconds)")               \
           range(0, max_intx)                                                \
                                                                             \
+  product(bool, TieredPayoffSelection, false, EXPERIMENTAL,                 \
+          "Select compile tasks by their decayed event rate divided by "    \
+          "an estimate of the compilation cost, ignoring total counts")     \
+                                                                            \
   product(ccstr, CompilationMode, "default",                                \
           "Compilation modes: "                                             \
           "default: normal tiered compilation; "                            \
@@ -2386,12 +2524,25 @@ const intx ObjectAlignmentInBytes = 8;
   product(ccstr, SharedClassListFile, NULL,                                 \
           "Override the default CDS class list")                            \
                                                                             \
+  product(ccstr, PreloadClassListFile, NULL,                                \
+          "Load and link the classes named in the specified class list "   \
+          "(as written by DumpLoadedClassList) on background threads "      \
+          "during startup")                                                 \
+                                                                            \
+  product(uint, PreloadClassThreads, 2,                                     \
+          "Number of threads used for PreloadClassListFile")                \
+          range(1, 64)                                                      \
+                                                                            \
   product(ccstr, SharedArchiveFile, NULL,                                   \
           "Override the default location of the CDS archive file")          \
                                                                             \
   product(ccstr, ArchiveClassesAtExit, NULL,                                \
           "The path and name of the dynamic archive file")                  \
                                                                             \
+  product(bool, AutoCreateSharedArchive, false,                             \
+          "Use the dynamic archive given by -XX:SharedArchiveFile if it "   \
+          "is usable, otherwise create it at exit")                         \
+                                                                            \
   product(ccstr, ExtraSharedClassListFile, NULL,                            \
           "Extra classlist for building the CDS archive file")              \
                                                                             \
@@ -2403,6 +2554,11 @@ const intx ObjectAlignmentInBytes = 8;
            "do not map the archive")                                        \
            range(0, 2)                                                      \
                                                                             \
+  product(bool, ArchiveResolvedConstantPoolEntries, true, DIAGNOSTIC,       \
+          "Keep instance field and invokevirtual entries of the constant "  \
+          "pool cache that were resolved during -Xshare:dump within the "   \
+          "same class hierarchy, loader and module")                         \
+                                                                            \
   product(size_t, ArrayAllocatorMallocLimit, (size_t)-1, EXPERIMENTAL,      \
           "Allocation less than this value will be allocated "              \
           "using malloc. Larger allocations will use mmap.")                \
@@ -2477,6 +2633,10 @@ const intx ObjectAlignmentInBytes = 8;
   JFR_ONLY(product(ccstr, StartFlightRecording, NULL,                       \
           "Start flight recording with options"))                           \
                                                                             \
+  JFR_ONLY(product(size_t, NativeAllocationSampleInterval, 512*K,           \
+          "Number of native bytes a thread allocates through Unsafe "       \
+          "between two NativeMemoryAllocationSample events"))               \
+                                                                            \
   product(bool, UseFastUnorderedTimeStamps, false, EXPERIMENTAL,            \
           "Use platform unstable time where supported for timestamps only") \
                                                                             \
@@ -38,17 +38,26 @@
 #include "utilities/preserveException.hpp"
 
 
-class HandshakeOperation: public StackObj {
+class HandshakeOperation: public CHeapObj<mtThread> {
   HandshakeClosure* _handshake_cl;
   int32_t _pending_threads;
   bool _executed;
   bool _is_direct;
+  HandshakeOperation* _next;  // Link in the target's queue of direct operations
 public:
   HandshakeOperation(HandshakeClosure* cl, bool is_direct = false) :
     _handshake_cl(cl),
     _pending_threads(1),
     _executed(false),
-    _is_direct(is_direct) {}
+    _is_direct(is_direct),
+    _next(NULL) {
+    assert(!cl->is_async() || is_direct, "asynchronous operations are queued");
+  }
+  ~HandshakeOperation() {
+    if (is_async()) {
+      delete static_cast<AsyncHandshakeClosure*>(_handshake_cl);
+    }
+  }
 
   void do_handshake(JavaThread* thread);
   bool is_completed() {
@@ -61,6 +70,10 @@ public:
   const char* name() { return _handshake_cl->name(); }
 
   bool is_direct() { return _is_direct; }
+  bool is_async() { return _handshake_cl->is_async(); }
+
+  HandshakeOperation* next() const { return _next; }
+  void set_next(HandshakeOperation* next) { _next = next; }
 };
 
 // Performing handshakes requires a custom yielding strategy because without it
@@ -305,6 +318,9 @@ void HandshakeOperation::do_handshake(JavaThread* thread) {
     start_time_ns = os::javaTimeNanos();
   }
 
+  assert(!is_async() || thread == Thread::current(),
+         "asynchronous operation %s must be executed by its target", name());
+
   // Only actually execute the operation for non terminated threads.
   if (!thread->is_terminated()) {
     _handshake_cl->do_thread(thread);
@@ -317,6 +333,12 @@ void HandshakeOperation::do_handshake(JavaThread* thread) {
                                name(), p2i(thread), BOOL_TO_STR(Thread::current()->is_VM_thread()), completion_time);
   }
 
+  if (is_async()) {
+    // Nobody waits for an asynchronous operation, whoever executed it frees it.
+    delete this;
+    return;
+  }
+
   // Inform VMThread/Handshaker that we have completed the operation.
   // When this is executed by the Handshakee we need a release store
   // here to make sure memory operations executed in the handshake
@@ -378,34 +400,85 @@ bool Handshake::execute_direct(HandshakeClosure* thread_cl, JavaThread* target)
   return op.executed();
 }
 
+void Handshake::execute(AsyncHandshakeClosure* thread_cl, JavaThread* target) {
+  jlong start_time_ns = os::javaTimeNanos();
+
+  // The operation owns the closure from here on.
+  HandshakeOperation* op = new HandshakeOperation(thread_cl, /*is_direct*/ true);
+
+  ThreadsListHandle tlh;
+  if (tlh.includes(target)) {
+    target->set_handshake_operation(op);
+  } else {
+    log_handshake_info(start_time_ns, op->name(), 0, 0, "(thread dead)");
+    delete op;
+  }
+}
+
 HandshakeState::HandshakeState() :
   _operation(NULL),
-  _operation_direct(NULL),
-  _handshake_turn_sem(1),
+  _queue(NULL),
   _processing_sem(1),
   _thread_in_process_handshake(false),
   _active_handshaker(NULL)
 {
 }
 
+HandshakeState::~HandshakeState() {
+  // A thread can terminate with asynchronous operations still queued.
+  // Requesters of direct operations keep the target alive until completion.
+  HandshakeOperation* op = Atomic::xchg(&_queue, (HandshakeOperation*)NULL);
+  while (op != NULL) {
+    HandshakeOperation* next = op->next();
+    assert(op->is_async(), "direct operation %s left behind", op->name());
+    delete op;
+    op = next;
+  }
+}
+
 void HandshakeState::set_operation(HandshakeOperation* op) {
   if (!op->is_direct()) {
     assert(Thread::current()->is_VM_thread(), "should be the VMThread");
     _operation = op;
   } else {
-    // Serialize direct handshakes so that only one proceeds at a time for a given target
-    _handshake_turn_sem.wait_with_safepoint_check(JavaThread::current());
-    _operation_direct = op;
+    // Direct handshakes for a given target do not wait for each other.
+    // Operations are only ever taken off the queue all at once, so a
+    // plain push does not suffer from ABA.
+    HandshakeOperation* head;
+    do {
+      head = Atomic::load(&_queue);
+      op->set_next(head);
+    } while (Atomic::cmpxchg(&_queue, head, op) != head);
   }
   SafepointMechanism::arm_local_poll_release(_handshakee);
 }
 
-void HandshakeState::clear_handshake(bool is_direct) {
-  if (!is_direct) {
-    _operation = NULL;
-  } else {
-    _operation_direct = NULL;
-    _handshake_turn_sem.signal();
+void HandshakeState::clear_handshake() {
+  _operation = NULL;
+}
+
+// Takes all queued operations and executes them in the order they were
+// requested. Must be called with _processing_sem held. A handshaker puts
+// asynchronous operations back on the queue, which keeps the poll of the
+// handshakee armed until it executes them itself.
+void HandshakeState::process_queue(bool by_handshakee) {
+  HandshakeOperation* op = Atomic::xchg(&_queue, (HandshakeOperation*)NULL);
+  HandshakeOperation* first = NULL;
+  while (op != NULL) {
+    HandshakeOperation* next = op->next();
+    op->set_next(first);
+    first = op;
+    op = next;
+  }
+  while (first != NULL) {
+    // The operation may be freed by its requester as soon as it is done.
+    HandshakeOperation* next = first->next();
+    if (!by_handshakee && first->is_async()) {
+      set_operation(first);
+    } else {
+      first->do_handshake(_handshakee);
+    }
+    first = next;
   }
 }
 
@@ -427,15 +500,10 @@ void HandshakeState::process_self_inner() {
       HandshakeOperation * op = _operation;
       if (op != NULL) {
         // Disarm before executing the operation
-        clear_handshake(/*is_direct*/ false);
-        op->do_handshake(self);
-      }
-      op = _operation_direct;
-      if (op != NULL) {
-        // Disarm before executing the operation
-        clear_handshake(/*is_direct*/ true);
+        clear_handshake();
         op->do_handshake(self);
       }
+      process_queue(true /* by_handshakee */);
     }
     _processing_sem.signal();
   } while (has_operation());
@@ -494,10 +562,10 @@ HandshakeState::ProcessResult HandshakeState::try_process(HandshakeOperation* op
     return _state_busy;
   }
 
-  // Check if the handshake operation is the same as the one we meant to execute. The
-  // handshake could have been already processed by the handshakee and a new handshake
-  // by another JavaThread might be in progress.
-  if (is_direct && op != _operation_direct) {
+  // Queued operations are only taken off the queue while holding the semaphore
+  // and are completed before it is released. If our operation is not completed
+  // it is still queued, otherwise the queue holds operations of other requesters.
+  if (is_direct && op->is_completed()) {
     _processing_sem.signal();
     return _no_operation;
   }
@@ -510,10 +578,15 @@ HandshakeState::ProcessResult HandshakeState::try_process(HandshakeOperation* op
     guarantee(!_processing_sem.trywait(), "we should already own the semaphore");
     log_trace(handshake)("Processing handshake by %s", Thread::current()->is_VM_thread() ? "VMThread" : "Handshaker");
     _active_handshaker = Thread::current();
-    op->do_handshake(_handshakee);
+    if (is_direct) {
+      // Execute the operations of other requesters queued with ours as well.
+      process_queue(false /* by_handshakee */);
+    } else {
+      op->do_handshake(_handshakee);
+      // Disarm after we have executed the operation.
+      clear_handshake();
+    }
     _active_handshaker = NULL;
-    // Disarm after we have executed the operation.
-    clear_handshake(is_direct);
     pr = _success;
   }
 
@@ -49,6 +49,21 @@ class HandshakeClosure : public ThreadClosure {
     return _name;
   }
   virtual void do_thread(Thread* thread) = 0;
+  virtual bool is_async() { return false; }
+};
+
+// An asynchronous handshake closure is allocated on the C heap by the
+// requester, which does not wait for it to be executed. The closure is
+// executed by the target itself the next time it processes its handshakes,
+// never by a handshaker on its behalf, and is deleted afterwards.
+class AsyncHandshakeClosure : public HandshakeClosure {
+ public:
+  AsyncHandshakeClosure(const char* name) : HandshakeClosure(name) {}
+  virtual ~AsyncHandshakeClosure() {}
+  virtual bool is_async() { return true; }
+
+  void* operator new(size_t size) throw() { return AllocateHeap(size, mtThread); }
+  void  operator delete(void* p)          { FreeHeap(p); }
 };
 
 class Handshake : public AllStatic {
@@ -57,37 +72,46 @@ class Handshake : public AllStatic {
   static void execute(HandshakeClosure* hs_cl);
   static bool execute(HandshakeClosure* hs_cl, JavaThread* target);
   static bool execute_direct(HandshakeClosure* hs_cl, JavaThread* target);
+  // Queues an asynchronous handshake and returns without waiting for it.
+  static void execute(AsyncHandshakeClosure* hs_cl, JavaThread* target);
 };
 
-// The HandshakeState keeps track of an ongoing handshake for this JavaThread.
+// The HandshakeState keeps track of ongoing handshakes for this JavaThread.
 // VMThread/Handshaker and JavaThread are serialized with semaphore _processing_sem
 // making sure the operation is only done by either VMThread/Handshaker on behalf
 // of the JavaThread or by the target JavaThread itself.
+// Direct and asynchronous operations are pushed on a lock-free queue without
+// waiting for each other. Whoever processes the handshakes of this JavaThread
+// takes all queued operations at once and executes them in one pass, so
+// requests from several handshakers arriving close together are coalesced.
+// Asynchronous operations are only executed by the JavaThread itself; a
+// handshaker leaves them queued for it.
 class HandshakeState {
   JavaThread* _handshakee;
   HandshakeOperation* volatile _operation;
-  HandshakeOperation* volatile _operation_direct;
+  HandshakeOperation* volatile _queue;  // Direct and asynchronous operations, LIFO.
 
-  Semaphore _handshake_turn_sem;  // Used to serialize direct handshakes for this JavaThread.
   Semaphore _processing_sem;
   bool _thread_in_process_handshake;
 
   bool claim_handshake(bool is_direct);
   bool possibly_can_process_handshake();
   bool can_process_handshake();
-  void clear_handshake(bool is_direct);
+  void clear_handshake();
+  void process_queue(bool by_handshakee);
 
   void process_self_inner();
 
 public:
   HandshakeState();
+  ~HandshakeState();
 
   void set_handshakee(JavaThread* thread) { _handshakee = thread; }
 
   void set_operation(HandshakeOperation* op);
-  bool has_operation() const { return _operation != NULL || _operation_direct != NULL; }
+  bool has_operation() const { return _operation != NULL || _queue != NULL; }
   bool has_specific_operation(bool is_direct) const {
-    return is_direct ? _operation_direct != NULL : _operation != NULL;
+    return is_direct ? _queue != NULL : _operation != NULL;
   }
 
   void process_by_self() {
@@ -86,6 +86,7 @@ void dependencyContext_init();
 bool universe_post_init();  // must happen after compiler_init
 void javaClasses_init();  // must happen after vtable initialization
 void stubRoutines_init2(); // note: StubRoutines need 2-phase init
+void compiler_stubs_init();
 
 // Do not disable thread-local-storage, as it is important for some
 // JNI/JVM/JVMTI functions and signal handlers to work properly
@@ -152,6 +153,7 @@ jint init_globals() {
     return JNI_ERR;
   }
   stubRoutines_init2(); // note: StubRoutines need 2-phase init
+  compiler_stubs_init(); // unless delayed until C2 is initialized
   MethodHandles::generate_adapters();
 
   // All the flags that get adjusted by VM_Version_init and os::init_2
@@ -31,8 +31,10 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "code/perfMap.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/profileCache.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/support/jfrThreadId.hpp"
@@ -40,6 +42,7 @@
 #include "jvmci/jvmci.hpp"
 #endif
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logStream.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -453,6 +456,8 @@ void before_exit(JavaThread* thread) {
     WatcherThread::stop();
   }
 
+  LINUX_ONLY(PerfMap::shutdown();)
+
   // shut down the StatSampler task
   StatSampler::disengage();
   StatSampler::destroy();
@@ -477,6 +482,8 @@ void before_exit(JavaThread* thread) {
     BytecodeHistogram::print();
   }
 
+  ProfileCache::dump();
+
   if (JvmtiExport::should_post_thread_life()) {
     JvmtiExport::post_thread_end(thread);
   }
@@ -566,6 +573,7 @@ void notify_vm_shutdown() {
 }
 
 void vm_direct_exit(int code) {
+  AsyncLogWriter::flush_on_error();
   notify_vm_shutdown();
   os::wait_for_keypress_at_exit();
   os::exit(code);
@@ -584,6 +592,8 @@ void vm_perform_shutdown_actions() {
       jt->set_thread_state(_thread_in_native);
     }
   }
+  // Also reached from error reporting, so do not wait for long
+  AsyncLogWriter::flush_on_error();
   notify_vm_shutdown();
 }
 
@@ -88,7 +88,7 @@ jobject JNIHandles::make_global(Handle obj, AllocFailType alloc_failmode) {
   if (!obj.is_null()) {
     // ignore null handles
     assert(oopDesc::is_oop(obj()), "not an oop");
-    oop* ptr = global_handles()->allocate();
+    oop* ptr = allocate_global_entry(Thread::current());
     // Return NULL on allocation failure.
     if (ptr != NULL) {
       assert(*ptr == NULL, "invariant");
@@ -102,6 +102,25 @@ jobject JNIHandles::make_global(Handle obj, AllocFailType alloc_failmode) {
   return res;
 }
 
+oop* JNIHandles::allocate_global_entry(Thread* thread) {
+  JNIGlobalHandleCache* cache = thread->global_handle_cache();
+  if (cache->_count == 0) {
+    cache->_count = (uint)global_handles()->allocate(cache->_entries, JNIGlobalHandleCache::Size);
+    if (cache->_count == 0) {
+      return NULL;
+    }
+  }
+  return cache->_entries[--cache->_count];
+}
+
+void JNIHandles::release_cached_global_entries(Thread* thread) {
+  JNIGlobalHandleCache* cache = thread->global_handle_cache();
+  if (cache->_count > 0) {
+    global_handles()->release(cache->_entries, cache->_count);
+    cache->_count = 0;
+  }
+}
+
 jobject JNIHandles::make_weak_global(Handle obj, AllocFailType alloc_failmode) {
   assert(!Universe::heap()->is_gc_active(), "can't extend the root set during GC");
   assert(!current_thread_in_native(), "must not be in native");
@@ -350,6 +369,7 @@ JNIHandleBlock* JNIHandleBlock::allocate_block(Thread* thread, AllocFailType all
   if (thread != NULL && thread->free_handle_block() != NULL) {
     block = thread->free_handle_block();
     thread->set_free_handle_block(block->_next);
+    thread->set_free_handle_block_count(thread->free_handle_block_count() - 1);
   }
   else {
     // locking with safepoint checking introduces a potential deadlock:
@@ -396,22 +416,26 @@ JNIHandleBlock* JNIHandleBlock::allocate_block(Thread* thread, AllocFailType all
 void JNIHandleBlock::release_block(JNIHandleBlock* block, Thread* thread) {
   assert(thread == NULL || thread == Thread::current(), "sanity check");
   JNIHandleBlock* pop_frame_link = block->pop_frame_link();
-  // Put returned block at the beginning of the thread-local free list.
+  // Put returned blocks at the beginning of the thread-local free list, so
+  // that PushLocalFrame and native method entry normally find a block there
+  // without taking the global lock. The thread-local list is bounded so that
+  // a burst of deep frames does not pin blocks to the thread forever; any
+  // excess goes to the global free list below.
   // Note that if thread == NULL, we use it as an implicit argument that
   // we _don't_ want the block to be kept on the free_handle_block.
   // See for instance JavaThread::exit().
-  if (thread != NULL ) {
-    block->zap();
-    JNIHandleBlock* freelist = thread->free_handle_block();
+  if (thread != NULL) {
     block->_pop_frame_link = NULL;
-    thread->set_free_handle_block(block);
-
-    // Add original freelist to end of chain
-    if ( freelist != NULL ) {
-      while ( block->_next != NULL ) block = block->_next;
-      block->_next = freelist;
+    int count = thread->free_handle_block_count();
+    while (block != NULL && count < max_thread_free_blocks) {
+      JNIHandleBlock* next = block->_next;
+      block->zap();
+      block->_next = thread->free_handle_block();
+      thread->set_free_handle_block(block);
+      count++;
+      block = next;
     }
-    block = NULL;
+    thread->set_free_handle_block_count(count);
   }
   if (block != NULL) {
     // Return blocks to free list
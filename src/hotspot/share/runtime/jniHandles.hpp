@@ -32,6 +32,22 @@ class JavaThread;
 class OopStorage;
 class Thread;
 
+// A small per-thread cache of unused global handle entries.  They are
+// allocated from the global handle storage in bulk, so that a thread creating
+// many global handles takes the storage's allocation lock once per batch
+// rather than once per handle.
+class JNIGlobalHandleCache {
+  friend class JNIHandles;
+
+  static const uint Size = 16;
+
+  oop* _entries[Size];
+  uint _count;
+
+ public:
+  JNIGlobalHandleCache() : _count(0) {}
+};
+
 // Interface for creating and resolving local/global JNI handles
 
 class JNIHandles : AllStatic {
@@ -49,6 +65,8 @@ class JNIHandles : AllStatic {
   inline static oop* jobject_ptr(jobject handle); // NOT jweak!
   inline static oop* jweak_ptr(jobject handle);
 
+  static oop* allocate_global_entry(Thread* thread);
+
   template <DecoratorSet decorators, bool external_guard> inline static oop resolve_impl(jobject handle);
 
   // Resolve handle into oop, without keeping the object alive
@@ -92,6 +110,8 @@ class JNIHandles : AllStatic {
   static jobject make_global(Handle  obj,
                              AllocFailType alloc_failmode = AllocFailStrategy::EXIT_OOM);
   static void destroy_global(jobject handle);
+  // Releases the entries cached by the thread.
+  static void release_cached_global_entries(Thread* thread);
 
   // Weak global handles
   static jobject make_weak_global(Handle obj,
@@ -143,7 +163,8 @@ class JNIHandleBlock : public CHeapObj<mtInternal> {
 
  private:
   enum SomeConstants {
-    block_size_in_oops  = 32                    // Number of handles per handle block
+    block_size_in_oops  = 32,                   // Number of handles per handle block
+    max_thread_free_blocks = 16                 // Max blocks kept on a thread-local free list
   };
 
   uintptr_t       _handles[block_size_in_oops]; // The handles
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "oops/oop.hpp"
+#include "runtime/lockStack.inline.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/ostream.hpp"
+
+LockStack::LockStack() : _top(start_offset()) {
+#ifdef ASSERT
+  for (int i = 0; i < CAPACITY; i++) {
+    _base[i] = NULL;
+  }
+#endif
+}
+
+uint32_t LockStack::start_offset() {
+  return in_bytes(JavaThread::lock_stack_base_offset());
+}
+
+uint32_t LockStack::end_offset() {
+  return start_offset() + CAPACITY * oopSize;
+}
+
+#ifndef PRODUCT
+void LockStack::verify(const char* msg) const {
+  assert(UseLightweightLocking, "never use lock-stack when lightweight locking is disabled");
+  assert(_top >= start_offset() && _top <= end_offset(), "lock-stack out of bounds: %s", msg);
+  if (SafepointSynchronize::is_at_safepoint() || is_owning_thread()) {
+    int end = to_index(_top);
+    for (int i = 0; i < end; i++) {
+      for (int j = i + 1; j < end; j++) {
+        assert(_base[i] != _base[j], "entries must be unique: %s", msg);
+      }
+    }
+  }
+}
+#endif
+
+void LockStack::print_on(outputStream* st) const {
+  for (int i = to_index(_top) - 1; i >= 0; i--) {
+    st->print("LockStack[%d]: ", i);
+    oop o = _base[i];
+    if (oopDesc::is_oop(o)) {
+      o->print_on(st);
+    } else {
+      st->print_cr("not an oop: " PTR_FORMAT, p2i(o));
+    }
+  }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_RUNTIME_LOCKSTACK_HPP
+#define SHARE_RUNTIME_LOCKSTACK_HPP
+
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/sizes.hpp"
+
+class JavaThread;
+class OopClosure;
+class outputStream;
+
+// The lock stack of a JavaThread records the objects it has fast-locked
+// with UseLightweightLocking, most recent last. It is embedded in the
+// JavaThread so that compiled code can push and pop entries relative to
+// the thread register: _top is the byte offset, from the start of the
+// JavaThread, of the next free slot.
+//
+// An object is fast-locked by at most one thread. When the stack is full,
+// or when a lock is taken recursively, the object is inflated instead.
+
+class LockStack {
+public:
+  static const int CAPACITY = 8;
+
+private:
+  uint32_t _top;
+  oop _base[CAPACITY];
+
+  int to_index(uint32_t offset) const;
+  JavaThread* get_thread() const;
+
+  bool is_owning_thread() const;
+  void verify(const char* msg) const PRODUCT_RETURN;
+
+public:
+  static ByteSize top_offset()  { return byte_offset_of(LockStack, _top); }
+  static ByteSize base_offset() { return byte_offset_of(LockStack, _base); }
+
+  // Byte offsets within the JavaThread of the first and one-past-last slot.
+  static uint32_t start_offset();
+  static uint32_t end_offset();
+
+  LockStack();
+
+  inline bool can_push() const;
+  inline bool is_empty() const;
+  inline void push(oop o);
+  inline oop pop();
+  // Removes o, which need not be the most recent entry.
+  inline void remove(oop o);
+  inline bool contains(oop o) const;
+
+  // GC support
+  inline void oops_do(OopClosure* cl);
+
+  void print_on(outputStream* st) const;
+};
+
+#endif // SHARE_RUNTIME_LOCKSTACK_HPP
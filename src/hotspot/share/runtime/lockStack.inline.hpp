@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_RUNTIME_LOCKSTACK_INLINE_HPP
+#define SHARE_RUNTIME_LOCKSTACK_INLINE_HPP
+
+#include "memory/iterator.hpp"
+#include "runtime/lockStack.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/stackWatermarkSet.hpp"
+#include "runtime/thread.hpp"
+
+inline int LockStack::to_index(uint32_t offset) const {
+  return (offset - start_offset()) / oopSize;
+}
+
+inline JavaThread* LockStack::get_thread() const {
+  char* addr = reinterpret_cast<char*>(const_cast<LockStack*>(this));
+  return reinterpret_cast<JavaThread*>(addr - in_bytes(JavaThread::lock_stack_offset()));
+}
+
+inline bool LockStack::can_push() const {
+  return to_index(_top) < CAPACITY;
+}
+
+inline bool LockStack::is_empty() const {
+  return _top == start_offset();
+}
+
+inline bool LockStack::is_owning_thread() const {
+  Thread* current = Thread::current();
+  return current->is_Java_thread() && current->as_Java_thread() == get_thread();
+}
+
+inline void LockStack::push(oop o) {
+  verify("pre-push");
+  assert(oopDesc::is_oop(o), "must be");
+  assert(!contains(o), "entries must be unique");
+  assert(can_push(), "must have room");
+  _base[to_index(_top)] = o;
+  _top += oopSize;
+  verify("post-push");
+}
+
+inline oop LockStack::pop() {
+  verify("pre-pop");
+  assert(!is_empty(), "must have entries");
+  _top -= oopSize;
+  oop o = _base[to_index(_top)];
+  assert(!contains(o), "entries must be unique");
+  verify("post-pop");
+  return o;
+}
+
+inline void LockStack::remove(oop o) {
+  verify("pre-remove");
+  assert(contains(o), "entry must be present");
+  int end = to_index(_top);
+  for (int i = 0; i < end; i++) {
+    if (_base[i] == o) {
+      for (int j = i + 1; j < end; j++) {
+        _base[j - 1] = _base[j];
+      }
+      _top -= oopSize;
+      break;
+    }
+  }
+  assert(!contains(o), "entries must be unique");
+  verify("post-remove");
+}
+
+inline bool LockStack::contains(oop o) const {
+  verify("pre-contains");
+  if (!SafepointSynchronize::is_at_safepoint() && !is_owning_thread()) {
+    // Another thread may look at this lock stack before the owner has
+    // processed its non-frame oops after a safepoint.
+    StackWatermarkSet::start_processing(get_thread(), StackWatermarkKind::gc);
+  }
+  int end = to_index(_top);
+  for (int i = end - 1; i >= 0; i--) {
+    if (_base[i] == o) {
+      verify("post-contains");
+      return true;
+    }
+  }
+  verify("post-contains");
+  return false;
+}
+
+inline void LockStack::oops_do(OopClosure* cl) {
+  verify("pre-oops-do");
+  int end = to_index(_top);
+  for (int i = 0; i < end; i++) {
+    cl->do_oop(&_base[i]);
+  }
+  verify("post-oops-do");
+}
+
+#endif // SHARE_RUNTIME_LOCKSTACK_INLINE_HPP
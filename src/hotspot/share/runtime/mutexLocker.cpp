@@ -109,7 +109,6 @@ Mutex*   tty_lock                     = NULL;
 Mutex*   RawMonitor_lock              = NULL;
 Mutex*   PerfDataMemAlloc_lock        = NULL;
 Mutex*   PerfDataManager_lock         = NULL;
-Mutex*   OopMapCacheAlloc_lock        = NULL;
 
 Mutex*   FreeList_lock                = NULL;
 Mutex*   OldSets_lock                 = NULL;
@@ -122,6 +121,7 @@ Monitor* PeriodicTask_lock            = NULL;
 Monitor* RedefineClasses_lock         = NULL;
 Mutex*   Verify_lock                  = NULL;
 Monitor* Zip_lock                     = NULL;
+Mutex*   ProfileCache_lock            = NULL;
 
 #if INCLUDE_JFR
 Mutex*   JfrStacktrace_lock           = NULL;
@@ -135,6 +135,8 @@ Monitor* JfrThreadSampler_lock        = NULL;
 Mutex*   UnsafeJlong_lock             = NULL;
 #endif
 Mutex*   CodeHeapStateAnalytics_lock  = NULL;
+Mutex*   SafepointProfile_lock        = NULL;
+Mutex*   AllocationSiteProfile_lock   = NULL;
 
 Mutex*   MetaspaceExpand_lock         = NULL;
 Mutex*   ClassLoaderDataGraph_lock    = NULL;
@@ -238,7 +240,6 @@ void mutex_init() {
   def(CodeCache_lock               , PaddedMonitor, special,     true,  _safepoint_check_never);
   def(CodeSweeper_lock             , PaddedMonitor, special-2,   true,  _safepoint_check_never);
   def(RawMonitor_lock              , PaddedMutex  , special,     true,  _safepoint_check_never);
-  def(OopMapCacheAlloc_lock        , PaddedMutex  , leaf,        true,  _safepoint_check_always); // used for oop_map_cache allocation.
 
   def(MetaspaceExpand_lock         , PaddedMutex  , leaf-1,      true,  _safepoint_check_never);
   def(ClassLoaderDataGraph_lock    , PaddedMutex  , nonleaf,     false, _safepoint_check_always);
@@ -318,6 +319,9 @@ void mutex_init() {
   if (WhiteBoxAPI) {
     def(Compilation_lock           , PaddedMonitor, leaf,        false, _safepoint_check_never);
   }
+  if (ProfileCacheFile != NULL || DumpProfileCacheFile != NULL) {
+    def(ProfileCache_lock          , PaddedMutex  , leaf,        true,  _safepoint_check_never);
+  }
 
 #if INCLUDE_JFR
   def(JfrMsg_lock                  , PaddedMonitor, leaf,        true,  _safepoint_check_always);
@@ -332,6 +336,8 @@ void mutex_init() {
 #endif
 
   def(CodeHeapStateAnalytics_lock  , PaddedMutex  , leaf,        true,  _safepoint_check_never);
+  def(SafepointProfile_lock        , PaddedMutex  , leaf,        true,  _safepoint_check_never);
+  def(AllocationSiteProfile_lock   , PaddedMutex  , leaf,        true,  _safepoint_check_never);
   def(NMethodSweeperStats_lock     , PaddedMutex  , special,     true,  _safepoint_check_never);
   def(ThreadsSMRDelete_lock        , PaddedMonitor, special,     true,  _safepoint_check_never);
   def(ThreadIdTableCreate_lock     , PaddedMutex  , leaf,        false, _safepoint_check_always);
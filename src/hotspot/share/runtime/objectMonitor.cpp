@@ -111,6 +111,7 @@ static int Knob_Penalty             = 200;     // spin failure penalty
 static int Knob_Poverty             = 1000;
 static int Knob_FixedSpin           = 0;
 static int Knob_PreSpin             = 10;      // 20-100 likely better
+static int Knob_MaxSpinners         = -1;      // set from the available processors in Initialize()
 
 DEBUG_ONLY(static volatile bool InitDone = false;)
 
@@ -237,6 +238,34 @@ void ObjectMonitor::operator delete[] (void *p) {
   operator delete(p);
 }
 
+ObjectMonitor::ObjectMonitor(oop object) :
+  _header(markWord::zero()),
+  _object(object),
+  _owner(NULL),
+  _previous_owner_tid(0),
+  _next_om(NULL),
+  _recursions(0),
+  _EntryList(NULL),
+  _cxq(NULL),
+  _succ(NULL),
+  _Responsible(NULL),
+  _Spinner(0),
+  _SpinDuration(ObjectMonitor::Knob_SpinLimit),
+  _contentions(0),
+  _WaitSet(NULL),
+  _waiters(0),
+  _WaitSetLock(0)
+{ }
+
+ObjectMonitor::~ObjectMonitor() {
+#ifdef ASSERT
+  stringStream ss;
+  assert(object() == NULL, "deleting monitor with an object: " INTPTR_FORMAT, p2i(object()));
+  assert((is_busy() | _recursions) == 0, "deleting in-use monitor: %s, "
+         "recursions=" INTX_FORMAT, is_busy_to_string(&ss), _recursions);
+#endif
+}
+
 // -----------------------------------------------------------------------------
 // Enter support
 
@@ -273,6 +302,8 @@ bool ObjectMonitor::enter(TRAPS) {
   // transitions.  The following spin is strictly optional ...
   // Note that if we acquire the monitor from an initial spin
   // we forgo posting JVMTI events and firing DTRACE probes.
+  int spin_count = 1;
+  int park_count = 0;
   if (TrySpin(Self) > 0) {
     assert(_owner == Self, "must be Self: owner=" INTPTR_FORMAT, p2i(_owner));
     assert(_recursions == 0, "must be 0: recursions=" INTX_FORMAT, _recursions);
@@ -339,7 +370,7 @@ bool ObjectMonitor::enter(TRAPS) {
       // cleared by handle_special_suspend_equivalent_condition()
       // or java_suspend_self()
 
-      EnterI(THREAD);
+      EnterI(&spin_count, &park_count, THREAD);
 
       if (!ExitSuspendEquivalent(jt)) break;
 
@@ -400,6 +431,8 @@ bool ObjectMonitor::enter(TRAPS) {
   }
   if (event.should_commit()) {
     event.set_previousOwner((uintptr_t)_previous_owner_tid);
+    event.set_spinCount(spin_count);
+    event.set_parkCount(park_count);
     event.commit();
   }
   OM_PERFDATA_OP(ContendedLockAttempts, inc());
@@ -503,7 +536,9 @@ const char* ObjectMonitor::is_busy_to_string(stringStream* ss) {
 
 #define MAX_RECHECK_INTERVAL 1000
 
-void ObjectMonitor::EnterI(TRAPS) {
+// spin_count and park_count are incremented for each round of adaptive
+// spinning and each park, respectively, for reporting by the caller.
+void ObjectMonitor::EnterI(int* spin_count, int* park_count, TRAPS) {
   Thread * const Self = THREAD;
   assert(Self->as_Java_thread()->thread_state() == _thread_blocked, "invariant");
 
@@ -542,6 +577,7 @@ void ObjectMonitor::EnterI(TRAPS) {
   // to the owner.  This has subtle but beneficial affinity
   // effects.
 
+  (*spin_count)++;
   if (TrySpin(Self) > 0) {
     assert(_owner == Self, "invariant");
     assert(_succ != Self, "invariant");
@@ -636,6 +672,7 @@ void ObjectMonitor::EnterI(TRAPS) {
     assert(_owner != Self, "invariant");
 
     // park self
+    (*park_count)++;
     if (_Responsible == Self) {
       Self->_ParkEvent->park((jlong) recheckInterval);
       // Increase the recheckInterval, but clamp the value.
@@ -680,6 +717,7 @@ void ObjectMonitor::EnterI(TRAPS) {
     // We can defer clearing _succ until after the spin completes
     // TrySpin() must tolerate being called with _succ == Self.
     // Try yet another round of adaptive spinning.
+    (*spin_count)++;
     if (TrySpin(Self) > 0) break;
 
     // We can find that we were unpark()ed and redesignated _succ while
@@ -1750,6 +1788,14 @@ int ObjectMonitor::TrySpin(Thread * Self) {
     return 0;
   }
 
+  // Once as many threads spin on this monitor as there are processors
+  // left over for the owner, another spinner would compete with the
+  // owner for a CPU rather than wait for it to drop the lock.
+  if (Atomic::add(&_Spinner, 1) > Knob_MaxSpinners) {
+    Atomic::dec(&_Spinner);
+    return 0;
+  }
+
   // We're good to spin ... spin ingress.
   // CONSIDER: use Prefetch::write() to avoid RTS->RTO upgrades
   // when preparing to LD...CAS _owner, etc and the CAS is likely
@@ -1814,6 +1860,7 @@ int ObjectMonitor::TrySpin(Thread * Self) {
           if (x < Knob_Poverty) x = Knob_Poverty;
           _SpinDuration = x + Knob_Bonus;
         }
+        Atomic::dec(&_Spinner);
         return 1;
       }
 
@@ -1859,6 +1906,7 @@ int ObjectMonitor::TrySpin(Thread * Self) {
   }
 
  Abort:
+  Atomic::dec(&_Spinner);
   if (_succ == Self) {
     _succ = NULL;
     // Invariant: after setting succ=null a contending thread
@@ -1924,7 +1972,10 @@ int ObjectMonitor::NotRunnable(Thread * Self, Thread * ox) {
   assert(sizeof(((JavaThread *)ox)->_thread_state == sizeof(int)), "invariant");
   int jst = SafeFetch32((int *) &((JavaThread *) ox)->_thread_state, -1);;
   // consider also: jst != _thread_in_Java -- but that's overspecific.
-  return jst == _thread_blocked || jst == _thread_in_native;
+  // An owner in _thread_blocked_trans is on its way back from blocking
+  // and may first have to wait for a safepoint or suspend request.
+  return jst == _thread_blocked || jst == _thread_blocked_trans ||
+         jst == _thread_in_native;
 }
 
 
@@ -2032,6 +2083,11 @@ void ObjectMonitor::Initialize() {
     Knob_FixedSpin = -1;
   }
 
+  // Leave at least one of the processors available to the VM for the
+  // owner. active_processor_count() honors container CPU quotas, which
+  // is where spinning against a descheduled owner hurts the most.
+  Knob_MaxSpinners = MAX2(1, os::active_processor_count() - 1);
+
   if (UsePerfData) {
     EXCEPTION_MARK;
 #define NEWPERFCOUNTER(n)                                                \
@@ -2073,11 +2129,10 @@ void ObjectMonitor::print() const { print_on(tty); }
 // (ObjectMonitor) 0x00007fdfb6012e40 = {
 //   _header = 0x0000000000000001
 //   _object = 0x000000070ff45fd0
-//   _allocation_state = Old
 //   _pad_buf0 = {
 //     [0] = '\0'
 //     ...
-//     [43] = '\0'
+//     [47] = '\0'
 //   }
 //   _owner = 0x0000000000000000
 //   _previous_owner_tid = 0
@@ -2098,23 +2153,17 @@ void ObjectMonitor::print() const { print_on(tty); }
 //   _WaitSet = 0x0000700009756248
 //   _waiters = 1
 //   _WaitSetLock = 0
+//   _pad_buf2 = {
+//     [0] = '\0'
+//     ...
+//     [59] = '\0'
+//   }
 // }
 //
 void ObjectMonitor::print_debug_style_on(outputStream* st) const {
   st->print_cr("(ObjectMonitor*) " INTPTR_FORMAT " = {", p2i(this));
   st->print_cr("  _header = " INTPTR_FORMAT, header().value());
   st->print_cr("  _object = " INTPTR_FORMAT, p2i(object()));
-  st->print("  _allocation_state = ");
-  if (is_free()) {
-    st->print("Free");
-  } else if (is_old()) {
-    st->print("Old");
-  } else if (is_new()) {
-    st->print("New");
-  } else {
-    st->print("unknown=%d", _allocation_state);
-  }
-  st->cr();
   st->print_cr("  _pad_buf0 = {");
   st->print_cr("    [0] = '\\0'");
   st->print_cr("    ...");
@@ -2139,6 +2188,11 @@ void ObjectMonitor::print_debug_style_on(outputStream* st) const {
   st->print_cr("  _WaitSet = " INTPTR_FORMAT, p2i(_WaitSet));
   st->print_cr("  _waiters = %d", _waiters);
   st->print_cr("  _WaitSetLock = %d", _WaitSetLock);
+  st->print_cr("  _pad_buf2 = {");
+  st->print_cr("    [0] = '\\0'");
+  st->print_cr("    ...");
+  st->print_cr("    [%d] = '\\0'", (int)sizeof(_pad_buf2) - 1);
+  st->print_cr("  }");
   st->print_cr("}");
 }
 #endif
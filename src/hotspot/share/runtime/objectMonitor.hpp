@@ -101,8 +101,8 @@ class ObjectWaiter : public StackObj {
 // - See TEST_VM(ObjectMonitor, sanity) gtest for how critical restrictions are
 //   enforced.
 // - Adjacent ObjectMonitors should be separated by enough space to avoid
-//   false sharing. This is handled by the ObjectMonitor allocation code
-//   in synchronizer.cpp. Also see TEST_VM(SynchronizerTest, sanity) gtest.
+//   false sharing. This is handled by the padding at the end of the
+//   ObjectMonitor. Also see TEST_VM(ObjectMonitor, sanity) gtest.
 //
 // Futures notes:
 //   - Separating _owner from the <remaining_fields> by enough space to
@@ -136,21 +136,19 @@ class ObjectMonitor {
   // Enforced by the assert() in header_addr().
   volatile markWord _header;        // displaced object header word - mark
   void* volatile _object;           // backward object pointer - strong root
-  typedef enum {
-    Free = 0,  // Free must be 0 for monitor to be free after memset(..,0,..).
-    New,
-    Old
-  } AllocationState;
-  AllocationState _allocation_state;
   // Separate _header and _owner on different cache lines since both can
-  // have busy multi-threaded access. _header, _object and _allocation_state
-  // are set at initial inflation. _object and _allocation_state don't
-  // change until deflation so _object and _allocation_state are good
-  // choices to share the cache line with _header.
+  // have busy multi-threaded access. _header and _object are set at initial
+  // inflation. _object doesn't change until deflation so _object is a good
+  // choice to share the cache line with _header.
   DEFINE_PAD_MINUS_SIZE(0, OM_CACHE_LINE_SIZE, sizeof(volatile markWord) +
-                        sizeof(void* volatile) + sizeof(AllocationState));
+                        sizeof(void* volatile));
   // Used by async deflation as a marker in the _owner field:
   #define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+  // Used with UseLightweightLocking as the owner of a monitor inflated from
+  // a fast-locked object by a thread other than the owner. The owner is
+  // then only known from its lock stack, and it claims the monitor when
+  // it next takes the slow path for the object.
+  #define ANONYMOUS_OWNER reinterpret_cast<void*>(1)
   void* volatile _owner;            // pointer to owning thread OR BasicLock
   volatile jlong _previous_owner_tid;  // thread id of the previous owner of the monitor
   // Separate _owner and _next_om on different cache lines since
@@ -159,7 +157,7 @@ class ObjectMonitor {
   // cache line with _owner.
   DEFINE_PAD_MINUS_SIZE(1, OM_CACHE_LINE_SIZE, sizeof(void* volatile) +
                         sizeof(volatile jlong));
-  ObjectMonitor* _next_om;          // Next ObjectMonitor* linkage
+  ObjectMonitor* _next_om;          // Next ObjectMonitor* linkage on the in-use list
   volatile intx _recursions;        // recursion count, 0 for first entry
   ObjectWaiter* volatile _EntryList;  // Threads blocked on entry or reentry.
                                       // The list is actually composed of WaitNodes,
@@ -169,7 +167,7 @@ class ObjectMonitor {
   Thread* volatile _succ;           // Heir presumptive thread - used for futile wakeup throttling
   Thread* volatile _Responsible;
 
-  volatile int _Spinner;            // for exit->spinner handoff optimization
+  volatile int _Spinner;            // number of threads currently in the TrySpin() spin loop
   volatile int _SpinDuration;
 
   jint  _contentions;               // Number of active contentions in enter(). It is used by is_busy()
@@ -181,6 +179,9 @@ class ObjectMonitor {
   volatile jint  _waiters;          // number of waiting threads
  private:
   volatile int _WaitSetLock;        // protects Wait Queue - simple spinlock
+  // Separate adjacent ObjectMonitors on different cache lines since
+  // they are allocated individually on the C heap.
+  DEFINE_PAD_MINUS_SIZE(2, OM_CACHE_LINE_SIZE, sizeof(volatile int));
 
  public:
   static void Initialize();
@@ -273,18 +274,20 @@ class ObjectMonitor {
   // _owner field. Returns the prior value of the _owner field.
   void*     try_set_owner_from(void* old_value, void* new_value);
 
+  void set_owner_anonymous() {
+    set_owner_from(NULL, ANONYMOUS_OWNER);
+  }
+  bool is_owner_anonymous() const {
+    return _owner == ANONYMOUS_OWNER;
+  }
+  void set_owner_from_anonymous(Thread* owner) {
+    set_owner_from(ANONYMOUS_OWNER, owner);
+  }
+
   // Simply get _next_om field.
   ObjectMonitor* next_om() const;
-  // Get _next_om field with acquire semantics.
-  ObjectMonitor* next_om_acquire() const;
   // Simply set _next_om field to new_value.
   void set_next_om(ObjectMonitor* new_value);
-  // Set _next_om field to new_value with release semantics.
-  void release_set_next_om(ObjectMonitor* new_value);
-  // Try to set _next_om field to new_value if the current value matches
-  // old_value, using Atomic::cmpxchg(). Otherwise, does not change the
-  // _next_om field. Returns the prior value of the _next_om field.
-  ObjectMonitor* try_set_next_om(ObjectMonitor* old_value, ObjectMonitor* new_value);
 
   jint      waiters() const;
 
@@ -297,52 +300,20 @@ class ObjectMonitor {
   ObjectWaiter* next_waiter(ObjectWaiter* o)                           { return o->_next; }
   Thread* thread_of_waiter(ObjectWaiter* o)                            { return o->_thread; }
 
- protected:
-  // We don't typically expect or want the ctors or dtors to run.
-  // normal ObjectMonitors are type-stable and immortal.
-  ObjectMonitor() { ::memset((void*)this, 0, sizeof(*this)); }
-
-  ~ObjectMonitor() {
-    // TODO: Add asserts ...
-    // _cxq == 0 _succ == NULL _owner == NULL _waiters == 0
-    // _contentions == 0 _EntryList  == NULL etc
-  }
-
- private:
-  void Recycle() {
-    // TODO: add stronger asserts ...
-    // _cxq == 0 _succ == NULL _owner == NULL _waiters == 0
-    // _contentions == 0 EntryList  == NULL
-    // _recursions == 0 _WaitSet == NULL
-#ifdef ASSERT
-    stringStream ss;
-    assert((is_busy() | _recursions) == 0, "freeing in-use monitor: %s, "
-           "recursions=" INTX_FORMAT, is_busy_to_string(&ss), _recursions);
-#endif
-    _succ          = NULL;
-    _EntryList     = NULL;
-    _cxq           = NULL;
-    _WaitSet       = NULL;
-    _recursions    = 0;
-  }
-
  public:
+  // ObjectMonitors are allocated on the C heap when an object is inflated
+  // and deleted by the async deflater after they have been deflated and
+  // unlinked from the in-use list.
+  ObjectMonitor(oop object);
+  ~ObjectMonitor();
 
   oop       object() const;
   oop*      object_addr();
   void      set_object(oop obj);
-  void      release_set_allocation_state(AllocationState s);
-  void      set_allocation_state(AllocationState s);
-  AllocationState allocation_state() const;
-  AllocationState allocation_state_acquire() const;
-  bool      is_free() const;
-  bool      is_old() const;
-  bool      is_new() const;
 
   // Returns true if the specified thread owns the ObjectMonitor. Otherwise
   // returns false and throws IllegalMonitorStateException (IMSE).
   bool      check_owner(Thread* THREAD);
-  void      clear();
   void      clear_common();
 
   bool      enter(TRAPS);
@@ -366,7 +337,7 @@ class ObjectMonitor {
   void      INotify(Thread* self);
   ObjectWaiter* DequeueWaiter();
   void      DequeueSpecificWaiter(ObjectWaiter* waiter);
-  void      EnterI(TRAPS);
+  void      EnterI(int* spin_count, int* park_count, TRAPS);
   void      ReenterI(Thread* self, ObjectWaiter* self_node);
   void      UnlinkAfterAcquire(Thread* self, ObjectWaiter* self_node);
   int       TryLock(Thread* self);
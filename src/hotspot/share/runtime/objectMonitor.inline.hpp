@@ -27,8 +27,16 @@
 
 #include "logging/log.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/lockStack.inline.hpp"
+#include "runtime/thread.hpp"
 
 inline intptr_t ObjectMonitor::is_entered(TRAPS) const {
+  if (UseLightweightLocking) {
+    if (is_owner_anonymous()) {
+      return THREAD->is_Java_thread() && THREAD->as_Java_thread()->lock_stack().contains(object()) ? 1 : 0;
+    }
+    return THREAD == _owner ? 1 : 0;
+  }
   if (THREAD == _owner || THREAD->is_lock_owned((address) _owner)) {
     return 1;
   }
@@ -70,22 +78,12 @@ inline bool ObjectMonitor::is_being_async_deflated() {
   return contentions() < 0;
 }
 
-inline void ObjectMonitor::clear() {
-  assert(Atomic::load(&_header).value() != 0, "must be non-zero");
-  assert(_owner == NULL, "must be NULL: owner=" INTPTR_FORMAT, p2i(_owner));
-
-  Atomic::store(&_header, markWord::zero());
-
-  clear_common();
-}
-
 inline void ObjectMonitor::clear_common() {
   // Async deflation protocol uses the header, owner and contentions
-  // fields. While the ObjectMonitor being deflated is on the global
-  // free list, we leave those three fields alone; contentions < 0
-  // will force any racing threads to retry. The header field is used
-  // by install_displaced_markword_in_object() to restore the object's
-  // header so we cannot check its value here.
+  // fields. Until the deflated ObjectMonitor is deleted, we leave those
+  // three fields alone; contentions < 0 will force any racing threads
+  // to retry. The header field is used by install_displaced_markword_in_object()
+  // to restore the object's header so we cannot check its value here.
   guarantee(_owner == NULL || _owner == DEFLATER_MARKER,
             "must be NULL or DEFLATER_MARKER: owner=" INTPTR_FORMAT,
             p2i(_owner));
@@ -94,7 +92,6 @@ inline void ObjectMonitor::clear_common() {
   assert(_recursions == 0, "must be 0: recursions=" INTX_FORMAT, _recursions);
   assert(object() != NULL, "must be non-NULL");
 
-  set_allocation_state(Free);
   set_object(NULL);
 }
 
@@ -195,34 +192,6 @@ inline void* ObjectMonitor::try_set_owner_from(void* old_value, void* new_value)
   return prev;
 }
 
-inline void ObjectMonitor::release_set_allocation_state(ObjectMonitor::AllocationState s) {
-  Atomic::release_store(&_allocation_state, s);
-}
-
-inline void ObjectMonitor::set_allocation_state(ObjectMonitor::AllocationState s) {
-  _allocation_state = s;
-}
-
-inline ObjectMonitor::AllocationState ObjectMonitor::allocation_state() const {
-  return _allocation_state;
-}
-
-inline ObjectMonitor::AllocationState ObjectMonitor::allocation_state_acquire() const {
-  return Atomic::load_acquire(&_allocation_state);
-}
-
-inline bool ObjectMonitor::is_free() const {
-  return _allocation_state == Free;
-}
-
-inline bool ObjectMonitor::is_old() const {
-  return allocation_state_acquire() == Old;
-}
-
-inline bool ObjectMonitor::is_new() const {
-  return _allocation_state == New;
-}
-
 // The _next_om field can be concurrently read and modified so we
 // use Atomic operations to disable compiler optimizations that
 // might try to elide loading and/or storing this field.
@@ -232,26 +201,9 @@ inline ObjectMonitor* ObjectMonitor::next_om() const {
   return Atomic::load(&_next_om);
 }
 
-// Get _next_om field with acquire semantics.
-inline ObjectMonitor* ObjectMonitor::next_om_acquire() const {
-  return Atomic::load_acquire(&_next_om);
-}
-
 // Simply set _next_om field to new_value.
 inline void ObjectMonitor::set_next_om(ObjectMonitor* new_value) {
   Atomic::store(&_next_om, new_value);
 }
 
-// Set _next_om field to new_value with release semantics.
-inline void ObjectMonitor::release_set_next_om(ObjectMonitor* new_value) {
-  Atomic::release_store(&_next_om, new_value);
-}
-
-// Try to set _next_om field to new_value if the current value matches
-// old_value. Otherwise, does not change the _next_om field. Returns
-// the prior value of the _next_om field.
-inline ObjectMonitor* ObjectMonitor::try_set_next_om(ObjectMonitor* old_value, ObjectMonitor* new_value) {
-  return Atomic::cmpxchg(&_next_om, old_value, new_value);
-}
-
 #endif // SHARE_RUNTIME_OBJECTMONITOR_INLINE_HPP
@@ -253,6 +253,16 @@ bool os::committed_in_range(address start, size_t size, address& committed_start
 }
 #endif
 
+#if !defined(LINUX)
+size_t os::resident_in_range(address start, size_t size) {
+  return size;
+}
+
+size_t os::huge_pages_in_range(address start, size_t size) {
+  return 0;
+}
+#endif
+
 // Helper for dll_locate_lib.
 // Pass buffer and printbuffer as we already printed the path to buffer
 // when we called get_current_directory. This way we avoid another buffer
@@ -673,7 +683,7 @@ static bool has_reached_max_malloc_test_peak(size_t alloc_size) {
 }
 
 void* os::malloc(size_t size, MEMFLAGS flags) {
-  return os::malloc(size, flags, CALLER_PC);
+  return os::malloc(size, flags, MALLOC_CALLER_PC);
 }
 
 void* os::malloc(size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
@@ -734,7 +744,7 @@ void* os::malloc(size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
 }
 
 void* os::realloc(void *memblock, size_t size, MEMFLAGS flags) {
-  return os::realloc(memblock, size, flags, CALLER_PC);
+  return os::realloc(memblock, size, flags, MALLOC_CALLER_PC);
 }
 
 void* os::realloc(void *memblock, size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
@@ -1758,8 +1768,11 @@ bool os::release_memory(char* addr, size_t bytes) {
 }
 
 void os::pretouch_memory(void* start, void* end, size_t page_size) {
-  for (volatile char *p = (char*)start; p < (char*)end; p += page_size) {
-    *p = 0;
+  assert(is_aligned(start, sizeof(int)), "must be");
+  // Touch with an atomic add of zero rather than a plain store, so that
+  // memory already in use by other threads can be pre-touched safely.
+  for (char* p = (char*)start; p < (char*)end; p += page_size) {
+    Atomic::add(reinterpret_cast<int*>(p), 0);
   }
 }
 
@@ -266,6 +266,14 @@ class os: AllStatic {
   // return true if found any
   static bool committed_in_range(address start, size_t size, address& committed_start, size_t& committed_size);
 
+  // Return how many bytes of the committed range (start, start + size) are
+  // resident in physical memory. Platforms that cannot tell report all of it.
+  static size_t resident_in_range(address start, size_t size);
+
+  // Return how many bytes of the range (start, start + size) are backed by
+  // transparent huge pages. Platforms that cannot tell report none.
+  static size_t huge_pages_in_range(address start, size_t size);
+
   // OS interface to Virtual Memory
 
   // Return the default page size.
@@ -417,6 +425,7 @@ class os: AllStatic {
     java_thread,       // Java, CodeCacheSweeper, JVMTIAgent and Service threads.
     compiler_thread,
     watcher_thread,
+    asynclog_thread,   // dedicated to flushing logs
     os_thread
   };
 
@@ -845,6 +854,8 @@ class os: AllStatic {
   // Thread priority helpers (implemented in OS-specific part)
   static OSReturn set_native_priority(Thread* thread, int native_prio);
   static OSReturn get_native_priority(const Thread* const thread, int* priority_ptr);
+  // Bind a thread to a list of CPUs and CPU ranges such as "0-3,8"
+  static OSReturn set_native_affinity(Thread* thread, const char* cpu_list);
   static int java_to_os_priority[CriticalPriority + 1];
   // Hint to the underlying OS that a task switch would not be good.
   // Void return because it's a hint and can fail.
@@ -55,6 +55,8 @@ enum ThreadState {
 
 typedef int (*OSThreadStartFunc)(void*);
 
+LINUX_ONLY(class PooledThreadStack;)
+
 class OSThread: public CHeapObj<mtThread> {
   friend class VMStructs;
   friend class JVMCIVMStructs;
@@ -27,6 +27,7 @@
 #include "classfile/vmSymbols.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
@@ -611,3 +612,35 @@ PerfTraceTime::~PerfTraceTime() {
   _t.stop();
   _timerp->inc(_t.ticks());
 }
+
+const jlong PerfHistogram::_bounds_us[PerfHistogram::bucket_count - 1] = {
+  100, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000
+};
+
+PerfHistogram* PerfDataManager::create_histogram(CounterNS ns, const char* name, TRAPS) {
+  ResourceMark rm;
+  PerfHistogram* h = new PerfHistogram();
+  char* bucket_ns = counter_name(name, "bucket");
+  for (int i = 0; i < PerfHistogram::bucket_count; i++) {
+    char* cname = name_space(bucket_ns, i);
+    h->_buckets[i] = create_long_counter(ns, cname, PerfData::U_Events, (jlong)0, CHECK_NULL);
+    if (i < PerfHistogram::bucket_count - 1) {
+      create_long_constant(ns, counter_name(cname, "le"), PerfData::U_None,
+                           PerfHistogram::_bounds_us[i], CHECK_NULL);
+    }
+  }
+  h->_sum = create_long_counter(ns, counter_name(name, "sum"), PerfData::U_None, (jlong)0, CHECK_NULL);
+  return h;
+}
+
+void PerfHistogram::sample_ticks(jlong ticks) {
+  if (!UsePerfData) return;
+  jlong us = (jlong)((double)ticks * 1000000.0 / (double)os::elapsed_frequency());
+  for (int i = 0; i < bucket_count - 1; i++) {
+    if (us <= _bounds_us[i]) {
+      _buckets[i]->inc();
+    }
+  }
+  _buckets[bucket_count - 1]->inc();
+  _sum->inc(us);
+}
@@ -661,6 +661,8 @@ class PerfDataList : public CHeapObj<mtInternal> {
  * subtypes via a set a factory methods and for managing lists
  * of the various PerfData types.
  */
+class PerfHistogram;
+
 class PerfDataManager : AllStatic {
 
   friend class StatSampler;   // for access to protected PerfDataList methods
@@ -860,6 +862,8 @@ class PerfDataManager : AllStatic {
       return create_long_counter(ns, name, u, sh, THREAD);
     }
 
+    static PerfHistogram* create_histogram(CounterNS ns, const char* name, TRAPS);
+
     static void destroy();
     static bool has_PerfData() { return _has_PerfData; }
 };
@@ -946,4 +950,36 @@ class PerfTraceTimedEvent : public PerfTraceTime {
 
 };
 
+/*
+ * PerfHistogram exports the distribution of a duration in the style of
+ * an OpenMetrics histogram, so external agents can read it from the
+ * PerfData memory like any other counter. The counter <name>.bucket.<i>
+ * counts the samples of at most <name>.bucket.<i>.le microseconds. The
+ * buckets are cumulative, and the last one has no bound and counts all
+ * samples. <name>.sum is the sum of all samples in microseconds.
+ */
+class PerfHistogram : public CHeapObj<mtInternal> {
+
+  friend class PerfDataManager; // for access to private constructor
+
+  public:
+    enum { bucket_count = 10 };
+
+  private:
+    static const jlong _bounds_us[bucket_count - 1];
+
+    PerfLongCounter* _buckets[bucket_count];
+    PerfLongCounter* _sum;
+
+    PerfHistogram() : _sum(NULL) {
+      for (int i = 0; i < bucket_count; i++) {
+        _buckets[i] = NULL;
+      }
+    }
+
+  public:
+    // Record a duration measured in os::elapsed_counter() ticks
+    void sample_ticks(jlong ticks);
+};
+
 #endif // SHARE_RUNTIME_PERFDATA_HPP
@@ -100,6 +100,13 @@ class RTMLockingCounters {
   uintx* abort_count_addr()               { return &_abort_count; }
   uintx* abortX_count_addr()              { return &_abortX_count[0]; }
 
+  uintx total_count() const               { return _total_count; }
+  uintx abort_count() const               { return _abort_count; }
+  uintx abortX_count(int i) const {
+    assert(0 <= i && i < ABORT_STATUS_LIMIT, "invalid abort status");
+    return _abortX_count[i];
+  }
+
   static int total_count_offset()         { return (int)offset_of(RTMLockingCounters, _total_count); }
   static int abort_count_offset()         { return (int)offset_of(RTMLockingCounters, _abort_count); }
   static int abortX_count_offset()        { return (int)offset_of(RTMLockingCounters, _abortX_count[0]); }
@@ -57,6 +57,7 @@
 #include "runtime/osThread.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/safepointMechanism.inline.hpp"
+#include "runtime/safepointProfiler.hpp"
 #include "runtime/signature.hpp"
 #include "runtime/stubCodeGenerator.hpp"
 #include "runtime/stubRoutines.hpp"
@@ -67,6 +68,7 @@
 #include "runtime/timerTrace.hpp"
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
+#include "utilities/latencyHistogram.hpp"
 #include "utilities/macros.hpp"
 
 static void post_safepoint_begin_event(EventSafepointBegin& event,
@@ -410,6 +412,10 @@ void SafepointSynchronize::begin() {
   // Update the count of active JNI critical regions
   GCLocker::set_jni_lock_count(_current_jni_active_count);
 
+  if (ProfileTimeToSafepoint) {
+    SafepointProfiler::record(_safepoint_counter, _safepoint_id, SafepointTracing::start_of_safepoint());
+  }
+
   post_safepoint_synchronize_event(sync_event,
                                    _safepoint_id,
                                    initial_running,
@@ -722,6 +728,10 @@ void SafepointSynchronize::block(JavaThread *thread) {
       // We have no idea where the VMThread is, it might even be at next safepoint.
       // So we can miss this poll, but stop at next.
 
+      if (ProfileTimeToSafepoint) {
+        thread->safepoint_state()->record_poll(safepoint_id);
+      }
+
       // Load dependent store, it must not pass loading of safepoint_id.
       thread->safepoint_state()->set_safepoint_id(safepoint_id); // Release store
 
@@ -842,7 +852,9 @@ void SafepointSynchronize::print_safepoint_timeout() {
 
 ThreadSafepointState::ThreadSafepointState(JavaThread *thread)
   : _at_poll_safepoint(false), _thread(thread), _safepoint_safe(false),
-    _safepoint_id(SafepointSynchronize::InactiveSafepointCounter), _next(NULL) {
+    _safepoint_id(SafepointSynchronize::InactiveSafepointCounter), _next(NULL),
+    _poll_safepoint_id(SafepointSynchronize::InactiveSafepointCounter), _poll_time_ns(0),
+    _poll_method(NULL), _poll_bci(InvocationEntryBci), _poll_pc(NULL) {
 }
 
 void ThreadSafepointState::create(JavaThread *thread) {
@@ -869,6 +881,44 @@ void ThreadSafepointState::set_safepoint_id(uint64_t safepoint_id) {
   Atomic::release_store(&_safepoint_id, safepoint_id);
 }
 
+// Called by the thread itself when it blocks for the safepoint. Only the
+// innermost Java frame is looked at, which is cheap enough to do on every
+// safepoint when profiling.
+void ThreadSafepointState::record_poll(uint64_t safepoint_id) {
+  assert(Thread::current() == _thread, "must be");
+  _poll_time_ns = os::javaTimeNanos();
+  _poll_method = NULL;
+  _poll_bci = InvocationEntryBci;
+  _poll_pc = NULL;
+
+  if (_thread->has_last_Java_frame()) {
+    RegisterMap map(_thread, false /* update_map */, false /* process_frames */);
+    frame fr = _thread->last_frame();
+    // Skip the safepoint stub and runtime frames on top of the Java frame.
+    for (int i = 0; i < 4 && !fr.is_java_frame() && !fr.is_first_frame(); i++) {
+      fr = fr.sender(&map);
+    }
+    if (fr.is_interpreted_frame()) {
+      _poll_method = fr.interpreter_frame_method();
+      _poll_bci = fr.interpreter_frame_bci();
+      _poll_pc = fr.pc();
+    } else if (fr.is_compiled_frame()) {
+      CompiledMethod* cm = fr.cb()->as_compiled_method();
+      _poll_pc = fr.pc();
+      if (cm->is_native_method()) {
+        _poll_method = cm->method();
+      } else {
+        // Attribute the poll to the innermost inlined method.
+        ResourceMark rm(_thread);
+        ScopeDesc* sd = cm->scope_desc_near(_poll_pc);
+        _poll_method = sd->method();
+        _poll_bci = sd->bci();
+      }
+    }
+  }
+  _poll_safepoint_id = safepoint_id;
+}
+
 void ThreadSafepointState::examine_state_of_thread(uint64_t safepoint_count) {
   assert(is_running(), "better be running or just have hit safepoint poll");
 
@@ -1025,6 +1075,9 @@ jlong     SafepointTracing::_max_sync_time = 0;
 jlong     SafepointTracing::_max_vmop_time = 0;
 uint64_t  SafepointTracing::_op_count[VM_Operation::VMOp_Terminating] = {0};
 
+static LatencyHistogram _sync_time_histogram("Safepoint synchronization");
+static LatencyHistogram _safepoint_time_histogram("Safepoint total");
+
 void SafepointTracing::init() {
   // Application start
   _last_safepoint_end_time_ns = os::javaTimeNanos();
@@ -1126,6 +1179,9 @@ void SafepointTracing::cleanup() {
 void SafepointTracing::end() {
   _last_safepoint_end_time_ns = os::javaTimeNanos();
 
+  _sync_time_histogram.record(_last_safepoint_sync_time_ns - _last_safepoint_begin_time_ns);
+  _safepoint_time_histogram.record(_last_safepoint_end_time_ns - _last_safepoint_begin_time_ns);
+
   if (_max_sync_time < (_last_safepoint_sync_time_ns - _last_safepoint_begin_time_ns)) {
     _max_sync_time = _last_safepoint_sync_time_ns - _last_safepoint_begin_time_ns;
   }
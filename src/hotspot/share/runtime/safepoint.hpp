@@ -208,6 +208,14 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
 
   ThreadSafepointState*           _next;
 
+  // Where and when the thread reached the poll of a safepoint,
+  // only recorded with ProfileTimeToSafepoint.
+  uint64_t                        _poll_safepoint_id;
+  jlong                           _poll_time_ns;
+  Method*                         _poll_method;
+  int                             _poll_bci;
+  address                         _poll_pc;
+
   void account_safe_thread();
 
  public:
@@ -236,6 +244,14 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
 
   void handle_polling_page_exception();
 
+  // Support for time-to-safepoint profiling
+  void     record_poll(uint64_t safepoint_id);
+  bool     has_poll_record(uint64_t safepoint_id) const { return _poll_safepoint_id == safepoint_id; }
+  jlong    poll_time_ns() const                         { return _poll_time_ns; }
+  Method*  poll_method() const                          { return _poll_method; }
+  int      poll_bci() const                             { return _poll_bci; }
+  address  poll_pc() const                              { return _poll_pc; }
+
   // debugging
   void print_on(outputStream* st) const;
 
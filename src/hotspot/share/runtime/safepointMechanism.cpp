@@ -28,6 +28,7 @@
 #include "runtime/orderAccess.hpp"
 #include "runtime/os.hpp"
 #include "runtime/safepointMechanism.inline.hpp"
+#include "runtime/stackWatermarkSet.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/globalDefinitions.hpp"
 
@@ -90,13 +91,24 @@ void SafepointMechanism::process_if_requested_slow(JavaThread *thread) {
   // local poll already checked, if used.
   process(thread);
 
+  // Process the frames of the thread that a GC left for lazy processing
+  // in the last safepoint before the thread is allowed to use them.
+  StackWatermarkSet::on_safepoint(thread);
+
+  // Record a JFR execution sample if the sampler thread asked for one.
+  JFR_ONLY(SAMPLE_THREAD_CONDITIONAL(thread);)
+
   OrderAccess::loadload();
 
   if (local_poll_armed(thread)) {
     disarm_local_poll_release(thread);
-    // We might have disarmed next safepoint/handshake
+    // We might have disarmed next safepoint/handshake/sample request
     OrderAccess::storeload();
-    if (global_poll() || thread->has_handshake()) {
+    // Keep the poll armed until all frames have been processed, so that
+    // the thread cannot return to its frames through any transition first.
+    if (global_poll() || thread->has_handshake() ||
+        !StackWatermarkSet::processing_completed(thread)
+        JFR_ONLY(|| thread->jfr_thread_local()->has_sample_request())) {
       arm_local_poll(thread);
     }
   }
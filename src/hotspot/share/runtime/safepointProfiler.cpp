@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/safepointProfiler.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/threadSMR.hpp"
+#include "utilities/ostream.hpp"
+
+// One histogram bucket per method where a late thread polled. The names are
+// copied to the C heap since the methods may be unloaded later on. Once the
+// table is full, further methods are accounted to a single overflow bucket.
+struct SafepointProfileEntry {
+  char*    _name;
+  uint64_t _count;
+  jlong    _total_ns;
+  jlong    _max_ns;
+};
+
+static const int profile_table_size = 256;
+static SafepointProfileEntry _table[profile_table_size + 1];
+static int _table_length = 0;
+static uint64_t _profiled_safepoints = 0;
+
+static const char* const no_java_frame_name = "<no Java frame>";
+static const char* const overflow_name = "<other methods>";
+
+static SafepointProfileEntry* find_or_add_entry(const char* name) {
+  for (int i = 0; i < _table_length; i++) {
+    if (strcmp(_table[i]._name, name) == 0) {
+      return &_table[i];
+    }
+  }
+  SafepointProfileEntry* entry;
+  if (_table_length < profile_table_size) {
+    entry = &_table[_table_length++];
+    entry->_name = os::strdup_check_oom(name, mtInternal);
+  } else {
+    entry = &_table[profile_table_size];
+    if (entry->_name == NULL) {
+      entry->_name = os::strdup_check_oom(overflow_name, mtInternal);
+    }
+  }
+  return entry;
+}
+
+static void post_late_thread_event(uint64_t safepoint_id, ThreadSafepointState* tss, jlong delay_ns) {
+  EventSafepointLateThread event;
+  if (event.should_commit()) {
+    event.set_safepointId(safepoint_id);
+    event.set_thread(JFR_THREAD_ID(tss->thread()));
+    event.set_method(tss->poll_method());
+    event.set_bytecodeIndex(tss->poll_bci());
+    event.set_pc((u8)tss->poll_pc());
+    event.set_timeToSafepoint(delay_ns);
+    event.commit();
+  }
+}
+
+void SafepointProfiler::record(uint64_t safepoint_counter, uint64_t safepoint_id, jlong begin_ns) {
+  assert_at_safepoint();
+  assert(Thread::current()->is_VM_thread(), "only the VMThread");
+  ResourceMark rm;
+
+  // Keep the slowest threads sorted by arrival time, latest first.
+  const int max_late = (int)ProfileTimeToSafepointThreads;
+  ThreadSafepointState** late = NEW_RESOURCE_ARRAY(ThreadSafepointState*, max_late);
+  int num_late = 0;
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread* jt = jtiwh.next(); ) {
+    ThreadSafepointState* tss = jt->safepoint_state();
+    if (!tss->has_poll_record(safepoint_counter)) {
+      // Did not block at a poll, e.g. it was in native or blocked already.
+      continue;
+    }
+    int pos = num_late < max_late ? num_late++ : max_late;
+    while (pos > 0 && late[pos - 1]->poll_time_ns() < tss->poll_time_ns()) {
+      if (pos < max_late) {
+        late[pos] = late[pos - 1];
+      }
+      pos--;
+    }
+    if (pos < max_late) {
+      late[pos] = tss;
+    }
+  }
+
+  MutexLocker ml(SafepointProfile_lock, Mutex::_no_safepoint_check_flag);
+  _profiled_safepoints++;
+  for (int i = 0; i < num_late; i++) {
+    ThreadSafepointState* tss = late[i];
+    jlong delay_ns = MAX2(tss->poll_time_ns() - begin_ns, (jlong)0);
+    Method* method = tss->poll_method();
+    const char* name = method != NULL ? method->name_and_sig_as_C_string() : no_java_frame_name;
+
+    log_debug(safepoint)("Late thread " INTPTR_FORMAT " reached safepoint " UINT64_FORMAT " after "
+                         JLONG_FORMAT " ns at %s bci %d pc " INTPTR_FORMAT,
+                         p2i(tss->thread()), safepoint_id, delay_ns, name, tss->poll_bci(), p2i(tss->poll_pc()));
+    post_late_thread_event(safepoint_id, tss, delay_ns);
+
+    SafepointProfileEntry* entry = find_or_add_entry(name);
+    entry->_count++;
+    entry->_total_ns += delay_ns;
+    entry->_max_ns = MAX2(entry->_max_ns, delay_ns);
+  }
+}
+
+static int compare_by_total(const void* a, const void* b) {
+  jlong ta = ((const SafepointProfileEntry*)a)->_total_ns;
+  jlong tb = ((const SafepointProfileEntry*)b)->_total_ns;
+  return ta < tb ? 1 : (ta > tb ? -1 : 0);
+}
+
+void SafepointProfiler::print_on(outputStream* st) {
+  ResourceMark rm;
+  MutexLocker ml(SafepointProfile_lock, Mutex::_no_safepoint_check_flag);
+
+  int length = _table_length;
+  SafepointProfileEntry* sorted = NEW_RESOURCE_ARRAY(SafepointProfileEntry, profile_table_size + 1);
+  memcpy(sorted, _table, length * sizeof(SafepointProfileEntry));
+  if (_table[profile_table_size]._name != NULL) {
+    sorted[length++] = _table[profile_table_size];
+  }
+  qsort(sorted, length, sizeof(SafepointProfileEntry), compare_by_total);
+
+  st->print_cr("Time to safepoint profile: " UINT64_FORMAT " safepoints, up to %u late threads each",
+               _profiled_safepoints, ProfileTimeToSafepointThreads);
+  st->print_cr("%10s %14s %14s  %s", "Count", "Total (us)", "Max (us)", "Method");
+  for (int i = 0; i < length; i++) {
+    st->print_cr(UINT64_FORMAT_W(10) " " JLONG_FORMAT_W(14) " " JLONG_FORMAT_W(14) "  %s",
+                 sorted[i]._count,
+                 sorted[i]._total_ns / (NANOUNITS / MICROUNITS),
+                 sorted[i]._max_ns / (NANOUNITS / MICROUNITS),
+                 sorted[i]._name);
+  }
+}
+
+void SafepointProfiler::reset() {
+  MutexLocker ml(SafepointProfile_lock, Mutex::_no_safepoint_check_flag);
+  for (int i = 0; i <= profile_table_size; i++) {
+    if (_table[i]._name != NULL) {
+      os::free(_table[i]._name);
+    }
+    _table[i]._name = NULL;
+    _table[i]._count = 0;
+    _table[i]._total_ns = 0;
+    _table[i]._max_ns = 0;
+  }
+  _table_length = 0;
+  _profiled_safepoints = 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_RUNTIME_SAFEPOINTPROFILER_HPP
+#define SHARE_RUNTIME_SAFEPOINTPROFILER_HPP
+
+#include "memory/allocation.hpp"
+
+class outputStream;
+
+// Time-to-safepoint profiling, enabled with ProfileTimeToSafepoint.
+//
+// Every JavaThread that blocks for a safepoint records when it got there
+// and its innermost Java frame in its ThreadSafepointState. Once all threads
+// are safe, the VMThread picks the ProfileTimeToSafepointThreads threads
+// that arrived last, posts a SafepointLateThread event for each and adds
+// them to a histogram by method. The histogram shows which methods keep
+// safepoints waiting, e.g. because of long counted loops without polls.
+class SafepointProfiler : AllStatic {
+ public:
+  // Called by the VMThread after synchronization, while all threads are stopped.
+  static void record(uint64_t safepoint_counter, uint64_t safepoint_id, jlong begin_ns);
+
+  static void print_on(outputStream* st);
+  static void reset();
+};
+
+#endif // SHARE_RUNTIME_SAFEPOINTPROFILER_HPP
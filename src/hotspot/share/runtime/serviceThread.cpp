@@ -147,6 +147,7 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     JvmtiDeferredEvent jvmti_event;
     bool oop_handles_to_release = false;
     bool cldg_cleanup_work = false;
+    bool cldg_purge_work = false;
     {
       // Need state transition ThreadBlockInVM so that this thread
       // will be handled by safepoint correctly when this thread is
@@ -175,6 +176,7 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
               (oopstorage_work = OopStorage::has_cleanup_work_and_reset()) |
               (oop_handles_to_release = (_oop_handle_list != NULL)) |
               (cldg_cleanup_work = ClassLoaderDataGraph::should_clean_metaspaces_and_reset()) |
+              (cldg_purge_work = ClassLoaderDataGraph::has_deferred_purge()) |
               (deflate_idle_monitors = ObjectSynchronizer::is_async_deflation_needed())
              ) == 0) {
         // Wait until notified that there is some work to do.
@@ -241,6 +243,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
       release_oop_handles();
     }
 
+    if (cldg_purge_work) {
+      ClassLoaderDataGraph::purge_deferred(jt);
+    }
+
     if (cldg_cleanup_work) {
       ClassLoaderDataGraph::safepoint_and_clean_metaspaces();
     }
@@ -257,8 +263,8 @@ void ServiceThread::enqueue_deferred_event(JvmtiDeferredEvent* event) {
   Service_lock->notify_all();
  }
 
-void ServiceThread::oops_do(OopClosure* f, CodeBlobClosure* cf) {
-  JavaThread::oops_do(f, cf);
+void ServiceThread::oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf) {
+  JavaThread::oops_do_no_frames(f, cf);
   // The ServiceThread "owns" the JVMTI Deferred events, scan them here
   // to keep them alive until they are processed.
   if (_jvmti_event != NULL) {
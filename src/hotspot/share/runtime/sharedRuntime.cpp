@@ -32,6 +32,7 @@
 #include "code/compiledIC.hpp"
 #include "code/icBuffer.hpp"
 #include "code/compiledMethod.inline.hpp"
+#include "code/perfMap.hpp"
 #include "code/scopeDesc.hpp"
 #include "code/vtableStubs.hpp"
 #include "compiler/abstractCompiler.hpp"
@@ -1601,7 +1602,14 @@ bool SharedRuntime::handle_ic_miss_helper_internal(Handle receiver, CompiledMeth
       return false;
     }
   } else if (!inline_cache->is_megamorphic() && !inline_cache->is_clean()) {
-    // Potential change to megamorphic
+    // Potential change to polymorphic or megamorphic
+
+    if (inline_cache->set_to_polymorphic(&call_info, bc, receiver()->klass(), needs_ic_stub_refill)) {
+      return true;
+    }
+    if (needs_ic_stub_refill) {
+      return false;
+    }
 
     bool successful = inline_cache->set_to_megamorphic(&call_info, bc, needs_ic_stub_refill, CHECK_false);
     if (needs_ic_stub_refill) {
@@ -2747,6 +2755,7 @@ AdapterHandlerEntry* AdapterHandlerLibrary::get_adapter0(const methodHandle& met
                  fingerprint->as_string(),
                  new_adapter->content_begin());
     Forte::register_stub(blob_id, new_adapter->content_begin(), new_adapter->content_end());
+    LINUX_ONLY(PerfMap::register_stub(NULL, blob_id, new_adapter->content_begin(), new_adapter->content_end());)
 
     if (JvmtiExport::should_post_dynamic_code_generated()) {
       JvmtiExport::post_dynamic_code_generated(blob_id, new_adapter->content_begin(), new_adapter->content_end());
@@ -3067,7 +3076,8 @@ JRT_LEAF(intptr_t*, SharedRuntime::OSR_migration_begin( JavaThread *thread) )
     if (kptr2->obj() != NULL) {         // Avoid 'holes' in the monitor array
       BasicLock *lock = kptr2->lock();
       // Inflate so the object's header no longer refers to the BasicLock.
-      if (lock->displaced_header().is_unlocked()) {
+      // A fast-locked header never refers to it.
+      if (!UseLightweightLocking && lock->displaced_header().is_unlocked()) {
         // The object is locked and the resulting ObjectMonitor* will also be
         // locked so it can't be async deflated until ownership is dropped.
         // See the big comment in basicLock.cpp: BasicLock::move_to().
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/frame.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/stackWatermark.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+StackWatermark::StackWatermark(JavaThread* jt, StackWatermarkKind kind, uint32_t epoch) :
+    _jt(jt),
+    _kind(kind),
+    _state(StackWatermarkState::create(epoch, true /* is_done */)),
+    _next(NULL),
+    _lock(Mutex::tty - 1, "stack_watermark_lock", true, Mutex::_safepoint_check_never) {}
+
+uint32_t StackWatermark::state_acquire() const {
+  return Atomic::load_acquire(&_state);
+}
+
+bool StackWatermark::processing_completed(uint32_t state) const {
+  return state == StackWatermarkState::create(epoch_id(), true /* is_done */);
+}
+
+bool StackWatermark::processing_completed() const {
+  return processing_completed(state_acquire());
+}
+
+void StackWatermark::process_frames(void* context) {
+  if (_jt->has_last_Java_frame()) {
+    ResourceMark rm;
+    for (StackFrameStream fst(_jt, true /* update */, false /* process_frames */); !fst.is_done(); fst.next()) {
+      process(*fst.current(), *fst.register_map(), context);
+    }
+  }
+  Atomic::release_store(&_state, StackWatermarkState::create(epoch_id(), true /* is_done */));
+}
+
+void StackWatermark::process_frames_if_needed(void* context) {
+  if (processing_completed(state_acquire())) {
+    // Fast path; the stack has already been processed in this epoch
+    return;
+  }
+  MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
+  if (!processing_completed(_state)) {
+    process_frames(context);
+  }
+}
+
+void StackWatermark::start_processing() {
+  process_frames_if_needed(NULL /* context */);
+}
+
+void StackWatermark::finish_processing(void* context) {
+  process_frames_if_needed(context);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_RUNTIME_STACKWATERMARK_HPP
+#define SHARE_RUNTIME_STACKWATERMARK_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/stackWatermarkKind.hpp"
+
+class frame;
+class JavaThread;
+class RegisterMap;
+
+// A stack watermark lets a GC defer the processing of the oops in the
+// frames of a thread from the safepoint where its roots are flipped to
+// after the safepoint. The frames of the thread are processed lazily,
+// either by the thread itself, the first time it wakes up after the
+// safepoint or walks its own stack, or by any other thread walking the
+// stack, or by GC worker threads that finish processing concurrently.
+// The processing is done for the whole stack at once, and is guarded by
+// a per-watermark lock. Each GC defines its own epochs; when the epoch
+// changes, the stack needs to be processed again before it is used.
+
+class StackWatermarkState : public AllStatic {
+public:
+  inline static bool is_done(uint32_t state) {
+    return state & 1;
+  }
+
+  inline static uint32_t epoch(uint32_t state) {
+    return state >> 1;
+  }
+
+  inline static uint32_t create(uint32_t epoch, bool is_done) {
+    return (epoch << 1) | (is_done ? 1u : 0u);
+  }
+};
+
+class StackWatermark : public CHeapObj<mtThread> {
+  friend class StackWatermarkSet;
+
+private:
+  JavaThread* const        _jt;
+  const StackWatermarkKind _kind;
+  volatile uint32_t        _state;
+  StackWatermark*          _next;
+  Mutex                    _lock;
+
+  bool processing_completed(uint32_t state) const;
+  uint32_t state_acquire() const;
+  void process_frames(void* context);
+  void process_frames_if_needed(void* context);
+
+protected:
+  // The current epoch of the GC owning this watermark
+  virtual uint32_t epoch_id() const = 0;
+  // Process the oops of a single frame
+  virtual void process(frame& fr, RegisterMap& register_map, void* context) = 0;
+
+public:
+  StackWatermark(JavaThread* jt, StackWatermarkKind kind, uint32_t epoch);
+  virtual ~StackWatermark() {}
+
+  JavaThread* thread() const { return _jt; }
+  StackWatermarkKind kind() const { return _kind; }
+  StackWatermark* next() const { return _next; }
+  void set_next(StackWatermark* n) { _next = n; }
+
+  // Returns true if the stack has been processed in the current epoch
+  bool processing_completed() const;
+
+  // Called by the thread itself or by stack walkers before the frames are used
+  void start_processing();
+  // Called by GC workers to process the stack with a GC specific context
+  void finish_processing(void* context);
+};
+
+#endif // SHARE_RUNTIME_STACKWATERMARK_HPP
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "runtime/stackWatermark.hpp"
+#include "runtime/stackWatermarkSet.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/debug.hpp"
+
+StackWatermarks::StackWatermarks() :
+    _head(NULL) {}
+
+StackWatermarks::~StackWatermarks() {
+  StackWatermark* current = _head;
+  while (current != NULL) {
+    StackWatermark* next = current->next();
+    delete current;
+    current = next;
+  }
+}
+
+StackWatermark* StackWatermarkSet::head(JavaThread* jt) {
+  return jt->stack_watermarks()->_head;
+}
+
+void StackWatermarkSet::set_head(JavaThread* jt, StackWatermark* watermark) {
+  jt->stack_watermarks()->_head = watermark;
+}
+
+void StackWatermarkSet::add_watermark(JavaThread* jt, StackWatermark* watermark) {
+  assert(!has_watermark(jt, watermark->kind()), "Two instances of same kind");
+  watermark->set_next(head(jt));
+  set_head(jt, watermark);
+}
+
+StackWatermark* StackWatermarkSet::get(JavaThread* jt, StackWatermarkKind kind) {
+  for (StackWatermark* current = head(jt); current != NULL; current = current->next()) {
+    if (current->kind() == kind) {
+      return current;
+    }
+  }
+  return NULL;
+}
+
+bool StackWatermarkSet::has_watermark(JavaThread* jt, StackWatermarkKind kind) {
+  return get(jt, kind) != NULL;
+}
+
+void StackWatermarkSet::on_safepoint(JavaThread* jt) {
+  for (StackWatermark* current = head(jt); current != NULL; current = current->next()) {
+    current->start_processing();
+  }
+}
+
+bool StackWatermarkSet::processing_completed(JavaThread* jt) {
+  for (StackWatermark* current = head(jt); current != NULL; current = current->next()) {
+    if (!current->processing_completed()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StackWatermarkSet::start_processing(JavaThread* jt, StackWatermarkKind kind) {
+  StackWatermark* watermark = get(jt, kind);
+  if (watermark != NULL) {
+    watermark->start_processing();
+  }
+}
+
+void StackWatermarkSet::finish_processing(JavaThread* jt, void* context, StackWatermarkKind kind) {
+  StackWatermark* watermark = get(jt, kind);
+  if (watermark != NULL) {
+    watermark->finish_processing(context);
+  }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_RUNTIME_STACKWATERMARKSET_HPP
+#define SHARE_RUNTIME_STACKWATERMARKSET_HPP
+
+#include "memory/allStatic.hpp"
+#include "runtime/stackWatermarkKind.hpp"
+
+class JavaThread;
+class StackWatermark;
+
+// A thread may have multiple watermarks installed, one per kind.
+
+class StackWatermarks {
+  friend class StackWatermarkSet;
+
+private:
+  StackWatermark* _head;
+
+public:
+  StackWatermarks();
+  ~StackWatermarks();
+};
+
+class StackWatermarkSet : public AllStatic {
+private:
+  static StackWatermark* head(JavaThread* jt);
+  static void set_head(JavaThread* jt, StackWatermark* watermark);
+
+public:
+  static void add_watermark(JavaThread* jt, StackWatermark* watermark);
+
+  static StackWatermark* get(JavaThread* jt, StackWatermarkKind kind);
+  static bool has_watermark(JavaThread* jt, StackWatermarkKind kind);
+
+  // Called by the thread when it wakes up after a safepoint or handshake,
+  // before it uses any of its own frames.
+  static void on_safepoint(JavaThread* jt);
+
+  // Returns true if all watermarks of the thread have been processed
+  // in their current epoch.
+  static bool processing_completed(JavaThread* jt);
+
+  // Called by stack walkers before the frames of the thread are used.
+  static void start_processing(JavaThread* jt, StackWatermarkKind kind);
+
+  // Called by GC workers to make sure all frames of the thread are processed.
+  static void finish_processing(JavaThread* jt, void* context, StackWatermarkKind kind);
+};
+
+#endif // SHARE_RUNTIME_STACKWATERMARKSET_HPP
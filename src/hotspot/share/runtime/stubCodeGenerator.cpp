@@ -26,6 +26,7 @@
 #include "asm/macroAssembler.hpp"
 #include "asm/macroAssembler.inline.hpp"
 #include "code/codeCache.hpp"
+#include "code/perfMap.hpp"
 #include "compiler/disassembler.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/forte.hpp"
@@ -56,6 +57,11 @@ void StubCodeDesc::freeze() {
   _frozen = true;
 }
 
+void StubCodeDesc::unfreeze() {
+  assert(_frozen, "repeated unfreeze operation");
+  _frozen = false;
+}
+
 void StubCodeDesc::print_on(outputStream* st) const {
   st->print("%s", group());
   st->print("::");
@@ -125,6 +131,7 @@ StubCodeMark::~StubCodeMark() {
   assert(StubCodeDesc::_list == _cdesc, "expected order on list");
   _cgen->stub_epilog(_cdesc);
   Forte::register_stub(_cdesc->name(), _cdesc->begin(), _cdesc->end());
+  LINUX_ONLY(PerfMap::register_stub(_cdesc->group(), _cdesc->name(), _cdesc->begin(), _cdesc->end());)
 
   if (JvmtiExport::should_post_dynamic_code_generated()) {
     JvmtiExport::post_dynamic_code_generated(_cdesc->name(), _cdesc->begin(), _cdesc->end());
@@ -80,6 +80,7 @@ class StubCodeDesc: public CHeapObj<mtCode> {
   };
 
   static void freeze();
+  static void unfreeze();
 
   const char* group() const                      { return _group; }
   const char* name() const                       { return _name; }
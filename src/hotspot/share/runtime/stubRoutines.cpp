@@ -25,12 +25,14 @@
 #include "precompiled.hpp"
 #include "asm/codeBuffer.hpp"
 #include "asm/macroAssembler.inline.hpp"
+#include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/sharedRuntime.hpp"
+#include "runtime/stubCodeGenerator.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "utilities/align.hpp"
 #include "utilities/copy.hpp"
@@ -51,6 +53,7 @@ address UnsafeCopyMemory::_common_exit_stub_pc                  = NULL;
 
 BufferBlob* StubRoutines::_code1                                = NULL;
 BufferBlob* StubRoutines::_code2                                = NULL;
+BufferBlob* StubRoutines::_code3                                = NULL;
 
 address StubRoutines::_call_stub_return_address                 = NULL;
 address StubRoutines::_call_stub_entry                          = NULL;
@@ -62,6 +65,7 @@ address StubRoutines::_throw_IncompatibleClassChangeError_entry = NULL;
 address StubRoutines::_throw_NullPointerException_at_call_entry = NULL;
 address StubRoutines::_throw_StackOverflowError_entry           = NULL;
 address StubRoutines::_throw_delayed_StackOverflowError_entry   = NULL;
+address StubRoutines::_polymorphic_ic_stub                      = NULL;
 jint    StubRoutines::_verify_oop_count                         = 0;
 address StubRoutines::_verify_oop_subroutine_entry              = NULL;
 address StubRoutines::_atomic_xchg_entry                        = NULL;
@@ -137,6 +141,8 @@ address StubRoutines::_electronicCodeBook_decryptAESCrypt  = NULL;
 address StubRoutines::_counterMode_AESCrypt                = NULL;
 address StubRoutines::_ghash_processBlocks                 = NULL;
 address StubRoutines::_base64_encodeBlock                  = NULL;
+address StubRoutines::_base64_decodeBlock                  = NULL;
+address StubRoutines::_chacha20Block                       = NULL;
 
 address StubRoutines::_md5_implCompress      = NULL;
 address StubRoutines::_md5_implCompressMB    = NULL;
@@ -164,6 +170,12 @@ address StubRoutines::_bigIntegerLeftShiftWorker = NULL;
 
 address StubRoutines::_vectorizedMismatch = NULL;
 
+address StubRoutines::_vectorizedHashCode_boolean = NULL;
+address StubRoutines::_vectorizedHashCode_byte = NULL;
+address StubRoutines::_vectorizedHashCode_char = NULL;
+address StubRoutines::_vectorizedHashCode_short = NULL;
+address StubRoutines::_vectorizedHashCode_int = NULL;
+
 address StubRoutines::_dexp = NULL;
 address StubRoutines::_dlog = NULL;
 address StubRoutines::_dlog10 = NULL;
@@ -187,8 +199,11 @@ address StubRoutines::_safefetchN_continuation_pc        = NULL;
 // Note: to break cycle with universe initialization, stubs are generated in two phases.
 // The first one generates stubs needed during universe init (e.g., _handle_must_compile_first_entry).
 // The second phase includes all other stubs (which may depend on universe being initialized.)
+// Platforms that define a non-zero compiler_stubs_code_size move the intrinsic stubs only
+// called from compiled code into a separate phase, see initialize_compiler_stubs().
 
 extern void StubGenerator_generate(CodeBuffer* code, bool all); // only interface to generators
+extern void StubGenerator_generate_compiler_stubs(CodeBuffer* code);
 
 void UnsafeCopyMemory::create_table(int max_size) {
   UnsafeCopyMemory::_table = new UnsafeCopyMemory[max_size];
@@ -402,9 +417,52 @@ void StubRoutines::initialize2() {
 #endif
 }
 
+bool StubRoutines::delay_compiler_stubs() {
+#ifdef COMPILER2
+  // JVMCI and AOT code read the stub entry points when they are
+  // initialized, which may happen before C2 is.
+  return DelayCompilerStubsGeneration AOT_ONLY(&& !UseAOT) JVMCI_ONLY(&& !EnableJVMCI);
+#else
+  return false;
+#endif
+}
+
+void StubRoutines::initialize_compiler_stubs(bool in_compiler_thread) {
+  if (compiler_stubs_code_size == 0 || in_compiler_thread != delay_compiler_stubs()) {
+    return;
+  }
+  assert(_code3 == NULL, "compiler stubs generated twice");
+  ResourceMark rm;
+  TraceTime timer("StubRoutines generation compiler stubs", TRACETIME_LOG(Info, startuptime));
+  BufferBlob* blob = BufferBlob::create("StubRoutines (compiler stubs)", compiler_stubs_code_size);
+  if (blob == NULL) {
+    if (!in_compiler_thread) {
+      vm_exit_out_of_memory(compiler_stubs_code_size, OOM_MALLOC_ERROR, "CodeCache: no room for StubRoutines (compiler stubs)");
+    }
+    // The entry points stay NULL and C2 falls back to the Java
+    // implementations of the affected intrinsics.
+    log_warning(codecache)("CodeCache: no room for StubRoutines (compiler stubs)");
+    return;
+  }
+  if (in_compiler_thread) {
+    // The stub descriptors were frozen at the end of VM startup. Only
+    // the compiler thread initializing C2 adds to them from now on.
+    StubCodeDesc::unfreeze();
+  }
+  CodeBuffer buffer(blob);
+  StubGenerator_generate_compiler_stubs(&buffer);
+  // When new stubs added we need to make sure there is some space left
+  // to catch situation when we should increase size again.
+  assert(buffer.insts_remaining() > 200, "increase compiler_stubs_code_size");
+  if (in_compiler_thread) {
+    StubCodeDesc::freeze();
+  }
+  _code3 = blob;
+}
 
 void stubRoutines_init1() { StubRoutines::initialize1(); }
 void stubRoutines_init2() { StubRoutines::initialize2(); }
+void compiler_stubs_init() { StubRoutines::initialize_compiler_stubs(false /* in_compiler_thread */); }
 
 //
 // Default versions of arraycopy functions
@@ -141,6 +141,8 @@ class StubRoutines: AllStatic {
   static address _throw_StackOverflowError_entry;
   static address _throw_delayed_StackOverflowError_entry;
 
+  static address _polymorphic_ic_stub;                    // dispatch for polymorphic inline caches, may be NULL
+
   static address _atomic_xchg_entry;
   static address _atomic_xchg_long_entry;
   static address _atomic_store_entry;
@@ -162,6 +164,7 @@ class StubRoutines: AllStatic {
 
   static BufferBlob* _code1;                               // code buffer for initial routines
   static BufferBlob* _code2;                               // code buffer for all other routines
+  static BufferBlob* _code3;                               // code buffer for compiler intrinsic routines
 
   // Leaf routines which implement arraycopy and their addresses
   // arraycopy operands aligned on element type boundary
@@ -219,6 +222,8 @@ class StubRoutines: AllStatic {
   static address _counterMode_AESCrypt;
   static address _ghash_processBlocks;
   static address _base64_encodeBlock;
+  static address _base64_decodeBlock;
+  static address _chacha20Block;
 
   static address _md5_implCompress;
   static address _md5_implCompressMB;
@@ -246,6 +251,12 @@ class StubRoutines: AllStatic {
 
   static address _vectorizedMismatch;
 
+  static address _vectorizedHashCode_boolean;
+  static address _vectorizedHashCode_byte;
+  static address _vectorizedHashCode_char;
+  static address _vectorizedHashCode_short;
+  static address _vectorizedHashCode_int;
+
   static address _dexp;
   static address _dlog;
   static address _dlog10;
@@ -269,13 +280,20 @@ class StubRoutines: AllStatic {
   // Initialization/Testing
   static void    initialize1();                            // must happen before universe::genesis
   static void    initialize2();                            // must happen after  universe::genesis
+  static void    initialize_compiler_stubs(bool in_compiler_thread);
+
+  // The intrinsic stubs that are only called from C2 compiled code are
+  // generated by the C2 compiler thread when the compiler is initialized,
+  // unless JVMCI or AOT code may need their entry points earlier.
+  static bool    delay_compiler_stubs();
 
   static bool is_stub_code(address addr)                   { return contains(addr); }
 
   static bool contains(address addr) {
     return
       (_code1 != NULL && _code1->blob_contains(addr)) ||
-      (_code2 != NULL && _code2->blob_contains(addr)) ;
+      (_code2 != NULL && _code2->blob_contains(addr)) ||
+      (_code3 != NULL && _code3->blob_contains(addr)) ;
   }
 
   static RuntimeBlob* code1() { return _code1; }
@@ -312,6 +330,8 @@ class StubRoutines: AllStatic {
   static address throw_StackOverflowError_entry()          { return _throw_StackOverflowError_entry; }
   static address throw_delayed_StackOverflowError_entry()  { return _throw_delayed_StackOverflowError_entry; }
 
+  static address polymorphic_ic_stub()                     { return _polymorphic_ic_stub; }
+
   static address atomic_xchg_entry()                       { return _atomic_xchg_entry; }
   static address atomic_xchg_long_entry()                  { return _atomic_xchg_long_entry; }
   static address atomic_store_entry()                      { return _atomic_store_entry; }
@@ -399,6 +419,8 @@ class StubRoutines: AllStatic {
   static address counterMode_AESCrypt()  { return _counterMode_AESCrypt; }
   static address ghash_processBlocks()   { return _ghash_processBlocks; }
   static address base64_encodeBlock()    { return _base64_encodeBlock; }
+  static address base64_decodeBlock()    { return _base64_decodeBlock; }
+  static address chacha20Block()         { return _chacha20Block; }
   static address md5_implCompress()      { return _md5_implCompress; }
   static address md5_implCompressMB()    { return _md5_implCompressMB; }
   static address sha1_implCompress()     { return _sha1_implCompress; }
@@ -425,6 +447,17 @@ class StubRoutines: AllStatic {
 
   static address vectorizedMismatch()  { return _vectorizedMismatch; }
 
+  static address vectorizedHashCode(BasicType type) {
+    switch (type) {
+      case T_BOOLEAN: return _vectorizedHashCode_boolean;
+      case T_BYTE:    return _vectorizedHashCode_byte;
+      case T_CHAR:    return _vectorizedHashCode_char;
+      case T_SHORT:   return _vectorizedHashCode_short;
+      case T_INT:     return _vectorizedHashCode_int;
+      default:        return NULL;
+    }
+  }
+
   static address dexp()                { return _dexp; }
   static address dlog()                { return _dlog; }
   static address dlog10()              { return _dlog10; }
@@ -133,6 +133,7 @@ public:
     assert(cb->is_nmethod(), "CodeBlob should be nmethod");
     nmethod* nm = (nmethod*)cb;
     nm->set_hotness_counter(NMethodSweeper::hotness_counter_reset_val());
+    nm->mark_as_seen_active();
     // If we see an activation belonging to a non_entrant nmethod, we mark it.
     if (nm->is_not_entrant()) {
       nm->mark_as_seen_on_stack();
@@ -237,6 +238,31 @@ void NMethodSweeper::report_allocation(int code_blob_type) {
   }
 }
 
+/**
+  * Wakes up the sweeper thread after a GC unloading cycle if nmethods
+  * changed state since the last sweep. Unloaded nmethods are then reclaimed
+  * right after the cycle instead of waiting for the state change threshold
+  * to be reached or for the code cache to fill up.
+  */
+void NMethodSweeper::report_unloading_cycle() {
+  if (MethodFlushing && Atomic::load(&_bytes_changed) > 0) {
+    MonitorLocker waiter(CodeSweeper_lock, Mutex::_no_safepoint_check_flag);
+    _should_sweep = true;
+    CodeSweeper_lock->notify();
+  }
+}
+
+/**
+  * Called from the nmethod entry barrier on the first entry after a GC cycle
+  * armed it. That is a direct sign of use, unlike stack scanning which only
+  * sees nmethods that happen to be active during the handshake, so it resets
+  * the hotness counter the same way MarkActivationClosure does.
+  */
+void NMethodSweeper::report_nmethod_entry(nmethod* nm) {
+  nm->set_hotness_counter(hotness_counter_reset_val());
+  nm->mark_as_seen_active();
+}
+
 bool NMethodSweeper::should_start_aggressive_sweep(int code_blob_type) {
   // Makes sure that we do not invoke the sweeper too often during startup.
   double start_threshold = 100.0 / (double)StartAggressiveSweepingAt;
@@ -606,6 +632,9 @@ void NMethodSweeper::possibly_flush(nmethod* nm) {
       }
 
       if (make_not_entrant) {
+        if (!nm->seen_active()) {
+          CompileBroker::record_unused_compilation(nm);
+        }
         nm->make_not_entrant();
 
         // Code cache state change is tracked in make_not_entrant()
@@ -118,6 +118,8 @@ class NMethodSweeper : public AllStatic {
   static int hotness_counter_reset_val();
   static void report_state_change(nmethod* nm);
   static void report_allocation(int code_blob_type);  // Possibly start the sweeper thread.
+  static void report_unloading_cycle();               // Sweep after GC unloading if there is work
+  static void report_nmethod_entry(nmethod* nm);      // nmethod entry barrier saw nm being entered
   static void possibly_flush(nmethod* nm);
   static void print(outputStream* out);   // Printing/debugging
   static void print() { print(tty); }
@@ -39,6 +39,7 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/lockStack.inline.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
@@ -55,6 +56,7 @@
 #include "utilities/align.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/events.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/preserveException.hpp"
 
 // The "core" versions of monitor enter and exit reside in this file.
@@ -118,310 +120,100 @@ int dtrace_waited_probe(ObjectMonitor* monitor, Handle obj, Thread* thr) {
 #define NINFLATIONLOCKS 256
 static volatile intptr_t gInflationLocks[NINFLATIONLOCKS];
 
-// global list of blocks of monitors
-PaddedObjectMonitor* ObjectSynchronizer::g_block_list = NULL;
+MonitorList ObjectSynchronizer::_in_use_list;
+volatile size_t ObjectSynchronizer::_in_use_list_ceiling = 0;
 bool volatile ObjectSynchronizer::_is_async_deflation_requested = false;
 jlong ObjectSynchronizer::_last_async_deflation_time_ns = 0;
 
-struct ObjectMonitorListGlobals {
-  char         _pad_prefix[OM_CACHE_LINE_SIZE];
-  // These are highly shared list related variables.
-  // To avoid false-sharing they need to be the sole occupants of a cache line.
-
-  // Global ObjectMonitor free list. Newly allocated and deflated
-  // ObjectMonitors are prepended here.
-  ObjectMonitor* _free_list;
-  DEFINE_PAD_MINUS_SIZE(1, OM_CACHE_LINE_SIZE, sizeof(ObjectMonitor*));
-
-  // Global ObjectMonitor in-use list. When a JavaThread is exiting,
-  // ObjectMonitors on its per-thread in-use list are prepended here.
-  ObjectMonitor* _in_use_list;
-  DEFINE_PAD_MINUS_SIZE(2, OM_CACHE_LINE_SIZE, sizeof(ObjectMonitor*));
-
-  // Global ObjectMonitor wait list. Deflated ObjectMonitors wait on
-  // this list until after a handshake or a safepoint for platforms
-  // that don't support handshakes. After the handshake or safepoint,
-  // the deflated ObjectMonitors are prepended to free_list.
-  ObjectMonitor* _wait_list;
-  DEFINE_PAD_MINUS_SIZE(3, OM_CACHE_LINE_SIZE, sizeof(ObjectMonitor*));
-
-  int _free_count;    // # on free_list
-  DEFINE_PAD_MINUS_SIZE(4, OM_CACHE_LINE_SIZE, sizeof(int));
-
-  int _in_use_count;  // # on in_use_list
-  DEFINE_PAD_MINUS_SIZE(5, OM_CACHE_LINE_SIZE, sizeof(int));
-
-  int _population;    // # Extant -- in circulation
-  DEFINE_PAD_MINUS_SIZE(6, OM_CACHE_LINE_SIZE, sizeof(int));
-
-  int _wait_count;    // # on wait_list
-  DEFINE_PAD_MINUS_SIZE(7, OM_CACHE_LINE_SIZE, sizeof(int));
-};
-static ObjectMonitorListGlobals om_list_globals;
-
-#define CHAINMARKER (cast_to_oop<intptr_t>(-1))
-
-
-// =====================> Spin-lock functions
-
-// ObjectMonitors are not lockable outside of this file. We use spin-locks
-// implemented using a bit in the _next_om field instead of the heavier
-// weight locking mechanisms for faster list management.
 
-#define OM_LOCK_BIT 0x1
+// =====================> In-use list management functions
 
-// Return true if the ObjectMonitor is locked.
-// Otherwise returns false.
-static bool is_locked(ObjectMonitor* om) {
-  return ((intptr_t)om->next_om_acquire() & OM_LOCK_BIT) == OM_LOCK_BIT;
-}
-
-// Mark an ObjectMonitor* with OM_LOCK_BIT and return it.
-static ObjectMonitor* mark_om_ptr(ObjectMonitor* om) {
-  return (ObjectMonitor*)((intptr_t)om | OM_LOCK_BIT);
-}
-
-// Return the unmarked next field in an ObjectMonitor. Note: the next
-// field may or may not have been marked with OM_LOCK_BIT originally.
-static ObjectMonitor* unmarked_next(ObjectMonitor* om) {
-  return (ObjectMonitor*)((intptr_t)om->next_om() & ~OM_LOCK_BIT);
-}
+// Prepend an ObjectMonitor to the in-use list. The list is only pushed
+// to by inflating threads, so a plain CAS on the list head is enough.
+void MonitorList::add(ObjectMonitor* m) {
+  ObjectMonitor* head;
+  do {
+    head = Atomic::load(&_head);
+    m->set_next_om(head);
+  } while (Atomic::cmpxchg(&_head, head, m) != head);
 
-// Try to lock an ObjectMonitor. Returns true if locking was successful.
-// Otherwise returns false.
-static bool try_om_lock(ObjectMonitor* om) {
-  // Get current next field without any OM_LOCK_BIT value.
-  ObjectMonitor* next = unmarked_next(om);
-  if (om->try_set_next_om(next, mark_om_ptr(next)) != next) {
-    return false;  // Cannot lock the ObjectMonitor.
+  size_t count = Atomic::add(&_count, 1u);
+  if (count > max()) {
+    Atomic::inc(&_max);
   }
-  return true;
 }
 
-// Lock an ObjectMonitor.
-static void om_lock(ObjectMonitor* om) {
-  while (true) {
-    if (try_om_lock(om)) {
-      return;
-    }
-  }
+size_t MonitorList::count() const {
+  return Atomic::load(&_count);
 }
 
-// Unlock an ObjectMonitor.
-static void om_unlock(ObjectMonitor* om) {
-  ObjectMonitor* next = om->next_om();
-  guarantee(((intptr_t)next & OM_LOCK_BIT) == OM_LOCK_BIT, "next=" INTPTR_FORMAT
-            " must have OM_LOCK_BIT=%x set.", p2i(next), OM_LOCK_BIT);
-
-  next = (ObjectMonitor*)((intptr_t)next & ~OM_LOCK_BIT);  // Clear OM_LOCK_BIT.
-  om->release_set_next_om(next);
+size_t MonitorList::max() const {
+  return Atomic::load(&_max);
 }
 
-// Get the list head after locking it. Returns the list head or NULL
-// if the list is empty.
-static ObjectMonitor* get_list_head_locked(ObjectMonitor** list_p) {
-  while (true) {
-    // Acquire semantics not needed on this list load since we're
-    // checking for NULL here or following up with a cmpxchg() via
-    // try_om_lock() below and we retry on cmpxchg() failure.
-    ObjectMonitor* mid = Atomic::load(list_p);
-    if (mid == NULL) {
-      return NULL;  // The list is empty.
-    }
-    if (try_om_lock(mid)) {
-      // Acquire semantics not needed on this list load since memory is
-      // already consistent due to the cmpxchg() via try_om_lock() above.
-      if (Atomic::load(list_p) != mid) {
-        // The list head changed before we could lock it so we have to retry.
-        om_unlock(mid);
-        continue;
+// Walk the in-use list and unlink (at most MonitorDeflationMax) deflated
+// ObjectMonitors. Returns the number of unlinked ObjectMonitors.
+// Only the head of the list can race with add(); all the other links are
+// owned by the deflating thread.
+size_t MonitorList::unlink_deflated(JavaThread* self, LogStream* ls,
+                                    elapsedTimer* timer_p,
+                                    GrowableArray<ObjectMonitor*>* unlinked_list) {
+  size_t unlinked_count = 0;
+  ObjectMonitor* prev = NULL;
+  ObjectMonitor* head = Atomic::load_acquire(&_head);
+  ObjectMonitor* m = head;
+  while (m != NULL) {
+    if (m->is_being_async_deflated()) {
+      // Find next live ObjectMonitor.
+      ObjectMonitor* next = m;
+      do {
+        ObjectMonitor* next_next = next->next_om();
+        unlinked_count++;
+        unlinked_list->append(next);
+        next = next_next;
+        if (unlinked_count >= (size_t)MonitorDeflationMax) {
+          // Reached the max so bail out on the gathering loop.
+          break;
+        }
+      } while (next != NULL && next->is_being_async_deflated());
+      if (prev == NULL) {
+        ObjectMonitor* prev_head = Atomic::cmpxchg(&_head, head, next);
+        if (prev_head != head) {
+          // Find new prev ObjectMonitor that just got inserted.
+          for (ObjectMonitor* n = prev_head; n != m; n = n->next_om()) {
+            prev = n;
+          }
+          prev->set_next_om(next);
+        }
+      } else {
+        prev->set_next_om(next);
       }
-      return mid;
-    }
-  }
-}
-
-#undef OM_LOCK_BIT
-
-
-// =====================> List Management functions
-
-// Prepend a list of ObjectMonitors to the specified *list_p. 'tail' is
-// the last ObjectMonitor in the list and there are 'count' on the list.
-// Also updates the specified *count_p.
-static void prepend_list_to_common(ObjectMonitor* list, ObjectMonitor* tail,
-                                   int count, ObjectMonitor** list_p,
-                                   int* count_p) {
-  while (true) {
-    // Acquire semantics not needed on this list load since we're
-    // following up with a cmpxchg() via try_om_lock() below and we
-    // retry on cmpxchg() failure.
-    ObjectMonitor* cur = Atomic::load(list_p);
-    // Prepend list to *list_p.
-    if (!try_om_lock(tail)) {
-      // Failed to lock tail due to a list walker so try it all again.
-      continue;
-    }
-    // Release semantics not needed on this "unlock" since memory is
-    // already consistent due to the cmpxchg() via try_om_lock() above.
-    tail->set_next_om(cur);  // tail now points to cur (and unlocks tail)
-    if (cur == NULL) {
-      // No potential race with takers or other prependers since
-      // *list_p is empty.
-      if (Atomic::cmpxchg(list_p, cur, list) == cur) {
-        // Successfully switched *list_p to the list value.
-        Atomic::add(count_p, count);
+      if (unlinked_count >= (size_t)MonitorDeflationMax) {
+        // Reached the max so bail out on the searching loop.
         break;
       }
-      // Implied else: try it all again
+      m = next;
     } else {
-      if (!try_om_lock(cur)) {
-        continue;  // failed to lock cur so try it all again
-      }
-      // We locked cur so try to switch *list_p to the list value.
-      if (Atomic::cmpxchg(list_p, cur, list) != cur) {
-        // The list head has changed so unlock cur and try again:
-        om_unlock(cur);
-        continue;
-      }
-      Atomic::add(count_p, count);
-      om_unlock(cur);
-      break;
+      prev = m;
+      m = m->next_om();
     }
-  }
-}
 
-// Prepend a newly allocated block of ObjectMonitors to g_block_list and
-// om_list_globals._free_list. Also updates om_list_globals._population
-// and om_list_globals._free_count.
-void ObjectSynchronizer::prepend_block_to_lists(PaddedObjectMonitor* new_blk) {
-  // First we handle g_block_list:
-  while (true) {
-    PaddedObjectMonitor* cur = Atomic::load(&g_block_list);
-    // Prepend new_blk to g_block_list. The first ObjectMonitor in
-    // a block is reserved for use as linkage to the next block.
-    new_blk[0].set_next_om(cur);
-    if (Atomic::cmpxchg(&g_block_list, cur, new_blk) == cur) {
-      // Successfully switched g_block_list to the new_blk value.
-      Atomic::add(&om_list_globals._population, _BLOCKSIZE - 1);
-      break;
-    }
-    // Implied else: try it all again
+    // A JavaThread must check for a safepoint/handshake and honor it.
+    ObjectSynchronizer::chk_for_block_req(self, "unlinking", "unlinked_count",
+                                          unlinked_count, ls, timer_p);
   }
-
-  // Second we handle om_list_globals._free_list:
-  prepend_list_to_common(new_blk + 1, &new_blk[_BLOCKSIZE - 1], _BLOCKSIZE - 1,
-                         &om_list_globals._free_list, &om_list_globals._free_count);
-}
-
-// Prepend a list of ObjectMonitors to om_list_globals._free_list.
-// 'tail' is the last ObjectMonitor in the list and there are 'count'
-// on the list. Also updates om_list_globals._free_count.
-static void prepend_list_to_global_free_list(ObjectMonitor* list,
-                                             ObjectMonitor* tail, int count) {
-  prepend_list_to_common(list, tail, count, &om_list_globals._free_list,
-                         &om_list_globals._free_count);
-}
-
-// Prepend a list of ObjectMonitors to om_list_globals._wait_list.
-// 'tail' is the last ObjectMonitor in the list and there are 'count'
-// on the list. Also updates om_list_globals._wait_count.
-static void prepend_list_to_global_wait_list(ObjectMonitor* list,
-                                             ObjectMonitor* tail, int count) {
-  prepend_list_to_common(list, tail, count, &om_list_globals._wait_list,
-                         &om_list_globals._wait_count);
-}
-
-// Prepend a list of ObjectMonitors to om_list_globals._in_use_list.
-// 'tail' is the last ObjectMonitor in the list and there are 'count'
-// on the list. Also updates om_list_globals._in_use_list.
-static void prepend_list_to_global_in_use_list(ObjectMonitor* list,
-                                               ObjectMonitor* tail, int count) {
-  prepend_list_to_common(list, tail, count, &om_list_globals._in_use_list,
-                         &om_list_globals._in_use_count);
-}
-
-// Prepend an ObjectMonitor to the specified list. Also updates
-// the specified counter.
-static void prepend_to_common(ObjectMonitor* m, ObjectMonitor** list_p,
-                              int* count_p) {
-  while (true) {
-    om_lock(m);  // Lock m so we can safely update its next field.
-    ObjectMonitor* cur = NULL;
-    // Lock the list head to guard against races with a list walker
-    // or async deflater thread (which only races in om_in_use_list):
-    if ((cur = get_list_head_locked(list_p)) != NULL) {
-      // List head is now locked so we can safely switch it. Release
-      // semantics not needed on this "unlock" since memory is already
-      // consistent due to the cmpxchg() via get_list_head_locked() above.
-      m->set_next_om(cur);  // m now points to cur (and unlocks m)
-      OrderAccess::storestore();  // Make sure set_next_om() is seen first.
-      Atomic::store(list_p, m);  // Switch list head to unlocked m.
-      om_unlock(cur);
-      break;
-    }
-    // The list is empty so try to set the list head.
-    assert(cur == NULL, "cur must be NULL: cur=" INTPTR_FORMAT, p2i(cur));
-    // Release semantics not needed on this "unlock" since memory
-    // is already consistent.
-    m->set_next_om(cur);  // m now points to NULL (and unlocks m)
-    if (Atomic::cmpxchg(list_p, cur, m) == cur) {
-      // List head is now unlocked m.
-      break;
-    }
-    // Implied else: try it all again
-  }
-  Atomic::inc(count_p);
-}
-
-// Prepend an ObjectMonitor to a per-thread om_free_list.
-// Also updates the per-thread om_free_count.
-static void prepend_to_om_free_list(Thread* self, ObjectMonitor* m) {
-  prepend_to_common(m, &self->om_free_list, &self->om_free_count);
+  Atomic::sub(&_count, unlinked_count);
+  return unlinked_count;
 }
 
-// Prepend an ObjectMonitor to a per-thread om_in_use_list.
-// Also updates the per-thread om_in_use_count.
-static void prepend_to_om_in_use_list(Thread* self, ObjectMonitor* m) {
-  prepend_to_common(m, &self->om_in_use_list, &self->om_in_use_count);
+MonitorList::Iterator MonitorList::iterator() const {
+  return Iterator(Atomic::load_acquire(&_head));
 }
 
-// Take an ObjectMonitor from the start of the specified list. Also
-// decrements the specified counter. Returns NULL if none are available.
-static ObjectMonitor* take_from_start_of_common(ObjectMonitor** list_p,
-                                                int* count_p) {
-  ObjectMonitor* take = NULL;
-  // Lock the list head to guard against races with a list walker
-  // or async deflater thread (which only races in om_list_globals._free_list):
-  if ((take = get_list_head_locked(list_p)) == NULL) {
-    return NULL;  // None are available.
-  }
-  ObjectMonitor* next = unmarked_next(take);
-  // Switch locked list head to next (which unlocks the list head, but
-  // leaves take locked). Release semantics not needed on this "unlock"
-  // since memory is already consistent due to the cmpxchg() via
-  // get_list_head_locked() above.
-  Atomic::store(list_p, next);
-  Atomic::dec(count_p);
-  // Unlock take, but leave the next value for any lagging list
-  // walkers. It will get cleaned up when take is prepended to
-  // the in-use list:
-  om_unlock(take);
-  return take;
-}
-
-// Take an ObjectMonitor from the start of the om_list_globals._free_list.
-// Also updates om_list_globals._free_count. Returns NULL if none are
-// available.
-static ObjectMonitor* take_from_start_of_global_free_list() {
-  return take_from_start_of_common(&om_list_globals._free_list,
-                                   &om_list_globals._free_count);
-}
-
-// Take an ObjectMonitor from the start of a per-thread free-list.
-// Also updates om_free_count. Returns NULL if none are available.
-static ObjectMonitor* take_from_start_of_om_free_list(Thread* self) {
-  return take_from_start_of_common(&self->om_free_list, &self->om_free_count);
+ObjectMonitor* MonitorList::Iterator::next() {
+  ObjectMonitor* current = _current;
+  _current = current->next_om();
+  return current;
 }
 
 
@@ -460,6 +252,12 @@ bool ObjectSynchronizer::quick_notify(oopDesc* obj, Thread* self, bool all) {
     return true;
   }
 
+  if (mark.is_fast_locked() && self->as_Java_thread()->lock_stack().contains(oop(obj))) {
+    // Degenerate notify
+    // fast-locked by caller so by definition the implied waitset is empty.
+    return true;
+  }
+
   if (mark.has_monitor()) {
     ObjectMonitor* const mon = mark.monitor();
     assert(mon->object() == oop(obj), "invariant");
@@ -620,23 +418,44 @@ void ObjectSynchronizer::enter(Handle obj, BasicLock* lock, TRAPS) {
     }
   }
 
-  markWord mark = obj->mark();
-  assert(!mark.has_bias_pattern(), "should not see bias pattern here");
-
-  if (mark.is_neutral()) {
-    // Anticipate successful CAS -- the ST of the displaced mark must
-    // be visible <= the ST performed by the CAS.
-    lock->set_displaced_header(mark);
-    if (mark == obj()->cas_set_mark(markWord::from_pointer(lock), mark)) {
+  if (UseLightweightLocking) {
+    if (THREAD->is_Java_thread()) {
+      LockStack& lock_stack = THREAD->as_Java_thread()->lock_stack();
+      if (lock_stack.can_push()) {
+        markWord mark = obj()->mark();
+        while (mark.is_neutral()) {
+          // Clear the lock bits and leave the rest of the header, including
+          // any hash code, in place. Retry if only the header changed.
+          markWord old_mark = obj()->cas_set_mark(mark.set_fast_locked(), mark);
+          if (old_mark == mark) {
+            lock_stack.push(obj());
+            return;
+          }
+          mark = old_mark;
+        }
+      }
+    }
+    // Recursive or contended locking, or a full lock stack: fall
+    // through to inflate() ...
+  } else {
+    markWord mark = obj->mark();
+    assert(!mark.has_bias_pattern(), "should not see bias pattern here");
+
+    if (mark.is_neutral()) {
+      // Anticipate successful CAS -- the ST of the displaced mark must
+      // be visible <= the ST performed by the CAS.
+      lock->set_displaced_header(mark);
+      if (mark == obj()->cas_set_mark(markWord::from_pointer(lock), mark)) {
+        return;
+      }
+      // Fall through to inflate() ...
+    } else if (mark.has_locker() &&
+               THREAD->is_lock_owned((address)mark.locker())) {
+      assert(lock != mark.locker(), "must not re-lock the same lock");
+      assert(lock != (BasicLock*)obj->mark().value(), "don't relock with same BasicLock");
+      lock->set_displaced_header(markWord::from_pointer(NULL));
       return;
     }
-    // Fall through to inflate() ...
-  } else if (mark.has_locker() &&
-             THREAD->is_lock_owned((address)mark.locker())) {
-    assert(lock != mark.locker(), "must not re-lock the same lock");
-    assert(lock != (BasicLock*)obj->mark().value(), "don't relock with same BasicLock");
-    lock->set_displaced_header(markWord::from_pointer(NULL));
-    return;
   }
 
   // The object header will never be displaced to this lock,
@@ -656,6 +475,31 @@ void ObjectSynchronizer::enter(Handle obj, BasicLock* lock, TRAPS) {
 }
 
 void ObjectSynchronizer::exit(oop object, BasicLock* lock, TRAPS) {
+  if (UseLightweightLocking) {
+    if (THREAD->is_Java_thread()) {
+      LockStack& lock_stack = THREAD->as_Java_thread()->lock_stack();
+      markWord mark = object->mark();
+      if (mark.is_fast_locked() && lock_stack.contains(object)) {
+        // Set the lock bits back to unlocked. Only the owner changes the
+        // lock bits of a fast-locked header, but other threads may inflate
+        // it or update its age, so retry while it is still fast-locked.
+        do {
+          markWord old_mark = object->cas_set_mark(mark.set_unlocked(), mark);
+          if (old_mark == mark) {
+            lock_stack.remove(object);
+            return;
+          }
+          mark = old_mark;
+        } while (mark.is_fast_locked());
+      }
+    }
+    // The lock is inflated: inflate() claims it from the lock stack if
+    // it is still owned anonymously.
+    ObjectMonitor* monitor = inflate(THREAD, object, inflate_cause_vm_internal);
+    monitor->exit(true, THREAD);
+    return;
+  }
+
   markWord mark = object->mark();
   // We cannot check for Biased Locking if we are racing an inflation.
   assert(mark == markWord::INFLATING() ||
@@ -870,6 +714,11 @@ void ObjectSynchronizer::notify(Handle obj, TRAPS) {
   if (mark.has_locker() && THREAD->is_lock_owned((address)mark.locker())) {
     return;
   }
+  if (mark.is_fast_locked() && THREAD->is_Java_thread() &&
+      THREAD->as_Java_thread()->lock_stack().contains(obj())) {
+    // Not inflated, so there are no waiters to notify.
+    return;
+  }
   // The ObjectMonitor* can't be async deflated until ownership is
   // dropped by the calling thread.
   ObjectMonitor* monitor = inflate(THREAD, obj(), inflate_cause_notify);
@@ -887,6 +736,11 @@ void ObjectSynchronizer::notifyall(Handle obj, TRAPS) {
   if (mark.has_locker() && THREAD->is_lock_owned((address)mark.locker())) {
     return;
   }
+  if (mark.is_fast_locked() && THREAD->is_Java_thread() &&
+      THREAD->as_Java_thread()->lock_stack().contains(obj())) {
+    // Not inflated, so there are no waiters to notify.
+    return;
+  }
   // The ObjectMonitor* can't be async deflated until ownership is
   // dropped by the calling thread.
   ObjectMonitor* monitor = inflate(THREAD, obj(), inflate_cause_notify);
@@ -1081,7 +935,8 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread* self, oop obj) {
     // object should remain ineligible for biased locking
     assert(!mark.has_bias_pattern(), "invariant");
 
-    if (mark.is_neutral()) {            // if this is a normal header
+    if (mark.is_neutral() ||            // if this is a normal header
+        mark.is_fast_locked()) {        // or one that is locked in place
       hash = mark.hash();
       if (hash != 0) {                  // if it has a hash, just return it
         return hash;
@@ -1093,6 +948,10 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread* self, oop obj) {
       if (test == mark) {               // if the hash was installed, return it
         return hash;
       }
+      if (UseLightweightLocking) {
+        // The header is never displaced, so just retry with the new one.
+        continue;
+      }
       // Failed to install the hash. It could be that another thread
       // installed the hash just before our attempt or inflation has
       // occurred or... so we fall thru to inflate the monitor for
@@ -1207,6 +1066,10 @@ bool ObjectSynchronizer::current_thread_holds_lock(JavaThread* thread,
   if (mark.has_locker()) {
     return thread->is_lock_owned((address)mark.locker());
   }
+  // Uncontended case, header locked in place
+  if (mark.is_fast_locked()) {
+    return thread->lock_stack().contains(obj);
+  }
   // Contended case, header points to ObjectMonitor (tagged pointer)
   if (mark.has_monitor()) {
     // The first stage of async deflation does not affect any field
@@ -1250,6 +1113,11 @@ ObjectSynchronizer::LockOwnership ObjectSynchronizer::query_lock_ownership
       owner_self : owner_other;
   }
 
+  // CASE: fast-locked. The owner has the object on its lock stack.
+  if (mark.is_fast_locked()) {
+    return self->lock_stack().contains(obj) ? owner_self : owner_other;
+  }
+
   // CASE: inflated. Mark (tagged pointer) points to an ObjectMonitor.
   if (mark.has_monitor()) {
     // The first stage of async deflation does not affect any field
@@ -1257,6 +1125,9 @@ ObjectSynchronizer::LockOwnership ObjectSynchronizer::query_lock_ownership
     ObjectMonitor* monitor = mark.monitor();
     void* owner = monitor->owner();
     if (owner == NULL) return owner_none;
+    if (owner == ANONYMOUS_OWNER) {
+      return self->lock_stack().contains(obj) ? owner_self : owner_other;
+    }
     return (owner == self ||
             self->is_lock_owned((address)owner)) ? owner_self : owner_other;
   }
@@ -1287,12 +1158,20 @@ JavaThread* ObjectSynchronizer::get_lock_owner(ThreadsList * t_list, Handle h_ob
     owner = (address) mark.locker();
   }
 
+  // Uncontended case, header locked in place
+  else if (mark.is_fast_locked()) {
+    return Threads::owning_thread_from_object(t_list, obj);
+  }
+
   // Contended case, header points to ObjectMonitor (tagged pointer)
   else if (mark.has_monitor()) {
     // The first stage of async deflation does not affect any field
     // used by this comparison so the ObjectMonitor* is usable here.
     ObjectMonitor* monitor = mark.monitor();
     assert(monitor != NULL, "monitor should be non-null");
+    if (monitor->is_owner_anonymous()) {
+      return Threads::owning_thread_from_object(t_list, obj);
+    }
     owner = (address) monitor->owner();
   }
 
@@ -1312,41 +1191,50 @@ JavaThread* ObjectSynchronizer::get_lock_owner(ThreadsList * t_list, Handle h_ob
 // Visitors ...
 
 void ObjectSynchronizer::monitors_iterate(MonitorClosure* closure) {
-  PaddedObjectMonitor* block = Atomic::load(&g_block_list);
-  while (block != NULL) {
-    assert(block->object() == CHAINMARKER, "must be a block header");
-    for (int i = _BLOCKSIZE - 1; i > 0; i--) {
-      ObjectMonitor* mid = (ObjectMonitor *)(block + i);
-      if (mid->object() != NULL) {
-        // Only process with closure if the object is set.
-
-        // monitors_iterate() is only called at a safepoint or when the
-        // target thread is suspended or when the target thread is
-        // operating on itself. The current closures in use today are
-        // only interested in an owned ObjectMonitor and ownership
-        // cannot be dropped under the calling contexts so the
-        // ObjectMonitor cannot be async deflated.
-        closure->do_monitor(mid);
-      }
+  // monitors_iterate() is only called at a safepoint or when the
+  // target thread is suspended or when the target thread is
+  // operating on itself. The current closures in use today are
+  // only interested in an owned ObjectMonitor and ownership
+  // cannot be dropped under the calling contexts so the
+  // ObjectMonitor cannot be async deflated.
+  MonitorList::Iterator iter = _in_use_list.iterator();
+  while (iter.has_next()) {
+    ObjectMonitor* mid = iter.next();
+    if (!mid->is_being_async_deflated() && mid->object() != NULL) {
+      // Only process with closure if the object is set.
+      closure->do_monitor(mid);
     }
-    // unmarked_next() is not needed with g_block_list (no locking
-    // used with block linkage _next_om fields).
-    block = (PaddedObjectMonitor*)block->next_om();
   }
 }
 
-static bool monitors_used_above_threshold() {
-  int population = Atomic::load(&om_list_globals._population);
-  if (population == 0) {
+size_t ObjectSynchronizer::in_use_list_ceiling() {
+  return Atomic::load(&_in_use_list_ceiling);
+}
+
+void ObjectSynchronizer::dec_in_use_list_ceiling() {
+  Atomic::sub(&_in_use_list_ceiling, (size_t)AvgMonitorsPerThreadEstimate);
+}
+
+void ObjectSynchronizer::inc_in_use_list_ceiling() {
+  Atomic::add(&_in_use_list_ceiling, (size_t)AvgMonitorsPerThreadEstimate);
+}
+
+static bool monitors_used_above_threshold(MonitorList* list) {
+  if (MonitorUsedDeflationThreshold == 0) {  // disabled case is easy
     return false;
   }
-  if (MonitorUsedDeflationThreshold > 0) {
-    int monitors_used = population - Atomic::load(&om_list_globals._free_count) -
-                        Atomic::load(&om_list_globals._wait_count);
-    int monitor_usage = (monitors_used * 100LL) / population;
-    return monitor_usage > MonitorUsedDeflationThreshold;
+  size_t monitors_used = list->count();
+  if (monitors_used == 0) {  // empty list is easy
+    return false;
   }
-  return false;
+  // Start with ceiling based on a per-thread estimate:
+  size_t ceiling = ObjectSynchronizer::in_use_list_ceiling();
+  if (ceiling < list->max()) {
+    // The max used by the system has exceeded the ceiling so use that:
+    ceiling = list->max();
+  }
+  size_t monitor_usage = (monitors_used * 100LL) / ceiling;
+  return int(monitor_usage) > MonitorUsedDeflationThreshold;
 }
 
 bool ObjectSynchronizer::is_async_deflation_needed() {
@@ -1356,7 +1244,7 @@ bool ObjectSynchronizer::is_async_deflation_needed() {
   }
   if (AsyncDeflationInterval > 0 &&
       time_since_last_async_deflation_ms() > AsyncDeflationInterval &&
-      monitors_used_above_threshold()) {
+      monitors_used_above_threshold(&_in_use_list)) {
     // It's been longer than our specified deflate interval and there
     // are too many monitors in use. We don't deflate more frequently
     // than AsyncDeflationInterval (unless is_async_deflation_requested)
@@ -1403,27 +1291,14 @@ jlong ObjectSynchronizer::time_since_last_async_deflation_ms() {
 }
 
 void ObjectSynchronizer::oops_do(OopClosure* f) {
-  // We only scan the global used list here (for moribund threads), and
-  // the thread-local monitors in Thread::oops_do().
-  global_used_oops_do(f);
-}
-
-void ObjectSynchronizer::global_used_oops_do(OopClosure* f) {
-  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
-  // Acquire semantics not needed since we're at a safepoint.
-  list_oops_do(Atomic::load(&om_list_globals._in_use_list), f);
-}
-
-void ObjectSynchronizer::thread_local_used_oops_do(Thread* thread, OopClosure* f) {
-  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
-  list_oops_do(thread->om_in_use_list, f);
-}
-
-void ObjectSynchronizer::list_oops_do(ObjectMonitor* list, OopClosure* f) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   // The oops_do() phase does not overlap with monitor deflation
-  // so no need to lock ObjectMonitors for the list traversal.
-  for (ObjectMonitor* mid = list; mid != NULL; mid = unmarked_next(mid)) {
+  // so the in-use list can be walked without synchronization. The
+  // ObjectMonitors that have been deflated but are not unlinked yet
+  // have a NULL object.
+  MonitorList::Iterator iter = _in_use_list.iterator();
+  while (iter.has_next()) {
+    ObjectMonitor* mid = iter.next();
     if (mid->object() != NULL) {
       f->do_oop(mid->object_addr());
     }
@@ -1434,398 +1309,17 @@ void ObjectSynchronizer::list_oops_do(ObjectMonitor* list, OopClosure* f) {
 // -----------------------------------------------------------------------------
 // ObjectMonitor Lifecycle
 // -----------------------
-// Inflation unlinks monitors from om_list_globals._free_list or a per-thread
-// free list and associates them with objects. Async deflation disassociates
-// idle monitors from objects. Such scavenged monitors are returned to the
-// om_list_globals._free_list.
-//
-// ObjectMonitors reside in type-stable memory (TSM) and are immortal.
+// Inflation allocates an ObjectMonitor on the C heap, associates it
+// with the object and adds it to the in-use list. Async deflation
+// disassociates idle monitors from objects and unlinks them from the
+// in-use list. After a handshake, no thread can still refer to an
+// unlinked monitor, so it is deleted.
 //
 // Lifecycle:
-// --   unassigned and on the om_list_globals._free_list
-// --   unassigned and on a per-thread free list
-// --   assigned to an object.  The object is inflated and the mark refers
-//      to the ObjectMonitor.
-
-ObjectMonitor* ObjectSynchronizer::om_alloc(Thread* self) {
-  // A large MAXPRIVATE value reduces both list lock contention
-  // and list coherency traffic, but also tends to increase the
-  // number of ObjectMonitors in circulation as well as the
-  // scavenge costs.  As usual, we lean toward time in space-time
-  // tradeoffs.
-  const int MAXPRIVATE = 1024;
-  NoSafepointVerifier nsv;
-
-  for (;;) {
-    ObjectMonitor* m;
-
-    // 1: try to allocate from the thread's local om_free_list.
-    // Threads will attempt to allocate first from their local list, then
-    // from the global list, and only after those attempts fail will the
-    // thread attempt to instantiate new monitors. Thread-local free lists
-    // improve allocation latency, as well as reducing coherency traffic
-    // on the shared global list.
-    m = take_from_start_of_om_free_list(self);
-    if (m != NULL) {
-      guarantee(m->object() == NULL, "invariant");
-      m->set_allocation_state(ObjectMonitor::New);
-      prepend_to_om_in_use_list(self, m);
-      return m;
-    }
-
-    // 2: try to allocate from the global om_list_globals._free_list
-    // If we're using thread-local free lists then try
-    // to reprovision the caller's free list.
-    // Acquire semantics not needed on this list load since memory
-    // is already consistent due to the cmpxchg() via
-    // take_from_start_of_om_free_list() above.
-    if (Atomic::load(&om_list_globals._free_list) != NULL) {
-      // Reprovision the thread's om_free_list.
-      // Use bulk transfers to reduce the allocation rate and heat
-      // on various locks.
-      for (int i = self->om_free_provision; --i >= 0;) {
-        ObjectMonitor* take = take_from_start_of_global_free_list();
-        if (take == NULL) {
-          break;  // No more are available.
-        }
-        guarantee(take->object() == NULL, "invariant");
-        // We allowed 3 field values to linger during async deflation.
-        // Clear or restore them as appropriate.
-        take->set_header(markWord::zero());
-        // DEFLATER_MARKER is the only non-NULL value we should see here.
-        take->try_set_owner_from(DEFLATER_MARKER, NULL);
-        if (take->contentions() < 0) {
-          // Add back max_jint to restore the contentions field to its
-          // proper value.
-          take->add_to_contentions(max_jint);
-
-#ifdef ASSERT
-          jint l_contentions = take->contentions();
-          assert(l_contentions >= 0, "must not be negative: l_contentions=%d, contentions=%d",
-                 l_contentions, take->contentions());
-#endif
-        }
-        take->Recycle();
-        // Since we're taking from the global free-list, take must be Free.
-        // om_release() also sets the allocation state to Free because it
-        // is called from other code paths.
-        assert(take->is_free(), "invariant");
-        om_release(self, take, false);
-      }
-      self->om_free_provision += 1 + (self->om_free_provision / 2);
-      if (self->om_free_provision > MAXPRIVATE) self->om_free_provision = MAXPRIVATE;
-      continue;
-    }
-
-    // 3: allocate a block of new ObjectMonitors
-    // Both the local and global free lists are empty -- resort to malloc().
-    // In the current implementation ObjectMonitors are TSM - immortal.
-    // Ideally, we'd write "new ObjectMonitor[_BLOCKSIZE], but we want
-    // each ObjectMonitor to start at the beginning of a cache line,
-    // so we use align_up().
-    // A better solution would be to use C++ placement-new.
-    // BEWARE: As it stands currently, we don't run the ctors!
-    assert(_BLOCKSIZE > 1, "invariant");
-    size_t neededsize = sizeof(PaddedObjectMonitor) * _BLOCKSIZE;
-    PaddedObjectMonitor* temp;
-    size_t aligned_size = neededsize + (OM_CACHE_LINE_SIZE - 1);
-    void* real_malloc_addr = NEW_C_HEAP_ARRAY(char, aligned_size, mtInternal);
-    temp = (PaddedObjectMonitor*)align_up(real_malloc_addr, OM_CACHE_LINE_SIZE);
-    (void)memset((void *) temp, 0, neededsize);
-
-    // Format the block.
-    // initialize the linked list, each monitor points to its next
-    // forming the single linked free list, the very first monitor
-    // will points to next block, which forms the block list.
-    // The trick of using the 1st element in the block as g_block_list
-    // linkage should be reconsidered.  A better implementation would
-    // look like: class Block { Block * next; int N; ObjectMonitor Body [N] ; }
-
-    for (int i = 1; i < _BLOCKSIZE; i++) {
-      temp[i].set_next_om((ObjectMonitor*)&temp[i + 1]);
-      assert(temp[i].is_free(), "invariant");
-    }
-
-    // terminate the last monitor as the end of list
-    temp[_BLOCKSIZE - 1].set_next_om((ObjectMonitor*)NULL);
-
-    // Element [0] is reserved for global list linkage
-    temp[0].set_object(CHAINMARKER);
-
-    // Consider carving out this thread's current request from the
-    // block in hand.  This avoids some lock traffic and redundant
-    // list activity.
-
-    prepend_block_to_lists(temp);
-  }
-}
-
-// Place "m" on the caller's private per-thread om_free_list.
-// In practice there's no need to clamp or limit the number of
-// monitors on a thread's om_free_list as the only non-allocation time
-// we'll call om_release() is to return a monitor to the free list after
-// a CAS attempt failed. This doesn't allow unbounded #s of monitors to
-// accumulate on a thread's free list.
-//
-// Key constraint: all ObjectMonitors on a thread's free list and the global
-// free list must have their object field set to null. This prevents the
-// scavenger -- deflate_monitor_list_using_JT() -- from reclaiming them
-// while we are trying to release them.
-
-void ObjectSynchronizer::om_release(Thread* self, ObjectMonitor* m,
-                                    bool from_per_thread_alloc) {
-  guarantee(m->header().value() == 0, "invariant");
-  guarantee(m->object() == NULL, "invariant");
-  NoSafepointVerifier nsv;
-
-  if ((m->is_busy() | m->_recursions) != 0) {
-    stringStream ss;
-    fatal("freeing in-use monitor: %s, recursions=" INTX_FORMAT,
-          m->is_busy_to_string(&ss), m->_recursions);
-  }
-  m->set_allocation_state(ObjectMonitor::Free);
-  // _next_om is used for both per-thread in-use and free lists so
-  // we have to remove 'm' from the in-use list first (as needed).
-  if (from_per_thread_alloc) {
-    // Need to remove 'm' from om_in_use_list.
-    ObjectMonitor* mid = NULL;
-    ObjectMonitor* next = NULL;
-
-    // This list walk can race with another list walker or with async
-    // deflation so we have to worry about an ObjectMonitor being
-    // removed from this list while we are walking it.
-
-    // Lock the list head to avoid racing with another list walker
-    // or with async deflation.
-    if ((mid = get_list_head_locked(&self->om_in_use_list)) == NULL) {
-      fatal("thread=" INTPTR_FORMAT " in-use list must not be empty.", p2i(self));
-    }
-    next = unmarked_next(mid);
-    if (m == mid) {
-      // First special case:
-      // 'm' matches mid, is the list head and is locked. Switch the list
-      // head to next which unlocks the list head, but leaves the extracted
-      // mid locked. Release semantics not needed on this "unlock" since
-      // memory is already consistent due to the get_list_head_locked()
-      // above.
-      Atomic::store(&self->om_in_use_list, next);
-    } else if (m == next) {
-      // Second special case:
-      // 'm' matches next after the list head and we already have the list
-      // head locked so set mid to what we are extracting:
-      mid = next;
-      // Lock mid to prevent races with a list walker or an async
-      // deflater thread that's ahead of us. The locked list head
-      // prevents races from behind us.
-      om_lock(mid);
-      // Update next to what follows mid (if anything):
-      next = unmarked_next(mid);
-      // Switch next after the list head to new next which unlocks the
-      // list head, but leaves the extracted mid locked. Release semantics
-      // not needed on this "unlock" since memory is already consistent
-      // due to the get_list_head_locked() above.
-      self->om_in_use_list->set_next_om(next);
-    } else {
-      // We have to search the list to find 'm'.
-      guarantee(next != NULL, "thread=" INTPTR_FORMAT ": om_in_use_list=" INTPTR_FORMAT
-                " is too short.", p2i(self), p2i(self->om_in_use_list));
-      // Our starting anchor is next after the list head which is the
-      // last ObjectMonitor we checked:
-      ObjectMonitor* anchor = next;
-      // Lock anchor to prevent races with a list walker or an async
-      // deflater thread that's ahead of us. The locked list head
-      // prevents races from behind us.
-      om_lock(anchor);
-      om_unlock(mid);  // Unlock the list head now that anchor is locked.
-      while ((mid = unmarked_next(anchor)) != NULL) {
-        if (m == mid) {
-          // We found 'm' on the per-thread in-use list so extract it.
-          // Update next to what follows mid (if anything):
-          next = unmarked_next(mid);
-          // Switch next after the anchor to new next which unlocks the
-          // anchor, but leaves the extracted mid locked. Release semantics
-          // not needed on this "unlock" since memory is already consistent
-          // due to the om_unlock() above before entering the loop or the
-          // om_unlock() below before looping again.
-          anchor->set_next_om(next);
-          break;
-        } else {
-          // Lock the next anchor to prevent races with a list walker
-          // or an async deflater thread that's ahead of us. The locked
-          // current anchor prevents races from behind us.
-          om_lock(mid);
-          // Unlock current anchor now that next anchor is locked:
-          om_unlock(anchor);
-          anchor = mid;  // Advance to new anchor and try again.
-        }
-      }
-    }
-
-    if (mid == NULL) {
-      // Reached end of the list and didn't find 'm' so:
-      fatal("thread=" INTPTR_FORMAT " must find m=" INTPTR_FORMAT "on om_in_use_list="
-            INTPTR_FORMAT, p2i(self), p2i(m), p2i(self->om_in_use_list));
-    }
-
-    // At this point mid is disconnected from the in-use list so
-    // its lock no longer has any effects on the in-use list.
-    Atomic::dec(&self->om_in_use_count);
-    // Unlock mid, but leave the next value for any lagging list
-    // walkers. It will get cleaned up when mid is prepended to
-    // the thread's free list:
-    om_unlock(mid);
-  }
-
-  prepend_to_om_free_list(self, m);
-  guarantee(m->is_free(), "invariant");
-}
-
-// Return ObjectMonitors on a moribund thread's free and in-use
-// lists to the appropriate global lists. The ObjectMonitors on the
-// per-thread in-use list may still be in use by other threads.
-//
-// We currently call om_flush() from Threads::remove() before the
-// thread has been excised from the thread list and is no longer a
-// mutator. In particular, this ensures that the thread's in-use
-// monitors are scanned by a GC safepoint, either via Thread::oops_do()
-// (before om_flush() is called) or via ObjectSynchronizer::oops_do()
-// (after om_flush() is called).
-//
-// deflate_global_idle_monitors_using_JT() and
-// deflate_per_thread_idle_monitors_using_JT() (in another thread) can
-// run at the same time as om_flush() so we have to follow a careful
-// protocol to prevent list corruption.
-
-void ObjectSynchronizer::om_flush(Thread* self) {
-  // Process the per-thread in-use list first to be consistent.
-  int in_use_count = 0;
-  ObjectMonitor* in_use_list = NULL;
-  ObjectMonitor* in_use_tail = NULL;
-  NoSafepointVerifier nsv;
-
-  // This function can race with a list walker or with an async
-  // deflater thread so we lock the list head to prevent confusion.
-  // An async deflater thread checks to see if the target thread
-  // is exiting, but if it has made it past that check before we
-  // started exiting, then it is racing to get to the in-use list.
-  if ((in_use_list = get_list_head_locked(&self->om_in_use_list)) != NULL) {
-    // At this point, we have locked the in-use list head so a racing
-    // thread cannot come in after us. However, a racing thread could
-    // be ahead of us; we'll detect that and delay to let it finish.
-    //
-    // The thread is going away, however the ObjectMonitors on the
-    // om_in_use_list may still be in-use by other threads. Link
-    // them to in_use_tail, which will be linked into the global
-    // in-use list (om_list_globals._in_use_list) below.
-    //
-    // Account for the in-use list head before the loop since it is
-    // already locked (by this thread):
-    in_use_tail = in_use_list;
-    in_use_count++;
-    for (ObjectMonitor* cur_om = unmarked_next(in_use_list); cur_om != NULL;) {
-      if (is_locked(cur_om)) {
-        // cur_om is locked so there must be a racing walker or async
-        // deflater thread ahead of us so we'll give it a chance to finish.
-        while (is_locked(cur_om)) {
-          os::naked_short_sleep(1);
-        }
-        // Refetch the possibly changed next field and try again.
-        cur_om = unmarked_next(in_use_tail);
-        continue;
-      }
-      if (cur_om->object() == NULL) {
-        // cur_om was deflated and the object ref was cleared while it
-        // was locked. We happened to see it just after it was unlocked
-        // (and added to the free list). Refetch the possibly changed
-        // next field and try again.
-        cur_om = unmarked_next(in_use_tail);
-        continue;
-      }
-      in_use_tail = cur_om;
-      in_use_count++;
-      cur_om = unmarked_next(cur_om);
-    }
-    guarantee(in_use_tail != NULL, "invariant");
-#ifdef ASSERT
-    int l_om_in_use_count = Atomic::load(&self->om_in_use_count);
-    assert(l_om_in_use_count == in_use_count, "in-use counts don't match: "
-           "l_om_in_use_count=%d, in_use_count=%d", l_om_in_use_count, in_use_count);
-#endif
-    Atomic::store(&self->om_in_use_count, 0);
-    OrderAccess::storestore();  // Make sure counter update is seen first.
-    // Clear the in-use list head (which also unlocks it):
-    Atomic::store(&self->om_in_use_list, (ObjectMonitor*)NULL);
-    om_unlock(in_use_list);
-  }
-
-  int free_count = 0;
-  ObjectMonitor* free_list = NULL;
-  ObjectMonitor* free_tail = NULL;
-  // This function can race with a list walker thread so we lock the
-  // list head to prevent confusion.
-  if ((free_list = get_list_head_locked(&self->om_free_list)) != NULL) {
-    // At this point, we have locked the free list head so a racing
-    // thread cannot come in after us. However, a racing thread could
-    // be ahead of us; we'll detect that and delay to let it finish.
-    //
-    // The thread is going away. Set 'free_tail' to the last per-thread free
-    // monitor which will be linked to om_list_globals._free_list below.
-    //
-    // Account for the free list head before the loop since it is
-    // already locked (by this thread):
-    free_tail = free_list;
-    free_count++;
-    for (ObjectMonitor* s = unmarked_next(free_list); s != NULL; s = unmarked_next(s)) {
-      if (is_locked(s)) {
-        // s is locked so there must be a racing walker thread ahead
-        // of us so we'll give it a chance to finish.
-        while (is_locked(s)) {
-          os::naked_short_sleep(1);
-        }
-      }
-      free_tail = s;
-      free_count++;
-      guarantee(s->object() == NULL, "invariant");
-      if (s->is_busy()) {
-        stringStream ss;
-        fatal("must be !is_busy: %s", s->is_busy_to_string(&ss));
-      }
-    }
-    guarantee(free_tail != NULL, "invariant");
-#ifdef ASSERT
-    int l_om_free_count = Atomic::load(&self->om_free_count);
-    assert(l_om_free_count == free_count, "free counts don't match: "
-           "l_om_free_count=%d, free_count=%d", l_om_free_count, free_count);
-#endif
-    Atomic::store(&self->om_free_count, 0);
-    OrderAccess::storestore();  // Make sure counter update is seen first.
-    Atomic::store(&self->om_free_list, (ObjectMonitor*)NULL);
-    om_unlock(free_list);
-  }
-
-  if (free_tail != NULL) {
-    prepend_list_to_global_free_list(free_list, free_tail, free_count);
-  }
-
-  if (in_use_tail != NULL) {
-    prepend_list_to_global_in_use_list(in_use_list, in_use_tail, in_use_count);
-  }
-
-  LogStreamHandle(Debug, monitorinflation) lsh_debug;
-  LogStreamHandle(Info, monitorinflation) lsh_info;
-  LogStream* ls = NULL;
-  if (log_is_enabled(Debug, monitorinflation)) {
-    ls = &lsh_debug;
-  } else if ((free_count != 0 || in_use_count != 0) &&
-             log_is_enabled(Info, monitorinflation)) {
-    ls = &lsh_info;
-  }
-  if (ls != NULL) {
-    ls->print_cr("om_flush: jt=" INTPTR_FORMAT ", free_count=%d"
-                 ", in_use_count=%d" ", om_free_provision=%d",
-                 p2i(self), free_count, in_use_count, self->om_free_provision);
-  }
-}
+// --   assigned to an object and on the in-use list.  The object is
+//      inflated and the mark refers to the ObjectMonitor.
+// --   deflated and still on the in-use list.
+// --   deflated, unlinked and waiting for the handshake before deletion.
 
 static void post_monitor_inflate_event(EventJavaMonitorInflate* event,
                                        const oop obj,
@@ -1843,7 +1337,6 @@ void ObjectSynchronizer::inflate_helper(oop obj) {
   markWord mark = obj->mark();
   if (mark.has_monitor()) {
     ObjectMonitor* monitor = mark.monitor();
-    assert(ObjectSynchronizer::verify_objmon_isinpool(monitor), "monitor=" INTPTR_FORMAT " is invalid", p2i(monitor));
     markWord dmw = monitor->header();
     assert(dmw.is_neutral(), "sanity check: header=" INTPTR_FORMAT, dmw.value());
     return;
@@ -1862,6 +1355,7 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* self, oop object,
     // The mark can be in one of the following states:
     // *  Inflated     - just return
     // *  Stack-locked - coerce it to inflated
+    // *  Fast-locked  - coerce it to inflated
     // *  INFLATING    - busy wait for conversion to complete
     // *  Neutral      - aggressively inflate the object.
     // *  BIASED       - Illegal.  We should never see this
@@ -1871,7 +1365,15 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* self, oop object,
       ObjectMonitor* inf = mark.monitor();
       markWord dmw = inf->header();
       assert(dmw.is_neutral(), "invariant: header=" INTPTR_FORMAT, dmw.value());
-      assert(ObjectSynchronizer::verify_objmon_isinpool(inf), "monitor is invalid");
+      if (UseLightweightLocking && inf->is_owner_anonymous() && self->is_Java_thread()) {
+        // The monitor was inflated by another thread while this thread
+        // had the object fast-locked. Only the owner can claim it.
+        LockStack& lock_stack = self->as_Java_thread()->lock_stack();
+        if (lock_stack.contains(object)) {
+          inf->set_owner_from_anonymous(self);
+          lock_stack.remove(object);
+        }
+      }
       return inf;
     }
 
@@ -1881,7 +1383,7 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* self, oop object,
     // The INFLATING value is transient.
     // Currently, we spin/yield/park and poll the markword, waiting for inflation to finish.
     // We could always eliminate polling by parking the thread on some auxiliary list.
-    if (mark == markWord::INFLATING()) {
+    if (mark.is_being_inflated()) {
       read_stable_mark(object);
       continue;
     }
@@ -1896,30 +1398,64 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* self, oop object,
     // the interval in which INFLATING appeared in the mark, thus increasing
     // the odds of inflation contention.
     //
-    // We now use per-thread private ObjectMonitor free lists.
-    // These list are reprovisioned from the global free list outside the
-    // critical INFLATING...ST interval.  A thread can transfer
-    // multiple ObjectMonitors en-mass from the global free list to its local free list.
-    // This reduces coherency traffic and lock contention on the global free list.
-    // Using such local free lists, it doesn't matter if the om_alloc() call appears
-    // before or after the CAS(INFLATING) operation.
-    // See the comments in om_alloc().
+    // ObjectMonitors are allocated on the C heap outside the critical
+    // INFLATING...ST interval, so it doesn't matter if the allocation
+    // appears before or after the CAS(INFLATING) operation.
 
     LogStreamHandle(Trace, monitorinflation) lsh;
 
+    // CASE: fast-locked
+    // Could be fast-locked either by this thread or by some other thread.
+    // The header stays in the object, so there is no INFLATING state and
+    // the monitor is published with a single CAS. If another thread owns
+    // the lock, the monitor is owned anonymously until that thread claims
+    // it in the inflated case above.
+    if (mark.is_fast_locked()) {
+      ObjectMonitor* m = new ObjectMonitor(object);
+      m->set_header(mark.set_unlocked());
+      bool own = self->is_Java_thread() && self->as_Java_thread()->lock_stack().contains(object);
+      if (own) {
+        m->set_owner_from(NULL, self);
+      } else {
+        m->set_owner_anonymous();
+      }
+
+      if (object->cas_set_mark(markWord::encode(m), mark) != mark) {
+        m->set_object(NULL);
+        delete m;
+        continue;       // Interference -- just retry
+      }
+      if (own) {
+        self->as_Java_thread()->lock_stack().remove(object);
+      }
+
+      // Once ObjectMonitor is configured and the object is associated
+      // with the ObjectMonitor, it is safe to allow async deflation:
+      _in_use_list.add(m);
+
+      OM_PERFDATA_OP(Inflations, inc());
+      if (log_is_enabled(Trace, monitorinflation)) {
+        ResourceMark rm(self);
+        lsh.print_cr("inflate(fast-locked): object=" INTPTR_FORMAT ", mark="
+                     INTPTR_FORMAT ", type='%s'", p2i(object),
+                     object->mark().value(), object->klass()->external_name());
+      }
+      if (event.should_commit()) {
+        post_monitor_inflate_event(&event, object, cause);
+      }
+      return m;
+    }
+
     if (mark.has_locker()) {
-      ObjectMonitor* m = om_alloc(self);
       // Optimistically prepare the ObjectMonitor - anticipate successful CAS
       // We do this before the CAS in order to minimize the length of time
       // in which INFLATING appears in the mark.
-      m->Recycle();
-      m->_Responsible  = NULL;
-      m->_SpinDuration = ObjectMonitor::Knob_SpinLimit;   // Consider: maintain by type/class
+      ObjectMonitor* m = new ObjectMonitor(object);
 
       markWord cmp = object->cas_set_mark(markWord::INFLATING(), mark);
       if (cmp != mark) {
-        // om_release() will reset the allocation state from New to Free.
-        om_release(self, m, true);
+        m->set_object(NULL);
+        delete m;
         continue;       // Interference -- just retry
       }
 
@@ -1966,21 +1502,18 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* self, oop object,
       // Note that a thread can inflate an object
       // that it has stack-locked -- as might happen in wait() -- directly
       // with CAS.  That is, we can avoid the xchg-NULL .... ST idiom.
-      m->set_owner_from(NULL, DEFLATER_MARKER, mark.locker());
-      m->set_object(object);
+      m->set_owner_from(NULL, mark.locker());
       // TODO-FIXME: assert BasicLock->dhw != 0.
 
       // Must preserve store ordering. The monitor state must
       // be stable at the time of publishing the monitor address.
       guarantee(object->mark() == markWord::INFLATING(), "invariant");
-      // Release semantics so that above set_object() is seen first.
+      // Release semantics so that the above monitor setup is seen first.
       object->release_set_mark(markWord::encode(m));
 
       // Once ObjectMonitor is configured and the object is associated
       // with the ObjectMonitor, it is safe to allow async deflation:
-      assert(m->is_new(), "freshly allocated monitor must be new");
-      // Release semantics needed to keep allocation_state from floating up.
-      m->release_set_allocation_state(ObjectMonitor::Old);
+      _in_use_list.add(m);
 
       // Hopefully the performance counters are allocated on distinct cache lines
       // to avoid false sharing on MP systems ...
@@ -2009,22 +1542,13 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* self, oop object,
     // Catch if the object's header is not neutral (not locked and
     // not marked is what we care about here).
     assert(mark.is_neutral(), "invariant: header=" INTPTR_FORMAT, mark.value());
-    ObjectMonitor* m = om_alloc(self);
+    ObjectMonitor* m = new ObjectMonitor(object);
     // prepare m for installation - set monitor to initial state
-    m->Recycle();
     m->set_header(mark);
-    // DEFLATER_MARKER is the only non-NULL value we should see here.
-    m->try_set_owner_from(DEFLATER_MARKER, NULL);
-    m->set_object(object);
-    m->_Responsible  = NULL;
-    m->_SpinDuration = ObjectMonitor::Knob_SpinLimit;       // consider: keep metastats by type/class
 
     if (object->cas_set_mark(markWord::encode(m), mark) != mark) {
-      m->set_header(markWord::zero());
       m->set_object(NULL);
-      m->Recycle();
-      // om_release() will reset the allocation state from New to Free.
-      om_release(self, m, true);
+      delete m;
       m = NULL;
       continue;
       // interference - the markword changed - just retry.
@@ -2034,10 +1558,7 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* self, oop object,
 
     // Once the ObjectMonitor is configured and object is associated
     // with the ObjectMonitor, it is safe to allow async deflation:
-    assert(m->is_new(), "freshly allocated monitor must be new");
-    // Release semantics are not needed to keep allocation_state from
-    // floating up since cas_set_mark() takes care of it.
-    m->set_allocation_state(ObjectMonitor::Old);
+    _in_use_list.add(m);
 
     // Hopefully the performance counters are allocated on distinct
     // cache lines to avoid false sharing on MP systems ...
@@ -2087,14 +1608,8 @@ void ObjectSynchronizer::do_safepoint_work() {
 //   (contentions < 0)
 // Contending threads that see that condition know to retry their operation.
 //
-bool ObjectSynchronizer::deflate_monitor_using_JT(ObjectMonitor* mid,
-                                                  ObjectMonitor** free_head_p,
-                                                  ObjectMonitor** free_tail_p) {
+bool ObjectSynchronizer::deflate_monitor_using_JT(ObjectMonitor* mid) {
   assert(Thread::current()->is_Java_thread(), "precondition");
-  // A newly allocated ObjectMonitor should not be seen here so we
-  // avoid an endless inflate/deflate cycle.
-  assert(mid->is_old(), "must be old: allocation_state=%d",
-         (int) mid->allocation_state());
 
   if (mid->is_busy()) {
     // Easy checks are first - the ObjectMonitor is busy so no deflation.
@@ -2162,184 +1677,73 @@ bool ObjectSynchronizer::deflate_monitor_using_JT(ObjectMonitor* mid,
 
   assert(mid->object() == NULL, "must be NULL: object=" INTPTR_FORMAT,
          p2i(mid->object()));
-  assert(mid->is_free(), "must be free: allocation_state=%d",
-         (int)mid->allocation_state());
-
-  // Move the deflated ObjectMonitor to the working free list
-  // defined by free_head_p and free_tail_p.
-  if (*free_head_p == NULL) {
-    // First one on the list.
-    *free_head_p = mid;
-  }
-  if (*free_tail_p != NULL) {
-    // We append to the list so the caller can use mid->_next_om
-    // to fix the linkages in its context.
-    ObjectMonitor* prevtail = *free_tail_p;
-    // prevtail should have been cleaned up by the caller:
-#ifdef ASSERT
-    ObjectMonitor* l_next_om = unmarked_next(prevtail);
-    assert(l_next_om == NULL, "must be NULL: _next_om=" INTPTR_FORMAT, p2i(l_next_om));
-#endif
-    om_lock(prevtail);
-    prevtail->set_next_om(mid);  // prevtail now points to mid (and is unlocked)
-  }
-  *free_tail_p = mid;
 
-  // At this point, mid->_next_om still refers to its current
-  // value and another ObjectMonitor's _next_om field still
-  // refers to this ObjectMonitor. Those linkages have to be
-  // cleaned up by the caller who has the complete context.
-
-  // We leave owner == DEFLATER_MARKER and contentions < 0
-  // to force any racing threads to retry.
+  // The ObjectMonitor stays on the in-use list until the deflating
+  // thread unlinks it via MonitorList::unlink_deflated(). We leave
+  // owner == DEFLATER_MARKER and contentions < 0 to force any racing
+  // threads to retry.
   return true;  // Success, ObjectMonitor has been deflated.
 }
 
-// Walk a given ObjectMonitor list and deflate idle ObjectMonitors using
-// a JavaThread. Returns the number of deflated ObjectMonitors. The given
-// list could be a per-thread in-use list or the global in-use list.
-// If a safepoint has started, then we save state via saved_mid_in_use_p
-// and return to the caller to honor the safepoint.
+// Walk the in-use list and deflate (at most MonitorDeflationMax) idle
+// ObjectMonitors using a JavaThread. Returns the number of deflated
+// ObjectMonitors. If a safepoint or handshake is requested, then the
+// calling thread blocks to honor it.
 //
-int ObjectSynchronizer::deflate_monitor_list_using_JT(ObjectMonitor** list_p,
-                                                      int* count_p,
-                                                      ObjectMonitor** free_head_p,
-                                                      ObjectMonitor** free_tail_p,
-                                                      ObjectMonitor** saved_mid_in_use_p) {
-  JavaThread* self = JavaThread::current();
+size_t ObjectSynchronizer::deflate_monitor_list_using_JT(JavaThread* self, LogStream* ls,
+                                                         elapsedTimer* timer_p) {
+  MonitorList::Iterator iter = _in_use_list.iterator();
+  size_t deflated_count = 0;
 
-  ObjectMonitor* cur_mid_in_use = NULL;
-  ObjectMonitor* mid = NULL;
-  ObjectMonitor* next = NULL;
-  ObjectMonitor* next_next = NULL;
-  int deflated_count = 0;
-  NoSafepointVerifier nsv;
-
-  // We use the more complicated lock-cur_mid_in_use-and-mid-as-we-go
-  // protocol because om_release() can do list deletions in parallel;
-  // this also prevents races with a list walker thread. We also
-  // lock-next-next-as-we-go to prevent an om_flush() that is behind
-  // this thread from passing us.
-  if (*saved_mid_in_use_p == NULL) {
-    // No saved state so start at the beginning.
-    // Lock the list head so we can possibly deflate it:
-    if ((mid = get_list_head_locked(list_p)) == NULL) {
-      return 0;  // The list is empty so nothing to deflate.
+  while (iter.has_next()) {
+    if (deflated_count >= (size_t)MonitorDeflationMax) {
+      break;
     }
-    next = unmarked_next(mid);
-  } else {
-    // We're restarting after a safepoint so restore the necessary state
-    // before we resume.
-    cur_mid_in_use = *saved_mid_in_use_p;
-    // Lock cur_mid_in_use so we can possibly update its
-    // next field to extract a deflated ObjectMonitor.
-    om_lock(cur_mid_in_use);
-    mid = unmarked_next(cur_mid_in_use);
-    if (mid == NULL) {
-      om_unlock(cur_mid_in_use);
-      *saved_mid_in_use_p = NULL;
-      return 0;  // The remainder is empty so nothing more to deflate.
+    ObjectMonitor* mid = iter.next();
+    // Only try to deflate if there is an associated Java object and
+    // the ObjectMonitor is not already being deflated.
+    if (mid->object() != NULL && !mid->is_being_async_deflated() &&
+        deflate_monitor_using_JT(mid)) {
+      deflated_count++;
     }
-    // Lock mid so we can possibly deflate it:
-    om_lock(mid);
-    next = unmarked_next(mid);
+
+    // A JavaThread must check for a safepoint/handshake and honor it.
+    chk_for_block_req(self, "deflation", "deflated_count", deflated_count,
+                      ls, timer_p);
   }
 
-  while (true) {
-    // The current mid is locked at this point. If we have a
-    // cur_mid_in_use, then it is also locked at this point.
-
-    if (next != NULL) {
-      // We lock next so that an om_flush() thread that is behind us
-      // cannot pass us when we unlock the current mid.
-      om_lock(next);
-      next_next = unmarked_next(next);
-    }
+  return deflated_count;
+}
 
-    // Only try to deflate if there is an associated Java object and if
-    // mid is old (is not newly allocated and is not newly freed).
-    if (mid->object() != NULL && mid->is_old() &&
-        deflate_monitor_using_JT(mid, free_head_p, free_tail_p)) {
-      // Deflation succeeded and already updated free_head_p and
-      // free_tail_p as needed. Finish the move to the local free list
-      // by unlinking mid from the global or per-thread in-use list.
-      if (cur_mid_in_use == NULL) {
-        // mid is the list head and it is locked. Switch the list head
-        // to next which is also locked (if not NULL) and also leave
-        // mid locked. Release semantics needed since not all code paths
-        // in deflate_monitor_using_JT() ensure memory consistency.
-        Atomic::release_store(list_p, next);
-      } else {
-        ObjectMonitor* locked_next = mark_om_ptr(next);
-        // mid and cur_mid_in_use are locked. Switch cur_mid_in_use's
-        // next field to locked_next and also leave mid locked.
-        // Release semantics needed since not all code paths in
-        // deflate_monitor_using_JT() ensure memory consistency.
-        cur_mid_in_use->release_set_next_om(locked_next);
-      }
-      // At this point mid is disconnected from the in-use list so
-      // its lock longer has any effects on in-use list.
-      deflated_count++;
-      Atomic::dec(count_p);
-      // mid is current tail in the free_head_p list so NULL terminate
-      // it (which also unlocks it). No release semantics needed since
-      // Atomic::dec() already provides it.
-      mid->set_next_om(NULL);
-
-      // All the list management is done so move on to the next one:
-      mid = next;  // mid keeps non-NULL next's locked state
-      next = next_next;
-    } else {
-      // mid is considered in-use if it does not have an associated
-      // Java object or mid is not old or deflation did not succeed.
-      // A mid->is_new() node can be seen here when it is freshly
-      // returned by om_alloc() (and skips the deflation code path).
-      // A mid->is_old() node can be seen here when deflation failed.
-      // A mid->is_free() node can be seen here when a fresh node from
-      // om_alloc() is released by om_release() due to losing the race
-      // in inflate().
-
-      // All the list management is done so move on to the next one:
-      if (cur_mid_in_use != NULL) {
-        om_unlock(cur_mid_in_use);
-      }
-      // The next cur_mid_in_use keeps mid's lock state so
-      // that it is stable for a possible next field change. It
-      // cannot be modified by om_release() while it is locked.
-      cur_mid_in_use = mid;
-      mid = next;  // mid keeps non-NULL next's locked state
-      next = next_next;
-
-      if (SafepointMechanism::should_process(self) &&
-          // Acquire semantics are not needed on this list load since
-          // it is not dependent on the following load which does have
-          // acquire semantics.
-          cur_mid_in_use != Atomic::load(list_p) && cur_mid_in_use->is_old()) {
-        // If a safepoint has started and cur_mid_in_use is not the list
-        // head and is old, then it is safe to use as saved state. Return
-        // to the caller before blocking.
-        *saved_mid_in_use_p = cur_mid_in_use;
-        om_unlock(cur_mid_in_use);
-        if (mid != NULL) {
-          om_unlock(mid);
-        }
-        return deflated_count;
-      }
-    }
-    if (mid == NULL) {
-      if (cur_mid_in_use != NULL) {
-        om_unlock(cur_mid_in_use);
-      }
-      break;  // Reached end of the list so nothing more to deflate.
-    }
+// If a safepoint or handshake has been requested, then log the current
+// progress, honor the request and resume the timer afterwards.
+void ObjectSynchronizer::chk_for_block_req(JavaThread* self, const char* op_name,
+                                           const char* cnt_name, size_t cnt,
+                                           LogStream* ls, elapsedTimer* timer_p) {
+  if (!SafepointMechanism::should_process(self)) {
+    return;
+  }
 
-    // The current mid's next field is locked at this point. If we have
-    // a cur_mid_in_use, then it is also locked at this point.
+  // A safepoint/handshake has started.
+  if (ls != NULL) {
+    timer_p->stop();
+    ls->print_cr("pausing %s: %s=" SIZE_FORMAT ", in_use_list stats: ceiling="
+                 SIZE_FORMAT ", count=" SIZE_FORMAT ", max=" SIZE_FORMAT,
+                 op_name, cnt_name, cnt, in_use_list_ceiling(),
+                 _in_use_list.count(), _in_use_list.max());
+  }
+
+  {
+    // Honor block request.
+    ThreadBlockInVM tbivm(self);
+  }
+
+  if (ls != NULL) {
+    ls->print_cr("resuming %s: in_use_list stats: ceiling=" SIZE_FORMAT
+                 ", count=" SIZE_FORMAT ", max=" SIZE_FORMAT, op_name,
+                 in_use_list_ceiling(), _in_use_list.count(), _in_use_list.max());
+    timer_p->start();
   }
-  // We finished the list without a safepoint starting so there's
-  // no need to save state.
-  *saved_mid_in_use_p = NULL;
-  return deflated_count;
 }
 
 class HandshakeForDeflation : public HandshakeClosure {
@@ -2352,185 +1756,96 @@ class HandshakeForDeflation : public HandshakeClosure {
   }
 };
 
-void ObjectSynchronizer::deflate_idle_monitors_using_JT() {
-  // Deflate any global idle monitors.
-  deflate_global_idle_monitors_using_JT();
-
-  int count = 0;
-  for (JavaThreadIteratorWithHandle jtiwh; JavaThread *jt = jtiwh.next(); ) {
-    if (Atomic::load(&jt->om_in_use_count) > 0 && !jt->is_exiting()) {
-      // This JavaThread is using ObjectMonitors so deflate any that
-      // are idle unless this JavaThread is exiting; do not race with
-      // ObjectSynchronizer::om_flush().
-      deflate_per_thread_idle_monitors_using_JT(jt);
-      count++;
-    }
-  }
-  if (count > 0) {
-    log_debug(monitorinflation)("did async deflation of idle monitors for %d thread(s).", count);
-  }
-
-  log_info(monitorinflation)("async global_population=%d, global_in_use_count=%d, "
-                             "global_free_count=%d, global_wait_count=%d",
-                             Atomic::load(&om_list_globals._population),
-                             Atomic::load(&om_list_globals._in_use_count),
-                             Atomic::load(&om_list_globals._free_count),
-                             Atomic::load(&om_list_globals._wait_count));
-
-  GVars.stw_random = os::random();
+// This function is called by the ServiceThread to deflate and free
+// idle ObjectMonitors. Returns the number of deflated ObjectMonitors.
+//
+size_t ObjectSynchronizer::deflate_idle_monitors_using_JT() {
+  JavaThread* self = JavaThread::current();
 
   // The ServiceThread's async deflation request has been processed.
   _last_async_deflation_time_ns = os::javaTimeNanos();
   set_is_async_deflation_requested(false);
 
-  if (Atomic::load(&om_list_globals._wait_count) > 0) {
-    // There are deflated ObjectMonitors waiting for a handshake
-    // (or a safepoint) for safety.
-
-    ObjectMonitor* list = Atomic::load(&om_list_globals._wait_list);
-    assert(list != NULL, "om_list_globals._wait_list must not be NULL");
-    int count = Atomic::load(&om_list_globals._wait_count);
-    Atomic::store(&om_list_globals._wait_count, 0);
-    OrderAccess::storestore();  // Make sure counter update is seen first.
-    Atomic::store(&om_list_globals._wait_list, (ObjectMonitor*)NULL);
-
-    // Find the tail for prepend_list_to_common(). No need to mark
-    // ObjectMonitors for this list walk since only the deflater
-    // thread manages the wait list.
-#ifdef ASSERT
-    int l_count = 0;
-#endif
-    ObjectMonitor* tail = NULL;
-    for (ObjectMonitor* n = list; n != NULL; n = unmarked_next(n)) {
-      tail = n;
-#ifdef ASSERT
-      l_count++;
-#endif
-    }
-    assert(count == l_count, "count=%d != l_count=%d", count, l_count);
-
-    // Will execute a safepoint if !ThreadLocalHandshakes:
-    HandshakeForDeflation hfd_hc;
-    Handshake::execute(&hfd_hc);
-
-    prepend_list_to_common(list, tail, count, &om_list_globals._free_list,
-                           &om_list_globals._free_count);
+  GVars.stw_random = os::random();
 
-    log_info(monitorinflation)("moved %d idle monitors from global waiting list to global free list", count);
+  LogStreamHandle(Debug, monitorinflation) lsh_debug;
+  LogStreamHandle(Info, monitorinflation) lsh_info;
+  LogStream* ls = NULL;
+  if (log_is_enabled(Debug, monitorinflation)) {
+    ls = &lsh_debug;
+  } else if (log_is_enabled(Info, monitorinflation)) {
+    ls = &lsh_info;
   }
-}
-
-// Deflate global idle ObjectMonitors using a JavaThread.
-//
-void ObjectSynchronizer::deflate_global_idle_monitors_using_JT() {
-  JavaThread* self = JavaThread::current();
-
-  deflate_common_idle_monitors_using_JT(true /* is_global */, self);
-}
 
-// Deflate the specified JavaThread's idle ObjectMonitors using a JavaThread.
-//
-void ObjectSynchronizer::deflate_per_thread_idle_monitors_using_JT(JavaThread* target) {
-  assert(Thread::current()->is_Java_thread(), "precondition");
-
-  deflate_common_idle_monitors_using_JT(false /* !is_global */, target);
-}
-
-// Deflate global or per-thread idle ObjectMonitors using a JavaThread.
-//
-void ObjectSynchronizer::deflate_common_idle_monitors_using_JT(bool is_global, JavaThread* target) {
-  JavaThread* self = JavaThread::current();
-
-  int deflated_count = 0;
-  ObjectMonitor* free_head_p = NULL;  // Local SLL of scavenged ObjectMonitors
-  ObjectMonitor* free_tail_p = NULL;
-  ObjectMonitor* saved_mid_in_use_p = NULL;
   elapsedTimer timer;
-
-  if (log_is_enabled(Info, monitorinflation)) {
+  if (ls != NULL) {
+    ls->print_cr("begin deflating: in_use_list stats: ceiling=" SIZE_FORMAT
+                 ", count=" SIZE_FORMAT ", max=" SIZE_FORMAT,
+                 in_use_list_ceiling(), _in_use_list.count(), _in_use_list.max());
     timer.start();
   }
 
-  if (is_global) {
-    OM_PERFDATA_OP(MonExtant, set_value(Atomic::load(&om_list_globals._in_use_count)));
-  } else {
-    OM_PERFDATA_OP(MonExtant, inc(Atomic::load(&target->om_in_use_count)));
-  }
+  // Deflate some idle ObjectMonitors.
+  size_t deflated_count = deflate_monitor_list_using_JT(self, ls, &timer);
+  if (deflated_count > 0) {
+    // There are ObjectMonitors that have been deflated.
+    ResourceMark rm;
+    GrowableArray<ObjectMonitor*> delete_list((int)deflated_count);
+    // Unlink the deflated ObjectMonitors from the in-use list.
+    size_t unlinked_count = _in_use_list.unlink_deflated(self, ls, &timer,
+                                                         &delete_list);
+    if (ls != NULL) {
+      ls->print_cr("before handshaking: unlinked_count=" SIZE_FORMAT
+                   ", in_use_list stats: ceiling=" SIZE_FORMAT ", count="
+                   SIZE_FORMAT ", max=" SIZE_FORMAT, unlinked_count,
+                   in_use_list_ceiling(), _in_use_list.count(),
+                   _in_use_list.max());
+    }
+
+    // A JavaThread needs to handshake in order to safely free the
+    // ObjectMonitors that were deflated in this cycle. No thread can
+    // be holding a stale reference to an unlinked ObjectMonitor once
+    // every thread has been handshaked.
+    HandshakeForDeflation hfd_hc;
+    Handshake::execute(&hfd_hc);
 
-  do {
-    int local_deflated_count;
-    if (is_global) {
-      local_deflated_count =
-          deflate_monitor_list_using_JT(&om_list_globals._in_use_list,
-                                        &om_list_globals._in_use_count,
-                                        &free_head_p, &free_tail_p,
-                                        &saved_mid_in_use_p);
-    } else {
-      local_deflated_count =
-          deflate_monitor_list_using_JT(&target->om_in_use_list,
-                                        &target->om_in_use_count, &free_head_p,
-                                        &free_tail_p, &saved_mid_in_use_p);
+    if (ls != NULL) {
+      ls->print_cr("after handshaking: in_use_list stats: ceiling="
+                   SIZE_FORMAT ", count=" SIZE_FORMAT ", max=" SIZE_FORMAT,
+                   in_use_list_ceiling(), _in_use_list.count(),
+                   _in_use_list.max());
     }
-    deflated_count += local_deflated_count;
-
-    if (free_head_p != NULL) {
-      // Move the deflated ObjectMonitors to the global free list.
-      guarantee(free_tail_p != NULL && local_deflated_count > 0, "free_tail_p=" INTPTR_FORMAT ", local_deflated_count=%d", p2i(free_tail_p), local_deflated_count);
-      // Note: The target thread can be doing an om_alloc() that
-      // is trying to prepend an ObjectMonitor on its in-use list
-      // at the same time that we have deflated the current in-use
-      // list head and put it on the local free list. prepend_to_common()
-      // will detect the race and retry which avoids list corruption,
-      // but the next field in free_tail_p can flicker to marked
-      // and then unmarked while prepend_to_common() is sorting it
-      // all out.
-#ifdef ASSERT
-      ObjectMonitor* l_next_om = unmarked_next(free_tail_p);
-      assert(l_next_om == NULL, "must be NULL: _next_om=" INTPTR_FORMAT, p2i(l_next_om));
-#endif
 
-      prepend_list_to_global_wait_list(free_head_p, free_tail_p, local_deflated_count);
+    // After the handshake, safely free the ObjectMonitors that were
+    // deflated in this cycle.
+    size_t deleted_count = 0;
+    for (int i = 0; i < delete_list.length(); i++) {
+      ObjectMonitor* monitor = delete_list.at(i);
+      delete monitor;
+      deleted_count++;
 
-      OM_PERFDATA_OP(Deflations, inc(local_deflated_count));
+      // A JavaThread must check for a safepoint/handshake and honor it.
+      chk_for_block_req(self, "deletion", "deleted_count", deleted_count,
+                        ls, &timer);
     }
 
-    if (saved_mid_in_use_p != NULL) {
-      // deflate_monitor_list_using_JT() detected a safepoint starting.
-      timer.stop();
-      {
-        if (is_global) {
-          log_debug(monitorinflation)("pausing deflation of global idle monitors for a safepoint.");
-        } else {
-          log_debug(monitorinflation)("jt=" INTPTR_FORMAT ": pausing deflation of per-thread idle monitors for a safepoint.", p2i(target));
-        }
-        assert(SafepointMechanism::should_process(self), "sanity check");
-        ThreadBlockInVM blocker(self);
-      }
-      // Prepare for another loop after the safepoint.
-      free_head_p = NULL;
-      free_tail_p = NULL;
-      if (log_is_enabled(Info, monitorinflation)) {
-        timer.start();
-      }
-    }
-  } while (saved_mid_in_use_p != NULL);
-  timer.stop();
-
-  LogStreamHandle(Debug, monitorinflation) lsh_debug;
-  LogStreamHandle(Info, monitorinflation) lsh_info;
-  LogStream* ls = NULL;
-  if (log_is_enabled(Debug, monitorinflation)) {
-    ls = &lsh_debug;
-  } else if (deflated_count != 0 && log_is_enabled(Info, monitorinflation)) {
-    ls = &lsh_info;
+    OM_PERFDATA_OP(Deflations, inc(deflated_count));
   }
+
   if (ls != NULL) {
-    if (is_global) {
-      ls->print_cr("async-deflating global idle monitors, %3.7f secs, %d monitors", timer.seconds(), deflated_count);
-    } else {
-      ls->print_cr("jt=" INTPTR_FORMAT ": async-deflating per-thread idle monitors, %3.7f secs, %d monitors", p2i(target), timer.seconds(), deflated_count);
+    timer.stop();
+    if (deflated_count != 0 || log_is_enabled(Debug, monitorinflation)) {
+      ls->print_cr("deflated " SIZE_FORMAT " monitors in %3.7f secs",
+                   deflated_count, timer.seconds());
     }
+    ls->print_cr("end deflating: in_use_list stats: ceiling=" SIZE_FORMAT
+                 ", count=" SIZE_FORMAT ", max=" SIZE_FORMAT,
+                 in_use_list_ceiling(), _in_use_list.count(), _in_use_list.max());
   }
+
+  OM_PERFDATA_OP(MonExtant, set_value(_in_use_list.count()));
+
+  return deflated_count;
 }
 
 // Monitor cleanup on JavaThread::exit
@@ -2611,7 +1926,7 @@ u_char* ObjectSynchronizer::get_gvars_stw_random_addr() {
 // This function can be called at a safepoint or it can be called when
 // we are trying to exit the VM. When we are trying to exit the VM, the
 // list walker functions can run in parallel with the other list
-// operations so spin-locking is used for safety.
+// operations so the in-use list counts are only approximate.
 //
 // Calls to this function can be added in various places as a debugging
 // aid; pass 'true' for the 'on_exit' parameter to have in-use monitor
@@ -2634,50 +1949,15 @@ void ObjectSynchronizer::audit_and_print_stats(bool on_exit) {
   }
   assert(ls != NULL, "sanity check");
 
-  // Log counts for the global and per-thread monitor lists:
-  int chk_om_population = log_monitor_list_counts(ls);
   int error_cnt = 0;
 
-  ls->print_cr("Checking global lists:");
-
-  // Check om_list_globals._population:
-  if (Atomic::load(&om_list_globals._population) == chk_om_population) {
-    ls->print_cr("global_population=%d equals chk_om_population=%d",
-                 Atomic::load(&om_list_globals._population), chk_om_population);
-  } else {
-    // With fine grained locks on the monitor lists, it is possible for
-    // log_monitor_list_counts() to return a value that doesn't match
-    // om_list_globals._population. So far a higher value has been
-    // seen in testing so something is being double counted by
-    // log_monitor_list_counts().
-    ls->print_cr("WARNING: global_population=%d is not equal to "
-                 "chk_om_population=%d",
-                 Atomic::load(&om_list_globals._population), chk_om_population);
-  }
-
-  // Check om_list_globals._in_use_list and om_list_globals._in_use_count:
-  chk_global_in_use_list_and_count(ls, &error_cnt);
-
-  // Check om_list_globals._free_list and om_list_globals._free_count:
-  chk_global_free_list_and_count(ls, &error_cnt);
-
-  // Check om_list_globals._wait_list and om_list_globals._wait_count:
-  chk_global_wait_list_and_count(ls, &error_cnt);
-
-  ls->print_cr("Checking per-thread lists:");
-
-  for (JavaThreadIteratorWithHandle jtiwh; JavaThread *jt = jtiwh.next(); ) {
-    // Check om_in_use_list and om_in_use_count:
-    chk_per_thread_in_use_list_and_count(jt, ls, &error_cnt);
-
-    // Check om_free_list and om_free_count:
-    chk_per_thread_free_list_and_count(jt, ls, &error_cnt);
-  }
+  ls->print_cr("Checking in_use_list:");
+  chk_in_use_list(ls, &error_cnt);
 
   if (error_cnt == 0) {
-    ls->print_cr("No errors found in monitor list checks.");
+    ls->print_cr("No errors found in in_use_list checks.");
   } else {
-    log_error(monitorinflation)("found monitor list errors: error_cnt=%d", error_cnt);
+    log_error(monitorinflation)("found in_use_list errors: error_cnt=%d", error_cnt);
   }
 
   if ((on_exit && log_is_enabled(Info, monitorinflation)) ||
@@ -2693,395 +1973,113 @@ void ObjectSynchronizer::audit_and_print_stats(bool on_exit) {
   guarantee(error_cnt == 0, "ERROR: found monitor list errors: error_cnt=%d", error_cnt);
 }
 
-// Check a free monitor entry; log any errors.
-void ObjectSynchronizer::chk_free_entry(JavaThread* jt, ObjectMonitor* n,
-                                        outputStream * out, int *error_cnt_p) {
-  stringStream ss;
-  if (n->is_busy()) {
-    if (jt != NULL) {
-      out->print_cr("ERROR: jt=" INTPTR_FORMAT ", monitor=" INTPTR_FORMAT
-                    ": free per-thread monitor must not be busy: %s", p2i(jt),
-                    p2i(n), n->is_busy_to_string(&ss));
-    } else {
-      out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": free global monitor "
-                    "must not be busy: %s", p2i(n), n->is_busy_to_string(&ss));
-    }
-    *error_cnt_p = *error_cnt_p + 1;
-  }
-  if (n->header().value() != 0) {
-    if (jt != NULL) {
-      out->print_cr("ERROR: jt=" INTPTR_FORMAT ", monitor=" INTPTR_FORMAT
-                    ": free per-thread monitor must have NULL _header "
-                    "field: _header=" INTPTR_FORMAT, p2i(jt), p2i(n),
-                    n->header().value());
-      *error_cnt_p = *error_cnt_p + 1;
-    }
-  }
-  if (n->object() != NULL) {
-    if (jt != NULL) {
-      out->print_cr("ERROR: jt=" INTPTR_FORMAT ", monitor=" INTPTR_FORMAT
-                    ": free per-thread monitor must have NULL _object "
-                    "field: _object=" INTPTR_FORMAT, p2i(jt), p2i(n),
-                    p2i(n->object()));
-    } else {
-      out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": free global monitor "
-                    "must have NULL _object field: _object=" INTPTR_FORMAT,
-                    p2i(n), p2i(n->object()));
-    }
-    *error_cnt_p = *error_cnt_p + 1;
-  }
-}
-
-// Lock the next ObjectMonitor for traversal and unlock the current
-// ObjectMonitor. Returns the next ObjectMonitor if there is one.
-// Otherwise returns NULL (after unlocking the current ObjectMonitor).
-// This function is used by the various list walker functions to
-// safely walk a list without allowing an ObjectMonitor to be moved
-// to another list in the middle of a walk.
-static ObjectMonitor* lock_next_for_traversal(ObjectMonitor* cur) {
-  assert(is_locked(cur), "cur=" INTPTR_FORMAT " must be locked", p2i(cur));
-  ObjectMonitor* next = unmarked_next(cur);
-  if (next == NULL) {  // Reached the end of the list.
-    om_unlock(cur);
-    return NULL;
-  }
-  om_lock(next);   // Lock next before unlocking current to keep
-  om_unlock(cur);  // from being by-passed by another thread.
-  return next;
-}
+// Check the in_use_list; log the results of the checks.
+void ObjectSynchronizer::chk_in_use_list(outputStream* out, int *error_cnt_p) {
+  size_t l_in_use_count = _in_use_list.count();
+  size_t l_in_use_max = _in_use_list.max();
+  out->print_cr("count=" SIZE_FORMAT ", max=" SIZE_FORMAT, l_in_use_count,
+                l_in_use_max);
 
-// Check the global free list and count; log the results of the checks.
-void ObjectSynchronizer::chk_global_free_list_and_count(outputStream * out,
-                                                        int *error_cnt_p) {
-  int chk_om_free_count = 0;
-  ObjectMonitor* cur = NULL;
-  if ((cur = get_list_head_locked(&om_list_globals._free_list)) != NULL) {
-    // Marked the global free list head so process the list.
-    while (true) {
-      chk_free_entry(NULL /* jt */, cur, out, error_cnt_p);
-      chk_om_free_count++;
-
-      cur = lock_next_for_traversal(cur);
-      if (cur == NULL) {
-        break;
-      }
-    }
+  size_t ck_in_use_count = 0;
+  MonitorList::Iterator iter = _in_use_list.iterator();
+  while (iter.has_next()) {
+    ObjectMonitor* mid = iter.next();
+    chk_in_use_entry(mid, out, error_cnt_p);
+    ck_in_use_count++;
   }
-  int l_free_count = Atomic::load(&om_list_globals._free_count);
-  if (l_free_count == chk_om_free_count) {
-    out->print_cr("global_free_count=%d equals chk_om_free_count=%d",
-                  l_free_count, chk_om_free_count);
-  } else {
-    // With fine grained locks on om_list_globals._free_list, it
-    // is possible for an ObjectMonitor to be prepended to
-    // om_list_globals._free_list after we started calculating
-    // chk_om_free_count so om_list_globals._free_count may not
-    // match anymore.
-    out->print_cr("WARNING: global_free_count=%d is not equal to "
-                  "chk_om_free_count=%d", l_free_count, chk_om_free_count);
-  }
-}
 
-// Check the global wait list and count; log the results of the checks.
-void ObjectSynchronizer::chk_global_wait_list_and_count(outputStream * out,
-                                                        int *error_cnt_p) {
-  int chk_om_wait_count = 0;
-  ObjectMonitor* cur = NULL;
-  if ((cur = get_list_head_locked(&om_list_globals._wait_list)) != NULL) {
-    // Marked the global wait list head so process the list.
-    while (true) {
-      // Rules for om_list_globals._wait_list are the same as for
-      // om_list_globals._free_list:
-      chk_free_entry(NULL /* jt */, cur, out, error_cnt_p);
-      chk_om_wait_count++;
-
-      cur = lock_next_for_traversal(cur);
-      if (cur == NULL) {
-        break;
-      }
-    }
-  }
-  if (Atomic::load(&om_list_globals._wait_count) == chk_om_wait_count) {
-    out->print_cr("global_wait_count=%d equals chk_om_wait_count=%d",
-                  Atomic::load(&om_list_globals._wait_count), chk_om_wait_count);
+  if (l_in_use_count == ck_in_use_count) {
+    out->print_cr("in_use_count=" SIZE_FORMAT " equals ck_in_use_count="
+                  SIZE_FORMAT, l_in_use_count, ck_in_use_count);
   } else {
-    out->print_cr("ERROR: global_wait_count=%d is not equal to "
-                  "chk_om_wait_count=%d",
-                  Atomic::load(&om_list_globals._wait_count), chk_om_wait_count);
-    *error_cnt_p = *error_cnt_p + 1;
+    // With lock-free additions to the in_use_list, it is possible for
+    // an ObjectMonitor to be added after the count is sampled above.
+    out->print_cr("WARNING: in_use_count=" SIZE_FORMAT " is not equal to "
+                  "ck_in_use_count=" SIZE_FORMAT, l_in_use_count,
+                  ck_in_use_count);
   }
-}
 
-// Check the global in-use list and count; log the results of the checks.
-void ObjectSynchronizer::chk_global_in_use_list_and_count(outputStream * out,
-                                                          int *error_cnt_p) {
-  int chk_om_in_use_count = 0;
-  ObjectMonitor* cur = NULL;
-  if ((cur = get_list_head_locked(&om_list_globals._in_use_list)) != NULL) {
-    // Marked the global in-use list head so process the list.
-    while (true) {
-      chk_in_use_entry(NULL /* jt */, cur, out, error_cnt_p);
-      chk_om_in_use_count++;
-
-      cur = lock_next_for_traversal(cur);
-      if (cur == NULL) {
-        break;
-      }
-    }
-  }
-  int l_in_use_count = Atomic::load(&om_list_globals._in_use_count);
-  if (l_in_use_count == chk_om_in_use_count) {
-    out->print_cr("global_in_use_count=%d equals chk_om_in_use_count=%d",
-                  l_in_use_count, chk_om_in_use_count);
+  size_t ck_in_use_max = _in_use_list.max();
+  if (l_in_use_max == ck_in_use_max) {
+    out->print_cr("in_use_max=" SIZE_FORMAT " equals ck_in_use_max="
+                  SIZE_FORMAT, l_in_use_max, ck_in_use_max);
   } else {
-    // With fine grained locks on the monitor lists, it is possible for
-    // an exiting JavaThread to put its in-use ObjectMonitors on the
-    // global in-use list after chk_om_in_use_count is calculated above.
-    out->print_cr("WARNING: global_in_use_count=%d is not equal to chk_om_in_use_count=%d",
-                  l_in_use_count, chk_om_in_use_count);
+    out->print_cr("WARNING: in_use_max=" SIZE_FORMAT " is not equal to "
+                  "ck_in_use_max=" SIZE_FORMAT, l_in_use_max, ck_in_use_max);
   }
 }
 
 // Check an in-use monitor entry; log any errors.
-void ObjectSynchronizer::chk_in_use_entry(JavaThread* jt, ObjectMonitor* n,
-                                          outputStream * out, int *error_cnt_p) {
+void ObjectSynchronizer::chk_in_use_entry(ObjectMonitor* n, outputStream* out,
+                                          int* error_cnt_p) {
+  if (n->owner_is_DEFLATER_MARKER()) {
+    // This should not happen, but if it does, it is not fatal.
+    out->print_cr("WARNING: monitor=" INTPTR_FORMAT ": in-use monitor is "
+                  "deflated.", p2i(n));
+    return;
+  }
   if (n->header().value() == 0) {
-    if (jt != NULL) {
-      out->print_cr("ERROR: jt=" INTPTR_FORMAT ", monitor=" INTPTR_FORMAT
-                    ": in-use per-thread monitor must have non-NULL _header "
-                    "field.", p2i(jt), p2i(n));
-    } else {
-      out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use global monitor "
-                    "must have non-NULL _header field.", p2i(n));
-    }
+    out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use monitor must "
+                  "have non-NULL _header field.", p2i(n));
     *error_cnt_p = *error_cnt_p + 1;
   }
-  if (n->object() == NULL) {
-    if (jt != NULL) {
-      out->print_cr("ERROR: jt=" INTPTR_FORMAT ", monitor=" INTPTR_FORMAT
-                    ": in-use per-thread monitor must have non-NULL _object "
-                    "field.", p2i(jt), p2i(n));
-    } else {
-      out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use global monitor "
-                    "must have non-NULL _object field.", p2i(n));
-    }
+  const oop obj = n->object();
+  if (obj == NULL) {
+    out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use monitor must "
+                  "have non-NULL _object field.", p2i(n));
     *error_cnt_p = *error_cnt_p + 1;
+    return;
   }
-  const oop obj = n->object();
   const markWord mark = obj->mark();
   if (!mark.has_monitor()) {
-    if (jt != NULL) {
-      out->print_cr("ERROR: jt=" INTPTR_FORMAT ", monitor=" INTPTR_FORMAT
-                    ": in-use per-thread monitor's object does not think "
-                    "it has a monitor: obj=" INTPTR_FORMAT ", mark="
-                    INTPTR_FORMAT,  p2i(jt), p2i(n), p2i(obj), mark.value());
-    } else {
-      out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use global "
-                    "monitor's object does not think it has a monitor: obj="
-                    INTPTR_FORMAT ", mark=" INTPTR_FORMAT, p2i(n),
-                    p2i(obj), mark.value());
-    }
+    out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use monitor's "
+                  "object does not think it has a monitor: obj="
+                  INTPTR_FORMAT ", mark=" INTPTR_FORMAT, p2i(n),
+                  p2i(obj), mark.value());
     *error_cnt_p = *error_cnt_p + 1;
+    return;
   }
   ObjectMonitor* const obj_mon = mark.monitor();
   if (n != obj_mon) {
-    if (jt != NULL) {
-      out->print_cr("ERROR: jt=" INTPTR_FORMAT ", monitor=" INTPTR_FORMAT
-                    ": in-use per-thread monitor's object does not refer "
-                    "to the same monitor: obj=" INTPTR_FORMAT ", mark="
-                    INTPTR_FORMAT ", obj_mon=" INTPTR_FORMAT, p2i(jt),
-                    p2i(n), p2i(obj), mark.value(), p2i(obj_mon));
-    } else {
-      out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use global "
-                    "monitor's object does not refer to the same monitor: obj="
-                    INTPTR_FORMAT ", mark=" INTPTR_FORMAT ", obj_mon="
-                    INTPTR_FORMAT, p2i(n), p2i(obj), mark.value(), p2i(obj_mon));
-    }
-    *error_cnt_p = *error_cnt_p + 1;
-  }
-}
-
-// Check the thread's free list and count; log the results of the checks.
-void ObjectSynchronizer::chk_per_thread_free_list_and_count(JavaThread *jt,
-                                                            outputStream * out,
-                                                            int *error_cnt_p) {
-  int chk_om_free_count = 0;
-  ObjectMonitor* cur = NULL;
-  if ((cur = get_list_head_locked(&jt->om_free_list)) != NULL) {
-    // Marked the per-thread free list head so process the list.
-    while (true) {
-      chk_free_entry(jt, cur, out, error_cnt_p);
-      chk_om_free_count++;
-
-      cur = lock_next_for_traversal(cur);
-      if (cur == NULL) {
-        break;
-      }
-    }
-  }
-  int l_om_free_count = Atomic::load(&jt->om_free_count);
-  if (l_om_free_count == chk_om_free_count) {
-    out->print_cr("jt=" INTPTR_FORMAT ": om_free_count=%d equals "
-                  "chk_om_free_count=%d", p2i(jt), l_om_free_count, chk_om_free_count);
-  } else {
-    out->print_cr("ERROR: jt=" INTPTR_FORMAT ": om_free_count=%d is not "
-                  "equal to chk_om_free_count=%d", p2i(jt), l_om_free_count,
-                  chk_om_free_count);
-    *error_cnt_p = *error_cnt_p + 1;
-  }
-}
-
-// Check the thread's in-use list and count; log the results of the checks.
-void ObjectSynchronizer::chk_per_thread_in_use_list_and_count(JavaThread *jt,
-                                                              outputStream * out,
-                                                              int *error_cnt_p) {
-  int chk_om_in_use_count = 0;
-  ObjectMonitor* cur = NULL;
-  if ((cur = get_list_head_locked(&jt->om_in_use_list)) != NULL) {
-    // Marked the per-thread in-use list head so process the list.
-    while (true) {
-      chk_in_use_entry(jt, cur, out, error_cnt_p);
-      chk_om_in_use_count++;
-
-      cur = lock_next_for_traversal(cur);
-      if (cur == NULL) {
-        break;
-      }
-    }
-  }
-  int l_om_in_use_count = Atomic::load(&jt->om_in_use_count);
-  if (l_om_in_use_count == chk_om_in_use_count) {
-    out->print_cr("jt=" INTPTR_FORMAT ": om_in_use_count=%d equals "
-                  "chk_om_in_use_count=%d", p2i(jt), l_om_in_use_count,
-                  chk_om_in_use_count);
-  } else {
-    out->print_cr("ERROR: jt=" INTPTR_FORMAT ": om_in_use_count=%d is not "
-                  "equal to chk_om_in_use_count=%d", p2i(jt), l_om_in_use_count,
-                  chk_om_in_use_count);
+    out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use monitor's "
+                  "object does not refer to the same monitor: obj="
+                  INTPTR_FORMAT ", mark=" INTPTR_FORMAT ", obj_mon="
+                  INTPTR_FORMAT, p2i(n), p2i(obj), mark.value(), p2i(obj_mon));
     *error_cnt_p = *error_cnt_p + 1;
   }
 }
 
-// Log details about ObjectMonitors on the in-use lists. The 'BHL'
+// Log details about ObjectMonitors on the in_use_list. The 'BHL'
 // flags indicate why the entry is in-use, 'object' and 'object type'
 // indicate the associated object and its type.
-void ObjectSynchronizer::log_in_use_monitor_details(outputStream * out) {
+void ObjectSynchronizer::log_in_use_monitor_details(outputStream* out) {
   stringStream ss;
-  if (Atomic::load(&om_list_globals._in_use_count) > 0) {
-    out->print_cr("In-use global monitor info:");
+  if (_in_use_list.count() > 0) {
+    out->print_cr("In-use monitor info:");
     out->print_cr("(B -> is_busy, H -> has hash code, L -> lock status)");
     out->print_cr("%18s  %s  %18s  %18s",
                   "monitor", "BHL", "object", "object type");
     out->print_cr("==================  ===  ==================  ==================");
-    ObjectMonitor* cur = NULL;
-    if ((cur = get_list_head_locked(&om_list_globals._in_use_list)) != NULL) {
-      // Marked the global in-use list head so process the list.
-      while (true) {
-        const oop obj = cur->object();
-        const markWord mark = cur->header();
-        ResourceMark rm;
-        out->print(INTPTR_FORMAT "  %d%d%d  " INTPTR_FORMAT "  %s", p2i(cur),
-                   cur->is_busy() != 0, mark.hash() != 0, cur->owner() != NULL,
-                   p2i(obj), obj->klass()->external_name());
-        if (cur->is_busy() != 0) {
-          out->print(" (%s)", cur->is_busy_to_string(&ss));
-          ss.reset();
-        }
-        out->cr();
-
-        cur = lock_next_for_traversal(cur);
-        if (cur == NULL) {
-          break;
-        }
+    MonitorList::Iterator iter = _in_use_list.iterator();
+    while (iter.has_next()) {
+      ObjectMonitor* mid = iter.next();
+      const oop obj = mid->object();
+      if (obj == NULL) {
+        // Skip monitors that are in the middle of async deflation.
+        continue;
       }
-    }
-  }
-
-  out->print_cr("In-use per-thread monitor info:");
-  out->print_cr("(B -> is_busy, H -> has hash code, L -> lock status)");
-  out->print_cr("%18s  %18s  %s  %18s  %18s",
-                "jt", "monitor", "BHL", "object", "object type");
-  out->print_cr("==================  ==================  ===  ==================  ==================");
-  for (JavaThreadIteratorWithHandle jtiwh; JavaThread *jt = jtiwh.next(); ) {
-    ObjectMonitor* cur = NULL;
-    if ((cur = get_list_head_locked(&jt->om_in_use_list)) != NULL) {
-      // Marked the global in-use list head so process the list.
-      while (true) {
-        const oop obj = cur->object();
-        const markWord mark = cur->header();
-        ResourceMark rm;
-        out->print(INTPTR_FORMAT "  " INTPTR_FORMAT "  %d%d%d  " INTPTR_FORMAT
-                   "  %s", p2i(jt), p2i(cur), cur->is_busy() != 0,
-                   mark.hash() != 0, cur->owner() != NULL, p2i(obj),
-                   obj->klass()->external_name());
-        if (cur->is_busy() != 0) {
-          out->print(" (%s)", cur->is_busy_to_string(&ss));
-          ss.reset();
-        }
-        out->cr();
-
-        cur = lock_next_for_traversal(cur);
-        if (cur == NULL) {
-          break;
-        }
+      const markWord mark = mid->header();
+      ResourceMark rm;
+      out->print(INTPTR_FORMAT "  %d%d%d  " INTPTR_FORMAT "  %s", p2i(mid),
+                 mid->is_busy() != 0, mark.hash() != 0, mid->owner() != NULL,
+                 p2i(obj), obj->klass()->external_name());
+      if (mid->is_busy() != 0) {
+        out->print(" (%s)", mid->is_busy_to_string(&ss));
+        ss.reset();
       }
+      out->cr();
     }
   }
 
   out->flush();
 }
-
-// Log counts for the global and per-thread monitor lists and return
-// the population count.
-int ObjectSynchronizer::log_monitor_list_counts(outputStream * out) {
-  int pop_count = 0;
-  out->print_cr("%18s  %10s  %10s  %10s  %10s",
-                "Global Lists:", "InUse", "Free", "Wait", "Total");
-  out->print_cr("==================  ==========  ==========  ==========  ==========");
-  int l_in_use_count = Atomic::load(&om_list_globals._in_use_count);
-  int l_free_count = Atomic::load(&om_list_globals._free_count);
-  int l_wait_count = Atomic::load(&om_list_globals._wait_count);
-  out->print_cr("%18s  %10d  %10d  %10d  %10d", "", l_in_use_count,
-                l_free_count, l_wait_count,
-                Atomic::load(&om_list_globals._population));
-  pop_count += l_in_use_count + l_free_count + l_wait_count;
-
-  out->print_cr("%18s  %10s  %10s  %10s",
-                "Per-Thread Lists:", "InUse", "Free", "Provision");
-  out->print_cr("==================  ==========  ==========  ==========");
-
-  for (JavaThreadIteratorWithHandle jtiwh; JavaThread *jt = jtiwh.next(); ) {
-    int l_om_in_use_count = Atomic::load(&jt->om_in_use_count);
-    int l_om_free_count = Atomic::load(&jt->om_free_count);
-    out->print_cr(INTPTR_FORMAT "  %10d  %10d  %10d", p2i(jt),
-                  l_om_in_use_count, l_om_free_count, jt->om_free_provision);
-    pop_count += l_om_in_use_count + l_om_free_count;
-  }
-  return pop_count;
-}
-
-#ifndef PRODUCT
-
-// Check if monitor belongs to the monitor cache
-// The list is grow-only so it's *relatively* safe to traverse
-// the list of extant blocks without taking a lock.
-
-int ObjectSynchronizer::verify_objmon_isinpool(ObjectMonitor *monitor) {
-  PaddedObjectMonitor* block = Atomic::load(&g_block_list);
-  while (block != NULL) {
-    assert(block->object() == CHAINMARKER, "must be a block header");
-    if (monitor > &block[0] && monitor < &block[_BLOCKSIZE]) {
-      address mon = (address)monitor;
-      address blk = (address)block;
-      size_t diff = mon - blk;
-      assert((diff % sizeof(PaddedObjectMonitor)) == 0, "must be aligned");
-      return 1;
-    }
-    // unmarked_next() is not needed with g_block_list (no locking
-    // used with block linkage _next_om fields).
-    block = (PaddedObjectMonitor*)block->next_om();
-  }
-  return 0;
-}
-
-#endif
@@ -25,7 +25,9 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "aot/aotLoader.hpp"
+#include "ci/ciEnv.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/classPreloader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/moduleEntry.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -46,6 +48,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -80,9 +83,10 @@
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/jniPeriodicChecker.hpp"
+#include "runtime/lockStack.inline.hpp"
 #include "runtime/memprofiler.hpp"
 #include "runtime/mutexLocker.hpp"
-#include "runtime/objectMonitor.hpp"
+#include "runtime/objectMonitor.inline.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/prefetch.inline.hpp"
@@ -127,6 +131,9 @@
 #ifdef COMPILER1
 #include "c1/c1_Compiler.hpp"
 #endif
+#ifdef LINUX
+#include "threadStackPool_linux.hpp"
+#endif
 #ifdef COMPILER2
 #include "opto/c2compiler.hpp"
 #include "opto/idealGraphPrinter.hpp"
@@ -178,8 +185,8 @@ void* Thread::allocate(size_t size, bool throw_excpt, MEMFLAGS flags) {
   if (UseBiasedLocking) {
     const size_t alignment = markWord::biased_lock_alignment;
     size_t aligned_size = size + (alignment - sizeof(intptr_t));
-    void* real_malloc_addr = throw_excpt? AllocateHeap(aligned_size, flags, CURRENT_PC)
-                                          : AllocateHeap(aligned_size, flags, CURRENT_PC,
+    void* real_malloc_addr = throw_excpt? AllocateHeap(aligned_size, flags, MALLOC_CURRENT_PC)
+                                          : AllocateHeap(aligned_size, flags, MALLOC_CURRENT_PC,
                                                          AllocFailStrategy::RETURN_NULL);
     void* aligned_addr     = align_up(real_malloc_addr, alignment);
     assert(((uintptr_t) aligned_addr + (uintptr_t) size) <=
@@ -193,8 +200,8 @@ void* Thread::allocate(size_t size, bool throw_excpt, MEMFLAGS flags) {
     ((Thread*) aligned_addr)->_real_malloc_address = real_malloc_addr;
     return aligned_addr;
   } else {
-    return throw_excpt? AllocateHeap(size, flags, CURRENT_PC)
-                       : AllocateHeap(size, flags, CURRENT_PC, AllocFailStrategy::RETURN_NULL);
+    return throw_excpt? AllocateHeap(size, flags, MALLOC_CURRENT_PC)
+                       : AllocateHeap(size, flags, MALLOC_CURRENT_PC, AllocFailStrategy::RETURN_NULL);
   }
 }
 
@@ -237,6 +244,7 @@ Thread::Thread() {
   set_metadata_handles(new (ResourceObj::C_HEAP, mtClass) GrowableArray<Metadata*>(30, mtClass));
   set_active_handles(NULL);
   set_free_handle_block(NULL);
+  set_free_handle_block_count(0);
   set_last_handle_mark(NULL);
   DEBUG_ONLY(_missed_ic_stub_refill_verifier = NULL);
 
@@ -244,6 +252,7 @@ Thread::Thread() {
   _threads_do_token = 0;
   _threads_hazard_ptr = NULL;
   _threads_list_ptr = NULL;
+  _threads_list_chunk = NULL;
   _nested_threads_hazard_ptr_cnt = 0;
   _rcu_counter = 0;
 
@@ -256,6 +265,8 @@ Thread::Thread() {
   NOT_PRODUCT(_skip_gcalot = false;)
   _jvmti_env_iteration_count = 0;
   set_allocated_bytes(0);
+  NMT_ONLY(_nmt_malloced_bytes = 0;)
+  NMT_ONLY(_nmt_freed_bytes = 0;)
   _vm_operation_started_count = 0;
   _vm_operation_completed_count = 0;
   _current_pending_monitor = NULL;
@@ -263,11 +274,6 @@ Thread::Thread() {
   _current_waiting_monitor = NULL;
   _current_pending_raw_monitor = NULL;
   _num_nested_signal = 0;
-  om_free_list = NULL;
-  om_free_count = 0;
-  om_free_provision = 32;
-  om_in_use_list = NULL;
-  om_in_use_count = 0;
 
 #ifdef ASSERT
   _visited_for_critical_count = false;
@@ -440,8 +446,12 @@ Thread::~Thread() {
     set_stack_base(NULL);
 #endif
   }
+  MallocTracker::record_thread_exit(this);
 #endif // INCLUDE_NMT
 
+  // Return the unused global handle entries of this thread.
+  JNIHandles::release_cached_global_entries(this);
+
   // deallocate data structures
   delete resource_area();
   // since the handle marks are using the handle area, we have to deallocated the root
@@ -458,6 +468,9 @@ Thread::~Thread() {
   delete handle_area();
   delete metadata_handles();
 
+  // Chunks freed above may have been cached by this thread
+  _chunk_cache.flush();
+
   // SR_handler uses this as a termination indicator -
   // needs to happen before os::free_thread()
   delete _SR_lock;
@@ -882,17 +895,18 @@ bool Thread::claim_par_threads_do(uintx claim_token) {
   return false;
 }
 
-void Thread::oops_do(OopClosure* f, CodeBlobClosure* cf) {
+void Thread::oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf) {
   if (active_handles() != NULL) {
     active_handles()->oops_do(f);
   }
   // Do oop for ThreadShadow
   f->do_oop((oop*)&_pending_exception);
   handle_area()->oops_do(f);
+}
 
-  // We scan thread local monitor lists here, and the remaining global
-  // monitors in ObjectSynchronizer::oops_do().
-  ObjectSynchronizer::thread_local_used_oops_do(this, f);
+void Thread::oops_do(OopClosure* f, CodeBlobClosure* cf) {
+  oops_do_no_frames(f, cf);
+  oops_do_frames(f, cf);
 }
 
 void Thread::metadata_handles_do(void f(Metadata*)) {
@@ -1723,6 +1737,7 @@ void JavaThread::initialize() {
   _jni_active_critical = 0;
   _pending_jni_exception_check_fn = NULL;
   _do_not_unlock_if_synchronized = false;
+  _profile_sample_state = os::random() | 1; // xorshift state must not be zero
   _cached_monitor_info = NULL;
   _parker = Parker::Allocate(this);
   _SleepEvent = ParkEvent::Allocate(this);
@@ -2195,6 +2210,7 @@ void JavaThread::exit(bool destroy_vm, ExitType exit_type) {
   if (free_handle_block() != NULL) {
     JNIHandleBlock* block = free_handle_block();
     set_free_handle_block(NULL);
+    set_free_handle_block_count(0);
     JNIHandleBlock::release_block(block);
   }
 
@@ -2259,6 +2275,7 @@ void JavaThread::cleanup_failed_attach_current_thread(bool is_daemon) {
   if (free_handle_block() != NULL) {
     JNIHandleBlock* block = free_handle_block();
     set_free_handle_block(NULL);
+    set_free_handle_block_count(0);
     JNIHandleBlock::release_block(block);
   }
 
@@ -2738,6 +2755,19 @@ void JavaThread::create_stack_guard_pages() {
   address low_addr = stack_end();
   size_t len = stack_guard_zone_size();
 
+#ifdef LINUX
+  // A stack from the ThreadStackPool usually has its guard zone in place.
+  PooledThreadStack* pooled_stack = osthread()->pooled_stack();
+  if (pooled_stack != NULL && pooled_stack->is_guarded()) {
+    assert(low_addr == pooled_stack->bottom(), "guard zone must be at the bottom of the pooled stack");
+    _stack_guard_state = stack_guard_enabled;
+    log_debug(os, thread)("Thread " UINTX_FORMAT " stack guard pages reused: "
+      PTR_FORMAT "-" PTR_FORMAT ".",
+      os::current_thread_id(), p2i(low_addr), p2i(low_addr + len));
+    return;
+  }
+#endif
+
   assert(is_aligned(low_addr, os::vm_page_size()), "Stack base should be the start of a page");
   assert(is_aligned(len, os::vm_page_size()), "Stack size should be a multiple of page size");
 
@@ -2771,6 +2801,17 @@ void JavaThread::remove_stack_guard_pages() {
   address low_addr = stack_end();
   size_t len = stack_guard_zone_size();
 
+#ifdef LINUX
+  // Leave the guard zone of a pooled stack for the next thread, unless
+  // part of it is disabled; the pool then protects it again.
+  PooledThreadStack* pooled_stack = osthread()->pooled_stack();
+  if (pooled_stack != NULL) {
+    pooled_stack->set_guarded(_stack_guard_state == stack_guard_enabled);
+    _stack_guard_state = stack_guard_unused;
+    return;
+  }
+#endif
+
   if (os::must_commit_stack_guard_pages()) {
     if (os::remove_stack_guard_pages((char *) low_addr, len)) {
       _stack_guard_state = stack_guard_unused;
@@ -2897,7 +2938,7 @@ void JavaThread::frames_do(void f(frame*, const RegisterMap* map)) {
   // ignore is there is no stack
   if (!has_last_Java_frame()) return;
   // traverse the stack frames. Starts from top frame.
-  for (StackFrameStream fst(this); !fst.is_done(); fst.next()) {
+  for (StackFrameStream fst(this, true /* update */, false /* process_frames */); !fst.is_done(); fst.next()) {
     frame* fr = fst.current();
     f(fr, fst.register_map());
   }
@@ -3001,29 +3042,21 @@ class RememberProcessedThread: public StackObj {
   }
 };
 
-void JavaThread::oops_do(OopClosure* f, CodeBlobClosure* cf) {
+void JavaThread::oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf) {
   // Verify that the deferred card marks have been flushed.
   assert(deferred_card_mark().is_empty(), "Should be empty during GC");
 
   // Traverse the GCHandles
-  Thread::oops_do(f, cf);
+  Thread::oops_do_no_frames(f, cf);
 
   assert((!has_last_Java_frame() && java_call_counter() == 0) ||
          (has_last_Java_frame() && java_call_counter() > 0), "wrong java_sp info!");
 
   if (has_last_Java_frame()) {
-    // Record JavaThread to GC thread
-    RememberProcessedThread rpt(this);
-
     // Traverse the monitor chunks
     for (MonitorChunk* chunk = monitor_chunks(); chunk != NULL; chunk = chunk->next()) {
       chunk->oops_do(f);
     }
-
-    // Traverse the execution stack
-    for (StackFrameStream fst(this); !fst.is_done(); fst.next()) {
-      fst.current()->oops_do(f, cf, fst.register_map());
-    }
   }
 
   assert(vframe_array_head() == NULL, "deopt in progress at a safepoint!");
@@ -3045,6 +3078,23 @@ void JavaThread::oops_do(OopClosure* f, CodeBlobClosure* cf) {
   if (jvmti_thread_state() != NULL) {
     jvmti_thread_state()->oops_do(f, cf);
   }
+
+  if (UseLightweightLocking) {
+    lock_stack().oops_do(f);
+  }
+}
+
+void JavaThread::oops_do_frames(OopClosure* f, CodeBlobClosure* cf) {
+  if (!has_last_Java_frame()) {
+    return;
+  }
+  // Record JavaThread to GC thread
+  RememberProcessedThread rpt(this);
+
+  // Traverse the execution stack
+  for (StackFrameStream fst(this, true /* update */, false /* process_frames */); !fst.is_done(); fst.next()) {
+    fst.current()->oops_do(f, cf, fst.register_map());
+  }
 }
 
 #ifdef ASSERT
@@ -3065,7 +3115,7 @@ void JavaThread::nmethods_do(CodeBlobClosure* cf) {
 
   if (has_last_Java_frame()) {
     // Traverse the execution stack
-    for (StackFrameStream fst(this); !fst.is_done(); fst.next()) {
+    for (StackFrameStream fst(this, true /* update */, false /* process_frames */); !fst.is_done(); fst.next()) {
       fst.current()->nmethods_do(cf);
     }
   }
@@ -3078,7 +3128,7 @@ void JavaThread::nmethods_do(CodeBlobClosure* cf) {
 void JavaThread::metadata_do(MetadataClosure* f) {
   if (has_last_Java_frame()) {
     // Traverse the execution stack to call f() on the methods in the stack
-    for (StackFrameStream fst(this); !fst.is_done(); fst.next()) {
+    for (StackFrameStream fst(this, true /* update */, false /* process_frames */); !fst.is_done(); fst.next()) {
       fst.current()->metadata_do(f);
     }
   } else if (is_Compiler_thread()) {
@@ -3525,6 +3575,7 @@ CompilerThread::CompilerThread(CompileQueue* queue,
   _counters = counters;
   _buffer_blob = NULL;
   _compiler = NULL;
+  reset_arena_statistics();
 
   // Compiler uses resource area for compilation, let's bias it to mtCompiler
   resource_area()->bias_to(mtCompiler);
@@ -3539,6 +3590,22 @@ CompilerThread::~CompilerThread() {
   delete _counters;
 }
 
+void CompilerThread::update_arena_statistics(ssize_t delta) {
+  // Memory held before the compilation started may be released during it,
+  // so _arena_bytes can become negative.
+  _arena_bytes += delta;
+  if (_arena_bytes > 0 && (size_t)_arena_bytes > _arena_peak) {
+    _arena_peak = (size_t)_arena_bytes;
+    if (CompileArenaMemoryLimit > 0 && _arena_peak > CompileArenaMemoryLimit &&
+        !_arena_limit_hit && _env != NULL) {
+      // Only flag the failure here, this may be called in the middle of an
+      // allocation. The compiler bails out at its next failing() check.
+      _arena_limit_hit = true;
+      _env->record_failure("out of compile arena memory");
+    }
+  }
+}
+
 bool CompilerThread::can_call_java() const {
   return _compiler != NULL && _compiler->is_jvmci();
 }
@@ -3549,8 +3616,8 @@ CodeCacheSweeperThread::CodeCacheSweeperThread()
   _scanned_compiled_method = NULL;
 }
 
-void CodeCacheSweeperThread::oops_do(OopClosure* f, CodeBlobClosure* cf) {
-  JavaThread::oops_do(f, cf);
+void CodeCacheSweeperThread::oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf) {
+  JavaThread::oops_do_no_frames(f, cf);
   if (_scanned_compiled_method != NULL && cf != NULL) {
     // Safepoints can occur when the sweeper is scanning an nmethod so
     // process it here to make sure it isn't unloaded in the middle of
@@ -3593,24 +3660,25 @@ size_t      JavaThread::_stack_size_at_create = 0;
 bool        Threads::_vm_complete = false;
 #endif
 
-static inline void *prefetch_and_load_ptr(void **addr, intx prefetch_interval) {
-  Prefetch::read((void*)addr, prefetch_interval);
-  return *addr;
+// Returns the JavaThread at the index carried in 'index', or NULL past
+// the end of the list.
+static inline JavaThread* java_thread_at(ThreadsList* list, JavaThread* index) {
+  const uint i = (uint)(uintptr_t)index;
+  return (i < list->length()) ? list->thread_at(i) : NULL;
 }
 
 // Possibly the ugliest for loop the world has seen. C++ does not allow
 // multiple types in the declaration section of the for loop. In this case
-// we are only dealing with pointers and hence can cast them. It looks ugly
-// but macros are ugly and therefore it's fine to make things absurdly ugly.
-#define DO_JAVA_THREADS(LIST, X)                                                                                          \
-    for (JavaThread *MACRO_scan_interval = (JavaThread*)(uintptr_t)PrefetchScanIntervalInBytes,                           \
-             *MACRO_list = (JavaThread*)(LIST),                                                                           \
-             **MACRO_end = ((JavaThread**)((ThreadsList*)MACRO_list)->threads()) + ((ThreadsList*)MACRO_list)->length(),  \
-             **MACRO_current_p = (JavaThread**)((ThreadsList*)MACRO_list)->threads(),                                     \
-             *X = (JavaThread*)prefetch_and_load_ptr((void**)MACRO_current_p, (intx)MACRO_scan_interval);                 \
-         MACRO_current_p != MACRO_end;                                                                                    \
-         MACRO_current_p++,                                                                                               \
-             X = (JavaThread*)prefetch_and_load_ptr((void**)MACRO_current_p, (intx)MACRO_scan_interval))
+// we are only dealing with pointers and hence can cast them, so the index
+// is carried in a JavaThread*. It looks ugly but macros are ugly and
+// therefore it's fine to make things absurdly ugly.
+#define DO_JAVA_THREADS(LIST, X)                                                      \
+    for (JavaThread *MACRO_list = (JavaThread*)(LIST),                                \
+             *MACRO_index = NULL,                                                     \
+             *X = java_thread_at((ThreadsList*)MACRO_list, MACRO_index);              \
+         X != NULL;                                                                   \
+         MACRO_index = (JavaThread*)((uintptr_t)MACRO_index + 1),                     \
+             X = java_thread_at((ThreadsList*)MACRO_list, MACRO_index))
 
 // All JavaThreads
 #define ALL_JAVA_THREADS(X) DO_JAVA_THREADS(ThreadsSMRSupport::get_java_thread_list(), X)
@@ -3936,6 +4004,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
     return status;
   }
 
+  // Start the asynchronous log writer, if enabled with -Xlog:async.
+  // It needs the barrier set, which is created by init_globals().
+  AsyncLogWriter::initialize();
+
   JFR_ONLY(Jfr::on_create_vm_1();)
 
   // Should be done after the heap is fully created
@@ -4115,6 +4187,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // Notify JVMTI agents that VM initialization is complete - nop if no agents.
   JvmtiExport::post_vm_initialized();
 
+  // Start loading the classes of -XX:PreloadClassListFile in the background.
+  ClassPreloader::initialize(CHECK_JNI_ERR);
+
   JFR_ONLY(Jfr::on_create_vm_3();)
 
 #if INCLUDE_MANAGEMENT
@@ -4131,6 +4206,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   if (MemProfiling)                   MemProfiler::engage();
   StatSampler::engage();
   if (CheckJNICalls)                  JniPeriodicChecker::engage();
+#if defined(LINUX) && defined(AMD64)
+  if (UseTSCForJavaTimeNanos)         os::tsc_java_time_nanos_engage();
+#endif
 
   BiasedLocking::init();
 
@@ -4583,6 +4661,9 @@ void Threads::add(JavaThread* p, bool force_daemon) {
 
   ThreadService::add_thread(p, daemon);
 
+  // Adjust the in-use monitor list ceiling for the new thread.
+  ObjectSynchronizer::inc_in_use_list_ceiling();
+
   // Maintain fast thread list
   ThreadsSMRSupport::add_thread(p);
 
@@ -4592,8 +4673,8 @@ void Threads::add(JavaThread* p, bool force_daemon) {
 
 void Threads::remove(JavaThread* p, bool is_daemon) {
 
-  // Reclaim the ObjectMonitors from the om_in_use_list and om_free_list of the moribund thread.
-  ObjectSynchronizer::om_flush(p);
+  // Adjust the in-use monitor list ceiling for the moribund thread.
+  ObjectSynchronizer::dec_in_use_list_ceiling();
 
   // Extra scope needed for Thread_lock, so we can check
   // that we do not remove thread without safepoint code notice
@@ -4779,6 +4860,23 @@ JavaThread *Threads::owning_thread_from_monitor_owner(ThreadsList * t_list,
   return the_owner;
 }
 
+JavaThread* Threads::owning_thread_from_object(ThreadsList* t_list, oop obj) {
+  assert(UseLightweightLocking, "Only with lightweight locking");
+  DO_JAVA_THREADS(t_list, q) {
+    if (q->lock_stack().contains(obj)) {
+      return q;
+    }
+  }
+  return NULL;
+}
+
+JavaThread* Threads::owning_thread_from_monitor(ThreadsList* t_list, ObjectMonitor* monitor) {
+  if (UseLightweightLocking && monitor->is_owner_anonymous()) {
+    return owning_thread_from_object(t_list, monitor->object());
+  }
+  return owning_thread_from_monitor_owner(t_list, (address)monitor->owner());
+}
+
 class PrintOnClosure : public ThreadClosure {
 private:
   outputStream* _st;
@@ -4845,6 +4943,65 @@ void Threads::print_on(outputStream* st, bool print_stacks,
   st->flush();
 }
 
+// Prints one JavaThread and its stack while the thread is stopped in a
+// handshake. Only the target is stopped, so the dump as a whole is not a
+// consistent snapshot.
+class PrintThreadStackClosure : public HandshakeClosure {
+ private:
+  outputStream* _st;
+  bool _print_extended_info;
+
+ public:
+  PrintThreadStackClosure(outputStream* st, bool print_extended_info) :
+      HandshakeClosure("PrintThreadStack"),
+      _st(st),
+      _print_extended_info(print_extended_info) {}
+
+  void do_thread(Thread* thread) {
+    JavaThread* jt = thread->as_Java_thread();
+    ResourceMark rm;
+    jt->print_on(_st, _print_extended_info);
+    jt->print_stack_on(_st);
+    _st->cr();
+  }
+};
+
+void Threads::print_on_with_handshakes(outputStream* st, bool print_extended_info) {
+  JavaThread* self = JavaThread::current();
+  assert(self->thread_state() == _thread_in_vm, "must be in vm state");
+
+  char buf[32];
+  st->print_raw_cr(os::local_time_string(buf, sizeof(buf)));
+
+  st->print_cr("Full thread dump %s (%s %s):",
+               VM_Version::vm_name(),
+               VM_Version::vm_release(),
+               VM_Version::vm_info_string());
+  st->cr();
+
+  ThreadsListHandle tlh(self);
+  ThreadsSMRSupport::print_info_on(st);
+  st->cr();
+
+  PrintThreadStackClosure cl(st, print_extended_info);
+  for (uint i = 0; i < tlh.length(); i++) {
+    JavaThread* jt = tlh.thread_at(i);
+    if (jt == self) {
+      cl.do_thread(jt);
+    } else {
+      // Threads that exit before the handshake reaches them are skipped.
+      Handshake::execute_direct(&cl, jt);
+    }
+  }
+
+  for (NonJavaThread::Iterator njti; !njti.end(); njti.step()) {
+    njti.current()->print_on(st);
+    st->cr();
+  }
+
+  st->flush();
+}
+
 void Threads::print_on_error(Thread* this_thread, outputStream* st, Thread* current, char* buf,
                              int buflen, bool* found_current) {
   if (this_thread != NULL) {
@@ -29,6 +29,7 @@
 #include "gc/shared/gcThreadLocalData.hpp"
 #include "gc/shared/threadLocalAllocBuffer.hpp"
 #include "memory/allocation.hpp"
+#include "memory/arena.hpp"
 #include "oops/oop.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/frame.hpp"
@@ -36,10 +37,12 @@
 #include "runtime/handshake.hpp"
 #include "runtime/javaFrameAnchor.hpp"
 #include "runtime/jniHandles.hpp"
+#include "runtime/lockStack.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/park.hpp"
+#include "runtime/stackWatermarkSet.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/threadHeapSampler.hpp"
 #include "runtime/threadLocalStorage.hpp"
@@ -181,9 +184,13 @@ class Thread: public ThreadShadow {
   friend class ScanHazardPtrGatherThreadsListClosure;  // for get_threads_hazard_ptr(), untag_hazard_ptr() access
   friend class ScanHazardPtrPrintMatchingThreadsClosure;  // for get_threads_hazard_ptr(), is_hazard_ptr_tagged() access
   friend class ThreadsSMRSupport;  // for _nested_threads_hazard_ptr_cnt, _threads_hazard_ptr, _threads_list_ptr access
+  friend class ThreadsList;  // for _threads_list_chunk access
 
   ThreadsList* volatile _threads_hazard_ptr;
   SafeThreadsListPtr*   _threads_list_ptr;
+  // The ThreadsList chunk holding this JavaThread in the current
+  // ThreadsList; only updated under the Threads_lock.
+  const void*           _threads_list_chunk;
   ThreadsList*          cmpxchg_threads_hazard_ptr(ThreadsList* exchange_value, ThreadsList* compare_value);
   ThreadsList*          get_threads_hazard_ptr();
   void                  set_threads_hazard_ptr(ThreadsList* new_list);
@@ -335,8 +342,13 @@ class Thread: public ThreadShadow {
   // Active_handles points to a block of handles
   JNIHandleBlock* _active_handles;
 
-  // One-element thread local free list
+  // Thread local free list of handle blocks, bounded by
+  // JNIHandleBlock::max_thread_free_blocks
   JNIHandleBlock* _free_handle_block;
+  int _free_handle_block_count;
+
+  // Unused global handle entries allocated in bulk
+  JNIGlobalHandleCache _global_handle_cache;
 
   // Point to the last handle mark
   HandleMark* _last_handle_mark;
@@ -396,6 +408,8 @@ class Thread: public ThreadShadow {
   jlong _allocated_bytes;                       // Cumulative number of bytes allocated on
                                                 // the Java heap
   ThreadHeapSampler _heap_sampler;              // For use when sampling the memory.
+  NMT_ONLY(size_t _nmt_malloced_bytes;)         // Cumulative number of bytes malloc'ed and
+  NMT_ONLY(size_t _nmt_freed_bytes;)            // freed by this thread, if NativeMemoryTrackingPerThread
 
   ThreadStatisticalInfo _statistical_info;      // Statistics about the thread
 
@@ -414,14 +428,6 @@ class Thread: public ThreadShadow {
   // ObjectMonitor on which this thread called Object.wait()
   ObjectMonitor* _current_waiting_monitor;
 
-  // Per-thread ObjectMonitor lists:
- public:
-  ObjectMonitor* om_free_list;                  // SLL of free ObjectMonitors
-  int om_free_count;                            // # on om_free_list
-  int om_free_provision;                        // # to try to allocate next
-  ObjectMonitor* om_in_use_list;                // SLL of in-use ObjectMonitors
-  int om_in_use_count;                          // # on om_in_use_list
-
 #ifdef ASSERT
  private:
   volatile uint64_t _visited_for_critical_count;
@@ -583,6 +589,7 @@ class Thread: public ThreadShadow {
   // Resource area
   ResourceArea* resource_area() const            { return _resource_area; }
   void set_resource_area(ResourceArea* area)     { _resource_area = area; }
+  ChunkCache* chunk_cache()                      { return &_chunk_cache; }
 
   OSThread* osthread() const                     { return _osthread;   }
   void set_osthread(OSThread* thread)            { _osthread = thread; }
@@ -592,6 +599,9 @@ class Thread: public ThreadShadow {
   void set_active_handles(JNIHandleBlock* block) { _active_handles = block; }
   JNIHandleBlock* free_handle_block() const      { return _free_handle_block; }
   void set_free_handle_block(JNIHandleBlock* block) { _free_handle_block = block; }
+  int free_handle_block_count() const            { return _free_handle_block_count; }
+  void set_free_handle_block_count(int count)    { _free_handle_block_count = count; }
+  JNIGlobalHandleCache* global_handle_cache()    { return &_global_handle_cache; }
 
   // Internal handle support
   HandleArea* handle_area() const                { return _handle_area; }
@@ -615,6 +625,13 @@ class Thread: public ThreadShadow {
 
   ThreadHeapSampler& heap_sampler()     { return _heap_sampler; }
 
+#if INCLUDE_NMT
+  size_t nmt_malloced_bytes() const     { return _nmt_malloced_bytes; }
+  size_t nmt_freed_bytes() const        { return _nmt_freed_bytes; }
+  void incr_nmt_malloced_bytes(size_t size) { _nmt_malloced_bytes += size; }
+  void incr_nmt_freed_bytes(size_t size)    { _nmt_freed_bytes += size; }
+#endif
+
   ThreadStatisticalInfo& statistical_info() { return _statistical_info; }
 
   JFR_ONLY(DEFINE_THREAD_LOCAL_ACCESSOR_JFR;)
@@ -660,7 +677,9 @@ class Thread: public ThreadShadow {
   // Apply "f->do_oop" to all root oops in "this".
   //   Used by JavaThread::oops_do.
   // Apply "cf->do_code_blob" (if !NULL) to all code blobs active in frames
-  virtual void oops_do(OopClosure* f, CodeBlobClosure* cf);
+  virtual void oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf);
+  virtual void oops_do_frames(OopClosure* f, CodeBlobClosure* cf) {}
+  void oops_do(OopClosure* f, CodeBlobClosure* cf);
 
   // Handles the parallel case for claim_threads_do.
  private:
@@ -743,6 +762,8 @@ protected:
 
   // Thread local resource area for temporary allocation within the VM
   ResourceArea* _resource_area;
+  // Free chunks kept for this thread's arenas, see ChunkCache
+  ChunkCache    _chunk_cache;
 
   DEBUG_ONLY(ResourceMark* _current_resource_mark;)
 
@@ -1127,6 +1148,7 @@ class JavaThread: public Thread {
   volatile bool         _doing_unsafe_access;    // Thread may fault due to unsafe access
   bool                  _do_not_unlock_if_synchronized;  // Do not unlock the receiver of a synchronized method (since it was
                                                          // never locked) when throwing an exception. Used by interpreter only.
+  jint                  _profile_sample_state;   // Xorshift state for sampled C1 counter updates (C1ProfileCounterSampling)
 
   // JNI attach states:
   enum JNIAttachStates {
@@ -1373,6 +1395,18 @@ class JavaThread: public Thread {
     return _handshake.active_handshaker();
   }
 
+ private:
+  // Support for lazy processing of the frames of this thread
+  StackWatermarks _stack_watermarks;
+ public:
+  StackWatermarks* stack_watermarks() { return &_stack_watermarks; }
+
+ private:
+  // Objects fast-locked by this thread with UseLightweightLocking
+  LockStack _lock_stack;
+ public:
+  LockStack& lock_stack() { return _lock_stack; }
+
   // Suspend/resume support for JavaThread
  private:
   inline void set_ext_suspended();
@@ -1818,11 +1852,16 @@ class JavaThread: public Thread {
   static ByteSize suspend_flags_offset()         { return byte_offset_of(JavaThread, _suspend_flags); }
 
   static ByteSize do_not_unlock_if_synchronized_offset() { return byte_offset_of(JavaThread, _do_not_unlock_if_synchronized); }
+  static ByteSize profile_sample_state_offset()  { return byte_offset_of(JavaThread, _profile_sample_state); }
   static ByteSize should_post_on_exceptions_flag_offset() {
     return byte_offset_of(JavaThread, _should_post_on_exceptions_flag);
   }
   static ByteSize doing_unsafe_access_offset() { return byte_offset_of(JavaThread, _doing_unsafe_access); }
 
+  static ByteSize lock_stack_offset()      { return byte_offset_of(JavaThread, _lock_stack); }
+  static ByteSize lock_stack_top_offset()  { return lock_stack_offset() + LockStack::top_offset(); }
+  static ByteSize lock_stack_base_offset() { return lock_stack_offset() + LockStack::base_offset(); }
+
   // Returns the jni environment for this thread
   JNIEnv* jni_environment()                      { return &_jni_environment; }
 
@@ -1887,7 +1926,8 @@ class JavaThread: public Thread {
   void frames_do(void f(frame*, const RegisterMap*));
 
   // Memory operations
-  void oops_do(OopClosure* f, CodeBlobClosure* cf);
+  void oops_do_frames(OopClosure* f, CodeBlobClosure* cf);
+  void oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf);
 
   // Sweeper operations
   virtual void nmethods_do(CodeBlobClosure* cf);
@@ -2139,7 +2179,7 @@ class CodeCacheSweeperThread : public JavaThread {
   bool is_Code_cache_sweeper_thread() const { return true; }
 
   // Prevent GC from unloading _scanned_compiled_method
-  void oops_do(OopClosure* f, CodeBlobClosure* cf);
+  void oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf);
   void nmethods_do(CodeBlobClosure* cf);
 };
 
@@ -2158,6 +2198,10 @@ class CompilerThread : public JavaThread {
   AbstractCompiler*     _compiler;
   TimeStamp             _idle_time;
 
+  ssize_t               _arena_bytes;        // mtCompiler arena memory used by the current compilation
+  size_t                _arena_peak;         // Peak of _arena_bytes
+  bool                  _arena_limit_hit;    // Current compilation exceeded CompileArenaMemoryLimit
+
  public:
 
   static CompilerThread* current();
@@ -2193,6 +2237,16 @@ class CompilerThread : public JavaThread {
     _log = log;
   }
 
+  // Per-compilation accounting of mtCompiler arena memory, see Arena::set_size_in_bytes()
+  void   reset_arena_statistics() {
+    _arena_bytes = 0;
+    _arena_peak = 0;
+    _arena_limit_hit = false;
+  }
+  void   update_arena_statistics(ssize_t delta);
+  size_t arena_peak() const                      { return _arena_peak; }
+  bool   arena_limit_hit() const                 { return _arena_limit_hit; }
+
   void start_idle_timer()                        { _idle_time.update(); }
   jlong idle_time_millis() {
     return TimeHelper::counter_to_millis(_idle_time.ticks_since_update());
@@ -2305,6 +2359,9 @@ class Threads: AllStatic {
   // Verification
   static void verify();
   static void print_on(outputStream* st, bool print_stacks, bool internal_format, bool print_concurrent_locks, bool print_extended_info);
+  // Prints all threads, stopping each JavaThread with a handshake of its
+  // own instead of bringing the whole VM to a safepoint.
+  static void print_on_with_handshakes(outputStream* st, bool print_extended_info);
   static void print(bool print_stacks, bool internal_format) {
     // this function is only used by debug.cpp
     print_on(tty, print_stacks, internal_format, false /* no concurrent lock printed */, false /* simple format */);
@@ -2321,6 +2378,10 @@ class Threads: AllStatic {
   // Get owning Java thread from the monitor's owner field.
   static JavaThread *owning_thread_from_monitor_owner(ThreadsList * t_list,
                                                       address owner);
+  // Get owning Java thread of a monitor, including an anonymously owned one.
+  static JavaThread* owning_thread_from_monitor(ThreadsList* t_list, ObjectMonitor* monitor);
+  // Get owning Java thread of a fast-locked object from the lock stacks.
+  static JavaThread* owning_thread_from_object(ThreadsList* t_list, oop obj);
 
   // Number of threads on the active threads list
   static int number_of_threads()                 { return _number_of_threads; }
@@ -134,6 +134,13 @@ uint                  ThreadsSMRSupport::_to_delete_list_cnt = 0;
 // Impl note: See _to_delete_list_cnt note.
 uint                  ThreadsSMRSupport::_to_delete_list_max = 0;
 
+// # of ThreadsLists added to the to-delete list since the hazard ptrs
+// were last scanned. Not a statistic; see free_list().
+uint                  ThreadsSMRSupport::_to_delete_list_unscanned = 0;
+
+// free_list() scans the hazard ptrs once per this many ThreadsLists.
+static const uint FreeListScanInterval = 8;
+
 // 'inline' functions first so the definitions are before first use:
 
 inline void ThreadsSMRSupport::add_deleted_thread_times(uint add_value) {
@@ -572,35 +579,94 @@ void SafeThreadsListPtr::verify_hazard_ptr_scanned() {
 #endif
 }
 
-// 'entries + 1' so we always have at least one entry.
+// At least one slot so that the directory is never empty.
+ThreadsList::Slot* ThreadsList::new_slots(uint count) {
+  return NEW_C_HEAP_ARRAY(Slot, MAX2(count, 1u), mtThread);
+}
+
 ThreadsList::ThreadsList(int entries) :
   _length(entries),
+  _slot_count((entries + ChunkSize - 1) >> ChunkShift),
   _next_list(NULL),
-  _threads(NEW_C_HEAP_ARRAY(JavaThread*, entries + 1, mtThread)),
+  _slots(new_slots(_slot_count)),
   _nested_handle_cnt(0)
 {
-  *(JavaThread**)(_threads + entries) = NULL;  // Make sure the extra entry is NULL.
+  for (uint c = 0; c < _slot_count; c++) {
+    Chunk* const chunk = new Chunk();
+    chunk->_used = MIN2(_length - (c << ChunkShift), ChunkSize);
+    chunk->_ref_cnt = 1;
+    _slots[c]._chunk = chunk;
+    _slots[c]._start = c << ChunkShift;
+    _slots[c]._length = chunk->_used;
+  }
 }
 
-ThreadsList::~ThreadsList() {
-  FREE_C_HEAP_ARRAY(JavaThread*, _threads);
+ThreadsList::ThreadsList(Slot* slots, uint slot_count) :
+  _length((slot_count > 0) ? slots[slot_count - 1]._start + slots[slot_count - 1]._length : 0),
+  _slot_count(slot_count),
+  _next_list(NULL),
+  _slots(slots),
+  _nested_handle_cnt(0)
+{
+  for (uint c = 0; c < _slot_count; c++) {
+    _slots[c]._chunk->_ref_cnt++;
+  }
 }
 
-// Add a JavaThread to a ThreadsList. The returned ThreadsList is a
-// new copy of the specified ThreadsList with the specified JavaThread
-// appended to the end.
-ThreadsList *ThreadsList::add_thread(ThreadsList *list, JavaThread *java_thread) {
-  const uint index = list->_length;
-  const uint new_length = index + 1;
-  const uint head_length = index;
-  ThreadsList *const new_list = new ThreadsList(new_length);
+ThreadsList::~ThreadsList() {
+  for (uint c = 0; c < _slot_count; c++) {
+    Chunk* const chunk = _slots[c]._chunk;
+    assert(chunk->_ref_cnt > 0, "sanity");
+    if (--chunk->_ref_cnt == 0) {
+      delete chunk;
+    }
+  }
+  FREE_C_HEAP_ARRAY(Slot, _slots);
+}
 
-  if (head_length > 0) {
-    Copy::disjoint_words((HeapWord*)list->_threads, (HeapWord*)new_list->_threads, head_length);
+// Appends the JavaThreads of the specified slot, except 'skip', to the
+// end of the specified chunk, which now holds them in the current list.
+void ThreadsList::append_entries(Chunk* chunk, const Slot* slot, const JavaThread* skip) {
+  for (uint i = 0; i < slot->_length; i++) {
+    JavaThread* const thread = slot->_chunk->_threads[i];
+    if (thread != skip) {
+      assert(chunk->_used < ChunkSize, "chunk overflow");
+      chunk->_threads[chunk->_used++] = thread;
+      thread->_threads_list_chunk = chunk;
+    }
   }
-  *(JavaThread**)(new_list->_threads + index) = java_thread;
+}
 
-  return new_list;
+// Add a JavaThread to a ThreadsList. The returned ThreadsList holds the
+// JavaThreads of the specified ThreadsList with the specified JavaThread
+// appended to the end. All chunks are shared with the specified
+// ThreadsList; the JavaThread is written to its last chunk unless that
+// chunk is full or has been appended to by another ThreadsList.
+ThreadsList *ThreadsList::add_thread(ThreadsList *list, JavaThread *java_thread) {
+  const uint count = list->_slot_count;
+  const Slot* const last = (count > 0) ? list->_slots + count - 1 : NULL;
+  const bool in_place = last != NULL && last->_length < ChunkSize &&
+                        last->_chunk->_used == last->_length;
+  const uint new_count = in_place ? count : count + 1;
+  Slot* const slots = new_slots(new_count);
+
+  for (uint c = 0; c < count; c++) {
+    slots[c] = list->_slots[c];
+  }
+  if (!in_place) {
+    slots[count]._chunk = new Chunk();
+    slots[count]._start = list->_length;
+    slots[count]._length = 0;
+  }
+  // Readers of the other ThreadsLists sharing the chunk do not look at
+  // this entry, and the new list is published with a full fence.
+  Slot* const slot = slots + new_count - 1;
+  Chunk* const chunk = slot->_chunk;
+  chunk->_threads[chunk->_used++] = java_thread;
+  slot->_length++;
+  java_thread->_threads_list_chunk = chunk;
+
+  return new ThreadsList(slots, new_count);
 }
 
 void ThreadsList::dec_nested_handle_cnt() {
@@ -662,28 +728,60 @@ bool ThreadsList::includes(const JavaThread * const p) const {
   return false;
 }
 
-// Remove a JavaThread from a ThreadsList. The returned ThreadsList is a
-// new copy of the specified ThreadsList with the specified JavaThread
-// removed.
+// Remove a JavaThread from a ThreadsList. The returned ThreadsList holds
+// the JavaThreads of the specified ThreadsList, in the same order, except
+// the specified one. The chunk that held it is copied without it, together
+// with a neighbouring chunk when both fit in one; the other chunks are
+// shared with the specified ThreadsList.
 ThreadsList *ThreadsList::remove_thread(ThreadsList* list, JavaThread* java_thread) {
   assert(list->_length > 0, "sanity");
 
-  uint i = (uint)list->find_index_of_JavaThread(java_thread);
-  assert(i < list->_length, "did not find JavaThread on the list");
-  const uint index = i;
-  const uint new_length = list->_length - 1;
-  const uint head_length = index;
-  const uint tail_length = (new_length >= index) ? (new_length - index) : 0;
-  ThreadsList *const new_list = new ThreadsList(new_length);
+  const uint count = list->_slot_count;
+  uint s = 0;
+  while (s < count && list->_slots[s]._chunk != java_thread->_threads_list_chunk) {
+    s++;
+  }
+  assert(s < count, "did not find JavaThread on the list");
+  const uint remaining = list->_slots[s]._length - 1;
+
+  // Replace the slots [first, last] with one slot, or none if it is empty.
+  uint first = s;
+  uint last = s;
+  if (remaining > 0) {
+    if (s + 1 < count && remaining + list->_slots[s + 1]._length <= ChunkSize) {
+      last = s + 1;
+    } else if (s > 0 && remaining + list->_slots[s - 1]._length <= ChunkSize) {
+      first = s - 1;
+    }
+  }
+  const uint new_count = count - (last - first) - ((remaining > 0) ? 0 : 1);
+  Slot* const slots = new_slots(new_count);
+  uint n = 0;
 
-  if (head_length > 0) {
-    Copy::disjoint_words((HeapWord*)list->_threads, (HeapWord*)new_list->_threads, head_length);
+  for (uint c = 0; c < first; c++) {
+    slots[n++] = list->_slots[c];
+  }
+  if (remaining > 0) {
+    Chunk* const chunk = new Chunk();
+    uint entries = 0;
+    for (uint c = first; c <= last; c++) {
+      append_entries(chunk, list->_slots + c, java_thread);
+      entries += list->_slots[c]._length;
+    }
+    assert(chunk->_used == entries - 1, "did not find JavaThread on the list");
+    slots[n]._chunk = chunk;
+    slots[n]._start = list->_slots[first]._start;
+    slots[n]._length = chunk->_used;
+    n++;
   }
-  if (tail_length > 0) {
-    Copy::disjoint_words((HeapWord*)list->_threads + index + 1, (HeapWord*)new_list->_threads + index, tail_length);
+  for (uint c = last + 1; c < count; c++) {
+    slots[n] = list->_slots[c];
+    slots[n]._start--;
+    n++;
   }
+  assert(n == new_count, "sanity");
 
-  return new_list;
+  return new ThreadsList(slots, new_count);
 }
 
 ThreadsListHandle::ThreadsListHandle(Thread *self) : _list_ptr(self, /* acquire */ true) {
@@ -808,6 +906,16 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
     }
   }
 
+  // Gathering the hazard ptrs visits every thread, so with many threads
+  // doing it on every Threads::add() and Threads::remove() dominates their
+  // cost. Only scan once a few ThreadsLists are pending; they share most
+  // of their chunks with the current list anyway.
+  if (++_to_delete_list_unscanned < FreeListScanInterval) {
+    log_debug(thread, smr)("tid=" UINTX_FORMAT ": ThreadsSMRSupport::free_list: threads=" INTPTR_FORMAT " is not freed.", os::current_thread_id(), p2i(threads));
+    return;
+  }
+  _to_delete_list_unscanned = 0;
+
   // Hash table size should be first power of two higher than twice the length of the ThreadsList
   int hash_table_size = MIN2((int)get_java_thread_list()->length(), 32) << 1;
   hash_table_size = round_up_power_of_2(hash_table_size);
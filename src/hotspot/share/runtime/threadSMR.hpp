@@ -117,6 +117,8 @@ class ThreadsSMRSupport : AllStatic {
   static ThreadsList*          _to_delete_list;
   static uint                  _to_delete_list_cnt;
   static uint                  _to_delete_list_max;
+  // ThreadsLists added to _to_delete_list since its hazard ptrs were last scanned.
+  static uint                  _to_delete_list_unscanned;
 
   static ThreadsList *acquire_stable_list_fast_path(Thread *self);
   static ThreadsList *acquire_stable_list_nested_path(Thread *self);
@@ -163,11 +165,73 @@ class ThreadsList : public CHeapObj<mtThread> {
   friend class SafeThreadsListPtr;  // for {dec,inc}_nested_handle_cnt() access
   friend class ThreadsSMRSupport;  // for _nested_handle_cnt, {add,remove}_thread(), {,set_}next_list() access
 
+  // The JavaThreads are kept in chunks of at most ChunkSize entries,
+  // reached through a directory of slots. A ThreadsList created by
+  // add_thread() or remove_thread() shares every unchanged chunk with the
+  // list it was created from, so adding or removing a JavaThread copies at
+  // most two chunks and the directory instead of the whole list.
+  //
+  // add_thread() appends in place to the last chunk when the list it was
+  // given was the last one to append to that chunk; readers of the other
+  // ThreadsLists sharing the chunk only read the entries below the length
+  // in their own slot. remove_thread() copies the chunk without the
+  // removed entry, so the JavaThreads stay in the order they were added.
+  // A chunk is merged with a neighbour when both fit in one chunk.
+  //
+  // Chunks are updated and their reference counts maintained under the
+  // Threads_lock.
+  static const uint ChunkShift = 7;
+  static const uint ChunkSize = 1u << ChunkShift;
+
+  class Chunk : public CHeapObj<mtThread> {
+   public:
+    JavaThread* _threads[ChunkSize];
+    uint _used;     // Entries written so far.
+    uint _ref_cnt;  // ThreadsLists using this chunk.
+
+    Chunk() : _used(0), _ref_cnt(0) {}
+  };
+
+  // The JavaThreads at indices [_start, _start + _length) of the list are
+  // the first _length entries of _chunk.
+  struct Slot {
+    Chunk* _chunk;
+    uint _start;
+    uint _length;
+  };
+
   const uint _length;
+  const uint _slot_count;
   ThreadsList* _next_list;
-  JavaThread *const *const _threads;
+  Slot *const _slots;
   volatile intx _nested_handle_cnt;
 
+  // Takes over the specified directory.
+  ThreadsList(Slot* slots, uint slot_count);
+
+  // Returns the index of the slot holding the JavaThread at index i. The
+  // chunks before it hold at most ChunkSize entries each, so that slot is
+  // at or after i >> ChunkShift, and exactly there unless JavaThreads were
+  // removed from an earlier chunk.
+  uint slot_index_of(uint i) const {
+    uint lo = MIN2(i >> ChunkShift, _slot_count - 1);
+    if (i - _slots[lo]._start < _slots[lo]._length) {
+      return lo;
+    }
+    uint hi = _slot_count - 1;
+    while (lo < hi) {
+      const uint mid = (lo + hi + 1) / 2;
+      if (_slots[mid]._start <= i) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    return lo;
+  }
+  static Slot* new_slots(uint count);
+  static void append_entries(Chunk* chunk, const Slot* slot, const JavaThread* skip);
+
   template <class T>
   void threads_do_dispatch(T *cl, JavaThread *const thread) const;
 
@@ -189,9 +253,11 @@ public:
 
   uint length() const                       { return _length; }
 
-  JavaThread *const thread_at(uint i) const { return _threads[i]; }
-
-  JavaThread *const *threads() const        { return _threads; }
+  JavaThread *const thread_at(uint i) const {
+    assert(i < _length, "index out of bounds");
+    const Slot* const slot = _slots + slot_index_of(i);
+    return slot->_chunk->_threads[i - slot->_start];
+  }
 
   // Returns -1 if target is not found.
   int find_index_of_JavaThread(JavaThread* target);
@@ -324,6 +390,9 @@ public:
 
   JavaThread *first() {
     _index = 0;
+    if (length() == 0) {
+      return NULL;
+    }
     return _list->thread_at(_index);
   }
 
@@ -45,11 +45,14 @@ inline void ThreadsList::threads_do_dispatch<ThreadClosure>(ThreadClosure *cl, J
 template <class T>
 inline void ThreadsList::threads_do(T *cl) const {
   const intx scan_interval = PrefetchScanIntervalInBytes;
-  JavaThread *const *const end = _threads + _length;
-  for (JavaThread *const *current_p = _threads; current_p != end; current_p++) {
-    Prefetch::read((void*)current_p, scan_interval);
-    JavaThread *const current = *current_p;
-    threads_do_dispatch(cl, current);
+  const Slot *const slots_end = _slots + _slot_count;
+  for (const Slot *slot = _slots; slot != slots_end; slot++) {
+    JavaThread *const *const end = slot->_chunk->_threads + slot->_length;
+    for (JavaThread *const *current_p = slot->_chunk->_threads; current_p != end; current_p++) {
+      Prefetch::read((void*)current_p, scan_interval);
+      JavaThread *const current = *current_p;
+      threads_do_dispatch(cl, current);
+    }
   }
 }
 
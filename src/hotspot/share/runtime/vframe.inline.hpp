@@ -29,7 +29,7 @@
 #include "runtime/thread.inline.hpp"
 #include "runtime/vframe.hpp"
 
-inline vframeStreamCommon::vframeStreamCommon(JavaThread* thread) : _reg_map(thread, false) {
+inline vframeStreamCommon::vframeStreamCommon(JavaThread* thread, bool process_frames) : _reg_map(thread, false, process_frames) {
   _thread = thread;
 }
 
@@ -50,8 +50,8 @@ inline void vframeStreamCommon::next() {
   } while (!fill_from_frame());
 }
 
-inline vframeStream::vframeStream(JavaThread* thread, bool stop_at_java_call_stub)
-  : vframeStreamCommon(thread) {
+inline vframeStream::vframeStream(JavaThread* thread, bool stop_at_java_call_stub, bool process_frames)
+  : vframeStreamCommon(thread, process_frames) {
   _stop_at_java_call_stub = stop_at_java_call_stub;
 
   if (!thread->has_last_Java_frame()) {
@@ -572,6 +572,7 @@ typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
      static_field(StubRoutines,                _counterMode_AESCrypt,                         address)                               \
      static_field(StubRoutines,                _ghash_processBlocks,                          address)                               \
      static_field(StubRoutines,                _base64_encodeBlock,                           address)                               \
+     static_field(StubRoutines,                _base64_decodeBlock,                           address)                               \
      static_field(StubRoutines,                _updateBytesCRC32,                             address)                               \
      static_field(StubRoutines,                _crc_table_adr,                                address)                               \
      static_field(StubRoutines,                _crc32c_table_addr,                            address)                               \
@@ -726,7 +727,11 @@ typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
                                                                                                                                      \
   static_ptr_volatile_field(ThreadsSMRSupport, _java_thread_list,                             ThreadsList*)                          \
   nonstatic_field(ThreadsList,                 _length,                                       const uint)                            \
-  nonstatic_field(ThreadsList,                 _threads,                                      JavaThread *const *const)              \
+  nonstatic_field(ThreadsList,                 _slot_count,                                   const uint)                            \
+  nonstatic_field(ThreadsList,                 _slots,                                        ThreadsList::Slot *const)              \
+  nonstatic_field(ThreadsList::Slot,           _chunk,                                        ThreadsList::Chunk*)                   \
+  nonstatic_field(ThreadsList::Slot,           _length,                                       uint)                                  \
+  unchecked_nonstatic_field(ThreadsList::Chunk, _threads,                                     ThreadsList::ChunkSize * sizeof(JavaThread*)) /* NOTE: no type */ \
                                                                                                                                      \
   nonstatic_field(ThreadShadow,                _pending_exception,                            oop)                                   \
   nonstatic_field(ThreadShadow,                _exception_file,                               const char*)                           \
@@ -887,7 +892,8 @@ typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
   volatile_nonstatic_field(ObjectMonitor,      _recursions,                                   intx)                                  \
   nonstatic_field(BasicObjectLock,             _lock,                                         BasicLock)                             \
   nonstatic_field(BasicObjectLock,             _obj,                                          oop)                                   \
-  static_field(ObjectSynchronizer,             g_block_list,                                  PaddedObjectMonitor*)                  \
+  static_field(ObjectSynchronizer,             _in_use_list,                                  MonitorList)                           \
+  volatile_nonstatic_field(MonitorList,        _head,                                         ObjectMonitor*)                        \
                                                                                                                                      \
   /*********************/                                                                                                            \
   /* Matcher (C2 only) */                                                                                                            \
@@ -1462,7 +1468,7 @@ typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
   /************/                                                          \
                                                                           \
   declare_toplevel_type(ObjectMonitor)                                    \
-  declare_toplevel_type(PaddedObjectMonitor)                              \
+  declare_toplevel_type(MonitorList)                                      \
   declare_toplevel_type(ObjectSynchronizer)                               \
   declare_toplevel_type(BasicLock)                                        \
   declare_toplevel_type(BasicObjectLock)                                  \
@@ -1948,6 +1954,10 @@ typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
    declare_unsigned_integer_type(InvocationCounter) /* FIXME: wrong type (not integer) */ \
   declare_toplevel_type(JavaThread*)                                      \
   declare_toplevel_type(JavaThread *const *const)                         \
+  declare_toplevel_type(ThreadsList::Chunk)                               \
+  declare_toplevel_type(ThreadsList::Chunk*)                              \
+  declare_toplevel_type(ThreadsList::Slot)                                \
+  declare_toplevel_type(ThreadsList::Slot *const)                         \
   declare_toplevel_type(java_lang_Class)                                  \
   declare_integer_type(JavaThread::AsyncRequests)                         \
   declare_integer_type(JavaThread::TerminatedTypes)                       \
@@ -1965,7 +1975,6 @@ typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
   declare_toplevel_type(nmethod*)                                         \
   COMPILER2_PRESENT(declare_unsigned_integer_type(node_idx_t))            \
   declare_toplevel_type(ObjectMonitor*)                                   \
-  declare_toplevel_type(PaddedObjectMonitor*)                             \
   declare_toplevel_type(oop*)                                             \
   declare_toplevel_type(OopMapCache*)                                     \
   declare_toplevel_type(VMReg)                                            \
@@ -2495,12 +2504,6 @@ typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
   declare_constant(JNIHandleBlock::block_size_in_oops)                    \
                                                                           \
   /**********************/                                                \
-  /* ObjectSynchronizer */                                                \
-  /**********************/                                                \
-                                                                          \
-  declare_constant(ObjectSynchronizer::_BLOCKSIZE)                        \
-                                                                          \
-  /**********************/                                                \
   /* PcDesc             */                                                \
   /**********************/                                                \
                                                                           \
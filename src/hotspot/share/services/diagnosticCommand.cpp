@@ -27,8 +27,10 @@
 #include "classfile/classLoaderHierarchyDCmd.hpp"
 #include "classfile/classLoaderStats.hpp"
 #include "code/codeCache.hpp"
+#include "code/perfMap.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/directivesParser.hpp"
+#include "gc/shared/allocationSiteProfiler.hpp"
 #include "gc/shared/gcVMOperations.hpp"
 #include "memory/metaspace/metaspaceDCmd.hpp"
 #include "memory/resourceArea.hpp"
@@ -42,6 +44,7 @@
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepointProfiler.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -51,7 +54,11 @@
 #include "utilities/debug.hpp"
 #include "utilities/events.hpp"
 #include "utilities/formatBuffer.hpp"
+#include "utilities/latencyHistogram.hpp"
 #include "utilities/macros.hpp"
+#if INCLUDE_EPSILONGC
+#include "gc/epsilon/epsilonArenaDCmd.hpp"
+#endif
 
 
 static void loadAgentModule(TRAPS) {
@@ -84,10 +91,16 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMDynamicLibrariesDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMUptimeDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMInfoDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMLatenciesDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SystemGCDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RunFinalizationDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapInfoDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<FinalizerInfoDCmd>(full_export, true, false));
+#if INCLUDE_EPSILONGC
+  if (UseEpsilonGC) {
+    DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<EpsilonArenaDCmd>(full_export, true, false));
+  }
+#endif
 #if INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapDumpDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassHistogramDCmd>(full_export, true, false));
@@ -97,6 +110,8 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<StringtableDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<metaspace::MetaspaceDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<EventLogDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SafepointProfileDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<AllocationSitesDCmd>(full_export, true, false));
 #if INCLUDE_JVMTI // Both JVMTI and SERVICES have to be enabled to have this dcmd
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<JVMTIAgentLoadDCmd>(full_export, true, false));
 #endif // INCLUDE_JVMTI
@@ -110,6 +125,9 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompileQueueDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
+#ifdef LINUX
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<PerfMapDCmd>(full_export, true, false));
+#endif // LINUX
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TouchedMethodsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeHeapAnalyticsDCmd>(full_export, true, false));
 
@@ -436,6 +454,10 @@ void VMInfoDCmd::execute(DCmdSource source, TRAPS) {
   VMError::print_vm_info(_output);
 }
 
+void VMLatenciesDCmd::execute(DCmdSource source, TRAPS) {
+  LatencyHistogram::print_all(output());
+}
+
 void SystemGCDCmd::execute(DCmdSource source, TRAPS) {
   Universe::heap()->collect(GCCause::_dcmd_gc_run);
 }
@@ -508,10 +530,27 @@ HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
        "BOOLEAN", false, "false"),
   _gzip("-gz", "If specified, the heap dump is written in gzipped format "
                "using the given compression level. 1 (recommended) is the fastest, "
-               "9 the strongest compression.", "INT", false, "1") {
+               "9 the strongest compression.", "INT", false, "1"),
+  _pipe("-pipe", "Write the dump to the existing named pipe given as filename, "
+                 "e.g. for an agent uploading it, instead of creating a file.",
+        "BOOLEAN", false, "false"),
+  _segment("-segment", "Split the dump into files <filename>.0, <filename>.1, ... "
+                       "of about the given size, which can be processed in parallel. "
+                       "With -gz, every file consists of complete gzip members.",
+           "MEMORY SIZE", false, "0"),
+  _truncate("-truncate", "Truncate the contents of primitive arrays larger than "
+                         "the given size. The dumped arrays report the truncated length.",
+            "MEMORY SIZE", false, "0"),
+  _redact("-redact", "Comma-separated list of classes whose instances are dumped "
+                     "with all primitive fields zeroed, e.g. to keep secrets out of "
+                     "the dump.", "STRING", false) {
   _dcmdparser.add_dcmd_option(&_all);
   _dcmdparser.add_dcmd_argument(&_filename);
   _dcmdparser.add_dcmd_option(&_gzip);
+  _dcmdparser.add_dcmd_option(&_pipe);
+  _dcmdparser.add_dcmd_option(&_segment);
+  _dcmdparser.add_dcmd_option(&_truncate);
+  _dcmdparser.add_dcmd_option(&_redact);
 }
 
 void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
@@ -526,11 +565,21 @@ void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
     }
   }
 
+  size_t segment_size = (size_t)_segment.value()._size;
+  if (_pipe.value() && segment_size > 0) {
+    output()->print_cr("Options -pipe and -segment can not be combined");
+    return;
+  }
+
   // Request a full GC before heap dump if _all is false
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  dumper.dump(_filename.value(), output(), (int) level);
+  if (_truncate.is_set()) {
+    dumper.set_prim_array_limit((size_t)_truncate.value()._size);
+  }
+  dumper.set_redacted_classes(_redact.value());
+  dumper.dump(_filename.value(), output(), (int) level, _pipe.value(), segment_size);
 }
 
 int HeapDumpDCmd::num_arguments() {
@@ -573,15 +622,25 @@ int ClassHistogramDCmd::num_arguments() {
 ThreadDumpDCmd::ThreadDumpDCmd(outputStream* output, bool heap) :
                                DCmdWithParser(output, heap),
   _locks("-l", "print java.util.concurrent locks", "BOOLEAN", false, "false"),
-  _extended("-e", "print extended thread information", "BOOLEAN", false, "false") {
+  _extended("-e", "print extended thread information", "BOOLEAN", false, "false"),
+  _handshake("-handshake", "stop one thread at a time with a handshake instead of "
+             "all threads at a safepoint; the dump is not a consistent snapshot "
+             "(ignored with -l)", "BOOLEAN", false, "false") {
   _dcmdparser.add_dcmd_option(&_locks);
   _dcmdparser.add_dcmd_option(&_extended);
+  _dcmdparser.add_dcmd_option(&_handshake);
 }
 
 void ThreadDumpDCmd::execute(DCmdSource source, TRAPS) {
   // thread stacks
-  VM_PrintThreads op1(output(), _locks.value(), _extended.value());
-  VMThread::execute(&op1);
+  if (_handshake.value() && !_locks.value()) {
+    Threads::print_on_with_handshakes(output(), _extended.value());
+  } else {
+    // Finding the owners of java.util.concurrent locks walks the heap,
+    // which needs a safepoint anyway.
+    VM_PrintThreads op1(output(), _locks.value(), _extended.value());
+    VMThread::execute(&op1);
+  }
 
   // JNI global handles
   VM_PrintJNI op2(output());
@@ -893,10 +952,16 @@ void CodeCacheDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_layout(output());
 }
 
+#ifdef LINUX
+void PerfMapDCmd::execute(DCmdSource source, TRAPS) {
+  PerfMap::write_perf_map(output());
+}
+#endif // LINUX
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 CodeHeapAnalyticsDCmd::CodeHeapAnalyticsDCmd(outputStream* output, bool heap) :
                                              DCmdWithParser(output, heap),
-  _function("function", "Function to be performed (aggregate, UsedSpace, FreeSpace, MethodCount, MethodSpace, MethodAge, MethodNames, discard", "STRING", false, "all"),
+  _function("function", "Function to be performed (aggregate, UsedSpace, FreeSpace, MethodCount, MethodSpace, MethodAge, MethodNames, discard, compact", "STRING", false, "all"),
   _granularity("granularity", "Detail level - smaller value -> more detail", "INT", false, "4096") {
   _dcmdparser.add_dcmd_argument(&_function);
   _dcmdparser.add_dcmd_argument(&_granularity);
@@ -964,6 +1029,70 @@ int EventLogDCmd::num_arguments() {
   }
 }
 
+SafepointProfileDCmd::SafepointProfileDCmd(outputStream* output, bool heap) :
+  DCmdWithParser(output, heap),
+  _reset("-reset", "Clear the profile after printing it", "BOOLEAN", false, "false")
+{
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void SafepointProfileDCmd::execute(DCmdSource source, TRAPS) {
+  if (!ProfileTimeToSafepoint) {
+    output()->print_cr("Time-to-safepoint profiling is not enabled, use -XX:+UnlockDiagnosticVMOptions -XX:+ProfileTimeToSafepoint.");
+    return;
+  }
+  SafepointProfiler::print_on(output());
+  if (_reset.value()) {
+    SafepointProfiler::reset();
+  }
+}
+
+int SafepointProfileDCmd::num_arguments() {
+  ResourceMark rm;
+  SafepointProfileDCmd* dcmd = new SafepointProfileDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+AllocationSitesDCmd::AllocationSitesDCmd(outputStream* output, bool heap) :
+  DCmdWithParser(output, heap),
+  _limit("-limit", "Maximum number of sites to print, 0 for all", "INT", false, "50"),
+  _reset("-reset", "Clear the profile after printing it", "BOOLEAN", false, "false")
+{
+  _dcmdparser.add_dcmd_option(&_limit);
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void AllocationSitesDCmd::execute(DCmdSource source, TRAPS) {
+  if (!ProfileAllocationSites) {
+    output()->print_cr("Allocation site profiling is not enabled, use -XX:+ProfileAllocationSites.");
+    return;
+  }
+  if (_limit.value() < 0) {
+    output()->print_cr("Invalid limit: " JLONG_FORMAT, _limit.value());
+    return;
+  }
+  AllocationSiteProfiler::print_on(output(), (int)MIN2(_limit.value(), (jlong)max_jint));
+  if (_reset.value()) {
+    AllocationSiteProfiler::reset();
+  }
+}
+
+int AllocationSitesDCmd::num_arguments() {
+  ResourceMark rm;
+  AllocationSitesDCmd* dcmd = new AllocationSitesDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 void CompilerDirectivesPrintDCmd::execute(DCmdSource source, TRAPS) {
   DirectivesStack::print(output());
 }
@@ -256,6 +256,23 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class VMLatenciesDCmd : public DCmd {
+public:
+  VMLatenciesDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() { return "VM.latencies"; }
+  static const char* description() {
+    return "Print percentiles of the durations of VM internal operations.";
+  }
+  static const char* impact() { return "Low"; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class SystemGCDCmd : public DCmd {
 public:
   SystemGCDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
@@ -331,6 +348,10 @@ protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
   DCmdArgument<jlong> _gzip;
+  DCmdArgument<bool>  _pipe;
+  DCmdArgument<MemorySizeArgument> _segment;
+  DCmdArgument<MemorySizeArgument> _truncate;
+  DCmdArgument<char*> _redact;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -425,6 +446,7 @@ class ThreadDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _locks;
   DCmdArgument<bool> _extended;
+  DCmdArgument<bool> _handshake;
 public:
   ThreadDumpDCmd(outputStream* output, bool heap);
   static const char* name() { return "Thread.print"; }
@@ -620,6 +642,29 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+#ifdef LINUX
+class PerfMapDCmd : public DCmd {
+public:
+  PerfMapDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() {
+    return "Compiler.perfmap";
+  }
+  static const char* description() {
+    return "Write map file for Linux perf tool.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+#endif // LINUX
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 class CodeHeapAnalyticsDCmd : public DCmdWithParser {
 protected:
@@ -635,7 +680,7 @@ public:
   }
   static const char* impact() {
     return "Low: Depends on code heap size and content. "
-           "Holds CodeCache_lock during analysis step, usually sub-second duration.";
+           "Holds CodeCache_lock during analysis step, releasing it periodically.";
   }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
@@ -891,4 +936,53 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class SafepointProfileDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _reset;
+public:
+  SafepointProfileDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "VM.safepoint_profile";
+  }
+  static const char* description() {
+    return "Print the methods where the threads slowest to reach a safepoint polled. "
+           "Requires -XX:+ProfileTimeToSafepoint.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class AllocationSitesDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _limit;
+  DCmdArgument<bool> _reset;
+public:
+  AllocationSitesDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "GC.allocation_sites";
+  }
+  static const char* description() {
+    return "Print the Java allocation sites sorted by the bytes they allocated. "
+           "Requires -XX:+ProfileAllocationSites.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 #endif // SHARE_SERVICES_DIAGNOSTICCOMMAND_HPP
@@ -41,6 +41,7 @@
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/javaCalls.hpp"
@@ -380,9 +381,9 @@ enum {
 };
 
 // Supports I/O operations for a dump
-
-class DumpWriter : public StackObj {
- private:
+// Base class for dump and parallel dump
+class AbstractDumpWriter : public CHeapObj<mtInternal> {
+ protected:
   enum {
     io_buffer_max_size = 1*M,
     io_buffer_max_waste = 10*K,
@@ -398,9 +399,7 @@ class DumpWriter : public StackObj {
   DEBUG_ONLY(size_t _sub_record_left;) // The bytes not written for the current sub-record.
   DEBUG_ONLY(bool _sub_record_ended;) // True if we have called the end_sub_record().
 
-  CompressionBackend _backend; // Does the actual writing.
-
-  void flush();
+  virtual void flush() = 0;
 
   char* buffer() const                          { return _buffer; }
   size_t buffer_size() const                    { return _size; }
@@ -414,15 +413,15 @@ class DumpWriter : public StackObj {
   bool can_write_fast(size_t len);
 
  public:
-  // Takes ownership of the writer and compressor.
-  DumpWriter(AbstractWriter* writer, AbstractCompressor* compressor);
-
-  ~DumpWriter();
+  AbstractDumpWriter() :
+    _buffer(NULL),
+    _size(0),
+    _pos(0),
+    _in_dump_segment(false) { }
 
   // total number of bytes written to the disk
-  julong bytes_written() const          { return (julong) _backend.get_written(); }
-
-  char const* error() const             { return _backend.error(); }
+  virtual julong bytes_written() const = 0;
+  virtual char const* error() const = 0;
 
   // writer functions
   void write_raw(void* s, size_t len);
@@ -440,29 +439,10 @@ class DumpWriter : public StackObj {
   // Ends the current sub-record.
   void end_sub_record();
   // Finishes the current dump segment if not already finished.
-  void finish_dump_segment();
-
-  // Called by threads used for parallel writing.
-  void writer_loop()                    { _backend.thread_loop(false); }
-  // Called when finished to release the threads.
-  void deactivate()                     { flush(); _backend.deactivate(); }
+  virtual void finish_dump_segment();
 };
 
-// Check for error after constructing the object and destroy it in case of an error.
-DumpWriter::DumpWriter(AbstractWriter* writer, AbstractCompressor* compressor) :
-  _buffer(NULL),
-  _size(0),
-  _pos(0),
-  _in_dump_segment(false),
-  _backend(writer, compressor, io_buffer_max_size, io_buffer_max_waste) {
-  flush();
-}
-
-DumpWriter::~DumpWriter() {
-  flush();
-}
-
-void DumpWriter::write_fast(void* s, size_t len) {
+void AbstractDumpWriter::write_fast(void* s, size_t len) {
   assert(!_in_dump_segment || (_sub_record_left >= len), "sub-record too large");
   assert(buffer_size() - position() >= len, "Must fit");
   debug_only(_sub_record_left -= len);
@@ -471,12 +451,12 @@ void DumpWriter::write_fast(void* s, size_t len) {
   set_position(position() + len);
 }
 
-bool DumpWriter::can_write_fast(size_t len) {
+bool AbstractDumpWriter::can_write_fast(size_t len) {
   return buffer_size() - position() >= len;
 }
 
 // write raw bytes
-void DumpWriter::write_raw(void* s, size_t len) {
+void AbstractDumpWriter::write_raw(void* s, size_t len) {
   assert(!_in_dump_segment || (_sub_record_left >= len), "sub-record too large");
   debug_only(_sub_record_left -= len);
 
@@ -497,38 +477,33 @@ void DumpWriter::write_raw(void* s, size_t len) {
   set_position(position() + len);
 }
 
-// flush any buffered bytes to the file
-void DumpWriter::flush() {
-  _backend.get_new_buffer(&_buffer, &_pos, &_size);
-}
-
 // Makes sure we inline the fast write into the write_u* functions. This is a big speedup.
 #define WRITE_KNOWN_TYPE(p, len) do { if (can_write_fast((len))) write_fast((p), (len)); \
                                       else write_raw((p), (len)); } while (0)
 
-void DumpWriter::write_u1(u1 x) {
+void AbstractDumpWriter::write_u1(u1 x) {
   WRITE_KNOWN_TYPE((void*) &x, 1);
 }
 
-void DumpWriter::write_u2(u2 x) {
+void AbstractDumpWriter::write_u2(u2 x) {
   u2 v;
   Bytes::put_Java_u2((address)&v, x);
   WRITE_KNOWN_TYPE((void*)&v, 2);
 }
 
-void DumpWriter::write_u4(u4 x) {
+void AbstractDumpWriter::write_u4(u4 x) {
   u4 v;
   Bytes::put_Java_u4((address)&v, x);
   WRITE_KNOWN_TYPE((void*)&v, 4);
 }
 
-void DumpWriter::write_u8(u8 x) {
+void AbstractDumpWriter::write_u8(u8 x) {
   u8 v;
   Bytes::put_Java_u8((address)&v, x);
   WRITE_KNOWN_TYPE((void*)&v, 8);
 }
 
-void DumpWriter::write_objectID(oop o) {
+void AbstractDumpWriter::write_objectID(oop o) {
   address a = cast_from_oop<address>(o);
 #ifdef _LP64
   write_u8((u8)a);
@@ -537,7 +512,7 @@ void DumpWriter::write_objectID(oop o) {
 #endif
 }
 
-void DumpWriter::write_symbolID(Symbol* s) {
+void AbstractDumpWriter::write_symbolID(Symbol* s) {
   address a = (address)((uintptr_t)s);
 #ifdef _LP64
   write_u8((u8)a);
@@ -546,7 +521,7 @@ void DumpWriter::write_symbolID(Symbol* s) {
 #endif
 }
 
-void DumpWriter::write_id(u4 x) {
+void AbstractDumpWriter::write_id(u4 x) {
 #ifdef _LP64
   write_u8((u8) x);
 #else
@@ -555,11 +530,11 @@ void DumpWriter::write_id(u4 x) {
 }
 
 // We use java mirror as the class ID
-void DumpWriter::write_classID(Klass* k) {
+void AbstractDumpWriter::write_classID(Klass* k) {
   write_objectID(k->java_mirror());
 }
 
-void DumpWriter::finish_dump_segment() {
+void AbstractDumpWriter::finish_dump_segment() {
   if (_in_dump_segment) {
     assert(_sub_record_left == 0, "Last sub-record not written completely");
     assert(_sub_record_ended, "sub-record must have ended");
@@ -577,7 +552,7 @@ void DumpWriter::finish_dump_segment() {
   }
 }
 
-void DumpWriter::start_sub_record(u1 tag, u4 len) {
+void AbstractDumpWriter::start_sub_record(u1 tag, u4 len) {
   if (!_in_dump_segment) {
     if (position() > 0) {
       flush();
@@ -607,20 +582,144 @@ void DumpWriter::start_sub_record(u1 tag, u4 len) {
   write_u1(tag);
 }
 
-void DumpWriter::end_sub_record() {
+void AbstractDumpWriter::end_sub_record() {
   assert(_in_dump_segment, "must be in dump segment");
   assert(_sub_record_left == 0, "sub-record not written completely");
   assert(!_sub_record_ended, "Must not have ended yet");
   debug_only(_sub_record_ended = true);
 }
 
+// Supports I/O operations for a dump, written through the CompressionBackend
+
+class DumpWriter : public AbstractDumpWriter {
+ private:
+  CompressionBackend _backend; // Does the actual writing.
+
+ protected:
+  virtual void flush();
+
+ public:
+  // Takes ownership of the writer and compressor.
+  DumpWriter(AbstractWriter* writer, AbstractCompressor* compressor);
+
+  ~DumpWriter();
+
+  // total number of bytes written to the disk
+  virtual julong bytes_written() const  { return (julong) _backend.get_written(); }
+
+  virtual char const* error() const     { return _backend.error(); }
+
+  // Returns true if the written data is compressed by the backend.
+  bool is_compressed() const            { return _backend.is_compressed(); }
+
+  // Called by threads used for parallel writing.
+  void writer_loop()                    { _backend.thread_loop(false); }
+  // Called when finished to release the threads.
+  void deactivate()                     { flush(); _backend.deactivate(); }
+};
+
+// Check for error after constructing the object and destroy it in case of an error.
+DumpWriter::DumpWriter(AbstractWriter* writer, AbstractCompressor* compressor) :
+  AbstractDumpWriter(),
+  _backend(writer, compressor, io_buffer_max_size, io_buffer_max_waste) {
+  flush();
+}
+
+DumpWriter::~DumpWriter() {
+  flush();
+}
+
+// flush any buffered bytes to the file
+void DumpWriter::flush() {
+  _backend.get_new_buffer(&_buffer, &_pos, &_size);
+}
+
+// Writer used by the threads dumping heap objects in parallel. Each
+// thread collects complete heap dump segments in a private buffer and
+// appends them to the shared DumpWriter while holding a lock, so the
+// segments of different threads never interleave in the dump file.
+// A huge sub-record spans several buffers, so the lock is then held
+// until its segment has been finished.
+class ParDumpWriter : public AbstractDumpWriter {
+ private:
+  DumpWriter* _global_writer;
+  Mutex*      _lock;
+  bool        _holds_lock;
+
+  void write_to_global_writer();
+
+ protected:
+  virtual void flush();
+
+ public:
+  ParDumpWriter(DumpWriter* global_writer, Mutex* lock);
+  ~ParDumpWriter();
+
+  // Returns false if the private buffer could not be allocated.
+  bool is_valid() const                 { return _buffer != NULL; }
+
+  virtual julong bytes_written() const  { return _global_writer->bytes_written(); }
+  virtual char const* error() const     { return _global_writer->error(); }
+
+  virtual void finish_dump_segment();
+};
+
+ParDumpWriter::ParDumpWriter(DumpWriter* global_writer, Mutex* lock) :
+  AbstractDumpWriter(),
+  _global_writer(global_writer),
+  _lock(lock),
+  _holds_lock(false) {
+  _buffer = (char*) os::malloc(io_buffer_max_size, mtInternal);
+  _size = (_buffer != NULL) ? io_buffer_max_size : 0;
+}
+
+ParDumpWriter::~ParDumpWriter() {
+  assert(!_in_dump_segment, "dump segment not finished");
+  assert(position() == 0, "buffered data not flushed");
+  assert(!_holds_lock, "lock not released");
+  os::free(_buffer);
+}
+
+void ParDumpWriter::write_to_global_writer() {
+  _global_writer->write_raw(buffer(), position());
+  set_position(0);
+}
+
+void ParDumpWriter::flush() {
+  if (position() == 0) {
+    return;
+  }
+
+  if (!_holds_lock && _in_dump_segment && _is_huge_sub_record) {
+    // Keep the lock until the rest of the huge sub-record has been written.
+    _lock->lock_without_safepoint_check();
+    _holds_lock = true;
+  }
+
+  if (_holds_lock) {
+    write_to_global_writer();
+  } else {
+    MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    write_to_global_writer();
+  }
+}
+
+void ParDumpWriter::finish_dump_segment() {
+  AbstractDumpWriter::finish_dump_segment();
+
+  if (_holds_lock) {
+    _holds_lock = false;
+    _lock->unlock();
+  }
+}
+
 // Support class with a collection of functions used when dumping the heap
 
 class DumperSupport : AllStatic {
  public:
 
   // write a header of the given type
-  static void write_header(DumpWriter* writer, hprofTag tag, u4 len);
+  static void write_header(AbstractDumpWriter* writer, hprofTag tag, u4 len);
 
   // returns hprof tag for the given type signature
   static hprofTag sig2tag(Symbol* sig);
@@ -633,42 +732,53 @@ class DumperSupport : AllStatic {
   static u4 instance_size(Klass* k);
 
   // dump a jfloat
-  static void dump_float(DumpWriter* writer, jfloat f);
+  static void dump_float(AbstractDumpWriter* writer, jfloat f);
   // dump a jdouble
-  static void dump_double(DumpWriter* writer, jdouble d);
+  static void dump_double(AbstractDumpWriter* writer, jdouble d);
   // dumps the raw value of the given field
-  static void dump_field_value(DumpWriter* writer, char type, oop obj, int offset);
+  static void dump_field_value(AbstractDumpWriter* writer, char type, oop obj, int offset);
   // returns the size of the static fields; also counts the static fields
   static u4 get_static_fields_size(InstanceKlass* ik, u2& field_count);
   // dumps static fields of the given class
-  static void dump_static_fields(DumpWriter* writer, Klass* k);
+  static void dump_static_fields(AbstractDumpWriter* writer, Klass* k);
   // dump the raw values of the instance fields of the given object
-  static void dump_instance_fields(DumpWriter* writer, oop o);
+  static void dump_instance_fields(AbstractDumpWriter* writer, oop o);
   // get the count of the instance fields for a given class
   static u2 get_instance_fields_count(InstanceKlass* ik);
   // dumps the definition of the instance fields for a given class
-  static void dump_instance_field_descriptors(DumpWriter* writer, Klass* k);
+  static void dump_instance_field_descriptors(AbstractDumpWriter* writer, Klass* k);
   // creates HPROF_GC_INSTANCE_DUMP record for the given object
-  static void dump_instance(DumpWriter* writer, oop o);
+  static void dump_instance(AbstractDumpWriter* writer, oop o);
   // creates HPROF_GC_CLASS_DUMP record for the given class and each of its
   // array classes
-  static void dump_class_and_array_classes(DumpWriter* writer, Klass* k);
+  static void dump_class_and_array_classes(AbstractDumpWriter* writer, Klass* k);
   // creates HPROF_GC_CLASS_DUMP record for a given primitive array
   // class (and each multi-dimensional array class too)
-  static void dump_basic_type_array_class(DumpWriter* writer, Klass* k);
+  static void dump_basic_type_array_class(AbstractDumpWriter* writer, Klass* k);
 
   // creates HPROF_GC_OBJ_ARRAY_DUMP record for the given object array
-  static void dump_object_array(DumpWriter* writer, objArrayOop array);
+  static void dump_object_array(AbstractDumpWriter* writer, objArrayOop array);
   // creates HPROF_GC_PRIM_ARRAY_DUMP record for the given type array
-  static void dump_prim_array(DumpWriter* writer, typeArrayOop array);
+  static void dump_prim_array(AbstractDumpWriter* writer, typeArrayOop array);
   // create HPROF_FRAME record for the given method and bci
-  static void dump_stack_frame(DumpWriter* writer, int frame_serial_num, int class_serial_num, Method* m, int bci);
+  static void dump_stack_frame(AbstractDumpWriter* writer, int frame_serial_num, int class_serial_num, Method* m, int bci);
 
   // check if we need to truncate an array
-  static int calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size);
+  static int calculate_array_max_length(AbstractDumpWriter* writer, arrayOop array, short header_size);
 
   // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
-  static void end_of_dump(DumpWriter* writer);
+  static void end_of_dump(AbstractDumpWriter* writer);
+
+  // Contents of primitive arrays beyond this many bytes are not dumped.
+  static size_t _prim_array_limit;
+  // Instances of these classes are dumped with all primitive fields zeroed.
+  static GrowableArray<Symbol*>* _redacted_classes;
+  // Number of primitive arrays which were truncated.
+  static volatile size_t _truncated_arrays;
+
+  static bool is_redacted(Klass* k) {
+    return _redacted_classes != NULL && _redacted_classes->contains(k->name());
+  }
 
   static oop mask_dormant_archived_object(oop o) {
     if (o != NULL && o->klass()->java_mirror() == NULL) {
@@ -681,8 +791,12 @@ class DumperSupport : AllStatic {
   }
 };
 
+size_t                 DumperSupport::_prim_array_limit = SIZE_MAX;
+GrowableArray<Symbol*>* DumperSupport::_redacted_classes = NULL;
+volatile size_t        DumperSupport::_truncated_arrays = 0;
+
 // write a header of the given type
-void DumperSupport:: write_header(DumpWriter* writer, hprofTag tag, u4 len) {
+void DumperSupport:: write_header(AbstractDumpWriter* writer, hprofTag tag, u4 len) {
   writer->write_u1((u1)tag);
   writer->write_u4(0);                  // current ticks
   writer->write_u4(len);
@@ -736,7 +850,7 @@ u4 DumperSupport::sig2size(Symbol* sig) {
 }
 
 // dump a jfloat
-void DumperSupport::dump_float(DumpWriter* writer, jfloat f) {
+void DumperSupport::dump_float(AbstractDumpWriter* writer, jfloat f) {
   if (g_isnan(f)) {
     writer->write_u4(0x7fc00000);    // collapsing NaNs
   } else {
@@ -750,7 +864,7 @@ void DumperSupport::dump_float(DumpWriter* writer, jfloat f) {
 }
 
 // dump a jdouble
-void DumperSupport::dump_double(DumpWriter* writer, jdouble d) {
+void DumperSupport::dump_double(AbstractDumpWriter* writer, jdouble d) {
   union {
     jlong l;
     double d;
@@ -765,7 +879,7 @@ void DumperSupport::dump_double(DumpWriter* writer, jdouble d) {
 }
 
 // dumps the raw value of the given field
-void DumperSupport::dump_field_value(DumpWriter* writer, char type, oop obj, int offset) {
+void DumperSupport::dump_field_value(AbstractDumpWriter* writer, char type, oop obj, int offset) {
   switch (type) {
     case JVM_SIGNATURE_CLASS :
     case JVM_SIGNATURE_ARRAY : {
@@ -883,7 +997,7 @@ u4 DumperSupport::get_static_fields_size(InstanceKlass* ik, u2& field_count) {
 }
 
 // dumps static fields of the given class
-void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+void DumperSupport::dump_static_fields(AbstractDumpWriter* writer, Klass* k) {
   InstanceKlass* ik = InstanceKlass::cast(k);
 
   // dump the field descriptors and raw values
@@ -926,13 +1040,22 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
 }
 
 // dump the raw values of the instance fields of the given object
-void DumperSupport::dump_instance_fields(DumpWriter* writer, oop o) {
+void DumperSupport::dump_instance_fields(AbstractDumpWriter* writer, oop o) {
   InstanceKlass* ik = InstanceKlass::cast(o->klass());
+  bool redacted = is_redacted(ik);
 
   for (FieldStream fld(ik, false, false); !fld.eos(); fld.next()) {
     if (!fld.access_flags().is_static()) {
       Symbol* sig = fld.signature();
-      dump_field_value(writer, sig->char_at(0), o, fld.offset());
+      char type = sig->char_at(0);
+      if (redacted && type != JVM_SIGNATURE_CLASS && type != JVM_SIGNATURE_ARRAY) {
+        // keep the references so that the object graph stays intact
+        for (u4 i = 0; i < sig2size(sig); i++) {
+          writer->write_u1(0);
+        }
+      } else {
+        dump_field_value(writer, type, o, fld.offset());
+      }
     }
   }
 }
@@ -949,7 +1072,7 @@ u2 DumperSupport::get_instance_fields_count(InstanceKlass* ik) {
 }
 
 // dumps the definition of the instance fields for a given class
-void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k) {
+void DumperSupport::dump_instance_field_descriptors(AbstractDumpWriter* writer, Klass* k) {
   InstanceKlass* ik = InstanceKlass::cast(k);
 
   // dump the field descriptors
@@ -964,7 +1087,7 @@ void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k
 }
 
 // creates HPROF_GC_INSTANCE_DUMP record for the given object
-void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
+void DumperSupport::dump_instance(AbstractDumpWriter* writer, oop o) {
   InstanceKlass* ik = InstanceKlass::cast(o->klass());
   u4 is = instance_size(ik);
   u4 size = 1 + sizeof(address) + 4 + sizeof(address) + 4 + is;
@@ -987,7 +1110,7 @@ void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
 
 // creates HPROF_GC_CLASS_DUMP record for the given class and each of
 // its array classes
-void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
+void DumperSupport::dump_class_and_array_classes(AbstractDumpWriter* writer, Klass* k) {
   InstanceKlass* ik = InstanceKlass::cast(k);
 
   // We can safepoint and do a heap dump at a point where we have a Klass,
@@ -1076,7 +1199,7 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
 
 // creates HPROF_GC_CLASS_DUMP record for a given primitive array
 // class (and each multi-dimensional array class too)
-void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
+void DumperSupport::dump_basic_type_array_class(AbstractDumpWriter* writer, Klass* k) {
  // array classes
  while (k != NULL) {
     Klass* klass = k;
@@ -1111,7 +1234,7 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
 
 // Hprof uses an u4 as record length field,
 // which means we need to truncate arrays that are too long.
-int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size) {
+int DumperSupport::calculate_array_max_length(AbstractDumpWriter* writer, arrayOop array, short header_size) {
   BasicType type = ArrayKlass::cast(array->klass())->element_type();
   assert(type >= T_BOOLEAN && type <= T_OBJECT, "invalid array element type");
 
@@ -1138,7 +1261,7 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
 }
 
 // creates HPROF_GC_OBJ_ARRAY_DUMP record for the given object array
-void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
+void DumperSupport::dump_object_array(AbstractDumpWriter* writer, objArrayOop array) {
   // sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID) + sizeof(classID)
   short header_size = 1 + 2 * 4 + 2 * sizeof(address);
   int length = calculate_array_max_length(writer, array, header_size);
@@ -1172,7 +1295,7 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
   for (int i = 0; i < Length; i++) { writer->write_##Size((Size)Array->Type##_at(i)); }
 
 // creates HPROF_GC_PRIM_ARRAY_DUMP record for the given type array
-void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
+void DumperSupport::dump_prim_array(AbstractDumpWriter* writer, typeArrayOop array) {
   BasicType type = TypeArrayKlass::cast(array->klass())->element_type();
 
   // 2 * sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID)
@@ -1180,6 +1303,10 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
 
   int length = calculate_array_max_length(writer, array, header_size);
   int type_size = type2aelembytes(type);
+  if ((size_t)length * type_size > _prim_array_limit) {
+    length = (int)(_prim_array_limit / type_size);
+    Atomic::inc(&_truncated_arrays);
+  }
   u4 length_in_bytes = (u4)length * type_size;
   u4 size = header_size + length_in_bytes;
 
@@ -1266,7 +1393,7 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
 }
 
 // create a HPROF_FRAME record of the given Method* and bci
-void DumperSupport::dump_stack_frame(DumpWriter* writer,
+void DumperSupport::dump_stack_frame(AbstractDumpWriter* writer,
                                      int frame_serial_num,
                                      int class_serial_num,
                                      Method* m,
@@ -1295,10 +1422,10 @@ void DumperSupport::dump_stack_frame(DumpWriter* writer,
 
 class SymbolTableDumper : public SymbolClosure {
  private:
-  DumpWriter* _writer;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* _writer;
+  AbstractDumpWriter* writer() const        { return _writer; }
  public:
-  SymbolTableDumper(DumpWriter* writer)     { _writer = writer; }
+  SymbolTableDumper(AbstractDumpWriter* writer) { _writer = writer; }
   void do_symbol(Symbol** p);
 };
 
@@ -1318,12 +1445,12 @@ void SymbolTableDumper::do_symbol(Symbol** p) {
 
 class JNILocalsDumper : public OopClosure {
  private:
-  DumpWriter* _writer;
+  AbstractDumpWriter* _writer;
   u4 _thread_serial_num;
   int _frame_num;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* writer() const        { return _writer; }
  public:
-  JNILocalsDumper(DumpWriter* writer, u4 thread_serial_num) {
+  JNILocalsDumper(AbstractDumpWriter* writer, u4 thread_serial_num) {
     _writer = writer;
     _thread_serial_num = thread_serial_num;
     _frame_num = -1;  // default - empty stack
@@ -1352,11 +1479,11 @@ void JNILocalsDumper::do_oop(oop* obj_p) {
 
 class JNIGlobalsDumper : public OopClosure {
  private:
-  DumpWriter* _writer;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* _writer;
+  AbstractDumpWriter* writer() const        { return _writer; }
 
  public:
-  JNIGlobalsDumper(DumpWriter* writer) {
+  JNIGlobalsDumper(AbstractDumpWriter* writer) {
     _writer = writer;
   }
   void do_oop(oop* obj_p);
@@ -1384,10 +1511,10 @@ void JNIGlobalsDumper::do_oop(oop* obj_p) {
 
 class MonitorUsedDumper : public OopClosure {
  private:
-  DumpWriter* _writer;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* _writer;
+  AbstractDumpWriter* writer() const        { return _writer; }
  public:
-  MonitorUsedDumper(DumpWriter* writer) {
+  MonitorUsedDumper(AbstractDumpWriter* writer) {
     _writer = writer;
   }
   void do_oop(oop* obj_p) {
@@ -1404,10 +1531,10 @@ class MonitorUsedDumper : public OopClosure {
 
 class StickyClassDumper : public KlassClosure {
  private:
-  DumpWriter* _writer;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* _writer;
+  AbstractDumpWriter* writer() const        { return _writer; }
  public:
-  StickyClassDumper(DumpWriter* writer) {
+  StickyClassDumper(AbstractDumpWriter* writer) {
     _writer = writer;
   }
   void do_klass(Klass* k) {
@@ -1429,13 +1556,13 @@ class VM_HeapDumper;
 class HeapObjectDumper : public ObjectClosure {
  private:
   VM_HeapDumper* _dumper;
-  DumpWriter* _writer;
+  AbstractDumpWriter* _writer;
 
   VM_HeapDumper* dumper()               { return _dumper; }
-  DumpWriter* writer()                  { return _writer; }
+  AbstractDumpWriter* writer()          { return _writer; }
 
  public:
-  HeapObjectDumper(VM_HeapDumper* dumper, DumpWriter* writer) {
+  HeapObjectDumper(VM_HeapDumper* dumper, AbstractDumpWriter* writer) {
     _dumper = dumper;
     _writer = writer;
   }
@@ -1469,6 +1596,60 @@ void HeapObjectDumper::do_object(oop o) {
   }
 }
 
+// Coordinates the VM thread and the worker threads dumping the heap objects
+// in parallel. The workers wait until the VM thread has written the records
+// preceding the objects, and the VM thread waits until all workers are done
+// before it writes the remaining records.
+class DumperController : public CHeapObj<mtInternal> {
+ private:
+  bool     _started;
+  Monitor* _lock;
+  uint     _dumper_number;
+  uint     _complete_number;
+
+ public:
+  DumperController(uint number) :
+    _started(false),
+    _lock(new (std::nothrow) PaddedMonitor(Mutex::leaf, "Dumper Controller lock",
+                                           true, Mutex::_safepoint_check_never)),
+    _dumper_number(number),
+    _complete_number(0) { }
+
+  ~DumperController() { delete _lock; }
+
+  bool is_valid() const { return _lock != NULL; }
+
+  void wait_for_start_signal() {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    while (!_started) {
+      ml.wait();
+    }
+  }
+
+  void start_dump() {
+    assert(!_started, "start dump with started dumper controller");
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    _started = true;
+    ml.notify_all();
+  }
+
+  void dumper_complete() {
+    assert(_started, "dumper exit with non-started dumper controller");
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    _complete_number++;
+    ml.notify();
+  }
+
+  void wait_all_dumpers_complete() {
+    assert(_started, "wrong dumper controller state");
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    while (_complete_number != _dumper_number) {
+      ml.wait();
+    }
+    _started = false;
+  }
+};
+
 // The VM operation that performs the heap dump
 class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
  private:
@@ -1482,6 +1663,18 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
   ThreadStackTrace** _stack_traces;
   int _num_threads;
 
+  // Parallel dumping of the heap objects, set up by prepare_parallel_dump().
+  uint _num_dumper_threads;
+  ParallelObjectIterator* _poi;
+  DumperController* _dumper_controller;
+  Mutex* _par_writer_lock;
+  ParDumpWriter** _par_writers;
+
+  // Redaction, see HeapDumper::set_prim_array_limit() and set_redacted_classes().
+  size_t _prim_array_limit;
+  GrowableArray<Symbol*>* _redacted_classes;
+  size_t _truncated_arrays;
+
   // accessors and setters
   static VM_HeapDumper* dumper()         {  assert(_global_dumper != NULL, "Error"); return _global_dumper; }
   static DumpWriter* writer()            {  assert(_global_writer != NULL, "Error"); return _global_writer; }
@@ -1521,6 +1714,16 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
   // HPROF_TRACE and HPROF_FRAME records
   void dump_stack_traces();
 
+  // Sets up the parallel dumping of the heap objects by the GC workers.
+  // Returns false if the heap objects have to be dumped serially.
+  bool prepare_parallel_dump(WorkGang* gang);
+  void cleanup_parallel_dump();
+  bool is_parallel_dump() const { return _num_dumper_threads > 0; }
+
+  // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP and HPROF_GC_PRIM_ARRAY_DUMP
+  // records for the part of the heap claimed by the given worker.
+  void dump_objects_in_parallel(uint worker_id);
+
  public:
   VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
@@ -1533,6 +1736,14 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
     _klass_map = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, mtServiceability);
     _stack_traces = NULL;
     _num_threads = 0;
+    _num_dumper_threads = 0;
+    _poi = NULL;
+    _dumper_controller = NULL;
+    _par_writer_lock = NULL;
+    _par_writers = NULL;
+    _prim_array_limit = SIZE_MAX;
+    _redacted_classes = NULL;
+    _truncated_arrays = 0;
     if (oome) {
       assert(!Thread::current()->is_VM_thread(), "Dump from OutOfMemoryError cannot be called by the VMThread");
       // get OutOfMemoryError zero-parameter constructor
@@ -1556,6 +1767,12 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
     delete _klass_map;
   }
 
+  void set_redaction(size_t prim_array_limit, GrowableArray<Symbol*>* redacted_classes) {
+    _prim_array_limit = prim_array_limit;
+    _redacted_classes = redacted_classes;
+  }
+  size_t truncated_arrays() const { return _truncated_arrays; }
+
   VMOp_Type type() const { return VMOp_HeapDumper; }
   void doit();
   void work(uint worker_id);
@@ -1570,7 +1787,7 @@ bool VM_HeapDumper::skip_operation() const {
 }
 
 // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
-void DumperSupport::end_of_dump(DumpWriter* writer) {
+void DumperSupport::end_of_dump(AbstractDumpWriter* writer) {
   writer->finish_dump_segment();
 
   writer->write_u1(HPROF_HEAP_DUMP_END);
@@ -1788,22 +2005,114 @@ void VM_HeapDumper::doit() {
   // the following should be safe.
   set_global_dumper();
   set_global_writer();
+  DumperSupport::_prim_array_limit = _prim_array_limit;
+  DumperSupport::_redacted_classes = _redacted_classes;
+  DumperSupport::_truncated_arrays = 0;
 
   WorkGang* gang = ch->safepoint_workers();
 
   if (gang == NULL) {
     work(0);
   } else {
+    prepare_parallel_dump(gang);
     gang->run_task(this, gang->active_workers(), true);
+    cleanup_parallel_dump();
   }
 
   // Now we clear the global variables, so that a future dumper can run.
+  _truncated_arrays = DumperSupport::_truncated_arrays;
+  DumperSupport::_prim_array_limit = SIZE_MAX;
+  DumperSupport::_redacted_classes = NULL;
   clear_global_dumper();
   clear_global_writer();
 }
 
+bool VM_HeapDumper::prepare_parallel_dump(WorkGang* gang) {
+  assert(!is_parallel_dump(), "already prepared");
+
+  uint num_workers = gang->active_workers();
+  if (num_workers < 2) {
+    return false;
+  }
+
+  // Without compression the remaining workers only have to do the file
+  // writes, so most of them can dump objects. Otherwise keep half of the
+  // workers for the compression.
+  uint num_dumpers = writer()->is_compressed() ? num_workers / 2 : num_workers - 1;
+
+  _poi = Universe::heap()->parallel_object_iterator(num_dumpers);
+  if (_poi == NULL) {
+    // The GC does not support parallel object iteration.
+    return false;
+  }
+
+  _dumper_controller = new (std::nothrow) DumperController(num_dumpers);
+  _par_writer_lock = new (std::nothrow) PaddedMutex(Mutex::leaf + 1, "Parallel HProf writer lock",
+                                                    true, Mutex::_safepoint_check_never);
+  _par_writers = NEW_C_HEAP_ARRAY_RETURN_NULL(ParDumpWriter*, num_dumpers, mtInternal);
+
+  bool success = (_dumper_controller != NULL) && _dumper_controller->is_valid() &&
+                 (_par_writer_lock != NULL) && (_par_writers != NULL);
+  for (uint i = 0; i < num_dumpers; i++) {
+    ParDumpWriter* par_writer = NULL;
+    if (success) {
+      par_writer = new (std::nothrow) ParDumpWriter(writer(), _par_writer_lock);
+      success = (par_writer != NULL) && par_writer->is_valid();
+    }
+    if (_par_writers != NULL) {
+      _par_writers[i] = par_writer;
+    }
+  }
+
+  _num_dumper_threads = num_dumpers;
+  if (!success) {
+    // Not enough memory for parallel dumping, fall back to the serial dump.
+    cleanup_parallel_dump();
+    return false;
+  }
+
+  log_debug(heapdump)("Dumping heap objects with %u of %u workers", num_dumpers, num_workers);
+  return true;
+}
+
+void VM_HeapDumper::cleanup_parallel_dump() {
+  if (_par_writers != NULL) {
+    for (uint i = 0; i < _num_dumper_threads; i++) {
+      delete _par_writers[i];
+    }
+    FREE_C_HEAP_ARRAY(ParDumpWriter*, _par_writers);
+    _par_writers = NULL;
+  }
+  delete _par_writer_lock;
+  _par_writer_lock = NULL;
+  delete _dumper_controller;
+  _dumper_controller = NULL;
+  delete _poi;
+  _poi = NULL;
+  _num_dumper_threads = 0;
+}
+
+void VM_HeapDumper::dump_objects_in_parallel(uint worker_id) {
+  assert(worker_id < _num_dumper_threads, "not a dumper thread");
+  ParDumpWriter* par_writer = _par_writers[worker_id];
+
+  _dumper_controller->wait_for_start_signal();
+
+  HeapObjectDumper obj_dumper(this, par_writer);
+  _poi->object_iterate(&obj_dumper, worker_id);
+
+  // Append the last segment of this worker to the dump.
+  par_writer->finish_dump_segment();
+
+  _dumper_controller->dumper_complete();
+}
+
 void VM_HeapDumper::work(uint worker_id) {
   if (!Thread::current()->is_VM_thread()) {
+    if (worker_id < _num_dumper_threads) {
+      dump_objects_in_parallel(worker_id);
+    }
+    // Help with the compression and writing until the dump is done.
     writer()->writer_loop();
     return;
   }
@@ -1846,8 +2155,16 @@ void VM_HeapDumper::work(uint worker_id) {
   // segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(this, writer());
-  Universe::heap()->object_iterate(&obj_dumper);
+  if (is_parallel_dump()) {
+    // The dumper threads append complete segments, so the current segment
+    // has to be finished before they start.
+    writer()->finish_dump_segment();
+    _dumper_controller->start_dump();
+    _dumper_controller->wait_all_dumpers_complete();
+  } else {
+    HeapObjectDumper obj_dumper(this, writer());
+    Universe::heap()->object_iterate(&obj_dumper);
+  }
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
@@ -1932,7 +2249,8 @@ void VM_HeapDumper::dump_stack_traces() {
 }
 
 // dump the heap to given path.
-int HeapDumper::dump(const char* path, outputStream* out, int compression) {
+int HeapDumper::dump(const char* path, outputStream* out, int compression,
+                     bool to_pipe, size_t segment_size) {
   assert(path != NULL && strlen(path) > 0, "path missing");
 
   // print message in interactive case
@@ -1955,7 +2273,16 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression) {
     }
   }
 
-  DumpWriter writer(new (std::nothrow) FileWriter(path), compressor);
+  AbstractWriter* file_writer;
+  if (to_pipe) {
+    file_writer = new (std::nothrow) PipeWriter(path);
+  } else if (segment_size > 0) {
+    file_writer = new (std::nothrow) SegmentedFileWriter(path, segment_size);
+  } else {
+    file_writer = new (std::nothrow) FileWriter(path);
+  }
+
+  DumpWriter writer(file_writer, compressor);
 
   if (writer.error() != NULL) {
     set_error(writer.error());
@@ -1966,8 +2293,29 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression) {
     return -1;
   }
 
+  // resolve the classes to redact; classes that are not loaded have no instances
+  GrowableArray<Symbol*>* redacted = NULL;
+  if (_redacted_classes != NULL && _redacted_classes[0] != '\0') {
+    redacted = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<Symbol*>(4, mtServiceability);
+    char* list = os::strdup_check_oom(_redacted_classes, mtServiceability);
+    char* save = NULL;
+    for (char* name = strtok_r(list, ",", &save); name != NULL; name = strtok_r(NULL, ",", &save)) {
+      for (char* p = name; *p != '\0'; p++) {
+        if (*p == '.') {
+          *p = '/';
+        }
+      }
+      Symbol* sym = SymbolTable::probe(name, (int)strlen(name));
+      if (sym != NULL) {
+        redacted->append(sym);
+      }
+    }
+    os::free(list);
+  }
+
   // generate the dump
   VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome);
+  dumper.set_redaction(_prim_array_limit, redacted);
   if (Thread::current()->is_VM_thread()) {
     assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
     dumper.doit();
@@ -1975,6 +2323,13 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression) {
     VMThread::execute(&dumper);
   }
 
+  if (redacted != NULL) {
+    for (int i = 0; i < redacted->length(); i++) {
+      redacted->at(i)->decrement_refcount();
+    }
+    delete redacted;
+  }
+
   // record any error that the writer may have encountered
   set_error(writer.error());
 
@@ -1993,6 +2348,10 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression) {
     if (error() == NULL) {
       out->print_cr("Heap dump file created [" JULONG_FORMAT " bytes in %3.3f secs]",
                     writer.bytes_written(), timer()->seconds());
+      if (dumper.truncated_arrays() > 0) {
+        out->print_cr("Truncated " SIZE_FORMAT " primitive arrays to " SIZE_FORMAT " bytes",
+                      dumper.truncated_arrays(), _prim_array_limit);
+      }
     } else {
       out->print_cr("Dump file is incomplete: %s", writer.error());
     }
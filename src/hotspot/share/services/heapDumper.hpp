@@ -48,10 +48,13 @@ class HeapDumper : public StackObj {
   char* _error;
   bool _gc_before_heap_dump;
   bool _oome;
+  size_t _prim_array_limit;
+  const char* _redacted_classes;
   elapsedTimer _t;
 
   HeapDumper(bool gc_before_heap_dump, bool oome) :
-    _error(NULL), _gc_before_heap_dump(gc_before_heap_dump), _oome(oome) { }
+    _error(NULL), _gc_before_heap_dump(gc_before_heap_dump), _oome(oome),
+    _prim_array_limit(SIZE_MAX), _redacted_classes(NULL) { }
 
   // string representation of error
   char* error() const                   { return _error; }
@@ -64,14 +67,24 @@ class HeapDumper : public StackObj {
 
  public:
   HeapDumper(bool gc_before_heap_dump) :
-    _error(NULL), _gc_before_heap_dump(gc_before_heap_dump), _oome(false) { }
+    _error(NULL), _gc_before_heap_dump(gc_before_heap_dump), _oome(false),
+    _prim_array_limit(SIZE_MAX), _redacted_classes(NULL) { }
 
   ~HeapDumper();
 
+  // primitive arrays whose contents exceed limit bytes are truncated to that size.
+  void set_prim_array_limit(size_t limit)         { _prim_array_limit = limit; }
+  // comma-separated list of class names whose instances are dumped with all
+  // primitive fields zeroed; reference fields are kept so the graph is intact.
+  void set_redacted_classes(const char* classes)  { _redacted_classes = classes; }
+
   // dumps the heap to the specified file, returns 0 if success.
   // additional info is written to out if not NULL.
   // compression >= 0 creates a gzipped file with the given compression level.
-  int dump(const char* path, outputStream* out = NULL, int compression = -1);
+  // to_pipe writes the dump to the existing named pipe path instead of a new file.
+  // segment_size > 0 splits the dump into files <path>.<n> of about that size.
+  int dump(const char* path, outputStream* out = NULL, int compression = -1,
+           bool to_pipe = false, size_t segment_size = 0);
 
   // returns error message (resource allocated), or NULL if no error
   char* error_as_C_string() const;
@@ -54,15 +54,84 @@ char const* FileWriter::write_buf(char* buf, ssize_t size) {
   assert(_fd >= 0, "Must be open");
   assert(size > 0, "Must write at least one byte");
 
-  ssize_t n = (ssize_t) os::write(_fd, buf, (uint) size);
+  return write_fully(_fd, buf, size);
+}
+
+char const* FileWriter::write_fully(int fd, char* buf, ssize_t size) {
+  while (size > 0) {
+    ssize_t n = (ssize_t) os::write(fd, buf, (uint) size);
+
+    if (n <= 0) {
+      return os::strerror(errno);
+    }
+
+    buf += n;
+    size -= n;
+  }
+
+  return NULL;
+}
+
+char const* PipeWriter::open_writer() {
+  assert(_fd < 0, "Must not already be open");
 
-  if (n <= 0) {
+  // Blocks until the pipe has a reader.
+  _fd = os::open(_path, O_WRONLY, 0);
+
+  if (_fd < 0) {
     return os::strerror(errno);
   }
 
   return NULL;
 }
 
+char const* SegmentedFileWriter::open_segment() {
+  assert(_fd < 0, "Must not already be open");
+
+  size_t len = strlen(_path) + 16;
+  char* path = NEW_C_HEAP_ARRAY(char, len, mtInternal);
+  jio_snprintf(path, len, "%s.%d", _path, _segment);
+  _fd = os::create_binary_file(path, false);    // don't replace existing file
+  FREE_C_HEAP_ARRAY(char, path);
+
+  if (_fd < 0) {
+    return os::strerror(errno);
+  }
+
+  _segment++;
+  _segment_written = 0;
+  return NULL;
+}
+
+char const* SegmentedFileWriter::open_writer() {
+  return open_segment();
+}
+
+SegmentedFileWriter::~SegmentedFileWriter() {
+  if (_fd >= 0) {
+    os::close(_fd);
+    _fd = -1;
+  }
+}
+
+char const* SegmentedFileWriter::write_buf(char* buf, ssize_t size) {
+  assert(_fd >= 0, "Must be open");
+  assert(size > 0, "Must write at least one byte");
+
+  if (_segment_written > 0 && _segment_written + size > _segment_size) {
+    os::close(_fd);
+    _fd = -1;
+    char const* msg = open_segment();
+
+    if (msg != NULL) {
+      return msg;
+    }
+  }
+
+  _segment_written += size;
+  return FileWriter::write_fully(_fd, buf, size);
+}
+
 
 typedef char const* (*GzipInitFunc)(size_t, size_t*, size_t*, int);
 typedef size_t(*GzipCompressFunc)(char*, size_t, char*, size_t, char*, size_t,
@@ -59,7 +59,7 @@ public:
 
 // A writer for a file.
 class FileWriter : public AbstractWriter {
-private:
+protected:
   char const* _path;
   int _fd;
 
@@ -73,10 +73,54 @@ public:
 
   // Does the write. Returns NULL on success and a static error message otherwise.
   virtual char const* write_buf(char* buf, ssize_t size);
+
+  // Writes all of buf to fd, even if the fd takes only part of it at a time
+  // (e.g. a pipe). Returns NULL on success and a static error message otherwise.
+  static char const* write_fully(int fd, char* buf, ssize_t size);
+};
+
+
+// A writer for an existing named pipe, e.g. one read by an agent which uploads
+// the dump. Writes block while the reader does not keep up.
+class PipeWriter : public FileWriter {
+public:
+  PipeWriter(char const* path) : FileWriter(path) { }
+
+  // Opens the writer. Returns NULL on success and a static error message otherwise.
+  virtual char const* open_writer();
+};
+
+
+// A writer splitting the dump into files <path>.0, <path>.1, ... of about
+// segment_size bytes, which can be uploaded in parallel. A write is never split
+// across files, so with compression every file consists of complete gzip members.
+class SegmentedFileWriter : public AbstractWriter {
+private:
+  char const* _path;
+  size_t _segment_size;
+  int _fd;
+  int _segment;
+  size_t _segment_written;
+
+  char const* open_segment();
+
+public:
+  SegmentedFileWriter(char const* path, size_t segment_size) :
+    _path(path), _segment_size(segment_size), _fd(-1), _segment(0), _segment_written(0) { }
+
+  ~SegmentedFileWriter();
+
+  // Opens the writer. Returns NULL on success and a static error message otherwise.
+  virtual char const* open_writer();
+
+  // Does the write. Returns NULL on success and a static error message otherwise.
+  virtual char const* write_buf(char* buf, ssize_t size);
 };
 
 
-// A compressor using the gzip format.
+// A compressor using the gzip format. Every block becomes a gzip member of
+// its own which records its compressed size, so the dump can be inflated in
+// parallel (see ZIP_GUnzip_Parallel in libzip).
 class GZipCompressor : public AbstractCompressor {
 private:
   int _level;
@@ -218,6 +262,9 @@ public:
 
   char const* error() const { return _err; }
 
+  // Returns true if the data is compressed before it is written.
+  bool is_compressed() const { return _compressor != NULL; }
+
   // Commits the old buffer (using the value in *used) and sets up a new one.
   void get_new_buffer(char** buffer, size_t* used, size_t* max);
 
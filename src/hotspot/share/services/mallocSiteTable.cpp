@@ -27,6 +27,7 @@
 #include "memory/allocation.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "services/mallocSiteTable.hpp"
+#include "services/memTracker.hpp"
 
 // Malloc site hashtable buckets
 MallocSiteHashtableEntry*  MallocSiteTable::_table[MallocSiteTable::table_size];
@@ -174,8 +175,11 @@ MallocSite* MallocSiteTable::malloc_site(size_t bucket_idx, size_t pos_idx) {
 // (pre-installed allocation site) has to be used to avoid infinite
 // recursion.
 MallocSiteHashtableEntry* MallocSiteTable::new_entry(const NativeCallStack& key, MEMFLAGS flags) {
+  // Sample this call like any other malloc, so that its site is scaled correctly.
+  const NativeCallStack& stack = MemTracker::sample_malloc_stack() ?
+    *hash_entry_allocation_stack() : NativeCallStack::empty_stack();
   void* p = AllocateHeap(sizeof(MallocSiteHashtableEntry), mtNMT,
-    *hash_entry_allocation_stack(), AllocFailStrategy::RETURN_NULL);
+    stack, AllocFailStrategy::RETURN_NULL);
   return ::new (p) MallocSiteHashtableEntry(key, flags);
 }
 
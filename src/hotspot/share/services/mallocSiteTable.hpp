@@ -47,8 +47,9 @@ class MallocSite : public AllocationSite<MemoryCounter> {
     AllocationSite<MemoryCounter>(stack, flags) {}
 
 
-  void allocate(size_t size)      { data()->allocate(size);   }
-  void deallocate(size_t size)    { data()->deallocate(size); }
+  // A call recorded with weight n stands for n calls of the same size.
+  void allocate(size_t size, size_t weight)   { data()->allocate(size * weight, weight);   }
+  void deallocate(size_t size, size_t weight) { data()->deallocate(size * weight, weight); }
 
   // Memory allocated from this code path
   size_t size()  const { return peek()->size(); }
@@ -193,33 +194,34 @@ class MallocSiteTable : AllStatic {
   }
 
   // Record a new allocation from specified call path.
+  // The allocation is counted weight times, see MemTracker::sample_malloc_stack().
   // Return true if the allocation is recorded successfully, bucket_idx
   // and pos_idx are also updated to indicate the entry where the allocation
   // information was recorded.
   // Return false only occurs under rare scenarios:
   //  1. out of memory
   //  2. overflow hash bucket
-  static inline bool allocation_at(const NativeCallStack& stack, size_t size,
+  static inline bool allocation_at(const NativeCallStack& stack, size_t size, size_t weight,
     size_t* bucket_idx, size_t* pos_idx, MEMFLAGS flags) {
     AccessLock locker(&_access_count);
     if (locker.sharedLock()) {
       NOT_PRODUCT(_peak_count = MAX2(_peak_count, _access_count);)
       MallocSite* site = lookup_or_add(stack, bucket_idx, pos_idx, flags);
-      if (site != NULL) site->allocate(size);
+      if (site != NULL) site->allocate(size, weight);
       return site != NULL;
     }
     return false;
   }
 
   // Record memory deallocation. bucket_idx and pos_idx indicate where the allocation
-  // information was recorded.
-  static inline bool deallocation_at(size_t size, size_t bucket_idx, size_t pos_idx) {
+  // information was recorded, weight must be the one it was recorded with.
+  static inline bool deallocation_at(size_t size, size_t weight, size_t bucket_idx, size_t pos_idx) {
     AccessLock locker(&_access_count);
     if (locker.sharedLock()) {
       NOT_PRODUCT(_peak_count = MAX2(_peak_count, _access_count);)
       MallocSite* site = malloc_site(bucket_idx, pos_idx);
       if (site != NULL) {
-        site->deallocate(size);
+        site->deallocate(size, weight);
         return true;
       }
     }
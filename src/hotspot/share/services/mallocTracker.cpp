@@ -23,11 +23,15 @@
  */
 #include "precompiled.hpp"
 
+#include "runtime/thread.hpp"
 #include "services/mallocSiteTable.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/mallocTracker.inline.hpp"
 #include "services/memTracker.hpp"
 
+volatile size_t MallocTracker::_exited_threads_malloced_bytes = 0;
+volatile size_t MallocTracker::_exited_threads_freed_bytes = 0;
+
 size_t MallocMemorySummary::_snapshot[CALC_OBJ_SIZE_IN_TYPE(MallocMemorySnapshot, size_t)];
 
 // Total malloc'd memory amount
@@ -70,14 +74,20 @@ void MallocHeader::release() const {
 
   MallocMemorySummary::record_free(size(), flags());
   MallocMemorySummary::record_free_malloc_header(sizeof(MallocHeader));
-  if (MemTracker::tracking_level() == NMT_detail) {
-    MallocSiteTable::deallocation_at(size(), _bucket_idx, _pos_idx);
+  if (NativeMemoryTrackingPerThread) {
+    Thread* thread = Thread::current_or_null();
+    if (thread != NULL) {
+      thread->incr_nmt_freed_bytes(size());
+    }
+  }
+  if (MemTracker::tracking_level() == NMT_detail && has_malloc_site()) {
+    MallocSiteTable::deallocation_at(size(), site_weight(), _bucket_idx, _pos_idx);
   }
 }
 
 bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
   size_t* bucket_idx, size_t* pos_idx, MEMFLAGS flags) const {
-  bool ret = MallocSiteTable::allocation_at(stack, size, bucket_idx, pos_idx, flags);
+  bool ret = MallocSiteTable::allocation_at(stack, size, site_weight(), bucket_idx, pos_idx, flags);
 
   // Something went wrong, could be OOM or overflow malloc site table.
   // We want to keep tracking data under OOM circumstance, so transition to
@@ -89,6 +99,9 @@ bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
 }
 
 bool MallocHeader::get_stack(NativeCallStack& stack) const {
+  if (!has_malloc_site()) {
+    return false;
+  }
   return MallocSiteTable::access_stack(stack, _bucket_idx, _pos_idx);
 }
 
@@ -131,6 +144,13 @@ void* MallocTracker::record_malloc(void* malloc_base, size_t size, MEMFLAGS flag
   header = ::new (malloc_base)MallocHeader(size, flags, stack, level);
   memblock = (void*)((char*)malloc_base + sizeof(MallocHeader));
 
+  if (NativeMemoryTrackingPerThread && level > NMT_minimal) {
+    Thread* thread = Thread::current_or_null();
+    if (thread != NULL) {
+      thread->incr_nmt_malloced_bytes(size);
+    }
+  }
+
   // The alignment check: 8 bytes alignment for 32 bit systems.
   //                      16 bytes alignment for 64-bit systems.
   assert(((size_t)memblock & (sizeof(size_t) * 2 - 1)) == 0, "Alignment check");
@@ -152,3 +172,10 @@ void* MallocTracker::record_free(void* memblock) {
   header->release();
   return (void*)header;
 }
+
+void MallocTracker::record_thread_exit(Thread* thread) {
+  if (thread->nmt_malloced_bytes() > 0 || thread->nmt_freed_bytes() > 0) {
+    Atomic::add(&_exited_threads_malloced_bytes, thread->nmt_malloced_bytes());
+    Atomic::add(&_exited_threads_freed_bytes, thread->nmt_freed_bytes());
+  }
+}
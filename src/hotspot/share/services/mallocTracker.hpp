@@ -29,6 +29,7 @@
 
 #include "memory/allocation.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/nmtCommon.hpp"
 #include "utilities/nativeCallStack.hpp"
@@ -52,8 +53,8 @@ class MemoryCounter {
     DEBUG_ONLY(_peak_size  = 0;)
   }
 
-  inline void allocate(size_t sz) {
-    Atomic::inc(&_count);
+  inline void allocate(size_t sz, size_t count = 1) {
+    Atomic::add(&_count, count);
     if (sz > 0) {
       Atomic::add(&_size, sz);
       DEBUG_ONLY(_peak_size = MAX2(_peak_size, _size));
@@ -61,10 +62,10 @@ class MemoryCounter {
     DEBUG_ONLY(_peak_count = MAX2(_peak_count, _count);)
   }
 
-  inline void deallocate(size_t sz) {
-    assert(_count > 0, "Nothing allocated yet");
+  inline void deallocate(size_t sz, size_t count = 1) {
+    assert(_count >= count, "Nothing allocated yet");
     assert(_size >= sz, "deallocation > allocated");
-    Atomic::dec(&_count);
+    Atomic::sub(&_count, count);
     if (sz > 0) {
       Atomic::sub(&_size, sz);
     }
@@ -246,14 +247,16 @@ class MallocMemorySummary : AllStatic {
 class MallocHeader {
 #ifdef _LP64
   size_t           _size      : 64;
-  size_t           _flags     : 8;
+  size_t           _flags     : 7;
+  size_t           _sampled   : 1;
   size_t           _pos_idx   : 16;
   size_t           _bucket_idx: 40;
 #define MAX_MALLOCSITE_TABLE_SIZE right_n_bits(40)
 #define MAX_BUCKET_LENGTH         right_n_bits(16)
 #else
   size_t           _size      : 32;
-  size_t           _flags     : 8;
+  size_t           _flags     : 7;
+  size_t           _sampled   : 1;
   size_t           _pos_idx   : 8;
   size_t           _bucket_idx: 16;
 #define MAX_MALLOCSITE_TABLE_SIZE  right_n_bits(16)
@@ -274,7 +277,14 @@ class MallocHeader {
     if (level == NMT_detail) {
       size_t bucket_idx;
       size_t pos_idx;
-      if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
+      // The interval can change from 1 during argument parsing, so each block
+      // remembers whether it was recorded as a sample.
+      _sampled = NativeMemoryTrackingSampleInterval > 1;
+      if (_sampled && stack.is_empty()) {
+        // Not sampled, see MemTracker::sample_malloc_stack().
+        _bucket_idx = NO_MALLOC_SITE;
+        _pos_idx = 0;
+      } else if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
         assert(bucket_idx <= MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
@@ -294,6 +304,13 @@ class MallocHeader {
   void release() const;
 
  private:
+  // Bucket index of blocks that have no entry in the malloc site table.
+  // Real bucket indices are much smaller than this.
+  static const size_t NO_MALLOC_SITE = MAX_MALLOCSITE_TABLE_SIZE;
+
+  inline bool has_malloc_site() const { return _bucket_idx != NO_MALLOC_SITE; }
+  inline size_t site_weight() const     { return _sampled ? NativeMemoryTrackingSampleInterval : 1; }
+
   inline void set_size(size_t size) {
     _size = size;
   }
@@ -365,7 +382,18 @@ class MallocTracker : AllStatic {
   static inline void record_arena_size_change(ssize_t size, MEMFLAGS flags) {
     MallocMemorySummary::record_arena_size_change(size, flags);
   }
+
+  // With NativeMemoryTrackingPerThread, every thread counts the bytes it
+  // malloc'ed and freed in its Thread. Counts of exited threads are folded
+  // into the totals below.
+  static void record_thread_exit(Thread* thread);
+  static size_t exited_threads_malloced_bytes() { return Atomic::load(&_exited_threads_malloced_bytes); }
+  static size_t exited_threads_freed_bytes()    { return Atomic::load(&_exited_threads_freed_bytes); }
+
  private:
+  static volatile size_t _exited_threads_malloced_bytes;
+  static volatile size_t _exited_threads_freed_bytes;
+
   static inline MallocHeader* malloc_header(void *memblock) {
     assert(memblock != NULL, "NULL pointer");
     MallocHeader* header = (MallocHeader*)((char*)memblock - sizeof(MallocHeader));
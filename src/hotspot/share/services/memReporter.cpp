@@ -23,7 +23,14 @@
  */
 #include "precompiled.hpp"
 
+#include "classfile/classLoaderData.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
 #include "memory/allocation.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/threadSMR.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/memReporter.hpp"
 #include "services/threadStackTracker.hpp"
@@ -107,6 +114,10 @@ void MemSummaryReporter::report() {
   out->print_cr("\nNative Memory Tracking:\n");
   out->print("Total: ");
   print_total(total_reserved_amount, total_committed_amount);
+  if (NativeMemoryTrackingResident) {
+    out->print(", mmap resident=" SIZE_FORMAT "%s",
+      amount_in_current_scale(_vm_snapshot->total_resident()), scale);
+  }
   out->print("\n");
 
   // Summary by memory type
@@ -188,6 +199,10 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
 
     if (amount_in_current_scale(virtual_memory->reserved()) > 0) {
       print_virtual_memory_line(virtual_memory->reserved(), virtual_memory->committed());
+      if (NativeMemoryTrackingResident) {
+        out->print_cr("%27s (mmap: resident=" SIZE_FORMAT "%s)", " ",
+          amount_in_current_scale(virtual_memory->resident()), scale);
+      }
     }
 
     if (amount_in_current_scale(malloc_memory->arena_size()) > 0) {
@@ -251,6 +266,11 @@ void MemDetailReporter::report_malloc_sites() {
 
   outputStream* out = output();
 
+  if (NativeMemoryTrackingSampleInterval > 1) {
+    out->print_cr("Malloc sites are estimated from one in %u sampled malloc calls.\n",
+                  NativeMemoryTrackingSampleInterval);
+  }
+
   const MallocSite* malloc_site;
   while ((malloc_site = malloc_itr.next()) != NULL) {
     // Don't report if size is too small
@@ -320,6 +340,12 @@ void MemDetailReporter::report_virtual_memory_region(const ReservedMemoryRegion*
   out->print_cr(" ");
   print_virtual_memory_region(region_type, reserved_rgn->base(), reserved_rgn->size());
   out->print(" for %s", NMTUtil::flag_to_name(reserved_rgn->flag()));
+  if (all_committed && NativeMemoryTrackingResident) {
+    print_resident(reserved_rgn->base(), reserved_rgn->size());
+  }
+  if (NativeMemoryTrackingResident && reserved_rgn->committed_size() > 0) {
+    print_huge_pages(reserved_rgn->base(), reserved_rgn->size());
+  }
   if (stack->is_empty()) {
     out->print_cr(" ");
   } else {
@@ -347,6 +373,9 @@ void MemDetailReporter::report_virtual_memory_region(const ReservedMemoryRegion*
     stack = committed_rgn->call_stack();
     out->print("\n\t");
     print_virtual_memory_region("committed", committed_rgn->base(), committed_rgn->size());
+    if (NativeMemoryTrackingResident) {
+      print_resident(committed_rgn->base(), committed_rgn->size());
+    }
     if (stack->is_empty()) {
       out->print_cr(" ");
     } else {
@@ -356,6 +385,23 @@ void MemDetailReporter::report_virtual_memory_region(const ReservedMemoryRegion*
   }
 }
 
+void MemDetailReporter::print_resident(address base, size_t size) const {
+  size_t resident = os::resident_in_range(base, size);
+  output()->print(", resident " SIZE_FORMAT "%s", amount_in_current_scale(resident), current_scale());
+  // Committed but mostly untouched memory is a candidate for uncommit
+  if (resident < size / 2) {
+    output()->print(" (mostly not resident)");
+  }
+}
+
+void MemDetailReporter::print_huge_pages(address base, size_t size) const {
+  size_t huge_pages = os::huge_pages_in_range(base, size);
+  // Only regions the kernel backed with transparent huge pages are of interest
+  if (huge_pages > 0) {
+    output()->print(", huge pages " SIZE_FORMAT "%s", amount_in_current_scale(huge_pages), current_scale());
+  }
+}
+
 void MemSummaryDiffReporter::report_diff() {
   const char* scale = current_scale();
   outputStream* out = output();
@@ -801,3 +847,72 @@ void MemDetailDiffReporter::diff_virtual_memory_site(const NativeCallStack* stac
 
   out->print_cr(")\n");
  }
+
+void MemAttributionReporter::report() {
+  outputStream* out = output();
+  out->print_cr("Native Memory Attribution:");
+  out->cr();
+  report_threads();
+  out->cr();
+  report_class_loaders();
+}
+
+void MemAttributionReporter::print_thread_line(const char* name, size_t malloced, size_t freed) const {
+  const char* scale = current_scale();
+  output()->print_cr("%-40s (malloc=" SIZE_FORMAT "%s, free=" SIZE_FORMAT "%s)", name,
+    amount_in_current_scale(malloced), scale, amount_in_current_scale(freed), scale);
+}
+
+void MemAttributionReporter::report_threads() const {
+  outputStream* out = output();
+  if (!NativeMemoryTrackingPerThread) {
+    out->print_cr("Per-thread tracking is not enabled, use -XX:+NativeMemoryTrackingPerThread");
+    return;
+  }
+
+  out->print_cr("Malloc by thread:");
+  out->cr();
+  {
+    // Needed for get_thread_name()
+    MutexLocker ml(Threads_lock);
+    for (JavaThreadIteratorWithHandle jtiwh; JavaThread* jt = jtiwh.next(); ) {
+      ResourceMark rm;
+      print_thread_line(jt->get_thread_name(), jt->nmt_malloced_bytes(), jt->nmt_freed_bytes());
+    }
+  }
+  for (NonJavaThread::Iterator njti; !njti.end(); njti.step()) {
+    NonJavaThread* t = njti.current();
+    print_thread_line(t->name(), t->nmt_malloced_bytes(), t->nmt_freed_bytes());
+  }
+  print_thread_line("<exited threads>", MallocTracker::exited_threads_malloced_bytes(),
+                    MallocTracker::exited_threads_freed_bytes());
+}
+
+class MemAttributionCLDClosure : public CLDClosure {
+  outputStream* const _out;
+  const size_t        _scale;
+
+ public:
+  MemAttributionCLDClosure(outputStream* out, size_t scale) : _out(out), _scale(scale) { }
+
+  void do_cld(ClassLoaderData* cld) {
+    ClassLoaderMetaspace* msp = cld->metaspace_or_null();
+    if (msp == NULL) {
+      return;
+    }
+    ResourceMark rm;
+    const char* scale = NMTUtil::scale_name(_scale);
+    _out->print_cr("%-40s (metaspace: used=" SIZE_FORMAT "%s, committed=" SIZE_FORMAT "%s)",
+      cld->loader_name_and_id(),
+      NMTUtil::amount_in_scale(msp->allocated_blocks_bytes(), _scale), scale,
+      NMTUtil::amount_in_scale(msp->allocated_chunks_bytes(), _scale), scale);
+  }
+};
+
+void MemAttributionReporter::report_class_loaders() const {
+  output()->print_cr("Metaspace by class loader:");
+  output()->cr();
+  MemAttributionCLDClosure cl(output(), scale());
+  MutexLocker ml(ClassLoaderDataGraph_lock);
+  ClassLoaderDataGraph::loaded_cld_do(&cl);
+}
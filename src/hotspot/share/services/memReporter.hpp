@@ -52,6 +52,9 @@ class MemReporterBase : public StackObj {
   inline outputStream* output() const {
     return _output;
   }
+  inline size_t scale() const {
+    return _scale;
+  }
   // Current reporting scale
   inline const char* current_scale() const {
     return NMTUtil::scale_name(_scale);
@@ -149,6 +152,29 @@ class MemDetailReporter : public MemSummaryReporter {
 
   // Report a virtual memory region
   void report_virtual_memory_region(const ReservedMemoryRegion* rgn);
+  // Print how much of a committed range is resident
+  void print_resident(address base, size_t size) const;
+  // Print how much of a reserved region is backed by transparent huge pages
+  void print_huge_pages(address base, size_t size) const;
+};
+
+/*
+ * The class is for attributing native memory to its owners: the bytes
+ * malloc'ed and freed by each thread (with NativeMemoryTrackingPerThread),
+ * and the metaspace used by each class loader.
+ */
+class MemAttributionReporter : public MemReporterBase {
+ public:
+  MemAttributionReporter(outputStream* output, size_t scale = K) :
+    MemReporterBase(output, scale) { }
+
+  void report();
+
+ private:
+  void report_threads() const;
+  void report_class_loaders() const;
+
+  void print_thread_line(const char* name, size_t malloced, size_t freed) const;
 };
 
 /*
@@ -46,6 +46,7 @@ NMT_TrackingLevel MemTracker::_cmdline_tracking_level = NMT_unknown;
 
 MemBaseline MemTracker::_baseline;
 bool MemTracker::_is_nmt_env_valid = true;
+volatile uint MemTracker::_malloc_stack_counter = 0;
 
 static const size_t buffer_size = 64;
 
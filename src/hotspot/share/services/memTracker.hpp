@@ -33,6 +33,8 @@
 
 #define CURRENT_PC   NativeCallStack::empty_stack()
 #define CALLER_PC    NativeCallStack::empty_stack()
+#define MALLOC_CURRENT_PC NativeCallStack::empty_stack()
+#define MALLOC_CALLER_PC  NativeCallStack::empty_stack()
 
 class Tracker : public StackObj {
  public:
@@ -80,6 +82,7 @@ class MemTracker : AllStatic {
 
 #else
 
+#include "runtime/globals.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/mallocTracker.hpp"
@@ -91,6 +94,13 @@ class MemTracker : AllStatic {
 #define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail) ?  \
                     NativeCallStack(1, true) : NativeCallStack::empty_stack())
 
+// Same as above for malloc call sites, whose stacks are only walked for one in
+// NativeMemoryTrackingSampleInterval calls (see MemTracker::sample_malloc_stack()).
+#define MALLOC_CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && MemTracker::sample_malloc_stack()) ? \
+                           NativeCallStack(0, true) : NativeCallStack::empty_stack())
+#define MALLOC_CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && MemTracker::sample_malloc_stack()) ? \
+                           NativeCallStack(1, true) : NativeCallStack::empty_stack())
+
 class MemBaseline;
 
 // Tracker is used for guarding 'release' semantics of virtual memory operation, to avoid
@@ -304,6 +314,16 @@ class MemTracker : AllStatic {
     return _cmdline_tracking_level;
   }
 
+  // Walking the call stack dominates the cost of detail tracking. With
+  // NativeMemoryTrackingSampleInterval > 1 only every n-th malloc gets a
+  // call stack; the others are accounted in the summary only, and the
+  // malloc site counters scale each sampled call up by the interval.
+  static inline bool sample_malloc_stack() {
+    const uint interval = NativeMemoryTrackingSampleInterval;
+    return interval == 1 ||
+           Atomic::add(&_malloc_stack_counter, 1u) % interval == 0;
+  }
+
   static void tuning_statistics(outputStream* out);
 
  private:
@@ -322,6 +342,8 @@ class MemTracker : AllStatic {
   static MemBaseline      _baseline;
   // Query lock
   static Mutex*           _query_lock;
+  // Number of malloc calls seen by sample_malloc_stack()
+  static volatile uint    _malloc_stack_counter;
 };
 
 #endif // INCLUDE_NMT
@@ -55,6 +55,9 @@ NMTDCmd::NMTDCmd(outputStream* output,
             "BOOLEAN", false, "false"),
   _statistics("statistics", "print tracker statistics for tuning purpose.", \
             "BOOLEAN", false, "false"),
+  _attribution("attribution", "request runtime to report native memory malloc'ed " \
+            "and freed by each thread, and metaspace used by each class loader.",
+            "BOOLEAN", false, "false"),
   _scale("scale", "Memory usage in which scale, KB, MB or GB",
        "STRING", false, "KB") {
   _dcmdparser.add_dcmd_option(&_summary);
@@ -64,6 +67,7 @@ NMTDCmd::NMTDCmd(outputStream* output,
   _dcmdparser.add_dcmd_option(&_detail_diff);
   _dcmdparser.add_dcmd_option(&_shutdown);
   _dcmdparser.add_dcmd_option(&_statistics);
+  _dcmdparser.add_dcmd_option(&_attribution);
   _dcmdparser.add_dcmd_option(&_scale);
 }
 
@@ -99,10 +103,12 @@ void NMTDCmd::execute(DCmdSource source, TRAPS) {
   if (_detail_diff.is_set() && _detail_diff.value()) { ++nopt; }
   if (_shutdown.is_set() && _shutdown.value()) { ++nopt; }
   if (_statistics.is_set() && _statistics.value()) { ++nopt; }
+  if (_attribution.is_set() && _attribution.value()) { ++nopt; }
 
   if (nopt > 1) {
       output()->print_cr("At most one of the following option can be specified: " \
-        "summary, detail, metadata, baseline, summary.diff, detail.diff, shutdown");
+        "summary, detail, metadata, baseline, summary.diff, detail.diff, shutdown, " \
+        "statistics, attribution");
       return;
   } else if (nopt == 0) {
     if (_summary.is_set()) {
@@ -154,6 +160,9 @@ void NMTDCmd::execute(DCmdSource source, TRAPS) {
     if (check_detail_tracking_level(output())) {
       MemTracker::tuning_statistics(output());
     }
+  } else if (_attribution.value()) {
+    MemAttributionReporter rpt(output(), scale_unit);
+    rpt.report();
   } else {
     ShouldNotReachHere();
     output()->print_cr("Unknown command");
@@ -44,6 +44,7 @@ class NMTDCmd: public DCmdWithParser {
   DCmdArgument<bool>  _detail_diff;
   DCmdArgument<bool>  _shutdown;
   DCmdArgument<bool>  _statistics;
+  DCmdArgument<bool>  _attribution;
   DCmdArgument<char*> _scale;
 
  public:
@@ -39,6 +39,8 @@ PerfCounter*  RuntimeService::_sync_time_ticks = NULL;
 PerfCounter*  RuntimeService::_total_safepoints = NULL;
 PerfCounter*  RuntimeService::_safepoint_time_ticks = NULL;
 PerfCounter*  RuntimeService::_application_time_ticks = NULL;
+PerfHistogram* RuntimeService::_sync_time_histogram = NULL;
+PerfHistogram* RuntimeService::_safepoint_time_histogram = NULL;
 
 void RuntimeService::init() {
   if (UsePerfData) {
@@ -60,6 +62,12 @@ void RuntimeService::init() {
               PerfDataManager::create_counter(SUN_RT, "applicationTime",
                                               PerfData::U_Ticks, CHECK);
 
+    _sync_time_histogram =
+              PerfDataManager::create_histogram(SUN_RT, "safepointSyncTimeHistogram", CHECK);
+
+    _safepoint_time_histogram =
+              PerfDataManager::create_histogram(SUN_RT, "safepointTimeHistogram", CHECK);
+
 
     // create performance counters for jvm_version and its capabilities
     PerfDataManager::create_constant(SUN_RT, "jvmVersion", PerfData::U_None,
@@ -92,6 +100,7 @@ void RuntimeService::record_safepoint_begin(jlong app_ticks) {
 void RuntimeService::record_safepoint_synchronized(jlong sync_ticks) {
   if (UsePerfData) {
     _sync_time_ticks->inc(sync_ticks);
+    _sync_time_histogram->sample_ticks(sync_ticks);
   }
 }
 
@@ -99,6 +108,7 @@ void RuntimeService::record_safepoint_end(jlong safepoint_ticks) {
   HS_PRIVATE_SAFEPOINT_END();
   if (UsePerfData) {
     _safepoint_time_ticks->inc(safepoint_ticks);
+    _safepoint_time_histogram->sample_ticks(safepoint_ticks);
   }
 }
 
@@ -47,6 +47,9 @@ void VirtualMemorySummary::snapshot(VirtualMemorySnapshot* s) {
     VirtualMemoryTracker::snapshot_thread_stacks();
   }
   as_snapshot()->copy_to(s);
+  if (NativeMemoryTrackingResident) {
+    VirtualMemoryTracker::snapshot_resident(s);
+  }
 }
 
 SortedLinkedList<ReservedMemoryRegion, compare_reserved_region_base>* VirtualMemoryTracker::_reserved_regions;
@@ -614,6 +617,30 @@ void VirtualMemoryTracker::snapshot_thread_stacks() {
   walk_virtual_memory(&walker);
 }
 
+// Walk all committed regions, and add up their resident parts by memory type.
+class SnapshotResidentWalker : public VirtualMemoryWalker {
+ private:
+  VirtualMemorySnapshot* _snapshot;
+
+ public:
+  SnapshotResidentWalker(VirtualMemorySnapshot* s) : _snapshot(s) { }
+
+  bool do_allocation_site(const ReservedMemoryRegion* rgn) {
+    VirtualMemory* vm = _snapshot->by_type(rgn->flag());
+    CommittedRegionIterator itr = rgn->iterate_committed_regions();
+    const CommittedMemoryRegion* committed_rgn;
+    while ((committed_rgn = itr.next()) != NULL) {
+      vm->add_resident(os::resident_in_range(committed_rgn->base(), committed_rgn->size()));
+    }
+    return true;
+  }
+};
+
+void VirtualMemoryTracker::snapshot_resident(VirtualMemorySnapshot* s) {
+  SnapshotResidentWalker walker(s);
+  walk_virtual_memory(&walker);
+}
+
 bool VirtualMemoryTracker::walk_virtual_memory(VirtualMemoryWalker* walker) {
   assert(_reserved_regions != NULL, "Sanity check");
   ThreadCritical tc;
@@ -43,9 +43,10 @@ class VirtualMemory {
  private:
   size_t     _reserved;
   size_t     _committed;
+  size_t     _resident;   // only set in snapshots, see NativeMemoryTrackingResident
 
  public:
-  VirtualMemory() : _reserved(0), _committed(0) { }
+  VirtualMemory() : _reserved(0), _committed(0), _resident(0) { }
 
   inline void reserve_memory(size_t sz) { _reserved += sz; }
   inline void commit_memory (size_t sz) {
@@ -63,8 +64,11 @@ class VirtualMemory {
     _committed -= sz;
   }
 
+  inline void add_resident(size_t sz) { _resident += sz; }
+
   inline size_t reserved()  const { return _reserved;  }
   inline size_t committed() const { return _committed; }
+  inline size_t resident()  const { return _resident;  }
 };
 
 // Virtual memory allocation site, keeps track where the virtual memory is reserved.
@@ -119,6 +123,14 @@ class VirtualMemorySnapshot : public ResourceObj {
     return amount;
   }
 
+  inline size_t total_resident() const {
+    size_t amount = 0;
+    for (int index = 0; index < mt_number_of_types; index ++) {
+      amount += _virtual_memory[index].resident();
+    }
+    return amount;
+  }
+
   void copy_to(VirtualMemorySnapshot* s) {
     for (int index = 0; index < mt_number_of_types; index ++) {
       s->_virtual_memory[index] = _virtual_memory[index];
@@ -398,6 +410,10 @@ class VirtualMemoryTracker : AllStatic {
   // Snapshot current thread stacks
   static void snapshot_thread_stacks();
 
+  // Ask the OS how much of each committed region is actually resident
+  // and add it up by memory type in the given snapshot.
+  static void snapshot_resident(VirtualMemorySnapshot* s);
+
  private:
   static SortedLinkedList<ReservedMemoryRegion, compare_reserved_region_base>* _reserved_regions;
 };
@@ -104,6 +104,10 @@ class BitMap {
   static const bm_word_t find_ones_flip = 0;
   static const bm_word_t find_zeros_flip = ~(bm_word_t)0;
 
+  // Number of words examined together when skipping over uninteresting
+  // words in get_next_bit_impl.
+  static const idx_t search_group_words = 4;
+
   // Threshold for performing small range operation, even when large range
   // operation was requested. Measured in words.
   static const size_t small_range_words = 32;
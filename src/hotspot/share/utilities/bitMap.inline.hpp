@@ -211,7 +211,25 @@ inline BitMap::idx_t BitMap::get_next_bit_impl(idx_t l_index, idx_t r_index) con
       idx_t limit = aligned_right
         ? to_words_align_down(r_index) // Miniscule savings when aligned.
         : to_words_align_up(r_index);
-      while (++index < limit) {
+      // Sparse bitmaps (e.g. mark bitmaps) often have long runs of
+      // uninteresting words.  Skip over them a group of words at a time,
+      // combining the words of a group into a single test.  The inner loop
+      // has a fixed trip count and no loop-carried branches, so the
+      // compiler can unroll it and use wide loads and vector compares where
+      // the platform supports them.  The word search below then locates
+      // the interesting word within the group we stopped at, if any.
+      ++index;
+      while (limit - index >= search_group_words) {
+        bm_word_t group = 0;
+        for (idx_t i = 0; i < search_group_words; i++) {
+          group |= map(index + i) ^ flip;
+        }
+        if (group != 0) {
+          break;
+        }
+        index += search_group_words;
+      }
+      for ( ; index < limit; ++index) {
         cword = map(index) ^ flip;
         if (cword != 0) {
           idx_t result = bit_index(index) + count_trailing_zeros(cword);
@@ -98,6 +98,13 @@ class ConcurrentHashTable<CONFIG, F>::BucketsOperation {
   }
 
 public:
+  // Sets the number of buckets processed per task; must be called before
+  // the operation is prepared.
+  void set_task_size_log2(size_t task_size_log2) {
+    assert(_stop_task == 0, "Operation already prepared");
+    _task_size_log2 = task_size_log2;
+  }
+
   // Pauses for safepoint
   void pause(Thread* thread) {
     // This leaves internal state locked.
@@ -29,9 +29,11 @@
 #include "memory/allocation.inline.hpp"
 #include "utilities/elfFuncDescTable.hpp"
 #include "utilities/elfSymbolTable.hpp"
+#include "utilities/quickSort.hpp"
 
 ElfSymbolTable::ElfSymbolTable(FILE* const file, Elf_Shdr& shdr) :
-  _next(NULL), _fd(file), _section(file, shdr) {
+  _next(NULL), _fd(file), _section(file, shdr),
+  _index(NULL), _index_length(0), _index_built(false) {
   assert(file != NULL, "null file handle");
   _status = _section.status();
 
@@ -41,22 +43,28 @@ ElfSymbolTable::ElfSymbolTable(FILE* const file, Elf_Shdr& shdr) :
 }
 
 ElfSymbolTable::~ElfSymbolTable() {
+  if (_index != NULL) {
+    FREE_C_HEAP_ARRAY(IndexEntry, _index);
+  }
   if (_next != NULL) {
     delete _next;
   }
 }
 
+address ElfSymbolTable::symbol_address(const Elf_Sym* sym, ElfFuncDescTable* funcDescTable) {
+  if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
+    // We need to go another step trough the function descriptor table (currently PPC64 only)
+    return funcDescTable->lookup(sym->st_value);
+  } else {
+    return (address)sym->st_value;
+  }
+}
+
 bool ElfSymbolTable::compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
   if (STT_FUNC == ELF_ST_TYPE(sym->st_info)) {
     Elf_Word st_size = sym->st_size;
     const Elf_Shdr* shdr = _section.section_header();
-    address sym_addr;
-    if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
-      // We need to go another step trough the function descriptor table (currently PPC64 only)
-      sym_addr = funcDescTable->lookup(sym->st_value);
-    } else {
-      sym_addr = (address)sym->st_value;
-    }
+    address sym_addr = symbol_address(sym, funcDescTable);
     if (sym_addr <= addr && (Elf_Word)(addr - sym_addr) < st_size) {
       *offset = (int)(addr - sym_addr);
       *posIndex = sym->st_name;
@@ -80,7 +88,13 @@ bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex,
   int count = _section.section_header()->sh_size / sym_size;
   Elf_Sym* symbols = (Elf_Sym*)_section.section_data();
 
-  if (symbols != NULL) {
+  if (symbols != NULL && !_index_built) {
+    build_index(funcDescTable);
+  }
+
+  if (_index != NULL) {
+    return lookup_index(addr, stringtableIndex, posIndex, offset);
+  } else if (symbols != NULL) {
     for (int index = 0; index < count; index ++) {
       if (compare(&symbols[index], addr, stringtableIndex, posIndex, offset, funcDescTable)) {
         return true;
@@ -109,4 +123,79 @@ bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex,
   return false;
 }
 
+int ElfSymbolTable::compare_entries(IndexEntry* e1, IndexEntry* e2) {
+  if (e1->_addr < e2->_addr) return -1;
+  if (e1->_addr > e2->_addr) return 1;
+  return 0;
+}
+
+// Builds the sorted index from the cached section. Symbols of size zero can
+// never match a lookup and are left out. If the index can not be allocated,
+// lookups fall back to walking the section.
+void ElfSymbolTable::build_index(ElfFuncDescTable* funcDescTable) {
+  assert(!_index_built && _index == NULL, "index built twice");
+  _index_built = true;
+
+  const Elf_Sym* symbols = (const Elf_Sym*)_section.section_data();
+  int count = _section.section_header()->sh_size / sizeof(Elf_Sym);
+  int length = 0;
+  for (int i = 0; i < count; i++) {
+    if (STT_FUNC == ELF_ST_TYPE(symbols[i].st_info) && symbols[i].st_size > 0) {
+      length++;
+    }
+  }
+  if (length == 0) {
+    return;
+  }
+
+  IndexEntry* index = NEW_C_HEAP_ARRAY_RETURN_NULL(IndexEntry, length, mtInternal);
+  if (index == NULL) {
+    return;
+  }
+  int pos = 0;
+  for (int i = 0; i < count; i++) {
+    const Elf_Sym* sym = &symbols[i];
+    if (STT_FUNC == ELF_ST_TYPE(sym->st_info) && sym->st_size > 0) {
+      index[pos]._addr = symbol_address(sym, funcDescTable);
+      index[pos]._size = sym->st_size;
+      index[pos]._name = sym->st_name;
+      pos++;
+    }
+  }
+  QuickSort::sort(index, length, compare_entries, false);
+  _index = index;
+  _index_length = length;
+}
+
+bool ElfSymbolTable::lookup_index(address addr, int* stringtableIndex, int* posIndex, int* offset) {
+  // find the last symbol starting at or below addr
+  int low = 0;
+  int high = _index_length - 1;
+  int found = -1;
+  while (low <= high) {
+    int mid = low + (high - low) / 2;
+    if (_index[mid]._addr <= addr) {
+      found = mid;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  // Function symbols do not normally overlap. Check the aliases sharing
+  // that start address, and the symbol just before them.
+  for (int i = found; i >= 0; i--) {
+    const IndexEntry* e = &_index[i];
+    if ((size_t)(addr - e->_addr) < e->_size) {
+      *offset = (int)(addr - e->_addr);
+      *posIndex = e->_name;
+      *stringtableIndex = _section.section_header()->sh_link;
+      return true;
+    }
+    if (e->_addr != _index[found]._addr) {
+      break;
+    }
+  }
+  return false;
+}
+
 #endif // !_WINDOWS && !__APPLE__
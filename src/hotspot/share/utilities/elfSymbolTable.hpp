@@ -50,6 +50,17 @@ private:
   ElfSection      _section;
 
   NullDecoder::decoder_status _status;
+
+  // Function symbols of the cached section, sorted by address, so that
+  // lookups are a binary search rather than a walk over the whole table.
+  struct IndexEntry {
+    address   _addr;
+    Elf_Word  _size;
+    Elf_Word  _name;
+  };
+  IndexEntry*     _index;
+  int             _index_length;
+  bool            _index_built;
 public:
   ElfSymbolTable(FILE* const file, Elf_Shdr& shdr);
   ~ElfSymbolTable();
@@ -63,6 +74,11 @@ private:
   void set_next(ElfSymbolTable* next) { _next = next; }
 
   bool compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable);
+  address symbol_address(const Elf_Sym* sym, ElfFuncDescTable* funcDescTable);
+
+  void build_index(ElfFuncDescTable* funcDescTable);
+  bool lookup_index(address addr, int* stringtableIndex, int* posIndex, int* offset);
+  static int compare_entries(IndexEntry* e1, IndexEntry* e2);
 };
 
 #endif // !_WINDOWS and !__APPLE__
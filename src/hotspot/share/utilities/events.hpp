@@ -26,6 +26,7 @@
 #define SHARE_UTILITIES_EVENTS_HPP
 
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/formatBuffer.hpp"
@@ -78,50 +79,81 @@ class EventLog : public CHeapObj<mtInternal> {
 // providing a more featureful log function if the existing copy
 // semantics aren't appropriate.  The name is used as the label of the
 // log when it is dumped during a crash.
+//
+// Writers don't take a lock.  Each one claims the next sequence number,
+// marks the slot it maps to as in progress, fills it in and publishes it
+// by storing the sequence number in the slot.  A writer that finds the
+// slot in progress, or already holding a newer event, drops its event.
+// Readers print only slots holding the sequence number they expect, so
+// slots that are being written or have been reused are skipped.
 template <class T> class EventLogBase : public EventLog {
+ protected:
   template <class X> class EventRecord : public CHeapObj<mtInternal> {
    public:
+    // sequence number + 1 of the event in this slot, 0 if never written
+    volatile size_t seq;
     double  timestamp;
     Thread* thread;
     X       data;
   };
+  typedef EventRecord<T> Record;
+
+  static const size_t in_progress = SIZE_MAX;
 
- protected:
-  Mutex           _mutex;
   // Name is printed out as a header.
   const char*     _name;
   // Handle is a short specifier used to select this particular event log
   // for printing (see VM.events command).
   const char*     _handle;
   int             _length;
-  int             _index;
-  int             _count;
+  // sequence number of the next event
+  volatile size_t _next;
+  // events dropped because their slot was still being written or
+  // already held a newer event
+  volatile size_t _dropped;
   EventRecord<T>* _records;
 
  public:
   EventLogBase<T>(const char* name, const char* handle, int length = LogEventsBufferEntries):
-    _mutex(Mutex::event, name, true, Mutex::_safepoint_check_never),
     _name(name),
     _handle(handle),
     _length(length),
-    _index(0),
-    _count(0) {
+    _next(0),
+    _dropped(0) {
     _records = new EventRecord<T>[length];
+    for (int i = 0; i < length; i++) {
+      _records[i].seq = 0;
+      // A reader may print a slot while it is rewritten; keep the
+      // terminating NUL in place so it never reads past the buffer.
+      _records[i].data.buffer()[_records[i].data.size() - 1] = '\0';
+    }
   }
 
   double fetch_timestamp() {
     return os::elapsedTime();
   }
 
-  // move the ring buffer to next open slot and return the index of
-  // the slot to use for the current message.  Should only be called
-  // while mutex is held.
-  int compute_log_index() {
-    int index = _index;
-    if (_count < _length) _count++;
-    _index++;
-    if (_index >= _length) _index = 0;
-    return index;
+  // Claim the slot for the next event and fill in its header.  Returns
+  // NULL, dropping the event, if another writer is still writing that
+  // slot, or if this writer has been lapped by the ring and a newer event
+  // was already written there.  A claimed record must be published.
+  Record* claim_record(Thread* thread, double timestamp, size_t* seq) {
+    *seq = Atomic::fetch_and_add(&_next, (size_t)1);
+    Record* r = &_records[*seq % _length];
+    size_t old = Atomic::load(&r->seq);
+    // The slot holds an older event only if its seq is at most ours;
+    // in_progress is larger than any sequence number.
+    if (old > *seq || Atomic::cmpxchg(&r->seq, old, in_progress) != old) {
+      Atomic::inc(&_dropped);
+      return NULL;
+    }
+    r->thread = thread;
+    r->timestamp = timestamp;
+    return r;
+  }
+
+  void publish_record(Record* r, size_t seq) {
+    Atomic::release_store(&r->seq, seq + 1);
   }
 
   bool should_log() {
@@ -130,7 +162,7 @@ template <class T> class EventLogBase : public EventLog {
     return !VMError::fatal_error_in_progress();
   }
 
-  // Print the contents of the log
+  // Print the contents of the log.  Safe against concurrent writers.
   void print_log_on(outputStream* out, int max = -1);
 
   // Returns true if s matches either the log name or the log handle.
@@ -173,11 +205,12 @@ class FormatStringEventLog : public EventLogBase< FormatStringLogMessage<bufsz>
     if (!this->should_log()) return;
 
     double timestamp = this->fetch_timestamp();
-    MutexLocker ml(&this->_mutex, Mutex::_no_safepoint_check_flag);
-    int index = this->compute_log_index();
-    this->_records[index].thread = thread;
-    this->_records[index].timestamp = timestamp;
-    this->_records[index].data.printv(format, ap);
+    size_t seq;
+    typename EventLogBase< FormatStringLogMessage<bufsz> >::Record* r =
+      this->claim_record(thread, timestamp, &seq);
+    if (r == NULL) return;
+    r->data.printv(format, ap);
+    this->publish_record(r, seq);
   }
 
   void log(Thread* thread, const char* format, ...) ATTRIBUTE_PRINTF(3, 4) {
@@ -311,13 +344,7 @@ inline void Events::log_deopt_message(Thread* thread, const char* format, ...) {
 
 template <class T>
 inline void EventLogBase<T>::print_log_on(outputStream* out, int max) {
-  if (Thread::current_or_null() == NULL) {
-    // Not yet attached? Don't try to use locking
-    print_log_impl(out, max);
-  } else {
-    MutexLocker ml(&_mutex, Mutex::_no_safepoint_check_flag);
-    print_log_impl(out, max);
-  }
+  print_log_impl(out, max);
 }
 
 template <class T>
@@ -334,42 +361,39 @@ inline void EventLogBase<T>::print_names(outputStream* out) const {
 // Dump the ring buffer entries that current have entries.
 template <class T>
 inline void EventLogBase<T>::print_log_impl(outputStream* out, int max) {
-  out->print_cr("%s (%d events):", _name, _count);
-  if (_count == 0) {
+  size_t next = Atomic::load_acquire(&_next);
+  size_t count = MIN2(next, (size_t)_length);
+  out->print_cr("%s (" SIZE_FORMAT " events):", _name, count);
+  if (count == 0) {
     out->print_cr("No events");
     out->cr();
     return;
   }
 
   int printed = 0;
-  if (_count < _length) {
-    for (int i = 0; i < _count; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+  for (size_t seq = next - count; seq < next; seq++) {
+    if (max > 0 && printed == max) {
+      break;
     }
-  } else {
-    for (int i = _index; i < _length; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+    EventRecord<T>& r = _records[seq % _length];
+    if (Atomic::load_acquire(&r.seq) != seq + 1) {
+      // still being written, or already reused for a later event
+      continue;
     }
-    for (int i = 0; i < _index; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+    print(out, r);
+    if (Atomic::load_acquire(&r.seq) != seq + 1) {
+      out->print_cr("(event overwritten while printing)");
     }
+    printed ++;
   }
 
   if (printed == max) {
     out->print_cr("...(skipped)");
   }
+  size_t dropped = Atomic::load(&_dropped);
+  if (dropped > 0) {
+    out->print_cr("(" SIZE_FORMAT " events dropped)", dropped);
+  }
 
   out->cr();
 }
@@ -710,6 +710,52 @@ public:
   }
 };
 
+// GrowableArray with storage for the first N elements embedded in the
+// instance, for short-lived temporaries that usually stay small. Only when
+// it grows beyond N elements is the data array moved to the resource area,
+// or to the given arena. The embedded storage is never freed, so instances
+// belong on the stack.
+template <typename E, int N>
+class GrowableArrayInline : public GrowableArrayWithAllocator<E, GrowableArrayInline<E, N> > {
+  friend class GrowableArrayWithAllocator<E, GrowableArrayInline<E, N> >;
+
+  STATIC_ASSERT(N > 0);
+
+  NONCOPYABLE(GrowableArrayInline);
+
+  // Raw storage; the elements are constructed by GrowableArrayWithAllocator.
+  union {
+    char _bytes[N * sizeof(E)];
+    jlong _align_jlong;
+    jdouble _align_jdouble;
+    void* _align_ptr;
+  } _inline_data;
+  Arena* _arena;
+
+  E* allocate() {
+    if (_arena != NULL) {
+      return (E*)GrowableArrayArenaAllocator::allocate(this->_max, sizeof(E), _arena);
+    }
+    return (E*)GrowableArrayResourceAllocator::allocate(this->_max, sizeof(E));
+  }
+
+  void deallocate(E* mem) {
+    // Neither the embedded storage nor resource or arena memory is freed.
+  }
+
+public:
+  GrowableArrayInline(Arena* arena = NULL) :
+      GrowableArrayWithAllocator<E, GrowableArrayInline<E, N> >(
+          reinterpret_cast<E*>(_inline_data._bytes),
+          N),
+      _arena(arena) {}
+
+  // Are the elements still in the embedded storage?
+  bool is_inline() const {
+    return this->_data == reinterpret_cast<const E*>(_inline_data._bytes);
+  }
+};
+
 // Custom STL-style iterator to iterate over GrowableArrays
 // It is constructed by invoking GrowableArray::begin() and GrowableArray::end()
 template <typename E>
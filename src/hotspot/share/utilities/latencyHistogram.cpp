@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/count_leading_zeros.hpp"
+#include "utilities/latencyHistogram.hpp"
+#include "utilities/ostream.hpp"
+
+LatencyHistogram* volatile LatencyHistogram::_all = NULL;
+
+LatencyHistogram::LatencyHistogram(const char* name) :
+    _name(name),
+    _next(NULL),
+    _total(0),
+    _max(0) {
+  for (int i = 0; i < bucket_count; i++) {
+    _counts[i] = 0;
+  }
+  LatencyHistogram* head = Atomic::load(&_all);
+  do {
+    _next = head;
+    head = Atomic::cmpxchg(&_all, _next, this);
+  } while (head != _next);
+}
+
+int LatencyHistogram::index_of(jlong value) {
+  julong v = (julong)MAX2(value, (jlong)0);
+  if (v < (julong)sub_bucket_count) {
+    return (int)v;
+  }
+  int msb = BitsPerLong - 1 - (int)count_leading_zeros(v);
+  int shift = msb - sub_bucket_bits;
+  return (shift + 1) * sub_bucket_count + (int)((v >> shift) & (sub_bucket_count - 1));
+}
+
+jlong LatencyHistogram::upper_bound(int index) {
+  if (index < sub_bucket_count) {
+    return index;
+  }
+  int shift = index / sub_bucket_count - 1;
+  int sub = index % sub_bucket_count;
+  julong lower = (julong)(sub_bucket_count + sub) << shift;
+  return (jlong)(lower + (((julong)1) << shift) - 1);
+}
+
+void LatencyHistogram::record(jlong nanos) {
+  Atomic::inc(&_counts[index_of(nanos)]);
+  Atomic::inc(&_total);
+  jlong max = Atomic::load(&_max);
+  while (nanos > max) {
+    jlong prev = Atomic::cmpxchg(&_max, max, nanos);
+    if (prev == max) {
+      break;
+    }
+    max = prev;
+  }
+}
+
+jlong LatencyHistogram::percentile(double p) const {
+  uint64_t total = Atomic::load(&_total);
+  if (total == 0) {
+    return 0;
+  }
+  uint64_t target = (uint64_t)(p * total);
+  if (target < 1) {
+    target = 1;
+  }
+  uint64_t seen = 0;
+  for (int i = 0; i < bucket_count; i++) {
+    seen += Atomic::load(&_counts[i]);
+    if (seen >= target) {
+      return MIN2(upper_bound(i), Atomic::load(&_max));
+    }
+  }
+  return Atomic::load(&_max);
+}
+
+void LatencyHistogram::print_on(outputStream* st) const {
+  st->print_cr("%-32s count=" UINT64_FORMAT " p50=%.3fms p99=%.3fms p999=%.3fms max=%.3fms",
+               _name, Atomic::load(&_total),
+               (double)percentile(0.5) / NANOSECS_PER_MILLISEC,
+               (double)percentile(0.99) / NANOSECS_PER_MILLISEC,
+               (double)percentile(0.999) / NANOSECS_PER_MILLISEC,
+               (double)Atomic::load(&_max) / NANOSECS_PER_MILLISEC);
+}
+
+void LatencyHistogram::print_all(outputStream* st) {
+  for (LatencyHistogram* h = Atomic::load(&_all); h != NULL; h = h->_next) {
+    h->print_on(st);
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_UTILITIES_LATENCYHISTOGRAM_HPP
+#define SHARE_UTILITIES_LATENCYHISTOGRAM_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class outputStream;
+
+// LatencyHistogram records durations in nanoseconds into logarithmic
+// buckets: every power of two is split into 2^sub_bucket_bits linear
+// sub-buckets, so a percentile is reported with a relative error of at
+// most 1/2^sub_bucket_bits, whatever the magnitude of the values.
+// Recording is lock free and may happen concurrently.
+//
+// Histograms register themselves on creation and are printed together
+// by print_all(), e.g. from the VM.latencies diagnostic command.
+class LatencyHistogram : public CHeapObj<mtInternal> {
+ private:
+  static const int sub_bucket_bits  = 3;
+  static const int sub_bucket_count = 1 << sub_bucket_bits;
+  static const int bucket_count     = (BitsPerLong - sub_bucket_bits) * sub_bucket_count;
+
+  static LatencyHistogram* volatile _all;
+
+  const char*       _name;
+  LatencyHistogram* _next;
+  volatile uint64_t _total;
+  volatile jlong    _max;
+  volatile uint64_t _counts[bucket_count];
+
+  static int index_of(jlong value);
+  static jlong upper_bound(int index);
+
+ public:
+  LatencyHistogram(const char* name);
+
+  const char* name() const { return _name; }
+  uint64_t total() const   { return _total; }
+  jlong max() const        { return _max; }
+
+  void record(jlong nanos);
+
+  // The smallest value such that a fraction p of the samples is less
+  // than or equal to it, rounded up to the end of its bucket.
+  jlong percentile(double p) const;
+
+  void print_on(outputStream* st) const;
+  static void print_all(outputStream* st);
+};
+
+#endif // SHARE_UTILITIES_LATENCYHISTOGRAM_HPP
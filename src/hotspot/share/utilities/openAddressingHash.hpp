@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_UTILITIES_OPENADDRESSINGHASH_HPP
+#define SHARE_UTILITIES_OPENADDRESSINGHASH_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/powerOfTwo.hpp"
+
+// A single-threaded hash map with the interface of ResourceHashtable that
+// keeps all entries in one C heap array instead of a chain of nodes per
+// bucket. Inserting does not allocate unless the table grows, and a lookup
+// usually touches one or two cache lines.
+//
+// Collisions are resolved with Robin Hood linear probing: every slot records
+// how far it is from the slot its hash maps to, and an insertion takes over
+// the slot of any entry that is closer to its home than the new one, then
+// goes on to place the displaced entry. This keeps probe sequences short
+// and lets a lookup stop at the first entry closer to home than the key
+// would be. Removal shifts the following entries back, so no tombstones
+// are needed.
+//
+// The probe distances and hashes live in an array of their own, so probing
+// does not load keys and values until a hash matches.
+//
+// Pointers returned by get() and put_if_absent() are only valid until the
+// next insertion or removal, which may move entries.
+template<
+    typename K, typename V,
+    unsigned (*HASH)  (K const&)           = primitive_hash<K>,
+    bool     (*EQUALS)(K const&, K const&) = primitive_equals<K>,
+    MEMFLAGS MEM_TYPE = mtInternal
+    >
+class OpenAddressingHashtable : public CHeapObj<MEM_TYPE> {
+  NONCOPYABLE(OpenAddressingHashtable);
+
+ private:
+  struct Entry {
+    K _key;
+    V _value;
+
+    Entry(K const& key, V const& value) : _key(key), _value(value) {}
+  };
+
+  struct Slot {
+    unsigned _dist;     // probe distance plus one, zero if the slot is empty
+    unsigned _hash;
+  };
+
+  Slot* _slots;
+  Entry* _entries;
+  size_t _capacity;     // a power of two
+  int _shift;           // 32 - log2(_capacity)
+  size_t _number_of_entries;
+
+  // Fibonacci hashing spreads the hash bits over the index, so that hash
+  // functions that only vary in the high or low bits probe well.
+  size_t home(unsigned hash) const {
+    return (size_t)((uint32_t)(hash * 2654435769U) >> _shift);
+  }
+
+  size_t next(size_t index) const {
+    return (index + 1) & (_capacity - 1);
+  }
+
+  void allocate(size_t capacity) {
+    assert(is_power_of_2(capacity) && capacity <= ((size_t)1 << 31), "invalid capacity " SIZE_FORMAT, capacity);
+    _capacity = capacity;
+    _shift = 32 - log2_intptr((uintptr_t)capacity);
+    _number_of_entries = 0;
+    _slots = NEW_C_HEAP_ARRAY(Slot, capacity, MEM_TYPE);
+    _entries = NEW_C_HEAP_ARRAY(Entry, capacity, MEM_TYPE);
+    memset(_slots, 0, capacity * sizeof(Slot));
+  }
+
+  static void release(Slot* slots, Entry* entries, size_t capacity) {
+    for (size_t i = 0; i < capacity; i++) {
+      if (slots[i]._dist != 0) {
+        entries[i].~Entry();
+      }
+    }
+    FREE_C_HEAP_ARRAY(Slot, slots);
+    FREE_C_HEAP_ARRAY(Entry, entries);
+  }
+
+  // Returns the index of the slot holding the key, or _capacity if the key
+  // is not in the table.
+  size_t lookup(unsigned hash, K const& key) const {
+    size_t index = home(hash);
+    for (unsigned dist = 1; dist <= _slots[index]._dist; dist++) {
+      if (_slots[index]._hash == hash && EQUALS(key, _entries[index]._key)) {
+        return index;
+      }
+      index = next(index);
+    }
+    return _capacity;
+  }
+
+  // Add an entry for a key that is not in the table yet and return the
+  // index of its slot.
+  size_t insert(unsigned hash, K const& key, V const& value) {
+    if (_number_of_entries + 1 > _capacity - _capacity / 8) {
+      grow();
+    }
+    size_t index = home(hash);
+    unsigned dist = 1;
+    while (_slots[index]._dist >= dist) {
+      index = next(index);
+      dist++;
+    }
+    const size_t result = index;
+    if (_slots[index]._dist != 0) {
+      // Take over the slot and move the entries that were closer to their
+      // home one slot further, up to the next empty slot.
+      size_t empty = index;
+      while (_slots[empty]._dist != 0) {
+        empty = next(empty);
+      }
+      ::new ((void*)&_entries[empty]) Entry(_entries[(empty - 1) & (_capacity - 1)]);
+      _slots[empty] = _slots[(empty - 1) & (_capacity - 1)];
+      _slots[empty]._dist++;
+      for (size_t i = (empty - 1) & (_capacity - 1); i != index; i = (i - 1) & (_capacity - 1)) {
+        size_t prev = (i - 1) & (_capacity - 1);
+        _entries[i] = _entries[prev];
+        _slots[i] = _slots[prev];
+        _slots[i]._dist++;
+      }
+      _entries[index] = Entry(key, value);
+    } else {
+      ::new ((void*)&_entries[index]) Entry(key, value);
+    }
+    _slots[index]._dist = dist;
+    _slots[index]._hash = hash;
+    _number_of_entries++;
+    return result;
+  }
+
+  void grow() {
+    Slot* old_slots = _slots;
+    Entry* old_entries = _entries;
+    size_t old_capacity = _capacity;
+    allocate(old_capacity * 2);
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old_slots[i]._dist != 0) {
+        insert(old_slots[i]._hash, old_entries[i]._key, old_entries[i]._value);
+      }
+    }
+    release(old_slots, old_entries, old_capacity);
+  }
+
+ public:
+  OpenAddressingHashtable(size_t initial_capacity = 16) {
+    allocate(round_up_power_of_2(MAX2(initial_capacity, (size_t)8)));
+  }
+
+  ~OpenAddressingHashtable() {
+    release(_slots, _entries, _capacity);
+  }
+
+  size_t number_of_entries() const { return _number_of_entries; }
+
+  bool contains(K const& key) const {
+    return get(key) != NULL;
+  }
+
+  V* get(K const& key) const {
+    size_t index = lookup(HASH(key), key);
+    return index < _capacity ? &_entries[index]._value : NULL;
+  }
+
+ /**
+  * Inserts or replaces a value in the table.
+  * @return: true:  if a new item is added
+  *          false: if the item already existed and the value is updated
+  */
+  bool put(K const& key, V const& value) {
+    unsigned hv = HASH(key);
+    size_t index = lookup(hv, key);
+    if (index < _capacity) {
+      _entries[index]._value = value;
+      return false;
+    }
+    insert(hv, key, value);
+    return true;
+  }
+
+  // Look up the key.
+  // If an entry for the key exists, leave map unchanged and return a pointer to its value.
+  // If no entry for the key exists, create a new entry from key and a default-created value
+  //  and return a pointer to the value.
+  // *p_created is true if entry was created, false if entry pre-existed.
+  V* put_if_absent(K const& key, bool* p_created) {
+    return put_if_absent(key, V(), p_created);
+  }
+
+  // Look up the key.
+  // If an entry for the key exists, leave map unchanged and return a pointer to its value.
+  // If no entry for the key exists, create a new entry from key and value and return a
+  //  pointer to the value.
+  // *p_created is true if entry was created, false if entry pre-existed.
+  V* put_if_absent(K const& key, V const& value, bool* p_created) {
+    unsigned hv = HASH(key);
+    size_t index = lookup(hv, key);
+    *p_created = index == _capacity;
+    if (*p_created) {
+      index = insert(hv, key, value);
+    }
+    return &_entries[index]._value;
+  }
+
+  bool remove(K const& key) {
+    size_t index = lookup(HASH(key), key);
+    if (index == _capacity) {
+      return false;
+    }
+    // Shift the following entries that are away from their home back by
+    // one slot, up to an empty slot or an entry in its home slot.
+    for (size_t n = next(index); _slots[n]._dist > 1; n = next(n)) {
+      _entries[index] = _entries[n];
+      _slots[index] = _slots[n];
+      _slots[index]._dist--;
+      index = n;
+    }
+    _entries[index].~Entry();
+    _slots[index]._dist = 0;
+    _number_of_entries--;
+    return true;
+  }
+
+  // ITER contains bool do_entry(K const&, V const&), which will be
+  // called for each entry in the table.  If do_entry() returns false,
+  // the iteration is cancelled.
+  template<class ITER>
+  void iterate(ITER* iter) const {
+    for (size_t i = 0; i < _capacity; i++) {
+      if (_slots[i]._dist != 0) {
+        bool cont = iter->do_entry(_entries[i]._key, _entries[i]._value);
+        if (!cont) { return; }
+      }
+    }
+  }
+};
+
+#endif // SHARE_UTILITIES_OPENADDRESSINGHASH_HPP
@@ -78,6 +78,74 @@ Java_sun_nio_ch_EPoll_ctl(JNIEnv *env, jclass clazz, jint epfd,
     return (res == 0) ? 0 : errno;
 }
 
+/*
+ * An interest change as queued by the caller for ctlBatch.
+ */
+struct epoll_change {
+    jint opcode;
+    jint fd;
+    jint events;
+    jint error;     /* set by ctlBatch, 0 or errno */
+};
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_changeSize(JNIEnv* env, jclass clazz)
+{
+    return sizeof(struct epoll_change);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_changeOpcodeOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct epoll_change, opcode);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_changeFdOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct epoll_change, fd);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_changeEventsOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct epoll_change, events);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_changeErrorOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct epoll_change, error);
+}
+
+/*
+ * Applies count interest changes at address with one JNI transition. The
+ * events may include EPOLLET or EPOLLEXCLUSIVE. Each change's error field
+ * is set to 0 or the errno of its epoll_ctl call, and the number of failed
+ * changes is returned.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_ctlBatch(JNIEnv *env, jclass clazz, jint epfd,
+                               jlong address, jint count)
+{
+    struct epoll_change *changes = jlong_to_ptr(address);
+    struct epoll_event event;
+    jint failed = 0;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        event.events = changes[i].events;
+        event.data.fd = changes[i].fd;
+        if (epoll_ctl(epfd, (int)changes[i].opcode, (int)changes[i].fd, &event) == 0) {
+            changes[i].error = 0;
+        } else {
+            changes[i].error = errno;
+            failed++;
+        }
+    }
+    return failed;
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_EPoll_wait(JNIEnv *env, jclass clazz, jint epfd,
                            jlong address, jint numfds, jint timeout)
@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Native support for sun.nio.ch.IOUring, an io_uring instance used to
+ * batch reads, writes and polls into few system calls. The rings are set
+ * up and accessed with the raw system calls so that there is no
+ * dependency on liburing. If the kernel headers used for the build are
+ * too old, or the kernel does not support io_uring, isSupported returns
+ * false and the caller falls back to epoll.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "jni.h"
+#include "jni_util.h"
+#include "jvm.h"
+#include "jlong.h"
+#include "nio.h"
+#include "nio_util.h"
+
+#include "sun_nio_ch_IOUring.h"
+
+#if defined(__NR_io_uring_setup) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+/* IORING_OP_READ and IORING_OP_WRITE need Linux 5.6 headers */
+#ifdef IORING_FEAT_RW_CUR_POS
+#define HAVE_IO_URING
+#endif
+#endif
+#endif
+
+/*
+ * A completion as copied out to the caller's buffer by poll.
+ */
+struct completion {
+    jlong user_data;
+    jint res;
+    jint flags;
+};
+
+#ifdef HAVE_IO_URING
+
+struct ring {
+    int fd;
+    unsigned entries;
+
+    /* submission queue */
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    struct io_uring_sqe *sqes;
+    unsigned sq_local_tail;     /* entries up to here are prepared */
+    unsigned sq_to_submit;      /* prepared but not yet submitted */
+
+    /* completion queue */
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void *sq_ptr;
+    size_t sq_len;
+    void *cq_ptr;
+    size_t cq_len;
+    size_t sqes_len;
+};
+
+static int io_uring_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int io_uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static void unmap_rings(struct ring *r) {
+    if (r->sqes != NULL && r->sqes != MAP_FAILED) {
+        munmap(r->sqes, r->sqes_len);
+    }
+    if (r->cq_ptr != NULL && r->cq_ptr != MAP_FAILED && r->cq_ptr != r->sq_ptr) {
+        munmap(r->cq_ptr, r->cq_len);
+    }
+    if (r->sq_ptr != NULL && r->sq_ptr != MAP_FAILED) {
+        munmap(r->sq_ptr, r->sq_len);
+    }
+}
+
+static int map_rings(struct ring *r, struct io_uring_params *p) {
+    r->sq_len = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+    r->cq_len = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+    if (p->features & IORING_FEAT_SINGLE_MMAP) {
+        if (r->cq_len > r->sq_len) {
+            r->sq_len = r->cq_len;
+        }
+        r->cq_len = r->sq_len;
+    }
+
+    r->sq_ptr = mmap(NULL, r->sq_len, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    if (r->sq_ptr == MAP_FAILED) {
+        return -1;
+    }
+    if (p->features & IORING_FEAT_SINGLE_MMAP) {
+        r->cq_ptr = r->sq_ptr;
+    } else {
+        r->cq_ptr = mmap(NULL, r->cq_len, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_CQ_RING);
+        if (r->cq_ptr == MAP_FAILED) {
+            return -1;
+        }
+    }
+    r->sqes_len = p->sq_entries * sizeof(struct io_uring_sqe);
+    r->sqes = mmap(NULL, r->sqes_len, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+    if (r->sqes == MAP_FAILED) {
+        return -1;
+    }
+
+    r->sq_head  = (unsigned *)((char *)r->sq_ptr + p->sq_off.head);
+    r->sq_tail  = (unsigned *)((char *)r->sq_ptr + p->sq_off.tail);
+    r->sq_mask  = (unsigned *)((char *)r->sq_ptr + p->sq_off.ring_mask);
+    r->sq_array = (unsigned *)((char *)r->sq_ptr + p->sq_off.array);
+    r->cq_head  = (unsigned *)((char *)r->cq_ptr + p->cq_off.head);
+    r->cq_tail  = (unsigned *)((char *)r->cq_ptr + p->cq_off.tail);
+    r->cq_mask  = (unsigned *)((char *)r->cq_ptr + p->cq_off.ring_mask);
+    r->cqes     = (struct io_uring_cqe *)((char *)r->cq_ptr + p->cq_off.cqes);
+    r->sq_local_tail = *r->sq_tail;
+    r->entries = p->sq_entries;
+    return 0;
+}
+
+/*
+ * Returns the next free submission queue entry, cleared, or NULL if the
+ * submission queue is full.
+ */
+static struct io_uring_sqe *next_sqe(struct ring *r) {
+    unsigned head = __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE);
+    unsigned index;
+    struct io_uring_sqe *sqe;
+
+    if (r->sq_local_tail - head >= r->entries) {
+        return NULL;
+    }
+    index = r->sq_local_tail & *r->sq_mask;
+    sqe = &r->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    r->sq_array[index] = index;
+    r->sq_local_tail++;
+    r->sq_to_submit++;
+    return sqe;
+}
+
+static jint prep_rw(jlong ringAddress, int opcode, int fixed_opcode, jint fd,
+                    jboolean fixedFile, jlong address, jint len, jlong position,
+                    jint bufIndex, jlong userData)
+{
+    struct ring *r = jlong_to_ptr(ringAddress);
+    struct io_uring_sqe *sqe = next_sqe(r);
+    if (sqe == NULL) {
+        return IOS_UNAVAILABLE;
+    }
+    if (bufIndex >= 0) {
+        sqe->opcode = (__u8)fixed_opcode;
+        sqe->buf_index = (__u16)bufIndex;
+    } else {
+        sqe->opcode = (__u8)opcode;
+    }
+    sqe->flags = fixedFile ? IOSQE_FIXED_FILE : 0;
+    sqe->fd = fd;
+    sqe->addr = (__u64)(uintptr_t)jlong_to_ptr(address);
+    sqe->len = (__u32)len;
+    /* -1 uses and updates the current file position */
+    sqe->off = (__u64)position;
+    sqe->user_data = (__u64)userData;
+    return 0;
+}
+
+#endif /* HAVE_IO_URING */
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_completionSize(JNIEnv* env, jclass clazz)
+{
+    return sizeof(struct completion);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_userDataOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct completion, user_data);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_resultOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct completion, res);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_IOUring_isSupported(JNIEnv* env, jclass clazz)
+{
+#ifdef HAVE_IO_URING
+    struct io_uring_params p;
+    int fd;
+
+    memset(&p, 0, sizeof(p));
+    fd = io_uring_setup(1, &p);
+    if (fd < 0) {
+        /* ENOSYS on older kernels, EPERM if disabled by seccomp or sysctl */
+        return JNI_FALSE;
+    }
+    close(fd);
+    /* Without IORING_FEAT_NODROP completions can be lost under load */
+    return (p.features & IORING_FEAT_NODROP) ? JNI_TRUE : JNI_FALSE;
+#else
+    return JNI_FALSE;
+#endif
+}
+
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_IOUring_create(JNIEnv *env, jclass clazz, jint entries)
+{
+#ifdef HAVE_IO_URING
+    struct io_uring_params p;
+    struct ring *r = calloc(1, sizeof(struct ring));
+    if (r == NULL) {
+        JNU_ThrowOutOfMemoryError(env, "native heap");
+        return 0;
+    }
+    memset(&p, 0, sizeof(p));
+    r->fd = io_uring_setup((unsigned)entries, &p);
+    if (r->fd < 0) {
+        free(r);
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_setup failed");
+        return 0;
+    }
+    if (map_rings(r, &p) != 0) {
+        int err = errno;
+        unmap_rings(r);
+        close(r->fd);
+        free(r);
+        errno = err;
+        JNU_ThrowIOExceptionWithLastError(env, "mmap of io_uring rings failed");
+        return 0;
+    }
+    return ptr_to_jlong(r);
+#else
+    JNU_ThrowByName(env, "java/lang/UnsupportedOperationException",
+                    "io_uring not supported");
+    return 0;
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_IOUring_close(JNIEnv *env, jclass clazz, jlong ringAddress)
+{
+#ifdef HAVE_IO_URING
+    struct ring *r = jlong_to_ptr(ringAddress);
+    unmap_rings(r);
+    close(r->fd);
+    free(r);
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepRead(JNIEnv *env, jclass clazz, jlong ringAddress,
+                                 jint fd, jboolean fixedFile, jlong address, jint len,
+                                 jlong position, jint bufIndex, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep_rw(ringAddress, IORING_OP_READ, IORING_OP_READ_FIXED, fd, fixedFile,
+                   address, len, position, bufIndex, userData);
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepWrite(JNIEnv *env, jclass clazz, jlong ringAddress,
+                                  jint fd, jboolean fixedFile, jlong address, jint len,
+                                  jlong position, jint bufIndex, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    return prep_rw(ringAddress, IORING_OP_WRITE, IORING_OP_WRITE_FIXED, fd, fixedFile,
+                   address, len, position, bufIndex, userData);
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_prepPoll(JNIEnv *env, jclass clazz, jlong ringAddress,
+                                 jint fd, jint events, jlong userData)
+{
+#ifdef HAVE_IO_URING
+    struct ring *r = jlong_to_ptr(ringAddress);
+    struct io_uring_sqe *sqe = next_sqe(r);
+    if (sqe == NULL) {
+        return IOS_UNAVAILABLE;
+    }
+    /* One-shot, like an EPOLLONESHOT registration */
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll_events = (__u16)events;
+    sqe->user_data = (__u64)userData;
+    return 0;
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
+
+/*
+ * Submits all prepared entries with a single io_uring_enter and, if
+ * minComplete > 0, waits until that many completions are available.
+ * Returns the number of entries submitted.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_submit(JNIEnv *env, jclass clazz, jlong ringAddress,
+                               jint minComplete)
+{
+#ifdef HAVE_IO_URING
+    struct ring *r = jlong_to_ptr(ringAddress);
+    unsigned flags = (minComplete > 0) ? IORING_ENTER_GETEVENTS : 0;
+    int res;
+
+    /* Publish the prepared entries to the kernel */
+    __atomic_store_n(r->sq_tail, r->sq_local_tail, __ATOMIC_RELEASE);
+    if (r->sq_to_submit == 0 && minComplete <= 0) {
+        return 0;
+    }
+    res = io_uring_enter(r->fd, r->sq_to_submit, (unsigned)minComplete, flags);
+    if (res < 0) {
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        } else {
+            JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+            return IOS_THROWN;
+        }
+    }
+    r->sq_to_submit -= (unsigned)res;
+    return res;
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
+
+/*
+ * Copies up to max available completions to the array of struct
+ * completion at address, and returns how many were copied.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_poll(JNIEnv *env, jclass clazz, jlong ringAddress,
+                             jlong address, jint max)
+{
+#ifdef HAVE_IO_URING
+    struct ring *r = jlong_to_ptr(ringAddress);
+    struct completion *out = jlong_to_ptr(address);
+    unsigned head = *r->cq_head;
+    unsigned tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+    jint n = 0;
+
+    while (head != tail && n < max) {
+        struct io_uring_cqe *cqe = &r->cqes[head & *r->cq_mask];
+        out[n].user_data = (jlong)cqe->user_data;
+        out[n].res = (jint)cqe->res;
+        out[n].flags = (jint)cqe->flags;
+        n++;
+        head++;
+    }
+    /* Hand the consumed entries back to the kernel */
+    __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Registers the direct buffers described by count struct iovec at address
+ * for use with a bufIndex in prepRead and prepWrite. Returns 0 or errno.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_registerBuffers(JNIEnv *env, jclass clazz, jlong ringAddress,
+                                        jlong address, jint count)
+{
+#ifdef HAVE_IO_URING
+    struct ring *r = jlong_to_ptr(ringAddress);
+    int res = io_uring_register(r->fd, IORING_REGISTER_BUFFERS, jlong_to_ptr(address),
+                                (unsigned)count);
+    return (res == 0) ? 0 : errno;
+#else
+    return ENOSYS;
+#endif
+}
+
+/*
+ * Registers count file descriptors at address so that they can be used
+ * as fixed files, by index, in prepRead and prepWrite. Returns 0 or errno.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_registerFiles(JNIEnv *env, jclass clazz, jlong ringAddress,
+                                      jlong address, jint count)
+{
+#ifdef HAVE_IO_URING
+    struct ring *r = jlong_to_ptr(ringAddress);
+    int res = io_uring_register(r->fd, IORING_REGISTER_FILES, jlong_to_ptr(address),
+                                (unsigned)count);
+    return (res == 0) ? 0 : errno;
+#else
+    return ENOSYS;
+#endif
+}
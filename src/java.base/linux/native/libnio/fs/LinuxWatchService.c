@@ -29,6 +29,10 @@
 #include "jlong.h"
 
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
 #include <dlfcn.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -102,6 +106,90 @@ Java_sun_nio_fs_LinuxWatchService_inotifyRmWatch
         throwUnixException(env, errno);
 }
 
+/**
+ * Number of preceding events searched when coalescing a modify or attrib
+ * event, bounds the work per batch.
+ */
+#define COALESCE_WINDOW 64
+
+static int sameTarget(struct inotify_event* a, struct inotify_event* b) {
+    if (a->wd != b->wd || a->len != b->len)
+        return 0;
+    return a->len == 0 || strcmp(a->name, b->name) == 0;
+}
+
+/**
+ * Reads as many inotify events as are available into the buffer at
+ * address, draining the descriptor with further reads while there is room
+ * and it does not block. Repeated IN_MODIFY/IN_ATTRIB events for the same
+ * watch and name are dropped when the previous event kept for that target
+ * in this batch is identical, so a file being written in many small
+ * chunks produces one event per batch. Returns the number of bytes of
+ * events left in the buffer, or 0 if nothing was available.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_fs_LinuxWatchService_readEvents
+    (JNIEnv* env, jclass clazz, jint fd, jlong address, jint size)
+{
+    char* buf = (char*)jlong_to_ptr(address);
+    struct inotify_event* kept[COALESCE_WINDOW];
+    int nkept = 0;
+    size_t total = 0;
+    size_t out = 0;
+    size_t pos;
+
+    int nonblocking = (fcntl((int)fd, F_GETFL) & O_NONBLOCK) != 0;
+
+    /* drain; the first read may block if the descriptor is blocking */
+    do {
+        ssize_t n;
+        do {
+            n = read((int)fd, buf + total, (size_t)size - total);
+        } while (n == -1 && errno == EINTR);
+        if (n == -1) {
+            if (total == 0 && errno != EAGAIN) {
+                throwUnixException(env, errno);
+                return 0;
+            }
+            break;
+        }
+        if (n == 0)
+            break;
+        total += (size_t)n;
+    } while (nonblocking &&
+             total + sizeof(struct inotify_event) + NAME_MAX + 1 <= (size_t)size);
+
+    /* compact in place, dropping duplicate modify/attrib events */
+    for (pos = 0; pos < total; ) {
+        struct inotify_event* ev = (struct inotify_event*)(buf + pos);
+        size_t len = sizeof(struct inotify_event) + ev->len;
+        int drop = 0;
+        int i;
+
+        if ((ev->mask & ~(uint32_t)IN_ISDIR) == IN_MODIFY ||
+            (ev->mask & ~(uint32_t)IN_ISDIR) == IN_ATTRIB) {
+            for (i = nkept - 1; i >= 0; i--) {
+                if (sameTarget(kept[i], ev)) {
+                    drop = (kept[i]->mask == ev->mask);
+                    break;
+                }
+            }
+        }
+        if (!drop) {
+            if (out != pos)
+                memmove(buf + out, ev, len);
+            if (nkept == COALESCE_WINDOW) {
+                memmove(&kept[0], &kept[1], (COALESCE_WINDOW - 1) * sizeof(kept[0]));
+                nkept--;
+            }
+            kept[nkept++] = (struct inotify_event*)(buf + out);
+            out += len;
+        }
+        pos += len;
+    }
+    return (jint)out;
+}
+
 JNIEXPORT void JNICALL
 Java_sun_nio_fs_LinuxWatchService_configureBlocking
     (JNIEnv* env, jclass clazz, jint fd, jboolean blocking)
@@ -83,3 +83,13 @@ JNIEXPORT jboolean JNICALL
 Java_jdk_internal_misc_VM_isCDSSharingEnabled(JNIEnv *env, jclass jcls) {
     return JVM_IsCDSSharingEnabled(env);
 }
+
+JNIEXPORT jboolean JNICALL
+Java_jdk_internal_misc_VM_isDumpingClassList(JNIEnv *env, jclass jcls) {
+    return JVM_IsDumpingClassList(env);
+}
+
+JNIEXPORT void JNICALL
+Java_jdk_internal_misc_VM_logLambdaFormInvoker(JNIEnv *env, jclass jcls, jstring line) {
+    JVM_LogLambdaFormInvoker(env, line);
+}
@@ -166,8 +166,12 @@ void ImageDecompressor::decompress_resource(u1* compressed, u1* uncompressed,
         compressed_resource += 1;
         has_header = _header._magic == ResourceHeader::resource_header_magic;
         if (has_header) {
-            // decompressed_resource array contains the result of decompression
-            decompressed_resource = new u1[(size_t) _header._uncompressed_size];
+            // decompressed_resource array contains the result of decompression.
+            // The last decompressor of the stack produces a resource of the
+            // final size, so it decompresses straight into the caller's buffer.
+            bool into_result = _header._uncompressed_size == uncompressed_size;
+            decompressed_resource = into_result ?
+                uncompressed : new u1[(size_t) _header._uncompressed_size];
             // Retrieve the decompressor name
             const char* decompressor_name = strings->get(_header._decompressor_name_offset);
             assert(decompressor_name && "image decompressor not found");
@@ -180,11 +184,20 @@ void ImageDecompressor::decompress_resource(u1* compressed, u1* uncompressed,
             if (compressed_resource_base != compressed) {
                 delete[] compressed_resource_base;
             }
+            if (into_result && uncompressed_size >= 4 &&
+                    getU4(uncompressed, endian) == ResourceHeader::resource_header_magic) {
+                // A decompressor that did not change the size is followed by
+                // another one, which cannot decompress in place.
+                decompressed_resource = new u1[(size_t) uncompressed_size];
+                memcpy(decompressed_resource, uncompressed, (size_t) uncompressed_size);
+            }
             compressed_resource = decompressed_resource;
         }
     } while (has_header);
-    memcpy(uncompressed, decompressed_resource, (size_t) uncompressed_size);
-    delete[] decompressed_resource;
+    if (decompressed_resource != uncompressed) {
+        memcpy(uncompressed, decompressed_resource, (size_t) uncompressed_size);
+        delete[] decompressed_resource;
+    }
 }
 
 // Zip decompressor
@@ -276,16 +289,11 @@ void SharedStringDecompressor::decompress_resource(u1* data,
                             // the case where we have a package.
                             // reconstruct the type full name
                             if (str_length > 0) {
-                                int len = str_length + 1;
-                                char* fullpkg = new char[len];
-                                char* pkg_base = fullpkg;
-                                memcpy(fullpkg, pkg, str_length);
-                                fullpkg += str_length;
-                                *fullpkg = '/';
-                                memcpy(uncompressed_resource, pkg_base, len);
-                                uncompressed_resource += len;
-                                delete[] pkg_base;
-                                desc_length += len;
+                                memcpy(uncompressed_resource, pkg, str_length);
+                                uncompressed_resource += str_length;
+                                *uncompressed_resource = '/';
+                                uncompressed_resource++;
+                                desc_length += str_length + 1;
                             } else { // Empty package
                                 // Nothing to do.
                             }
@@ -45,6 +45,8 @@
 #include "emessages.h"
 
 #define MAX_ARGF_SIZE 0x7fffffffL
+#define ARGF_MIN_CHUNK 4096
+#define ARGF_MAX_CHUNK (1024 * 1024)
 
 static char* clone_substring(const char *begin, size_t len) {
     char *rv = (char *) JLI_MemAlloc(len + 1);
@@ -305,13 +307,27 @@ static char* nextToken(__ctx_args *pctx) {
     return NULL;
 }
 
-static JLI_List readArgFile(FILE *file) {
-    char buf[4096];
+/*
+ * Read an argument file of about file_size bytes. The whole file is read
+ * in one chunk when it is not larger than ARGF_MAX_CHUNK, so that a token
+ * such as a long class path is not split across reads and reassembled.
+ */
+static JLI_List readArgFile(FILE *file, size_t file_size) {
+    char *buf;
+    size_t buf_size;
     JLI_List rv;
     __ctx_args ctx;
     size_t size;
     char *token;
 
+    buf_size = file_size + 1;
+    if (buf_size < ARGF_MIN_CHUNK) {
+        buf_size = ARGF_MIN_CHUNK;
+    } else if (buf_size > ARGF_MAX_CHUNK) {
+        buf_size = ARGF_MAX_CHUNK;
+    }
+    buf = (char *) JLI_MemAlloc(buf_size);
+
     ctx.state = FIND_NEXT;
     ctx.parts = JLI_List_new(4);
     // initialize to avoid -Werror=maybe-uninitialized issues from gcc 7.3 onwards.
@@ -321,8 +337,9 @@ static JLI_List readArgFile(FILE *file) {
     rv = JLI_List_new(8);
 
     while (!feof(file)) {
-        size = fread(buf, sizeof(char), sizeof(buf), file);
+        size = fread(buf, sizeof(char), buf_size, file);
         if (ferror(file)) {
+            JLI_MemFree(buf);
             JLI_List_free(rv);
             return NULL;
         }
@@ -350,6 +367,7 @@ static JLI_List readArgFile(FILE *file) {
         }
     }
     JLI_List_free(ctx.parts);
+    JLI_MemFree(buf);
 
     return rv;
 }
@@ -382,7 +400,7 @@ static JLI_List expandArgFile(const char *arg) {
         exit(1);
     }
 
-    rv = readArgFile(fptr);
+    rv = readArgFile(fptr, (size_t) st.st_size);
     fclose(fptr);
 
     /* error occurred reading the file */
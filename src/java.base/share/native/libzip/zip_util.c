@@ -74,8 +74,6 @@ static void freeCEN(jzfile *);
 #define PATH_MAX 1024
 #endif
 
-static jint INITIAL_META_COUNT = 2;   /* initial number of entries in meta name array */
-
 /*
  * Declare library specific JNI_Onload entry if static build
  */
@@ -454,97 +452,12 @@ hash_append(unsigned int hash, char c)
     return ((int)hash)*31 + c;
 }
 
-/*
- * Returns true if the specified entry's name begins with the string
- * "META-INF/" irrespective of case.
- */
-static int
-isMetaName(const char *name, int length)
-{
-    const char *s;
-    if (length < (int)sizeof("META-INF/") - 1)
-        return 0;
-    for (s = "META-INF/"; *s != '\0'; s++) {
-        char c = *name++;
-        // Avoid toupper; it's locale-dependent
-        if (c >= 'a' && c <= 'z') c += 'A' - 'a';
-        if (*s != c)
-            return 0;
-    }
-    return 1;
-}
-
-/*
- * Increases the capacity of zip->metanames.
- * Returns non-zero in case of allocation error.
- */
-static int
-growMetaNames(jzfile *zip)
-{
-    jint i;
-    /* double the meta names array */
-    const jint new_metacount = zip->metacount << 1;
-    zip->metanames =
-        realloc(zip->metanames, new_metacount * sizeof(zip->metanames[0]));
-    if (zip->metanames == NULL) return -1;
-    for (i = zip->metacount; i < new_metacount; i++)
-        zip->metanames[i] = NULL;
-    zip->metacurrent = zip->metacount;
-    zip->metacount = new_metacount;
-    return 0;
-}
-
-/*
- * Adds name to zip->metanames.
- * Returns non-zero in case of allocation error.
- */
-static int
-addMetaName(jzfile *zip, const char *name, int length)
-{
-    jint i;
-    if (zip->metanames == NULL) {
-      zip->metacount = INITIAL_META_COUNT;
-      zip->metanames = calloc(zip->metacount, sizeof(zip->metanames[0]));
-      if (zip->metanames == NULL) return -1;
-      zip->metacurrent = 0;
-    }
-
-    i = zip->metacurrent;
-
-    /* current meta name array isn't full yet. */
-    if (i < zip->metacount) {
-      zip->metanames[i] = (char *) malloc(length+1);
-      if (zip->metanames[i] == NULL) return -1;
-      memcpy(zip->metanames[i], name, length);
-      zip->metanames[i][length] = '\0';
-      zip->metacurrent++;
-      return 0;
-    }
-
-    /* No free entries in zip->metanames? */
-    if (growMetaNames(zip) != 0) return -1;
-    return addMetaName(zip, name, length);
-}
-
-static void
-freeMetaNames(jzfile *zip)
-{
-    if (zip->metanames) {
-        jint i;
-        for (i = 0; i < zip->metacount; i++)
-            free(zip->metanames[i]);
-        free(zip->metanames);
-        zip->metanames = NULL;
-    }
-}
-
 /* Free Zip data allocated by readCEN() */
 static void
 freeCEN(jzfile *zip)
 {
     free(zip->entries); zip->entries = NULL;
     free(zip->table);   zip->table   = NULL;
-    freeMetaNames(zip);
 }
 
 /*
@@ -727,11 +640,6 @@ readCEN(jzfile *zip, jint knownTotal)
         if (cp + CENHDR + nlen > cenend) {
             ZIP_FORMAT_ERROR("invalid CEN header (bad header size)");
         }
-        /* if the entry is metadata add it to our metadata names */
-        if (isMetaName((char *)cp+CENHDR, nlen))
-            if (addMetaName(zip, (char *)cp+CENHDR, nlen) != 0)
-                goto Catch;
-
         /* Record the CEN offset and the name hash in our hash cell. */
         entries[i].cenpos = cenpos + (cp - cenbuf);
         entries[i].hash = hashN((char *)cp+CENHDR, nlen);
@@ -1215,6 +1123,19 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
             jzcell *zc = &zip->entries[idx];
 
             if (zc->hash == hsh) {
+#ifdef USE_MMAP
+                /*
+                 * The mapped CEN can be compared in place, so that a
+                 * hash collision does not allocate and free an entry.
+                 */
+                if (zip->usemmap) {
+                    char *cen = (char*) zip->maddr + zc->cenpos - zip->offset;
+                    if (!equals(cen + CENHDR, CENNAM(cen), name, ulen)) {
+                        idx = zc->next;
+                        continue;
+                    }
+                }
+#endif
                 /*
                  * OK, we've found a ZIP entry whose 32 bit hashcode
                  * matches the name we're looking for.  Try to read
@@ -1652,7 +1573,8 @@ ZIP_GZip_InitParams(size_t inLen, size_t* outLen, size_t* tmpLen, int level) {
   errorMsg = deflateInit2Wrapper(&strm, level);
 
   if (errorMsg == NULL) {
-    *outLen = (size_t) deflateBound(&strm, (uLong) inLen);
+    /* deflateBound() does not know about the member size subfield. */
+    *outLen = (size_t) deflateBound(&strm, (uLong) inLen) + 2 + GZIP_SIZE_EXTRA;
     deflateEnd(&strm);
   }
 
@@ -1664,6 +1586,7 @@ ZIP_GZip_Fully(char* inBuf, size_t inLen, char* outBuf, size_t outLen, char* tmp
                int level, char* comment, char const** pmsg) {
   z_stream strm;
   gz_header hdr;
+  Bytef extra[GZIP_SIZE_EXTRA];
   int err;
   char* block[] = {tmp, tmpLen + tmp};
   size_t result = 0;
@@ -1681,11 +1604,16 @@ ZIP_GZip_Fully(char* inBuf, size_t inLen, char* outBuf, size_t outLen, char* tmp
     strm.next_in = (Bytef *) inBuf;
     strm.avail_in = (uInt) inLen;
 
-    if (comment != NULL) {
-      memset(&hdr, 0, sizeof(hdr));
-      hdr.comment = (Bytef*) comment;
-      deflateSetHeader(&strm, &hdr);
-    }
+    /* Reserve the member size subfield; it is filled in below. */
+    memset(extra, 0, sizeof(extra));
+    extra[0] = GZIP_SIZE_SI1;
+    extra[1] = GZIP_SIZE_SI2;
+    extra[2] = GZIP_SIZE_LEN;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.extra = extra;
+    hdr.extra_len = sizeof(extra);
+    hdr.comment = (Bytef*) comment;
+    deflateSetHeader(&strm, &hdr);
 
     err = deflate(&strm, Z_FINISH);
 
@@ -1694,7 +1622,11 @@ ZIP_GZip_Fully(char* inBuf, size_t inLen, char* outBuf, size_t outLen, char* tmp
     } else if (err != Z_STREAM_END) {
       *pmsg = "Intern deflate error";
     } else {
+      int i;
       result = (size_t) strm.total_out;
+      for (i = 0; i < GZIP_SIZE_LEN; i++) {
+        outBuf[GZIP_SIZE_OFF + i] = (char) (((jlong) result >> (8 * i)) & 0xff);
+      }
     }
 
     deflateEnd(&strm);
@@ -145,6 +145,22 @@
 #define STORED      0
 #define DEFLATED    8
 
+/*
+ * Gzip members written by ZIP_GZip_Fully carry their compressed size,
+ * header and trailer included, as a little-endian 64-bit value in an
+ * extra field subfield. A reader can then find the members of a
+ * multi-member stream, and inflate them in parallel, without inflating
+ * the members before them.
+ */
+#define GZIP_HDR            10      /* fixed part of a gzip member header */
+#define GZIP_TRAILER        8       /* CRC-32 and ISIZE */
+#define GZIP_FEXTRA         0x04    /* FLG bit: extra field present */
+#define GZIP_SIZE_SI1       'J'     /* subfield ID of the member size */
+#define GZIP_SIZE_SI2       'S'
+#define GZIP_SIZE_LEN       8       /* length of the member size subfield data */
+#define GZIP_SIZE_EXTRA     (4 + GZIP_SIZE_LEN)   /* the whole subfield */
+#define GZIP_SIZE_OFF       (GZIP_HDR + 2 + 4)    /* member size, when it is the first subfield */
+
 /*
  * Support for reading ZIP/JAR files. Some things worth noting:
  *
@@ -228,10 +244,6 @@ typedef struct jzfile {   /* Zip file */
     jint tablelen;        /* number of hash heads */
     struct jzfile *next;  /* next zip file in search list */
     jzentry *cache;       /* we cache the most recently freed jzentry */
-    /* Information on metadata names in META-INF directory */
-    char **metanames;     /* array of meta names (may have null names) */
-    jint metacurrent;     /* the next empty slot in metanames array */
-    jint metacount;       /* number of slots in metanames array */
     jlong lastModified;   /* last modified time */
     jlong locpos;         /* position of first LOC header (usually 0) */
 } jzfile;
@@ -1365,6 +1365,23 @@ local uInt longest_match(s, cur_match)
         scan += 2, match++;
         Assert(*scan == *match, "match[2]?");
 
+#ifdef UNALIGNED64_OK
+        /* Compare eight bytes at a time, strstart+3..+10 up to
+         * strstart+251..+258, and find the first difference from the lowest
+         * set bit of the exclusive or. This reads the same bytes and gives
+         * the same length as the byte at a time loop below.
+         */
+        do {
+            unsigned long long scan_word, match_word;
+            zmemcpy(&scan_word, scan + 1, sizeof(scan_word));
+            zmemcpy(&match_word, match + 1, sizeof(match_word));
+            if (scan_word != match_word) {
+                scan += 1 + (__builtin_ctzll(scan_word ^ match_word) >> 3);
+                break;
+            }
+            scan += 8, match += 8;
+        } while (scan < strend);
+#else
         /* We check for insufficient lookahead only every 8th comparison;
          * the 256th check will be made at strstart+258.
          */
@@ -1374,6 +1391,7 @@ local uInt longest_match(s, cur_match)
                  *++scan == *++match && *++scan == *++match &&
                  *++scan == *++match && *++scan == *++match &&
                  scan < strend);
+#endif /* UNALIGNED64_OK */
 
         Assert(scan <= s->window+(unsigned)(s->window_size-1), "wild scan");
 
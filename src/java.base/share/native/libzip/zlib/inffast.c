@@ -274,12 +274,29 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                 }
                 else {
                     from = out - dist;          /* copy direct from output */
+#ifdef UNALIGNED64_OK
+                    if (dist >= 8) {            /* chunks do not overlap */
+                        while (len >= 8) {
+                            zmemcpy(out, from, 8);
+                            out += 8;
+                            from += 8;
+                            len -= 8;
+                        }
+                    }
+                    while (len > 2) {
+                        *out++ = *from++;
+                        *out++ = *from++;
+                        *out++ = *from++;
+                        len -= 3;
+                    }
+#else
                     do {                        /* minimum length is three */
                         *out++ = *from++;
                         *out++ = *from++;
                         *out++ = *from++;
                         len -= 3;
                     } while (len > 2);
+#endif
                     if (len) {
                         *out++ = *from++;
                         if (len > 1)
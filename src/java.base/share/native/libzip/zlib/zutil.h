@@ -257,6 +257,19 @@ extern z_const char * const z_errmsg[10]; /* indexed by 2-zlib_error */
    void ZLIB_INTERNAL zmemzero OF((Bytef* dest, uInt len));
 #endif
 
+/* Compare and copy eight bytes at a time in deflate's longest_match() and
+ * inflate_fast(), where unaligned 64-bit loads are cheap and an 8 byte
+ * zmemcpy() compiles to a single load or store. Both produce exactly the
+ * same results as the byte at a time loops. Define NO_UNALIGNED64 to use
+ * the byte at a time loops everywhere.
+ */
+#if !defined(NO_UNALIGNED64) && defined(HAVE_MEMCPY) && \
+    !defined(SMALL_MEDIUM) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__aarch64__)) && \
+    defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define UNALIGNED64_OK
+#endif
+
 /* Diagnostic functions */
 #ifdef ZLIB_DEBUG
 #  include <stdio.h>
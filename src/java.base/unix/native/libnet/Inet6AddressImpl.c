@@ -30,6 +30,7 @@
 #include <sys/types.h>
 #include <netinet/in.h>
 #include <netinet/icmp6.h>
+#include <pthread.h>
 
 #if defined(_ALLBSD_SOURCE)
 #include <ifaddrs.h>
@@ -197,6 +198,164 @@ lookupIfLocalhost(JNIEnv *env, const char *hostname, jboolean includeV6)
 }
 #endif
 
+/*
+ * Converts the result of getaddrinfo for host into an array of InetAddress
+ * objects, without duplicates and in the order of the address preference.
+ * Returns NULL or leaves an exception pending on failure.
+ */
+static jobjectArray
+addrinfoToInetAddresses(JNIEnv *env, jstring host, struct addrinfo *res)
+{
+    jobjectArray ret = NULL;
+    struct addrinfo *resNew = NULL, *last = NULL, *iterator;
+    int i = 0, inetCount = 0, inet6Count = 0, inetIndex = 0,
+        inet6Index = 0, originalIndex = 0;
+    int addressPreference =
+        (*env)->GetStaticIntField(env, ia_class, ia_preferIPv6AddressID);;
+    iterator = res;
+    while (iterator != NULL) {
+        // skip duplicates
+        int skip = 0;
+        struct addrinfo *iteratorNew = resNew;
+        while (iteratorNew != NULL) {
+            if (iterator->ai_family == iteratorNew->ai_family &&
+                iterator->ai_addrlen == iteratorNew->ai_addrlen) {
+                if (iteratorNew->ai_family == AF_INET) { /* AF_INET */
+                    struct sockaddr_in *addr1, *addr2;
+                    addr1 = (struct sockaddr_in *)iterator->ai_addr;
+                    addr2 = (struct sockaddr_in *)iteratorNew->ai_addr;
+                    if (addr1->sin_addr.s_addr == addr2->sin_addr.s_addr) {
+                        skip = 1;
+                        break;
+                    }
+                } else {
+                    int t;
+                    struct sockaddr_in6 *addr1, *addr2;
+                    addr1 = (struct sockaddr_in6 *)iterator->ai_addr;
+                    addr2 = (struct sockaddr_in6 *)iteratorNew->ai_addr;
+
+                    for (t = 0; t < 16; t++) {
+                        if (addr1->sin6_addr.s6_addr[t] !=
+                            addr2->sin6_addr.s6_addr[t]) {
+                            break;
+                        }
+                    }
+                    if (t < 16) {
+                        iteratorNew = iteratorNew->ai_next;
+                        continue;
+                    } else {
+                        skip = 1;
+                        break;
+                    }
+                }
+            } else if (iterator->ai_family != AF_INET &&
+                       iterator->ai_family != AF_INET6) {
+                // we can't handle other family types
+                skip = 1;
+                break;
+            }
+            iteratorNew = iteratorNew->ai_next;
+        }
+
+        if (!skip) {
+            struct addrinfo *next
+                = (struct addrinfo *)malloc(sizeof(struct addrinfo));
+            if (!next) {
+                JNU_ThrowOutOfMemoryError(env, "Native heap allocation failed");
+                ret = NULL;
+                goto cleanupAndReturn;
+            }
+            memcpy(next, iterator, sizeof(struct addrinfo));
+            next->ai_next = NULL;
+            if (resNew == NULL) {
+                resNew = next;
+            } else {
+                last->ai_next = next;
+            }
+            last = next;
+            i++;
+            if (iterator->ai_family == AF_INET) {
+                inetCount++;
+            } else if (iterator->ai_family == AF_INET6) {
+                inet6Count++;
+            }
+        }
+        iterator = iterator->ai_next;
+    }
+
+    // allocate array - at this point i contains the number of addresses
+    ret = (*env)->NewObjectArray(env, i, ia_class, NULL);
+    if (IS_NULL(ret)) {
+        /* we may have memory to free at the end of this */
+        goto cleanupAndReturn;
+    }
+
+    if (addressPreference == java_net_InetAddress_PREFER_IPV6_VALUE) {
+        inetIndex = inet6Count;
+        inet6Index = 0;
+    } else if (addressPreference == java_net_InetAddress_PREFER_IPV4_VALUE) {
+        inetIndex = 0;
+        inet6Index = inetCount;
+    } else if (addressPreference == java_net_InetAddress_PREFER_SYSTEM_VALUE) {
+        inetIndex = inet6Index = originalIndex = 0;
+    }
+
+    iterator = resNew;
+    while (iterator != NULL) {
+        if (iterator->ai_family == AF_INET) {
+            jobject iaObj = (*env)->NewObject(env, ia4_class, ia4_ctrID);
+            if (IS_NULL(iaObj)) {
+                ret = NULL;
+                goto cleanupAndReturn;
+            }
+            setInetAddress_addr(env, iaObj, ntohl(((struct sockaddr_in*)iterator->ai_addr)->sin_addr.s_addr));
+            if ((*env)->ExceptionCheck(env))
+                goto cleanupAndReturn;
+            setInetAddress_hostName(env, iaObj, host);
+            if ((*env)->ExceptionCheck(env))
+                goto cleanupAndReturn;
+            (*env)->SetObjectArrayElement(env, ret, (inetIndex | originalIndex), iaObj);
+            (*env)->DeleteLocalRef(env, iaObj);
+            inetIndex++;
+        } else if (iterator->ai_family == AF_INET6) {
+            jint scope = 0;
+            jboolean ret1;
+            jobject iaObj = (*env)->NewObject(env, ia6_class, ia6_ctrID);
+            if (IS_NULL(iaObj)) {
+                ret = NULL;
+                goto cleanupAndReturn;
+            }
+            ret1 = setInet6Address_ipaddress(env, iaObj, (char *)&(((struct sockaddr_in6*)iterator->ai_addr)->sin6_addr));
+            if (ret1 == JNI_FALSE) {
+                ret = NULL;
+                goto cleanupAndReturn;
+            }
+            scope = ((struct sockaddr_in6 *)iterator->ai_addr)->sin6_scope_id;
+            if (scope != 0) { // zero is default value, no need to set
+                setInet6Address_scopeid(env, iaObj, scope);
+            }
+            setInetAddress_hostName(env, iaObj, host);
+            if ((*env)->ExceptionCheck(env))
+                goto cleanupAndReturn;
+            (*env)->SetObjectArrayElement(env, ret, (inet6Index | originalIndex), iaObj);
+            (*env)->DeleteLocalRef(env, iaObj);
+            inet6Index++;
+        }
+        if (addressPreference == java_net_InetAddress_PREFER_SYSTEM_VALUE) {
+            originalIndex++;
+            inetIndex = inet6Index = 0;
+        }
+        iterator = iterator->ai_next;
+    }
+cleanupAndReturn:
+    while (resNew != NULL) {
+        last = resNew;
+        resNew = resNew->ai_next;
+        free(last);
+    }
+    return ret;
+}
+
 /*
  * Class:     java_net_Inet6AddressImpl
  * Method:    lookupAllHostAddr
@@ -208,8 +367,7 @@ Java_java_net_Inet6AddressImpl_lookupAllHostAddr(JNIEnv *env, jobject this,
     jobjectArray ret = NULL;
     const char *hostname;
     int error = 0;
-    struct addrinfo hints, *res = NULL, *resNew = NULL, *last = NULL,
-        *iterator;
+    struct addrinfo hints, *res = NULL;
 
     initInetAddressIDs(env);
     JNU_CHECK_EXCEPTION_RETURN(env, NULL);
@@ -240,154 +398,174 @@ Java_java_net_Inet6AddressImpl_lookupAllHostAddr(JNIEnv *env, jobject this,
         NET_ThrowUnknownHostExceptionWithGaiError(env, hostname, error);
         goto cleanupAndReturn;
     } else {
-        int i = 0, inetCount = 0, inet6Count = 0, inetIndex = 0,
-            inet6Index = 0, originalIndex = 0;
-        int addressPreference =
-            (*env)->GetStaticIntField(env, ia_class, ia_preferIPv6AddressID);;
-        iterator = res;
-        while (iterator != NULL) {
-            // skip duplicates
-            int skip = 0;
-            struct addrinfo *iteratorNew = resNew;
-            while (iteratorNew != NULL) {
-                if (iterator->ai_family == iteratorNew->ai_family &&
-                    iterator->ai_addrlen == iteratorNew->ai_addrlen) {
-                    if (iteratorNew->ai_family == AF_INET) { /* AF_INET */
-                        struct sockaddr_in *addr1, *addr2;
-                        addr1 = (struct sockaddr_in *)iterator->ai_addr;
-                        addr2 = (struct sockaddr_in *)iteratorNew->ai_addr;
-                        if (addr1->sin_addr.s_addr == addr2->sin_addr.s_addr) {
-                            skip = 1;
-                            break;
-                        }
-                    } else {
-                        int t;
-                        struct sockaddr_in6 *addr1, *addr2;
-                        addr1 = (struct sockaddr_in6 *)iterator->ai_addr;
-                        addr2 = (struct sockaddr_in6 *)iteratorNew->ai_addr;
-
-                        for (t = 0; t < 16; t++) {
-                            if (addr1->sin6_addr.s6_addr[t] !=
-                                addr2->sin6_addr.s6_addr[t]) {
-                                break;
-                            }
-                        }
-                        if (t < 16) {
-                            iteratorNew = iteratorNew->ai_next;
-                            continue;
-                        } else {
-                            skip = 1;
-                            break;
-                        }
-                    }
-                } else if (iterator->ai_family != AF_INET &&
-                           iterator->ai_family != AF_INET6) {
-                    // we can't handle other family types
-                    skip = 1;
-                    break;
-                }
-                iteratorNew = iteratorNew->ai_next;
-            }
+        ret = addrinfoToInetAddresses(env, host, res);
+    }
+cleanupAndReturn:
+    JNU_ReleaseStringPlatformChars(env, host, hostname);
+    if (res != NULL) {
+        freeaddrinfo(res);
+    }
+    return ret;
+}
 
-            if (!skip) {
-                struct addrinfo *next
-                    = (struct addrinfo *)malloc(sizeof(struct addrinfo));
-                if (!next) {
-                    JNU_ThrowOutOfMemoryError(env, "Native heap allocation failed");
-                    ret = NULL;
-                    goto cleanupAndReturn;
-                }
-                memcpy(next, iterator, sizeof(struct addrinfo));
-                next->ai_next = NULL;
-                if (resNew == NULL) {
-                    resNew = next;
-                } else {
-                    last->ai_next = next;
-                }
-                last = next;
-                i++;
-                if (iterator->ai_family == AF_INET) {
-                    inetCount++;
-                } else if (iterator->ai_family == AF_INET6) {
-                    inet6Count++;
-                }
-            }
-            iterator = iterator->ai_next;
+/*
+ * The host names of a batch lookup are resolved by the calling thread and
+ * up to LOOKUP_MAX_THREADS helper threads, which take the next unresolved
+ * name until none are left.
+ */
+#define LOOKUP_MAX_THREADS 16
+
+typedef struct {
+    pthread_mutex_t lock;
+    int next;                   /* index of the next name to resolve */
+    int count;
+    char **hostnames;
+    struct addrinfo **results;
+    int *errors;
+} lookupBatch;
+
+static void
+lookupBatchRun(lookupBatch *batch)
+{
+    struct addrinfo hints;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_flags = AI_CANONNAME;
+    hints.ai_family = AF_UNSPEC;
+
+    for (;;) {
+        int i;
+        pthread_mutex_lock(&batch->lock);
+        i = batch->next++;
+        pthread_mutex_unlock(&batch->lock);
+        if (i >= batch->count) {
+            return;
         }
+        batch->errors[i] = getaddrinfo(batch->hostnames[i], NULL, &hints,
+                                       &batch->results[i]);
+    }
+}
+
+static void *
+lookupBatchThread(void *arg)
+{
+    lookupBatchRun((lookupBatch *)arg);
+    return NULL;
+}
+
+/*
+ * Class:     java_net_Inet6AddressImpl
+ * Method:    lookupAllHostAddrs
+ * Signature: ([Ljava/lang/String;)[[Ljava/net/InetAddress;
+ *
+ * Resolves several host names concurrently, so that a caller with many
+ * names waits for the slowest lookup rather than for the sum of all of
+ * them. The result holds the addresses of each host, as returned by
+ * lookupAllHostAddr, or null for a host that could not be resolved.
+ */
+JNIEXPORT jobjectArray JNICALL
+Java_java_net_Inet6AddressImpl_lookupAllHostAddrs(JNIEnv *env, jobject this,
+                                                  jobjectArray hosts) {
+    jobjectArray ret = NULL;
+    jclass iaArrayClass;
+    lookupBatch batch;
+    pthread_t threads[LOOKUP_MAX_THREADS];
+    int nthreads, i;
+
+    initInetAddressIDs(env);
+    JNU_CHECK_EXCEPTION_RETURN(env, NULL);
 
-        // allocate array - at this point i contains the number of addresses
-        ret = (*env)->NewObjectArray(env, i, ia_class, NULL);
-        if (IS_NULL(ret)) {
-            /* we may have memory to free at the end of this */
+    if (IS_NULL(hosts)) {
+        JNU_ThrowNullPointerException(env, "hosts argument is null");
+        return NULL;
+    }
+
+    memset(&batch, 0, sizeof(batch));
+    batch.count = (*env)->GetArrayLength(env, hosts);
+    batch.hostnames = (char **)calloc(batch.count + 1, sizeof(char *));
+    batch.results = (struct addrinfo **)calloc(batch.count + 1, sizeof(struct addrinfo *));
+    batch.errors = (int *)calloc(batch.count + 1, sizeof(int));
+    if (batch.hostnames == NULL || batch.results == NULL || batch.errors == NULL) {
+        JNU_ThrowOutOfMemoryError(env, "Native heap allocation failed");
+        goto cleanupAndReturn;
+    }
+
+    for (i = 0; i < batch.count; i++) {
+        jstring host = (jstring)(*env)->GetObjectArrayElement(env, hosts, i);
+        const char *hostname;
+        if (IS_NULL(host)) {
+            JNU_ThrowNullPointerException(env, "host argument is null");
+            goto cleanupAndReturn;
+        }
+        hostname = JNU_GetStringPlatformChars(env, host, JNI_FALSE);
+        if (hostname == NULL) {
             goto cleanupAndReturn;
         }
+        batch.hostnames[i] = strdup(hostname);
+        JNU_ReleaseStringPlatformChars(env, host, hostname);
+        (*env)->DeleteLocalRef(env, host);
+        if (batch.hostnames[i] == NULL) {
+            JNU_ThrowOutOfMemoryError(env, "Native heap allocation failed");
+            goto cleanupAndReturn;
+        }
+    }
 
-        if (addressPreference == java_net_InetAddress_PREFER_IPV6_VALUE) {
-            inetIndex = inet6Count;
-            inet6Index = 0;
-        } else if (addressPreference == java_net_InetAddress_PREFER_IPV4_VALUE) {
-            inetIndex = 0;
-            inet6Index = inetCount;
-        } else if (addressPreference == java_net_InetAddress_PREFER_SYSTEM_VALUE) {
-            inetIndex = inet6Index = originalIndex = 0;
+    // The calling thread takes part, so one name needs no helper threads,
+    // and a failure to start threads only reduces the concurrency.
+    pthread_mutex_init(&batch.lock, NULL);
+    for (nthreads = 0; nthreads < batch.count - 1 && nthreads < LOOKUP_MAX_THREADS; nthreads++) {
+        if (pthread_create(&threads[nthreads], NULL, lookupBatchThread, &batch) != 0) {
+            break;
         }
+    }
+    lookupBatchRun(&batch);
+    while (nthreads > 0) {
+        pthread_join(threads[--nthreads], NULL);
+    }
+    pthread_mutex_destroy(&batch.lock);
 
-        iterator = resNew;
-        while (iterator != NULL) {
-            if (iterator->ai_family == AF_INET) {
-                jobject iaObj = (*env)->NewObject(env, ia4_class, ia4_ctrID);
-                if (IS_NULL(iaObj)) {
-                    ret = NULL;
-                    goto cleanupAndReturn;
-                }
-                setInetAddress_addr(env, iaObj, ntohl(((struct sockaddr_in*)iterator->ai_addr)->sin_addr.s_addr));
-                if ((*env)->ExceptionCheck(env))
-                    goto cleanupAndReturn;
-                setInetAddress_hostName(env, iaObj, host);
-                if ((*env)->ExceptionCheck(env))
-                    goto cleanupAndReturn;
-                (*env)->SetObjectArrayElement(env, ret, (inetIndex | originalIndex), iaObj);
-                inetIndex++;
-            } else if (iterator->ai_family == AF_INET6) {
-                jint scope = 0;
-                jboolean ret1;
-                jobject iaObj = (*env)->NewObject(env, ia6_class, ia6_ctrID);
-                if (IS_NULL(iaObj)) {
-                    ret = NULL;
-                    goto cleanupAndReturn;
-                }
-                ret1 = setInet6Address_ipaddress(env, iaObj, (char *)&(((struct sockaddr_in6*)iterator->ai_addr)->sin6_addr));
-                if (ret1 == JNI_FALSE) {
-                    ret = NULL;
-                    goto cleanupAndReturn;
-                }
-                scope = ((struct sockaddr_in6 *)iterator->ai_addr)->sin6_scope_id;
-                if (scope != 0) { // zero is default value, no need to set
-                    setInet6Address_scopeid(env, iaObj, scope);
-                }
-                setInetAddress_hostName(env, iaObj, host);
-                if ((*env)->ExceptionCheck(env))
-                    goto cleanupAndReturn;
-                (*env)->SetObjectArrayElement(env, ret, (inet6Index | originalIndex), iaObj);
-                inet6Index++;
-            }
-            if (addressPreference == java_net_InetAddress_PREFER_SYSTEM_VALUE) {
-                originalIndex++;
-                inetIndex = inet6Index = 0;
-            }
-            iterator = iterator->ai_next;
+    iaArrayClass = (*env)->FindClass(env, "[Ljava/net/InetAddress;");
+    if (iaArrayClass == NULL) {
+        goto cleanupAndReturn;
+    }
+    ret = (*env)->NewObjectArray(env, batch.count, iaArrayClass, NULL);
+    if (IS_NULL(ret)) {
+        goto cleanupAndReturn;
+    }
+    for (i = 0; i < batch.count; i++) {
+        jobjectArray addrs = NULL;
+        if (batch.errors[i] == 0) {
+            jstring host = (jstring)(*env)->GetObjectArrayElement(env, hosts, i);
+            addrs = addrinfoToInetAddresses(env, host, batch.results[i]);
+            (*env)->DeleteLocalRef(env, host);
+        }
+#if defined(MACOSX)
+        else {
+            addrs = lookupIfLocalhost(env, batch.hostnames[i], JNI_TRUE);
+        }
+#endif
+        if ((*env)->ExceptionCheck(env)) {
+            ret = NULL;
+            goto cleanupAndReturn;
+        }
+        if (addrs != NULL) {
+            (*env)->SetObjectArrayElement(env, ret, i, addrs);
+            (*env)->DeleteLocalRef(env, addrs);
         }
     }
+
 cleanupAndReturn:
-    JNU_ReleaseStringPlatformChars(env, host, hostname);
-    while (resNew != NULL) {
-        last = resNew;
-        resNew = resNew->ai_next;
-        free(last);
-    }
-    if (res != NULL) {
-        freeaddrinfo(res);
+    for (i = 0; i < batch.count; i++) {
+        if (batch.hostnames != NULL) {
+            free(batch.hostnames[i]);
+        }
+        if (batch.results != NULL && batch.results[i] != NULL) {
+            freeaddrinfo(batch.results[i]);
+        }
     }
+    free(batch.hostnames);
+    free(batch.results);
+    free(batch.errors);
     return ret;
 }
 
@@ -34,6 +34,26 @@
 #include <netinet/in.h>
 #endif
 
+#if defined(__linux__)
+#include <stdint.h>
+#include <sys/uio.h>
+#include <netinet/udp.h>
+
+/* UDP segmentation offload, not defined by older headers */
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif
+
+/* Upper bound on the datagrams moved by one receiveBatch0/sendBatch0 call */
+#define MAX_BATCH 64
+
 #include "jni.h"
 #include "jni_util.h"
 #include "jlong.h"
@@ -153,3 +173,207 @@ Java_sun_nio_ch_DatagramChannelImpl_send0(JNIEnv *env, jclass clazz,
     }
     return n;
 }
+
+#if defined(__linux__)
+
+/*
+ * Returns the UDP_GRO segment size in the control data of a received
+ * message, or 0 if the kernel did not coalesce the datagram.
+ */
+static jint
+gro_segment_size(struct msghdr *m)
+{
+    struct cmsghdr *cmsg;
+    for (cmsg = CMSG_FIRSTHDR(m); cmsg != NULL; cmsg = CMSG_NXTHDR(m, cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int size;
+            memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+            return (jint)size;
+        }
+    }
+    return 0;
+}
+
+#endif
+
+/*
+ * Receives up to count datagrams with one recvmmsg call. Datagram i is
+ * read into the buffer described by the i-th struct iovec at iovAddress,
+ * its sender is stored in the i-th SOCKETADDRESS at senderAddresses and
+ * its length in the i-th jint at lengthsAddress. If segSizesAddress is
+ * not 0 and UDP_GRO is enabled on the socket, the i-th jint there is set
+ * to the size of the segments coalesced into datagram i, or 0. Returns the
+ * number of datagrams received, or 0 if count is not positive. The iovecs
+ * are not modified. A blocking socket waits for the first datagram only.
+ * Other platforms return IOS_UNSUPPORTED_CASE so that callers fall back to
+ * receive0.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_receiveBatch0(JNIEnv *env, jclass clazz,
+                                                  jobject fdo, jlong iovAddress,
+                                                  jint count, jlong senderAddresses,
+                                                  jlong lengthsAddress,
+                                                  jlong segSizesAddress,
+                                                  jboolean connected)
+{
+#if defined(__linux__)
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(iovAddress);
+    SOCKETADDRESS *sa = (SOCKETADDRESS *)jlong_to_ptr(senderAddresses);
+    jint *lengths = (jint *)jlong_to_ptr(lengthsAddress);
+    jint *segSizes = (jint *)jlong_to_ptr(segSizesAddress);
+    struct iovec vecs[MAX_BATCH];
+    struct mmsghdr msgs[MAX_BATCH];
+    union {
+        char buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control[MAX_BATCH];
+    int i, n;
+
+    if (count <= 0) {
+        return 0;
+    }
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+
+    memset(msgs, 0, count * sizeof(struct mmsghdr));
+    for (i = 0; i < count; i++) {
+        vecs[i] = iov[i];
+        if (vecs[i].iov_len > MAX_PACKET_LEN) {
+            vecs[i].iov_len = MAX_PACKET_LEN;
+        }
+        msgs[i].msg_hdr.msg_iov = &vecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &sa[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(SOCKETADDRESS);
+        if (segSizes != NULL) {
+            msgs[i].msg_hdr.msg_control = control[i].buf;
+            msgs[i].msg_hdr.msg_controllen = sizeof(control[i].buf);
+        }
+    }
+
+    for (;;) {
+        n = recvmmsg(fd, msgs, (unsigned int)count, MSG_WAITFORONE, NULL);
+        if (n >= 0) {
+            break;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        }
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        }
+        if (errno == ECONNREFUSED) {
+            if (connected == JNI_FALSE) {
+                continue;
+            }
+            JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+            return IOS_THROWN;
+        }
+        if (errno == ENOSYS) {
+            return IOS_UNSUPPORTED_CASE;
+        }
+        return handleSocketError(env, errno);
+    }
+
+    for (i = 0; i < n; i++) {
+        lengths[i] = (jint)msgs[i].msg_len;
+        if (segSizes != NULL) {
+            segSizes[i] = gro_segment_size(&msgs[i].msg_hdr);
+        }
+    }
+    return n;
+#else
+    return IOS_UNSUPPORTED_CASE;
+#endif
+}
+
+/*
+ * Sends up to count datagrams with one sendmmsg call. Datagram i is the
+ * buffer described by the i-th struct iovec at iovAddress and goes to the
+ * i-th SOCKETADDRESS at targetAddresses, or to the connected peer if
+ * targetAddresses is 0. If segmentSize is greater than 0, each buffer is
+ * split by the kernel into datagrams of that size with UDP_SEGMENT, so a
+ * single message can carry many packets for the same destination. Returns
+ * the number of messages sent, or 0 if count is not positive. The iovecs
+ * are not modified. Other platforms, and kernels without sendmmsg or UDP
+ * segmentation offload, return IOS_UNSUPPORTED_CASE so that callers fall
+ * back to send0.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_sendBatch0(JNIEnv *env, jclass clazz,
+                                               jobject fdo, jlong iovAddress,
+                                               jint count, jlong targetAddresses,
+                                               jint targetAddressLen,
+                                               jint segmentSize)
+{
+#if defined(__linux__)
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(iovAddress);
+    SOCKETADDRESS *sa = (SOCKETADDRESS *)jlong_to_ptr(targetAddresses);
+    struct iovec vecs[MAX_BATCH];
+    struct mmsghdr msgs[MAX_BATCH];
+    union {
+        char buf[CMSG_SPACE(sizeof(uint16_t))];
+        struct cmsghdr align;
+    } control[MAX_BATCH];
+    int i, n;
+
+    if (count <= 0) {
+        return 0;
+    }
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+    if (segmentSize < 0 || segmentSize > UINT16_MAX) {
+        return IOS_UNSUPPORTED_CASE;
+    }
+
+    memset(msgs, 0, count * sizeof(struct mmsghdr));
+    for (i = 0; i < count; i++) {
+        vecs[i] = iov[i];
+        msgs[i].msg_hdr.msg_iov = &vecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (sa != NULL) {
+            msgs[i].msg_hdr.msg_name = &sa[i];
+            msgs[i].msg_hdr.msg_namelen = (socklen_t)targetAddressLen;
+        }
+        if (segmentSize > 0) {
+            uint16_t size = (uint16_t)segmentSize;
+            struct cmsghdr *cmsg;
+            memset(control[i].buf, 0, sizeof(control[i].buf));
+            msgs[i].msg_hdr.msg_control = control[i].buf;
+            msgs[i].msg_hdr.msg_controllen = sizeof(control[i].buf);
+            cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(size));
+            memcpy(CMSG_DATA(cmsg), &size, sizeof(size));
+        } else if (vecs[i].iov_len > MAX_PACKET_LEN) {
+            vecs[i].iov_len = MAX_PACKET_LEN;
+        }
+    }
+
+    n = sendmmsg(fd, msgs, (unsigned int)count, 0);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        }
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        }
+        if (errno == ECONNREFUSED) {
+            JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+            return IOS_THROWN;
+        }
+        if (errno == ENOSYS || (segmentSize > 0 && (errno == EINVAL || errno == EIO))) {
+            return IOS_UNSUPPORTED_CASE;
+        }
+        return handleSocketError(env, errno);
+    }
+    return n;
+#else
+    return IOS_UNSUPPORTED_CASE;
+#endif
+}
@@ -30,6 +30,7 @@
 #include <unistd.h>
 
 #if defined(__linux__)
+#include <pthread.h>
 #include <sys/sendfile.h>
 #elif defined(_AIX)
 #include <string.h>
@@ -252,3 +253,132 @@ Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
 #endif
 }
 
+#if defined(__linux__)
+
+/*
+ * Each thread that splices keeps a pipe in thread-local storage, so that
+ * transfers do not pay for creating one. It is closed when the thread
+ * exits.
+ */
+static pthread_key_t splice_pipe_key;
+static pthread_once_t splice_pipe_once = PTHREAD_ONCE_INIT;
+static int splice_pipe_key_created = 0;
+
+static void
+close_splice_pipe(void *value)
+{
+    int *fds = (int *)value;
+    close(fds[0]);
+    close(fds[1]);
+    free(fds);
+}
+
+static void
+create_splice_pipe_key(void)
+{
+    splice_pipe_key_created = pthread_key_create(&splice_pipe_key, close_splice_pipe) == 0;
+}
+
+static int *
+splice_pipe(void)
+{
+    int *fds;
+    pthread_once(&splice_pipe_once, create_splice_pipe_key);
+    if (!splice_pipe_key_created) {
+        return NULL;
+    }
+    fds = pthread_getspecific(splice_pipe_key);
+    if (fds == NULL) {
+        fds = malloc(2 * sizeof(int));
+        if (fds == NULL) {
+            return NULL;
+        }
+        if (pipe2(fds, O_CLOEXEC) != 0) {
+            free(fds);
+            return NULL;
+        }
+        if (pthread_setspecific(splice_pipe_key, fds) != 0) {
+            close_splice_pipe(fds);
+            return NULL;
+        }
+    }
+    return fds;
+}
+
+static void
+discard_splice_pipe(int *fds)
+{
+    pthread_setspecific(splice_pipe_key, NULL);
+    close_splice_pipe(fds);
+}
+
+#endif
+
+/*
+ * Moves up to count bytes from srcFDO to dstFDO without copying them to
+ * user space, through a pipe with two splice calls. Either side can be a
+ * socket, a pipe or a file; a position of -1 means the descriptor has no
+ * position (or its current one is used). This is the zero-copy path for
+ * socket to socket and socket to file transfers, which sendfile does not
+ * support. The destination must be in blocking mode: bytes that were
+ * taken from the source but cannot be written are lost with an exception.
+ */
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileChannelImpl_splice0(JNIEnv *env, jobject this,
+                                        jobject srcFDO, jlong srcPosition,
+                                        jobject dstFDO, jlong dstPosition,
+                                        jlong count)
+{
+#if defined(__linux__)
+    jint srcFD = fdval(env, srcFDO);
+    jint dstFD = fdval(env, dstFDO);
+    loff_t srcOffset = (loff_t)srcPosition;
+    loff_t dstOffset = (loff_t)dstPosition;
+    int *fds = splice_pipe();
+    ssize_t n, remaining;
+
+    if (fds == NULL) {
+        return IOS_UNSUPPORTED_CASE;
+    }
+
+    n = splice(srcFD, srcPosition >= 0 ? &srcOffset : NULL, fds[1], NULL,
+               (size_t)count, SPLICE_F_MOVE | SPLICE_F_MORE);
+    if (n < 0) {
+        if (errno == EAGAIN)
+            return IOS_UNAVAILABLE;
+        if (errno == EINVAL)
+            return IOS_UNSUPPORTED_CASE;
+        if (errno == EINTR)
+            return IOS_INTERRUPTED;
+        JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+        return IOS_THROWN;
+    }
+    if (n == 0) {
+        return IOS_EOF;
+    }
+
+    /*
+     * Drain the pipe completely so it is empty for the next transfer. No
+     * SPLICE_F_MORE here: whether more data follows is unknown, and for a
+     * socket destination it would hold back the end of the data like
+     * MSG_MORE.
+     */
+    remaining = n;
+    while (remaining > 0) {
+        ssize_t m = splice(fds[0], NULL, dstFD, dstPosition >= 0 ? &dstOffset : NULL,
+                           (size_t)remaining, SPLICE_F_MOVE);
+        if (m < 0 && errno == EINTR) {
+            continue;
+        }
+        if (m <= 0) {
+            discard_splice_pipe(fds);
+            JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+            return IOS_THROWN;
+        }
+        remaining -= m;
+    }
+    return n;
+#else
+    return IOS_UNSUPPORTED_CASE;
+#endif
+}
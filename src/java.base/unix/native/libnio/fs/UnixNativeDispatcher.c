@@ -815,6 +815,139 @@ Java_sun_nio_fs_UnixNativeDispatcher_readdir(JNIEnv* env, jclass this, jlong val
     }
 }
 
+/**
+ * Reads as many directory entries as fit into the native buffer at
+ * bufAddress. Each entry is written as a one byte d_type (DT_UNKNOWN when
+ * the file system or platform does not provide it) followed by the NUL
+ * terminated name; "." and ".." are skipped. Returns the number of bytes
+ * written, or 0 at the end of the directory. The C library already fills
+ * its getdents buffer a page at a time, so this mainly saves the JNI
+ * transition and byte[] allocation per entry.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_fs_UnixNativeDispatcher_readdirBatch(JNIEnv* env, jclass this,
+    jlong value, jlong bufAddress, jint bufSize)
+{
+    DIR* dirp = jlong_to_ptr(value);
+    char* buf = (char*)jlong_to_ptr(bufAddress);
+    jint used = 0;
+
+    for (;;) {
+        struct dirent* ptr;
+        size_t len;
+        long pos = telldir(dirp);
+
+        errno = 0;
+        ptr = readdir(dirp);
+        if (ptr == NULL) {
+            if (errno != 0) {
+                throwUnixException(env, errno);
+            }
+            break;
+        }
+        if (ptr->d_name[0] == '.' &&
+            (ptr->d_name[1] == '\0' ||
+             (ptr->d_name[1] == '.' && ptr->d_name[2] == '\0'))) {
+            continue;
+        }
+        len = strlen(ptr->d_name);
+        if ((size_t)(bufSize - used) < len + 2) {
+            if (used == 0) {
+                throwUnixException(env, ENAMETOOLONG);
+            } else {
+                /* does not fit, hand it out on the next call */
+                seekdir(dirp, pos);
+            }
+            break;
+        }
+#ifdef DT_UNKNOWN
+        buf[used] = (char)ptr->d_type;
+#else
+        buf[used] = 0;
+#endif
+        memcpy(buf + used + 1, ptr->d_name, len + 1);
+        used += (jint)(len + 2);
+    }
+    return used;
+}
+
+/**
+ * Layout of the per-entry attribute record written by fstatatBatch, in
+ * jlongs. A non-zero errno slot means the other slots are undefined.
+ */
+enum {
+    BATCH_ATTRS_ERRNO = 0,
+    BATCH_ATTRS_MODE,
+    BATCH_ATTRS_INO,
+    BATCH_ATTRS_DEV,
+    BATCH_ATTRS_RDEV,
+    BATCH_ATTRS_NLINK,
+    BATCH_ATTRS_UID,
+    BATCH_ATTRS_GID,
+    BATCH_ATTRS_SIZE,
+    BATCH_ATTRS_ATIME_SEC,
+    BATCH_ATTRS_ATIME_NSEC,
+    BATCH_ATTRS_MTIME_SEC,
+    BATCH_ATTRS_MTIME_NSEC,
+    BATCH_ATTRS_CTIME_SEC,
+    BATCH_ATTRS_CTIME_NSEC,
+    BATCH_ATTRS_SLOTS
+};
+
+/**
+ * Stats count names relative to dfd in one call. The names are packed
+ * NUL terminated at namesAddress, as produced by readdirBatch without the
+ * d_type byte. Failures are reported per entry in the errno slot rather
+ * than thrown, since entries commonly vanish during a tree walk. Returns
+ * the size of one record in jlongs.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_fs_UnixNativeDispatcher_fstatatBatch(JNIEnv* env, jclass this,
+    jint dfd, jlong namesAddress, jint count, jint flag, jlong attrsAddress)
+{
+    const char* name = (const char*)jlong_to_ptr(namesAddress);
+    jlong* attrs = (jlong*)jlong_to_ptr(attrsAddress);
+    jint i;
+
+    if (my_fstatat64_func == NULL) {
+        JNU_ThrowInternalError(env, "should not reach here");
+        return 0;
+    }
+    for (i = 0; i < count; i++, attrs += BATCH_ATTRS_SLOTS) {
+        struct stat64 buf;
+        int err;
+
+        RESTARTABLE((*my_fstatat64_func)((int)dfd, name, &buf, (int)flag), err);
+        name += strlen(name) + 1;
+        if (err == -1) {
+            attrs[BATCH_ATTRS_ERRNO] = (jlong)errno;
+            continue;
+        }
+        attrs[BATCH_ATTRS_ERRNO] = 0;
+        attrs[BATCH_ATTRS_MODE] = (jlong)buf.st_mode;
+        attrs[BATCH_ATTRS_INO] = (jlong)buf.st_ino;
+        attrs[BATCH_ATTRS_DEV] = (jlong)buf.st_dev;
+        attrs[BATCH_ATTRS_RDEV] = (jlong)buf.st_rdev;
+        attrs[BATCH_ATTRS_NLINK] = (jlong)buf.st_nlink;
+        attrs[BATCH_ATTRS_UID] = (jlong)buf.st_uid;
+        attrs[BATCH_ATTRS_GID] = (jlong)buf.st_gid;
+        attrs[BATCH_ATTRS_SIZE] = (jlong)buf.st_size;
+        attrs[BATCH_ATTRS_ATIME_SEC] = (jlong)buf.st_atime;
+        attrs[BATCH_ATTRS_MTIME_SEC] = (jlong)buf.st_mtime;
+        attrs[BATCH_ATTRS_CTIME_SEC] = (jlong)buf.st_ctime;
+#ifndef MACOSX
+        attrs[BATCH_ATTRS_ATIME_NSEC] = (jlong)buf.st_atim.tv_nsec;
+        attrs[BATCH_ATTRS_MTIME_NSEC] = (jlong)buf.st_mtim.tv_nsec;
+        attrs[BATCH_ATTRS_CTIME_NSEC] = (jlong)buf.st_ctim.tv_nsec;
+#else
+        attrs[BATCH_ATTRS_ATIME_NSEC] = (jlong)buf.st_atimespec.tv_nsec;
+        attrs[BATCH_ATTRS_MTIME_NSEC] = (jlong)buf.st_mtimespec.tv_nsec;
+        attrs[BATCH_ATTRS_CTIME_NSEC] = (jlong)buf.st_ctimespec.tv_nsec;
+#endif
+    }
+    return BATCH_ATTRS_SLOTS;
+}
+
 JNIEXPORT void JNICALL
 Java_sun_nio_fs_UnixNativeDispatcher_mkdir0(JNIEnv* env, jclass this,
     jlong pathAddress, jint mode)
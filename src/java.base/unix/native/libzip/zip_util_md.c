@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Multi-threaded gzip compression and decompression.
+ *
+ * ZIP_GZip_Parallel splits its input into blocks and deflates them on
+ * worker threads. Each block is primed with the 32K of input before it
+ * and ends on a byte boundary (Z_SYNC_FLUSH), so the concatenated blocks
+ * form a single raw deflate stream and the result is one ordinary gzip
+ * member.
+ *
+ * ZIP_GUnzip_Parallel inflates a multi-member gzip stream. Members that
+ * carry their size (see GZIP_SIZE_SI1 in zip_util.h) are inflated on
+ * worker threads; any other member is inflated in order while scanning.
+ *
+ * Like the other ZIP_GZip functions these are looked up by name.
+ */
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jni.h"
+#include "zip_util.h"
+#include <zlib.h>
+
+#define GZIP_WINDOW         32768         /* deflate dictionary size */
+#define GZIP_DEF_BLOCK      (128 * 1024)  /* default ZIP_GZip_Parallel block size */
+#define GZIP_MAX_BLOCK      (1 << 30)     /* keeps block lengths within uInt */
+#define GZIP_MAX_THREADS    64
+
+#define GZIP_FCOMMENT       0x10          /* FLG bit: comment present */
+#define GZIP_OS_UNIX        3
+
+/*
+ * Runs work(arg) on up to threads threads, the calling thread included.
+ * If a thread cannot be created the work is done by fewer threads.
+ */
+static void
+run_workers(void* (*work)(void*), void* arg, int threads) {
+    pthread_t tids[GZIP_MAX_THREADS];
+    int started = 0;
+    int i;
+
+    for (i = 1; i < threads && i < GZIP_MAX_THREADS; i++) {
+        if (pthread_create(&tids[started], NULL, work, arg) == 0) {
+            started++;
+        }
+    }
+
+    work(arg);
+
+    for (i = 0; i < started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+}
+
+static void
+put_le32(Bytef* p, uLong v) {
+    p[0] = (Bytef) (v & 0xff);
+    p[1] = (Bytef) ((v >> 8) & 0xff);
+    p[2] = (Bytef) ((v >> 16) & 0xff);
+    p[3] = (Bytef) ((v >> 24) & 0xff);
+}
+
+static uLong
+get_le32(const Bytef* p) {
+    return (uLong) p[0] | ((uLong) p[1] << 8) | ((uLong) p[2] << 16) | ((uLong) p[3] << 24);
+}
+
+/* Shared state of a ZIP_GZip_Parallel call. */
+typedef struct {
+    const Bytef* in;
+    size_t inLen;
+    size_t blockLen;
+    size_t blocks;
+    int level;
+    Bytef** out;        /* deflated blocks, malloc'd by the workers */
+    size_t* outLens;
+    uLong* crcs;
+    size_t next;        /* next block to deflate, guarded by lock */
+    char const* msg;    /* first error, guarded by lock */
+    pthread_mutex_t lock;
+} ParallelDeflate;
+
+static char const*
+deflate_block(ParallelDeflate* pd, size_t i) {
+    size_t start = i * pd->blockLen;
+    size_t len = pd->inLen - start < pd->blockLen ? pd->inLen - start : pd->blockLen;
+    int last = i == pd->blocks - 1;
+    z_stream strm;
+    size_t bound;
+    int err;
+
+    memset(&strm, 0, sizeof(z_stream));
+    err = deflateInit2(&strm, pd->level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+
+    if (err == Z_MEM_ERROR) {
+        return "Out of memory in deflateInit2";
+    } else if (err != Z_OK) {
+        return "Internal error in deflateInit2";
+    }
+
+    if (start > 0) {
+        size_t dictLen = start < GZIP_WINDOW ? start : GZIP_WINDOW;
+
+        if (deflateSetDictionary(&strm, pd->in + start - dictLen, (uInt) dictLen) != Z_OK) {
+            deflateEnd(&strm);
+            return "Internal error in deflateSetDictionary";
+        }
+    }
+
+    /* Leave room for the sync flush marker as well. */
+    bound = (size_t) deflateBound(&strm, (uLong) len) + 64;
+    pd->out[i] = (Bytef*) malloc(bound);
+
+    if (pd->out[i] == NULL) {
+        deflateEnd(&strm);
+        return "Out of memory";
+    }
+
+    strm.next_in = (Bytef*) pd->in + start;
+    strm.avail_in = (uInt) len;
+    strm.next_out = pd->out[i];
+    strm.avail_out = (uInt) bound;
+
+    err = deflate(&strm, last ? Z_FINISH : Z_SYNC_FLUSH);
+    pd->outLens[i] = bound - strm.avail_out;
+    deflateEnd(&strm);
+
+    if (last ? err != Z_STREAM_END : (err != Z_OK || strm.avail_in != 0 || strm.avail_out == 0)) {
+        return "Intern deflate error";
+    }
+
+    pd->crcs[i] = crc32(crc32(0L, Z_NULL, 0), pd->in + start, (uInt) len);
+
+    return NULL;
+}
+
+static void*
+deflate_worker(void* arg) {
+    ParallelDeflate* pd = (ParallelDeflate*) arg;
+
+    for (;;) {
+        size_t i;
+        char const* msg;
+
+        pthread_mutex_lock(&pd->lock);
+
+        if (pd->msg != NULL || pd->next >= pd->blocks) {
+            pthread_mutex_unlock(&pd->lock);
+            return NULL;
+        }
+
+        i = pd->next++;
+        pthread_mutex_unlock(&pd->lock);
+
+        msg = deflate_block(pd, i);
+
+        if (msg != NULL) {
+            pthread_mutex_lock(&pd->lock);
+
+            if (pd->msg == NULL) {
+                pd->msg = msg;
+            }
+
+            pthread_mutex_unlock(&pd->lock);
+        }
+    }
+}
+
+/*
+ * Returns an output size that is always large enough for
+ * ZIP_GZip_Parallel with the given input length, block length and
+ * comment.
+ */
+JNIEXPORT size_t
+ZIP_GZip_ParallelBound(size_t inLen, size_t blockLen, char* comment) {
+    size_t blocks;
+
+    if (blockLen == 0) {
+        blockLen = GZIP_DEF_BLOCK;
+    } else if (blockLen > GZIP_MAX_BLOCK) {
+        blockLen = GZIP_MAX_BLOCK;
+    }
+
+    blocks = inLen == 0 ? 1 : (inLen + blockLen - 1) / blockLen;
+
+    /* Stored blocks plus a sync flush marker for every block. */
+    return inLen + ((inLen + 7) >> 3) + ((inLen + 63) >> 6) + 16 * blocks +
+           GZIP_HDR + GZIP_TRAILER + (comment != NULL ? strlen(comment) + 1 : 0);
+}
+
+/*
+ * Compresses inBuf into a single gzip member in outBuf, deflating blocks
+ * of blockLen bytes (a default is used for 0) on up to threads threads.
+ * Returns the size of the gzip data, or 0 with *pmsg set on error.
+ */
+JNIEXPORT size_t
+ZIP_GZip_Parallel(char* inBuf, size_t inLen, char* outBuf, size_t outLen, int level,
+                  size_t blockLen, int threads, char* comment, char const** pmsg) {
+    ParallelDeflate pd;
+    size_t commentLen = comment != NULL ? strlen(comment) + 1 : 0;
+    size_t result = 0;
+    size_t i;
+
+    *pmsg = NULL;
+
+    if (blockLen == 0) {
+        blockLen = GZIP_DEF_BLOCK;
+    } else if (blockLen > GZIP_MAX_BLOCK) {
+        blockLen = GZIP_MAX_BLOCK;
+    }
+
+    memset(&pd, 0, sizeof(pd));
+    pd.in = (const Bytef*) inBuf;
+    pd.inLen = inLen;
+    pd.blockLen = blockLen;
+    pd.blocks = inLen == 0 ? 1 : (inLen + blockLen - 1) / blockLen;
+    pd.level = level >= 0 && level <= 9 ? level : Z_DEFAULT_COMPRESSION;
+    pd.out = (Bytef**) calloc(pd.blocks, sizeof(Bytef*));
+    pd.outLens = (size_t*) calloc(pd.blocks, sizeof(size_t));
+    pd.crcs = (uLong*) calloc(pd.blocks, sizeof(uLong));
+
+    if (pd.out == NULL || pd.outLens == NULL || pd.crcs == NULL) {
+        *pmsg = "Out of memory";
+    } else if (pthread_mutex_init(&pd.lock, NULL) != 0) {
+        *pmsg = "Cannot create mutex";
+    } else {
+        run_workers(deflate_worker, &pd, threads);
+        pthread_mutex_destroy(&pd.lock);
+        *pmsg = pd.msg;
+    }
+
+    if (*pmsg == NULL) {
+        size_t total = GZIP_HDR + commentLen + GZIP_TRAILER;
+
+        for (i = 0; i < pd.blocks; i++) {
+            total += pd.outLens[i];
+        }
+
+        if (total > outLen) {
+            *pmsg = "Buffer too small";
+        }
+    }
+
+    if (*pmsg == NULL) {
+        Bytef* out = (Bytef*) outBuf;
+        uLong crc = pd.crcs[0];
+
+        memset(out, 0, GZIP_HDR);
+        out[0] = 0x1f;
+        out[1] = 0x8b;
+        out[2] = Z_DEFLATED;
+        out[3] = comment != NULL ? GZIP_FCOMMENT : 0;
+        out[8] = pd.level == 9 ? 2 : (pd.level == 1 ? 4 : 0);
+        out[9] = GZIP_OS_UNIX;
+        result = GZIP_HDR;
+
+        if (comment != NULL) {
+            memcpy(out + result, comment, commentLen);
+            result += commentLen;
+        }
+
+        for (i = 0; i < pd.blocks; i++) {
+            memcpy(out + result, pd.out[i], pd.outLens[i]);
+            result += pd.outLens[i];
+
+            if (i > 0) {
+                crc = crc32_combine(crc, pd.crcs[i], (z_off_t) (inLen - i * blockLen < blockLen ?
+                                                                inLen - i * blockLen : blockLen));
+            }
+        }
+
+        put_le32(out + result, crc);
+        put_le32(out + result + 4, (uLong) (inLen & 0xffffffff));
+        result += GZIP_TRAILER;
+    }
+
+    if (pd.out != NULL) {
+        for (i = 0; i < pd.blocks; i++) {
+            free(pd.out[i]);
+        }
+    }
+
+    free(pd.out);
+    free(pd.outLens);
+    free(pd.crcs);
+
+    return result;
+}
+
+/*
+ * Inflates the gzip member at in, which must fit into outLen bytes, and
+ * stores the number of bytes consumed and produced.
+ */
+static char const*
+inflate_member(Bytef* in, size_t inLen, Bytef* out, size_t outLen,
+               size_t* inUsed, size_t* outUsed) {
+    z_stream strm;
+    size_t inLeft = inLen;
+    size_t outLeft = outLen;
+    int err;
+
+    memset(&strm, 0, sizeof(z_stream));
+    err = inflateInit2(&strm, MAX_WBITS + 16);
+
+    if (err == Z_MEM_ERROR) {
+        return "Out of memory in inflateInit2";
+    } else if (err != Z_OK) {
+        return "Internal error in inflateInit2";
+    }
+
+    strm.next_in = in;
+    strm.next_out = out;
+
+    do {
+        if (strm.avail_in == 0) {
+            strm.avail_in = (uInt) (inLeft < UINT_MAX ? inLeft : UINT_MAX);
+            inLeft -= strm.avail_in;
+        }
+
+        if (strm.avail_out == 0) {
+            strm.avail_out = (uInt) (outLeft < UINT_MAX ? outLeft : UINT_MAX);
+            outLeft -= strm.avail_out;
+        }
+
+        err = inflate(&strm, Z_NO_FLUSH);
+    } while (err == Z_OK || (err == Z_BUF_ERROR &&
+                             ((strm.avail_in == 0 && inLeft > 0) ||
+                              (strm.avail_out == 0 && outLeft > 0))));
+
+    *inUsed = inLen - inLeft - strm.avail_in;
+    *outUsed = outLen - outLeft - strm.avail_out;
+    inflateEnd(&strm);
+
+    if (err == Z_STREAM_END) {
+        return NULL;
+    } else if (err == Z_MEM_ERROR) {
+        return "Out of memory in inflate";
+    } else if (err == Z_BUF_ERROR && strm.avail_out == 0 && outLeft == 0) {
+        return "Buffer too small";
+    }
+
+    return "Invalid gzip data";
+}
+
+/*
+ * Returns the size recorded in the gzip member at in, or 0 if it has
+ * none or it is not plausible.
+ */
+static size_t
+sized_member_length(const Bytef* in, size_t inLen) {
+    size_t size = 0;
+    int i;
+
+    if (inLen < GZIP_SIZE_OFF + GZIP_SIZE_LEN ||
+        in[0] != 0x1f || in[1] != 0x8b || in[2] != Z_DEFLATED ||
+        (in[3] & GZIP_FEXTRA) == 0 ||
+        in[GZIP_HDR] + (in[GZIP_HDR + 1] << 8) < GZIP_SIZE_EXTRA ||
+        in[GZIP_HDR + 2] != GZIP_SIZE_SI1 || in[GZIP_HDR + 3] != GZIP_SIZE_SI2 ||
+        in[GZIP_HDR + 4] != GZIP_SIZE_LEN || in[GZIP_HDR + 5] != 0) {
+        return 0;
+    }
+
+    for (i = GZIP_SIZE_LEN - 1; i >= 0; i--) {
+        size = (size << 8) | in[GZIP_SIZE_OFF + i];
+    }
+
+    if (size < GZIP_SIZE_OFF + GZIP_SIZE_LEN + GZIP_TRAILER || size > inLen) {
+        return 0;
+    }
+
+    return size;
+}
+
+typedef struct {
+    size_t inOff;
+    size_t inLen;
+    size_t outOff;
+    size_t outLen;
+} SizedMember;
+
+/* Shared state of a ZIP_GUnzip_Parallel call. */
+typedef struct {
+    Bytef* in;
+    Bytef* out;
+    SizedMember* members;
+    size_t count;
+    size_t next;        /* next member to inflate, guarded by lock */
+    char const* msg;    /* first error, guarded by lock */
+    pthread_mutex_t lock;
+} ParallelInflate;
+
+static void*
+inflate_worker(void* arg) {
+    ParallelInflate* pi = (ParallelInflate*) arg;
+
+    for (;;) {
+        SizedMember* m;
+        size_t inUsed;
+        size_t outUsed;
+        char const* msg;
+
+        pthread_mutex_lock(&pi->lock);
+
+        if (pi->msg != NULL || pi->next >= pi->count) {
+            pthread_mutex_unlock(&pi->lock);
+            return NULL;
+        }
+
+        m = &pi->members[pi->next++];
+        pthread_mutex_unlock(&pi->lock);
+
+        msg = inflate_member(pi->in + m->inOff, m->inLen, pi->out + m->outOff, m->outLen,
+                             &inUsed, &outUsed);
+
+        if (msg == NULL && (inUsed != m->inLen || outUsed != m->outLen)) {
+            msg = "Invalid gzip data";
+        }
+
+        if (msg != NULL) {
+            pthread_mutex_lock(&pi->lock);
+
+            if (pi->msg == NULL) {
+                pi->msg = msg;
+            }
+
+            pthread_mutex_unlock(&pi->lock);
+        }
+    }
+}
+
+/*
+ * Decompresses the (possibly multi-member) gzip stream in inBuf into
+ * outBuf, using up to threads threads for members that carry their size.
+ * Returns the size of the decompressed data, or 0 with *pmsg set on error.
+ */
+JNIEXPORT size_t
+ZIP_GUnzip_Parallel(char* inBuf, size_t inLen, char* outBuf, size_t outLen, int threads,
+                    char const** pmsg) {
+    ParallelInflate pi;
+    size_t capacity = 0;
+    size_t inPos = 0;
+    size_t outPos = 0;
+
+    *pmsg = NULL;
+    memset(&pi, 0, sizeof(pi));
+    pi.in = (Bytef*) inBuf;
+    pi.out = (Bytef*) outBuf;
+
+    while (*pmsg == NULL && inPos < inLen) {
+        size_t size = sized_member_length(pi.in + inPos, inLen - inPos);
+
+        if (size > 0) {
+            size_t isize = (size_t) get_le32(pi.in + inPos + size - 4);
+
+            if (pi.count == capacity) {
+                size_t newCapacity = capacity == 0 ? 64 : 2 * capacity;
+                SizedMember* members = (SizedMember*) realloc(pi.members,
+                                                              newCapacity * sizeof(SizedMember));
+
+                if (members == NULL) {
+                    *pmsg = "Out of memory";
+                    break;
+                }
+
+                pi.members = members;
+                capacity = newCapacity;
+            }
+
+            if (isize > outLen - outPos) {
+                *pmsg = "Buffer too small";
+                break;
+            }
+
+            pi.members[pi.count].inOff = inPos;
+            pi.members[pi.count].inLen = size;
+            pi.members[pi.count].outOff = outPos;
+            pi.members[pi.count].outLen = isize;
+            pi.count++;
+            inPos += size;
+            outPos += isize;
+        } else {
+            size_t inUsed;
+            size_t outUsed;
+
+            *pmsg = inflate_member(pi.in + inPos, inLen - inPos, pi.out + outPos,
+                                   outLen - outPos, &inUsed, &outUsed);
+            inPos += inUsed;
+            outPos += outUsed;
+        }
+    }
+
+    if (*pmsg == NULL && pi.count > 0) {
+        if (pthread_mutex_init(&pi.lock, NULL) != 0) {
+            *pmsg = "Cannot create mutex";
+        } else {
+            run_workers(inflate_worker, &pi, threads);
+            pthread_mutex_destroy(&pi.lock);
+            *pmsg = pi.msg;
+        }
+    }
+
+    free(pi.members);
+
+    return *pmsg == NULL ? outPos : 0;
+}
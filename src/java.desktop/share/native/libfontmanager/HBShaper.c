@@ -25,6 +25,7 @@
 
 #include <jni_util.h>
 #include <stdlib.h>
+#include <string.h>
 #include "hb.h"
 #include "hb-jdk.h"
 #include "hb-ot.h"
@@ -227,6 +228,199 @@ JDKFontInfo*
     return fi;
 }
 
+/*
+ * Cache of shaping results.  Applications such as report generators lay
+ * out the same strings over and over, and most of the cost of that is in
+ * HarfBuzz and in the Java upcalls it makes for glyph metrics.
+ *
+ * The result of shaping a run depends on the face, the strike (which
+ * supplies the advances and carries the rendering hints), the size and
+ * transform, the script and flags, and the text of the run together with
+ * the few characters of context HarfBuzz looks at on either side.  All of
+ * that makes up the key; the strike is held by a weak reference so that
+ * the cache doesn't keep strikes alive.  Entries are direct mapped by a
+ * hash of the key and replaced on collision, which bounds the memory used
+ * to SHAPE_CACHE_SIZE runs of at most SHAPE_CACHE_MAX_CHARS characters.
+ *
+ * The cache is guarded by the monitor of the SunLayoutEngine class, which
+ * is only held to look up, copy and insert entries, never while shaping.
+ */
+
+#define SHAPE_CACHE_SIZE      256   /* entries, must be a power of 2 */
+#define SHAPE_CACHE_MAX_CHARS 128   /* longest run that is cached */
+#define SHAPE_CONTEXT_LENGTH  5     /* HB_BUFFER_CONTEXT_LENGTH */
+
+typedef struct ShapeKey_Struct {
+    jlong pFace;
+    jfloat ptSize;
+    jfloat matrix[4];
+    jint script;
+    jint flags;
+    jint runStart;        /* start of the run within text */
+    jint runLength;
+    jint textLength;      /* the run and its context */
+    const jchar* text;
+    unsigned int hash;
+} ShapeKey;
+
+/*
+ * A result is a single malloc block: this header is followed by the
+ * glyph infos, the glyph positions and, for cached entries, the text.
+ * Glyph clusters are stored relative to the start of the run.
+ */
+typedef struct ShapeResult_Struct {
+    size_t size;
+    int glyphCount;
+    float devScale;
+    hb_glyph_info_t* glyphInfo;
+    hb_glyph_position_t* glyphPos;
+    jchar* text;
+} ShapeResult;
+
+typedef struct ShapeCacheEntry_Struct {
+    jweak fontStrike;
+    ShapeKey key;
+    ShapeResult* result;
+} ShapeCacheEntry;
+
+static ShapeCacheEntry shapeCache[SHAPE_CACHE_SIZE];
+
+static void initShapeKey(ShapeKey* key, jlong pFace, JDKFontInfo* fi,
+                         jint script, jint flags, const jchar* chars,
+                         jsize len, jint offset, jint limit) {
+    jint start = offset - SHAPE_CONTEXT_LENGTH;
+    jint end = limit + SHAPE_CONTEXT_LENGTH;
+    unsigned int h = 2166136261u;
+    int i;
+
+    if (start < 0) {
+        start = 0;
+    }
+    if (end > len) {
+        end = len;
+    }
+    memset(key, 0, sizeof(ShapeKey));
+    key->pFace = pFace;
+    key->ptSize = fi->ptSize;
+    memcpy(key->matrix, fi->matrix, sizeof(key->matrix));
+    key->script = script;
+    key->flags = flags;
+    key->runStart = offset - start;
+    key->runLength = limit - offset;
+    key->textLength = end - start;
+    key->text = chars + start;
+
+    for (i = 0; i < key->textLength; i++) {
+        h = (h ^ key->text[i]) * 16777619u;
+    }
+    h = (h ^ (unsigned int)key->runStart) * 16777619u;
+    h = (h ^ (unsigned int)key->script) * 16777619u;
+    h = (h ^ (unsigned int)key->flags) * 16777619u;
+    h = (h ^ (unsigned int)(key->pFace >> 4)) * 16777619u;
+    key->hash = h;
+}
+
+static int sameShapeKey(const ShapeKey* a, const ShapeKey* b) {
+    return a->hash == b->hash &&
+           a->pFace == b->pFace &&
+           a->ptSize == b->ptSize &&
+           memcmp(a->matrix, b->matrix, sizeof(a->matrix)) == 0 &&
+           a->script == b->script &&
+           a->flags == b->flags &&
+           a->runStart == b->runStart &&
+           a->runLength == b->runLength &&
+           a->textLength == b->textLength &&
+           memcmp(a->text, b->text, a->textLength * sizeof(jchar)) == 0;
+}
+
+static ShapeResult* allocShapeResult(int glyphCount, int textLength) {
+    size_t size = sizeof(ShapeResult) +
+                  glyphCount * sizeof(hb_glyph_info_t) +
+                  glyphCount * sizeof(hb_glyph_position_t) +
+                  textLength * sizeof(jchar);
+    ShapeResult* r = (ShapeResult*)malloc(size);
+    if (r == NULL) {
+        return NULL;
+    }
+    r->size = size;
+    r->glyphCount = glyphCount;
+    r->glyphInfo = (hb_glyph_info_t*)(r + 1);
+    r->glyphPos = (hb_glyph_position_t*)(r->glyphInfo + glyphCount);
+    r->text = (jchar*)(r->glyphPos + glyphCount);
+    return r;
+}
+
+static ShapeResult* copyShapeResult(const ShapeResult* from) {
+    ShapeResult* r = (ShapeResult*)malloc(from->size);
+    if (r == NULL) {
+        return NULL;
+    }
+    memcpy(r, from, from->size);
+    r->glyphInfo = (hb_glyph_info_t*)(r + 1);
+    r->glyphPos = (hb_glyph_position_t*)(r->glyphInfo + r->glyphCount);
+    r->text = (jchar*)(r->glyphPos + r->glyphCount);
+    return r;
+}
+
+/*
+ * Returns a private copy of the cached result for key, or NULL.
+ */
+static ShapeResult* lookupShapeCache(JNIEnv* env, jclass lock,
+                                     jobject fontStrike, const ShapeKey* key) {
+    ShapeCacheEntry* e = &shapeCache[key->hash & (SHAPE_CACHE_SIZE - 1)];
+    ShapeResult* r = NULL;
+
+    if ((*env)->MonitorEnter(env, lock) != JNI_OK) {
+        return NULL;
+    }
+    if (e->result != NULL && sameShapeKey(&e->key, key) &&
+        (*env)->IsSameObject(env, e->fontStrike, fontStrike)) {
+        r = copyShapeResult(e->result);
+    }
+    (*env)->MonitorExit(env, lock);
+    return r;
+}
+
+static void insertShapeCache(JNIEnv* env, jclass lock, jobject fontStrike,
+                             const ShapeKey* key, float devScale,
+                             int glyphCount, hb_glyph_info_t* glyphInfo,
+                             hb_glyph_position_t* glyphPos, jint offset) {
+    ShapeCacheEntry* e = &shapeCache[key->hash & (SHAPE_CACHE_SIZE - 1)];
+    ShapeResult* r = allocShapeResult(glyphCount, key->textLength);
+    jweak weak;
+    int i;
+
+    if (r == NULL) {
+        return;
+    }
+    r->devScale = devScale;
+    memcpy(r->glyphInfo, glyphInfo, glyphCount * sizeof(hb_glyph_info_t));
+    memcpy(r->glyphPos, glyphPos, glyphCount * sizeof(hb_glyph_position_t));
+    memcpy(r->text, key->text, key->textLength * sizeof(jchar));
+    for (i = 0; i < glyphCount; i++) {
+        r->glyphInfo[i].cluster -= offset;
+    }
+    weak = (*env)->NewWeakGlobalRef(env, fontStrike);
+    if (weak == NULL) {
+        free(r);
+        return;
+    }
+
+    if ((*env)->MonitorEnter(env, lock) != JNI_OK) {
+        (*env)->DeleteWeakGlobalRef(env, weak);
+        free(r);
+        return;
+    }
+    if (e->result != NULL) {
+        (*env)->DeleteWeakGlobalRef(env, e->fontStrike);
+        free(e->result);
+    }
+    e->fontStrike = weak;
+    e->key = *key;
+    e->key.text = r->text;
+    e->result = r;
+    (*env)->MonitorExit(env, lock);
+}
 
 #define TYPO_KERN 0x00000001
 #define TYPO_LIGA 0x00000002
@@ -266,6 +460,9 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      char* liga = (flags & TYPO_LIGA) ? "liga" : "-liga";
      jboolean ret;
      unsigned int buflen;
+     ShapeKey key;
+     ShapeResult* cached;
+     int cacheable;
 
      JDKFontInfo *jdkFontInfo =
          createJDKFontInfo(env, font2D, fontStrike, ptSize,
@@ -300,6 +497,26 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      }
      len = (*env)->GetArrayLength(env, text);
 
+     cacheable = !aat && (limit - offset) <= SHAPE_CACHE_MAX_CHARS;
+     if (cacheable) {
+         initShapeKey(&key, pFace, jdkFontInfo, script, flags,
+                      chars, len, offset, limit);
+         cached = lookupShapeCache(env, cls, fontStrike, &key);
+         if (cached != NULL) {
+             // clusters are already relative to the start of the run
+             ret = storeGVData(env, gvdata, slot, baseIndex, 0, startPt,
+                               limit - offset, cached->glyphCount,
+                               cached->glyphInfo, cached->glyphPos,
+                               cached->devScale);
+             free(cached);
+             hb_buffer_destroy(buffer);
+             hb_font_destroy(hbfont);
+             free((void*)jdkFontInfo);
+             (*env)->ReleaseCharArrayElements(env, text, chars, JNI_ABORT);
+             return ret;
+         }
+     }
+
      hb_buffer_add_utf16(buffer, chars, len, offset, limit-offset);
 
      features = calloc(2, sizeof(hb_feature_t));
@@ -313,6 +530,11 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      glyphInfo = hb_buffer_get_glyph_infos(buffer, 0);
      glyphPos = hb_buffer_get_glyph_positions(buffer, &buflen);
 
+     if (cacheable && !(*env)->ExceptionCheck(env)) {
+         insertShapeCache(env, cls, fontStrike, &key, jdkFontInfo->devScale,
+                          glyphCount, glyphInfo, glyphPos, offset);
+     }
+
      ret = storeGVData(env, gvdata, slot, baseIndex, offset, startPt,
                        limit - offset, glyphCount, glyphInfo, glyphPos,
                        jdkFontInfo->devScale);
@@ -16,6 +16,12 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 
+/* SSE2 is part of the x86-64 baseline, so no runtime check is needed. */
+#if BITS_IN_JSAMPLE == 8 && (defined(__SSE2__) || defined(_M_X64))
+#define YCC_RGB_SSE2
+#include <emmintrin.h>
+#endif
+
 
 /* Private subobject */
 
@@ -109,6 +115,79 @@ build_ycc_rgb_table (j_decompress_ptr cinfo)
 }
 
 
+#ifdef YCC_RGB_SSE2
+
+/*
+ * Vector version of the inner loop of ycc_rgb_convert, 8 pixels at a time.
+ * pmaddwd only takes 16-bit multipliers, so each constant is split into a
+ * multiple of 2^16, applied as a plain add, plus a remainder that fits.
+ * The results are identical to the table-driven code.  Since every sum is
+ * within -(MAXJSAMPLE+1)..2*(MAXJSAMPLE+1), the unsigned saturating pack
+ * does the same job as range_limit.
+ * Returns the number of columns converted; the caller does the rest.
+ */
+
+#define PAIR(cb_mul, cr_mul) \
+  _mm_set1_epi32((int) (((unsigned int) (cr_mul) << 16) | \
+                        ((unsigned int) (cb_mul) & 0xFFFF)))
+
+LOCAL(JDIMENSION)
+ycc_rgb_convert_sse2 (JSAMPROW inptr0, JSAMPROW inptr1, JSAMPROW inptr2,
+                      JSAMPROW outptr, JDIMENSION num_cols)
+{
+  /* R = Y + Cr + (FIX(1.40200) - FIX(1)) * Cr */
+  __m128i r_mul = PAIR(0, FIX(1.40200) - FIX(1));
+  /* G = Y - Cr - FIX(0.34414) * Cb + (FIX(1) - FIX(0.71414)) * Cr */
+  __m128i g_mul = PAIR(- FIX(0.34414), FIX(1) - FIX(0.71414));
+  /* B = Y + 2 * Cb + (FIX(1.77200) - 2 * FIX(1)) * Cb */
+  __m128i b_mul = PAIR(FIX(1.77200) - 2 * FIX(1), 0);
+  __m128i one_half = _mm_set1_epi32(ONE_HALF);
+  __m128i center = _mm_set1_epi16(CENTERJSAMPLE);
+  __m128i zero = _mm_setzero_si128();
+  __m128i y, cb, cr, lo, hi, r, g, b;
+  JSAMPLE rbuf[16], gbuf[16], bbuf[16];
+  JDIMENSION col;
+  int i;
+
+#define YCC_TERM(mul) \
+  _mm_packs_epi32( \
+    _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(lo, mul), one_half), SCALEBITS), \
+    _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(hi, mul), one_half), SCALEBITS))
+
+  for (col = 0; col + 8 <= num_cols; col += 8) {
+    y  = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr0 + col)), zero);
+    cb = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr1 + col)), zero);
+    cr = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr2 + col)), zero);
+    cb = _mm_sub_epi16(cb, center);
+    cr = _mm_sub_epi16(cr, center);
+    lo = _mm_unpacklo_epi16(cb, cr);
+    hi = _mm_unpackhi_epi16(cb, cr);
+
+    r = _mm_add_epi16(_mm_add_epi16(y, cr), YCC_TERM(r_mul));
+    g = _mm_add_epi16(_mm_sub_epi16(y, cr), YCC_TERM(g_mul));
+    b = _mm_add_epi16(_mm_add_epi16(y, _mm_add_epi16(cb, cb)), YCC_TERM(b_mul));
+
+    _mm_storeu_si128((__m128i *) rbuf, _mm_packus_epi16(r, zero));
+    _mm_storeu_si128((__m128i *) gbuf, _mm_packus_epi16(g, zero));
+    _mm_storeu_si128((__m128i *) bbuf, _mm_packus_epi16(b, zero));
+    for (i = 0; i < 8; i++) {
+      outptr[RGB_RED] =   rbuf[i];
+      outptr[RGB_GREEN] = gbuf[i];
+      outptr[RGB_BLUE] =  bbuf[i];
+      outptr += RGB_PIXELSIZE;
+    }
+  }
+
+#undef YCC_TERM
+
+  return col;
+}
+
+#undef PAIR
+
+#endif /* YCC_RGB_SSE2 */
+
+
 /*
  * Convert some rows of samples to the output colorspace.
  *
@@ -145,7 +224,12 @@ ycc_rgb_convert (j_decompress_ptr cinfo,
     inptr2 = input_buf[2][input_row];
     input_row++;
     outptr = *output_buf++;
-    for (col = 0; col < num_cols; col++) {
+    col = 0;
+#ifdef YCC_RGB_SSE2
+    col = ycc_rgb_convert_sse2(inptr0, inptr1, inptr2, outptr, num_cols);
+    outptr += col * RGB_PIXELSIZE;
+#endif
+    for (; col < num_cols; col++) {
       y  = GETJSAMPLE(inptr0[col]);
       cb = GETJSAMPLE(inptr1[col]);
       cr = GETJSAMPLE(inptr2[col]);
@@ -33,6 +33,12 @@
 #include <lcms2.h>
 #include "jlong.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#define LCMS_PARALLEL_TRANSFORM
+#endif
+
 
 #define ALIGNLONG(x) (((x)+3) & ~(3))         // Aligns to DWORD boundary
 
@@ -562,6 +568,139 @@ void releaseILData (JNIEnv *env, void* pData, jint dataType,
     }
 }
 
+/*
+ * A band of an image, either a run of pixels when the whole image is
+ * contiguous, or a number of rows.
+ */
+typedef struct {
+    cmsHTRANSFORM sTrans;
+    char* inputRow;
+    char* outputRow;
+    int srcNextRowOffset;
+    int dstNextRowOffset;
+    int width;
+    int rows;
+    jboolean atOnce;
+} TransformBand;
+
+static void transformBand(TransformBand* band)
+{
+    int i;
+    char* inputRow = band->inputRow;
+    char* outputRow = band->outputRow;
+
+    if (band->atOnce) {
+        cmsDoTransform(band->sTrans, inputRow, outputRow, band->width);
+    } else {
+        for (i = 0; i < band->rows; i++) {
+            cmsDoTransform(band->sTrans, inputRow, outputRow, band->width);
+            inputRow += band->srcNextRowOffset;
+            outputRow += band->dstNextRowOffset;
+        }
+    }
+}
+
+#ifdef LCMS_PARALLEL_TRANSFORM
+
+/*
+ * Large images are split into bands that are transformed in parallel.
+ * cmsDoTransform may be called on one transform from several threads at
+ * once; the bands don't overlap.
+ */
+#define PARALLEL_PIXELS_PER_THREAD  (512 * 1024)
+#define PARALLEL_MAX_THREADS        8
+
+static void* transformBandThread(void* arg)
+{
+    transformBand((TransformBand*)arg);
+    return NULL;
+}
+
+/* Returns the size of a pixel in bytes, or 0 if it is not interleaved. */
+static int pixelSize(cmsUInt32Number format)
+{
+    int bytes = T_BYTES(format);
+    if (T_PLANAR(format)) {
+        return 0;
+    }
+    if (bytes == 0) {
+        bytes = sizeof(cmsFloat64Number);
+    }
+    return bytes * (T_CHANNELS(format) + T_EXTRA(format));
+}
+
+/*
+ * Transforms the image described by whole, using several threads if it
+ * is large enough.  Returns JNI_FALSE if it was not transformed, and the
+ * caller has to do it on its own.
+ */
+static jboolean transformParallel(TransformBand* whole)
+{
+    TransformBand bands[PARALLEL_MAX_THREADS];
+    pthread_t threads[PARALLEL_MAX_THREADS];
+    jboolean started[PARALLEL_MAX_THREADS];
+    long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+    long pixels = whole->atOnce ? (long)whole->width
+                                : (long)whole->width * whole->rows;
+    int units = whole->atOnce ? whole->width : whole->rows;
+    int inSize = 0, outSize = 0;
+    int n, i, start;
+
+    n = (int)(pixels / PARALLEL_PIXELS_PER_THREAD);
+    if (n > ncpus) {
+        n = (int)ncpus;
+    }
+    if (n > PARALLEL_MAX_THREADS) {
+        n = PARALLEL_MAX_THREADS;
+    }
+    if (n > units) {
+        n = units;
+    }
+    if (n < 2) {
+        return JNI_FALSE;
+    }
+    if (whole->atOnce) {
+        inSize = pixelSize(cmsGetTransformInputFormat(whole->sTrans));
+        outSize = pixelSize(cmsGetTransformOutputFormat(whole->sTrans));
+        if (inSize == 0 || outSize == 0) {
+            return JNI_FALSE;
+        }
+    }
+
+    start = 0;
+    for (i = 0; i < n; i++) {
+        int count = units / n + (i < units % n ? 1 : 0);
+        bands[i] = *whole;
+        if (whole->atOnce) {
+            bands[i].inputRow += (size_t)start * inSize;
+            bands[i].outputRow += (size_t)start * outSize;
+            bands[i].width = count;
+        } else {
+            bands[i].inputRow += (size_t)start * whole->srcNextRowOffset;
+            bands[i].outputRow += (size_t)start * whole->dstNextRowOffset;
+            bands[i].rows = count;
+        }
+        start += count;
+    }
+
+    /* The first band is done by the calling thread. */
+    for (i = 1; i < n; i++) {
+        started[i] = pthread_create(&threads[i], NULL,
+                                    transformBandThread, &bands[i]) == 0;
+    }
+    transformBand(&bands[0]);
+    for (i = 1; i < n; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            transformBand(&bands[i]);
+        }
+    }
+    return JNI_TRUE;
+}
+
+#endif /* LCMS_PARALLEL_TRANSFORM */
+
 /*
  * Class:     sun_java2d_cmm_lcms_LCMS
  * Method:    colorConvert
@@ -573,7 +712,8 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
     cmsHTRANSFORM sTrans = NULL;
     int srcDType, dstDType;
     int srcOffset, srcNextRowOffset, dstOffset, dstNextRowOffset;
-    int width, height, i;
+    int width, height;
+    TransformBand whole;
     void* inputBuffer;
     void* outputBuffer;
     char* inputRow;
@@ -620,14 +760,25 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
     inputRow = (char*)inputBuffer + srcOffset;
     outputRow = (char*)outputBuffer + dstOffset;
 
-    if (srcAtOnce && dstAtOnce) {
-        cmsDoTransform(sTrans, inputRow, outputRow, width * height);
+    whole.sTrans = sTrans;
+    whole.inputRow = inputRow;
+    whole.outputRow = outputRow;
+    whole.srcNextRowOffset = srcNextRowOffset;
+    whole.dstNextRowOffset = dstNextRowOffset;
+    whole.atOnce = srcAtOnce && dstAtOnce;
+    if (whole.atOnce) {
+        whole.width = width * height;
+        whole.rows = 1;
     } else {
-        for (i = 0; i < height; i++) {
-            cmsDoTransform(sTrans, inputRow, outputRow, width);
-            inputRow += srcNextRowOffset;
-            outputRow += dstNextRowOffset;
-        }
+        whole.width = width;
+        whole.rows = height;
+    }
+
+#ifdef LCMS_PARALLEL_TRANSFORM
+    if (!transformParallel(&whole))
+#endif
+    {
+        transformBand(&whole);
     }
 
     releaseILData(env, inputBuffer, srcDType, srcData);
@@ -75,6 +75,12 @@
 #include "mlib_ImageCheck.h"
 #include "mlib_ImageAffine.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#define MLIB_AFFINE_PARALLEL
+#endif /* _WIN32 */
+
 
 /***************************************************************/
 #define BUFF_SIZE  600
@@ -130,6 +136,105 @@ const type_affine_fun mlib_AffineFunArr_bc[] = {
 #define MAX_T_IND  3
 #endif /* i386 ( do not perform the coping by mlib_d64 data type for x86 ) */
 
+/***************************************************************/
+#ifdef MLIB_AFFINE_PARALLEL
+
+/*
+ * Large destinations are split into bands of rows that are computed in
+ * parallel.  Every row is computed from its own entries of the edge,
+ * start and warp tables prepared by mlib_AffineEdges, so the bands are
+ * independent and produce the same pixels as a single call.
+ */
+#define MAX_THREADS        8
+#define PIXELS_PER_THREAD  (256 * 1024)
+
+typedef struct {
+  type_affine_fun   fun;
+  mlib_affine_param param;
+  mlib_status       res;
+} mlib_affine_band;
+
+static void *mlib_ImageAffine_band(void *arg)
+{
+  mlib_affine_band *band = (mlib_affine_band *) arg;
+
+  band->res = band->fun(&band->param);
+  return NULL;
+}
+
+static mlib_status mlib_ImageAffine_run(type_affine_fun   fun,
+                                        mlib_affine_param *param)
+{
+  mlib_affine_band band[MAX_THREADS];
+  pthread_t thread[MAX_THREADS];
+  mlib_s32 started[MAX_THREADS];
+  mlib_s32 rows = param->yFinish - param->yStart + 1;
+  mlib_s32 width = mlib_ImageGetWidth(param->dst);
+  mlib_s32 nthreads, i, y;
+  long ncpus;
+  mlib_status res = MLIB_SUCCESS;
+
+  if (rows <= 1 || (mlib_d64) rows * width < 2.0 * PIXELS_PER_THREAD)
+    return fun(param);
+
+  ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+  nthreads = (mlib_s32) (((mlib_d64) rows * width) / PIXELS_PER_THREAD);
+
+  if (nthreads > ncpus)
+    nthreads = (mlib_s32) ncpus;
+
+  if (nthreads > MAX_THREADS)
+    nthreads = MAX_THREADS;
+
+  if (nthreads > rows)
+    nthreads = rows;
+
+  if (nthreads < 2)
+    return fun(param);
+
+  y = param->yStart;
+  for (i = 0; i < nthreads; i++) {
+    mlib_s32 count = rows / nthreads + (i < rows % nthreads ? 1 : 0);
+
+    band[i].fun = fun;
+    band[i].param = *param;
+    band[i].param.yStart = y;
+    band[i].param.yFinish = y + count - 1;
+    /* dstData points to the line before yStart */
+    band[i].param.dstData += (y - param->yStart) * param->dstYStride;
+    band[i].res = MLIB_SUCCESS;
+    y += count;
+  }
+
+  /* the first band is done by the calling thread */
+  for (i = 1; i < nthreads; i++) {
+    started[i] = pthread_create(&thread[i], NULL,
+                                mlib_ImageAffine_band, &band[i]) == 0;
+  }
+
+  mlib_ImageAffine_band(&band[0]);
+
+  for (i = 1; i < nthreads; i++) {
+    if (started[i])
+      pthread_join(thread[i], NULL);
+    else
+      mlib_ImageAffine_band(&band[i]);
+  }
+
+  for (i = 0; i < nthreads; i++) {
+    if (band[i].res != MLIB_SUCCESS)
+      res = band[i].res;
+  }
+
+  return res;
+}
+
+#else
+
+#define mlib_ImageAffine_run(fun, param) (fun)(param)
+
+#endif /* MLIB_AFFINE_PARALLEL */
+
 /***************************************************************/
 mlib_status mlib_ImageAffine_alltypes(mlib_image       *dst,
                                       const mlib_image *src,
@@ -222,18 +327,21 @@ mlib_status mlib_ImageAffine_alltypes(mlib_image       *dst,
           t_ind++;
         }
 
-        res = mlib_AffineFunArr_nn[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_ImageAffine_run(mlib_AffineFunArr_nn[4 * t_ind + (nchan - 1)],
+                                   param);
         break;
 
       case MLIB_BILINEAR:
 
-        res = mlib_AffineFunArr_bl[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_ImageAffine_run(mlib_AffineFunArr_bl[4 * t_ind + (nchan - 1)],
+                                   param);
         break;
 
       case MLIB_BICUBIC:
       case MLIB_BICUBIC2:
 
-        res = mlib_AffineFunArr_bc[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_ImageAffine_run(mlib_AffineFunArr_bc[4 * t_ind + (nchan - 1)],
+                                   param);
         break;
     }
 
@@ -270,11 +270,6 @@ lib_info* add_lib_info_fd(struct ps_prochandle* ph, const char* libname, int fd,
       return NULL;
    }
 
-   newlib->symtab = build_symtab(newlib->fd, libname);
-   if (newlib->symtab == NULL) {
-      print_debug("symbol table build failed for %s\n", newlib->name);
-   }
-
    if (fill_instr_info(newlib)) {
      if (!read_eh_frame(ph, newlib)) {
        print_debug("Could not find .eh_frame section in %s\n", newlib->name);
@@ -283,7 +278,8 @@ lib_info* add_lib_info_fd(struct ps_prochandle* ph, const char* libname, int fd,
       print_debug("Could not find executable section in %s\n", newlib->name);
    }
 
-   // even if symbol table building fails, we add the lib_info.
+   // the symbol table is built on first use, and even if that fails, we add
+   // the lib_info.
    // This is because we may need to read from the ELF file for core file
    // address read functionality. lookup_symbol checks for NULL symtab.
    if (ph->libs) {
@@ -297,6 +293,36 @@ lib_info* add_lib_info_fd(struct ps_prochandle* ph, const char* libname, int fd,
    return newlib;
 }
 
+// Symbol tables are built on first use. A lookup by address only needs the
+// library containing the address, and a lookup by name stops at the first
+// library defining the symbol, so most libraries of a large core never need
+// one.
+static struct symtab* lib_symtab(lib_info* lib) {
+   int fd;
+
+   if (lib->symtab_built) {
+      return lib->symtab;
+   }
+   lib->symtab_built = true;
+
+   // the fd is only kept open for core files
+   fd = lib->fd;
+   if (fd < 0 && (fd = pathmap_open(lib->name)) < 0) {
+      print_debug("can't open shared object %s\n", lib->name);
+      return NULL;
+   }
+
+   lib->symtab = build_symtab(fd, lib->name);
+   if (lib->symtab == NULL) {
+      print_debug("symbol table build failed for %s\n", lib->name);
+   }
+
+   if (fd != lib->fd) {
+      close(fd);
+   }
+   return lib->symtab;
+}
+
 // lookup for a specific symbol
 uintptr_t lookup_symbol(struct ps_prochandle* ph,  const char* object_name,
                        const char* sym_name) {
@@ -309,8 +335,9 @@ uintptr_t lookup_symbol(struct ps_prochandle* ph,  const char* object_name,
 
    lib_info* lib = ph->libs;
    while (lib) {
-      if (lib->symtab) {
-         uintptr_t res = search_symbol(lib->symtab, lib->base, sym_name, NULL);
+      struct symtab* symtab = lib_symtab(lib);
+      if (symtab) {
+         uintptr_t res = search_symbol(symtab, lib->base, sym_name, NULL);
          if (res) return res;
       }
       lib = lib->next;
@@ -326,7 +353,7 @@ const char* symbol_for_pc(struct ps_prochandle* ph, uintptr_t addr, uintptr_t* p
    const char* res = NULL;
    lib_info* lib = ph->libs;
    while (lib) {
-      if (lib->symtab && addr >= lib->base) {
+      if (addr >= lib->base && lib_symtab(lib) != NULL) {
          res = nearest_symbol(lib->symtab, addr - lib->base, poffset);
          if (res) return res;
       }
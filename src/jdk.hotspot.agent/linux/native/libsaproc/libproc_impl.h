@@ -49,7 +49,8 @@ typedef struct lib_info {
   uintptr_t        exec_start;
   uintptr_t        exec_end;
   eh_frame_info    eh_frame;
-  struct symtab*   symtab;
+  struct symtab*   symtab;    // built on first use, see lib_symtab()
+  bool             symtab_built;
   int              fd;        // file descriptor for lib
   struct lib_info* next;
 } lib_info;
@@ -68,6 +69,11 @@ typedef struct map_info {
    uintptr_t        vaddr;    // starting virtual address
    size_t           memsz;    // size of the mapping
    uint32_t         flags;    // acces flags
+   bool             map_tried;   // whether a read-only mapping was attempted
+   char*            map_base;    // start of the mapping, page aligned
+   size_t           map_len;     // length of the mapping
+   char*            map_data;    // data at 'offset' within the mapping
+   size_t           map_data_len;// bytes of the segment backed by the mapping
    struct map_info* next;
 } map_info;
 
@@ -30,6 +30,8 @@
 #include <stddef.h>
 #include <elf.h>
 #include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "libproc_impl.h"
 #include "ps_core_common.h"
 #include "proc_service.h"
@@ -105,6 +107,67 @@ static bool sort_map_array(struct ps_prochandle* ph) {
 #define MIN(x, y) (((x) < (y))? (x): (y))
 #endif
 
+// Map the file data of a segment read-only, so that the many small reads
+// done while walking the heap are served from the page cache by memcpy
+// rather than costing a pread each. The mapping is created on first access
+// and only covers the part of the segment present in the file; reads
+// beyond that, or of segments that could not be mapped, fall back to pread.
+static void core_map_segment(map_info* mp, long page_size) {
+   struct stat st;
+   off_t aligned_offset;
+   size_t delta, len;
+   void* base;
+
+   mp->map_tried = true;
+   if (fstat(mp->fd, &st) != 0 || st.st_size <= mp->offset) {
+      return;
+   }
+
+   aligned_offset = mp->offset & ~((off_t) page_size - 1);
+   delta = (size_t) (mp->offset - aligned_offset);
+   len = MIN(mp->memsz, (size_t) (st.st_size - mp->offset));
+   if (len == 0) {
+      return;
+   }
+
+   base = mmap(NULL, len + delta, PROT_READ, MAP_PRIVATE, mp->fd, aligned_offset);
+   if (base == MAP_FAILED) {
+      print_debug("can't map segment at 0x%lx, using pread\n", mp->vaddr);
+      return;
+   }
+
+   mp->map_base = (char*) base;
+   mp->map_len = len + delta;
+   mp->map_data = (char*) base + delta;
+   mp->map_data_len = len;
+}
+
+static void core_unmap_segment(map_info* mp) {
+   if (mp->map_base != NULL) {
+      munmap(mp->map_base, mp->map_len);
+   }
+   mp->map_tried = false;
+   mp->map_base = NULL;
+   mp->map_len = 0;
+   mp->map_data = NULL;
+   mp->map_data_len = 0;
+}
+
+static void core_unmap_segments(map_info* map) {
+   while (map) {
+      core_unmap_segment(map);
+      map = map->next;
+   }
+}
+
+static void core_release_data(struct ps_prochandle* ph) {
+   if (ph->core) {
+      core_unmap_segments(ph->core->maps);
+      core_unmap_segments(ph->core->class_share_maps);
+   }
+   core_release(ph);
+}
+
 static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf, size_t size) {
    ssize_t resid = size;
    int page_size=sysconf(_SC_PAGE_SIZE);
@@ -124,7 +187,13 @@ static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf,
       len = MIN(resid, mp->memsz - mapoff);
       off = mp->offset + mapoff;
 
-      if ((len = pread(fd, buf, len, off)) <= 0) {
+      if (!mp->map_tried) {
+         core_map_segment(mp, page_size);
+      }
+      if (mapoff < mp->map_data_len) {
+         len = MIN(len, mp->map_data_len - mapoff);
+         memcpy(buf, mp->map_data + mapoff, len);
+      } else if ((len = pread(fd, buf, len, off)) <= 0) {
          break;
       }
 
@@ -176,7 +245,7 @@ static bool core_get_lwp_regs(struct ps_prochandle* ph, lwpid_t lwp_id,
 }
 
 static ps_prochandle_ops core_ops = {
-   .release=  core_release,
+   .release=  core_release_data,
    .p_pread=  core_read_data,
    .p_pwrite= core_write_data,
    .get_lwp_regs= core_get_lwp_regs
@@ -421,6 +490,7 @@ static bool read_lib_segments(struct ps_prochandle* ph, int lib_fd, ELF_EHDR* li
         print_debug("overwrote with new address mapping (memsz %ld -> %ld)\n",
                      existing_map->memsz, ROUNDUP(lib_php->p_memsz, page_size));
 
+        core_unmap_segment(existing_map);
         existing_map->fd = lib_fd;
         existing_map->offset = lib_php->p_offset;
         existing_map->memsz = ROUNDUP(lib_php->p_memsz, page_size);
@@ -393,8 +393,8 @@ static bool read_lib_info(struct ps_prochandle* ph) {
        if ((lib = add_lib_info(ph, word[5], (uintptr_t)base)) == NULL)
           continue; // ignore, add_lib_info prints error
 
-       // we don't need to keep the library open, symtab is already
-       // built. Only for core dump we need to keep the fd open.
+       // we don't need to keep the library open, the symtab is built
+       // by reopening it. Only for core dump we need to keep the fd open.
        close(lib->fd);
        lib->fd = -1;
     }
@@ -358,6 +358,22 @@ eventInstance(EventInfo *evinfo)
     return object;
 }
 
+/*
+ * Most events are never reported if they happen in debug threads.
+ * This is the same for every handler of the event, so it is checked
+ * once per event before the handler chain is walked.
+ */
+jboolean
+eventFilterRestricted_suppressedInThread(EventInfo *evinfo)
+{
+    if ((evinfo->ei == EI_CLASS_PREPARE) ||
+        (evinfo->ei == EI_GC_FINISH) ||
+        (evinfo->ei == EI_CLASS_LOAD)) {
+        return JNI_FALSE;
+    }
+    return threadControl_isDebugThread(evinfo->thread);
+}
+
 /*
  * Determine if this event is interesting to this handler.
  * Do so by checking each of the handler's filters.
@@ -369,6 +385,8 @@ eventInstance(EventInfo *evinfo)
  *
  * If shouldDelete is returned true, a count filter has expired
  * and the corresponding node should be deleted.
+ *
+ * The caller must have checked eventFilterRestricted_suppressedInThread.
  */
 jboolean
 eventFilterRestricted_passesFilter(JNIEnv *env,
@@ -389,15 +407,9 @@ eventFilterRestricted_passesFilter(JNIEnv *env,
     method = evinfo->method;
 
     /*
-     * Suppress most events if they happen in debug threads
+     * Events in debug threads have already been suppressed by the
+     * caller, which checks once per event rather than once per handler.
      */
-    if ((evinfo->ei != EI_CLASS_PREPARE) &&
-        (evinfo->ei != EI_GC_FINISH) &&
-        (evinfo->ei != EI_CLASS_LOAD) &&
-        threadControl_isDebugThread(thread)) {
-        return JNI_FALSE;
-    }
-
     for (i = 0; i < FILTER_COUNT(node); ++i, ++filter) {
         switch (filter->modifier) {
             case JDWP_REQUEST_MODIFIER(ThreadOnly):
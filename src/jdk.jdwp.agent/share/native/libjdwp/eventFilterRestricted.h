@@ -37,6 +37,7 @@ jvmtiError eventFilterRestricted_install(HandlerNode *node);
 
 jvmtiError eventFilterRestricted_deinstall(HandlerNode *node);
 
+jboolean eventFilterRestricted_suppressedInThread(EventInfo *evinfo);
 jboolean eventFilterRestricted_passesFilter(JNIEnv *env,
                                             char *classname,
                                             EventInfo *evinfo,
@@ -644,7 +644,17 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
         }
 
         node = getHandlerChain(evinfo->ei)->first;
-        classname = getClassname(evinfo->clazz);
+        classname = NULL;
+
+        /* Nothing to filter if no handler can see this event; this also
+         * saves fetching the class signature for every prepared class.
+         */
+        if (node != NULL && eventFilterRestricted_suppressedInThread(evinfo)) {
+            node = NULL;
+        }
+        if (node != NULL) {
+            classname = getClassname(evinfo->clazz);
+        }
 
         while (node != NULL) {
             /* save next so handlers can remove themselves */
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "benchmarkHelper.inline.hpp"
+
+WorkGang* BenchmarkRunner::_workers = NULL;
+
+void BenchmarkRunner::report(const char* label, uint nthreads, size_t ops, jlong* times, int n) {
+  sort(times, n);
+  double per_op = ops > 0 ? 1.0 / ops : 0.0;
+  double min_ns = times[0] * per_op;
+  double median_ns = times[n / 2] * per_op;
+  double max_ns = times[n - 1] * per_op;
+  double ops_per_sec = median_ns > 0.0 ? NANOSECS_PER_SEC / median_ns : 0.0;
+
+  const ::testing::TestInfo* info = ::testing::UnitTest::GetInstance()->current_test_info();
+  tty->print_cr("BENCHMARK %s.%s threads=%u ops=" SIZE_FORMAT
+                " min_ns=%.3f median_ns=%.3f max_ns=%.3f ops_per_sec=%.0f",
+                info != NULL ? info->test_case_name() : "?", label, nthreads, ops,
+                min_ns, median_ns, max_ns, ops_per_sec);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef GTEST_BENCHMARKHELPER_INLINE_HPP
+#define GTEST_BENCHMARKHELPER_INLINE_HPP
+
+#include "gc/shared/workgroup.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vmOperations.hpp"
+#include "runtime/vmThread.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "unittest.hpp"
+
+// Support for TEST_VM_BENCHMARK tests.
+//
+// An operation is a functor with
+//   void operator()(uint worker_id, size_t count)
+// that performs count operations on behalf of worker worker_id. It is run
+// by nthreads gang workers at the same time, inside a safepoint so that the
+// measurement is not disturbed by the rest of the VM. Each run does the
+// configured number of warmup rounds, then the measured rounds, and prints
+// one line per run:
+//
+//   BENCHMARK <test case>.<label> threads=<n> ops=<total ops per round>
+//     min_ns=<ns/op> median_ns=<ns/op> max_ns=<ns/op> ops_per_sec=<median>
+//
+// where a round's time is the span from the first worker starting to the
+// last worker finishing.
+
+class BenchmarkRunner : public AllStatic {
+  static WorkGang* _workers;
+
+  template <typename OP> class Task;
+  class VM_Round;
+
+  static WorkGang* workers() {
+    if (_workers == NULL) {
+      WorkGang* wg = new WorkGang("Benchmark workers", max_threads(), false, false);
+      wg->initialize_workers();
+      wg->update_active_workers(max_threads());
+      _workers = wg;
+    }
+    return _workers;
+  }
+
+  static void sort(jlong* times, int n) {
+    for (int i = 1; i < n; i++) {
+      jlong t = times[i];
+      int j = i - 1;
+      for (; j >= 0 && times[j] > t; j--) {
+        times[j + 1] = times[j];
+      }
+      times[j + 1] = t;
+    }
+  }
+
+  static void report(const char* label, uint nthreads, size_t ops, jlong* times, int n);
+
+public:
+  // The largest number of workers a run uses.
+  static uint max_threads() {
+    uint n = (uint)BenchmarkOptions::max_threads;
+    if (n == 0) {
+      n = MIN2((uint)os::active_processor_count(), 16u);
+    }
+    return MAX2(n, 1u);
+  }
+
+  // Runs op on nthreads workers, each doing count operations per round.
+  template <typename OP>
+  static void run(const char* label, OP* op, size_t count, uint nthreads);
+
+  // Runs op on 1, 2, 4, ... workers up to the configured maximum.
+  template <typename OP>
+  static void run_scaling(const char* label, OP* op, size_t count) {
+    uint limit = max_threads();
+    for (uint n = 1; n < limit; n *= 2) {
+      run(label, op, count, n);
+    }
+    run(label, op, count, limit);
+  }
+};
+
+template <typename OP>
+class BenchmarkRunner::Task : public AbstractGangTask {
+  OP* _op;
+  size_t _count;
+  volatile jlong _start;
+  volatile jlong _end;
+
+public:
+  Task(OP* op, size_t count) :
+    AbstractGangTask("BenchmarkRunner::Task"),
+    _op(op), _count(count), _start(max_jlong), _end(0) {}
+
+  virtual void work(uint worker_id) {
+    jlong start = os::javaTimeNanos();
+    (*_op)(worker_id, _count);
+    jlong end = os::javaTimeNanos();
+
+    jlong cur = Atomic::load(&_start);
+    while (start < cur) {
+      jlong prev = Atomic::cmpxchg(&_start, cur, start);
+      if (prev == cur) break;
+      cur = prev;
+    }
+    cur = Atomic::load(&_end);
+    while (end > cur) {
+      jlong prev = Atomic::cmpxchg(&_end, cur, end);
+      if (prev == cur) break;
+      cur = prev;
+    }
+  }
+
+  jlong elapsed() const { return _end - _start; }
+};
+
+class BenchmarkRunner::VM_Round : public VM_GTestExecuteAtSafepoint {
+  WorkGang* _workers;
+  AbstractGangTask* _task;
+  uint _nthreads;
+
+public:
+  VM_Round(WorkGang* workers, AbstractGangTask* task, uint nthreads) :
+    _workers(workers), _task(task), _nthreads(nthreads) {}
+
+  void doit() {
+    _workers->run_task(_task, _nthreads);
+  }
+};
+
+template <typename OP>
+void BenchmarkRunner::run(const char* label, OP* op, size_t count, uint nthreads) {
+  const int rounds = MAX2(BenchmarkOptions::iterations, 1);
+  jlong* times = NEW_C_HEAP_ARRAY(jlong, rounds, mtTest);
+  nthreads = MIN2(nthreads, max_threads());
+
+  ThreadInVMfromNative invm(JavaThread::current());
+  WorkGang* gang = workers();
+  for (int i = -BenchmarkOptions::warmup; i < rounds; i++) {
+    Task<OP> task(op, count);
+    VM_Round round(gang, &task, nthreads);
+    VMThread::execute(&round);
+    if (i >= 0) {
+      times[i] = task.elapsed();
+    }
+  }
+  report(label, nthreads, count * nthreads, times, rounds);
+  FREE_C_HEAP_ARRAY(jlong, times);
+}
+
+#endif // GTEST_BENCHMARKHELPER_INLINE_HPP
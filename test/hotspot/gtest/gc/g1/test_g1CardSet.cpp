@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CardSet.inline.hpp"
+#include "gc/g1/heapRegion.hpp"
+#include "runtime/mutex.hpp"
+#include "unittest.hpp"
+
+class G1CardSetTestClosure {
+public:
+  size_t _num_cards;
+  size_t _num_bitmap_cards;
+  size_t _num_full;
+
+  G1CardSetTestClosure() : _num_cards(0), _num_bitmap_cards(0), _num_full(0) { }
+
+  void next_full(uint region_idx) {
+    _num_full++;
+  }
+
+  void next_bitmap(uint region_idx, BitMap* bm) {
+    _num_bitmap_cards += bm->count_one_bits();
+  }
+
+  void next_cards(uint region_idx, const G1CardSet::CardElem* cards, uint num_cards) {
+    _num_cards += num_cards;
+  }
+};
+
+// @requires UseG1GC
+TEST_VM(G1CardSet, add_and_contains) {
+  if (!UseG1GC) {
+    return;
+  }
+
+  Mutex m(Mutex::leaf, "G1CardSetTest lock", true, Mutex::_safepoint_check_never);
+  G1CardSet card_set(&m);
+
+  const uint num_regions = 100;
+  for (uint r = 0; r < num_regions; r++) {
+    for (uint c = 0; c <= r % 10; c++) {
+      ASSERT_TRUE(card_set.add_card(r, (G1CardSet::CardElem)(c * 3)));
+      ASSERT_FALSE(card_set.add_card(r, (G1CardSet::CardElem)(c * 3)));
+    }
+  }
+
+  size_t expected = 0;
+  for (uint r = 0; r < num_regions; r++) {
+    for (uint c = 0; c <= r % 10; c++) {
+      ASSERT_TRUE(card_set.contains_card(r, (G1CardSet::CardElem)(c * 3)));
+      ASSERT_FALSE(card_set.contains_card(r, (G1CardSet::CardElem)(c * 3 + 1)));
+      expected++;
+    }
+  }
+  ASSERT_EQ(expected, card_set.occupied());
+  ASSERT_FALSE(card_set.contains_card(num_regions, 0));
+
+  G1CardSetTestClosure cl;
+  card_set.iterate_for_merge(cl);
+  ASSERT_EQ(expected, cl._num_cards + cl._num_bitmap_cards);
+  ASSERT_EQ((size_t)0, cl._num_full);
+
+  card_set.clear();
+  ASSERT_TRUE(card_set.is_empty());
+  ASSERT_FALSE(card_set.contains_card(0, 0));
+}
+
+// @requires UseG1GC
+TEST_VM(G1CardSet, coarsen_to_full) {
+  if (!UseG1GC) {
+    return;
+  }
+
+  Mutex m(Mutex::leaf, "G1CardSetTest lock", true, Mutex::_safepoint_check_never);
+  G1CardSet card_set(&m);
+
+  // Adding every card of a region eventually makes the container cover the
+  // whole region.
+  for (size_t c = 0; c < HeapRegion::CardsPerRegion; c++) {
+    card_set.add_card(7, (G1CardSet::CardElem)c);
+  }
+  ASSERT_EQ(HeapRegion::CardsPerRegion, card_set.occupied());
+
+  G1CardSetTestClosure cl;
+  card_set.iterate_for_merge(cl);
+  ASSERT_EQ((size_t)1, cl._num_full);
+  ASSERT_EQ((size_t)0, cl._num_cards);
+
+  for (size_t c = 0; c < HeapRegion::CardsPerRegion; c++) {
+    ASSERT_TRUE(card_set.contains_card(7, (G1CardSet::CardElem)c));
+  }
+}
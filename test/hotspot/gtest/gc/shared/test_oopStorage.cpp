@@ -386,6 +386,43 @@ TEST_VM_F(OopStorageTest, allocate_many) {
   }
 }
 
+TEST_VM_F(OopStorageTest, bulk_allocation) {
+  static const size_t max_entries = 1000;
+  oop* entries[max_entries];
+
+  AllocationList& allocation_list = TestAccess::allocation_list(_storage);
+
+  // Taking fewer entries than the block has leaves the rest available.
+  size_t taken = _storage.allocate(entries, 5);
+  EXPECT_EQ(5u, taken);
+  EXPECT_EQ(5u, _storage.allocation_count());
+  EXPECT_EQ(1u, _storage.block_count());
+  EXPECT_TRUE(process_deferred_updates(_storage));
+  EXPECT_EQ(1u, list_length(allocation_list));
+
+  const OopBlock& block = *TestAccess::active_array(_storage).at(0);
+  EXPECT_EQ(5u, TestAccess::block_allocation_count(block));
+  for (size_t i = 0; i < taken; ++i) {
+    ASSERT_TRUE(entries[i] != NULL);
+    EXPECT_EQ(OopStorage::ALLOCATED_ENTRY, _storage.allocation_status(entries[i]));
+  }
+
+  // Asking for more than the block has takes the rest of the block.
+  size_t rest = _storage.allocate(entries + taken, max_entries - taken);
+  EXPECT_LT(rest, max_entries - taken);
+  EXPECT_EQ(taken + rest, _storage.allocation_count());
+  EXPECT_EQ(1u, _storage.block_count());
+  EXPECT_TRUE(TestAccess::block_is_full(block));
+  EXPECT_TRUE(is_list_empty(allocation_list));
+
+  for (size_t i = 0; i < taken + rest; ++i) {
+    release_entry(_storage, entries[i]);
+  }
+  EXPECT_EQ(0u, _storage.allocation_count());
+  EXPECT_TRUE(TestAccess::block_is_empty(block));
+  EXPECT_EQ(1u, list_length(allocation_list));
+}
+
 TEST_VM_F(OopStorageTestWithAllocation, random_release) {
   static const size_t step = 11;
   ASSERT_NE(0u, _max_entries % step); // max_entries and step are mutually prime
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "utilities/debug.hpp"
+#include "benchmarkHelper.inline.hpp"
+#include "unittest.hpp"
+
+// Throughput of OopStorage allocation and release. Entries are allocated
+// one at a time and released in batches, the way JNI handle blocks and
+// the string table use the storage.
+
+class OopStorageAllocateReleaseOp {
+  OopStorage* _storage;
+  size_t _batch;
+public:
+  OopStorageAllocateReleaseOp(OopStorage* storage, size_t batch) :
+    _storage(storage), _batch(batch) {}
+
+  void operator()(uint worker_id, size_t count) {
+    const size_t max_batch = 256;
+    oop* entries[max_batch];
+    size_t batch = MIN2(_batch, max_batch);
+    for (size_t done = 0; done < count; ) {
+      size_t n = MIN2(batch, count - done);
+      for (size_t i = 0; i < n; i++) {
+        entries[i] = _storage->allocate();
+        guarantee(entries[i] != NULL, "allocation failed");
+      }
+      if (n == 1) {
+        _storage->release(entries[0]);
+      } else {
+        _storage->release(entries, n);
+      }
+      done += n;
+    }
+  }
+};
+
+TEST_VM_BENCHMARK(OopStorage, allocate_release) {
+  OopStorage storage("Benchmark Storage");
+  OopStorageAllocateReleaseOp op(&storage, 1);
+  BenchmarkRunner::run_scaling("allocate_release", &op, 100000);
+}
+
+TEST_VM_BENCHMARK(OopStorage, allocate_release_batch) {
+  OopStorage storage("Benchmark Storage");
+  OopStorageAllocateReleaseOp op(&storage, 256);
+  BenchmarkRunner::run_scaling("allocate_release_batch", &op, 100000);
+}
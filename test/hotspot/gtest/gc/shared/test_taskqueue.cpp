@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "unittest.hpp"
+
+typedef GenericTaskQueue<int, mtGC> TestTaskQueue;
+typedef GenericTaskQueueSet<TestTaskQueue, mtGC> TestTaskQueueSet;
+
+TEST_VM(TaskQueueSet, steal_preferred_first) {
+  const uint num_queues = 3;
+  TestTaskQueueSet queue_set(num_queues);
+  TestTaskQueue* queues[num_queues];
+  for (uint i = 0; i < num_queues; i++) {
+    queues[i] = new TestTaskQueue();
+    queues[i]->initialize();
+    queue_set.register_queue(i, queues[i]);
+  }
+
+  ASSERT_TRUE(queues[1]->push(1));
+  ASSERT_TRUE(queues[2]->push(2));
+
+  const uint preferred[] = { 2 };
+  int task = 0;
+  ASSERT_TRUE(queue_set.steal(0, preferred, 1, task));
+  EXPECT_EQ(2, task);
+
+  // The preferred queue is empty now, fall back to any other queue.
+  ASSERT_TRUE(queue_set.steal(0, preferred, 1, task));
+  EXPECT_EQ(1, task);
+
+  EXPECT_FALSE(queue_set.steal(0, preferred, 1, task));
+
+  for (uint i = 0; i < num_queues; i++) {
+    delete queues[i];
+  }
+}
+
+TEST_VM(TaskQueueSet, steal_half) {
+  const uint num_queues = 2;
+  TestTaskQueueSet queue_set(num_queues);
+  TestTaskQueue* queues[num_queues];
+  for (uint i = 0; i < num_queues; i++) {
+    queues[i] = new TestTaskQueue();
+    queues[i]->initialize();
+    queue_set.register_queue(i, queues[i]);
+  }
+
+  const int num_tasks = 9;
+  for (int i = 0; i < num_tasks; i++) {
+    ASSERT_TRUE(queues[1]->push(i));
+  }
+
+  // Steals the oldest task, then half of the remaining ones.
+  int task = -1;
+  ASSERT_TRUE(queue_set.steal_half(0, task));
+  EXPECT_EQ(0, task);
+  EXPECT_EQ(4u, queues[0]->size());
+  EXPECT_EQ(4u, queues[1]->size());
+
+  // All tasks are still there exactly once.
+  bool seen[num_tasks] = {};
+  seen[task] = true;
+  for (uint i = 0; i < num_queues; i++) {
+    while (queues[i]->pop_local(task)) {
+      ASSERT_TRUE(task >= 0 && task < num_tasks);
+      EXPECT_FALSE(seen[task]);
+      seen[task] = true;
+    }
+  }
+  for (int i = 0; i < num_tasks; i++) {
+    EXPECT_TRUE(seen[i]);
+  }
+
+  EXPECT_FALSE(queue_set.steal_half(0, task));
+
+  for (uint i = 0; i < num_queues; i++) {
+    delete queues[i];
+  }
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "utilities/debug.hpp"
+#include "benchmarkHelper.inline.hpp"
+#include "unittest.hpp"
+
+// Throughput of task queue push/pop_local by the owner and of stealing
+// through the queue set.
+
+typedef GenericTaskQueue<int, mtGC> BenchTaskQueue;
+typedef GenericTaskQueueSet<BenchTaskQueue, mtGC> BenchTaskQueueSet;
+
+const uint bench_chunk = 1024;
+
+class TaskQueueFixture {
+  uint _num_queues;
+public:
+  BenchTaskQueueSet _set;
+  BenchTaskQueue** _queues;
+
+  TaskQueueFixture(uint num_queues) :
+    _num_queues(num_queues), _set(num_queues),
+    _queues(NEW_C_HEAP_ARRAY(BenchTaskQueue*, num_queues, mtGC)) {
+    for (uint i = 0; i < num_queues; i++) {
+      _queues[i] = new BenchTaskQueue();
+      _queues[i]->initialize();
+      _set.register_queue(i, _queues[i]);
+    }
+  }
+
+  ~TaskQueueFixture() {
+    for (uint i = 0; i < _num_queues; i++) {
+      delete _queues[i];
+    }
+    FREE_C_HEAP_ARRAY(BenchTaskQueue*, _queues);
+  }
+};
+
+class TaskQueuePushPopOp {
+  TaskQueueFixture* _fixture;
+public:
+  TaskQueuePushPopOp(TaskQueueFixture* fixture) : _fixture(fixture) {}
+
+  void operator()(uint worker_id, size_t count) {
+    BenchTaskQueue* queue = _fixture->_queues[worker_id];
+    int task;
+    for (size_t done = 0; done < count; ) {
+      size_t n = MIN2((size_t)bench_chunk, count - done);
+      for (size_t i = 0; i < n; i++) {
+        guarantee(queue->push((int)i), "queue full");
+      }
+      for (size_t i = 0; i < n; i++) {
+        guarantee(queue->pop_local(task), "queue empty");
+      }
+      done += n;
+    }
+  }
+};
+
+// Each worker pushes a chunk onto its own queue and then takes the same
+// number of tasks by stealing, competing with the other workers. Whatever
+// is left in its own queue is drained locally so every chunk starts out
+// from an empty queue.
+class TaskQueuePushStealOp {
+  TaskQueueFixture* _fixture;
+public:
+  TaskQueuePushStealOp(TaskQueueFixture* fixture) : _fixture(fixture) {}
+
+  void operator()(uint worker_id, size_t count) {
+    BenchTaskQueue* queue = _fixture->_queues[worker_id];
+    int task;
+    for (size_t done = 0; done < count; ) {
+      size_t n = MIN2((size_t)bench_chunk, count - done);
+      for (size_t i = 0; i < n; i++) {
+        guarantee(queue->push((int)i), "queue full");
+      }
+      for (size_t i = 0; i < n; i++) {
+        if (!_fixture->_set.steal(worker_id, task)) {
+          break;
+        }
+      }
+      while (queue->pop_local(task)) {}
+      done += n;
+    }
+  }
+};
+
+TEST_VM_BENCHMARK(TaskQueue, push_pop) {
+  TaskQueueFixture fixture(BenchmarkRunner::max_threads());
+  TaskQueuePushPopOp op(&fixture);
+  BenchmarkRunner::run_scaling("push_pop", &op, 1000000);
+}
+
+TEST_VM_BENCHMARK(TaskQueue, push_steal) {
+  TaskQueueFixture fixture(BenchmarkRunner::max_threads());
+  TaskQueuePushStealOp op(&fixture);
+  BenchmarkRunner::run_scaling("push_steal", &op, 200000);
+}
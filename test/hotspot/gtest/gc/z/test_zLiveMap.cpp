@@ -48,8 +48,29 @@ protected:
 
     ASSERT_TRUE(inc_live);
   }
+
+  static void live_largest() {
+    ZLiveMap livemap(8);
+
+    bool inc_live;
+
+    // Marking the first object resets the live information.
+    livemap.set(0, false /* finalizable */, inc_live);
+
+    livemap.inc_live(1, 16, 16);
+    livemap.inc_live(2, 96, 64);
+    livemap.inc_live(1, 32, 32);
+
+    ASSERT_EQ(livemap.live_objects(), 4u);
+    ASSERT_EQ(livemap.live_bytes(), (size_t)144);
+    ASSERT_EQ(livemap.live_largest(), (size_t)64);
+  }
 };
 
 TEST_F(ZLiveMapTest, strongly_live_for_large_zpage) {
   strongly_live_for_large_zpage();
 }
+
+TEST_F(ZLiveMapTest, live_largest) {
+  live_largest();
+}
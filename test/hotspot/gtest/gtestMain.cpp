@@ -46,6 +46,11 @@ const static bool DEFAULT_SPAWN_IN_NEW_THREAD = true;
 const static bool DEFAULT_SPAWN_IN_NEW_THREAD = false;
 #endif
 
+bool BenchmarkOptions::enabled = false;
+int BenchmarkOptions::warmup = 2;
+int BenchmarkOptions::iterations = 5;
+int BenchmarkOptions::max_threads = 0;
+
 static bool is_prefix(const char* prefix, const char* str) {
   return strncmp(str, prefix, strlen(prefix)) == 0;
 }
@@ -158,6 +163,23 @@ static bool get_spawn_new_main_thread_arg(int argc, char** argv) {
   return DEFAULT_SPAWN_IN_NEW_THREAD;
 }
 
+static void get_benchmark_args(int argc, char** argv) {
+  // -benchmark, -benchmark-warmup=<n>, -benchmark-iterations=<n>, -benchmark-threads=<n>
+  for (int i = 0; i < argc; i++) {
+    if (strcmp(argv[i], "-benchmark") == 0) {
+      BenchmarkOptions::enabled = true;
+    } else if (is_prefix("-benchmark-warmup=", argv[i])) {
+      BenchmarkOptions::warmup = atoi(argv[i] + strlen("-benchmark-warmup="));
+    } else if (is_prefix("-benchmark-iterations=", argv[i])) {
+      BenchmarkOptions::iterations = atoi(argv[i] + strlen("-benchmark-iterations="));
+    } else if (is_prefix("-benchmark-threads=", argv[i])) {
+      BenchmarkOptions::max_threads = atoi(argv[i] + strlen("-benchmark-threads="));
+    } else if (is_prefix("-benchmark", argv[i])) {
+      fprintf(stderr, "Invalid benchmark option (%s)\n", argv[i]);
+    }
+  }
+}
+
 static int num_args_to_skip(char* arg) {
   if (strcmp(arg, "-jdk") == 0) {
     return 2; // skip the argument after -jdk as well
@@ -171,6 +193,9 @@ static int num_args_to_skip(char* arg) {
   if (is_prefix("-new-thread", arg)) {
     return 1;
   }
+  if (is_prefix("-benchmark", arg)) {
+    return 1;
+  }
   return 0;
 }
 
@@ -199,6 +224,14 @@ static void runUnitTestsInner(int argc, char** argv) {
   ::testing::InitGoogleMock(&argc, argv);
   ::testing::GTEST_FLAG(death_test_style) = "threadsafe";
 
+  get_benchmark_args(argc, argv);
+  if (!BenchmarkOptions::enabled) {
+    // TEST_VM_BENCHMARK tests only run when asked for
+    std::string& filter = ::testing::GTEST_FLAG(filter);
+    filter += (filter.find('-') == std::string::npos) ? "-" : ":";
+    filter += "*_benchmark_test_vm";
+  }
+
   bool is_vmassert_test = false;
   bool is_othervm_test = false;
   // death tests facility is used for both regular death tests, other vm and vmassert tests
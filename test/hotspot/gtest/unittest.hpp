@@ -78,6 +78,19 @@
   GTEST_TEST_(test_fixture, name ## _test_vm, test_fixture,         \
               ::testing::internal::GetTypeId<test_fixture>())
 
+// Benchmarks of VM internals, see benchmarkHelper.inline.hpp. They are
+// only run when the launcher is given -benchmark.
+#define TEST_VM_BENCHMARK(category, name) GTEST_TEST(category, CONCAT(name, _benchmark_test_vm))
+
+// Set by the launcher from -benchmark, -benchmark-warmup=<n>,
+// -benchmark-iterations=<n> and -benchmark-threads=<n>.
+struct BenchmarkOptions {
+  static bool enabled;
+  static int warmup;
+  static int iterations;
+  static int max_threads;    // 0 means active processor count, capped at 16
+};
+
 #define TEST_OTHER_VM(category, name)                               \
   static void test_  ## category ## _ ## name ## _();               \
                                                                     \
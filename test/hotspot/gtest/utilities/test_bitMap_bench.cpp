@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "utilities/debug.hpp"
+#include "benchmarkHelper.inline.hpp"
+#include "unittest.hpp"
+
+// Throughput of BitMap searches over maps of different densities.
+
+const BitMap::idx_t bench_bits = (BitMap::idx_t)1 << 20;
+
+class BitMapSearchOp {
+  const BitMap* _map;
+  // Bits found by all workers. Keeps the searches from being optimized away.
+  volatile size_t _found;
+public:
+  BitMapSearchOp(const BitMap* map) : _map(map), _found(0) {}
+
+  void operator()(uint worker_id, size_t count) {
+    BitMap::idx_t size = _map->size();
+    BitMap::idx_t pos = (worker_id * (size / 16)) % size;
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+      pos = _map->get_next_one_offset(pos + 1, size);
+      if (pos >= size) {
+        pos = 0;
+      } else {
+        found++;
+      }
+    }
+    Atomic::add(&_found, found);
+  }
+
+  size_t found() const { return _found; }
+};
+
+static void run_search(const char* label, BitMap::idx_t stride) {
+  CHeapBitMap map(bench_bits, mtTest);
+  for (BitMap::idx_t i = 0; i < bench_bits; i += stride) {
+    map.set_bit(i);
+  }
+  BitMapSearchOp op(&map);
+  BenchmarkRunner::run_scaling(label, &op, 100000);
+  ASSERT_GT(op.found(), 0u) << "no bits found";
+}
+
+TEST_VM_BENCHMARK(BitMap, search_sparse) {
+  run_search("search_sparse", 997);
+}
+
+TEST_VM_BENCHMARK(BitMap, search_dense) {
+  run_search("search_dense", 3);
+}
@@ -256,3 +256,42 @@ TEST(BitMap, search) {
     }
   }
 }
+
+// Exercise the search over long runs of uninteresting words, with the single
+// interesting bit placed at every word position relative to the start of the
+// search, so that the grouped word skipping stops in all group positions.
+TEST(BitMap, search_sparse) {
+  const idx_t nwords = 37;
+  const idx_t size = nwords * BitsPerWord;
+  CHeapBitMap test_ones(size);
+  CHeapBitMap test_zeros(size);
+
+  test_ones.clear_range(0, size);
+  test_zeros.set_range(0, size);
+
+  const idx_t bit_offsets[] = { 0, 1, BitsPerWord / 2, BitsPerWord - 1 };
+
+  for (idx_t start = 0; start < 3 * BitsPerWord; start += BitsPerWord / 2 + 1) {
+    for (idx_t w = 0; w < nwords; ++w) {
+      for (size_t o = 0; o < ARRAY_SIZE(bit_offsets); ++o) {
+        idx_t bit = w * BitsPerWord + bit_offsets[o];
+        test_ones.set_bit(bit);
+        test_zeros.clear_bit(bit);
+
+        idx_t expected = (bit >= start) ? bit : size;
+        EXPECT_EQ(expected, test_ones.get_next_one_offset(start, size));
+        EXPECT_EQ(expected, test_zeros.get_next_zero_offset(start, size));
+        EXPECT_EQ(expected, test_ones.get_next_one_offset_aligned_right(start, size));
+
+        // Search bounded just before the bit must not find it.
+        if (bit > start) {
+          EXPECT_EQ(bit, test_ones.get_next_one_offset(start, bit));
+          EXPECT_EQ(bit, test_zeros.get_next_zero_offset(start, bit));
+        }
+
+        test_ones.clear_bit(bit);
+        test_zeros.set_bit(bit);
+      }
+    }
+  }
+}
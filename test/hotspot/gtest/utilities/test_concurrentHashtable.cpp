@@ -374,6 +374,38 @@ static void cht_task_grow(Thread* thr) {
   delete cht;
 }
 
+static void cht_task_grow_small_chunks(Thread* thr) {
+  const size_t log2_size = 10;
+  const size_t task_size_log2 = 4;
+  const uintptr_t num_values = 2000;
+  SimpleTestTable* cht = new SimpleTestTable(log2_size, log2_size + 2);
+
+  for (uintptr_t v = 1; v <= num_values; v++) {
+    SimpleTestLookup stl(v);
+    EXPECT_TRUE(cht->insert(thr, stl, v)) << "Insert unique value failed.";
+  }
+
+  SimpleTestTable::GrowTask gt(cht);
+  gt.set_task_size_log2(task_size_log2);
+  EXPECT_TRUE(gt.prepare(thr)) << "Growing uncontended should not fail.";
+  size_t tasks = 0;
+  while (gt.do_task(thr)) {
+    tasks++;
+    gt.pause(thr);
+    gt.cont(thr);
+  }
+  gt.done(thr);
+  EXPECT_EQ(tasks, (size_t)1 << (log2_size - task_size_log2)) << "Wrong number of tasks.";
+  EXPECT_EQ(cht->get_size_log2(thr), log2_size + 1) << "Table should have grown.";
+
+  for (uintptr_t v = 1; v <= num_values; v++) {
+    SimpleTestLookup stl(v);
+    EXPECT_EQ(cht_get_copy(cht, thr, stl), v) << "Getting an item after grow failed.";
+  }
+
+  delete cht;
+}
+
 TEST_VM(ConcurrentHashTable, basic_insert) {
   nomt_test_doer(cht_insert);
 }
@@ -410,6 +442,10 @@ TEST_VM(ConcurrentHashTable, task_grow) {
   nomt_test_doer(cht_task_grow);
 }
 
+TEST_VM(ConcurrentHashTable, task_grow_small_chunks) {
+  nomt_test_doer(cht_task_grow_small_chunks);
+}
+
 //#############################################################################################
 
 class TestInterface : public AllStatic {
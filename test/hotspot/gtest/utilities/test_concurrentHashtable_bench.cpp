@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/debug.hpp"
+#include "benchmarkHelper.inline.hpp"
+#include "unittest.hpp"
+
+// Throughput of ConcurrentHashTable lookups and insert/remove pairs.
+
+struct BenchConfig : public AllStatic {
+  typedef uintptr_t Value;
+  static uintx get_hash(const Value& value, bool* dead_hash) {
+    return (uintx)(value * UCONST64(0x9E3779B97F4A7C15));
+  }
+  static void* allocate_node(size_t size, const Value& value) {
+    return ::malloc(size);
+  }
+  static void free_node(void* memory, const Value& value) {
+    ::free(memory);
+  }
+};
+
+typedef ConcurrentHashTable<BenchConfig, mtInternal> BenchTable;
+
+struct BenchLookup {
+  uintptr_t _val;
+  BenchLookup(uintptr_t val) : _val(val) {}
+  uintx get_hash() {
+    return BenchConfig::get_hash(_val, NULL);
+  }
+  bool equals(const uintptr_t* value, bool* is_dead) {
+    return _val == *value;
+  }
+};
+
+struct BenchFound {
+  uintptr_t _value;
+  BenchFound() : _value(0) {}
+  void operator()(uintptr_t* value) {
+    _value = *value;
+  }
+};
+
+const size_t bench_log2_size = 16;
+const uintptr_t bench_entries = (uintptr_t)1 << bench_log2_size;
+
+static BenchTable* create_populated_table() {
+  BenchTable* table = new BenchTable(bench_log2_size, bench_log2_size);
+  for (uintptr_t v = 1; v <= bench_entries; v++) {
+    table->unsafe_insert(v);
+  }
+  return table;
+}
+
+class CHTGetOp {
+  BenchTable* _table;
+public:
+  CHTGetOp(BenchTable* table) : _table(table) {}
+
+  void operator()(uint worker_id, size_t count) {
+    Thread* thread = Thread::current();
+    uintptr_t key = worker_id * 7919;
+    for (size_t i = 0; i < count; i++) {
+      key = (key + 40503) & (bench_entries - 1);
+      BenchLookup lookup(key + 1);
+      BenchFound found;
+      guarantee(_table->get(thread, lookup, found), "missing key");
+    }
+  }
+};
+
+// Each worker inserts and removes keys from its own range above the
+// populated entries, so the table size stays constant.
+class CHTInsertRemoveOp {
+  BenchTable* _table;
+public:
+  CHTInsertRemoveOp(BenchTable* table) : _table(table) {}
+
+  void operator()(uint worker_id, size_t count) {
+    Thread* thread = Thread::current();
+    uintptr_t base = bench_entries + 1 + (uintptr_t)worker_id * count;
+    for (size_t i = 0; i < count; i++) {
+      BenchLookup lookup(base + i);
+      guarantee(_table->insert(thread, lookup, base + i), "duplicate key");
+      guarantee(_table->remove(thread, lookup), "missing key");
+    }
+  }
+};
+
+TEST_VM_BENCHMARK(ConcurrentHashTable, get) {
+  BenchTable* table = create_populated_table();
+  CHTGetOp op(table);
+  BenchmarkRunner::run_scaling("get", &op, 200000);
+  delete table;
+}
+
+TEST_VM_BENCHMARK(ConcurrentHashTable, insert_remove) {
+  BenchTable* table = create_populated_table();
+  CHTInsertRemoveOp op(table);
+  BenchmarkRunner::run_scaling("insert_remove", &op, 20000);
+  delete table;
+}
@@ -555,3 +555,34 @@ TEST(GrowableArrayCHeap, sanity) {
     delete a;
   }
 }
+
+TEST_VM(GrowableArrayInline, sanity) {
+  ResourceMark rm;
+  GrowableArrayInline<int, 4> a;
+  ASSERT_TRUE(a.is_empty());
+  ASSERT_TRUE(a.is_inline());
+
+  for (int i = 0; i < 4; i++) {
+    a.append(i);
+  }
+  ASSERT_TRUE(a.is_inline());
+
+  // Growing moves the elements out of the embedded storage
+  for (int i = 4; i < 100; i++) {
+    a.append(i);
+  }
+  ASSERT_FALSE(a.is_inline());
+  ASSERT_EQ(a.length(), 100);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(a.at(i), i);
+  }
+
+  Arena arena(mtTest);
+  GrowableArrayInline<int, 2> b(&arena);
+  for (int i = 0; i < 10; i++) {
+    b.push(i);
+  }
+  ASSERT_FALSE(b.is_inline());
+  ASSERT_EQ(b.pop(), 9);
+  ASSERT_EQ(b.length(), 9);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "unittest.hpp"
+#include "utilities/latencyHistogram.hpp"
+
+// Histograms register themselves globally and are never freed.
+
+TEST(LatencyHistogram, empty) {
+  LatencyHistogram* h = new LatencyHistogram("test empty");
+  EXPECT_EQ(0u, h->total());
+  EXPECT_EQ(0, h->percentile(0.5));
+  EXPECT_EQ(0, h->max());
+}
+
+TEST(LatencyHistogram, small_values_are_exact) {
+  LatencyHistogram* h = new LatencyHistogram("test small");
+  for (jlong v = 0; v < 8; v++) {
+    h->record(v);
+  }
+  EXPECT_EQ(8u, h->total());
+  EXPECT_EQ(3, h->percentile(0.5));
+  EXPECT_EQ(7, h->percentile(1.0));
+  EXPECT_EQ(7, h->max());
+}
+
+TEST(LatencyHistogram, percentiles) {
+  LatencyHistogram* h = new LatencyHistogram("test percentiles");
+  for (jlong v = 1; v <= 1000; v++) {
+    h->record(v);
+  }
+  EXPECT_EQ(1000u, h->total());
+  EXPECT_EQ(1000, h->max());
+
+  jlong p50 = h->percentile(0.5);
+  EXPECT_LE(500, p50);
+  EXPECT_GE(500 + 500 / 8, p50);
+
+  jlong p99 = h->percentile(0.99);
+  EXPECT_LE(990, p99);
+  EXPECT_GE(1000, p99);
+
+  // Never above the largest recorded value
+  EXPECT_EQ(1000, h->percentile(1.0));
+}
+
+TEST(LatencyHistogram, large_values) {
+  LatencyHistogram* h = new LatencyHistogram("test large");
+  const jlong second = NANOSECS_PER_SEC;
+  h->record(second);
+  h->record(max_jlong);
+  EXPECT_LE(second, h->percentile(0.5));
+  EXPECT_GE(second + second / 8, h->percentile(0.5));
+  EXPECT_EQ(max_jlong, h->percentile(1.0));
+}
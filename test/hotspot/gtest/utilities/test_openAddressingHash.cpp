@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+#include "unittest.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/openAddressingHash.hpp"
+#include "utilities/resourceHash.hpp"
+
+class OpenAddressingHashtableTest : public ::testing::Test {
+ protected:
+  typedef void* K;
+  typedef uintx V;
+
+  static unsigned identity_hash(const K& k) {
+    return (unsigned) (uintptr_t) k;
+  }
+
+  static unsigned bad_hash(const K& k) {
+    return 1;
+  }
+
+  static void* as_K(uintptr_t val) {
+    return (void*) val;
+  }
+
+  class EqualityTestIter {
+   public:
+    size_t _count;
+
+    EqualityTestIter() : _count(0) {}
+
+    bool do_entry(K const& k, V const& v) {
+      _count++;
+      if ((uintptr_t) k != (uintptr_t) v) {
+        EXPECT_EQ((uintptr_t) k, (uintptr_t) v);
+        return false;
+      } else {
+        return true; // continue iteration
+      }
+    }
+  };
+
+  template<unsigned (*HASH) (K const&) = primitive_hash<K> >
+  class Runner : public AllStatic {
+   public:
+
+    static void test_small(V step) {
+      EqualityTestIter et;
+      OpenAddressingHashtable<K, V, HASH> ht;
+
+      ASSERT_FALSE(ht.contains(as_K(step)));
+
+      ASSERT_TRUE(ht.put(as_K(step), step));
+      ASSERT_TRUE(ht.contains(as_K(step)));
+
+      ASSERT_FALSE(ht.put(as_K(step), step));
+
+      ASSERT_TRUE(ht.put(as_K(2 * step), 2 * step));
+      ASSERT_TRUE(ht.put(as_K(3 * step), 3 * step));
+      ASSERT_TRUE(ht.put(as_K(4 * step), 4 * step));
+      ASSERT_TRUE(ht.put(as_K(5 * step), 5 * step));
+      ASSERT_EQ((size_t)5, ht.number_of_entries());
+
+      ASSERT_FALSE(ht.remove(as_K(0x0)));
+
+      ht.iterate(&et);
+      ASSERT_EQ((size_t)5, et._count);
+
+      ASSERT_TRUE(ht.remove(as_K(step)));
+      ASSERT_FALSE(ht.contains(as_K(step)));
+      ASSERT_TRUE(ht.contains(as_K(5 * step)));
+
+      // Test put_if_absent(key) (creating a default-created value)
+      bool created = false;
+      V* v = ht.put_if_absent(as_K(step), &created);
+      ASSERT_TRUE(ht.contains(as_K(step)));
+      ASSERT_TRUE(created);
+      ASSERT_EQ((V)0, *v);
+      *v = (V)step;
+
+      V* v2 = ht.put_if_absent(as_K(step), &created);
+      ASSERT_EQ(v, v2);
+      ASSERT_FALSE(created);
+
+      // Test put_if_absent(key, value)
+      ASSERT_TRUE(ht.remove(as_K(step)));
+      v = ht.put_if_absent(as_K(step), step, &created);
+      ASSERT_EQ(*v, step);
+      ASSERT_TRUE(created);
+      v2 = ht.put_if_absent(as_K(step), 7 * step, &created);
+      ASSERT_EQ(*v2, step);
+      ASSERT_FALSE(created);
+    }
+
+    // Enough entries to grow the table several times, removing every
+    // other one to exercise the backward shift.
+    static void test_large(V step, uintptr_t n) {
+      OpenAddressingHashtable<K, V, HASH> ht(8);
+
+      for (uintptr_t i = 1; i <= n; i++) {
+        ASSERT_TRUE(ht.put(as_K(i * step), i * step));
+      }
+      ASSERT_EQ((size_t)n, ht.number_of_entries());
+      for (uintptr_t i = 1; i <= n; i++) {
+        V* v = ht.get(as_K(i * step));
+        ASSERT_TRUE(v != NULL);
+        ASSERT_EQ(i * step, *v);
+      }
+      for (uintptr_t i = 1; i <= n; i += 2) {
+        ASSERT_TRUE(ht.remove(as_K(i * step)));
+      }
+      for (uintptr_t i = 1; i <= n; i++) {
+        ASSERT_EQ((i % 2) == 0, ht.contains(as_K(i * step)));
+      }
+
+      EqualityTestIter et;
+      ht.iterate(&et);
+      ASSERT_EQ((size_t)(n / 2), et._count);
+      ASSERT_EQ((size_t)(n / 2), ht.number_of_entries());
+    }
+  };
+};
+
+TEST_VM_F(OpenAddressingHashtableTest, small_default) {
+  Runner<>::test_small(0x1);
+}
+
+TEST_VM_F(OpenAddressingHashtableTest, small_default_shifted) {
+  Runner<>::test_small(0x10);
+}
+
+TEST_VM_F(OpenAddressingHashtableTest, small_bad_hash) {
+  Runner<bad_hash>::test_small(0x1);
+}
+
+TEST_VM_F(OpenAddressingHashtableTest, small_identity_hash_shifted) {
+  Runner<identity_hash>::test_small(0x10);
+}
+
+TEST_VM_F(OpenAddressingHashtableTest, large_default) {
+  Runner<>::test_large(0x1, 10000);
+}
+
+TEST_VM_F(OpenAddressingHashtableTest, large_identity_hash_shifted) {
+  Runner<identity_hash>::test_large(0x1000, 10000);
+}
+
+TEST_VM_F(OpenAddressingHashtableTest, large_bad_hash) {
+  Runner<bad_hash>::test_large(0x1, 500);
+}
+
+// Random puts and removes, checked against a ResourceHashtable.
+TEST_VM_F(OpenAddressingHashtableTest, random_against_resource_hash) {
+  typedef ResourceHashtable<K, V, primitive_hash<K>, primitive_equals<K>, 1031, ResourceObj::C_HEAP> Reference;
+  Reference* expected = new (ResourceObj::C_HEAP, mtTest) Reference();
+  OpenAddressingHashtable<K, V> ht;
+  size_t entries = 0;
+
+  for (int i = 0; i < 100000; i++) {
+    uintptr_t key = 1 + os::random() % 4096;
+    if (os::random() % 3 == 0) {
+      bool removed = expected->remove(as_K(key));
+      ASSERT_EQ(removed, ht.remove(as_K(key)));
+      entries -= removed ? 1 : 0;
+    } else {
+      bool added = expected->put(as_K(key), (V)i);
+      ASSERT_EQ(added, ht.put(as_K(key), (V)i));
+      entries += added ? 1 : 0;
+    }
+  }
+
+  ASSERT_EQ(entries, ht.number_of_entries());
+  for (uintptr_t key = 1; key <= 4096; key++) {
+    V* e = expected->get(as_K(key));
+    V* v = ht.get(as_K(key));
+    ASSERT_EQ(e == NULL, v == NULL);
+    if (e != NULL) {
+      ASSERT_EQ(*e, *v);
+    }
+  }
+  delete expected;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Methods profiled with sampled counter updates still reach C2.
+ * @requires vm.compiler1.enabled & vm.compiler2.enabled & vm.opt.TieredStopAtLevel == null
+ * @library /test/lib /
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ *
+ * @build sun.hotspot.WhiteBox
+ * @run driver ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UnlockExperimentalVMOptions -XX:C1ProfileCounterSampling=4
+ *                   -XX:+TieredCompilation -XX:-BackgroundCompilation
+ *                   compiler.c1.TestProfileCounterSampling
+ */
+
+package compiler.c1;
+
+import compiler.whitebox.CompilerWhiteBoxTest;
+import sun.hotspot.WhiteBox;
+
+import java.lang.reflect.Method;
+
+public class TestProfileCounterSampling {
+
+    private static final WhiteBox WHITE_BOX = WhiteBox.getWhiteBox();
+
+    static int call(int i) {
+        return i * 31 + 7;
+    }
+
+    static int loop(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += call(i);
+        }
+        return sum;
+    }
+
+    static int expected(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += i * 31 + 7;
+        }
+        return sum;
+    }
+
+    public static void main(String[] args) throws Exception {
+        Method m = TestProfileCounterSampling.class.getDeclaredMethod("loop", int.class);
+        for (int i = 0; i < 100_000; i++) {
+            int n = i % 100;
+            if (loop(n) != expected(n)) {
+                throw new RuntimeException("Wrong result for " + n);
+            }
+            if (WHITE_BOX.getMethodCompilationLevel(m) == CompilerWhiteBoxTest.COMP_LEVEL_FULL_OPTIMIZATION) {
+                return;
+            }
+        }
+        throw new RuntimeException("loop() was not compiled by C2, level " +
+                                   WHITE_BOX.getMethodCompilationLevel(m));
+    }
+}
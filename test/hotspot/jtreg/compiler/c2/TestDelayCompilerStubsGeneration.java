@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Intrinsic stubs generated by the C2 compiler thread give the same results.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -XX:-BackgroundCompilation
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+DelayCompilerStubsGeneration
+ *                   compiler.c2.TestDelayCompilerStubsGeneration
+ * @run main/othervm -XX:-BackgroundCompilation
+ *                   -XX:+UnlockExperimentalVMOptions -XX:-DelayCompilerStubsGeneration
+ *                   compiler.c2.TestDelayCompilerStubsGeneration
+ * @run main/othervm -XX:TieredStopAtLevel=1
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+DelayCompilerStubsGeneration
+ *                   compiler.c2.TestDelayCompilerStubsGeneration
+ */
+
+package compiler.c2;
+
+import java.security.MessageDigest;
+import java.util.Arrays;
+import java.util.Base64;
+
+public class TestDelayCompilerStubsGeneration {
+
+    static byte[] digest(MessageDigest md, byte[] data) {
+        md.reset();
+        return md.digest(data);
+    }
+
+    static byte[] encode(byte[] data) {
+        return Base64.getEncoder().encode(data);
+    }
+
+    public static void main(String[] args) throws Exception {
+        byte[] data = new byte[1024];
+        for (int i = 0; i < data.length; i++) {
+            data[i] = (byte)(i * 31);
+        }
+        MessageDigest md = MessageDigest.getInstance("SHA-256");
+        byte[] expectedDigest = digest(md, data);
+        byte[] expectedEncoding = encode(data);
+        for (int i = 0; i < 20_000; i++) {
+            if (!Arrays.equals(digest(md, data), expectedDigest)) {
+                throw new RuntimeException("SHA-256 digest mismatch in iteration " + i);
+            }
+            if (!Arrays.equals(encode(data), expectedEncoding)) {
+                throw new RuntimeException("Base64 encoding mismatch in iteration " + i);
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Call sites with three to five receivers give the same result with guarded inlining.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -XX:-BackgroundCompilation -XX:TypeProfileWidth=4
+ *                   compiler.c2.TestPolymorphicInlining
+ * @run main/othervm -XX:-BackgroundCompilation -XX:TypeProfileWidth=4 -XX:PolymorphicInlineLimit=3
+ *                   compiler.c2.TestPolymorphicInlining
+ * @run main/othervm -XX:-BackgroundCompilation -XX:TypeProfileWidth=4 -XX:-UsePolymorphicInlining
+ *                   compiler.c2.TestPolymorphicInlining
+ */
+
+package compiler.c2;
+
+public class TestPolymorphicInlining {
+
+    static abstract class Node {
+        abstract int eval();
+    }
+
+    static class A extends Node { int eval() { return 1; } }
+    static class B extends Node { int eval() { return 2; } }
+    static class C extends Node { int eval() { return 3; } }
+    static class D extends Node { int eval() { return 4; } }
+    static class E extends Node { int eval() { return 5; } }
+
+    static int sum(Node[] nodes) {
+        int res = 0;
+        for (Node n : nodes) {
+            res += n.eval();
+        }
+        return res;
+    }
+
+    static int expected(Node[] nodes) {
+        int res = 0;
+        for (Node n : nodes) {
+            res += (n instanceof A) ? 1 : (n instanceof B) ? 2 : (n instanceof C) ? 3 :
+                   (n instanceof D) ? 4 : 5;
+        }
+        return res;
+    }
+
+    public static void main(String[] args) {
+        Node[] three = { new A(), new B(), new C(), new A(), new B(), new A() };
+        Node[] four  = { new A(), new B(), new C(), new D() };
+        Node[] five  = { new A(), new B(), new C(), new D(), new E() };
+        for (int i = 0; i < 20_000; i++) {
+            check(three);
+            check(four);
+        }
+        // A receiver that was not in the profile
+        for (int i = 0; i < 20_000; i++) {
+            check(five);
+        }
+    }
+
+    static void check(Node[] nodes) {
+        int res = sum(nodes);
+        if (res != expected(nodes)) {
+            throw new RuntimeException(res + " != " + expected(nodes));
+        }
+    }
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Polymorphic inline caches at interface call sites: transition to
+ *          megamorphic, class unloading and class redefinition.
+ * @requires os.arch == "x86_64" | os.arch == "amd64"
+ * @requires vm.compiler1.enabled
+ * @library /test/lib /
+ * @modules java.base/jdk.internal.misc
+ *          java.compiler
+ *          java.instrument
+ *          java.management
+ *
+ * @build sun.hotspot.WhiteBox
+ * @run driver ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main RedefineClassHelper
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UnlockExperimentalVMOptions -XX:PolymorphicInlineCacheSize=4
+ *                   -XX:-BackgroundCompilation -javaagent:redefineagent.jar
+ *                   -XX:CompileCommand=quiet -XX:CompileCommand=dontinline,compiler.calls.*::value
+ *                   -XX:CompileCommand=dontinline,compiler.calls.TestPolymorphicInterfaceIC::call*
+ *                   compiler.calls.TestPolymorphicInterfaceIC
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UnlockExperimentalVMOptions -XX:PolymorphicInlineCacheSize=2
+ *                   -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *                   -XX:-BackgroundCompilation -javaagent:redefineagent.jar
+ *                   -XX:CompileCommand=quiet -XX:CompileCommand=dontinline,compiler.calls.*::value
+ *                   -XX:CompileCommand=dontinline,compiler.calls.TestPolymorphicInterfaceIC::call*
+ *                   compiler.calls.TestPolymorphicInterfaceIC
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:-BackgroundCompilation -javaagent:redefineagent.jar
+ *                   -XX:CompileCommand=quiet -XX:CompileCommand=dontinline,compiler.calls.*::value
+ *                   -XX:CompileCommand=dontinline,compiler.calls.TestPolymorphicInterfaceIC::call*
+ *                   compiler.calls.TestPolymorphicInterfaceIC
+ */
+
+/*
+ * @test
+ * @summary Check the inline cache transitions of an interface call site with
+ *          polymorphic inline caches enabled and disabled.
+ * @requires os.arch == "x86_64" | os.arch == "amd64"
+ * @requires vm.compiler1.enabled & vm.debug
+ * @library /test/lib /
+ * @modules java.base/jdk.internal.misc
+ *          java.compiler
+ *          java.instrument
+ *          java.management
+ *
+ * @build sun.hotspot.WhiteBox
+ * @run driver ClassFileInstaller sun.hotspot.WhiteBox
+ * @run driver compiler.calls.TestPolymorphicInterfaceIC trace
+ */
+
+package compiler.calls;
+
+import compiler.whitebox.CompilerWhiteBoxTest;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+import sun.hotspot.WhiteBox;
+
+import java.io.InputStream;
+import java.lang.ref.WeakReference;
+import java.lang.reflect.Method;
+
+public class TestPolymorphicInterfaceIC {
+
+    public interface I {
+        int value();
+    }
+
+    static class A implements I { public int value() { return 1; } }
+    static class B implements I { public int value() { return 2; } }
+    static class C implements I { public int value() { return 3; } }
+    static class D implements I { public int value() { return 4; } }
+    static class E implements I { public int value() { return 5; } }
+    static class F implements I { public int value() { return 6; } }
+
+    // Loaded by a separate UnloadableLoader each time, so every instance
+    // has a different, unloadable class.
+    public static class Unloadable implements I {
+        public int value() { return 100; }
+    }
+
+    static final String UNLOADABLE = Unloadable.class.getName();
+
+    static class UnloadableLoader extends ClassLoader {
+        UnloadableLoader() {
+            super(TestPolymorphicInterfaceIC.class.getClassLoader());
+        }
+
+        @Override
+        protected Class<?> loadClass(String name, boolean resolve) throws ClassNotFoundException {
+            if (!name.equals(UNLOADABLE)) {
+                return super.loadClass(name, resolve);
+            }
+            synchronized (getClassLoadingLock(name)) {
+                Class<?> c = findLoadedClass(name);
+                if (c == null) {
+                    String resource = name.replace('.', '/') + ".class";
+                    try (InputStream in = getParent().getResourceAsStream(resource)) {
+                        byte[] b = in.readAllBytes();
+                        c = defineClass(name, b, 0, b.length);
+                    } catch (Exception e) {
+                        throw new ClassNotFoundException(name, e);
+                    }
+                }
+                return c;
+            }
+        }
+    }
+
+    private static final WhiteBox WHITE_BOX = WhiteBox.getWhiteBox();
+    private static final int CALLS = 100;
+
+    // One call site per scenario, so that each starts with a clean inline cache.
+    static int callTransitions(I i) { return i.value(); }
+    static int callUnloading(I i)   { return i.value(); }
+    static int callRedefinition(I i) { return i.value(); }
+
+    interface CallSite {
+        int call(I i);
+    }
+
+    static void check(CallSite site, I receiver, int expected) {
+        for (int k = 0; k < CALLS; k++) {
+            int v = site.call(receiver);
+            if (v != expected) {
+                throw new RuntimeException(receiver.getClass().getName() + ".value() returned " + v +
+                                           ", expected " + expected);
+            }
+        }
+    }
+
+    static void compile(String name) throws Exception {
+        Method m = TestPolymorphicInterfaceIC.class.getDeclaredMethod(name, I.class);
+        WHITE_BOX.enqueueMethodForCompilation(m, CompilerWhiteBoxTest.COMP_LEVEL_SIMPLE);
+        if (!WHITE_BOX.isMethodCompiled(m)) {
+            throw new RuntimeException(name + " is not compiled");
+        }
+    }
+
+    static I newUnloadable() throws Exception {
+        Class<?> c = Class.forName(UNLOADABLE, true, new UnloadableLoader());
+        return (I)c.getDeclaredConstructor().newInstance();
+    }
+
+    // Monomorphic, then polymorphic with a growing number of receiver
+    // classes, then megamorphic. Receivers seen before must still dispatch
+    // correctly after each transition.
+    static void testTransitions() throws Exception {
+        I[] receivers = { new A(), new B(), new C(), new D(), new E(), new F() };
+        compile("callTransitions");
+        for (int n = 0; n < receivers.length; n++) {
+            for (int j = 0; j <= n; j++) {
+                check(TestPolymorphicInterfaceIC::callTransitions, receivers[j], j + 1);
+            }
+        }
+    }
+
+    // Cache entries for unloaded classes must not be used or kept alive.
+    static void testUnloading() throws Exception {
+        compile("callUnloading");
+        I a = new A();
+        I u1 = newUnloadable();
+        WeakReference<ClassLoader> loader = new WeakReference<>(u1.getClass().getClassLoader());
+        check(TestPolymorphicInterfaceIC::callUnloading, a, 1);
+        check(TestPolymorphicInterfaceIC::callUnloading, u1, 100);
+        u1 = null;
+
+        WHITE_BOX.fullGC();
+        if (loader.get() != null) {
+            throw new RuntimeException("Unloadable class was not unloaded");
+        }
+
+        // A new class of the same name must not hit the stale entry.
+        I u2 = newUnloadable();
+        check(TestPolymorphicInterfaceIC::callUnloading, u2, 100);
+        check(TestPolymorphicInterfaceIC::callUnloading, a, 1);
+        check(TestPolymorphicInterfaceIC::callUnloading, new B(), 2);
+        check(TestPolymorphicInterfaceIC::callUnloading, new C(), 3);
+        check(TestPolymorphicInterfaceIC::callUnloading, new D(), 4);
+    }
+
+    // Cache entries must dispatch to the new version of a redefined method.
+    static void testRedefinition() throws Exception {
+        compile("callRedefinition");
+        I a = new A();
+        I r = new RedefinedImpl();
+        check(TestPolymorphicInterfaceIC::callRedefinition, a, 1);
+        check(TestPolymorphicInterfaceIC::callRedefinition, r, 7);
+
+        // RedefineClassHelper is in the unnamed package.
+        Class<?> helper = Class.forName("RedefineClassHelper");
+        helper.getMethod("redefineClass", Class.class, String.class).invoke(null, RedefinedImpl.class,
+            "package compiler.calls;" +
+            "class RedefinedImpl implements TestPolymorphicInterfaceIC.I {" +
+            "    public int value() { return 8; }" +
+            "}");
+
+        check(TestPolymorphicInterfaceIC::callRedefinition, r, 8);
+        check(TestPolymorphicInterfaceIC::callRedefinition, a, 1);
+        check(TestPolymorphicInterfaceIC::callRedefinition, new B(), 2);
+        check(TestPolymorphicInterfaceIC::callRedefinition, r, 8);
+    }
+
+    static void checkTrace(int cacheSize) throws Exception {
+        OutputAnalyzer output = ProcessTools.executeTestJvm(
+            "-Xbootclasspath/a:.", "-XX:+UnlockDiagnosticVMOptions", "-XX:+WhiteBoxAPI",
+            "-XX:+UnlockExperimentalVMOptions", "-XX:PolymorphicInlineCacheSize=" + cacheSize,
+            "-XX:-BackgroundCompilation", "-XX:+TraceICs",
+            "-XX:CompileCommand=quiet", "-XX:CompileCommand=dontinline,compiler.calls.*::value",
+            "-XX:CompileCommand=dontinline,compiler.calls.TestPolymorphicInterfaceIC::call*",
+            TestPolymorphicInterfaceIC.class.getName(), "transitions");
+        output.shouldHaveExitValue(0);
+        if (cacheSize >= 2) {
+            for (int n = 2; n <= cacheSize; n++) {
+                output.shouldContain(": to polymorphic (" + n + ")");
+            }
+            output.shouldNotContain(": to polymorphic (" + (cacheSize + 1) + ")");
+        } else {
+            output.shouldNotContain(": to polymorphic");
+        }
+        output.shouldContain(": to megamorphic");
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0 && args[0].equals("trace")) {
+            checkTrace(4);
+            checkTrace(0);
+            return;
+        }
+        testTransitions();
+        if (args.length > 0 && args[0].equals("transitions")) {
+            return;
+        }
+        testUnloading();
+        testRedefinition();
+    }
+}
+
+class RedefinedImpl implements TestPolymorphicInterfaceIC.I {
+    public int value() { return 7; }
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Test field loads from Phis which merge new allocations
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xbatch -XX:CompileCommand=dontinline,*::blackhole
+ *                   compiler.escapeAnalysis.TestLoadsThroughAllocationMerge
+ * @run main/othervm -Xbatch -XX:CompileCommand=dontinline,*::blackhole
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:-SplitLoadsThroughAllocationMerges
+ *                   compiler.escapeAnalysis.TestLoadsThroughAllocationMerge
+ */
+
+package compiler.escapeAnalysis;
+
+public class TestLoadsThroughAllocationMerge {
+    static class Point {
+        final int x;
+        final int y;
+
+        Point(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static class MutablePoint {
+        int x;
+        int y;
+    }
+
+    static final Point ORIGIN = new Point(0, 0);
+
+    static volatile Object sink;
+
+    static void blackhole(Object o) {
+        sink = o;
+    }
+
+    static int mergeTwo(boolean c, int a, int b) {
+        Point p = c ? new Point(a, b) : new Point(b, a);
+        return p.x * 31 + p.y;
+    }
+
+    static int mergeWithConstant(boolean c, int a, int b) {
+        Point p = c ? new Point(a, b) : ORIGIN;
+        return p.x - p.y;
+    }
+
+    static int mergeEscapingOnOnePath(boolean c, int a, int b) {
+        Point p = new Point(a, b);
+        if (c) {
+            blackhole(p);
+        } else {
+            p = new Point(b, a);
+        }
+        return p.x + 2 * p.y;
+    }
+
+    static int mergeStoredAfter(boolean c, int a, int b) {
+        MutablePoint p1 = new MutablePoint();
+        p1.x = a;
+        MutablePoint p2 = new MutablePoint();
+        p2.x = b;
+        MutablePoint p = c ? p1 : p2;
+        p1.x = a + 1;
+        return p.x;
+    }
+
+    static int mergeInLoop(int n, int a) {
+        Point p = new Point(a, a);
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += p.x;
+            p = new Point(p.y + 1, i);
+        }
+        return sum + p.x + p.y;
+    }
+
+    static int mergeInLoopExpected(int n, int a) {
+        int x = a;
+        int y = a;
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += x;
+            x = y + 1;
+            y = i;
+        }
+        return sum + x + y;
+    }
+
+    private static void check(String name, int expected, int actual) {
+        if (expected != actual) {
+            throw new RuntimeException(name + ": expected " + expected + ", got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 50_000; i++) {
+            boolean c = (i % 3) == 0;
+            int a = i;
+            int b = i ^ 0x5a5a;
+
+            check("mergeTwo", c ? a * 31 + b : b * 31 + a, mergeTwo(c, a, b));
+            check("mergeWithConstant", c ? a - b : 0, mergeWithConstant(c, a, b));
+            check("mergeEscapingOnOnePath", c ? a + 2 * b : b + 2 * a, mergeEscapingOnOnePath(c, a, b));
+            check("mergeStoredAfter", c ? a + 1 : b, mergeStoredAfter(c, a, b));
+            check("mergeInLoop", mergeInLoopExpected(i % 17, a), mergeInLoop(i % 17, a));
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Loops with a long induction variable converted to a loop nest compute the same result.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement
+ *                   compiler.loopopts.TestLongCountedLoopNest
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:-UseLongCountedLoops
+ *                   compiler.loopopts.TestLongCountedLoopNest
+ */
+
+package compiler.loopopts;
+
+public class TestLongCountedLoopNest {
+
+    static long countUp(long start, long stop, long[] array) {
+        long res = 0;
+        for (long i = start; i < stop; i++) {
+            res += i;
+            array[(int)(i & (array.length - 1))]++;
+        }
+        return res;
+    }
+
+    static long countUpInclusive(long start, long stop) {
+        long res = 0;
+        for (long i = start; i <= stop; i += 3) {
+            res += i;
+        }
+        return res;
+    }
+
+    static long countDown(long start, long stop) {
+        long res = 0;
+        for (long i = start; i > stop; i -= 2) {
+            res += i;
+        }
+        return res;
+    }
+
+    // Sum of n terms of the arithmetic progression first, first + stride...
+    static long expected(long first, long stride, long n) {
+        long tri = (n % 2 == 0) ? (n / 2) * (n - 1) : n * ((n - 1) / 2);
+        return n * first + stride * tri;
+    }
+
+    static void check(String name, long res, long expected) {
+        if (res != expected) {
+            throw new RuntimeException(name + ": " + res + " != " + expected);
+        }
+    }
+
+    public static void main(String[] args) {
+        long[] array = new long[16];
+        for (int i = 0; i < 20_000; i++) {
+            countUp(0, 100, array);
+            countUpInclusive(0, 100);
+            countDown(100, 0);
+        }
+
+        // More iterations than fit in a single inner loop
+        long start = Integer.MAX_VALUE - 10L;
+        long stop = 3L * Integer.MAX_VALUE + 7;
+        check("countUp", countUp(start, stop, array), expected(start, 1, stop - start));
+        check("countUpInclusive", countUpInclusive(start, stop), expected(start, 3, (stop - start) / 3 + 1));
+        check("countDown", countDown(stop, start), expected(stop, -2, (stop - start + 1) / 2));
+
+        // Limits at the edges of the long range
+        check("countUpInclusive near max", countUpInclusive(Long.MAX_VALUE - 10, Long.MAX_VALUE - 3),
+              expected(Long.MAX_VALUE - 10, 3, 3));
+        check("countUp near min", countUp(Long.MIN_VALUE, Long.MIN_VALUE + 5, array),
+              expected(Long.MIN_VALUE, 1, 5));
+        check("countDown near min", countDown(Long.MIN_VALUE + 5, Long.MIN_VALUE),
+              expected(Long.MIN_VALUE + 5, -2, 3));
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Loop unswitching folds every test of the unswitched invariant condition.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement
+ *                   compiler.loopopts.TestUnswitchSameCondition
+ */
+
+package compiler.loopopts;
+
+public class TestUnswitchSameCondition {
+
+    static int test(int[] array, boolean flag1, boolean flag2) {
+        int res = 0;
+        for (int i = 0; i < array.length; i++) {
+            int v = array[i];
+            if (flag1) {
+                v += 1;
+            }
+            if (flag2) {
+                v *= 3;
+            }
+            if ((v & 1) == 0) {
+                if (flag1) {
+                    v -= 7;
+                }
+            } else if (!flag1) {
+                v ^= 5;
+            }
+            res += v;
+        }
+        return res;
+    }
+
+    static int expected(int[] array, boolean flag1, boolean flag2) {
+        int res = 0;
+        for (int v : array) {
+            if (flag1) v += 1;
+            if (flag2) v *= 3;
+            if ((v & 1) == 0) {
+                if (flag1) v -= 7;
+            } else if (!flag1) {
+                v ^= 5;
+            }
+            res += v;
+        }
+        return res;
+    }
+
+    public static void main(String[] args) {
+        int[] array = new int[100];
+        for (int i = 0; i < array.length; i++) {
+            array[i] = i * 31;
+        }
+        int[] exp = new int[4];
+        for (int f = 0; f < 4; f++) {
+            exp[f] = expected(array, (f & 1) != 0, (f & 2) != 0);
+        }
+        for (int i = 0; i < 20_000; i++) {
+            for (int f = 0; f < 4; f++) {
+                int res = test(array, (f & 1) != 0, (f & 2) != 0);
+                if (res != exp[f]) {
+                    throw new RuntimeException("wrong result " + res + " != " + exp[f] + " for flags " + f);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Test vectorization of int min/max loops, including loops where
+ *          the min/max is written as a conditional
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xbatch -XX:CompileCommand=compileonly,compiler.loopopts.superword.TestMinMaxIntReduction::*
+ *                   compiler.loopopts.superword.TestMinMaxIntReduction
+ * @run main/othervm -Xbatch -XX:CompileCommand=compileonly,compiler.loopopts.superword.TestMinMaxIntReduction::*
+ *                   -XX:-UseSuperWord
+ *                   compiler.loopopts.superword.TestMinMaxIntReduction
+ */
+
+package compiler.loopopts.superword;
+
+import java.util.Random;
+
+public class TestMinMaxIntReduction {
+    private static final int SIZE = 1021;
+    private static final int ITERATIONS = 20_000;
+
+    private static final int MIN = -5000;
+    private static final int MAX = 5000;
+
+    static int minIntrinsic(int[] a) {
+        int m = Integer.MAX_VALUE;
+        for (int i = 0; i < a.length; i++) {
+            m = Math.min(m, a[i]);
+        }
+        return m;
+    }
+
+    static int maxIntrinsic(int[] a) {
+        int m = Integer.MIN_VALUE;
+        for (int i = 0; i < a.length; i++) {
+            m = Math.max(m, a[i]);
+        }
+        return m;
+    }
+
+    static int minConditional(int[] a) {
+        int m = Integer.MAX_VALUE;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] < m) {
+                m = a[i];
+            }
+        }
+        return m;
+    }
+
+    static int maxConditional(int[] a) {
+        int m = Integer.MIN_VALUE;
+        for (int i = 0; i < a.length; i++) {
+            m = (a[i] > m) ? a[i] : m;
+        }
+        return m;
+    }
+
+    static void clamp(int[] a, int[] r, int lo, int hi) {
+        for (int i = 0; i < a.length; i++) {
+            int v = a[i];
+            v = (v < lo) ? lo : v;
+            v = (v > hi) ? hi : v;
+            r[i] = v;
+        }
+    }
+
+    private static void check(String name, int expected, int actual) {
+        if (expected != actual) {
+            throw new RuntimeException(name + ": expected " + expected + ", got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        Random random = new Random(42);
+        int[] a = new int[SIZE];
+        int[] r = new int[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            a[i] = random.nextInt(2001) - 1000;
+        }
+
+        for (int iter = 0; iter < ITERATIONS; iter++) {
+            // Plant the extremes at varying positions so that they land in
+            // the pre-, main- and post-loops.
+            int min_index = iter % SIZE;
+            int max_index = (iter * 7 + 3) % SIZE;
+            if (max_index == min_index) {
+                max_index = (max_index + 1) % SIZE;
+            }
+            int saved_min = a[min_index];
+            a[min_index] = MIN;
+            int saved_max = a[max_index];
+            a[max_index] = MAX;
+
+            check("minIntrinsic", MIN, minIntrinsic(a));
+            check("maxIntrinsic", MAX, maxIntrinsic(a));
+            check("minConditional", MIN, minConditional(a));
+            check("maxConditional", MAX, maxConditional(a));
+
+            clamp(a, r, -100, 100);
+            for (int i = 0; i < SIZE; i++) {
+                check("clamp", Math.max(-100, Math.min(100, a[i])), r[i]);
+            }
+
+            a[min_index] = saved_min;
+            a[max_index] = saved_max;
+        }
+    }
+}
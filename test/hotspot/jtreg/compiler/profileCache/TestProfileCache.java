@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Dump a profile cache at exit and load it in a second run.
+ * @requires vm.compiler1.enabled | vm.compiler2.enabled
+ * @library /test/lib
+ * @run driver compiler.profileCache.TestProfileCache
+ */
+
+package compiler.profileCache;
+
+import java.io.File;
+import java.nio.file.Files;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestProfileCache {
+
+    public static class Hot {
+        static int sum;
+
+        static void hot(int i) {
+            sum += i;
+        }
+
+        public static void main(String[] args) {
+            for (int i = 0; i < 100_000; i++) {
+                hot(i);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        String cache = new File("profile.cache").getAbsolutePath();
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:DumpProfileCacheFile=" + cache,
+            "-Xlog:jit+compilation=info",
+            Hot.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Profile cache: dumped");
+
+        String contents = new String(Files.readAllBytes(new File(cache).toPath()));
+        if (!contents.startsWith("# HotSpot profile cache") ||
+            !contents.contains("class compiler/profileCache/TestProfileCache$Hot ") ||
+            !contents.contains("method hot (I)V ")) {
+            throw new RuntimeException("Unexpected profile cache contents:\n" + contents);
+        }
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:ProfileCacheFile=" + cache,
+            "-Xlog:jit+compilation=info",
+            Hot.class.getName());
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Profile cache: loaded");
+        output.shouldNotContain("Profile cache: ignoring compiler/profileCache/TestProfileCache$Hot");
+    }
+}
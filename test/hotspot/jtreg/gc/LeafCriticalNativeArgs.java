@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+package gc;
+
+/*
+ * @test LeafCriticalNativeArgsSerial
+ * @library /
+ * @requires os.arch == "x86_64" | os.arch == "amd64"
+ * @requires vm.gc.Serial
+ * @summary test critical natives called as leaves without pinning
+ * @run main/othervm/native -XX:+UseSerialGC -Xcomp -Xmx64M -XX:+CriticalJNINatives -XX:+UnlockExperimentalVMOptions -XX:+LeafCriticalJNINatives gc.LeafCriticalNativeArgs
+ */
+
+/*
+ * @test LeafCriticalNativeArgsParallel
+ * @library /
+ * @requires os.arch == "x86_64" | os.arch == "amd64"
+ * @requires vm.gc.Parallel
+ * @summary test critical natives called as leaves without pinning
+ * @run main/othervm/native -XX:+UseParallelGC -Xcomp -Xmx64M -XX:+CriticalJNINatives -XX:+UnlockExperimentalVMOptions -XX:+LeafCriticalJNINatives gc.LeafCriticalNativeArgs
+ */
+
+/*
+ * @test LeafCriticalNativeArgsEpsilon
+ * @library /
+ * @requires os.arch == "x86_64" | os.arch == "amd64"
+ * @requires vm.gc.Epsilon
+ * @summary test critical natives called as leaves with Epsilon, which does not pin objects
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC -Xcomp -Xmx256M -XX:+CriticalJNINatives -XX:+LeafCriticalJNINatives gc.LeafCriticalNativeArgs
+ */
+
+/*
+ * @test LeafCriticalNativeArgsG1
+ * @library /
+ * @requires os.arch == "x86_64" | os.arch == "amd64"
+ * @requires vm.gc.G1
+ * @summary test that G1, which pins objects, ignores LeafCriticalJNINatives
+ * @run main/othervm/native -XX:+UseG1GC -Xcomp -Xmx64M -XX:+CriticalJNINatives -XX:+UnlockExperimentalVMOptions -XX:+LeafCriticalJNINatives gc.LeafCriticalNativeArgs
+ */
+public class LeafCriticalNativeArgs {
+    static final int ITERATIONS = 10_000;
+
+    // Keeps some garbage reachable for a while so that the collectors
+    // that support it run collections between the calls.
+    static Object[] sink = new Object[64];
+
+    public static void main(String[] args) {
+        int[] arr = new int[2];
+
+        if (CriticalNative.isNull(arr)) {
+            throw new RuntimeException("Should not be null");
+        }
+
+        if (!CriticalNative.isNull(null)) {
+            throw new RuntimeException("Should be null");
+        }
+
+        long[] a1 = new long[16];
+        int[] a2 = new int[16];
+        int[] a3 = new int[16];
+        long[] a4 = new long[16];
+        int[] a5 = new int[16];
+        for (int i = 0; i < 16; i++) {
+            a1[i] = i;
+            a2[i] = i;
+            a3[i] = 2 * i;
+            a4[i] = 3 * i;
+            a5[i] = 4 * i;
+        }
+        long expected1 = 120;
+        long expected2 = 7 + 120 * (1 + 2 + 3 + 4);
+
+        for (int i = 0; i < ITERATIONS; i++) {
+            sink[i % sink.length] = new byte[1024];
+            long sum1 = CriticalNative.sum1(a1);
+            if (sum1 != expected1) {
+                throw new RuntimeException("sum1: expected " + expected1 + ", got " + sum1);
+            }
+            long sum2 = CriticalNative.sum2(7, a2, a3, a4, a5);
+            if (sum2 != expected2) {
+                throw new RuntimeException("sum2: expected " + expected2 + ", got " + sum2);
+            }
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc;
+
+/*
+ * @test TestSerialFullGCParallelPhases
+ * @requires vm.gc.Serial
+ * @summary Run Serial full GCs with parallel marking and pointer adjustment.
+ * @run main/othervm -XX:+UseSerialGC -XX:+UnlockExperimentalVMOptions -XX:+SerialFullGCParallelPhases
+ *                   -XX:ParallelGCThreads=4 -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *                   -Xmx128m gc.TestSerialFullGCParallelPhases
+ * @run main/othervm -XX:+UseSerialGC -XX:+UnlockExperimentalVMOptions -XX:+SerialFullGCParallelPhases
+ *                   -XX:ParallelGCThreads=1 -Xmx128m gc.TestSerialFullGCParallelPhases
+ */
+
+import java.lang.ref.WeakReference;
+
+public class TestSerialFullGCParallelPhases {
+    static class Node {
+        final int value;
+        Node next;
+        Object[] payload;
+
+        Node(int value, Node next) {
+            this.value = value;
+            this.next = next;
+            this.payload = new Object[value % 16];
+            for (int i = 0; i < payload.length; i++) {
+                payload[i] = Integer.valueOf(value + i);
+            }
+        }
+    }
+
+    static final int NODES = 100_000;
+
+    public static void main(String[] args) throws Exception {
+        Node head = null;
+        int[] hashes = new int[NODES / 100];
+        for (int i = 0; i < NODES; i++) {
+            head = new Node(i, head);
+            if (i % 100 == 0) {
+                // Hashed objects have marks that must be preserved.
+                hashes[i / 100] = System.identityHashCode(head);
+            }
+            // Interleave garbage with the live objects.
+            new Node(i, null);
+        }
+        Object[] bigArray = new Object[1_000_000];
+        for (int i = 0; i < bigArray.length; i += 7) {
+            bigArray[i] = new int[] { i };
+        }
+        WeakReference<Object> weak = new WeakReference<>(new Object());
+
+        for (int gc = 0; gc < 3; gc++) {
+            System.gc();
+
+            int expected = NODES - 1;
+            for (Node n = head; n != null; n = n.next, expected--) {
+                if (n.value != expected || n.payload.length != expected % 16) {
+                    throw new RuntimeException("Corrupted node " + n.value + ", expected " + expected);
+                }
+                for (int i = 0; i < n.payload.length; i++) {
+                    if (((Integer)n.payload[i]).intValue() != expected + i) {
+                        throw new RuntimeException("Corrupted payload of node " + expected);
+                    }
+                }
+                if (expected % 100 == 0 && System.identityHashCode(n) != hashes[expected / 100]) {
+                    throw new RuntimeException("Identity hash code of node " + expected + " changed");
+                }
+            }
+            for (int i = 0; i < bigArray.length; i += 7) {
+                if (((int[])bigArray[i])[0] != i) {
+                    throw new RuntimeException("Corrupted array element " + i);
+                }
+            }
+        }
+        if (weak.get() != null) {
+            throw new RuntimeException("Weak reference not cleared");
+        }
+    }
+}
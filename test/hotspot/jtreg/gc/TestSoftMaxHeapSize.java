@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc;
+
+/*
+ * @test TestSoftMaxHeapSizeG1
+ * @requires vm.gc.G1
+ * @summary Verify that the heap shrinks towards SoftMaxHeapSize and that it can be changed at runtime.
+ * @modules jdk.management
+ * @run main/othervm -XX:+UseG1GC -Xms16m -Xmx256m -XX:SoftMaxHeapSize=96m gc.TestSoftMaxHeapSize
+ */
+
+/*
+ * @test TestSoftMaxHeapSizeParallel
+ * @requires vm.gc.Parallel
+ * @summary Verify that the heap shrinks towards SoftMaxHeapSize and that it can be changed at runtime.
+ * @modules jdk.management
+ * @run main/othervm -XX:+UseParallelGC -Xms16m -Xmx256m -XX:SoftMaxHeapSize=96m gc.TestSoftMaxHeapSize
+ */
+
+import java.lang.management.ManagementFactory;
+import java.util.ArrayList;
+
+import com.sun.management.HotSpotDiagnosticMXBean;
+
+public class TestSoftMaxHeapSize {
+    private static final long M = 1024 * 1024;
+    // Allow for rounding to region and generation alignment.
+    private static final long SLACK = 16 * M;
+
+    private static volatile Object sink;
+
+    private static void allocate() {
+        // Grow the heap beyond the soft limit with live data, then drop it.
+        ArrayList<byte[]> live = new ArrayList<>();
+        for (int i = 0; i < 160; i++) {
+            live.add(new byte[(int)M]);
+        }
+        sink = live;
+        sink = null;
+        live = null;
+        for (int i = 0; i < 1024; i++) {
+            sink = new byte[64 * 1024];
+        }
+    }
+
+    private static void check(long softMax) {
+        System.gc();
+        long committed = Runtime.getRuntime().totalMemory();
+        System.out.println("SoftMaxHeapSize: " + softMax + " committed: " + committed);
+        if (committed > softMax + SLACK) {
+            throw new RuntimeException("Committed heap " + committed + " exceeds SoftMaxHeapSize " + softMax);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        allocate();
+        check(96 * M);
+
+        HotSpotDiagnosticMXBean diag = ManagementFactory.getPlatformMXBean(HotSpotDiagnosticMXBean.class);
+        diag.setVMOption("SoftMaxHeapSize", Long.toString(48 * M));
+
+        allocate();
+        check(48 * M);
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc;
+
+/*
+ * @test TestTLABLargeAllocatorSizing
+ * @requires vm.gc.Serial
+ * @summary Check that a thread allocating most of eden between GCs is classified as large allocator.
+ * @library /test/lib /
+ * @modules java.base/jdk.internal.misc
+ *          java.management/sun.management
+ *          jdk.internal.jvmstat/sun.jvmstat.monitor
+ * @run driver gc.TestTLABLargeAllocatorSizing
+ */
+
+import gc.testlibrary.PerfCounters;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestTLABLargeAllocatorSizing {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseSerialGC",
+            "-Xmx64m",
+            "-Xmn16m",
+            "-XX:+UsePerfData",
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:+TLABLargeAllocatorSizing",
+            "-Xlog:gc+tlab=debug",
+            Allocator.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("TLAB: thread: .* became large allocator");
+        output.shouldMatch("TLAB totals: thrds: \\d+ large: [1-9]");
+    }
+
+    static class Allocator {
+        static Object sink;
+
+        public static void main(String[] args) throws Exception {
+            // Allocate enough to go through many young GCs, all from this thread.
+            for (int i = 0; i < 2_000_000; i++) {
+                sink = new byte[128];
+            }
+            if (PerfCounters.findByName("sun.gc.tlab.largeAllocThreads").longValue() < 1) {
+                throw new RuntimeException("Unexpected large allocating thread count");
+            }
+        }
+    }
+}
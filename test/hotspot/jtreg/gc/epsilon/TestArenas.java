@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.epsilon;
+
+/**
+ * @test TestArenas
+ * @requires vm.gc.Epsilon
+ * @summary Epsilon releases arenas in bulk through GC.epsilon_arena
+ * @library /test/lib
+ * @run driver gc.epsilon.TestArenas
+ */
+
+import java.io.BufferedReader;
+import java.io.InputStreamReader;
+import java.io.PrintStream;
+
+import jdk.test.lib.JDKToolLauncher;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestArenas {
+    // Each cycle allocates half of the heap, so that the worker only survives
+    // all cycles if arenas are actually released.
+    static final int CYCLES = 10;
+    static final int ALLOCATION_MB = 32;
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:+UseEpsilonGC",
+            "-XX:+EpsilonArenas",
+            "-Xmx64m",
+            Worker.class.getName());
+        Process p = pb.start();
+        BufferedReader out = new BufferedReader(new InputStreamReader(p.getInputStream()));
+        PrintStream in = new PrintStream(p.getOutputStream(), true);
+
+        expectLine(out, "ready");
+        for (int i = 0; i < CYCLES; i++) {
+            arena(p.pid(), "begin").shouldContain("Arena 1 started.");
+            in.println("allocate");
+            expectLine(out, "allocated");
+            arena(p.pid(), "release").shouldContain("Arena released");
+        }
+
+        // An arena that is still referenced from a static field is kept.
+        arena(p.pid(), "begin").shouldContain("Arena 1 started.");
+        in.println("keep");
+        expectLine(out, "kept");
+        arena(p.pid(), "release").shouldContain("Arena not released");
+        in.println("drop");
+        expectLine(out, "dropped");
+        arena(p.pid(), "release").shouldContain("Arena released");
+
+        arena(p.pid(), "release").shouldContain("No active arena.");
+        arena(p.pid(), "reset").shouldContain("Unknown action");
+
+        in.println("exit");
+        int exitValue = p.waitFor();
+        if (exitValue != 0) {
+            throw new RuntimeException("Worker failed with exit value " + exitValue);
+        }
+    }
+
+    static OutputAnalyzer arena(long pid, String action) throws Exception {
+        JDKToolLauncher launcher = JDKToolLauncher.createUsingTestJDK("jcmd");
+        launcher.addToolArg(Long.toString(pid));
+        launcher.addToolArg("GC.epsilon_arena");
+        launcher.addToolArg(action);
+        OutputAnalyzer output = ProcessTools.executeProcess(launcher.getCommand());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    static void expectLine(BufferedReader reader, String expected) throws Exception {
+        String line = reader.readLine();
+        if (!expected.equals(line)) {
+            throw new RuntimeException("Expected \"" + expected + "\" from worker, got \"" + line + "\"");
+        }
+    }
+
+    static class Worker {
+        static byte[] sink;
+
+        // Strings resolved while an arena is active would live in the arena
+        // and keep it from being released, resolve them all up front.
+        static final String[] COMMANDS = { "allocate", "allocated", "keep", "kept", "drop", "dropped", "exit" };
+
+        public static void main(String[] args) throws Exception {
+            BufferedReader reader = new BufferedReader(new InputStreamReader(System.in));
+            System.out.println("ready");
+            String command;
+            while ((command = reader.readLine()) != null) {
+                boolean exit = command.equals("exit");
+                if (command.equals("allocate")) {
+                    for (int i = 0; i < ALLOCATION_MB * 1024; i++) {
+                        sink = new byte[1024];
+                    }
+                    // Drop the last reference into the arena before it is released.
+                    sink = null;
+                    command = null;
+                    System.out.println("allocated");
+                } else if (command.equals("keep")) {
+                    sink = new byte[1024];
+                    command = null;
+                    System.out.println("kept");
+                } else if (command.equals("drop")) {
+                    sink = null;
+                    command = null;
+                    System.out.println("dropped");
+                }
+                if (exit) {
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/**
+ * @test TestConcurrentUncommit
+ * @requires vm.gc.G1
+ * @summary Verify that G1 uncommits excess free regions outside of a pause
+ * @library /test/lib /
+ * @modules java.base/jdk.internal.misc
+ * @modules java.management/sun.management
+ * @run driver gc.g1.TestConcurrentUncommit
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestConcurrentUncommit {
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-XX:+UseG1GC",
+                                                                  "-XX:+UnlockExperimentalVMOptions",
+                                                                  "-XX:-G1ConcurrentUncommit",
+                                                                  "-Xlog:gc+ergo+heap=debug",
+                                                                  "-Xms128M",
+                                                                  "-XX:MinHeapSize=8M",
+                                                                  "-Xmx128M",
+                                                                  IdleTest.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldNotContain("Concurrent uncommit");
+        output.shouldHaveExitValue(0);
+
+        pb = ProcessTools.createJavaProcessBuilder("-XX:+UseG1GC",
+                                                   "-XX:+UnlockExperimentalVMOptions",
+                                                   "-XX:+G1ConcurrentUncommit",
+                                                   "-XX:G1UncommitDelay=0",
+                                                   "-XX:G1UncommitChunkSize=8M",
+                                                   "-XX:MaxHeapFreeRatio=10",
+                                                   "-Xlog:gc+ergo+heap=debug",
+                                                   "-Xms128M",
+                                                   "-XX:MinHeapSize=8M",
+                                                   "-Xmx128M",
+                                                   IdleTest.class.getName());
+
+        output = new OutputAnalyzer(pb.start());
+        output.shouldMatch("Concurrent uncommit. requested: \\d+ regions uncommitted: [1-9]\\d* regions");
+        output.shouldHaveExitValue(0);
+    }
+
+    static class IdleTest {
+        public static void main(String [] args) throws Exception {
+            System.out.println("Waiting for uncommit...");
+            Thread.sleep(3000);
+            System.out.println("Done");
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check that -XX:PreloadClassListFile loads the listed classes and ignores bad entries.
+ * @library /test/lib
+ * @run driver PreloadClassListTest
+ */
+
+import java.io.File;
+import java.io.PrintWriter;
+
+import jdk.test.lib.process.ProcessTools;
+import jdk.test.lib.process.OutputAnalyzer;
+
+public class PreloadClassListTest {
+
+    static class Hello {
+        public static void main(String[] args) {
+            System.out.println("Hello");
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        File classList = new File("preload.classlist");
+        try (PrintWriter out = new PrintWriter(classList)) {
+            out.println("# comment");
+            out.println("java/util/concurrent/ConcurrentSkipListMap id: 1");
+            out.println("PreloadClassListTest$Hello");
+            out.println("does/not/Exist");
+            out.println("@lambda-proxy java/lang/Object run ()Ljava/lang/Runnable;");
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(true,
+            "-XX:PreloadClassListFile=" + classList.getPath(),
+            "-XX:PreloadClassThreads=2",
+            "-Xlog:class+load=info",
+            Hello.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Preloading 3 classes from");
+        output.shouldContain("java.util.concurrent.ConcurrentSkipListMap");
+        output.shouldContain("Hello");
+
+        // A missing class list only produces a warning.
+        pb = ProcessTools.createJavaProcessBuilder(true,
+            "-XX:PreloadClassListFile=does-not-exist.classlist",
+            Hello.class.getName());
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Cannot read PreloadClassListFile");
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check that fields listed in -XX:HotFieldsFile are laid out before the other fields.
+ * @modules java.base/jdk.internal.misc
+ * @library /test/lib
+ * @run driver HotFieldsFileTest
+ */
+
+import java.io.File;
+import java.io.PrintWriter;
+import java.lang.reflect.Field;
+
+import jdk.internal.misc.Unsafe;
+import jdk.test.lib.process.ProcessTools;
+import jdk.test.lib.process.OutputAnalyzer;
+
+public class HotFieldsFileTest {
+
+    static class Entity {
+        long cold1;
+        long cold2;
+        double cold3;
+        Object cold4;
+        Object cold5;
+        int cold6;
+        Object hotRef;
+        int hotInt;
+    }
+
+    static class CheckLayout {
+        public static void main(String[] args) throws Exception {
+            Unsafe unsafe = Unsafe.getUnsafe();
+            long maxHot = Math.max(unsafe.objectFieldOffset(Entity.class.getDeclaredField("hotRef")),
+                                   unsafe.objectFieldOffset(Entity.class.getDeclaredField("hotInt")));
+            for (Field f : Entity.class.getDeclaredFields()) {
+                if (f.getName().startsWith("cold") && unsafe.objectFieldOffset(f) < maxHot) {
+                    throw new RuntimeException("Cold field " + f.getName() + " laid out before hot fields");
+                }
+            }
+            System.out.println("Layout OK");
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        File hotFields = new File("hot.fields");
+        try (PrintWriter out = new PrintWriter(hotFields)) {
+            out.println("# class field count");
+            out.println("HotFieldsFileTest$Entity hotRef 1000");
+            out.println("HotFieldsFileTest$Entity hotInt");
+            out.println("does.not.Exist someField");
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(true,
+            "--add-exports", "java.base/jdk.internal.misc=ALL-UNNAMED",
+            "-XX:HotFieldsFile=" + hotFields.getPath(),
+            "-Xlog:class=info",
+            CheckLayout.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Read 3 hot fields from");
+        output.shouldContain("Layout OK");
+
+        // A missing file only produces a warning.
+        pb = ProcessTools.createJavaProcessBuilder(true,
+            "-XX:HotFieldsFile=does-not-exist.fields",
+            "-version");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Cannot read HotFieldsFile");
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test id=x86_64
+ * @summary Check uncontended, nested, recursive and contended locking, hash codes
+ *          and wait/notify with lightweight locking.
+ * @requires os.arch == "amd64" | os.arch == "x86_64"
+ * @requires !vm.graal.enabled
+ * @run main/othervm -Xint -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking LightweightLockingTest
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=1 -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking LightweightLockingTest
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking LightweightLockingTest
+ */
+
+/*
+ * @test id=fallback
+ * @summary Check that platforms without lightweight locking ignore the flag
+ *          and keep locking correctly.
+ * @requires os.arch != "amd64" & os.arch != "x86_64"
+ * @run main/othervm -Xint -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking LightweightLockingTest
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking LightweightLockingTest
+ */
+
+public class LightweightLockingTest {
+    static final int ITERATIONS = 20_000;
+
+    static int counter;
+
+    static synchronized void syncStatic() {
+        counter++;
+    }
+
+    static void uncontended(Object o) {
+        synchronized (o) {
+            counter++;
+        }
+    }
+
+    static void recursive(Object o, int depth) {
+        synchronized (o) {
+            if (depth > 0) {
+                recursive(o, depth - 1);
+            }
+            counter++;
+        }
+    }
+
+    // Deeper than the lock stack, so the innermost locks are inflated.
+    static void nested(Object[] locks, int i) {
+        synchronized (locks[i]) {
+            if (i + 1 < locks.length) {
+                nested(locks, i + 1);
+            } else {
+                for (Object o : locks) {
+                    check(Thread.holdsLock(o), "must hold all nested locks");
+                }
+            }
+        }
+    }
+
+    // Locks the same two objects in opposite orders across calls.
+    static void twoLocks(Object a, Object b) {
+        synchronized (a) {
+            synchronized (b) {
+                counter++;
+            }
+        }
+    }
+
+    static int hashWhileLocked(Object o) {
+        synchronized (o) {
+            return System.identityHashCode(o);
+        }
+    }
+
+    static void check(boolean condition, String msg) {
+        if (!condition) {
+            throw new RuntimeException(msg);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Object lock = new Object();
+        Object[] locks = new Object[12];
+        for (int i = 0; i < locks.length; i++) {
+            locks[i] = new Object();
+        }
+
+        for (int i = 0; i < ITERATIONS; i++) {
+            syncStatic();
+            uncontended(lock);
+            recursive(lock, 3);
+            nested(locks, 0);
+            twoLocks(locks[i & 1], locks[(i + 1) & 1]);
+        }
+        check(counter == ITERATIONS * 7, "lost updates: " + counter);
+        check(!Thread.holdsLock(lock), "lock must be released");
+
+        // The identity hash stays in the header while an object is fast-locked.
+        Object hashed = new Object();
+        int hash = hashWhileLocked(hashed);
+        check(hash == System.identityHashCode(hashed), "hash changed after unlock");
+        for (int i = 0; i < ITERATIONS; i++) {
+            check(hashWhileLocked(hashed) == hash, "hash changed while locked");
+        }
+
+        // Contended locking inflates a fast-locked object owned by another thread.
+        final int threads = 4;
+        final Object shared = new Object();
+        int[] sum = new int[1];
+        Thread[] workers = new Thread[threads];
+        for (int t = 0; t < threads; t++) {
+            workers[t] = new Thread(() -> {
+                for (int i = 0; i < ITERATIONS; i++) {
+                    synchronized (shared) {
+                        sum[0]++;
+                    }
+                }
+            });
+            workers[t].start();
+        }
+        for (Thread w : workers) {
+            w.join();
+        }
+        check(sum[0] == threads * ITERATIONS, "lost contended updates: " + sum[0]);
+
+        // wait/notify on an object that was fast-locked first.
+        final Object monitor = new Object();
+        boolean[] ready = new boolean[1];
+        Thread waiter = new Thread(() -> {
+            synchronized (monitor) {
+                while (!ready[0]) {
+                    try {
+                        monitor.wait();
+                    } catch (InterruptedException e) {
+                        throw new RuntimeException(e);
+                    }
+                }
+            }
+        });
+        waiter.start();
+        synchronized (monitor) {
+            ready[0] = true;
+            monitor.notifyAll();
+        }
+        waiter.join();
+    }
+}
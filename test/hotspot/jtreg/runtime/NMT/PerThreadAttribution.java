@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test id=enabled
+ * @summary Check the per-thread report of jcmd VM.native_memory attribution.
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run main/othervm -XX:NativeMemoryTracking=summary -XX:+NativeMemoryTrackingPerThread PerThreadAttribution true
+ */
+
+/*
+ * @test id=disabled
+ * @summary Check that jcmd VM.native_memory attribution reports per-thread tracking as disabled by default.
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run main/othervm -XX:NativeMemoryTracking=summary PerThreadAttribution false
+ */
+
+import java.util.concurrent.CountDownLatch;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.internal.misc.Unsafe;
+import jdk.test.lib.JDKToolFinder;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class PerThreadAttribution {
+    static final String THREAD_NAME = "NMTAttributionThread";
+    static final int CHUNK_SIZE = 1024 * 1024;
+    static final int CHUNKS = 8;
+
+    static final Unsafe UNSAFE = Unsafe.getUnsafe();
+
+    public static void main(String[] args) throws Exception {
+        boolean enabled = Boolean.parseBoolean(args[0]);
+
+        CountDownLatch allocated = new CountDownLatch(1);
+        CountDownLatch done = new CountDownLatch(1);
+        Thread allocator = new Thread(() -> {
+            long[] addrs = new long[CHUNKS];
+            for (int i = 0; i < CHUNKS; i++) {
+                addrs[i] = UNSAFE.allocateMemory(CHUNK_SIZE);
+            }
+            // Free half of it so that the thread also shows frees.
+            for (int i = 0; i < CHUNKS / 2; i++) {
+                UNSAFE.freeMemory(addrs[i]);
+            }
+            allocated.countDown();
+            try {
+                done.await();
+            } catch (InterruptedException e) {
+                throw new RuntimeException(e);
+            }
+            for (int i = CHUNKS / 2; i < CHUNKS; i++) {
+                UNSAFE.freeMemory(addrs[i]);
+            }
+        }, THREAD_NAME);
+        allocator.start();
+        allocated.await();
+
+        OutputAnalyzer output;
+        try {
+            String pid = Long.toString(ProcessTools.getProcessId());
+            ProcessBuilder pb = new ProcessBuilder();
+            pb.command(new String[] { JDKToolFinder.getJDKTool("jcmd"), pid,
+                                      "VM.native_memory", "attribution", "scale=KB" });
+            output = new OutputAnalyzer(pb.start());
+        } finally {
+            done.countDown();
+            allocator.join();
+        }
+
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Native Memory Attribution:");
+        output.shouldContain("Metaspace by class loader:");
+        output.shouldMatch("'app'.*\\(metaspace: used=\\d+KB, committed=\\d+KB\\)");
+
+        if (!enabled) {
+            output.shouldContain("Per-thread tracking is not enabled, use -XX:+NativeMemoryTrackingPerThread");
+            output.shouldNotContain(THREAD_NAME);
+            return;
+        }
+
+        output.shouldContain("Malloc by thread:");
+        output.shouldMatch("<exited threads>\\s+\\(malloc=\\d+KB, free=\\d+KB\\)");
+        output.shouldMatch("\"?VM Thread\"?\\s+\\(malloc=\\d+KB, free=\\d+KB\\)");
+
+        Pattern p = Pattern.compile(THREAD_NAME + "\\s+\\(malloc=(\\d+)KB, free=(\\d+)KB\\)");
+        Matcher m = p.matcher(output.getStdout());
+        if (!m.find()) {
+            throw new RuntimeException("No attribution line for " + THREAD_NAME);
+        }
+        long malloced = Long.parseLong(m.group(1));
+        long freed = Long.parseLong(m.group(2));
+        long chunkKB = CHUNK_SIZE / 1024;
+        if (malloced < CHUNKS * chunkKB) {
+            throw new RuntimeException(THREAD_NAME + " malloc'ed " + malloced + "KB, expected at least " +
+                                       (CHUNKS * chunkKB) + "KB");
+        }
+        if (freed < (CHUNKS / 2) * chunkKB) {
+            throw new RuntimeException(THREAD_NAME + " freed " + freed + "KB, expected at least " +
+                                       ((CHUNKS / 2) * chunkKB) + "KB");
+        }
+        if (freed >= CHUNKS * chunkKB) {
+            throw new RuntimeException(THREAD_NAME + " freed " + freed + "KB before freeing all chunks");
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check the perf map and jitdump files written by -XX:+WritePerfMap and -XX:+WriteJitDump.
+ * @requires os.family == "linux"
+ * @library /test/lib
+ * @run driver PerfMapTest
+ */
+
+import java.io.File;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.file.Files;
+import java.util.List;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.process.ProcessTools;
+import jdk.test.lib.process.OutputAnalyzer;
+
+public class PerfMapTest {
+
+    static final Pattern LINE = Pattern.compile("0x[0-9a-f]+ 0x[0-9a-f]+ \\S.*");
+
+    public static class Child {
+        public static void main(String[] args) {
+            System.out.println("PID=" + ProcessHandle.current().pid());
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+WritePerfMap", "-XX:+WriteJitDump", "-Xcomp",
+            "-XX:CompileOnly=PerfMapTest$Child::main",
+            Child.class.getName());
+        OutputAnalyzer out = new OutputAnalyzer(pb.start());
+        out.shouldHaveExitValue(0);
+        String pid = out.firstMatch("PID=(\\d+)", 1);
+
+        File map = new File("/tmp/perf-" + pid + ".map");
+        File dump = new File("/tmp/jit-" + pid + ".dump");
+        try {
+            checkMap(Files.readAllLines(map.toPath()));
+            checkDump(ByteBuffer.wrap(Files.readAllBytes(dump.toPath())).order(ByteOrder.nativeOrder()));
+        } finally {
+            map.delete();
+            dump.delete();
+        }
+    }
+
+    static void checkMap(List<String> lines) {
+        boolean interpreter = false, stub = false, nmethod = false;
+        for (String line : lines) {
+            if (!LINE.matcher(line).matches()) {
+                throw new RuntimeException("Malformed line: " + line);
+            }
+            interpreter |= line.contains(" Interpreter: ");
+            stub |= line.contains(" StubRoutines::");
+            nmethod |= line.contains(" PerfMapTest$Child.main(java.lang.String[]) [");
+        }
+        if (!interpreter || !stub || !nmethod) {
+            throw new RuntimeException("Missing entries: interpreter=" + interpreter +
+                                       " stub=" + stub + " nmethod=" + nmethod);
+        }
+    }
+
+    static void checkDump(ByteBuffer buf) {
+        if (buf.getInt(0) != 0x4A695444) {
+            throw new RuntimeException("Bad magic");
+        }
+        int pos = buf.getInt(8);
+        int loads = 0;
+        int last = -1;
+        while (pos < buf.limit()) {
+            last = buf.getInt(pos);
+            int size = buf.getInt(pos + 4);
+            if (last == 0) {
+                loads++;
+            }
+            pos += size;
+        }
+        if (pos != buf.limit() || loads == 0 || last != 3) {
+            throw new RuntimeException("Bad records: loads=" + loads + " last=" + last);
+        }
+    }
+}
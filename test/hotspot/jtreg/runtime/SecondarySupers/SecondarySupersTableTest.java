@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test SecondarySupersTableTest
+ * @summary Check instanceof and checkcast against classes with many secondary supers.
+ * @run main/othervm -Xbatch SecondarySupersTableTest
+ * @run main/othervm -Xbatch -XX:+UnlockDiagnosticVMOptions -XX:-UseSecondarySupersTable SecondarySupersTableTest
+ * @run main/othervm -Xint SecondarySupersTableTest
+ */
+
+public class SecondarySupersTableTest {
+    interface I0 {}
+    interface I1 {}
+    interface I2 {}
+    interface I3 {}
+    interface I4 {}
+    interface I5 {}
+    interface I6 {}
+    interface I7 {}
+    interface I8 {}
+    interface I9 {}
+    interface I10 {}
+    interface I11 {}
+    interface I12 {}
+    interface I13 {}
+    interface I14 {}
+    interface I15 {}
+    interface I16 {}
+    interface I17 {}
+    interface I18 {}
+    interface I19 {}
+    interface I20 {}
+    interface I21 {}
+    interface I22 {}
+    interface I23 {}
+    interface I24 {}
+    interface I25 {}
+    interface I26 {}
+    interface I27 {}
+    interface I28 {}
+    interface I29 {}
+    interface I30 {}
+    interface I31 {}
+    interface I32 {}
+    interface I33 {}
+    interface I34 {}
+    interface I35 {}
+    interface I36 {}
+    interface I37 {}
+    interface I38 {}
+    interface I39 {}
+    interface I40 {}
+    interface I41 {}
+    interface I42 {}
+    interface I43 {}
+    interface I44 {}
+    interface I45 {}
+    interface I46 {}
+    interface I47 {}
+
+    static class AllInterfaces implements I0, I1, I2, I3, I4, I5, I6, I7, I8, I9, I10, I11, I12, I13, I14, I15, I16, I17, I18, I19, I20, I21, I22, I23, I24, I25, I26, I27, I28, I29, I30, I31, I32, I33, I34, I35, I36, I37, I38, I39, I40, I41, I42, I43, I44, I45, I46, I47 {}
+    static class EvenInterfaces implements I0, I2, I4, I6, I8, I10, I12, I14, I16, I18, I20, I22, I24, I26, I28, I30, I32, I34, I36, I38, I40, I42, I44, I46 {}
+    static class Sub extends EvenInterfaces implements I1 {}
+
+    static void check(Object o, Class<?> c, boolean expected) {
+        if (c.isInstance(o) != expected) {
+            throw new RuntimeException(o.getClass().getName() + " instanceof " + c.getName() + " should be " + expected);
+        }
+    }
+
+    static boolean isI1(Object o) {
+        return o instanceof I1;
+    }
+
+    static I46 castI46(Object o) {
+        return (I46) o;
+    }
+
+    public static void main(String... args) {
+        Object all = new AllInterfaces();
+        Object even = new EvenInterfaces();
+        Object sub = new Sub();
+        Object[] arrays = new Object[] { new AllInterfaces[0], new EvenInterfaces[0] };
+
+        for (int i = 0; i < 20_000; i++) {
+            if (!isI1(all) || isI1(even) || !isI1(sub)) {
+                throw new RuntimeException("wrong instanceof I1 result");
+            }
+            castI46(all);
+            castI46(even);
+            castI46(sub);
+        }
+
+        check(all, I0.class, true);
+        check(even, I0.class, true);
+        check(all, I1.class, true);
+        check(even, I1.class, false);
+        check(all, I2.class, true);
+        check(even, I2.class, true);
+        check(all, I3.class, true);
+        check(even, I3.class, false);
+        check(all, I4.class, true);
+        check(even, I4.class, true);
+        check(all, I5.class, true);
+        check(even, I5.class, false);
+        check(all, I6.class, true);
+        check(even, I6.class, true);
+        check(all, I7.class, true);
+        check(even, I7.class, false);
+        check(all, I8.class, true);
+        check(even, I8.class, true);
+        check(all, I9.class, true);
+        check(even, I9.class, false);
+        check(all, I10.class, true);
+        check(even, I10.class, true);
+        check(all, I11.class, true);
+        check(even, I11.class, false);
+        check(all, I12.class, true);
+        check(even, I12.class, true);
+        check(all, I13.class, true);
+        check(even, I13.class, false);
+        check(all, I14.class, true);
+        check(even, I14.class, true);
+        check(all, I15.class, true);
+        check(even, I15.class, false);
+        check(all, I16.class, true);
+        check(even, I16.class, true);
+        check(all, I17.class, true);
+        check(even, I17.class, false);
+        check(all, I18.class, true);
+        check(even, I18.class, true);
+        check(all, I19.class, true);
+        check(even, I19.class, false);
+        check(all, I20.class, true);
+        check(even, I20.class, true);
+        check(all, I21.class, true);
+        check(even, I21.class, false);
+        check(all, I22.class, true);
+        check(even, I22.class, true);
+        check(all, I23.class, true);
+        check(even, I23.class, false);
+        check(all, I24.class, true);
+        check(even, I24.class, true);
+        check(all, I25.class, true);
+        check(even, I25.class, false);
+        check(all, I26.class, true);
+        check(even, I26.class, true);
+        check(all, I27.class, true);
+        check(even, I27.class, false);
+        check(all, I28.class, true);
+        check(even, I28.class, true);
+        check(all, I29.class, true);
+        check(even, I29.class, false);
+        check(all, I30.class, true);
+        check(even, I30.class, true);
+        check(all, I31.class, true);
+        check(even, I31.class, false);
+        check(all, I32.class, true);
+        check(even, I32.class, true);
+        check(all, I33.class, true);
+        check(even, I33.class, false);
+        check(all, I34.class, true);
+        check(even, I34.class, true);
+        check(all, I35.class, true);
+        check(even, I35.class, false);
+        check(all, I36.class, true);
+        check(even, I36.class, true);
+        check(all, I37.class, true);
+        check(even, I37.class, false);
+        check(all, I38.class, true);
+        check(even, I38.class, true);
+        check(all, I39.class, true);
+        check(even, I39.class, false);
+        check(all, I40.class, true);
+        check(even, I40.class, true);
+        check(all, I41.class, true);
+        check(even, I41.class, false);
+        check(all, I42.class, true);
+        check(even, I42.class, true);
+        check(all, I43.class, true);
+        check(even, I43.class, false);
+        check(all, I44.class, true);
+        check(even, I44.class, true);
+        check(all, I45.class, true);
+        check(even, I45.class, false);
+        check(all, I46.class, true);
+        check(even, I46.class, true);
+        check(all, I47.class, true);
+        check(even, I47.class, false);
+
+        check(arrays[0], I1[].class, true);
+        check(arrays[1], I1[].class, false);
+        check(arrays[1], I2[].class, true);
+        check(arrays[1], Cloneable.class, true);
+        check(sub, I3.class, false);
+    }
+}
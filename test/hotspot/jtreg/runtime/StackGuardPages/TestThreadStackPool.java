@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Threads that reuse pooled stacks still get StackOverflowError,
+ *          including after an overflow on the same stack.
+ * @requires os.family == "linux"
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:ThreadStackPoolSize=4 TestThreadStackPool
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:ThreadStackPoolSize=1 -Xint TestThreadStackPool
+ */
+
+public class TestThreadStackPool {
+    static final int ROUNDS = 200;
+    static final int THREADS = 8;
+
+    static int depth;
+
+    static void recurse() {
+        depth++;
+        recurse();
+    }
+
+    static void run(boolean overflow) throws Exception {
+        Thread[] threads = new Thread[THREADS];
+        boolean[] overflowed = new boolean[THREADS];
+        for (int i = 0; i < THREADS; i++) {
+            final int index = i;
+            threads[i] = new Thread(() -> {
+                if (overflow) {
+                    try {
+                        recurse();
+                    } catch (StackOverflowError e) {
+                        overflowed[index] = true;
+                    }
+                }
+            });
+            threads[i].start();
+        }
+        for (int i = 0; i < THREADS; i++) {
+            threads[i].join();
+            if (overflow && !overflowed[i]) {
+                throw new RuntimeException("No StackOverflowError in thread " + i);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < ROUNDS; i++) {
+            // Every few rounds overflow the stacks, which by then have
+            // been used by earlier threads.
+            run(i % 10 == 0);
+        }
+    }
+}
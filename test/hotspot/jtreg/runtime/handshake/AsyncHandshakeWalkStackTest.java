@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test AsyncHandshakeWalkStackTest
+ * @summary Queue asynchronous handshakes to running, waiting and exiting threads.
+ * @library /testlibrary /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @build AsyncHandshakeWalkStackTest
+ * @run driver ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI AsyncHandshakeWalkStackTest
+ */
+
+import jdk.test.lib.dcmd.JMXExecutor;
+import sun.hotspot.WhiteBox;
+
+public class AsyncHandshakeWalkStackTest {
+
+    public static void main(String... args) throws Exception {
+        int iterations = 3;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+        test(iterations);
+    }
+
+    private static void test(int iterations) throws Exception {
+        Thread loop_thread = new Thread(() -> run_loop());
+        Thread wait_thread = new Thread(() -> run_wait(new Object() {}));
+        loop_thread.setDaemon(true);
+        wait_thread.setDaemon(true);
+        loop_thread.start();
+        wait_thread.start();
+
+        WhiteBox wb = WhiteBox.getWhiteBox();
+        for (int i = 0; i < iterations; i++) {
+            System.out.println("Iteration " + i);
+            System.out.flush();
+            // Several requests in a row are coalesced by the target.
+            for (int j = 0; j < 10; j++) {
+                wb.asyncHandshakeWalkStack(loop_thread);
+                wb.asyncHandshakeWalkStack(wait_thread);
+            }
+            Thread.sleep(200);
+
+            // The waiting thread still has its asynchronous operations queued.
+            // The direct handshakes of the thread dump are executed on its
+            // behalf and must leave them for the thread itself.
+            new JMXExecutor().execute("Thread.print -handshake");
+
+            // Threads that exit with operations still queued must not leak or crash.
+            Thread exit_thread = new Thread(() -> {});
+            exit_thread.start();
+            for (int j = 0; j < 10; j++) {
+                wb.asyncHandshakeWalkStack(exit_thread);
+            }
+            exit_thread.join();
+            wb.asyncHandshakeWalkStack(exit_thread);
+        }
+    }
+
+    public static volatile boolean loop = true;
+
+    public static void run_loop() {
+        while (loop) {
+        }
+    }
+
+    public static void run_wait(Object lock) {
+        synchronized (lock) {
+            try {
+                lock.wait();
+            } catch (InterruptedException ie) {}
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Asynchronous logging writes all buffered messages before the VM exits.
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver AsyncLogTest
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class AsyncLogTest {
+
+    public static void main(String[] args) throws Exception {
+        // Messages logged right before exit must not be lost.
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-Xlog:async", "-Xlog:gc", "-Xlog:logging+thread=debug",
+            InnerClass.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Pause Full (System.gc())");
+        output.shouldContain("Async logging thread terminated.");
+
+        // With a tiny buffer that blocks when full, nothing is dropped.
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-Xlog:async", "-XX:AsyncLogBufferSize=100K", "-XX:+AsyncLogBlockWhenFull",
+            "-Xlog:all=trace", InnerClass.class.getName());
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Pause Full (System.gc())");
+        output.shouldNotContain("messages dropped due to async logging");
+    }
+
+    public static class InnerClass {
+        public static void main(String[] args) {
+            System.gc();
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary System.nanoTime() read from the TSC never goes backwards, also across threads.
+ * @requires os.family == "linux" & os.arch == "amd64"
+ * @library /test/lib
+ *
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseTSCForJavaTimeNanos -Xlog:os=info
+ *                   TestUseTSCForJavaTimeNanos
+ * @run driver TestUseTSCForJavaTimeNanos recalibration
+ */
+
+import java.util.concurrent.atomic.AtomicLong;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestUseTSCForJavaTimeNanos {
+
+    static final int THREADS = 4;
+    static final int ITERATIONS = 1_000_000;
+
+    // The largest time published by any thread so far
+    static final AtomicLong latest = new AtomicLong(Long.MIN_VALUE);
+
+    static void publishAndCheck() {
+        for (int i = 0; i < ITERATIONS; i++) {
+            long seen = latest.get();
+            long now = System.nanoTime();
+            if (now < seen) {
+                throw new RuntimeException("nanoTime went backwards: " + now + " < " + seen);
+            }
+            latest.accumulateAndGet(now, Math::max);
+        }
+    }
+
+    // The TSC is recalibrated every second for as long as the kernel uses it.
+    static void checkRecalibration() throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions", "-XX:+UseTSCForJavaTimeNanos", "-Xlog:os=debug",
+            TestUseTSCForJavaTimeNanos.class.getName(), "sleep");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        if (!output.getStdout().contains("Using the TSC for javaTimeNanos")) {
+            System.out.println("The TSC is not used on this machine");
+            return;
+        }
+        if (!output.getStdout().contains("No longer using the TSC for javaTimeNanos")) {
+            output.shouldMatch("Recalibrated the TSC for javaTimeNanos, -?\\d+ ns off CLOCK_MONOTONIC");
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0 && args[0].equals("recalibration")) {
+            checkRecalibration();
+            return;
+        }
+        if (args.length > 0 && args[0].equals("sleep")) {
+            Thread.sleep(3000);
+        }
+
+        long start = System.nanoTime();
+        Thread.sleep(100);
+        long slept = System.nanoTime() - start;
+        if (slept < 100_000_000L) {
+            throw new RuntimeException("Slept 100 ms but nanoTime advanced " + slept + " ns");
+        }
+
+        Thread[] threads = new Thread[THREADS];
+        Throwable[] failure = new Throwable[1];
+        for (int i = 0; i < THREADS; i++) {
+            threads[i] = new Thread(TestUseTSCForJavaTimeNanos::publishAndCheck);
+            threads[i].setUncaughtExceptionHandler((t, e) -> failure[0] = e);
+            threads[i].start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+        if (failure[0] != null) {
+            throw new RuntimeException(failure[0]);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import jdk.test.lib.dcmd.CommandExecutor;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.dcmd.PidJcmdExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+
+import java.util.List;
+
+import org.testng.annotations.Test;
+
+/*
+ * @test id=segmented
+ * @summary Test of diagnostic command Compiler.CodeHeap_Analytics compact
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.compiler
+ *          java.management
+ *          jdk.internal.jvmstat/sun.jvmstat.monitor
+ * @run testng/othervm -XX:+SegmentedCodeCache CodeHeapAnalyticsCompact
+ */
+
+/*
+ * @test id=nonsegmented
+ * @summary Test of diagnostic command Compiler.CodeHeap_Analytics compact
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.compiler
+ *          java.management
+ *          jdk.internal.jvmstat/sun.jvmstat.monitor
+ * @run testng/othervm -XX:-SegmentedCodeCache CodeHeapAnalyticsCompact
+ */
+public class CodeHeapAnalyticsCompact {
+    static final String LINE_PATTERN =
+        "heap=\"[^\"]+\" aggregated=true capacity=\\d+ max_capacity=\\d+" +
+        " t1_count=\\d+ t1_bytes=\\d+ t2_count=\\d+ t2_bytes=\\d+" +
+        " alive_count=\\d+ alive_bytes=\\d+ dead_count=\\d+ dead_bytes=\\d+" +
+        " stub_count=\\d+ stub_bytes=\\d+ free_count=\\d+ free_bytes=\\d+" +
+        " max_free_bytes=\\d+ min_temp=-?\\d+ avg_temp=-?\\d+ max_temp=-?\\d+";
+
+    public void run(CommandExecutor executor) {
+        OutputAnalyzer output = executor.execute("Compiler.CodeHeap_Analytics compact");
+        output.shouldNotContain("is not supported");
+
+        // One complete line per code heap.
+        List<String> lines = output.asLines();
+        int heaps = 0;
+        for (String line : lines) {
+            if (!line.startsWith("heap=")) {
+                continue;
+            }
+            if (!line.matches(LINE_PATTERN)) {
+                throw new RuntimeException("Unexpected line: " + line);
+            }
+            heaps++;
+        }
+        if (heaps == 0) {
+            throw new RuntimeException("No code heap reported");
+        }
+        output.shouldContain("stub_count=");
+
+        // Running it again reuses the aggregated state.
+        output = executor.execute("Compiler.CodeHeap_Analytics compact");
+        output.shouldMatch(LINE_PATTERN);
+
+        // The full analysis holds the CodeCache_lock throughout and must
+        // still complete.
+        output = executor.execute("Compiler.CodeHeap_Analytics all");
+        output.shouldContain("CodeCache (global) lock hold took");
+        output.shouldNotContain("during analysis. Analysis data is incomplete.");
+    }
+
+    @Test
+    public void jmx() {
+        run(new JMXExecutor());
+    }
+
+    @Test
+    public void cli() {
+        run(new PidJcmdExecutor());
+    }
+}
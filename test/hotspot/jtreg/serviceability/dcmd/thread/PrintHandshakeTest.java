@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import jdk.test.lib.dcmd.CommandExecutor;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.dcmd.PidJcmdExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+
+import java.util.concurrent.CountDownLatch;
+
+import org.testng.annotations.AfterClass;
+import org.testng.annotations.BeforeClass;
+import org.testng.annotations.Test;
+
+/*
+ * @test
+ * @summary Test of diagnostic command Thread.print -handshake
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.compiler
+ *          java.management
+ *          jdk.internal.jvmstat/sun.jvmstat.monitor
+ * @run testng PrintHandshakeTest
+ */
+public class PrintHandshakeTest {
+    static final String THREAD_NAME = "PrintHandshakeTest-Sleeper";
+
+    private final CountDownLatch started = new CountDownLatch(1);
+    private final Object lock = new Object();
+    private Thread sleeper;
+
+    private void sleepHoldingLock() {
+        synchronized (lock) {
+            started.countDown();
+            try {
+                Thread.sleep(Long.MAX_VALUE);
+            } catch (InterruptedException e) {
+                // Done
+            }
+        }
+    }
+
+    @BeforeClass
+    public void setup() throws InterruptedException {
+        sleeper = new Thread(this::sleepHoldingLock, THREAD_NAME);
+        sleeper.setDaemon(true);
+        sleeper.start();
+        started.await();
+    }
+
+    @AfterClass
+    public void shutdown() throws InterruptedException {
+        sleeper.interrupt();
+        sleeper.join();
+    }
+
+    private void checkDump(OutputAnalyzer output) {
+        output.shouldContain("Full thread dump");
+        output.shouldContain("\"" + THREAD_NAME + "\"");
+        output.shouldMatch("java.lang.Thread.State: TIMED_WAITING \\(sleeping\\)");
+        output.shouldContain("at PrintHandshakeTest.sleepHoldingLock");
+        // The monitor info is printed while the thread is stopped.
+        output.shouldMatch("- locked <0x\\p{XDigit}+> \\(a java.lang.Object\\)");
+        // The requesting thread prints its own stack too.
+        output.shouldContain("java.lang.Thread.State: RUNNABLE");
+        // Non-Java threads follow the Java threads.
+        output.shouldContain("\"VM Thread\"");
+        output.shouldContain("JNI global refs:");
+    }
+
+    public void run(CommandExecutor executor) {
+        checkDump(executor.execute("Thread.print -handshake"));
+        checkDump(executor.execute("Thread.print -handshake -e"));
+        // -l needs a safepoint and falls back to the safepoint dump.
+        OutputAnalyzer locks = executor.execute("Thread.print -handshake -l");
+        checkDump(locks);
+        locks.shouldContain("Locked ownable synchronizers:");
+        // The safepoint dump is still the default.
+        checkDump(executor.execute("Thread.print"));
+    }
+
+    @Test
+    public void jmx() {
+        run(new JMXExecutor());
+    }
+
+    @Test
+    public void cli() {
+        run(new PidJcmdExecutor());
+    }
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package startup;
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Measures startup and footprint of the applications in startup.apps
+ * under several sharing configurations:
+ *
+ *   cds      default CDS archive (-Xshare:auto)
+ *   noshare  -Xshare:off
+ *   dynamic  a dynamic archive of the application, created by a training
+ *            run with -XX:ArchiveClassesAtExit
+ *   aot      -XX:AOTLibrary=<lib>, only when --aot-library is given
+ *
+ * For every run the applications print STARTUP_MAIN on entry to main and
+ * STARTUP_READY when done, then wait for stdin to close. While they wait,
+ * the PerfData counters are read with jcmd and RSS from /proc. Each
+ * application and configuration is run several times and the medians
+ * are reported, one line each:
+ *
+ *   STARTUP app=<app> config=<config> time_to_main_ms=<n> create_vm_ms=<n>
+ *     loaded_classes=<n> shared_classes=<n> metaspace_kb=<n> rss_kb=<n>
+ *
+ * time_to_main_ms is measured from process launch; create_vm_ms comes
+ * from -Xlog:startuptime. Values that are not available are reported as -1.
+ */
+public class StartupBenchmark {
+
+    static final String[] APPS = { "Hello", "ModuleHeavy", "LambdaHeavy", "ReflectionHeavy" };
+
+    static final String[] METRICS = { "time_to_main_ms", "create_vm_ms", "loaded_classes",
+                                      "shared_classes", "metaspace_kb", "rss_kb" };
+
+    private String jdk = System.getProperty("java.home");
+    private String classes = System.getProperty("java.class.path");
+    private Path workDir = Paths.get(".");
+    private int iterations = 5;
+    private List<String> configs = new ArrayList<>(Arrays.asList("cds", "noshare", "dynamic"));
+    private String aotLibrary;
+
+    public static void main(String[] args) throws Exception {
+        new StartupBenchmark(args).run();
+    }
+
+    StartupBenchmark(String[] args) {
+        for (int i = 0; i < args.length; i++) {
+            switch (args[i]) {
+                case "--jdk":         jdk = args[++i]; break;
+                case "--classes":     classes = args[++i]; break;
+                case "--work-dir":    workDir = Paths.get(args[++i]); break;
+                case "--iterations":  iterations = Integer.parseInt(args[++i]); break;
+                case "--configs":     configs = new ArrayList<>(Arrays.asList(args[++i].split(","))); break;
+                case "--aot-library": aotLibrary = args[++i]; break;
+                default:
+                    throw new IllegalArgumentException("Unknown option " + args[i]);
+            }
+        }
+        if (aotLibrary != null && !configs.contains("aot")) {
+            configs.add("aot");
+        }
+    }
+
+    void run() throws Exception {
+        for (String app : APPS) {
+            for (String config : configs) {
+                List<String> vmArgs = vmArgs(app, config);
+                if (vmArgs == null) {
+                    continue;
+                }
+                Map<String, List<Double>> samples = new HashMap<>();
+                for (int i = 0; i < iterations; i++) {
+                    Map<String, Double> sample = measure(app, vmArgs);
+                    for (String m : METRICS) {
+                        samples.computeIfAbsent(m, k -> new ArrayList<>()).add(sample.getOrDefault(m, -1.0));
+                    }
+                }
+                StringBuilder sb = new StringBuilder();
+                sb.append("STARTUP app=").append(app).append(" config=").append(config);
+                for (String m : METRICS) {
+                    sb.append(' ').append(m).append('=').append(format(median(samples.get(m))));
+                }
+                System.out.println(sb);
+            }
+        }
+    }
+
+    List<String> vmArgs(String app, String config) throws Exception {
+        switch (config) {
+            case "cds":
+                return List.of("-Xshare:auto");
+            case "noshare":
+                return List.of("-Xshare:off");
+            case "dynamic": {
+                Path archive = workDir.resolve(app + ".jsa").toAbsolutePath();
+                Files.deleteIfExists(archive);
+                Process p = launch(app, List.of("-XX:ArchiveClassesAtExit=" + archive));
+                p.getOutputStream().close();
+                drain(new BufferedReader(new InputStreamReader(p.getInputStream())));
+                if (p.waitFor() != 0 || !Files.exists(archive)) {
+                    System.err.println("Could not create dynamic archive for " + app + ", skipping");
+                    return null;
+                }
+                return List.of("-XX:SharedArchiveFile=" + archive);
+            }
+            case "aot":
+                if (aotLibrary == null) {
+                    System.err.println("aot configuration needs --aot-library, skipping");
+                    return null;
+                }
+                return List.of("-XX:+UnlockExperimentalVMOptions", "-XX:AOTLibrary=" + aotLibrary);
+            default:
+                throw new IllegalArgumentException("Unknown configuration " + config);
+        }
+    }
+
+    Process launch(String app, List<String> vmArgs) throws IOException {
+        List<String> cmd = new ArrayList<>();
+        cmd.add(Paths.get(jdk, "bin", "java").toString());
+        cmd.addAll(vmArgs);
+        cmd.add("-Xlog:startuptime");
+        cmd.add("-cp");
+        cmd.add(classes);
+        cmd.add("startup.apps." + app);
+        return new ProcessBuilder(cmd).redirectErrorStream(true).start();
+    }
+
+    Map<String, Double> measure(String app, List<String> vmArgs) throws Exception {
+        Map<String, Double> result = new HashMap<>();
+        long start = System.nanoTime();
+        Process p = launch(app, vmArgs);
+        BufferedReader out = new BufferedReader(new InputStreamReader(p.getInputStream()));
+        String line;
+        while ((line = out.readLine()) != null) {
+            if (line.equals("STARTUP_MAIN")) {
+                result.put("time_to_main_ms", (System.nanoTime() - start) / 1e6);
+            } else if (line.contains("startuptime") && line.contains("Create VM,")) {
+                result.put("create_vm_ms", parseSecs(line) * 1000);
+            } else if (line.equals("STARTUP_READY")) {
+                break;
+            }
+        }
+
+        Map<String, String> counters = perfCounters(p.pid());
+        putCounter(result, "loaded_classes", counters.get("java.cls.loadedClasses"), 1);
+        putCounter(result, "shared_classes", counters.get("java.cls.sharedLoadedClasses"), 1);
+        putCounter(result, "metaspace_kb", counters.get("sun.gc.metaspace.used"), 1024);
+        Path status = Paths.get("/proc", Long.toString(p.pid()), "status");
+        if (Files.exists(status)) {
+            for (String s : Files.readAllLines(status)) {
+                if (s.startsWith("VmRSS:")) {
+                    result.put("rss_kb", Double.parseDouble(s.replaceAll("[^0-9]", "")));
+                }
+            }
+        }
+
+        p.getOutputStream().close();
+        drain(out);
+        if (p.waitFor() != 0) {
+            throw new RuntimeException(app + " exited with " + p.exitValue());
+        }
+        return result;
+    }
+
+    Map<String, String> perfCounters(long pid) throws Exception {
+        Map<String, String> counters = new HashMap<>();
+        Process jcmd = new ProcessBuilder(Paths.get(jdk, "bin", "jcmd").toString(),
+                                          Long.toString(pid), "PerfCounter.print")
+                .redirectErrorStream(true).start();
+        try (BufferedReader r = new BufferedReader(new InputStreamReader(jcmd.getInputStream()))) {
+            String line;
+            while ((line = r.readLine()) != null) {
+                int eq = line.indexOf('=');
+                if (eq > 0) {
+                    counters.put(line.substring(0, eq), line.substring(eq + 1));
+                }
+            }
+        }
+        jcmd.waitFor();
+        return counters;
+    }
+
+    static void putCounter(Map<String, Double> result, String metric, String value, int scale) {
+        if (value != null) {
+            try {
+                result.put(metric, Double.parseDouble(value.trim()) / scale);
+            } catch (NumberFormatException e) {
+                // not a numeric counter
+            }
+        }
+    }
+
+    // "[0.123s][info][startuptime] Create VM, 0.0812345 secs"
+    static double parseSecs(String line) {
+        int comma = line.lastIndexOf(',');
+        String s = line.substring(comma + 1).replace("secs", "").trim();
+        return Double.parseDouble(s);
+    }
+
+    static void drain(BufferedReader r) throws IOException {
+        while (r.readLine() != null) {
+            // discard
+        }
+    }
+
+    static double median(List<Double> values) {
+        double[] v = values.stream().mapToDouble(Double::doubleValue).sorted().toArray();
+        return v.length == 0 ? -1 : v[v.length / 2];
+    }
+
+    static String format(double v) {
+        return v == Math.rint(v) ? Long.toString((long) v) : String.format("%.2f", v);
+    }
+}
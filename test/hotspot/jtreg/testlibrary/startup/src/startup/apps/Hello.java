@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -19,18 +19,16 @@
  * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
  * or visit www.oracle.com if you need additional information or have any
  * questions.
- *
  */
 
-#ifndef SHARE_GC_G1_SPARSEPRT_INLINE_HPP
-#define SHARE_GC_G1_SPARSEPRT_INLINE_HPP
-
-#include "gc/g1/g1CollectedHeap.hpp"
-#include "gc/g1/sparsePRT.hpp"
+package startup.apps;
 
-inline bool SparsePRT::contains_card(RegionIdx_t region_id, CardIdx_t card_index) const {
-  return _table->contains_card(region_id, card_index);
+public class Hello {
+    public static void main(String[] args) throws Exception {
+        System.out.println("STARTUP_MAIN");
+        System.out.println("Hello, world");
+        System.out.println("STARTUP_READY");
+        System.out.flush();
+        while (System.in.read() != -1) {}
+    }
 }
-
-
-#endif // SHARE_GC_G1_SPARSEPRT_INLINE_HPP
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package startup.apps;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.function.BiFunction;
+import java.util.function.Function;
+import java.util.function.Predicate;
+import java.util.function.Supplier;
+import java.util.stream.Collectors;
+import java.util.stream.IntStream;
+
+/**
+ * Links many distinct lambda, method reference and string concatenation
+ * call sites, each of which spins a class at startup unless archived.
+ */
+public class LambdaHeavy {
+    public static void main(String[] args) throws Exception {
+        System.out.println("STARTUP_MAIN");
+
+        List<Function<Integer, Integer>> fs = new ArrayList<>();
+        fs.add(x -> x + 1);
+        fs.add(x -> x * 2);
+        fs.add(x -> x - 3);
+        fs.add(x -> x / 2);
+        fs.add(x -> x % 7);
+        fs.add(x -> -x);
+        fs.add(x -> x << 1);
+        fs.add(x -> x >> 1);
+        fs.add(x -> x ^ 0x55);
+        fs.add(x -> x | 0x10);
+        fs.add(x -> x & 0xff);
+        fs.add(Math::abs);
+        fs.add(Integer::reverse);
+        fs.add(Integer::bitCount);
+        fs.add(Integer::highestOneBit);
+        fs.add(Integer::lowestOneBit);
+        int v = 42;
+        for (Function<Integer, Integer> f : fs) {
+            v = f.apply(v);
+        }
+
+        List<Predicate<String>> ps = List.of(String::isEmpty, s -> s.length() > 3,
+                                             s -> s.startsWith("a"), s -> s.endsWith("z"),
+                                             s -> s.contains("x"), String::isBlank);
+        List<BiFunction<String, Integer, String>> bs = List.of(String::repeat, (s, i) -> s + i,
+                                                              (s, i) -> i + s, (s, i) -> s.substring(0, Math.min(i, s.length())));
+        List<Supplier<Object>> ss = List.of(ArrayList::new, Object::new, StringBuilder::new, () -> "x");
+
+        Map<Boolean, List<String>> parts = IntStream.range(0, 100)
+                .mapToObj(i -> "s" + i + ":" + (i * 31) + "/" + (char) ('a' + i % 26))
+                .filter(s -> !s.isEmpty())
+                .map(String::toUpperCase)
+                .sorted((a, b) -> b.compareTo(a))
+                .collect(Collectors.partitioningBy(s -> s.length() % 2 == 0));
+        long matches = ps.stream().filter(p -> p.test("abcxyz")).count();
+        String joined = bs.stream().map(b -> b.apply("ab", 2)).collect(Collectors.joining(",", "[", "]"));
+        int suppliers = (int) ss.stream().map(Supplier::get).count();
+        System.out.println(v + " " + parts.size() + " " + matches + " " + joined + " " + suppliers);
+
+        System.out.println("STARTUP_READY");
+        System.out.flush();
+        while (System.in.read() != -1) {}
+    }
+}
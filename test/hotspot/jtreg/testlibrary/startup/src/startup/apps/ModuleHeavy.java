@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package startup.apps;
+
+import java.io.ByteArrayInputStream;
+import java.lang.management.ManagementFactory;
+import java.nio.charset.StandardCharsets;
+import java.time.LocalDateTime;
+import java.time.format.DateTimeFormatter;
+import java.util.logging.Logger;
+import javax.crypto.Cipher;
+import javax.xml.parsers.DocumentBuilderFactory;
+
+/**
+ * Touches services from several platform modules (logging, management,
+ * XML, crypto, time), the way a typical small server initializes.
+ */
+public class ModuleHeavy {
+    public static void main(String[] args) throws Exception {
+        System.out.println("STARTUP_MAIN");
+
+        Logger.getLogger("startup").fine("starting");
+        long uptime = ManagementFactory.getRuntimeMXBean().getUptime();
+        String xml = "<config><entry key=\"a\">1</entry><entry key=\"b\">2</entry></config>";
+        int entries = DocumentBuilderFactory.newInstance().newDocumentBuilder()
+                .parse(new ByteArrayInputStream(xml.getBytes(StandardCharsets.UTF_8)))
+                .getElementsByTagName("entry").getLength();
+        String cipher = Cipher.getInstance("AES/GCM/NoPadding").getAlgorithm();
+        String now = DateTimeFormatter.ISO_LOCAL_DATE_TIME.format(LocalDateTime.now());
+        System.out.println(uptime + " " + entries + " " + cipher + " " + now);
+
+        System.out.println("STARTUP_READY");
+        System.out.flush();
+        while (System.in.read() != -1) {}
+    }
+}
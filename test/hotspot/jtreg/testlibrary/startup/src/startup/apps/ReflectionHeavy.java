@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package startup.apps;
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.reflect.Method;
+import java.lang.reflect.Modifier;
+import java.lang.reflect.Proxy;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.BitSet;
+import java.util.HashMap;
+import java.util.LinkedList;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.Callable;
+
+/**
+ * Introspects and reflectively invokes many JDK classes, creates dynamic
+ * proxies and method handles, the way dependency injection and
+ * serialization frameworks do at startup.
+ */
+public class ReflectionHeavy {
+    public static void main(String[] args) throws Throwable {
+        System.out.println("STARTUP_MAIN");
+
+        Class<?>[] types = { ArrayList.class, LinkedList.class, HashMap.class, TreeMap.class,
+                             ArrayDeque.class, BitSet.class, ConcurrentHashMap.class, StringBuilder.class };
+        int members = 0;
+        int invoked = 0;
+        for (Class<?> c : types) {
+            Object instance = c.getConstructor().newInstance();
+            members += c.getDeclaredFields().length + c.getDeclaredConstructors().length;
+            for (Method m : c.getDeclaredMethods()) {
+                members++;
+                if (Modifier.isPublic(m.getModifiers()) && !Modifier.isStatic(m.getModifiers()) &&
+                    m.getParameterCount() == 0 &&
+                    (m.getName().startsWith("size") || m.getName().startsWith("is") ||
+                     m.getName().equals("hashCode") || m.getName().equals("toString"))) {
+                    m.invoke(instance);
+                    invoked++;
+                }
+            }
+        }
+
+        List<Class<?>> interfaces = List.of(Runnable.class, Callable.class, Comparable.class, Map.Entry.class);
+        for (Class<?> i : interfaces) {
+            Object proxy = Proxy.newProxyInstance(ReflectionHeavy.class.getClassLoader(), new Class<?>[] { i },
+                                                  (p, m, a) -> m.getReturnType() == int.class ? 0 : null);
+            members += proxy.getClass().getDeclaredMethods().length;
+        }
+
+        MethodHandle mh = MethodHandles.lookup().findVirtual(String.class, "concat",
+                MethodType.methodType(String.class, String.class));
+        String s = (String) mh.invokeExact("members=", Integer.toString(members));
+        System.out.println(s + " invoked=" + invoked);
+
+        System.out.println("STARTUP_READY");
+        System.out.flush();
+        while (System.in.read() != -1) {}
+    }
+}
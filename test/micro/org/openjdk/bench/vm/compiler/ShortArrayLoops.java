@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.vm.compiler;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Superword loops over short double arrays, where the pre- and post-loops
+ * around the vectorized main loop execute a large share of the iterations.
+ * Run with -XX:+UnlockExperimentalVMOptions -XX:+PostLoopMultiversioning to
+ * measure the masked post-loop on hardware with predicated vectors.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@State(Scope.Thread)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(value = 3)
+public class ShortArrayLoops {
+
+    @Param({"20", "37", "60"})
+    public int size;
+
+    private double[] a;
+    private double[] b;
+    private double[] c;
+
+    @Setup
+    public void setup() {
+        Random r = new Random(42);
+        a = new double[size];
+        b = new double[size];
+        c = new double[size];
+        for (int i = 0; i < size; i++) {
+            a[i] = r.nextDouble();
+            b[i] = r.nextDouble();
+        }
+    }
+
+    @Benchmark
+    public double[] add() {
+        for (int i = 0; i < c.length; i++) {
+            c[i] = a[i] + b[i];
+        }
+        return c;
+    }
+
+    @Benchmark
+    public double[] fma() {
+        for (int i = 0; i < c.length; i++) {
+            c[i] = a[i] * b[i] + c[i];
+        }
+        return c;
+    }
+
+    @Benchmark
+    public double[] scale() {
+        double f = 1.0001;
+        for (int i = 0; i < c.length; i++) {
+            c[i] = a[i] * f;
+        }
+        return c;
+    }
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.vm.gc;
+
+import org.openjdk.jmh.infra.BenchmarkParams;
+import org.openjdk.jmh.infra.IterationParams;
+import org.openjdk.jmh.profile.InternalProfiler;
+import org.openjdk.jmh.results.AggregationPolicy;
+import org.openjdk.jmh.results.IterationResult;
+import org.openjdk.jmh.results.Result;
+import org.openjdk.jmh.results.ScalarResult;
+
+import java.io.IOException;
+import java.lang.management.ManagementFactory;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.List;
+
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.jfr.consumer.RecordingFile;
+
+/**
+ * Reports per-iteration GC statistics as secondary JMH results, for use with
+ * the workloads in this package:
+ *
+ *   -prof org.openjdk.bench.vm.gc.GCPauseProfiler
+ *
+ * gc.pause.*     count and p50/p90/p99/max of the GC pauses (jdk.GCPhasePause)
+ * gc.stalls      mutator stalls: ZGC allocation stalls, Shenandoah degenerated
+ *                or full collections, and G1/Parallel/Serial full collections
+ * gc.cpu.per.mb  CPU time of threads that are not Java threads (GC workers,
+ *                VM and compiler threads) per MB reclaimed, in ms; compiler
+ *                activity is small after warmup
+ *
+ * Reclaimed bytes are the bytes allocated by live Java threads minus the
+ * growth of the used heap over the iteration.
+ */
+public class GCPauseProfiler implements InternalProfiler {
+
+    private static final List<String> FULL_GC_NAMES = List.of("G1Full", "ParallelOld", "SerialOld");
+
+    private Recording recording;
+    private long cpuStart;
+    private long javaCpuStart;
+    private long allocatedStart;
+    private long usedStart;
+
+    @Override
+    public String getDescription() {
+        return "GC pause percentiles, allocation stalls and GC CPU per reclaimed MB";
+    }
+
+    @Override
+    public void beforeIteration(BenchmarkParams benchmarkParams, IterationParams iterationParams) {
+        recording = new Recording();
+        recording.enable("jdk.GCPhasePause").withoutThreshold();
+        recording.enable("jdk.GarbageCollection").withoutThreshold();
+        recording.enable("jdk.ZAllocationStall").withoutThreshold();
+        recording.start();
+        cpuStart = processCpuTime();
+        javaCpuStart = javaThreadsCpuTime();
+        allocatedStart = allocatedBytes();
+        usedStart = heapUsed();
+    }
+
+    @Override
+    public Collection<? extends Result> afterIteration(BenchmarkParams benchmarkParams,
+                                                       IterationParams iterationParams,
+                                                       IterationResult result) {
+        long nonJavaCpu = (processCpuTime() - cpuStart) - (javaThreadsCpuTime() - javaCpuStart);
+        long reclaimed = (allocatedBytes() - allocatedStart) - (heapUsed() - usedStart);
+        recording.stop();
+
+        List<RecordedEvent> events;
+        try {
+            Path file = Files.createTempFile("gcpause", ".jfr");
+            try {
+                recording.dump(file);
+                events = RecordingFile.readAllEvents(file);
+            } finally {
+                Files.deleteIfExists(file);
+            }
+        } catch (IOException e) {
+            throw new IllegalStateException(e);
+        } finally {
+            recording.close();
+            recording = null;
+        }
+
+        List<Long> pauses = new ArrayList<>();
+        int stalls = 0;
+        for (RecordedEvent e : events) {
+            switch (e.getEventType().getName()) {
+                case "jdk.GCPhasePause":
+                    pauses.add(e.getDuration().toNanos());
+                    break;
+                case "jdk.ZAllocationStall":
+                    stalls++;
+                    break;
+                case "jdk.GarbageCollection": {
+                    String name = e.getString("name");
+                    if (FULL_GC_NAMES.contains(name) ||
+                        ("Shenandoah".equals(name) && "Allocation Failure".equals(e.getString("cause")))) {
+                        stalls++;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        long[] sorted = pauses.stream().mapToLong(Long::longValue).toArray();
+        Arrays.sort(sorted);
+
+        List<Result> results = new ArrayList<>();
+        results.add(new ScalarResult("gc.pause.count", sorted.length, "#", AggregationPolicy.SUM));
+        results.add(new ScalarResult("gc.pause.p50", percentile(sorted, 50), "ms", AggregationPolicy.AVG));
+        results.add(new ScalarResult("gc.pause.p90", percentile(sorted, 90), "ms", AggregationPolicy.AVG));
+        results.add(new ScalarResult("gc.pause.p99", percentile(sorted, 99), "ms", AggregationPolicy.AVG));
+        results.add(new ScalarResult("gc.pause.max", percentile(sorted, 100), "ms", AggregationPolicy.MAX));
+        results.add(new ScalarResult("gc.stalls", stalls, "#", AggregationPolicy.SUM));
+        double reclaimedMB = reclaimed / (1024.0 * 1024.0);
+        double cpuPerMB = reclaimedMB > 0 ? nonJavaCpu / 1e6 / reclaimedMB : Double.NaN;
+        results.add(new ScalarResult("gc.cpu.per.mb", cpuPerMB, "ms/MB", AggregationPolicy.AVG));
+        return results;
+    }
+
+    // Nearest-rank percentile in milliseconds, 0 when there were no pauses.
+    private static double percentile(long[] sorted, int p) {
+        if (sorted.length == 0) {
+            return 0;
+        }
+        int rank = (int) Math.ceil(p / 100.0 * sorted.length);
+        return sorted[Math.max(rank, 1) - 1] / 1e6;
+    }
+
+    private static long processCpuTime() {
+        return ((com.sun.management.OperatingSystemMXBean) ManagementFactory.getOperatingSystemMXBean())
+                .getProcessCpuTime();
+    }
+
+    private static long javaThreadsCpuTime() {
+        java.lang.management.ThreadMXBean threads = ManagementFactory.getThreadMXBean();
+        long sum = 0;
+        for (long id : threads.getAllThreadIds()) {
+            long t = threads.getThreadCpuTime(id);
+            if (t > 0) {
+                sum += t;
+            }
+        }
+        return sum;
+    }
+
+    private static long allocatedBytes() {
+        com.sun.management.ThreadMXBean threads =
+                (com.sun.management.ThreadMXBean) ManagementFactory.getThreadMXBean();
+        long sum = 0;
+        for (long bytes : threads.getThreadAllocatedBytes(threads.getAllThreadIds())) {
+            if (bytes > 0) {
+                sum += bytes;
+            }
+        }
+        return sum;
+    }
+
+    private static long heapUsed() {
+        return ManagementFactory.getMemoryMXBean().getHeapMemoryUsage().getUsed();
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.vm.gc;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * A large live set of binary trees in which whole trees are replaced, so
+ * that old objects die continuously and the old generation needs marking
+ * and compaction. Run with -prof org.openjdk.bench.vm.gc.GCPauseProfiler
+ * to get pause percentiles, stalls and GC CPU.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 5)
+@Measurement(iterations = 5, time = 10)
+public abstract class ObjectGraphChurn {
+
+    static final class Node {
+        Node left;
+        Node right;
+        long payload;
+    }
+
+    private static final int TREE_DEPTH = 10;
+
+    // Approximate size of one tree, 32 bytes per node with compressed oops
+    private static final long TREE_BYTES = ((1L << (TREE_DEPTH + 1)) - 1) * 32;
+
+    @Param({"256", "1024"})
+    public int liveSetMB;
+
+    private Node[] trees;
+
+    @Setup
+    public void setup() {
+        int count = (int) Math.max(1, liveSetMB * 1024L * 1024L / TREE_BYTES);
+        trees = new Node[count];
+        for (int i = 0; i < count; i++) {
+            trees[i] = build(TREE_DEPTH, i);
+        }
+        System.gc();
+    }
+
+    private static Node build(int depth, long seed) {
+        Node n = new Node();
+        n.payload = seed;
+        if (depth > 0) {
+            n.left = build(depth - 1, seed * 2);
+            n.right = build(depth - 1, seed * 2 + 1);
+        }
+        return n;
+    }
+
+    @Benchmark
+    public Node replaceTree() {
+        int i = ThreadLocalRandom.current().nextInt(trees.length);
+        Node n = build(TREE_DEPTH, i);
+        trees[i] = n;
+        return n;
+    }
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseG1GC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class G1 extends ObjectGraphChurn {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseParallelGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Parallel extends ObjectGraphChurn {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseZGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Z extends ObjectGraphChurn {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseShenandoahGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Shenandoah extends ObjectGraphChurn {}
+}
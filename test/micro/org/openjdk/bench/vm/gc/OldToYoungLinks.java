@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.vm.gc;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Stores freshly allocated objects into random slots of a large, long-lived
+ * array of holders, creating many old-to-young references spread over the
+ * old generation. This stresses card marking and remembered set scanning
+ * and refinement. Run with -prof org.openjdk.bench.vm.gc.GCPauseProfiler
+ * to get pause percentiles, stalls and GC CPU.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 5)
+@Measurement(iterations = 5, time = 10)
+public abstract class OldToYoungLinks {
+
+    private static final int SLOTS = 64;
+
+    static final class Value {
+        final long id;
+        Value(long id) {
+            this.id = id;
+        }
+    }
+
+    @Param({"1000000"})
+    public int holders;
+
+    private Object[][] old;
+
+    @Setup
+    public void setup() {
+        old = new Object[holders][];
+        for (int i = 0; i < holders; i++) {
+            old[i] = new Object[SLOTS];
+        }
+        // promote the holders
+        System.gc();
+        System.gc();
+    }
+
+    @Benchmark
+    public Object storeYoung() {
+        ThreadLocalRandom r = ThreadLocalRandom.current();
+        Value v = new Value(r.nextLong());
+        old[r.nextInt(holders)][r.nextInt(SLOTS)] = v;
+        return v;
+    }
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseG1GC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class G1 extends OldToYoungLinks {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseParallelGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Parallel extends OldToYoungLinks {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseZGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Z extends OldToYoungLinks {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseShenandoahGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Shenandoah extends OldToYoungLinks {}
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.vm.gc;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.lang.ref.Reference;
+import java.lang.ref.SoftReference;
+import java.lang.ref.WeakReference;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * A cache of values held through soft or weak references, with a skewed
+ * access pattern: hot entries stay reachable through the cache while cold
+ * ones are cleared by the collector and rebuilt on a miss. This exercises
+ * reference discovery and processing. Run with
+ * -prof org.openjdk.bench.vm.gc.GCPauseProfiler to get pause percentiles,
+ * stalls and GC CPU.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 5)
+@Measurement(iterations = 5, time = 10)
+public abstract class ReferenceCache {
+
+    @Param({"soft", "weak"})
+    public String refType;
+
+    @Param({"500000"})
+    public int entries;
+
+    @Param({"1024"})
+    public int valueSize;
+
+    private Reference<byte[]>[] cache;
+
+    // Strongly held hot entries, a small share of the cache
+    private byte[][] hot;
+
+    @SuppressWarnings("unchecked")
+    @Setup
+    public void setup() {
+        cache = (Reference<byte[]>[]) new Reference<?>[entries];
+        hot = new byte[entries / 100][];
+        for (int i = 0; i < entries; i++) {
+            byte[] v = new byte[valueSize];
+            cache[i] = newRef(v);
+            if (i < hot.length) {
+                hot[i] = v;
+            }
+        }
+        System.gc();
+    }
+
+    private Reference<byte[]> newRef(byte[] v) {
+        return "soft".equals(refType) ? new SoftReference<>(v) : new WeakReference<>(v);
+    }
+
+    @Benchmark
+    public byte[] lookup() {
+        ThreadLocalRandom r = ThreadLocalRandom.current();
+        // squaring skews accesses towards the low, hot indices
+        double u = r.nextDouble();
+        int i = (int) (u * u * entries);
+        byte[] v = cache[i].get();
+        if (v == null) {
+            v = new byte[valueSize];
+            cache[i] = newRef(v);
+        }
+        return v;
+    }
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseG1GC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class G1 extends ReferenceCache {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseParallelGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Parallel extends ReferenceCache {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseZGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Z extends ReferenceCache {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseShenandoahGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Shenandoah extends ReferenceCache {}
+}